@@ -0,0 +1,275 @@
+/**
+ * AnimationBlendBench.cpp
+ *
+ * Frame time of N characters, each blending M clip layers, through
+ * AnimationInstance's SoA/SSE pose path against the AoS path it replaced:
+ * every layer sampled into its own freshly allocated matrix vector and
+ * blended by decomposing and recomposing each matrix. Checks that both
+ * paths produce the same skinning matrices first.
+ *
+ * Usage:
+ *   sanic_bench_anim_blend
+ */
+
+#include "engine/Animation.h"
+#include "BenchCommon.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace SanicBench;
+using namespace Sanic;
+
+namespace {
+
+constexpr uint32_t BONE_COUNT = 64;
+constexpr uint32_t KEY_COUNT = 31;
+constexpr float CLIP_DURATION = 1.0f;
+constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+// Humanoid-sized tree: a 4-bone spine with 15-bone limb chains
+std::shared_ptr<Skeleton> makeSkeleton() {
+    auto skeleton = std::make_shared<Skeleton>();
+    skeleton->name = "bench";
+    skeleton->rootBoneIndex = 0;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> offset(-0.2f, 0.2f);
+    for (uint32_t i = 0; i < BONE_COUNT; ++i) {
+        Bone bone;
+        bone.name = "bone" + std::to_string(i);
+        if (i == 0) {
+            bone.parentIndex = -1;
+        } else if (i < 4 || (i - 4) % 15 == 0) {
+            bone.parentIndex = i < 4 ? int32_t(i - 1) : 3;
+        } else {
+            bone.parentIndex = int32_t(i - 1);
+        }
+        bone.localBindPose = glm::translate(glm::mat4(1.0f), glm::vec3(offset(rng), 0.25f, offset(rng)));
+        bone.inverseBindMatrix = glm::mat4(1.0f);
+        bone.localTransform = bone.localBindPose;
+        bone.globalTransform = glm::mat4(1.0f);
+        bone.skinningMatrix = glm::mat4(1.0f);
+
+        skeleton->boneNameToIndex[bone.name] = i;
+        skeleton->hierarchyOrder.push_back(i);
+        skeleton->bones.push_back(bone);
+    }
+    return skeleton;
+}
+
+// AnimationLibrary has no glTF loader yet: loadAnimation caches an empty
+// clip under "<path>:", which is filled in here and played by that name
+std::string makeClip(uint32_t seed) {
+    std::string path = "bench_clip" + std::to_string(seed);
+    std::shared_ptr<AnimationClip> clip = AnimationLibrary::getInstance().loadAnimation(path);
+    clip->duration = CLIP_DURATION;
+    clip->looping = true;
+    clip->channels.clear();
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (uint32_t bone = 0; bone < BONE_COUNT; ++bone) {
+        AnimationChannel channel;
+        channel.boneIndex = bone;
+        for (uint32_t k = 0; k < KEY_COUNT; ++k) {
+            float time = CLIP_DURATION * k / (KEY_COUNT - 1);
+            glm::vec3 axis = glm::normalize(glm::vec3(dist(rng), dist(rng), dist(rng)) + glm::vec3(0.0f, 0.0f, 1.5f));
+            channel.positionKeys.push_back({time, glm::vec3(dist(rng), 2.0f + dist(rng), dist(rng)) * 0.1f});
+            channel.rotationKeys.push_back({time, glm::angleAxis(0.6f * dist(rng), axis)});
+            channel.scaleKeys.push_back({time, glm::vec3(1.0f + 0.05f * dist(rng))});
+        }
+        clip->channels.push_back(std::move(channel));
+    }
+    return path + ":";
+}
+
+// ============================================================================
+// AOS REFERENCE (AnimationInstance before the SoA pose path)
+// ============================================================================
+
+template<typename T, typename Mix>
+T sampleKeys(const std::vector<Keyframe<T>>& keys, float time, Mix mix) {
+    if (keys.size() == 1) return keys[0].value;
+
+    size_t nextIdx = 0;
+    for (size_t i = 0; i < keys.size() - 1; ++i) {
+        nextIdx = i + 1;
+        if (time < keys[i + 1].time) break;
+    }
+    size_t prevIdx = nextIdx > 0 ? nextIdx - 1 : 0;
+    float t = 0.0f;
+    float dt = keys[nextIdx].time - keys[prevIdx].time;
+    if (dt > 0.0f) {
+        t = (time - keys[prevIdx].time) / dt;
+    }
+    return mix(keys[prevIdx].value, keys[nextIdx].value, t);
+}
+
+class AoSInstance {
+public:
+    AoSInstance(std::shared_ptr<Skeleton> skeleton, std::vector<const AnimationClip*> clips, std::vector<float> weights)
+        : skeleton_(std::move(skeleton)), clips_(std::move(clips)), weights_(std::move(weights)),
+          times_(clips_.size(), 0.0f), globals_(skeleton_->bones.size()), skinning_(skeleton_->bones.size()) {}
+
+    void update(float deltaTime) {
+        for (size_t i = 0; i < clips_.size(); ++i) {
+            times_[i] = std::fmod(times_[i] + deltaTime, clips_[i]->duration);
+        }
+
+        std::vector<glm::mat4> basePose(skeleton_->bones.size());
+        sampleClip(*clips_[0], times_[0], basePose);
+        for (size_t i = 1; i < clips_.size(); ++i) {
+            std::vector<glm::mat4> clipPose(skeleton_->bones.size());
+            sampleClip(*clips_[i], times_[i], clipPose);
+            for (size_t b = 0; b < basePose.size(); ++b) {
+                basePose[b] = interpolateTransform(basePose[b], clipPose[b], weights_[i]);
+            }
+        }
+
+        for (uint32_t boneIdx : skeleton_->hierarchyOrder) {
+            int32_t parent = skeleton_->bones[boneIdx].parentIndex;
+            globals_[boneIdx] = parent >= 0 ? globals_[parent] * basePose[boneIdx] : basePose[boneIdx];
+        }
+        for (size_t b = 0; b < globals_.size(); ++b) {
+            skinning_[b] = globals_[b] * skeleton_->bones[b].inverseBindMatrix;
+        }
+    }
+
+    const std::vector<glm::mat4>& getSkinningMatrices() const { return skinning_; }
+
+private:
+    std::shared_ptr<Skeleton> skeleton_;
+    std::vector<const AnimationClip*> clips_;
+    std::vector<float> weights_;
+    std::vector<float> times_;
+    std::vector<glm::mat4> globals_;
+    std::vector<glm::mat4> skinning_;
+
+    static void sampleClip(const AnimationClip& clip, float time, std::vector<glm::mat4>& outTransforms) {
+        for (auto& t : outTransforms) {
+            t = glm::mat4(1.0f);
+        }
+
+        auto mixVec = [](const glm::vec3& a, const glm::vec3& b, float t) { return glm::mix(a, b, t); };
+        for (const auto& channel : clip.channels) {
+            glm::vec3 position = sampleKeys(channel.positionKeys, time, mixVec);
+            glm::quat rotation = sampleKeys(channel.rotationKeys, time, slerpQuat);
+            glm::vec3 scale = sampleKeys(channel.scaleKeys, time, mixVec);
+
+            outTransforms[channel.boneIndex] = glm::translate(glm::mat4(1.0f), position) *
+                                               glm::mat4_cast(rotation) *
+                                               glm::scale(glm::mat4(1.0f), scale);
+        }
+    }
+};
+
+// ============================================================================
+// CROWD
+// ============================================================================
+
+struct Crowd {
+    std::vector<std::unique_ptr<AnimationInstance>> soa;
+    std::vector<std::unique_ptr<AoSInstance>> aos;
+};
+
+// Layer 0 at full weight, the rest blended over it at `weight`. Start
+// times are staggered so characters don't sample identical keys.
+Crowd makeCrowd(const std::shared_ptr<Skeleton>& skeleton, const std::vector<std::string>& clipNames,
+                uint32_t characters, uint32_t layers, float weight) {
+    Crowd crowd;
+    std::vector<const AnimationClip*> clips;
+    std::vector<float> weights;
+    for (uint32_t layer = 0; layer < layers; ++layer) {
+        clips.push_back(AnimationLibrary::getInstance().getAnimation(clipNames[layer]).get());
+        weights.push_back(layer == 0 ? 1.0f : weight);
+    }
+
+    for (uint32_t c = 0; c < characters; ++c) {
+        float startTime = CLIP_DURATION * c / characters;
+
+        auto instance = std::make_unique<AnimationInstance>(skeleton);
+        instance->play(clipNames[0], 0.0f);
+        for (uint32_t layer = 1; layer < layers; ++layer) {
+            instance->crossfade(clipNames[layer], 0.0f);
+            instance->setLayerWeight(layer, weight);
+        }
+        instance->update(startTime);
+        crowd.soa.push_back(std::move(instance));
+
+        auto reference = std::make_unique<AoSInstance>(skeleton, clips, weights);
+        reference->update(startTime);
+        crowd.aos.push_back(std::move(reference));
+    }
+    return crowd;
+}
+
+// A single layer at weight 0.5, where the SoA path's nlerp equals the
+// AoS path's slerp, so both should agree to float precision
+void checkParity(const std::shared_ptr<Skeleton>& skeleton, const std::vector<std::string>& clipNames) {
+    Crowd crowd = makeCrowd(skeleton, clipNames, 8, 2, 0.5f);
+
+    float maxError = 0.0f;
+    for (int frame = 0; frame < 20; ++frame) {
+        for (size_t c = 0; c < crowd.soa.size(); ++c) {
+            crowd.soa[c]->update(FRAME_TIME);
+            crowd.aos[c]->update(FRAME_TIME);
+
+            const auto& a = crowd.soa[c]->getSkinningMatrices();
+            const auto& b = crowd.aos[c]->getSkinningMatrices();
+            for (size_t bone = 0; bone < a.size(); ++bone) {
+                for (int col = 0; col < 4; ++col) {
+                    for (int row = 0; row < 4; ++row) {
+                        maxError = std::max(maxError, std::abs(a[bone][col][row] - b[bone][col][row]));
+                    }
+                }
+            }
+        }
+    }
+
+    std::printf("SoA vs AoS skinning matrices: max error %.2e\n", maxError);
+    check(maxError < 1e-3f, "SoA blend matches the AoS blend");
+}
+
+void benchmark(const std::shared_ptr<Skeleton>& skeleton, const std::vector<std::string>& clipNames,
+               uint32_t characters, uint32_t layers) {
+    Crowd crowd = makeCrowd(skeleton, clipNames, characters, layers, 0.3f);
+    const int runs = characters >= 1000 ? 15 : 61;
+
+    double soaMs = medianMs(runs, [&] {
+        for (auto& instance : crowd.soa) {
+            instance->update(FRAME_TIME);
+        }
+    });
+    double aosMs = medianMs(runs, [&] {
+        for (auto& instance : crowd.aos) {
+            instance->update(FRAME_TIME);
+        }
+    });
+
+    std::printf("  %5u characters x %u layers: SoA %8.3f ms, AoS %8.3f ms (%.1fx)\n",
+                characters, layers, soaMs, aosMs, aosMs / soaMs);
+}
+
+} // namespace
+
+int main() {
+    std::shared_ptr<Skeleton> skeleton = makeSkeleton();
+    std::vector<std::string> clipNames;
+    for (uint32_t seed = 1; seed <= 4; ++seed) {
+        clipNames.push_back(makeClip(seed));
+    }
+
+    checkParity(skeleton, clipNames);
+
+    std::printf("Pose blend, %u bones, %u keys per channel, single thread, per frame:\n", BONE_COUNT, KEY_COUNT);
+    for (uint32_t characters : {100, 1000, 5000}) {
+        for (uint32_t layers : {1, 2, 4}) {
+            benchmark(skeleton, clipNames, characters, layers);
+        }
+    }
+
+    return exitCode();
+}
@@ -0,0 +1,54 @@
+/**
+ * BenchCommon.h
+ * 
+ * Timing and checking helpers shared by the benchmark executables.
+ * Benchmarks print their results and exit non-zero if a check failed,
+ * so the ones with checks also run under ctest.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace SanicBench {
+
+using Clock = std::chrono::steady_clock;
+
+inline double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Median wall time of fn over `runs` calls, in milliseconds
+template <typename Fn>
+double medianMs(int runs, Fn&& fn) {
+    std::vector<double> times;
+    times.reserve(runs);
+    for (int run = 0; run < runs; ++run) {
+        Clock::time_point start = Clock::now();
+        fn();
+        times.push_back(elapsedMs(start));
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+inline int& failureCount() {
+    static int count = 0;
+    return count;
+}
+
+inline void check(bool condition, const char* what) {
+    if (!condition) {
+        std::fprintf(stderr, "FAILED: %s\n", what);
+        failureCount()++;
+    }
+}
+
+inline int exitCode() {
+    return failureCount() == 0 ? 0 : 1;
+}
+
+} // namespace SanicBench
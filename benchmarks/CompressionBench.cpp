@@ -0,0 +1,206 @@
+/**
+ * CompressionBench.cpp
+ *
+ * Round-trips DataCompression's LZ4 codecs over varied inputs (raw blocks
+ * and framed sections, truncated and corrupted streams must fail cleanly),
+ * then measures them on asset-like data: ratio and compress / decompress
+ * throughput per level, and the time to load a section compressed versus
+ * uncompressed from storage of a given bandwidth.
+ *
+ * Usage:
+ *   sanic_bench_compression
+ */
+
+#include "engine/DataCompression.h"
+#include "BenchCommon.h"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+
+using namespace SanicBench;
+using namespace Sanic;
+
+namespace {
+
+const CompressionCodec CODECS[] = {CompressionCodec::None, CompressionCodec::LZ4, CompressionCodec::LZ4Shuffle4};
+
+void appendFloat(std::vector<uint8_t>& data, float value) {
+    uint8_t bytes[4];
+    std::memcpy(bytes, &value, 4);
+    data.insert(data.end(), bytes, bytes + 4);
+}
+
+// Interleaved position/normal/uv vertices of a torus, then its indices
+std::vector<uint8_t> makeGeometry(int segments) {
+    std::vector<uint8_t> data;
+    const int ringCount = segments * 2;
+    for (int i = 0; i <= ringCount; ++i) {
+        for (int j = 0; j <= segments; ++j) {
+            float theta = 6.2831853f * i / ringCount;
+            float phi = 6.2831853f * j / segments;
+            float ring = 1.0f + 0.35f * std::cos(phi);
+            float values[8] = {
+                ring * std::cos(theta), 0.35f * std::sin(phi), ring * std::sin(theta),
+                std::cos(phi) * std::cos(theta), std::sin(phi), std::cos(phi) * std::sin(theta),
+                float(i) / ringCount, float(j) / segments
+            };
+            for (float value : values) appendFloat(data, value);
+        }
+    }
+    for (int i = 0; i < ringCount; ++i) {
+        for (int j = 0; j < segments; ++j) {
+            uint32_t a = i * (segments + 1) + j;
+            uint32_t quad[6] = {a, a + segments + 1, a + 1, a + 1, a + segments + 1, a + segments + 2};
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(quad);
+            data.insert(data.end(), bytes, bytes + sizeof(quad));
+        }
+    }
+    return data;
+}
+
+// Signed distance volume of the same torus
+std::vector<uint8_t> makeSdfVolume(int resolution) {
+    std::vector<uint8_t> data;
+    data.reserve(size_t(resolution) * resolution * resolution * 4);
+    for (int z = 0; z < resolution; ++z) {
+        for (int y = 0; y < resolution; ++y) {
+            for (int x = 0; x < resolution; ++x) {
+                float px = (x + 0.5f) / resolution * 3.0f - 1.5f;
+                float py = (y + 0.5f) / resolution * 3.0f - 1.5f;
+                float pz = (z + 0.5f) / resolution * 3.0f - 1.5f;
+                float ring = std::sqrt(px * px + pz * pz) - 1.0f;
+                appendFloat(data, std::sqrt(ring * ring + py * py) - 0.35f);
+            }
+        }
+    }
+    return data;
+}
+
+std::vector<uint8_t> makeNoise(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> data(size);
+    for (uint8_t& byte : data) byte = uint8_t(rng());
+    return data;
+}
+
+// ============================================================================
+// ROUND TRIP
+// ============================================================================
+
+void checkRoundTrip() {
+    std::mt19937 rng(1);
+    size_t cases = 0;
+    size_t failures = 0;
+
+    for (int iteration = 0; iteration < 120; ++iteration) {
+        size_t size = rng() % (iteration < 30 ? 64 : 200000);
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            switch (iteration % 4) {
+                case 0: data[i] = uint8_t(rng()); break;                                // Incompressible
+                case 1: data[i] = uint8_t((i / 7) % 13); break;                         // Short repeats
+                case 2: data[i] = uint8_t(i % 4 == 3 ? 0x3f : (i * 31) >> 6); break;    // Float-like
+                default: data[i] = (rng() % 10 == 0 || i == 0) ? uint8_t(rng()) : data[i - 1]; break;
+            }
+        }
+
+        for (CompressionCodec codec : CODECS) {
+            for (int level : {1, 6, 12}) {
+                cases++;
+                std::vector<uint8_t> packed(DataCompression::compressBound(size));
+                size_t packedSize = DataCompression::compress(codec, data.data(), size, packed.data(), packed.size(), level);
+                std::vector<uint8_t> unpacked(size);
+                bool ok = (packedSize > 0 || size == 0) &&
+                          DataCompression::decompress(codec, packed.data(), packedSize, unpacked.data(), size) &&
+                          unpacked == data;
+
+                // Damaged streams must be rejected or decode without overrunning
+                if (packedSize > 2) {
+                    DataCompression::decompress(codec, packed.data(), packedSize / 2, unpacked.data(), size);
+                    packed[packedSize / 3] ^= 0x5a;
+                    DataCompression::decompress(codec, packed.data(), packedSize, unpacked.data(), size);
+                }
+
+                // Framed section with page-style split points
+                std::vector<uint32_t> splits;
+                for (int k = 0; k < 4 && size > 0; ++k) splits.push_back(uint32_t(rng() % size));
+                std::vector<uint8_t> sectionData = data;
+                std::vector<uint8_t> section = DataCompression::compressSection(
+                    SectionType::Nanite, sectionData, codec, level, splits);
+                SectionHeader header;
+                std::vector<uint8_t> decoded;
+                ok = ok && DataCompression::decompressSection(section.data(), section.size(), header, decoded) &&
+                     decoded == data;
+                if (section.size() > sizeof(SectionHeader) + 1) {
+                    DataCompression::decompressSection(section.data(), section.size() - 1, header, decoded);
+                }
+
+                failures += ok ? 0 : 1;
+            }
+        }
+    }
+
+    std::printf("Round trip: %zu/%zu cases match\n", cases - failures, cases);
+    check(failures == 0, "compress -> decompress returns the input");
+}
+
+// ============================================================================
+// THROUGHPUT
+// ============================================================================
+
+double megabytesPerSecond(size_t bytes, double ms) {
+    return ms > 0.0 ? bytes / (1024.0 * 1024.0) / (ms / 1000.0) : 0.0;
+}
+
+void benchmark(const char* name, SectionType type, std::vector<uint8_t> data) {
+    CompressionCodec codec = DataCompression::selectCodec(type);
+    const double storageMBps[] = {500.0, 3500.0};
+
+    std::printf("  %s, %.1f MB, %s:\n", name, data.size() / (1024.0 * 1024.0),
+                codec == CompressionCodec::LZ4Shuffle4 ? "LZ4 + shuffle" : "LZ4");
+    for (int level : {1, 6, 12}) {
+        std::vector<uint8_t> section;
+        double compressMs = medianMs(3, [&] {
+            section = DataCompression::compressSection(type, data, codec, level);
+        });
+
+        SectionHeader header;
+        std::vector<uint8_t> decoded;
+        double decompressMs = medianMs(9, [&] {
+            DataCompression::decompressSection(section.data(), section.size(), header, decoded);
+        });
+        check(decoded == data, "section throughput run decodes to its input");
+
+        // Compression pays off while reading the saved bytes takes longer
+        // than decoding them
+        double megabytes = data.size() / (1024.0 * 1024.0);
+        double savedMegabytes = (data.size() - std::min(data.size(), section.size())) / (1024.0 * 1024.0);
+        double breakEvenMBps = savedMegabytes / (decompressMs / 1000.0);
+        std::printf("    level %2d: ratio %5.2f, compress %7.1f MB/s, decompress %7.1f MB/s, "
+                    "faster to load compressed below %6.0f MB/s\n",
+                    level, double(data.size()) / section.size(), megabytesPerSecond(data.size(), compressMs),
+                    megabytesPerSecond(data.size(), decompressMs), breakEvenMBps);
+        std::printf("             load");
+        for (double bandwidth : storageMBps) {
+            double rawMs = megabytes / bandwidth * 1000.0;
+            double packedMs = section.size() / (1024.0 * 1024.0) / bandwidth * 1000.0 + decompressMs;
+            std::printf(" @ %4.0f MB/s: %6.2f ms raw, %6.2f ms compressed", bandwidth, rawMs, packedMs);
+        }
+        std::printf("\n");
+    }
+}
+
+} // namespace
+
+int main() {
+    checkRoundTrip();
+
+    std::printf("Section throughput (single thread; load = read at the given bandwidth + decode):\n");
+    benchmark("geometry", SectionType::Geometry, makeGeometry(256));
+    benchmark("SDF volume", SectionType::Lumen, makeSdfVolume(128));
+    benchmark("noise", SectionType::Nanite, makeNoise(4 << 20, 2));
+
+    return exitCode();
+}
@@ -0,0 +1,243 @@
+/**
+ * NavHierarchyBench.cpp
+ *
+ * Query latency of 1 km+ routes across a 1152 m square of ground split by
+ * walls, each with one gap, so most routes detour. NavHierarchy (route
+ * cache miss, then hit) runs against NavigationQuery without a hierarchy,
+ * whose node pool ends the search part way, and against a flat Detour A*
+ * with the largest node pool Detour allows, which shows what finishing
+ * the route flat costs. Checks that every hierarchical route reaches its
+ * target and is not much longer than the flat A* route.
+ *
+ * Usage:
+ *   sanic_bench_nav
+ */
+
+#include "engine/NavigationSystem.h"
+#include "BenchCommon.h"
+#include "DetourNavMesh.h"
+#include "DetourNavMeshQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace SanicBench;
+using namespace Sanic;
+
+namespace {
+
+constexpr float WORLD_SIZE = 1152.0f;           // 80 tiles of the default 14.4 m
+constexpr float GROUND_CELL = 24.0f;
+constexpr int WALL_COUNT = 8;
+constexpr float WALL_SPACING = 144.0f;
+constexpr float WALL_THICKNESS = 2.0f;
+constexpr float WALL_HEIGHT = 4.0f;
+constexpr float GAP_WIDTH = 12.0f;
+constexpr float MIN_ROUTE = 1000.0f;
+constexpr int ROUTE_COUNT = 32;
+constexpr int FULL_SEARCH_NODES = 65535;        // Detour's node index limit
+constexpr int FULL_SEARCH_POLYS = 65536;
+
+float wallX(int wall) {
+    return WALL_SPACING * (wall + 0.5f);
+}
+
+float gapZ(int wall) {
+    return 100.0f + float((wall * 397) % 950);
+}
+
+void addBox(NavMeshInputGeometry& geometry, const glm::vec3& min, const glm::vec3& max) {
+    glm::vec3 c[8];
+    for (int i = 0; i < 8; ++i) {
+        c[i] = glm::vec3(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z);
+    }
+    const int faces[5][4] = {{0, 4, 6, 2}, {1, 3, 7, 5}, {0, 1, 5, 4}, {2, 6, 7, 3}, {2, 3, 1, 0}};
+    const int top[4] = {6, 7, 3, 2};
+    for (const auto& face : faces) {
+        geometry.addTriangle(c[face[0]], c[face[1]], c[face[2]]);
+        geometry.addTriangle(c[face[0]], c[face[2]], c[face[3]]);
+    }
+    geometry.addTriangle(c[top[0]], c[top[1]], c[top[2]]);
+    geometry.addTriangle(c[top[0]], c[top[2]], c[top[3]]);
+}
+
+NavMeshInputGeometry makeWorld() {
+    NavMeshInputGeometry geometry;
+    int cells = int(WORLD_SIZE / GROUND_CELL);
+    for (int i = 0; i < cells; ++i) {
+        for (int j = 0; j < cells; ++j) {
+            glm::vec3 a(i * GROUND_CELL, 0.0f, j * GROUND_CELL);
+            glm::vec3 b = a + glm::vec3(GROUND_CELL, 0.0f, 0.0f);
+            glm::vec3 c = a + glm::vec3(GROUND_CELL, 0.0f, GROUND_CELL);
+            glm::vec3 d = a + glm::vec3(0.0f, 0.0f, GROUND_CELL);
+            geometry.addTriangle(a, c, b);
+            geometry.addTriangle(a, d, c);
+        }
+    }
+
+    for (int wall = 0; wall < WALL_COUNT; ++wall) {
+        float x0 = wallX(wall) - WALL_THICKNESS * 0.5f;
+        float x1 = wallX(wall) + WALL_THICKNESS * 0.5f;
+        float gap = gapZ(wall);
+        addBox(geometry, glm::vec3(x0, 0.0f, 0.0f), glm::vec3(x1, WALL_HEIGHT, gap - GAP_WIDTH * 0.5f));
+        addBox(geometry, glm::vec3(x0, 0.0f, gap + GAP_WIDTH * 0.5f), glm::vec3(x1, WALL_HEIGHT, WORLD_SIZE));
+    }
+    return geometry;
+}
+
+// Endpoints on open ground, at least MIN_ROUTE apart
+std::vector<std::pair<glm::vec3, glm::vec3>> makeRoutes() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coordinate(8.0f, WORLD_SIZE - 8.0f);
+    auto openPoint = [&] {
+        for (;;) {
+            glm::vec3 p(coordinate(rng), 0.0f, coordinate(rng));
+            float toWall = std::abs(std::fmod(p.x, WALL_SPACING) - WALL_SPACING * 0.5f);
+            if (toWall > 6.0f) return p;
+        }
+    };
+
+    std::vector<std::pair<glm::vec3, glm::vec3>> routes;
+    while (routes.size() < ROUTE_COUNT) {
+        glm::vec3 start = openPoint();
+        glm::vec3 end = openPoint();
+        if (glm::distance(start, end) >= MIN_ROUTE) {
+            routes.emplace_back(start, end);
+        }
+    }
+    return routes;
+}
+
+float pathLength(const std::vector<glm::vec3>& path) {
+    float length = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        length += glm::distance(path[i - 1], path[i]);
+    }
+    return length;
+}
+
+// ============================================================================
+// FLAT REFERENCE (one Detour A* over the whole NavMesh)
+// ============================================================================
+
+class FullSearch {
+public:
+    explicit FullSearch(const dtNavMesh* navMesh)
+        : query_(dtAllocNavMeshQuery()), polys_(FULL_SEARCH_POLYS), straight_(FULL_SEARCH_POLYS * 3) {
+        query_->init(navMesh, FULL_SEARCH_NODES);
+    }
+    ~FullSearch() { dtFreeNavMeshQuery(query_); }
+
+    PathResult findPath(const glm::vec3& start, const glm::vec3& end) {
+        PathResult result;
+        const float extents[3] = {2.0f, 4.0f, 2.0f};
+        dtPolyRef startRef = 0, endRef = 0;
+        glm::vec3 startOnMesh, endOnMesh;
+        query_->findNearestPoly(&start.x, extents, filter_.getFilter(), &startRef, &startOnMesh.x);
+        query_->findNearestPoly(&end.x, extents, filter_.getFilter(), &endRef, &endOnMesh.x);
+        if (!startRef || !endRef) return result;
+
+        int polyCount = 0;
+        dtStatus status = query_->findPath(startRef, endRef, &startOnMesh.x, &endOnMesh.x, filter_.getFilter(),
+                                           polys_.data(), &polyCount, FULL_SEARCH_POLYS);
+        if (dtStatusFailed(status) || polyCount == 0) return result;
+
+        int straightCount = 0;
+        query_->findStraightPath(&startOnMesh.x, &endOnMesh.x, polys_.data(), polyCount, straight_.data(),
+                                 nullptr, nullptr, &straightCount, FULL_SEARCH_POLYS);
+        for (int i = 0; i < straightCount; ++i) {
+            result.path.emplace_back(straight_[i * 3], straight_[i * 3 + 1], straight_[i * 3 + 2]);
+        }
+        result.success = !result.path.empty();
+        result.partial = dtStatusDetail(status, DT_PARTIAL_RESULT) || polys_[polyCount - 1] != endRef;
+        return result;
+    }
+
+private:
+    dtNavMeshQuery* query_;
+    NavQueryFilter filter_;
+    std::vector<dtPolyRef> polys_;
+    std::vector<float> straight_;
+};
+
+// ============================================================================
+// RUNS
+// ============================================================================
+
+struct Latency {
+    std::vector<double> ms;
+    size_t reached = 0;
+
+    void add(double time, const PathResult& result) {
+        ms.push_back(time);
+        reached += result.success && !result.partial ? 1 : 0;
+    }
+    void print(const char* label) {
+        std::sort(ms.begin(), ms.end());
+        std::printf("  %-32s median %8.3f ms, max %8.3f ms, reached %2zu/%zu\n",
+                    label, ms[ms.size() / 2], ms.back(), reached, ms.size());
+    }
+};
+
+template<typename Fn>
+PathResult timed(Latency& latency, Fn&& fn) {
+    Clock::time_point start = Clock::now();
+    PathResult result = fn();
+    latency.add(elapsedMs(start), result);
+    return result;
+}
+
+} // namespace
+
+int main() {
+    NavigationMesh navMesh;
+    Clock::time_point buildStart = Clock::now();
+    bool built = navMesh.build(makeWorld());
+    double buildMs = elapsedMs(buildStart);
+    check(built, "NavMesh builds");
+    if (!built) return exitCode();
+
+    NavHierarchy hierarchy(navMesh);
+    Clock::time_point precomputeStart = Clock::now();
+    hierarchy.precompute();
+    double precomputeMs = elapsedMs(precomputeStart);
+
+    NavigationQuery flat(navMesh);
+    FullSearch full(navMesh.getNavMesh());
+
+    std::printf("%.0f m square, %d walls: NavMesh build %.0f ms, hierarchy precompute %.0f ms\n",
+                WORLD_SIZE, WALL_COUNT, buildMs, precomputeMs);
+
+    Latency miss, hit, flatLatency, fullLatency;
+    float straightTotal = 0.0f;
+    float worstRatio = 0.0f;
+    size_t missed = 0;
+    for (const auto& [start, end] : makeRoutes()) {
+        straightTotal += glm::distance(start, end);
+
+        uint32_t missesBefore = hierarchy.getStats().cacheMisses;
+        PathResult route = timed(miss, [&] { return hierarchy.findPath(start, end); });
+        missed += hierarchy.getStats().cacheMisses - missesBefore;
+        timed(hit, [&] { return hierarchy.findPath(start, end); });
+        timed(flatLatency, [&] { return flat.findPath(start, end); });
+        PathResult reference = timed(fullLatency, [&] { return full.findPath(start, end); });
+
+        bool arrived = route.success && !route.partial && !route.path.empty() &&
+                       glm::distance(route.path.back(), end) < 0.5f;
+        check(arrived, "hierarchical route reaches its target");
+        if (arrived && reference.success && !reference.partial) {
+            worstRatio = std::max(worstRatio, pathLength(route.path) / pathLength(reference.path));
+        }
+    }
+
+    std::printf("%d routes, mean straight-line distance %.0f m, %zu route cache misses on first query:\n",
+                ROUTE_COUNT, straightTotal / ROUTE_COUNT, missed);
+    miss.print("hierarchy, first query");
+    hit.print("hierarchy, cached route");
+    flatLatency.print("flat, NavigationQuery");
+    fullLatency.print("flat, 65535-node Detour A*");
+    std::printf("  hierarchical path length vs flat A*: worst %.3fx\n", worstRatio);
+
+    check(worstRatio < 1.25f, "hierarchical routes stay within 25% of flat A*");
+    return exitCode();
+}
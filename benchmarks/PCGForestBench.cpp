@@ -0,0 +1,207 @@
+/**
+ * PCGForestBench.cpp
+ *
+ * Time to execute a forest PCG graph over a square kilometre of rolling
+ * hills on job pools of increasing size, starting from one with no worker
+ * threads, where every node and point range runs on the calling thread.
+ * The graph has three independent branches off one landscape input: trees
+ * (sparse samples spaced by a distance filter), undergrowth (dense samples
+ * masked by a layer and density noise, projected back onto the surface)
+ * and rocks on slopes. The cache is cleared before every run, so each run
+ * executes every node. Checks that every pool produces the same points.
+ *
+ * Usage:
+ *   sanic_bench_pcg
+ */
+
+#include "engine/PCGFramework.h"
+#include "engine/JobSystem.h"
+#include "BenchCommon.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace SanicBench;
+using namespace Kinetic;
+
+namespace {
+
+constexpr float WORLD_SIZE = 1000.0f;
+
+float heightAt(const glm::vec2& p) {
+    return 20.0f * std::sin(p.x / 90.0f) * std::cos(p.y / 70.0f) + 5.0f * std::sin(p.x / 17.0f + p.y / 23.0f);
+}
+
+glm::vec3 normalAt(const glm::vec2& p) {
+    float dx = 20.0f / 90.0f * std::cos(p.x / 90.0f) * std::cos(p.y / 70.0f) +
+               5.0f / 17.0f * std::cos(p.x / 17.0f + p.y / 23.0f);
+    float dz = -20.0f / 70.0f * std::sin(p.x / 90.0f) * std::sin(p.y / 70.0f) +
+               5.0f / 23.0f * std::cos(p.x / 17.0f + p.y / 23.0f);
+    return glm::normalize(glm::vec3(-dx, 1.0f, -dz));
+}
+
+// Feeds an analytic heightfield to the samplers through their landscape pin
+class LandscapeInputNode : public PCGNode {
+public:
+    std::string getName() const override { return "Landscape Input"; }
+    std::string getCategory() const override { return "Bench"; }
+    std::vector<PCGPin> getInputPins() const override { return {}; }
+    std::vector<PCGPin> getOutputPins() const override { return {{"Landscape", PCGPinType::Landscape, false, {}}}; }
+
+    bool execute(PCGContext&, const std::vector<PCGDataPtr>&, std::vector<PCGDataPtr>& outputs) override {
+        PCGLandscapeData landscape;
+        landscape.boundsMin = glm::vec3(0.0f, -30.0f, 0.0f);
+        landscape.boundsMax = glm::vec3(WORLD_SIZE, 30.0f, WORLD_SIZE);
+        landscape.heightQuery = heightAt;
+        landscape.normalQuery = normalAt;
+        landscape.layerWeightQuery = [](const glm::vec2& p, uint32_t) {
+            return 0.5f + 0.5f * std::sin(p.x / 40.0f) * std::sin(p.y / 55.0f);
+        };
+        outputs.push_back(makePCGData(std::move(landscape)));
+        return true;
+    }
+};
+
+struct ForestGraph {
+    PCGGraph graph;
+    std::vector<uint32_t> branchEnds;   // Trees, undergrowth, rocks
+};
+
+// Chains nodes after source through their first pins, returning their ids
+std::vector<uint32_t> chain(PCGGraph& graph, uint32_t source, std::vector<std::unique_ptr<PCGNode>> nodes) {
+    std::vector<uint32_t> ids;
+    for (auto& node : nodes) {
+        ids.push_back(graph.addNode(std::move(node)));
+        graph.connect(source, 0, ids.back(), 0);
+        source = ids.back();
+    }
+    return ids;
+}
+
+template<typename T>
+std::unique_ptr<PCGNode> node(std::initializer_list<std::pair<const char*, PCGNode::Setting::Value>> settings) {
+    auto result = std::make_unique<T>();
+    for (const auto& [name, value] : settings) {
+        result->setSetting(name, value);
+    }
+    return result;
+}
+
+template<typename... Nodes>
+std::vector<std::unique_ptr<PCGNode>> nodes(Nodes... list) {
+    std::vector<std::unique_ptr<PCGNode>> result;
+    (result.push_back(std::move(list)), ...);
+    return result;
+}
+
+void buildForest(ForestGraph& forest) {
+    PCGGraph& graph = forest.graph;
+    uint32_t landscape = graph.addNode(std::make_unique<LandscapeInputNode>());
+
+    std::vector<uint32_t> trees = chain(graph, landscape, nodes(
+        node<PCGSurfaceSamplerNode>({{"PointsPerSquareMeter", 0.02f}, {"MaxSlope", 30.0f}}),
+        node<PCGDensityFilterNode>({{"NoiseScale", 50.0f}}),
+        node<PCGDistanceFilterNode>({{"MinDistance", 4.0f}}),
+        node<PCGTransformNode>({{"ScaleMin", glm::vec3(0.8f)}, {"ScaleMax", glm::vec3(1.2f)}})));
+
+    std::vector<uint32_t> undergrowth = chain(graph, landscape, nodes(
+        node<PCGSurfaceSamplerNode>({{"PointsPerSquareMeter", 0.5f}}),
+        node<PCGLayerFilterNode>({{"LayerIndex", 0}, {"MinWeight", 0.3f}}),
+        node<PCGDensityFilterNode>({{"NoiseScale", 20.0f}, {"DensityMin", 0.2f}}),
+        node<PCGTransformNode>({{"OffsetMin", glm::vec3(-0.5f, 0.0f, -0.5f)},
+                                {"OffsetMax", glm::vec3(0.5f, 0.0f, 0.5f)},
+                                {"ScaleMin", glm::vec3(0.6f)}, {"ScaleMax", glm::vec3(1.4f)}}),
+        node<PCGProjectToSurfaceNode>({{"AlignToNormal", true}})));
+    graph.connect(landscape, 0, undergrowth[1], 1);
+    graph.connect(landscape, 0, undergrowth[4], 1);
+
+    std::vector<uint32_t> rocks = chain(graph, landscape, nodes(
+        node<PCGSurfaceSamplerNode>({{"PointsPerSquareMeter", 0.05f}, {"MinSlope", 10.0f}}),
+        node<PCGDistanceFilterNode>({{"MinDistance", 5.0f}}),
+        node<PCGTransformNode>({{"ScaleMin", glm::vec3(0.5f)}, {"ScaleMax", glm::vec3(2.0f)},
+                                {"RotationMax", glm::vec3(360.0f)}})));
+
+    forest.branchEnds = {trees.back(), undergrowth.back(), rocks.back()};
+}
+
+const PCGSpatialData& branchOutput(const ForestGraph& forest, size_t branch) {
+    return std::get<PCGSpatialData>(*(*forest.graph.getNodeOutputs(forest.branchEnds[branch]))[0]);
+}
+
+bool samePoints(const PCGSpatialData& a, const PCGSpatialData& b) {
+    return a.positions == b.positions && a.rotations == b.rotations && a.scales == b.scales &&
+           a.seeds == b.seeds;
+}
+
+PCGContext makeContext(Sanic::JobSystem* jobs) {
+    PCGContext context;
+    context.seed = 1234;
+    context.worldBoundsMin = glm::vec3(0.0f);
+    context.worldBoundsMax = glm::vec3(WORLD_SIZE, 0.0f, WORLD_SIZE);
+    context.jobs = jobs;
+    return context;
+}
+
+} // namespace
+
+int main() {
+    // Pools up to the machine's size, and at least 3 workers so the
+    // parallel paths are checked everywhere. The first has no workers, so
+    // every node and point range runs on the calling thread.
+    uint32_t maxWorkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    std::vector<uint32_t> workerCounts = {0};
+    for (uint32_t workers : {1u, 3u, 7u, 15u, maxWorkers}) {
+        if (workers > workerCounts.back() && workers <= std::max(maxWorkers, 3u)) {
+            workerCounts.push_back(workers);
+        }
+    }
+
+    ForestGraph reference;
+    buildForest(reference);
+    Sanic::JobSystem serialPool(0);
+    PCGContext serialContext = makeContext(&serialPool);
+    bool ok = reference.graph.execute(serialContext);
+    check(ok, "forest graph executes");
+    if (!ok) return exitCode();
+
+    const char* branchNames[] = {"trees", "undergrowth", "rocks"};
+    std::printf("Forest graph, %.0f m square, %zu nodes:\n", WORLD_SIZE, reference.graph.getNodes().size());
+    for (size_t branch = 0; branch < reference.branchEnds.size(); ++branch) {
+        std::printf("  %-12s %8zu points\n", branchNames[branch], branchOutput(reference, branch).size());
+        check(branchOutput(reference, branch).size() > 0, "branch produces points");
+    }
+
+    const int runs = 5;
+    double serialMs = 0.0;
+    std::printf("Full execution, cache cleared, median of %d (%u hardware threads):\n",
+                runs, std::thread::hardware_concurrency());
+    for (uint32_t workers : workerCounts) {
+        Sanic::JobSystem pool(workers);
+        PCGContext context = makeContext(&pool);
+        ForestGraph forest;
+        buildForest(forest);
+
+        double ms = medianMs(runs, [&] {
+            forest.graph.clearCache();
+            forest.graph.execute(context);
+        });
+        serialMs = workers == 0 ? ms : serialMs;
+
+        bool identical = true;
+        for (size_t branch = 0; branch < forest.branchEnds.size(); ++branch) {
+            identical = identical && samePoints(branchOutput(forest, branch), branchOutput(reference, branch));
+        }
+        std::printf("  %2u workers: %8.2f ms (%.2fx), output %s%s\n", workers, ms, serialMs / ms,
+                    identical ? "identical to serial" : "DIFFERS from serial",
+                    workers > maxWorkers ? " (more workers than hardware threads)" : "");
+        check(identical, "parallel execution matches serial");
+
+        if (workers == workerCounts.back()) {
+            double cachedMs = medianMs(runs, [&] { forest.graph.execute(context); });
+            check(forest.graph.getLastExecutionStats().nodesExecuted == 0, "unchanged graph is served from the cache");
+            std::printf("  re-execution with every node cached: %.3f ms\n", cachedMs);
+        }
+    }
+
+    return exitCode();
+}
@@ -0,0 +1,128 @@
+/**
+ * QueryCacheBench.cpp
+ *
+ * Per-frame cost of a query over a world with many archetypes, through
+ * World's cached match lists against the uncached path they replaced: a
+ * fresh getMatchingArchetypes scan and vector on every query. Entities
+ * carry Transform and Velocity plus a combination of ten tag components,
+ * which spreads them over 1024 archetypes. Both paths walk the chunks the
+ * same way, so the difference is the match lookup.
+ *
+ * Usage:
+ *   sanic_bench_query
+ */
+
+#include "engine/ECS.h"
+#include "BenchCommon.h"
+#include <string>
+
+using namespace SanicBench;
+using namespace Sanic;
+
+namespace {
+
+constexpr uint32_t TAG_COUNT = 10;
+constexpr uint32_t ARCHETYPE_COUNT = 1u << TAG_COUNT;
+
+template<uint32_t N>
+struct Tag {
+    uint32_t value = N;
+};
+
+template<uint32_t... N>
+ComponentSignature tagSignature(uint32_t mask, std::integer_sequence<uint32_t, N...>) {
+    auto& registry = ComponentRegistry::getInstance();
+    ComponentSignature signature;
+    ((mask & (1u << N) ? (void)signature.set(registry.getTypeId<Tag<N>>()) : (void)0), ...);
+    return signature;
+}
+
+void populate(World& world, uint32_t entityCount) {
+    auto& registry = ComponentRegistry::getInstance();
+    std::vector<Entity> entities;
+    for (uint32_t mask = 0; mask < ARCHETYPE_COUNT; ++mask) {
+        ComponentSignature signature = tagSignature(mask, std::make_integer_sequence<uint32_t, TAG_COUNT>());
+        signature.set(registry.getTypeId<Transform>());
+        signature.set(registry.getTypeId<Velocity>());
+
+        uint32_t count = entityCount / ARCHETYPE_COUNT + (mask < entityCount % ARCHETYPE_COUNT ? 1 : 0);
+        uint32_t firstRow = 0;
+        entities.clear();
+        world.createEntities(signature, count, entities, firstRow);
+        for (Entity entity : entities) {
+            world.getComponent<Velocity>(entity).linear = glm::vec3(1.0f, 0.0f, 0.0f);
+        }
+    }
+}
+
+// The pre-cache Query: match archetypes from scratch, then walk their chunks
+template<typename... Components, typename Func>
+void forEachChunkUncached(World& world, Func&& fn) {
+    ComponentSignature required;
+    ((required.set(ComponentRegistry::getInstance().getTypeId<Components>())), ...);
+
+    std::vector<Archetype*> archetypes = world.getMatchingArchetypes(required);
+    for (Archetype* archetype : archetypes) {
+        for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+            fn(static_cast<size_t>(archetype->getChunkSize(chunk)),
+               archetype->getChunkEntities(chunk),
+               archetype->template getChunkColumn<Components>(chunk)...);
+        }
+    }
+}
+
+// One query's work for a frame: integrate velocity into position
+struct Integrate {
+    size_t* visited;
+    void operator()(size_t count, Entity*, Transform* transforms, Velocity* velocities) const {
+        for (size_t i = 0; i < count; ++i) {
+            transforms[i].position += velocities[i].linear * 0.016f;
+        }
+        *visited += count;
+    }
+    template<typename... Tags>
+    void operator()(size_t count, Entity* entities, Transform* transforms, Velocity* velocities, Tags*...) const {
+        (*this)(count, entities, transforms, velocities);
+    }
+};
+
+template<typename... Components>
+void compare(World& world, const char* label, size_t expected) {
+    const int runs = 51;
+    size_t cachedVisited = 0;
+    size_t uncachedVisited = 0;
+
+    double cachedMs = medianMs(runs, [&] {
+        world.query<Transform, Velocity, Components...>().forEachChunk(Integrate{&cachedVisited});
+    });
+    double uncachedMs = medianMs(runs, [&] {
+        forEachChunkUncached<Transform, Velocity, Components...>(world, Integrate{&uncachedVisited});
+    });
+
+    std::printf("    %-22s %8zu matches: cached %9.4f ms, uncached %9.4f ms (%.1fx)\n",
+                label, expected, cachedMs, uncachedMs, uncachedMs / cachedMs);
+    check(cachedVisited == expected * runs, "cached query visits every match");
+    check(uncachedVisited == expected * runs, "uncached query visits every match");
+}
+
+void benchmark(uint32_t entityCount) {
+    World world;
+    populate(world, entityCount);
+    std::printf("  %u entities, %zu archetypes:\n", entityCount, world.getArchetypeCount());
+
+    compare<>(world, "all", entityCount);
+    compare<Tag<0>, Tag<1>, Tag<2>>(world, "3 tags (1/8)", world.query<Tag<0>, Tag<1>, Tag<2>>().count());
+    compare<Tag<0>, Tag<1>, Tag<2>, Tag<3>, Tag<4>, Tag<5>, Tag<6>, Tag<7>, Tag<8>, Tag<9>>(
+        world, "10 tags (1 archetype)",
+        world.query<Tag<0>, Tag<1>, Tag<2>, Tag<3>, Tag<4>, Tag<5>, Tag<6>, Tag<7>, Tag<8>, Tag<9>>().count());
+}
+
+} // namespace
+
+int main() {
+    std::printf("Transform += Velocity per matched entity, median of 51 frames:\n");
+    for (uint32_t entityCount : {10000, 100000, 1000000}) {
+        benchmark(entityCount);
+    }
+    return exitCode();
+}
@@ -0,0 +1,258 @@
+/**
+ * SaveCaptureBench.cpp
+ *
+ * Game-thread stall and file size of a full save of a representative
+ * world: saveable entities with transform and health (a tenth with custom
+ * data), player and world state sections and a set of checkpoints.
+ *
+ * v1 is the format before background saves, rebuilt here from the public
+ * pieces it used: every section and entity turned into one JSON document,
+ * checksummed, compressed and written, all on the calling thread. v2 is
+ * SaveSystem::saveGame, which only snapshots on the calling thread and
+ * leaves encoding and writing to the save thread. Checks that the v2 save
+ * loads back first.
+ *
+ * Usage:
+ *   sanic_bench_save
+ */
+
+#include "engine/SaveSystem.h"
+#include "BenchCommon.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace SanicBench;
+using namespace Sanic;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct BenchWorld {
+    World world;
+    SaveState<PlayerSaveData> player;
+    SaveState<WorldSaveData> worldState;
+};
+
+void populate(BenchWorld& bench, uint32_t entityCount) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-500.0f, 500.0f);
+
+    for (uint32_t i = 0; i < entityCount; ++i) {
+        Entity entity = bench.world.createEntity();
+        bench.world.addComponent<Transform>(entity, Transform{});
+        Transform& transform = bench.world.getComponent<Transform>(entity);
+        transform.position = glm::vec3(dist(rng), dist(rng) * 0.1f, dist(rng));
+        transform.rotation = glm::normalize(glm::quat(1.0f, 0.0f, dist(rng) * 0.001f, 0.0f));
+
+        Health health;
+        health.current = float(i % 100);
+        bench.world.addComponent<Health>(entity, health);
+
+        SaveableComponent saveable;
+        saveable.persistentId = "npc_" + std::to_string(i);
+        if (i % 10 == 0) {
+            saveable.customSerialize = [i] { return "{\"mood\":" + std::to_string(i % 7) + ",\"route\":\"patrol_a\"}"; };
+        }
+        bench.world.addComponent<SaveableComponent>(entity, saveable);
+    }
+
+    PlayerSaveData& player = bench.player.edit();
+    player.playerName = "Bench";
+    player.characterClass = "Ranger";
+    player.level = 37;
+    for (int i = 0; i < 200; ++i) {
+        player.statistics["stat_" + std::to_string(i)] = i * 13;
+        player.unlockedSkills.push_back("skill_" + std::to_string(i));
+    }
+
+    WorldSaveData& worldState = bench.worldState.edit();
+    worldState.dayCount = 12;
+    worldState.weatherState = "rain";
+    for (int i = 0; i < 5000; ++i) {
+        worldState.flags["quest_flag_" + std::to_string(i)] = (i % 3) == 0;
+    }
+    for (int i = 0; i < 2000; ++i) {
+        worldState.counters["counter_" + std::to_string(i)] = i;
+        worldState.destroyedPersistentIds.push_back("prop_" + std::to_string(i * 7));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        worldState.objectStates["door_" + std::to_string(i)] = (i % 2) ? "open" : "locked";
+    }
+}
+
+void registerSections(BenchWorld& bench, SaveSystem& saves) {
+    SaveSectionHandler player;
+    player.section = SaveSection::Player;
+    player.name = "player";
+    player.serialize = [&bench](const SerializationContext&) { return bench.player.get().serialize(); };
+    player.snapshot = [&bench](const SerializationContext&) { return bench.player.snapshot(); };
+    player.read = [&bench](SaveReader& reader, SerializationContext&) { return bench.player.edit().read(reader); };
+    saves.registerSectionHandler(player);
+
+    SaveSectionHandler world;
+    world.section = SaveSection::World;
+    world.name = "world";
+    world.serialize = [&bench](const SerializationContext&) { return bench.worldState.get().serialize(); };
+    world.snapshot = [&bench](const SerializationContext&) { return bench.worldState.snapshot(); };
+    world.read = [&bench](SaveReader& reader, SerializationContext&) { return bench.worldState.edit().read(reader); };
+    saves.registerSectionHandler(world);
+
+    for (int i = 0; i < 40; ++i) {
+        Checkpoint checkpoint;
+        checkpoint.id = "checkpoint_" + std::to_string(i);
+        checkpoint.name = "Checkpoint " + std::to_string(i);
+        checkpoint.respawnPosition = glm::vec3(float(i), 0.0f, 0.0f);
+        checkpoint.respawnRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        checkpoint.areaId = "area_" + std::to_string(i / 8);
+        saves.getCheckpointManager().registerCheckpoint(checkpoint);
+    }
+}
+
+// ============================================================================
+// V1 REFERENCE (SaveSystem::saveToFile before background saves)
+// ============================================================================
+
+size_t saveV1(BenchWorld& bench, SaveSystem& saves, const std::string& filePath) {
+    using json = nlohmann::json;
+
+    json game;
+    game["player"] = bench.player.get().serialize();
+    game["world"] = bench.worldState.get().serialize();
+
+    json entities = json::array();
+    for (auto [entity, saveable] : bench.world.query<SaveableComponent>()) {
+        json e;
+        e["persistentId"] = saveable.persistentId;
+        if (auto* transform = bench.world.tryGetComponent<Transform>(entity)) {
+            e["transform"] = {
+                {"pos", {transform->position.x, transform->position.y, transform->position.z}},
+                {"rot", {transform->rotation.x, transform->rotation.y, transform->rotation.z, transform->rotation.w}},
+                {"scale", {transform->scale.x, transform->scale.y, transform->scale.z}}
+            };
+        }
+        if (auto* health = bench.world.tryGetComponent<Health>(entity)) {
+            e["health"] = {{"current", health->current}, {"max", health->max}};
+        }
+        if (saveable.customSerialize) {
+            e["custom"] = saveable.customSerialize();
+        }
+        entities.push_back(e);
+    }
+    game["entities"] = entities;
+
+    json doc;
+    doc["version"] = "1.0.0";
+    doc["metadata"] = {{"slotId", 1}, {"saveName", "bench"}, {"playerLevel", 37}};
+    doc["gameData"] = game.dump();
+    doc["checkpoints"] = saves.getCheckpointManager().serialize();
+
+    std::string jsonStr = doc.dump();
+    uint32_t checksum = SaveSystem::calculateChecksum(jsonStr);
+    std::vector<uint8_t> compressed = SaveSystem::compressData(jsonStr);
+
+    std::ofstream file(filePath, std::ios::binary);
+    file.write("SANIC", 5);
+    const int version[3] = {1, 0, 0};
+    file.write(reinterpret_cast<const char*>(version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+    uint64_t uncompressedSize = jsonStr.size();
+    file.write(reinterpret_cast<const char*>(&uncompressedSize), sizeof(uncompressedSize));
+    file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+    return 5 + sizeof(version) + sizeof(checksum) + sizeof(uncompressedSize) + compressed.size();
+}
+
+// ============================================================================
+// RUNS
+// ============================================================================
+
+// Positions and world state are wiped, then restored from the v2 slot
+void checkRoundTrip(const fs::path& directory) {
+    BenchWorld bench;
+    populate(bench, 2000);
+    SaveSystem saves;
+    saves.init(directory.string());
+    saves.setWorld(&bench.world);
+    registerSections(bench, saves);
+
+    std::vector<glm::vec3> expected;
+    for (auto [entity, transform] : bench.world.query<Transform>()) {
+        expected.push_back(transform.position);
+    }
+
+    saves.saveGame(1, "round trip");
+    saves.flushSaves();
+
+    for (auto [entity, transform] : bench.world.query<Transform>()) {
+        transform.position = glm::vec3(0.0f);
+    }
+    bench.worldState.edit().flags.clear();
+
+    bool loaded = saves.loadGame(1);
+    size_t restored = 0;
+    size_t index = 0;
+    for (auto [entity, transform] : bench.world.query<Transform>()) {
+        restored += transform.position == expected[index++] ? 1 : 0;
+    }
+
+    std::printf("v2 round trip: loaded %d, %zu/%zu transforms restored, %zu flags\n",
+                loaded, restored, expected.size(), bench.worldState.get().flags.size());
+    check(loaded, "v2 save loads");
+    check(restored == expected.size(), "v2 save restores every transform");
+    check(bench.worldState.get().flags.size() == 5000, "v2 save restores the world section");
+    saves.shutdown();
+}
+
+void benchmark(const fs::path& directory, uint32_t entityCount) {
+    BenchWorld bench;
+    populate(bench, entityCount);
+    SaveSystem saves;
+    saves.init(directory.string());
+    saves.setWorld(&bench.world);
+    registerSections(bench, saves);
+
+    const int runs = 7;
+    size_t v1Bytes = 0;
+    double v1Ms = medianMs(runs, [&] {
+        v1Bytes = saveV1(bench, saves, (directory / "v1.sav").string());
+    });
+
+    // saveGame returns once the snapshot is queued; the save thread is
+    // drained outside the timed region
+    std::vector<double> stalls;
+    SaveSystem::SaveStats stats;
+    for (int run = 0; run < runs; ++run) {
+        Clock::time_point start = Clock::now();
+        saves.saveGame(1, "bench");
+        stalls.push_back(elapsedMs(start));
+        saves.flushSaves();
+        stats = saves.getLastSaveStats();
+    }
+    std::sort(stalls.begin(), stalls.end());
+    saves.shutdown();
+
+    std::printf("  %6u entities: v1 JSON %8.2f ms stall, %8.1f KB | v2 binary %6.2f ms stall "
+                "(%.2f ms snapshot), %6.2f ms on the save thread, %8.1f KB (raw %.1f KB)\n",
+                entityCount, v1Ms, v1Bytes / 1024.0, stalls[runs / 2], stats.snapshotMs,
+                stats.encodeMs + stats.writeMs, stats.fileBytes / 1024.0, stats.rawBytes / 1024.0);
+}
+
+} // namespace
+
+int main() {
+    fs::path directory = fs::temp_directory_path() / "sanic_bench_save";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+
+    checkRoundTrip(directory);
+
+    std::printf("Full save, 200 player stats, 8000 world entries, 40 checkpoints:\n");
+    for (uint32_t entityCount : {1000, 10000, 50000}) {
+        benchmark(directory, entityCount);
+    }
+
+    fs::remove_all(directory);
+    return exitCode();
+}
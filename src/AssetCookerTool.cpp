@@ -6,7 +6,7 @@
  * 
  * Usage:
  *   sanic_cooker input.obj -o output.sanic_mesh
- *   sanic_cooker input_dir/ --batch -o output_dir/
+ *   sanic_cooker input_dir/ --batch -o output_dir/ --jobs 16
  *   sanic_cooker input.obj --lod-levels 8 --sdf-resolution 128
  */
 
@@ -47,7 +47,7 @@ void printUsage(const char* programName) {
     std::cout << "  -o, --output <path>       Output file or directory\n";
     std::cout << "  -b, --batch               Batch mode - process entire directory\n";
     std::cout << "  -r, --recursive           Recursive directory search\n";
-    std::cout << "  -f, --force               Overwrite existing output files\n";
+    std::cout << "  -f, --force               Recook even if source and settings are unchanged\n";
     std::cout << "  -v, --verbose             Verbose output\n";
     std::cout << "  --dry-run                 Print what would be done\n";
     std::cout << "\nCooking Options:\n";
@@ -57,7 +57,8 @@ void printUsage(const char* programName) {
     std::cout << "  --sdf-padding <f>         SDF padding (default: 0.1)\n";
     std::cout << "  --no-physics              Skip physics data generation\n";
     std::cout << "  --no-compress             Skip compression\n";
-    std::cout << "  --threads <n>             Number of processing threads\n";
+    std::cout << "  -j, --jobs <n>            Number of processing threads (default: all cores)\n";
+    std::cout << "  --max-in-flight <n>       Assets cooked at once; bounds memory (default: --jobs)\n";
     std::cout << "\nExamples:\n";
     std::cout << "  " << programName << " model.obj -o model.sanic_mesh\n";
     std::cout << "  " << programName << " assets/raw/ --batch -o assets/cooked/ -r\n";
@@ -86,6 +87,7 @@ bool parseArgs(int argc, char* argv[], CookerOptions& options) {
             options.recursive = true;
         } else if (arg == "-f" || arg == "--force") {
             options.force = true;
+            options.config.skipUnchanged = false;
         } else if (arg == "-v" || arg == "--verbose") {
             options.verbose = true;
             options.config.verbose = true;
@@ -109,9 +111,12 @@ bool parseArgs(int argc, char* argv[], CookerOptions& options) {
             options.config.generateTriangleMesh = false;
         } else if (arg == "--no-compress") {
             options.config.compressPages = false;
-        } else if (arg == "--threads") {
+        } else if (arg == "-j" || arg == "--jobs" || arg == "--threads") {
             if (i + 1 >= argc) return false;
-            // Threading handled by batch cook
+            options.config.jobs = std::stoi(argv[++i]);
+        } else if (arg == "--max-in-flight") {
+            if (i + 1 >= argc) return false;
+            options.config.maxAssetsInFlight = std::stoi(argv[++i]);
         } else if (arg[0] != '-') {
             options.inputPaths.push_back(arg);
         } else {
@@ -231,11 +236,8 @@ int main(int argc, char* argv[]) {
         });
     }
     
-    // Process each file
-    auto startTime = std::chrono::high_resolution_clock::now();
-    uint32_t successCount = 0;
-    uint32_t failCount = 0;
-    
+    // Pair each source with its output
+    std::vector<std::pair<std::string, std::string>> jobs;
     for (const auto& sourcePath : sourceFiles) {
         // Determine output path
         std::string outputPath;
@@ -250,56 +252,34 @@ int main(int argc, char* argv[]) {
             outputPath = options.outputPath;
         }
         
-        // Check if output exists
-        if (fs::exists(outputPath) && !options.force) {
-            if (options.verbose) {
-                std::cout << "Skipping (exists): " << sourcePath << "\n";
-            }
-            continue;
-        }
-        
         if (options.dryRun) {
             std::cout << "Would cook: " << sourcePath << " -> " << outputPath << "\n";
             continue;
         }
         
-        if (options.verbose) {
-            std::cout << "Cooking: " << sourcePath << "\n";
-        }
-        
         // Create output directory if needed
         fs::path outputDir = fs::path(outputPath).parent_path();
         if (!outputDir.empty() && !fs::exists(outputDir)) {
             fs::create_directories(outputDir);
         }
         
-        // Cook the file
-        if (!cooker.cookFile(sourcePath, outputPath)) {
-            std::cerr << "Error cooking: " << sourcePath << "\n";
-            std::cerr << "  Reason: " << cooker.getLastError() << "\n";
-            failCount++;
-            continue;
-        }
-        
-        if (options.verbose) {
-            std::cout << "  -> " << outputPath << "\n";
-            const auto& stats = cooker.getStats();
-            std::cout << "  Stats: " << stats.inputTriangles << " tris -> "
-                      << stats.outputClusters << " clusters, "
-                      << stats.outputMeshlets << " meshlets\n";
-            std::cout << "  Size: " << (stats.totalSize / 1024) << " KB\n";
-        }
-        
-        successCount++;
+        jobs.push_back({sourcePath, outputPath});
     }
     
+    // Cook everything; unchanged outputs are skipped unless --force
+    auto startTime = std::chrono::high_resolution_clock::now();
+    cooker.cookBatch(jobs);
+    const auto& stats = cooker.getStats();
+    uint32_t failCount = stats.assetsFailed;
+    
     auto endTime = std::chrono::high_resolution_clock::now();
     double totalSeconds = std::chrono::duration<double>(endTime - startTime).count();
     
     std::cout << "\n";
     std::cout << "==================\n";
     std::cout << "Cooking complete!\n";
-    std::cout << "  Success: " << successCount << "\n";
+    std::cout << "  Success: " << stats.assetsCooked << "\n";
+    std::cout << "  Skipped: " << stats.assetsSkipped << " (up to date)\n";
     std::cout << "  Failed:  " << failCount << "\n";
     std::cout << "  Time:    " << totalSeconds << "s\n";
     
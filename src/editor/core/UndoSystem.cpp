@@ -24,12 +24,14 @@ TransformAction::TransformAction(Sanic::World* world, Entity entity,
 void TransformAction::execute() {
     if (world_ && world_->hasComponent<Transform>(entity_)) {
         world_->getComponent<Transform>(entity_) = newTransform_;
+        Sanic::TransformSystem::markDirty(*world_, entity_);
     }
 }
 
 void TransformAction::undo() {
     if (world_ && world_->hasComponent<Transform>(entity_)) {
         world_->getComponent<Transform>(entity_) = oldTransform_;
+        Sanic::TransformSystem::markDirty(*world_, entity_);
     }
 }
 
@@ -90,18 +90,7 @@ void HierarchyPanel::draw() {
         if (ImGui::BeginDragDropTarget()) {
             if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("ENTITY")) {
                 Entity droppedEntity = *static_cast<Entity*>(payload->Data);
-                if (world->hasComponent<Transform>(droppedEntity)) {
-                    Transform& transform = world->getComponent<Transform>(droppedEntity);
-                    if (transform.parent != INVALID_ENTITY) {
-                        // Remove from current parent
-                        if (world->hasComponent<Transform>(transform.parent)) {
-                            auto& parentTransform = world->getComponent<Transform>(transform.parent);
-                            auto& children = parentTransform.children;
-                            children.erase(std::remove(children.begin(), children.end(), droppedEntity), children.end());
-                        }
-                        transform.parent = INVALID_ENTITY;
-                    }
-                }
+                reparent(droppedEntity, INVALID_ENTITY, *world);
             }
             ImGui::EndDragDropTarget();
         }
@@ -216,28 +205,38 @@ void HierarchyPanel::handleDragDrop(Entity entity, Sanic::World& world) {
             Entity droppedEntity = *static_cast<Entity*>(payload->Data);
             
             if (droppedEntity != entity) {
-                // Reparent
-                if (world.hasComponent<Transform>(droppedEntity)) {
-                    Transform& droppedTransform = world.getComponent<Transform>(droppedEntity);
-                    
-                    // Remove from old parent
-                    if (droppedTransform.parent != INVALID_ENTITY && world.hasComponent<Transform>(droppedTransform.parent)) {
-                        auto& oldParentChildren = world.getComponent<Transform>(droppedTransform.parent).children;
-                        oldParentChildren.erase(std::remove(oldParentChildren.begin(), oldParentChildren.end(), droppedEntity), oldParentChildren.end());
-                    }
-                    
-                    // Add to new parent
-                    droppedTransform.parent = entity;
-                    if (world.hasComponent<Transform>(entity)) {
-                        world.getComponent<Transform>(entity).children.push_back(droppedEntity);
-                    }
-                }
+                reparent(droppedEntity, entity, world);
             }
         }
         ImGui::EndDragDropTarget();
     }
 }
 
+void HierarchyPanel::reparent(Entity child, Entity parent, Sanic::World& world) {
+    if (!world.hasComponent<Transform>(child)) return;
+    
+    // Through the TransformSystem, so it rebuilds its order and the moved
+    // subtree gets new world matrices
+    if (Sanic::TransformSystem* transforms = world.getSystem<Sanic::TransformSystem>()) {
+        transforms->setParent(world, child, parent);
+        return;
+    }
+    
+    Transform& childTransform = world.getComponent<Transform>(child);
+    
+    // Remove from old parent
+    if (childTransform.parent != INVALID_ENTITY && world.hasComponent<Transform>(childTransform.parent)) {
+        auto& oldParentChildren = world.getComponent<Transform>(childTransform.parent).children;
+        oldParentChildren.erase(std::remove(oldParentChildren.begin(), oldParentChildren.end(), child), oldParentChildren.end());
+    }
+    
+    // Add to new parent
+    childTransform.parent = parent;
+    if (parent != INVALID_ENTITY && world.hasComponent<Transform>(parent)) {
+        world.getComponent<Transform>(parent).children.push_back(child);
+    }
+}
+
 void HierarchyPanel::handleContextMenu(Entity entity, Sanic::World& world) {
     if (ImGui::MenuItem("Rename", "F2")) {
         renamingEntity_ = entity;
@@ -30,6 +30,7 @@ private:
     void drawEntityNode(Entity entity, Sanic::World& world);
     void handleDragDrop(Entity entity, Sanic::World& world);
     void handleContextMenu(Entity entity, Sanic::World& world);
+    void reparent(Entity child, Entity parent, Sanic::World& world);
     
     void createEntity(const char* name = "New Entity");
     void createPrimitive(const char* type);
@@ -241,6 +241,10 @@ void InspectorPanel::drawTransformComponent(Entity entity, Transform& transform)
         // Scale
         changed |= drawVector3("Scale", transform.scale, 1.0f);
         
+        if (changed) {
+            Sanic::TransformSystem::markDirty(*editor_->getWorld(), entity);
+        }
+        
         // Record undo when editing ends
         if (changed && !ImGui::IsAnyItemActive() && transformEditing_) {
             if (cachedTransform_.position != transform.position ||
@@ -312,6 +312,9 @@ void Viewport::handleGizmoInteraction() {
         viewportPos_,
         viewportSize_
     );
+    if (result.changed) {
+        Sanic::TransformSystem::markDirty(*world, focused);
+    }
     
     // Record undo when gizmo manipulation ends
     if (gizmoWasUsing_ && !gizmo_.isUsing()) {
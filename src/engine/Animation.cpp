@@ -5,13 +5,25 @@
  */
 
 #include "Animation.h"
+#include "AnimationAdvanced.h"
+#include "JobSystem.h"
 #include "VulkanContext.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SANIC_ANIMATION_SSE2 1
+#else
+#define SANIC_ANIMATION_SSE2 0
+#endif
+
 // For glTF loading
 #define TINYGLTF_NO_STB_IMAGE_WRITE
 #define TINYGLTF_NO_INCLUDE_STB_IMAGE
@@ -19,6 +31,533 @@
 
 namespace Sanic {
 
+namespace {
+
+// Four float lanes: SSE2 where available, plain floats otherwise.
+// Comparisons return lane masks for select().
+struct Float4 {
+#if SANIC_ANIMATION_SSE2
+    __m128 v;
+    
+    static Float4 load(const float* p) { return { _mm_loadu_ps(p) }; }
+    static Float4 splat(float x) { return { _mm_set1_ps(x) }; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    
+    friend Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+    friend Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+    friend Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+    friend Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+    friend Float4 sqrt(Float4 a) { return { _mm_sqrt_ps(a.v) }; }
+    friend Float4 max(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+    friend Float4 lessThan(Float4 a, Float4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+    friend Float4 equal(Float4 a, Float4 b) { return { _mm_cmpeq_ps(a.v, b.v) }; }
+    friend Float4 select(Float4 mask, Float4 a, Float4 b) {
+        return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+    }
+    friend void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+        _MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v);
+    }
+#else
+    float v[4];
+    
+    static Float4 load(const float* p) { Float4 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+    static Float4 splat(float x) { return { { x, x, x, x } }; }
+    void store(float* p) const { std::memcpy(p, v, sizeof(v)); }
+    
+    template<typename Op>
+    static Float4 map(Float4 a, Float4 b, Op op) {
+        Float4 r;
+        for (int i = 0; i < 4; ++i) r.v[i] = op(a.v[i], b.v[i]);
+        return r;
+    }
+    static float mask(bool set) {
+        uint32_t bits = set ? 0xFFFFFFFFu : 0u;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+    static bool isSet(float f) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits != 0;
+    }
+    
+    friend Float4 operator+(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x + y; }); }
+    friend Float4 operator-(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x - y; }); }
+    friend Float4 operator*(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x * y; }); }
+    friend Float4 operator/(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x / y; }); }
+    friend Float4 sqrt(Float4 a) { return map(a, a, [](float x, float) { return std::sqrt(x); }); }
+    friend Float4 max(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+    friend Float4 lessThan(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return mask(x < y); }); }
+    friend Float4 equal(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return mask(x == y); }); }
+    friend Float4 select(Float4 m, Float4 a, Float4 b) {
+        Float4 r;
+        for (int i = 0; i < 4; ++i) r.v[i] = isSet(m.v[i]) ? a.v[i] : b.v[i];
+        return r;
+    }
+    friend void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+        Float4* rows[4] = { &a, &b, &c, &d };
+        for (int i = 0; i < 4; ++i) {
+            for (int j = i + 1; j < 4; ++j) std::swap(rows[i]->v[j], rows[j]->v[i]);
+        }
+    }
+#endif
+};
+
+} // namespace
+
+// ============================================================================
+// LOCAL POSE
+// ============================================================================
+
+void LocalPose::resize(uint32_t count) {
+    uint32_t padded = (count + LANE_WIDTH - 1) / LANE_WIDTH * LANE_WIDTH;
+    boneCount = count;
+    tx.resize(padded, 0.0f);
+    ty.resize(padded, 0.0f);
+    tz.resize(padded, 0.0f);
+    rx.resize(padded, 0.0f);
+    ry.resize(padded, 0.0f);
+    rz.resize(padded, 0.0f);
+    rw.resize(padded, 1.0f);
+    sx.resize(padded, 1.0f);
+    sy.resize(padded, 1.0f);
+    sz.resize(padded, 1.0f);
+}
+
+void LocalPose::setBindPose(const Skeleton& skeleton) {
+    resize(static_cast<uint32_t>(skeleton.bones.size()));
+    for (uint32_t i = 0; i < boneCount; ++i) {
+        glm::vec3 translation, scale;
+        glm::quat rotation;
+        decomposeTransform(skeleton.bones[i].localBindPose, translation, rotation, scale);
+        setBone(i, translation, rotation, scale);
+    }
+}
+
+void LocalPose::setIdentity() {
+    std::fill(tx.begin(), tx.end(), 0.0f);
+    std::fill(ty.begin(), ty.end(), 0.0f);
+    std::fill(tz.begin(), tz.end(), 0.0f);
+    std::fill(rx.begin(), rx.end(), 0.0f);
+    std::fill(ry.begin(), ry.end(), 0.0f);
+    std::fill(rz.begin(), rz.end(), 0.0f);
+    std::fill(rw.begin(), rw.end(), 1.0f);
+    std::fill(sx.begin(), sx.end(), 1.0f);
+    std::fill(sy.begin(), sy.end(), 1.0f);
+    std::fill(sz.begin(), sz.end(), 1.0f);
+}
+
+void LocalPose::setBone(uint32_t bone, const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale) {
+    tx[bone] = translation.x;
+    ty[bone] = translation.y;
+    tz[bone] = translation.z;
+    rx[bone] = rotation.x;
+    ry[bone] = rotation.y;
+    rz[bone] = rotation.z;
+    rw[bone] = rotation.w;
+    sx[bone] = scale.x;
+    sy[bone] = scale.y;
+    sz[bone] = scale.z;
+}
+
+void LocalPose::toMatrices(glm::mat4* outMatrices) const {
+    const Float4 one = Float4::splat(1.0f);
+    const Float4 two = Float4::splat(2.0f);
+    const Float4 zero = Float4::splat(0.0f);
+    
+    for (uint32_t base = 0; base < boneCount; base += LANE_WIDTH) {
+        Float4 x = Float4::load(&rx[base]), y = Float4::load(&ry[base]);
+        Float4 z = Float4::load(&rz[base]), w = Float4::load(&rw[base]);
+        Float4 scaleX = Float4::load(&sx[base]);
+        Float4 scaleY = Float4::load(&sy[base]);
+        Float4 scaleZ = Float4::load(&sz[base]);
+        
+        Float4 xx = x * x, yy = y * y, zz = z * z;
+        Float4 xy = x * y, xz = x * z, yz = y * z;
+        Float4 wx = w * x, wy = w * y, wz = w * z;
+        
+        // columns[c][r]: row r of column c, one lane per bone
+        Float4 columns[4][4] = {
+            { (one - two * (yy + zz)) * scaleX, two * (xy + wz) * scaleX, two * (xz - wy) * scaleX, zero },
+            { two * (xy - wz) * scaleY, (one - two * (xx + zz)) * scaleY, two * (yz + wx) * scaleY, zero },
+            { two * (xz + wy) * scaleZ, two * (yz - wx) * scaleZ, (one - two * (xx + yy)) * scaleZ, zero },
+            { Float4::load(&tx[base]), Float4::load(&ty[base]), Float4::load(&tz[base]), one },
+        };
+        
+        // Now columns[c][lane] is column c of that lane's bone
+        for (auto& column : columns) {
+            transpose(column[0], column[1], column[2], column[3]);
+        }
+        
+        uint32_t count = std::min(LANE_WIDTH, boneCount - base);
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            float* out = &outMatrices[base + lane][0][0];
+            for (int c = 0; c < 4; ++c) {
+                columns[c][lane].store(out + c * 4);
+            }
+        }
+    }
+}
+
+void blendLocalPoses(const LocalPose& a, const LocalPose& b, float weight, LocalPose& out,
+                     const float* boneMask) {
+    const Float4 zero = Float4::splat(0.0f);
+    const Float4 one = Float4::splat(1.0f);
+    const Float4 layerWeight = Float4::splat(weight);
+    
+    for (uint32_t base = 0; base < out.boneCount; base += LocalPose::LANE_WIDTH) {
+        Float4 w = boneMask ? layerWeight * Float4::load(boneMask + base) : layerWeight;
+        
+        auto lerp = [&](const std::vector<float>& from, const std::vector<float>& to, std::vector<float>& result) {
+            Float4 x = Float4::load(&from[base]);
+            (x + (Float4::load(&to[base]) - x) * w).store(&result[base]);
+        };
+        lerp(a.tx, b.tx, out.tx);
+        lerp(a.ty, b.ty, out.ty);
+        lerp(a.tz, b.tz, out.tz);
+        lerp(a.sx, b.sx, out.sx);
+        lerp(a.sy, b.sy, out.sy);
+        lerp(a.sz, b.sz, out.sz);
+        
+        // nlerp along the shorter arc
+        Float4 ax = Float4::load(&a.rx[base]), ay = Float4::load(&a.ry[base]);
+        Float4 az = Float4::load(&a.rz[base]), aw = Float4::load(&a.rw[base]);
+        Float4 bx = Float4::load(&b.rx[base]), by = Float4::load(&b.ry[base]);
+        Float4 bz = Float4::load(&b.rz[base]), bw = Float4::load(&b.rw[base]);
+        Float4 flip = lessThan(ax * bx + ay * by + az * bz + aw * bw, zero);
+        Float4 sign = select(flip, zero - one, one);
+        Float4 x = ax + (bx * sign - ax) * w;
+        Float4 y = ay + (by * sign - ay) * w;
+        Float4 z = az + (bz * sign - az) * w;
+        Float4 qw = aw + (bw * sign - aw) * w;
+        Float4 invLength = one / sqrt(x * x + y * y + z * z + qw * qw);
+        (x * invLength).store(&out.rx[base]);
+        (y * invLength).store(&out.ry[base]);
+        (z * invLength).store(&out.rz[base]);
+        (qw * invLength).store(&out.rw[base]);
+    }
+}
+
+void addLocalPose(const LocalPose& base, const LocalPose& additive, float weight, LocalPose& out,
+                  const float* boneMask) {
+    const Float4 zero = Float4::splat(0.0f);
+    const Float4 one = Float4::splat(1.0f);
+    const Float4 layerWeight = Float4::splat(weight);
+    
+    for (uint32_t i = 0; i < out.boneCount; i += LocalPose::LANE_WIDTH) {
+        Float4 w = boneMask ? layerWeight * Float4::load(boneMask + i) : layerWeight;
+        
+        (Float4::load(&base.tx[i]) + Float4::load(&additive.tx[i]) * w).store(&out.tx[i]);
+        (Float4::load(&base.ty[i]) + Float4::load(&additive.ty[i]) * w).store(&out.ty[i]);
+        (Float4::load(&base.tz[i]) + Float4::load(&additive.tz[i]) * w).store(&out.tz[i]);
+        if (&out != &base) {
+            Float4::load(&base.sx[i]).store(&out.sx[i]);
+            Float4::load(&base.sy[i]).store(&out.sy[i]);
+            Float4::load(&base.sz[i]).store(&out.sz[i]);
+        }
+        
+        // Weighted delta: nlerp from identity
+        Float4 dx = Float4::load(&additive.rx[i]), dy = Float4::load(&additive.ry[i]);
+        Float4 dz = Float4::load(&additive.rz[i]), dw = Float4::load(&additive.rw[i]);
+        Float4 sign = select(lessThan(dw, zero), zero - one, one);
+        dx = dx * sign * w;
+        dy = dy * sign * w;
+        dz = dz * sign * w;
+        dw = one + (dw * sign - one) * w;
+        Float4 invLength = one / sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+        dx = dx * invLength;
+        dy = dy * invLength;
+        dz = dz * invLength;
+        dw = dw * invLength;
+        
+        // delta * base
+        Float4 bx = Float4::load(&base.rx[i]), by = Float4::load(&base.ry[i]);
+        Float4 bz = Float4::load(&base.rz[i]), bw = Float4::load(&base.rw[i]);
+        (dw * bx + dx * bw + dy * bz - dz * by).store(&out.rx[i]);
+        (dw * by + dy * bw + dz * bx - dx * bz).store(&out.ry[i]);
+        (dw * bz + dz * bw + dx * by - dy * bx).store(&out.rz[i]);
+        (dw * bw - dx * bx - dy * by - dz * bz).store(&out.rw[i]);
+    }
+}
+
+void multiplyMatrices(const glm::mat4& a, const glm::mat4& b, glm::mat4& out) {
+    Float4 columns[4] = {
+        Float4::load(&a[0][0]), Float4::load(&a[1][0]), Float4::load(&a[2][0]), Float4::load(&a[3][0])
+    };
+    Float4 result[4];
+    for (int c = 0; c < 4; ++c) {
+        result[c] = columns[0] * Float4::splat(b[c][0]) + columns[1] * Float4::splat(b[c][1]) +
+                    columns[2] * Float4::splat(b[c][2]) + columns[3] * Float4::splat(b[c][3]);
+    }
+    for (int c = 0; c < 4; ++c) {
+        result[c].store(&out[c][0]);
+    }
+}
+
+void computeModelMatrices(const Skeleton& skeleton, const glm::mat4* localMatrices, glm::mat4* outModelMatrices) {
+    for (uint32_t boneIdx : skeleton.hierarchyOrder) {
+        int32_t parent = skeleton.bones[boneIdx].parentIndex;
+        if (parent >= 0) {
+            multiplyMatrices(outModelMatrices[parent], localMatrices[boneIdx], outModelMatrices[boneIdx]);
+        } else {
+            outModelMatrices[boneIdx] = localMatrices[boneIdx];
+        }
+    }
+}
+
+// ============================================================================
+// COMPRESSED CLIP SAMPLING
+// ============================================================================
+
+namespace {
+
+// Keys searched linearly from the cursor before falling back to a binary search
+constexpr uint32_t MAX_CURSOR_STEPS = 4;
+
+// Key pair around u (0..1) for count evenly spaced keys
+inline void findUniformKey(uint32_t count, float u, uint32_t& outKey, float& outAlpha) {
+    if (count < 2) {
+        outKey = 0;
+        outAlpha = 0.0f;
+        return;
+    }
+    float position = u * static_cast<float>(count - 1);
+    outKey = std::min(static_cast<uint32_t>(position), count - 2);
+    outAlpha = std::min(position - static_cast<float>(outKey), 1.0f);
+}
+
+// Key pair around keyTime in sorted times, starting from the cached key
+inline void findCursorKey(const uint16_t* times, uint32_t count, float keyTime,
+                          uint32_t& key, float& outAlpha) {
+    if (count < 2) {
+        key = 0;
+        outAlpha = 0.0f;
+        return;
+    }
+    
+    bool found = key < count - 1 && times[key] <= keyTime;
+    for (uint32_t step = 0; found && key + 2 < count && times[key + 1] <= keyTime; ++step) {
+        if (step == MAX_CURSOR_STEPS) {
+            found = false;
+            break;
+        }
+        ++key;
+    }
+    if (!found) {
+        // Went backwards (loop or seek) or jumped far ahead
+        const uint16_t* next = std::upper_bound(times, times + count, keyTime);
+        uint32_t index = static_cast<uint32_t>(next - times);
+        key = std::min(index > 0 ? index - 1 : 0, count - 2);
+    }
+    
+    float span = static_cast<float>(times[key + 1]) - static_cast<float>(times[key]);
+    outAlpha = span > 0.0f ? std::clamp((keyTime - times[key]) / span, 0.0f, 1.0f) : 0.0f;
+}
+
+// Smallest-3 quaternions, lane-wise (see AnimationCompressor::compressQuaternion).
+// Components are quantized to 16, 16 and 14 bits; largest is the index of
+// the dropped one, which is non-negative.
+inline void decodeQuaternions(Float4 q0, Float4 q1, Float4 q2, Float4 largest,
+                              Float4& x, Float4& y, Float4& z, Float4& w) {
+    const Float4 offset = Float4::splat(0.7071067811865f);
+    Float4 c0 = q0 * Float4::splat(1.4142135623731f / 65535.0f) - offset;
+    Float4 c1 = q1 * Float4::splat(1.4142135623731f / 65535.0f) - offset;
+    Float4 c2 = q2 * Float4::splat(1.4142135623731f / 16383.0f) - offset;
+    Float4 dropped = sqrt(max(Float4::splat(0.0f), Float4::splat(1.0f) - c0 * c0 - c1 * c1 - c2 * c2));
+    
+    // The stored components fill the others in order
+    Float4 isX = equal(largest, Float4::splat(0.0f));
+    Float4 isY = equal(largest, Float4::splat(1.0f));
+    Float4 isZ = equal(largest, Float4::splat(2.0f));
+    Float4 isW = equal(largest, Float4::splat(3.0f));
+    x = select(isX, dropped, c0);
+    y = select(isY, dropped, select(isX, c0, c1));
+    z = select(isZ, dropped, select(lessThan(largest, Float4::splat(2.0f)), c1, c2));
+    w = select(isW, dropped, c2);
+}
+
+} // namespace
+
+CompressedClipSampler::CompressedClipSampler(std::shared_ptr<const CompressedAnimationClip> clip)
+    : clip_(std::move(clip)) {
+    trackCount_ = static_cast<uint32_t>(clip_->boneTracks.size());
+    
+    // Padded so whole lanes can be loaded
+    size_t padded = (trackCount_ + LocalPose::LANE_WIDTH - 1) / LocalPose::LANE_WIDTH * LocalPose::LANE_WIDTH;
+    for (int axis = 0; axis < 3; ++axis) {
+        translationMin_[axis].assign(padded, 0.0f);
+        translationScale_[axis].assign(padded, 0.0f);
+        scaleMin_[axis].assign(padded, 0.0f);
+        scaleScale_[axis].assign(padded, 0.0f);
+    }
+    
+    for (uint32_t i = 0; i < trackCount_; ++i) {
+        const auto& track = clip_->boneTracks[i];
+        
+        // Undo the compressor's normalization by max(range, 0.0001)
+        if (!track.translationData.empty()) {
+            glm::vec3 step = glm::max(track.translationRange, glm::vec3(0.0001f)) / 65535.0f;
+            for (int axis = 0; axis < 3; ++axis) {
+                translationMin_[axis][i] = track.translationMin[axis];
+                translationScale_[axis][i] = step[axis];
+            }
+        }
+        if (!track.scaleData.empty()) {
+            glm::vec3 step = glm::max(track.scaleRange, glm::vec3(0.0001f)) / 65535.0f;
+            for (int axis = 0; axis < 3; ++axis) {
+                scaleMin_[axis][i] = track.scaleMin[axis];
+                scaleScale_[axis][i] = step[axis];
+            }
+        }
+    }
+}
+
+CompressedClipSampler::~CompressedClipSampler() = default;
+
+float CompressedClipSampler::getDuration() const {
+    return clip_->duration;
+}
+
+void CompressedClipSampler::resetCursor(Cursor& cursor) const {
+    cursor.sampler = this;
+    cursor.translationKeys.assign(trackCount_, 0);
+}
+
+void CompressedClipSampler::sample(float time, Cursor& cursor, LocalPose& outPose) const {
+    if (cursor.sampler != this) {
+        resetCursor(cursor);
+    }
+    
+    const auto& tracks = clip_->boneTracks;
+    float duration = clip_->duration;
+    float u = duration > 0.0f ? std::clamp(time / duration, 0.0f, 1.0f) : 0.0f;
+    float keyTime = u * 65535.0f;   // In keyframeTimes units
+    
+    constexpr uint32_t LANES = LocalPose::LANE_WIDTH;
+    for (uint32_t base = 0; base < trackCount_; base += LANES) {
+        uint32_t laneCount = std::min(LANES, trackCount_ - base);
+        
+        // Quantized keys either side of time, one lane per track
+        alignas(16) float translationA[3][LANES] = {}, translationB[3][LANES] = {};
+        alignas(16) float rotationA[4][LANES] = {}, rotationB[4][LANES] = {};  // 3 components + largest
+        alignas(16) float scaleA[3][LANES] = {}, scaleB[3][LANES] = {};
+        alignas(16) float translationAlpha[LANES] = {}, rotationAlpha[LANES] = {}, scaleAlpha[LANES] = {};
+        
+        for (uint32_t lane = 0; lane < laneCount; ++lane) {
+            const auto& track = tracks[base + lane];
+            uint32_t key;
+            
+            uint32_t count = static_cast<uint32_t>(track.translationData.size() / 3);
+            if (count > 0) {
+                if (track.keyframeTimes.size() == count) {
+                    key = cursor.translationKeys[base + lane];
+                    findCursorKey(track.keyframeTimes.data(), count, keyTime, key, translationAlpha[lane]);
+                    cursor.translationKeys[base + lane] = key;
+                } else {
+                    findUniformKey(count, u, key, translationAlpha[lane]);
+                }
+                const uint16_t* a = &track.translationData[key * 3];
+                const uint16_t* b = &track.translationData[std::min(key + 1, count - 1) * 3];
+                for (int axis = 0; axis < 3; ++axis) {
+                    translationA[axis][lane] = a[axis];
+                    translationB[axis][lane] = b[axis];
+                }
+            }
+            
+            count = static_cast<uint32_t>(track.rotationData.size() / 3);
+            if (count > 0) {
+                findUniformKey(count, u, key, rotationAlpha[lane]);
+                const uint16_t* a = &track.rotationData[key * 3];
+                const uint16_t* b = &track.rotationData[std::min(key + 1, count - 1) * 3];
+                rotationA[0][lane] = a[0];
+                rotationA[1][lane] = a[1];
+                rotationA[2][lane] = a[2] & 0x3FFF;
+                rotationA[3][lane] = a[2] >> 14;
+                rotationB[0][lane] = b[0];
+                rotationB[1][lane] = b[1];
+                rotationB[2][lane] = b[2] & 0x3FFF;
+                rotationB[3][lane] = b[2] >> 14;
+            }
+            
+            count = static_cast<uint32_t>(track.scaleData.size() / 3);
+            if (count > 0) {
+                findUniformKey(count, u, key, scaleAlpha[lane]);
+                const uint16_t* a = &track.scaleData[key * 3];
+                const uint16_t* b = &track.scaleData[std::min(key + 1, count - 1) * 3];
+                for (int axis = 0; axis < 3; ++axis) {
+                    scaleA[axis][lane] = a[axis];
+                    scaleB[axis][lane] = b[axis];
+                }
+            }
+        }
+        
+        // Dequantize and interpolate
+        alignas(16) float translation[3][LANES], rotation[4][LANES], scale[3][LANES];
+        Float4 alpha = Float4::load(translationAlpha);
+        for (int axis = 0; axis < 3; ++axis) {
+            Float4 a = Float4::load(translationA[axis]);
+            Float4 b = Float4::load(translationB[axis]);
+            Float4 value = Float4::load(&translationMin_[axis][base]) +
+                           Float4::load(&translationScale_[axis][base]) * (a + (b - a) * alpha);
+            value.store(translation[axis]);
+        }
+        
+        alpha = Float4::load(scaleAlpha);
+        for (int axis = 0; axis < 3; ++axis) {
+            Float4 a = Float4::load(scaleA[axis]);
+            Float4 b = Float4::load(scaleB[axis]);
+            Float4 value = Float4::load(&scaleMin_[axis][base]) +
+                           Float4::load(&scaleScale_[axis][base]) * (a + (b - a) * alpha);
+            value.store(scale[axis]);
+        }
+        
+        Float4 ax, ay, az, aw, bx, by, bz, bw;
+        decodeQuaternions(Float4::load(rotationA[0]), Float4::load(rotationA[1]),
+                          Float4::load(rotationA[2]), Float4::load(rotationA[3]), ax, ay, az, aw);
+        decodeQuaternions(Float4::load(rotationB[0]), Float4::load(rotationB[1]),
+                          Float4::load(rotationB[2]), Float4::load(rotationB[3]), bx, by, bz, bw);
+        
+        // Normalized lerp along the shorter arc
+        Float4 flip = lessThan(ax * bx + ay * by + az * bz + aw * bw, Float4::splat(0.0f));
+        Float4 sign = select(flip, Float4::splat(-1.0f), Float4::splat(1.0f));
+        alpha = Float4::load(rotationAlpha);
+        Float4 x = ax + (bx * sign - ax) * alpha;
+        Float4 y = ay + (by * sign - ay) * alpha;
+        Float4 z = az + (bz * sign - az) * alpha;
+        Float4 w = aw + (bw * sign - aw) * alpha;
+        Float4 invLength = Float4::splat(1.0f) / sqrt(x * x + y * y + z * z + w * w);
+        (x * invLength).store(rotation[0]);
+        (y * invLength).store(rotation[1]);
+        (z * invLength).store(rotation[2]);
+        (w * invLength).store(rotation[3]);
+        
+        // Scatter to bones
+        for (uint32_t lane = 0; lane < laneCount; ++lane) {
+            const auto& track = tracks[base + lane];
+            uint32_t bone = track.boneIndex;
+            if (bone >= outPose.boneCount) continue;
+            
+            if (!track.translationData.empty()) {
+                outPose.tx[bone] = translation[0][lane];
+                outPose.ty[bone] = translation[1][lane];
+                outPose.tz[bone] = translation[2][lane];
+            }
+            if (!track.rotationData.empty()) {
+                outPose.rx[bone] = rotation[0][lane];
+                outPose.ry[bone] = rotation[1][lane];
+                outPose.rz[bone] = rotation[2][lane];
+                outPose.rw[bone] = rotation[3][lane];
+            }
+            if (!track.scaleData.empty()) {
+                outPose.sx[bone] = scale[0][lane];
+                outPose.sy[bone] = scale[1][lane];
+                outPose.sz[bone] = scale[2][lane];
+            }
+        }
+    }
+}
+
 // ============================================================================
 // ANIMATION STATE MACHINE
 // ============================================================================
@@ -159,6 +698,10 @@ AnimationInstance::AnimationInstance(std::shared_ptr<Skeleton> skeleton)
         size_t boneCount = skeleton_->bones.size();
         boneTransforms_.resize(boneCount, glm::mat4(1.0f));
         skinningMatrices_.resize(boneCount, glm::mat4(1.0f));
+        localMatrices_.resize(boneCount, glm::mat4(1.0f));
+        bindPose_.setBindPose(*skeleton_);
+        localPose_ = bindPose_;
+        layerPose_ = bindPose_;
     }
 }
 
@@ -167,22 +710,29 @@ void AnimationInstance::play(const std::string& clipName, float blendTime) {
     auto clip = library.getAnimation(clipName);
     
     if (clip) {
+        compressedClip_.reset();
         if (blendTime > 0.0f && !activeClips_.empty()) {
             crossfade(clipName, blendTime);
         } else {
-            activeClips_.clear();
-            clipTimes_.clear();
-            clipWeights_.clear();
-            
-            activeClips_.push_back(clip.get());
-            clipTimes_.push_back(0.0f);
-            clipWeights_.push_back(1.0f);
+            clearLayers();
+            pushLayer(clip.get(), 1.0f, false);
         }
         playing_ = true;
         paused_ = false;
     }
 }
 
+void AnimationInstance::playCompressed(std::shared_ptr<const CompressedClipSampler> clip, bool looping) {
+    if (!clip) return;
+    
+    clearLayers();
+    compressedClip_ = std::move(clip);
+    compressedTime_ = 0.0f;
+    compressedLooping_ = looping;
+    playing_ = true;
+    paused_ = false;
+}
+
 void AnimationInstance::stop(float blendTime) {
     if (blendTime > 0.0f) {
         // Fade out current animations
@@ -190,9 +740,8 @@ void AnimationInstance::stop(float blendTime) {
             weight = 0.0f;  // Will be handled in update
         }
     } else {
-        activeClips_.clear();
-        clipTimes_.clear();
-        clipWeights_.clear();
+        clearLayers();
+        compressedClip_.reset();
     }
     playing_ = false;
 }
@@ -209,6 +758,7 @@ void AnimationInstance::setTime(float time) {
     if (!clipTimes_.empty()) {
         clipTimes_[0] = time;
     }
+    compressedTime_ = time;
 }
 
 void AnimationInstance::crossfade(const std::string& clipName, float duration) {
@@ -216,9 +766,7 @@ void AnimationInstance::crossfade(const std::string& clipName, float duration) {
     auto newClip = library.getAnimation(clipName);
     
     if (newClip) {
-        activeClips_.push_back(newClip.get());
-        clipTimes_.push_back(0.0f);
-        clipWeights_.push_back(0.0f);
+        pushLayer(newClip.get(), 0.0f, false);
         
         // Store crossfade info - weight will be updated in update()
     }
@@ -235,14 +783,49 @@ void AnimationInstance::addAdditiveLayer(const std::string& clipName, float weig
     auto clip = library.getAnimation(clipName);
     
     if (clip) {
-        activeClips_.push_back(clip.get());
-        clipTimes_.push_back(0.0f);
-        clipWeights_.push_back(weight);
+        pushLayer(clip.get(), weight, true);
     }
 }
 
+void AnimationInstance::setLayerMask(uint32_t layer, const std::vector<float>& boneWeights) {
+    if (layer >= clipMasks_.size()) return;
+    
+    std::vector<float>& mask = clipMasks_[layer];
+    if (boneWeights.empty()) {
+        mask.clear();
+        return;
+    }
+    
+    // Padded like the pose arrays; bones past boneWeights are excluded
+    mask.assign(localPose_.tx.size(), 0.0f);
+    std::copy_n(boneWeights.begin(), std::min(boneWeights.size(), mask.size()), mask.begin());
+}
+
+void AnimationInstance::pushLayer(AnimationClip* clip, float weight, bool additive) {
+    activeClips_.push_back(clip);
+    clipTimes_.push_back(0.0f);
+    clipWeights_.push_back(weight);
+    clipAdditive_.push_back(additive ? 1 : 0);
+    clipMasks_.emplace_back();
+}
+
+void AnimationInstance::clearLayers() {
+    activeClips_.clear();
+    clipTimes_.clear();
+    clipWeights_.clear();
+    clipAdditive_.clear();
+    clipMasks_.clear();
+}
+
 void AnimationInstance::update(float deltaTime) {
-    if (!playing_ || paused_ || !skeleton_) return;
+    if (!isPlaying()) return;
+    
+    advance(deltaTime);
+    applyToSkeleton();
+}
+
+void AnimationInstance::advance(float deltaTime) {
+    if (!isPlaying()) return;
     
     // Update state machine if present
     if (stateMachine_) {
@@ -272,37 +855,80 @@ void AnimationInstance::update(float deltaTime) {
         }
     }
     
-    applyToSkeleton();
+    if (compressedClip_) {
+        float duration = compressedClip_->getDuration();
+        float prevTime = compressedTime_;
+        compressedTime_ += deltaTime * playbackSpeed_;
+        
+        if (compressedLooping_ && duration > 0.0f) {
+            while (compressedTime_ >= duration) {
+                compressedTime_ -= duration;
+            }
+        } else {
+            compressedTime_ = std::min(compressedTime_, duration);
+        }
+        
+        if (eventCallback_) {
+            bool wrapped = compressedTime_ < prevTime;
+            for (const auto& event : compressedClip_->getClip().events) {
+                bool passed = wrapped ? (event.time > prevTime || event.time <= compressedTime_)
+                                      : (prevTime < event.time && compressedTime_ >= event.time);
+                if (passed) {
+                    eventCallback_(event.name);
+                }
+            }
+        }
+    }
 }
 
 void AnimationInstance::applyToSkeleton() {
-    if (!skeleton_ || activeClips_.empty()) return;
-    
-    // Sample first clip as base
-    std::vector<glm::mat4> basePose(skeleton_->bones.size());
-    sampleClip(*activeClips_[0], clipTimes_[0], basePose);
-    
-    // Blend additional clips
-    for (size_t i = 1; i < activeClips_.size(); ++i) {
-        std::vector<glm::mat4> clipPose(skeleton_->bones.size());
-        sampleClip(*activeClips_[i], clipTimes_[i], clipPose);
-        blendPoses(basePose, clipPose, clipWeights_[i], basePose);
+    if (!evaluatePose()) return;
+    finalizePose(localPose_);
+    
+    // Publish to the skeleton for code that reads bones directly
+    std::vector<Bone>& bones = skeleton_->bones;
+    for (size_t i = 0; i < bones.size(); ++i) {
+        bones[i].localTransform = localMatrices_[i];
+        bones[i].globalTransform = boneTransforms_[i];
     }
-    
-    // Apply local transforms to skeleton
-    for (size_t i = 0; i < skeleton_->bones.size(); ++i) {
-        skeleton_->bones[i].localTransform = basePose[i];
+}
+
+bool AnimationInstance::evaluatePose() {
+    if (!skeleton_ || (activeClips_.empty() && !compressedClip_)) return false;
+    
+    // Poses stay in SoA form until every layer is applied; nothing here
+    // allocates once the buffers are sized
+    localPose_ = bindPose_;
+    if (compressedClip_) {
+        compressedClip_->sample(compressedTime_, compressedCursor_, localPose_);
+        return true;
     }
     
-    // Calculate global transforms in hierarchy order
-    for (uint32_t boneIdx : skeleton_->hierarchyOrder) {
-        Bone& bone = skeleton_->bones[boneIdx];
-        if (bone.parentIndex >= 0) {
-            bone.globalTransform = skeleton_->bones[bone.parentIndex].globalTransform * bone.localTransform;
+    sampleClip(*activeClips_[0], clipTimes_[0], localPose_);
+    
+    for (size_t i = 1; i < activeClips_.size(); ++i) {
+        if (clipWeights_[i] <= 0.0f) continue;
+        const float* mask = clipMasks_[i].empty() ? nullptr : clipMasks_[i].data();
+        
+        if (clipAdditive_[i]) {
+            // Additive clips hold deltas; bones without a channel add nothing
+            layerPose_.setIdentity();
+            sampleClip(*activeClips_[i], clipTimes_[i], layerPose_);
+            addLocalPose(localPose_, layerPose_, clipWeights_[i], localPose_, mask);
         } else {
-            bone.globalTransform = bone.localTransform;
+            layerPose_ = bindPose_;
+            sampleClip(*activeClips_[i], clipTimes_[i], layerPose_);
+            blendLocalPoses(localPose_, layerPose_, clipWeights_[i], localPose_, mask);
         }
     }
+    return true;
+}
+
+void AnimationInstance::finalizePose(const LocalPose& pose) {
+    if (!skeleton_) return;
+    
+    pose.toMatrices(localMatrices_.data());
+    computeModelMatrices(*skeleton_, localMatrices_.data(), boneTransforms_.data());
     
     // Apply IK
     if (!ikTargets_.empty()) {
@@ -310,121 +936,69 @@ void AnimationInstance::applyToSkeleton() {
     }
     
     // Calculate skinning matrices
-    for (size_t i = 0; i < skeleton_->bones.size(); ++i) {
-        skinningMatrices_[i] = skeleton_->bones[i].globalTransform * skeleton_->bones[i].inverseBindMatrix;
-        boneTransforms_[i] = skeleton_->bones[i].globalTransform;
+    const std::vector<Bone>& bones = skeleton_->bones;
+    for (size_t i = 0; i < bones.size(); ++i) {
+        multiplyMatrices(boneTransforms_[i], bones[i].inverseBindMatrix, skinningMatrices_[i]);
     }
 }
 
-void AnimationInstance::sampleClip(const AnimationClip& clip, float time, 
-                                   std::vector<glm::mat4>& outTransforms) {
-    // Initialize with identity
-    for (auto& t : outTransforms) {
-        t = glm::mat4(1.0f);
+namespace {
+
+// Last key at or before time, and the blend factor towards the next one
+template<typename Key>
+size_t findKeyframe(const std::vector<Key>& keys, float time, float& outAlpha) {
+    auto next = std::upper_bound(keys.begin(), keys.end(), time,
+                                 [](float t, const Key& key) { return t < key.time; });
+    outAlpha = 0.0f;
+    if (next == keys.begin()) return 0;
+    if (next == keys.end()) return keys.size() - 1;
+    
+    size_t index = static_cast<size_t>(next - keys.begin()) - 1;
+    float dt = next->time - keys[index].time;
+    if (dt > 0.0f) {
+        outAlpha = (time - keys[index].time) / dt;
     }
-    
+    return index;
+}
+
+} // namespace
+
+void AnimationInstance::sampleClip(const AnimationClip& clip, float time, LocalPose& outPose) {
     for (const auto& channel : clip.channels) {
-        if (channel.boneIndex >= outTransforms.size()) continue;
+        uint32_t bone = channel.boneIndex;
+        if (bone >= outPose.boneCount) continue;
         
-        glm::vec3 position(0.0f);
-        glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
-        glm::vec3 scale(1.0f);
-        
-        // Sample position
+        float t;
         if (!channel.positionKeys.empty()) {
-            if (channel.positionKeys.size() == 1) {
-                position = channel.positionKeys[0].value;
-            } else {
-                // Find keyframes
-                size_t nextIdx = 0;
-                for (size_t i = 0; i < channel.positionKeys.size() - 1; ++i) {
-                    if (time < channel.positionKeys[i + 1].time) {
-                        nextIdx = i + 1;
-                        break;
-                    }
-                    nextIdx = i + 1;
-                }
-                
-                size_t prevIdx = nextIdx > 0 ? nextIdx - 1 : 0;
-                float t = 0.0f;
-                
-                float dt = channel.positionKeys[nextIdx].time - channel.positionKeys[prevIdx].time;
-                if (dt > 0.0f) {
-                    t = (time - channel.positionKeys[prevIdx].time) / dt;
-                }
-                
-                position = glm::mix(channel.positionKeys[prevIdx].value, 
-                                   channel.positionKeys[nextIdx].value, t);
-            }
+            const auto& keys = channel.positionKeys;
+            size_t i = findKeyframe(keys, time, t);
+            if (channel.positionInterp == AnimationChannel::Interpolation::Step) t = 0.0f;
+            glm::vec3 position = glm::mix(keys[i].value, keys[std::min(i + 1, keys.size() - 1)].value, t);
+            outPose.tx[bone] = position.x;
+            outPose.ty[bone] = position.y;
+            outPose.tz[bone] = position.z;
         }
         
-        // Sample rotation
         if (!channel.rotationKeys.empty()) {
-            if (channel.rotationKeys.size() == 1) {
-                rotation = channel.rotationKeys[0].value;
-            } else {
-                size_t nextIdx = 0;
-                for (size_t i = 0; i < channel.rotationKeys.size() - 1; ++i) {
-                    if (time < channel.rotationKeys[i + 1].time) {
-                        nextIdx = i + 1;
-                        break;
-                    }
-                    nextIdx = i + 1;
-                }
-                
-                size_t prevIdx = nextIdx > 0 ? nextIdx - 1 : 0;
-                float t = 0.0f;
-                
-                float dt = channel.rotationKeys[nextIdx].time - channel.rotationKeys[prevIdx].time;
-                if (dt > 0.0f) {
-                    t = (time - channel.rotationKeys[prevIdx].time) / dt;
-                }
-                
-                rotation = slerpQuat(channel.rotationKeys[prevIdx].value,
-                                    channel.rotationKeys[nextIdx].value, t);
-            }
+            const auto& keys = channel.rotationKeys;
+            size_t i = findKeyframe(keys, time, t);
+            if (channel.rotationInterp == AnimationChannel::Interpolation::Step) t = 0.0f;
+            glm::quat rotation = slerpQuat(keys[i].value, keys[std::min(i + 1, keys.size() - 1)].value, t);
+            outPose.rx[bone] = rotation.x;
+            outPose.ry[bone] = rotation.y;
+            outPose.rz[bone] = rotation.z;
+            outPose.rw[bone] = rotation.w;
         }
         
-        // Sample scale
         if (!channel.scaleKeys.empty()) {
-            if (channel.scaleKeys.size() == 1) {
-                scale = channel.scaleKeys[0].value;
-            } else {
-                size_t nextIdx = 0;
-                for (size_t i = 0; i < channel.scaleKeys.size() - 1; ++i) {
-                    if (time < channel.scaleKeys[i + 1].time) {
-                        nextIdx = i + 1;
-                        break;
-                    }
-                    nextIdx = i + 1;
-                }
-                
-                size_t prevIdx = nextIdx > 0 ? nextIdx - 1 : 0;
-                float t = 0.0f;
-                
-                float dt = channel.scaleKeys[nextIdx].time - channel.scaleKeys[prevIdx].time;
-                if (dt > 0.0f) {
-                    t = (time - channel.scaleKeys[prevIdx].time) / dt;
-                }
-                
-                scale = glm::mix(channel.scaleKeys[prevIdx].value,
-                                channel.scaleKeys[nextIdx].value, t);
-            }
+            const auto& keys = channel.scaleKeys;
+            size_t i = findKeyframe(keys, time, t);
+            if (channel.scaleInterp == AnimationChannel::Interpolation::Step) t = 0.0f;
+            glm::vec3 scale = glm::mix(keys[i].value, keys[std::min(i + 1, keys.size() - 1)].value, t);
+            outPose.sx[bone] = scale.x;
+            outPose.sy[bone] = scale.y;
+            outPose.sz[bone] = scale.z;
         }
-        
-        // Compose transform
-        glm::mat4 T = glm::translate(glm::mat4(1.0f), position);
-        glm::mat4 R = glm::mat4_cast(rotation);
-        glm::mat4 S = glm::scale(glm::mat4(1.0f), scale);
-        
-        outTransforms[channel.boneIndex] = T * R * S;
-    }
-}
-
-void AnimationInstance::blendPoses(const std::vector<glm::mat4>& a, const std::vector<glm::mat4>& b,
-                                   float weight, std::vector<glm::mat4>& out) {
-    for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
-        out[i] = interpolateTransform(a[i], b[i], weight);
     }
 }
 
@@ -442,22 +1016,23 @@ void AnimationInstance::clearIKTargets() {
 }
 
 void AnimationInstance::solveIK() {
-    // Simple two-bone IK for each target
+    // Simple two-bone IK for each target, on this instance's matrices
+    const std::vector<Bone>& bones = skeleton_->bones;
     for (const auto& target : ikTargets_) {
         // Find bone chain (end effector -> parent -> grandparent)
-        if (target.boneIndex >= skeleton_->bones.size()) continue;
+        if (target.boneIndex >= bones.size()) continue;
         
-        Bone& endBone = skeleton_->bones[target.boneIndex];
-        if (endBone.parentIndex < 0) continue;
+        uint32_t endIdx = target.boneIndex;
+        if (bones[endIdx].parentIndex < 0) continue;
         
-        Bone& midBone = skeleton_->bones[endBone.parentIndex];
-        if (midBone.parentIndex < 0) continue;
+        uint32_t midIdx = static_cast<uint32_t>(bones[endIdx].parentIndex);
+        if (bones[midIdx].parentIndex < 0) continue;
         
-        Bone& startBone = skeleton_->bones[midBone.parentIndex];
+        uint32_t startIdx = static_cast<uint32_t>(bones[midIdx].parentIndex);
         
-        glm::vec3 a = glm::vec3(startBone.globalTransform[3]);
-        glm::vec3 b = glm::vec3(midBone.globalTransform[3]);
-        glm::vec3 c = glm::vec3(endBone.globalTransform[3]);
+        glm::vec3 a = glm::vec3(boneTransforms_[startIdx][3]);
+        glm::vec3 b = glm::vec3(boneTransforms_[midIdx][3]);
+        glm::vec3 c = glm::vec3(boneTransforms_[endIdx][3]);
         
         glm::vec3 targetPos = glm::mix(c, target.targetPosition, target.weight);
         
@@ -467,12 +1042,12 @@ void AnimationInstance::solveIK() {
         
         if (solveTwoBoneIK(a, b, c, targetPos, poleVector, rotA, rotB)) {
             // Apply rotations
-            startBone.localTransform = glm::mat4_cast(rotA) * startBone.localTransform;
-            midBone.localTransform = glm::mat4_cast(rotB) * midBone.localTransform;
+            localMatrices_[startIdx] = glm::mat4_cast(rotA) * localMatrices_[startIdx];
+            localMatrices_[midIdx] = glm::mat4_cast(rotB) * localMatrices_[midIdx];
             
             // Recalculate global transforms
-            midBone.globalTransform = startBone.globalTransform * midBone.localTransform;
-            endBone.globalTransform = midBone.globalTransform * endBone.localTransform;
+            multiplyMatrices(boneTransforms_[startIdx], localMatrices_[midIdx], boneTransforms_[midIdx]);
+            multiplyMatrices(boneTransforms_[midIdx], localMatrices_[endIdx], boneTransforms_[endIdx]);
         }
     }
 }
@@ -619,13 +1194,18 @@ void GPUSkinningSystem::unregisterMesh(uint32_t handle) {
 }
 
 void GPUSkinningSystem::updateBoneMatrices(uint32_t handle, const std::vector<glm::mat4>& matrices) {
+    updateBoneMatrices(handle, matrices.data(), static_cast<uint32_t>(matrices.size()));
+}
+
+void GPUSkinningSystem::updateBoneMatrices(uint32_t handle, const glm::mat4* matrices, uint32_t count) {
     if (handle >= instances_.size()) return;
     
-    instances_[handle].dirty = true;
-    
-    // Map and copy matrices to GPU buffer
-    // This would be done through VMA or direct memory mapping
-    // For now, mark for update
+    SkinningInstance& instance = instances_[handle];
+    if (instance.setup.boneMatrixMapped && matrices) {
+        uint32_t uploaded = std::min(count, instance.setup.maxBones);
+        std::memcpy(instance.setup.boneMatrixMapped, matrices, uploaded * sizeof(glm::mat4));
+    }
+    instance.dirty = true;
 }
 
 void GPUSkinningSystem::dispatchSkinning(VkCommandBuffer cmd) {
@@ -661,6 +1241,162 @@ void GPUSkinningSystem::markBLASForUpdate(uint32_t handle) {
     pendingBLASUpdates_.push_back(handle);
 }
 
+// ============================================================================
+// ANIMATION MANAGER
+// ============================================================================
+
+AnimationManager::AnimationManager() = default;
+AnimationManager::~AnimationManager() = default;
+
+uint32_t AnimationManager::addInstance(AnimationInstance* instance, uint32_t skinningHandle) {
+    if (!instance) return INVALID_HANDLE;
+    
+    uint32_t handle;
+    if (!freeHandles_.empty()) {
+        handle = freeHandles_.back();
+        freeHandles_.pop_back();
+        entries_[handle] = Entry();
+    } else {
+        handle = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+    }
+    
+    Entry& entry = entries_[handle];
+    entry.instance = instance;
+    entry.skinningHandle = skinningHandle;
+    entry.phase = std::fmod(handle * 0.618034f, 1.0f);
+    
+    rebuildBoneOffsets();
+    return handle;
+}
+
+void AnimationManager::removeInstance(uint32_t handle) {
+    if (handle >= entries_.size() || !entries_[handle].instance) return;
+    
+    entries_[handle] = Entry();
+    freeHandles_.push_back(handle);
+    rebuildBoneOffsets();
+}
+
+void AnimationManager::setInstancePosition(uint32_t handle, const glm::vec3& worldPosition) {
+    if (handle < entries_.size()) {
+        entries_[handle].position = worldPosition;
+    }
+}
+
+uint32_t AnimationManager::getBoneOffset(uint32_t handle) const {
+    return handle < entries_.size() ? entries_[handle].boneOffset : 0;
+}
+
+void AnimationManager::rebuildBoneOffsets() {
+    uint32_t offset = 0;
+    for (Entry& entry : entries_) {
+        if (!entry.instance) continue;
+        entry.boneOffset = offset;
+        offset += entry.instance->getBoneCount();
+    }
+    
+    boneMatrices_.resize(offset);
+    for (const Entry& entry : entries_) {
+        if (entry.instance) writeBoneMatrices(entry);
+    }
+}
+
+void AnimationManager::writeBoneMatrices(const Entry& entry) {
+    const std::vector<glm::mat4>& matrices = entry.instance->getSkinningMatrices();
+    std::copy(matrices.begin(), matrices.end(), boneMatrices_.begin() + entry.boneOffset);
+}
+
+void AnimationManager::update(float deltaTime) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    // Rates, clip times and events on this thread
+    stats_.instances = 0;
+    for (Entry& entry : entries_) {
+        if (!entry.instance) continue;
+        stats_.instances++;
+        
+        float distance = glm::distance(entry.position, viewPosition_);
+        float interval = 0.0f;
+        if (distance > lodSettings_.farDistance && lodSettings_.farRate > 0.0f) {
+            interval = 1.0f / lodSettings_.farRate;
+        } else if (distance > lodSettings_.mediumDistance && lodSettings_.mediumRate > 0.0f) {
+            interval = 1.0f / lodSettings_.mediumRate;
+        }
+        if (interval != entry.interval) {
+            entry.interval = interval;
+            entry.sinceEvaluate = entry.phase * interval;
+            entry.hasPreviousPose = false;
+        }
+        
+        entry.instance->advance(deltaTime);
+        entry.sinceEvaluate += deltaTime;
+        entry.evaluateThisFrame = entry.instance->isPlaying() &&
+            (!entry.hasPose || entry.interval <= 0.0f || entry.sinceEvaluate >= entry.interval);
+    }
+    
+    // Pose in parallel; each instance only writes its own buffers and range.
+    // parallelFor splits at multiples of the grain, so begin / grain names
+    // the range and its scratch pose.
+    const size_t grain = 4;
+    JobSystem& jobs = JobSystem::getInstance();
+    scratchPoses_.resize(std::max(scratchPoses_.size(), (entries_.size() + grain - 1) / grain));
+    std::atomic<uint32_t> evaluated{0};
+    std::atomic<uint32_t> interpolated{0};
+    
+    jobs.parallelFor(entries_.size(), grain, [&](size_t begin, size_t end) {
+        LocalPose& scratch = scratchPoses_[begin / grain];
+        
+        for (size_t i = begin; i < end; ++i) {
+            Entry& entry = entries_[i];
+            AnimationInstance* instance = entry.instance;
+            if (!instance) continue;
+            
+            bool interpolate = lodSettings_.interpolate && entry.interval > 0.0f;
+            if (entry.evaluateThisFrame) {
+                if (interpolate && entry.hasPose) {
+                    entry.previousPose = instance->getLocalPose();
+                    entry.hasPreviousPose = true;
+                }
+                if (!instance->evaluatePose()) continue;
+                
+                entry.sinceEvaluate = entry.interval > 0.0f
+                    ? std::fmod(entry.sinceEvaluate, entry.interval) : 0.0f;
+                entry.hasPose = true;
+                evaluated++;
+            }
+            
+            const LocalPose& current = instance->getLocalPose();
+            if (interpolate && entry.hasPreviousPose) {
+                float alpha = std::min(entry.sinceEvaluate / entry.interval, 1.0f);
+                scratch.resize(current.boneCount);
+                blendLocalPoses(entry.previousPose, current, alpha, scratch);
+                instance->finalizePose(scratch);
+                interpolated++;
+            } else if (entry.evaluateThisFrame) {
+                instance->finalizePose(current);
+            } else {
+                continue;   // Keeps last frame's matrices
+            }
+            
+            writeBoneMatrices(entry);
+        }
+    });
+    
+    stats_.evaluated = evaluated.load();
+    stats_.interpolated = interpolated.load();
+    stats_.updateMs = std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+}
+
+void AnimationManager::uploadTo(GPUSkinningSystem& skinning) const {
+    for (const Entry& entry : entries_) {
+        if (!entry.instance || entry.skinningHandle == INVALID_HANDLE) continue;
+        skinning.updateBoneMatrices(entry.skinningHandle, boneMatrices_.data() + entry.boneOffset,
+                                    entry.instance->getBoneCount());
+    }
+}
+
 // ============================================================================
 // ANIMATION LIBRARY
 // ============================================================================
@@ -741,6 +1477,15 @@ glm::quat slerpQuat(const glm::quat& a, const glm::quat& b, float t) {
     return glm::slerp(a, b, t);
 }
 
+void decomposeTransform(const glm::mat4& m, glm::vec3& outTranslation, glm::quat& outRotation, glm::vec3& outScale) {
+    outTranslation = glm::vec3(m[3]);
+    outScale = glm::vec3(glm::length(glm::vec3(m[0])), glm::length(glm::vec3(m[1])), glm::length(glm::vec3(m[2])));
+    
+    glm::vec3 safeScale = glm::max(outScale, glm::vec3(1e-8f));
+    glm::mat3 rotation(glm::vec3(m[0]) / safeScale.x, glm::vec3(m[1]) / safeScale.y, glm::vec3(m[2]) / safeScale.z);
+    outRotation = glm::normalize(glm::quat_cast(rotation));
+}
+
 glm::mat4 interpolateTransform(const glm::mat4& a, const glm::mat4& b, float t) {
     // Decompose matrices
     glm::vec3 posA = glm::vec3(a[3]);
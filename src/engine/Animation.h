@@ -6,6 +6,10 @@
  * Key Features:
  * - Skeleton hierarchy with bone transforms
  * - Animation clips with keyframe interpolation
+ * - Structure-of-arrays local poses with SSE blend, additive and masked-layer kernels
+ * - Allocation-free per-frame update into preallocated pose buffers
+ * - AnimationManager: parallel evaluation with distance-based update rates
+ * - Direct sampling of compressed clips with per-track key cursors
  * - Animation blending and layering
  * - GPU skinning via compute shader (pre-Nanite stage)
  * - Animation state machine for gameplay
@@ -31,6 +35,8 @@ class VulkanContext;
 
 namespace Sanic {
 
+struct CompressedAnimationClip;
+
 // ============================================================================
 // SKELETON DATA STRUCTURES
 // ============================================================================
@@ -119,6 +125,109 @@ struct AnimationClip {
     std::vector<Event> events;
 };
 
+// ============================================================================
+// LOCAL POSE
+// ============================================================================
+
+/**
+ * Bone-local transforms in structure-of-arrays TRS form
+ *
+ * Each component has its own array, padded to a multiple of LANE_WIDTH
+ * bones so kernels can work on whole SIMD lanes. Poses stay in this form
+ * while being sampled; toMatrices() builds the matrices once at the end.
+ */
+struct LocalPose {
+    static constexpr uint32_t LANE_WIDTH = 4;
+    
+    uint32_t boneCount = 0;
+    std::vector<float> tx, ty, tz;          // Translation
+    std::vector<float> rx, ry, rz, rw;      // Rotation quaternion
+    std::vector<float> sx, sy, sz;          // Scale
+    
+    // Resizes to boneCount bones (padding included); new bones are identity
+    void resize(uint32_t count);
+    
+    // Fills every bone with its skeleton localBindPose
+    void setBindPose(const Skeleton& skeleton);
+    
+    // Resets every bone to the identity transform, keeping the size
+    void setIdentity();
+    
+    void setBone(uint32_t bone, const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale);
+    
+    // Writes T * R * S for each bone; outMatrices must hold boneCount matrices
+    void toMatrices(glm::mat4* outMatrices) const;
+};
+
+/*
+ * Pose kernels, four bones per SSE instruction. All poses must have the
+ * same bone count, and out may be one of the inputs. boneMask, if given,
+ * scales weight per bone and must be padded like the pose arrays.
+ */
+
+// Lerp translation and scale, nlerp rotation from a towards b
+void blendLocalPoses(const LocalPose& a, const LocalPose& b, float weight, LocalPose& out,
+                     const float* boneMask = nullptr);
+
+// Apply an additive pose (deltas, see AdditiveAnimationProcessor::makeAdditive):
+// translation is added, rotation pre-multiplied, scale kept from base
+void addLocalPose(const LocalPose& base, const LocalPose& additive, float weight, LocalPose& out,
+                  const float* boneMask = nullptr);
+
+// out = a * b; out may be a or b
+void multiplyMatrices(const glm::mat4& a, const glm::mat4& b, glm::mat4& out);
+
+// Chains local matrices into model space in skeleton.hierarchyOrder
+void computeModelMatrices(const Skeleton& skeleton, const glm::mat4* localMatrices, glm::mat4* outModelMatrices);
+
+// ============================================================================
+// COMPRESSED CLIP SAMPLING
+// ============================================================================
+
+/**
+ * Samples a CompressedAnimationClip straight from its quantized tracks
+ *
+ * Tracks are dequantized and interpolated four at a time with SSE, into a
+ * LocalPose; bones without a track keep the value already in the pose
+ * (normally the bind pose). Rotations are normalized-lerped.
+ *
+ * The sampler holds only per-clip decode constants and is shared by every
+ * instance playing the clip. Each instance keeps its own Cursor, which
+ * remembers the last key of every variable-rate track, so playback moving
+ * forward finds its keys in O(1); seeking back and looping fall back to a
+ * binary search. sample() is const and safe to call from several threads
+ * with different cursors.
+ */
+class CompressedClipSampler {
+public:
+    struct Cursor {
+        const CompressedClipSampler* sampler = nullptr;
+        std::vector<uint32_t> translationKeys;  // Per track
+    };
+    
+    explicit CompressedClipSampler(std::shared_ptr<const CompressedAnimationClip> clip);
+    ~CompressedClipSampler();
+    
+    // Sample at time (seconds, clamped to the clip). Allocates only the
+    // first time a cursor is used with this sampler.
+    void sample(float time, Cursor& cursor, LocalPose& outPose) const;
+    
+    const CompressedAnimationClip& getClip() const { return *clip_; }
+    float getDuration() const;
+    
+private:
+    std::shared_ptr<const CompressedAnimationClip> clip_;
+    uint32_t trackCount_ = 0;
+    
+    // Dequantization constants per track: value = min + scale * quantized
+    std::vector<float> translationMin_[3];
+    std::vector<float> translationScale_[3];
+    std::vector<float> scaleMin_[3];
+    std::vector<float> scaleScale_[3];
+    
+    void resetCursor(Cursor& cursor) const;
+};
+
 // ============================================================================
 // ANIMATION STATE MACHINE
 // ============================================================================
@@ -212,6 +321,10 @@ public:
     
     // Playback control
     void play(const std::string& clipName, float blendTime = 0.2f);
+    
+    // Play a compressed clip, sampled straight from its quantized tracks.
+    // Replaces any playing clips.
+    void playCompressed(std::shared_ptr<const CompressedClipSampler> clip, bool looping = true);
     void stop(float blendTime = 0.2f);
     void pause();
     void resume();
@@ -224,10 +337,30 @@ public:
     void setLayerWeight(uint32_t layer, float weight);
     void addAdditiveLayer(const std::string& clipName, float weight);
     
+    // Limit a layer to some bones: boneWeights[i] scales the layer weight
+    // for bone i (e.g. 1 for the upper body, 0 elsewhere). Empty clears it.
+    void setLayerMask(uint32_t layer, const std::vector<float>& boneWeights);
+    
     // Update and apply
     void update(float deltaTime);
     void applyToSkeleton();
     
+    /*
+     * update() split into steps for AnimationManager. advance() moves clip
+     * times and fires events; evaluatePose() samples and blends the layers
+     * into getLocalPose() (false if nothing is playing); finalizePose()
+     * turns a local pose into this instance's bone, skinning and IK
+     * results. The last two only write to this instance, never to the
+     * shared Skeleton, so different instances can run them in parallel.
+     */
+    void advance(float deltaTime);
+    bool evaluatePose();
+    void finalizePose(const LocalPose& pose);
+    
+    const LocalPose& getLocalPose() const { return localPose_; }
+    bool isPlaying() const { return playing_ && !paused_ && skeleton_ != nullptr; }
+    uint32_t getBoneCount() const { return static_cast<uint32_t>(skinningMatrices_.size()); }
+    
     // Get bone transforms for GPU upload
     const std::vector<glm::mat4>& getSkinningMatrices() const { return skinningMatrices_; }
     const std::vector<glm::mat4>& getBoneTransforms() const { return boneTransforms_; }
@@ -249,10 +382,24 @@ private:
     std::vector<AnimationClip*> activeClips_;
     std::vector<float> clipTimes_;
     std::vector<float> clipWeights_;
+    std::vector<uint8_t> clipAdditive_;
+    std::vector<std::vector<float>> clipMasks_;   // Padded per-bone weights; empty = all bones
     
     std::vector<glm::mat4> boneTransforms_;
     std::vector<glm::mat4> skinningMatrices_;
     
+    // Compressed playback
+    std::shared_ptr<const CompressedClipSampler> compressedClip_;
+    CompressedClipSampler::Cursor compressedCursor_;
+    float compressedTime_ = 0.0f;
+    bool compressedLooping_ = true;
+    
+    // Pose buffers, sized once so updates don't allocate
+    LocalPose bindPose_;
+    LocalPose localPose_;
+    LocalPose layerPose_;
+    std::vector<glm::mat4> localMatrices_;
+    
     float playbackSpeed_ = 1.0f;
     bool playing_ = false;
     bool paused_ = false;
@@ -268,9 +415,10 @@ private:
     };
     std::vector<IKTarget> ikTargets_;
     
-    void sampleClip(const AnimationClip& clip, float time, std::vector<glm::mat4>& outTransforms);
-    void blendPoses(const std::vector<glm::mat4>& a, const std::vector<glm::mat4>& b, 
-                   float weight, std::vector<glm::mat4>& out);
+    // Writes the clip's channels over the bones already in outPose
+    void sampleClip(const AnimationClip& clip, float time, LocalPose& outPose);
+    void pushLayer(AnimationClip* clip, float weight, bool additive);
+    void clearLayers();
     void solveIK();
 };
 
@@ -291,13 +439,17 @@ public:
         VkBuffer boneMatrixBuffer;      // Skinning matrices (updated per frame)
         uint32_t vertexCount;
         uint32_t vertexStride;
+        void* boneMatrixMapped = nullptr;   // Host-coherent boneMatrixBuffer, persistently mapped
+        uint32_t maxBones = 0;              // Matrices boneMatrixBuffer holds
     };
     
     uint32_t registerMesh(const SkinningSetup& setup);
     void unregisterMesh(uint32_t handle);
     
-    // Update bone matrices for an instance
+    // Copy an instance's bone matrices into its mapped bone buffer, up to
+    // maxBones. The buffer must not be in use by an in-flight dispatch.
     void updateBoneMatrices(uint32_t handle, const std::vector<glm::mat4>& matrices);
+    void updateBoneMatrices(uint32_t handle, const glm::mat4* matrices, uint32_t count);
     
     // Dispatch skinning compute shader
     void dispatchSkinning(VkCommandBuffer cmd);
@@ -330,6 +482,94 @@ private:
     void createPipeline();
 };
 
+// ============================================================================
+// ANIMATION MANAGER
+// ============================================================================
+
+struct AnimationLODSettings {
+    float mediumDistance = 25.0f;       // Beyond this, poses update at mediumRate
+    float farDistance = 60.0f;          // Beyond this, at farRate
+    float mediumRate = 15.0f;           // Hz
+    float farRate = 7.5f;               // Hz
+    bool interpolate = true;            // Blend between reduced-rate poses
+};
+
+/**
+ * Evaluates every registered AnimationInstance each frame across the
+ * JobSystem, and gathers their skinning matrices into one contiguous buffer
+ * for GPUSkinningSystem.
+ *
+ * Clip times, events and state machines advance on the calling thread,
+ * since they run user callbacks. Posing runs in parallel, at a rate picked
+ * from the distance to the view: beyond the LOD distances an instance is
+ * re-sampled at 15 or 7.5 Hz, and on the frames between, its last two
+ * poses are blended (trailing by one update interval). Blending costs
+ * much less than sampling every layer.
+ *
+ * Registered instances must outlive their registration and should not
+ * also be updated directly.
+ */
+class AnimationManager {
+public:
+    static constexpr uint32_t INVALID_HANDLE = UINT32_MAX;
+    
+    struct Stats {
+        uint32_t instances = 0;
+        uint32_t evaluated = 0;         // Last frame: sampled
+        uint32_t interpolated = 0;      // Last frame: blended from previous poses
+        float updateMs = 0.0f;
+    };
+    
+    AnimationManager();
+    ~AnimationManager();
+    
+    // skinningHandle: GPUSkinningSystem mesh fed by uploadTo(), if any
+    uint32_t addInstance(AnimationInstance* instance, uint32_t skinningHandle = INVALID_HANDLE);
+    void removeInstance(uint32_t handle);
+    
+    void setInstancePosition(uint32_t handle, const glm::vec3& worldPosition);
+    void setViewPosition(const glm::vec3& position) { viewPosition_ = position; }
+    void setLODSettings(const AnimationLODSettings& settings) { lodSettings_ = settings; }
+    
+    void update(float deltaTime);
+    
+    // Skinning matrices of every instance, back to back
+    const std::vector<glm::mat4>& getBoneMatrices() const { return boneMatrices_; }
+    uint32_t getBoneOffset(uint32_t handle) const;
+    
+    // Hands each instance its range of the buffer
+    void uploadTo(GPUSkinningSystem& skinning) const;
+    
+    const Stats& getStats() const { return stats_; }
+    
+private:
+    struct Entry {
+        AnimationInstance* instance = nullptr;  // nullptr if the handle is free
+        uint32_t skinningHandle = INVALID_HANDLE;
+        uint32_t boneOffset = 0;
+        glm::vec3 position = glm::vec3(0.0f);
+        float interval = 0.0f;          // Seconds between evaluations; 0 = every frame
+        float sinceEvaluate = 0.0f;
+        float phase = 0.0f;             // Staggers evaluations of same-rate instances
+        bool hasPose = false;
+        bool hasPreviousPose = false;
+        bool evaluateThisFrame = false;
+        LocalPose previousPose;
+    };
+    
+    std::vector<Entry> entries_;        // Indexed by handle
+    std::vector<uint32_t> freeHandles_;
+    std::vector<glm::mat4> boneMatrices_;
+    std::vector<LocalPose> scratchPoses_;   // Per parallelFor range
+    
+    glm::vec3 viewPosition_ = glm::vec3(0.0f);
+    AnimationLODSettings lodSettings_;
+    Stats stats_;
+    
+    void rebuildBoneOffsets();
+    void writeBoneMatrices(const Entry& entry);
+};
+
 // ============================================================================
 // ANIMATION LIBRARY
 // ============================================================================
@@ -368,6 +608,9 @@ private:
 glm::quat slerpQuat(const glm::quat& a, const glm::quat& b, float t);
 glm::mat4 interpolateTransform(const glm::mat4& a, const glm::mat4& b, float t);
 
+// Split a T * R * S matrix into its parts
+void decomposeTransform(const glm::mat4& m, glm::vec3& outTranslation, glm::quat& outRotation, glm::vec3& outScale);
+
 // Two-bone IK solver
 bool solveTwoBoneIK(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
                     const glm::vec3& target, const glm::vec3& poleVector,
@@ -5,9 +5,11 @@
  */
 
 #include "AnimationAdvanced.h"
+#include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <unordered_set>
 
 namespace Sanic {
 
@@ -319,6 +321,13 @@ CompressedAnimationClip AnimationCompressor::compress(
         }
         
         // Compress rotation using smallest-3 quaternion encoding
+        bool rotationConstant = true;
+        for (const auto& key : channel.rotationKeys) {
+            if (std::abs(glm::dot(key.value, channel.rotationKeys[0].value)) < 1.0f - settings.constantThreshold) {
+                rotationConstant = false;
+                break;
+            }
+        }
         if (!channel.rotationKeys.empty()) {
             for (const auto& key : channel.rotationKeys) {
                 uint16_t compressed[3];
@@ -340,6 +349,7 @@ CompressedAnimationClip AnimationCompressor::compress(
             }
             
             track.scaleRange = scaleMax - track.scaleMin;
+            isConstant = isConstant && glm::length(track.scaleRange) < settings.constantThreshold;
             
             for (const auto& key : channel.scaleKeys) {
                 glm::vec3 normalized = (key.value - track.scaleMin) / 
@@ -351,13 +361,31 @@ CompressedAnimationClip AnimationCompressor::compress(
             }
         }
         
-        track.isConstant = isConstant && track.isConstant;
+        // Constant only if no channel moves
+        track.isConstant = isConstant && rotationConstant &&
+                           (channel.positionKeys.empty() || track.isConstant);
         
-        // Skip identity tracks if configured
-        if (settings.removeIdentityTracks && track.isConstant) {
-            // Check if this is an identity transform
+        // Skip tracks that just hold the bind pose if configured; samplers
+        // leave those bones at the bind pose
+        if (settings.removeIdentityTracks && track.isConstant && channel.boneIndex < skeleton.bones.size()) {
+            glm::vec3 bindTranslation, bindScale;
+            glm::quat bindRotation;
+            decomposeTransform(skeleton.bones[channel.boneIndex].localBindPose,
+                               bindTranslation, bindRotation, bindScale);
+            
             bool isIdentity = true;
-            // ... identity check logic
+            if (!channel.positionKeys.empty()) {
+                isIdentity &= glm::distance(channel.positionKeys[0].value, bindTranslation) <
+                              settings.translationErrorThreshold;
+            }
+            if (!channel.rotationKeys.empty()) {
+                isIdentity &= std::abs(glm::dot(channel.rotationKeys[0].value, bindRotation)) >
+                              1.0f - settings.constantThreshold;
+            }
+            if (!channel.scaleKeys.empty()) {
+                isIdentity &= glm::distance(channel.scaleKeys[0].value, bindScale) <
+                              settings.scaleErrorThreshold;
+            }
             if (isIdentity) continue;
         }
         
@@ -383,7 +411,7 @@ CompressedAnimationClip AnimationCompressor::compress(
 
 AnimationClip AnimationCompressor::decompress(
     const CompressedAnimationClip& compressed,
-    const Skeleton& skeleton
+    const Skeleton& /*skeleton*/
 ) {
     AnimationClip result;
     result.name = compressed.name;
@@ -412,7 +440,7 @@ AnimationClip AnimationCompressor::decompress(
                 track.translationData[i * 3 + 2] / 65535.0f
             );
             
-            key.value = track.translationMin + normalized * track.translationRange;
+            key.value = track.translationMin + normalized * glm::max(track.translationRange, glm::vec3(0.0001f));
             channel.positionKeys.push_back(key);
         }
         
@@ -443,7 +471,7 @@ AnimationClip AnimationCompressor::decompress(
                 track.scaleData[i * 3 + 2] / 65535.0f
             );
             
-            key.value = track.scaleMin + normalized * track.scaleRange;
+            key.value = track.scaleMin + normalized * glm::max(track.scaleRange, glm::vec3(0.0001f));
             channel.scaleKeys.push_back(key);
         }
         
@@ -453,6 +481,22 @@ AnimationClip AnimationCompressor::decompress(
     return result;
 }
 
+void AnimationCompressor::sampleCompressed(
+    const CompressedAnimationClip& compressed,
+    float time,
+    std::vector<glm::mat4>& outBoneTransforms
+) {
+    // One-off sample; players should keep a CompressedClipSampler and cursor
+    std::shared_ptr<const CompressedAnimationClip> clip(&compressed, [](const CompressedAnimationClip*) {});
+    CompressedClipSampler sampler(clip);
+    CompressedClipSampler::Cursor cursor;
+    
+    LocalPose pose;
+    pose.resize(static_cast<uint32_t>(outBoneTransforms.size()));
+    sampler.sample(time, cursor, pose);
+    pose.toMatrices(outBoneTransforms.data());
+}
+
 void AnimationCompressor::compressQuaternion(const glm::quat& q, uint16_t* out) {
     // Smallest-3 encoding: drop the largest component, encode the other 3
     // With sign bit recovery using the dropped component's known constraint
@@ -472,22 +516,29 @@ void AnimationCompressor::compressQuaternion(const glm::quat& q, uint16_t* out)
     // Ensure the dropped component is positive (quaternion negation invariance)
     float sign = components[largestIdx] >= 0 ? 1.0f : -1.0f;
     
-    // Encode 3 components + 2-bit index = 48 bits total (3 x 16-bit)
+    // 16 + 16 + 14 bits for the 3 components, 2 bits for the index = 48 bits
+    const float scales[3] = {65535.0f, 65535.0f, 16383.0f};
     int outIdx = 0;
     for (int i = 0; i < 4; ++i) {
         if (i != largestIdx) {
             // Range is [-1/sqrt(2), 1/sqrt(2)] for non-largest components
             float normalized = (components[i] * sign + 0.7071067811865f) / 1.4142135623731f;
-            out[outIdx++] = static_cast<uint16_t>(std::clamp(normalized, 0.0f, 1.0f) * 65535);
+            out[outIdx] = static_cast<uint16_t>(std::clamp(normalized, 0.0f, 1.0f) * scales[outIdx] + 0.5f);
+            ++outIdx;
         }
     }
     
     // Encode largest index in high bits of last component
-    out[2] = (out[2] & 0x3FFF) | (static_cast<uint16_t>(largestIdx) << 14);
+    out[2] = static_cast<uint16_t>(out[2] | (largestIdx << 14));
 }
 
 glm::quat AnimationCompressor::decompressQuaternion(const uint16_t* data) {
     int largestIdx = (data[2] >> 14) & 0x3;
+    const float values[3] = {
+        data[0] / 65535.0f,
+        data[1] / 65535.0f,
+        (data[2] & 0x3FFF) / 16383.0f
+    };
     
     float components[4];
     float sumSquares = 0.0f;
@@ -495,15 +546,7 @@ glm::quat AnimationCompressor::decompressQuaternion(const uint16_t* data) {
     int dataIdx = 0;
     for (int i = 0; i < 4; ++i) {
         if (i != largestIdx) {
-            uint16_t val = (i == 2 || (i > 2 && largestIdx <= 2)) ? 
-                           (data[dataIdx] & 0x3FFF) : data[dataIdx];
-            if (i == 2 && largestIdx != 2) {
-                val = data[dataIdx]; // Use full 16 bits for first two
-            }
-            
-            // Actually simpler decode
-            float normalized = data[dataIdx++] / 65535.0f;
-            components[i] = normalized * 1.4142135623731f - 0.7071067811865f;
+            components[i] = values[dataIdx++] * 1.4142135623731f - 0.7071067811865f;
             sumSquares += components[i] * components[i];
         }
     }
@@ -569,7 +612,7 @@ std::shared_ptr<AnimationClip> AnimationRetargeter::retarget(
     const Skeleton& sourceSkeleton,
     const Skeleton& targetSkeleton,
     const RetargetingProfile& profile,
-    ERetargetingMode mode
+    ERetargetingMode /*mode*/
 ) {
     auto result = std::make_shared<AnimationClip>();
     result->name = sourceClip.name + "_retargeted";
@@ -599,10 +642,6 @@ std::shared_ptr<AnimationClip> AnimationRetargeter::retarget(
         AnimationChannel dstChannel;
         dstChannel.boneIndex = targetBoneIdx;
         
-        // Get bind poses
-        const Bone& srcBone = sourceSkeleton.bones[srcChannel.boneIndex];
-        const Bone& dstBone = targetSkeleton.bones[targetBoneIdx];
-        
         // Retarget position keyframes
         for (const auto& srcKey : srcChannel.positionKeys) {
             PositionKeyframe dstKey;
@@ -680,7 +719,7 @@ RetargetingProfile AnimationRetargeter::createProfile(
         for (const auto& bone : skeleton.bones) {
             std::string normalized = normalizeNoneName(bone.name);
             for (const auto& pattern : patterns) {
-                if (normalized.find(pattern) != std::string::npos) {
+                if (normalized == pattern) {
                     return bone.name;
                 }
             }
@@ -727,6 +766,30 @@ RetargetingProfile AnimationRetargeter::createProfile(
         }
     }
     
+    // Finally map common rig names the two skeletons spell differently
+    auto isMapped = [&](const std::string& name, bool source) {
+        for (const auto& existing : profile.boneMappings) {
+            if ((source ? existing.sourceBone : existing.targetBone) == name) return true;
+        }
+        return false;
+    };
+    
+    for (const auto& [patterns, canonicalName] : bonePatterns) {
+        std::string srcName = findMatchingBone(source, patterns);
+        if (srcName.empty() || isMapped(srcName, true)) continue;
+        
+        std::vector<std::string> targetPatterns = patterns;
+        targetPatterns.push_back(normalizeNoneName(canonicalName));
+        std::string dstName = findMatchingBone(target, targetPatterns);
+        if (dstName.empty() || isMapped(dstName, false)) continue;
+        
+        BoneMapping mapping;
+        mapping.sourceBone = srcName;
+        mapping.targetBone = dstName;
+        mapping.lengthScale = 1.0f;
+        profile.boneMappings.push_back(mapping);
+    }
+    
     return profile;
 }
 
@@ -983,7 +1046,6 @@ void AnimationMontage::play(float startTime) {
 void AnimationMontage::update(float deltaTime) {
     if (!playing_ || paused_) return;
     
-    float prevPosition = position_;
     position_ += deltaTime * playRate_;
     
     // Find current section and handle transitions
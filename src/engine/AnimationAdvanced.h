@@ -195,7 +195,8 @@ struct CompressedAnimationClip {
         glm::vec3 translationMin;
         glm::vec3 translationRange;
         
-        // Rotation: smallest-3 quaternion compression
+        // Rotation: smallest-3 quaternion compression, 16 + 16 + 14 bits
+        // plus the dropped component's index in the top 2 bits
         std::vector<uint16_t> rotationData;  // 48 bits per quaternion
         
         // Scale: quantized
@@ -242,7 +243,9 @@ public:
     );
     
     /**
-     * Sample compressed animation at time
+     * Sample compressed animation at time into local transforms (identity
+     * for bones without a track). For playback, keep a
+     * CompressedClipSampler and cursor per instance instead.
      */
     static void sampleCompressed(
         const CompressedAnimationClip& compressed,
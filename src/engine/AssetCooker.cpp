@@ -7,15 +7,21 @@
 
 #include "AssetCooker.h"
 #include "SanicAssetFormat.h"
+#include "DataCompression.h"
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <chrono>
 #include <algorithm>
 #include <cstring>
 #include <cmath>
+#include <limits>
 #include <unordered_map>
 #include <queue>
+#include <filesystem>
+#include <mutex>
+#include <thread>
 
 // External libraries
 #include <meshoptimizer.h>
@@ -29,9 +35,8 @@ namespace Sanic {
 // UTILITY FUNCTIONS
 // ============================================================================
 
-uint64_t calculateSourceHash(const void* data, size_t size) {
-    // FNV-1a hash
-    uint64_t hash = 14695981039346656037ULL;
+// FNV-1a, continuing from an existing hash
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
     const uint8_t* bytes = static_cast<const uint8_t*>(data);
     for (size_t i = 0; i < size; i++) {
         hash ^= bytes[i];
@@ -40,6 +45,186 @@ uint64_t calculateSourceHash(const void* data, size_t size) {
     return hash;
 }
 
+template<typename T>
+static uint64_t hashValue(uint64_t hash, const T& value) {
+    return hashBytes(hash, &value, sizeof(T));
+}
+
+uint64_t calculateSourceHash(const void* data, size_t size) {
+    return hashBytes(14695981039346656037ULL, data, size);
+}
+
+static bool readSourceFile(const std::string& path, std::vector<char>& outBytes) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    
+    outBytes.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    return static_cast<bool>(file.read(outBytes.data(), outBytes.size()));
+}
+
+// Files an OBJ pulls in: its material libraries and the textures they name.
+// Names are resolved against the OBJ's directory, as loadFromOBJ does.
+static std::vector<std::string> findObjDependencies(const std::vector<char>& objBytes,
+                                                    const std::string& baseDir) {
+    std::vector<std::string> dependencies;
+    
+    std::istringstream obj(std::string(objBytes.begin(), objBytes.end()));
+    std::string line;
+    while (std::getline(obj, line)) {
+        std::istringstream tokens(line);
+        std::string keyword, name;
+        if (!(tokens >> keyword) || keyword != "mtllib") continue;
+        while (tokens >> name) {
+            dependencies.push_back(baseDir + name);
+        }
+    }
+    
+    // Texture statements end in the file name; any options come before it
+    size_t libraryCount = dependencies.size();
+    for (size_t i = 0; i < libraryCount; i++) {
+        std::vector<char> mtlBytes;
+        if (!readSourceFile(dependencies[i], mtlBytes)) continue;
+        
+        std::istringstream mtl(std::string(mtlBytes.begin(), mtlBytes.end()));
+        while (std::getline(mtl, line)) {
+            std::istringstream tokens(line);
+            std::string keyword, token, name;
+            if (!(tokens >> keyword)) continue;
+            if (keyword.compare(0, 4, "map_") != 0 && keyword != "bump" && keyword != "disp" &&
+                keyword != "decal" && keyword != "refl" && keyword != "norm") {
+                continue;
+            }
+            while (tokens >> token) {
+                name = token;
+            }
+            if (!name.empty()) {
+                dependencies.push_back(baseDir + name);
+            }
+        }
+    }
+    
+    return dependencies;
+}
+
+// Files a glTF references by URI: external buffers and images
+static std::vector<std::string> findGltfDependencies(const std::vector<char>& gltfBytes,
+                                                     const std::string& baseDir) {
+    std::vector<std::string> dependencies;
+    
+    std::string json(gltfBytes.begin(), gltfBytes.end());
+    const std::string key = "\"uri\"";
+    for (size_t pos = json.find(key); pos != std::string::npos; pos = json.find(key, pos)) {
+        pos += key.size();
+        size_t open = json.find('"', json.find(':', pos));
+        size_t close = open == std::string::npos ? open : json.find('"', open + 1);
+        if (close == std::string::npos) break;
+        
+        std::string uri = json.substr(open + 1, close - open - 1);
+        if (uri.compare(0, 5, "data:") != 0) {
+            dependencies.push_back(baseDir + uri);
+        }
+        pos = close + 1;
+    }
+    
+    return dependencies;
+}
+
+// Hashes a source file together with every file it depends on, so editing a
+// material library or texture re-cooks the mesh. A missing dependency hashes
+// as missing, so creating it later does too.
+static bool hashSourceFile(const std::string& path, const std::string& ext, uint64_t& outHash) {
+    std::vector<char> bytes;
+    if (!readSourceFile(path, bytes)) {
+        return false;
+    }
+    outHash = calculateSourceHash(bytes.data(), bytes.size());
+    
+    std::string baseDir = path.substr(0, path.find_last_of("/\\") + 1);
+    std::vector<std::string> dependencies;
+    if (ext == "obj") {
+        dependencies = findObjDependencies(bytes, baseDir);
+    } else if (ext == "gltf") {
+        dependencies = findGltfDependencies(bytes, baseDir);
+    }
+    
+    for (const std::string& dependency : dependencies) {
+        outHash = hashBytes(outHash, dependency.data(), dependency.size());
+        
+        std::vector<char> dependencyBytes;
+        bool found = readSourceFile(dependency, dependencyBytes);
+        outHash = hashValue(outHash, found);
+        if (found) {
+            outHash = hashValue(outHash, calculateSourceHash(dependencyBytes.data(), dependencyBytes.size()));
+        }
+    }
+    return true;
+}
+
+// Everything that affects cooked output; thread counts and logging don't
+static uint64_t hashCookerConfig(const CookerConfig& config) {
+    uint64_t hash = hashValue(14695981039346656037ULL, SANIC_VERSION);
+    hash = hashValue(hash, config.maxMeshletsPerCluster);
+    hash = hashValue(hash, config.maxVerticesPerMeshlet);
+    hash = hashValue(hash, config.maxTrianglesPerMeshlet);
+    hash = hashValue(hash, config.maxLodLevels);
+    hash = hashValue(hash, config.lodErrorThreshold);
+    hash = hashValue(hash, config.clusterGroupingFactor);
+    hash = hashValue(hash, config.generateImpostors);
+    hash = hashValue(hash, config.sdfResolution);
+    hash = hashValue(hash, config.sdfPadding);
+    hash = hashValue(hash, config.maxSurfaceCards);
+    hash = hashValue(hash, config.cardMinArea);
+    hash = hashValue(hash, config.cardTexelDensity);
+    hash = hashValue(hash, config.bakeSurfaceCardTextures);
+    hash = hashValue(hash, config.generateConvexHulls);
+    hash = hashValue(hash, config.maxConvexHulls);
+    hash = hashValue(hash, config.maxConvexVertices);
+    hash = hashValue(hash, config.generateTriangleMesh);
+    hash = hashValue(hash, config.physicsMeshSimplification);
+    hash = hashValue(hash, config.compressPages);
+    hash = hashValue(hash, config.compressionLevel);
+    hash = hashValue(hash, config.writeStreamingFile);
+    return hash;
+}
+
+static double compressionRatio(const CookingStats& stats) {
+    return stats.compressedSize > 0 ? static_cast<double>(stats.totalSize) / stats.compressedSize : 1.0;
+}
+
+static void accumulateStats(CookingStats& total, const CookingStats& stats) {
+    total.inputVertices += stats.inputVertices;
+    total.inputTriangles += stats.inputTriangles;
+    total.inputMaterials += stats.inputMaterials;
+    total.outputClusters += stats.outputClusters;
+    total.outputMeshlets += stats.outputMeshlets;
+    total.outputHierarchyNodes += stats.outputHierarchyNodes;
+    total.outputPages += stats.outputPages;
+    total.outputLodLevels = std::max(total.outputLodLevels, stats.outputLodLevels);
+    total.sdfVoxels += stats.sdfVoxels;
+    total.surfaceCards += stats.surfaceCards;
+    total.geometrySize += stats.geometrySize;
+    total.naniteSize += stats.naniteSize;
+    total.lumenSize += stats.lumenSize;
+    total.physicsSize += stats.physicsSize;
+    total.totalSize += stats.totalSize;
+    total.compressedSize += stats.compressedSize;
+    total.loadTime += stats.loadTime;
+    total.meshletGenerationTime += stats.meshletGenerationTime;
+    total.clusterHierarchyTime += stats.clusterHierarchyTime;
+    total.sdfGenerationTime += stats.sdfGenerationTime;
+    total.surfaceCardTime += stats.surfaceCardTime;
+    total.physicsTime += stats.physicsTime;
+    total.compressionTime += stats.compressionTime;
+    total.assemblyTime += stats.assemblyTime;
+    total.writeTime += stats.writeTime;
+    total.assetsCooked += stats.assetsCooked;
+    total.assetsSkipped += stats.assetsSkipped;
+    total.assetsFailed += stats.assetsFailed;
+}
+
 static double getCurrentTimeMs() {
     using namespace std::chrono;
     return duration_cast<duration<double, std::milli>>(
@@ -61,6 +246,10 @@ void AssetCooker::setConfig(const CookerConfig& config) {
     config_ = config;
 }
 
+JobSystem& AssetCooker::getJobSystem() const {
+    return jobSystem_ ? *jobSystem_ : JobSystem::getInstance();
+}
+
 void AssetCooker::reportProgress(const std::string& stage, float progress) {
     if (progressCallback_) {
         progressCallback_(stage, progress);
@@ -229,104 +418,123 @@ bool AssetCooker::cook(const InputAsset& input, const std::string& outputPath) {
     
     reportProgress("Starting cook", 0.0f);
     
-    // ========================================================================
-    // STAGE 1: Build Meshlets
-    // ========================================================================
-    reportProgress("Building meshlets", 0.1f);
-    double meshletStart = getCurrentTimeMs();
+    // SDF, surface cards and physics only read the input mesh, so they run
+    // as jobs alongside the meshlet -> cluster -> page chain below.
+    JobSystem& jobs = getJobSystem();
+    JobCounter stageCounter;
     
-    std::vector<CookedMeshlet> meshlets;
-    std::vector<uint32_t> meshletVertices;
-    std::vector<uint8_t> meshletTriangles;
+    std::vector<float> sdfVolume;
+    glm::ivec3 sdfResolution(0);
+    float sdfVoxelSize = 0.0f;
+    bool sdfSucceeded = false;
     
-    if (!buildMeshlets(input.mesh, meshlets, meshletVertices, meshletTriangles)) {
-        return false;
-    }
+    jobs.submit([&] {
+        double sdfStart = getCurrentTimeMs();
+        sdfSucceeded = generateSDF(input.mesh, sdfVolume, sdfResolution, sdfVoxelSize);
+        stats_.sdfGenerationTime = getCurrentTimeMs() - sdfStart;
+    }, &stageCounter);
     
-    stats_.meshletGenerationTime = getCurrentTimeMs() - meshletStart;
-    stats_.outputMeshlets = static_cast<uint32_t>(meshlets.size());
+    std::vector<CookedSurfaceCard> surfaceCards;
+    bool cardsSucceeded = false;
     
-    // ========================================================================
-    // STAGE 2: Build Cluster Hierarchy
-    // ========================================================================
-    reportProgress("Building cluster hierarchy", 0.25f);
-    double clusterStart = getCurrentTimeMs();
+    jobs.submit([&] {
+        double cardStart = getCurrentTimeMs();
+        cardsSucceeded = generateSurfaceCards(input.mesh, surfaceCards);
+        stats_.surfaceCardTime = getCurrentTimeMs() - cardStart;
+    }, &stageCounter);
+    
+    std::vector<uint8_t> joltData;
+    std::vector<uint8_t> simpleShapes;
+    bool physicsSucceeded = false;
     
+    jobs.submit([&] {
+        double physicsStart = getCurrentTimeMs();
+        physicsSucceeded = generatePhysicsData(input.mesh, joltData, simpleShapes);
+        stats_.physicsTime = getCurrentTimeMs() - physicsStart;
+    }, &stageCounter);
+    
+    std::vector<CookedMeshlet> meshlets;
+    std::vector<uint32_t> meshletVertices;
+    std::vector<uint8_t> meshletTriangles;
     std::vector<CookedCluster> clusters;
     std::vector<CookedHierarchyNode> hierarchyNodes;
+    std::vector<PageTableEntry> pages;
     
-    if (!buildClusterHierarchy(input.mesh, meshlets, clusters, hierarchyNodes)) {
-        return false;
-    }
+    auto buildGeometry = [&]() -> bool {
+        // ====================================================================
+        // STAGE 1: Build Meshlets
+        // ====================================================================
+        reportProgress("Building meshlets", 0.1f);
+        double meshletStart = getCurrentTimeMs();
+        
+        if (!buildMeshlets(input.mesh, meshlets, meshletVertices, meshletTriangles)) {
+            return false;
+        }
+        
+        stats_.meshletGenerationTime = getCurrentTimeMs() - meshletStart;
+        stats_.outputMeshlets = static_cast<uint32_t>(meshlets.size());
+        
+        // ====================================================================
+        // STAGE 2: Build Cluster Hierarchy
+        // ====================================================================
+        reportProgress("Building cluster hierarchy", 0.25f);
+        double clusterStart = getCurrentTimeMs();
+        
+        if (!buildClusterHierarchy(input.mesh, meshlets, clusters, hierarchyNodes)) {
+            return false;
+        }
+        
+        stats_.clusterHierarchyTime = getCurrentTimeMs() - clusterStart;
+        stats_.outputClusters = static_cast<uint32_t>(clusters.size());
+        stats_.outputHierarchyNodes = static_cast<uint32_t>(hierarchyNodes.size());
+        
+        // ====================================================================
+        // STAGE 3: Build Cluster Pages
+        // ====================================================================
+        reportProgress("Building cluster pages", 0.35f);
+        
+        if (!buildClusterPages(clusters, pages)) {
+            return false;
+        }
+        stats_.outputPages = static_cast<uint32_t>(pages.size());
+        return true;
+    };
     
-    stats_.clusterHierarchyTime = getCurrentTimeMs() - clusterStart;
-    stats_.outputClusters = static_cast<uint32_t>(clusters.size());
-    stats_.outputHierarchyNodes = static_cast<uint32_t>(hierarchyNodes.size());
+    bool geometrySucceeded = buildGeometry();
     
     // ========================================================================
-    // STAGE 3: Build Cluster Pages
+    // STAGES 4-6: SDF, Surface Cards, Physics (running since the start)
     // ========================================================================
-    reportProgress("Building cluster pages", 0.35f);
+    reportProgress("Waiting for SDF, surface cards and physics", 0.6f);
+    jobs.wait(stageCounter);
     
-    std::vector<PageTableEntry> pages;
-    if (!buildClusterPages(clusters, pages)) {
+    if (!geometrySucceeded) {
         return false;
     }
-    stats_.outputPages = static_cast<uint32_t>(pages.size());
-    
-    // ========================================================================
-    // STAGE 4: Generate SDF
-    // ========================================================================
-    reportProgress("Generating SDF", 0.45f);
-    double sdfStart = getCurrentTimeMs();
-    
-    std::vector<float> sdfVolume;
-    glm::ivec3 sdfResolution;
-    float sdfVoxelSize;
-    
-    if (!generateSDF(input.mesh, sdfVolume, sdfResolution, sdfVoxelSize)) {
+    if (!sdfSucceeded) {
+        lastError_ = "Failed to generate SDF";
         return false;
     }
-    
-    stats_.sdfGenerationTime = getCurrentTimeMs() - sdfStart;
-    stats_.sdfVoxels = sdfResolution.x * sdfResolution.y * sdfResolution.z;
-    
-    // ========================================================================
-    // STAGE 5: Generate Surface Cards
-    // ========================================================================
-    reportProgress("Generating surface cards", 0.6f);
-    double cardStart = getCurrentTimeMs();
-    
-    std::vector<CookedSurfaceCard> surfaceCards;
-    if (!generateSurfaceCards(input.mesh, surfaceCards)) {
+    if (!cardsSucceeded) {
+        lastError_ = "Failed to generate surface cards";
         return false;
     }
     
-    stats_.surfaceCardTime = getCurrentTimeMs() - cardStart;
+    stats_.sdfVoxels = sdfResolution.x * sdfResolution.y * sdfResolution.z;
     stats_.surfaceCards = static_cast<uint32_t>(surfaceCards.size());
     
-    // ========================================================================
-    // STAGE 6: Generate Physics Data
-    // ========================================================================
-    reportProgress("Generating physics data", 0.75f);
-    double physicsStart = getCurrentTimeMs();
-    
-    std::vector<uint8_t> joltData;
-    std::vector<uint8_t> simpleShapes;
-    
-    if (!generatePhysicsData(input.mesh, joltData, simpleShapes)) {
+    if (!physicsSucceeded) {
         // Physics is optional - continue without it
         if (config_.verbose) {
             std::cout << "Warning: Physics generation failed" << std::endl;
         }
     }
     
-    stats_.physicsTime = getCurrentTimeMs() - physicsStart;
-    
     // ========================================================================
     // STAGE 7: Assemble Sections
     // ========================================================================
     reportProgress("Assembling sections", 0.85f);
+    double assemblyStart = getCurrentTimeMs();
     
     // Geometry section
     std::vector<uint8_t> geometryData;
@@ -485,10 +693,27 @@ bool AssetCooker::cook(const InputAsset& input, const std::string& outputPath) {
         }
     }
     
+    stats_.assemblyTime = getCurrentTimeMs() - assemblyStart;
+    
+    // ========================================================================
+    // STAGE 8: Compress Sections
     // ========================================================================
-    // STAGE 8: Write File
+    reportProgress("Compressing sections", 0.9f);
+    double compressionStart = getCurrentTimeMs();
+    
+    std::vector<uint8_t> geometrySection = packSection(SectionType::Geometry, geometryData);
+    std::vector<uint8_t> naniteSection = packNaniteSection(naniteData);
+    std::vector<uint8_t> lumenSection = packSection(SectionType::Lumen, lumenData);
+    std::vector<uint8_t> physicsSection = packSection(SectionType::Physics, physicsData);
+    std::vector<uint8_t> materialSection = packSection(SectionType::Material, materialData);
+    
+    stats_.compressionTime = getCurrentTimeMs() - compressionStart;
+    
+    // ========================================================================
+    // STAGE 9: Write File
     // ========================================================================
     reportProgress("Writing output file", 0.95f);
+    double writeStart = getCurrentTimeMs();
     
     AssetHeader header{};
     header.magic = SANIC_MAGIC;
@@ -501,23 +726,34 @@ bool AssetCooker::cook(const InputAsset& input, const std::string& outputPath) {
     if (!input.materials.empty()) {
         header.flags |= static_cast<uint32_t>(AssetFlags::HasMaterials);
     }
+    if (config_.compressPages) {
+        header.flags |= static_cast<uint32_t>(AssetFlags::Compressed);
+    }
     
     header.boundsMin = input.mesh.boundsMin;
     header.boundsMax = input.mesh.boundsMax;
     
     strncpy(header.assetName, input.mesh.name.c_str(), 63);
     header.sourceHash = input.mesh.sourceHash;
+    header.cookSettingsHash = hashCookerConfig(config_);
     header.cookTimestamp = std::chrono::duration_cast<std::chrono::seconds>(
         std::chrono::system_clock::now().time_since_epoch()
     ).count();
     
-    if (!writeAssetFile(outputPath, header, geometryData, naniteData, lumenData, physicsData, materialData)) {
+    if (!writeAssetFile(outputPath, header, geometrySection, naniteSection, lumenSection, physicsSection, materialSection)) {
+        return false;
+    }
+    if (config_.writeStreamingFile && !writeStreamingFile(outputPath + ".nanite", naniteData, naniteSection)) {
         return false;
     }
     
+    stats_.writeTime = getCurrentTimeMs() - writeStart;
     stats_.totalSize = stats_.geometrySize + stats_.naniteSize + stats_.lumenSize + 
                        stats_.physicsSize + materialData.size() + sizeof(AssetHeader);
+    stats_.compressedSize = sizeof(AssetHeader) + geometrySection.size() + naniteSection.size() +
+                            lumenSection.size() + physicsSection.size() + materialSection.size();
     stats_.totalTime = getCurrentTimeMs() - startTime;
+    stats_.assetsCooked = 1;
     
     reportProgress("Complete", 1.0f);
     
@@ -529,6 +765,8 @@ bool AssetCooker::cook(const InputAsset& input, const std::string& outputPath) {
         std::cout << "  SDF voxels: " << stats_.sdfVoxels << std::endl;
         std::cout << "  Surface cards: " << stats_.surfaceCards << std::endl;
         std::cout << "  Total size: " << stats_.totalSize / 1024 << " KB" << std::endl;
+        std::cout << "  File size: " << stats_.compressedSize / 1024 << " KB ("
+                  << compressionRatio(stats_) << ":1, " << stats_.compressionTime << " ms)" << std::endl;
         std::cout << "  Total time: " << stats_.totalTime << " ms" << std::endl;
     }
     
@@ -536,44 +774,179 @@ bool AssetCooker::cook(const InputAsset& input, const std::string& outputPath) {
 }
 
 bool AssetCooker::cookFile(const std::string& inputPath, const std::string& outputPath) {
+    double startTime = getCurrentTimeMs();
     InputAsset asset;
     
     // Determine format from extension
     std::string ext = inputPath.substr(inputPath.find_last_of('.') + 1);
     std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
     
+    if (ext != "obj" && ext != "gltf" && ext != "glb") {
+        lastError_ = "Unsupported format: " + ext;
+        return false;
+    }
+    
+    uint64_t sourceHash = 0;
+    if (!hashSourceFile(inputPath, ext, sourceHash)) {
+        lastError_ = "Failed to read input file: " + inputPath;
+        return false;
+    }
+    
+    if (config_.skipUnchanged && !config_.dryRun && isUpToDate(outputPath, sourceHash)) {
+        stats_ = {};
+        stats_.assetsSkipped = 1;
+        if (config_.verbose) {
+            std::cout << "Up to date: " << outputPath << std::endl;
+        }
+        return true;
+    }
+    
     if (ext == "obj") {
         if (!loadFromOBJ(inputPath, asset)) {
             return false;
         }
-    } else if (ext == "gltf" || ext == "glb") {
+    } else {
         if (!loadFromGLTF(inputPath, asset)) {
             return false;
         }
-    } else {
-        lastError_ = "Unsupported format: " + ext;
+    }
+    
+    // Identify the asset by its source files, not the decoded vertex data
+    asset.mesh.sourceHash = sourceHash;
+    double loadTime = getCurrentTimeMs() - startTime;
+    
+    if (!cook(asset, outputPath)) {
         return false;
     }
     
-    return cook(asset, outputPath);
+    stats_.loadTime = loadTime;
+    stats_.totalTime += loadTime;
+    return true;
+}
+
+bool AssetCooker::isUpToDate(const std::string& outputPath, uint64_t sourceHash) const {
+    std::ifstream file(outputPath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    if (fileSize < sizeof(AssetHeader)) {
+        return false;
+    }
+    
+    AssetHeader header{};
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(AssetHeader))) {
+        return false;
+    }
+    
+    if (config_.writeStreamingFile && !std::filesystem::exists(outputPath + ".nanite")) {
+        return false;
+    }
+    
+    return header.magic == SANIC_MAGIC &&
+           header.version == SANIC_VERSION &&
+           header.totalSize == fileSize &&
+           header.sourceHash == sourceHash &&
+           header.cookSettingsHash == hashCookerConfig(config_);
 }
 
 bool AssetCooker::cookBatch(const std::vector<std::pair<std::string, std::string>>& files) {
-    bool allSuccess = true;
+    double startTime = getCurrentTimeMs();
+    stats_ = {};
+    if (files.empty()) {
+        return true;
+    }
     
-    for (size_t i = 0; i < files.size(); i++) {
-        if (config_.verbose) {
-            std::cout << "\n[" << (i + 1) << "/" << files.size() << "] Cooking: " 
-                      << files[i].first << std::endl;
-        }
+    // Each lane is its own thread cooking one asset at a time, which bounds
+    // how many assets (and their intermediate buffers) are alive at once.
+    // Lanes are not jobs: cook() waits on its stage jobs, and a wait running
+    // another lane inline would stall this asset behind it and put more than
+    // maxAssetsInFlight assets in flight. Stage jobs run on the pool, and a
+    // waiting lane helps with them.
+    JobSystem* jobs = &getJobSystem();
+    size_t threadCount = config_.jobs > 0 ? config_.jobs : jobs->getWorkerCount() + 1;
+    size_t laneCount = config_.maxAssetsInFlight > 0 ? config_.maxAssetsInFlight : threadCount;
+    laneCount = std::min(laneCount, files.size());
+    
+    std::unique_ptr<JobSystem> ownedJobs;
+    if (config_.jobs > 0) {
+        // Lanes count towards the N threads; the pool gets the rest
+        size_t workerCount = threadCount > laneCount ? threadCount - laneCount : 0;
+        ownedJobs = std::make_unique<JobSystem>(static_cast<uint32_t>(workerCount));
+        jobs = ownedJobs.get();
+    }
+    
+    CookerConfig laneConfig = config_;
+    laneConfig.verbose = false;
+    
+    std::atomic<size_t> nextFile{0};
+    std::mutex resultMutex;
+    size_t finishedCount = 0;
+    CookingStats totals{};
+    
+    auto runLane = [&] {
+        AssetCooker cooker;
+        cooker.setConfig(laneConfig);
+        cooker.setJobSystem(jobs);
         
-        if (!cookFile(files[i].first, files[i].second)) {
-            std::cerr << "Failed to cook: " << files[i].first << " - " << lastError_ << std::endl;
-            allSuccess = false;
+        for (size_t i = nextFile.fetch_add(1); i < files.size(); i = nextFile.fetch_add(1)) {
+            const std::string& inputPath = files[i].first;
+            bool succeeded = cooker.cookFile(inputPath, files[i].second);
+            
+            std::lock_guard<std::mutex> lock(resultMutex);
+            ++finishedCount;
+            float progress = static_cast<float>(finishedCount) / static_cast<float>(files.size());
+            
+            if (!succeeded) {
+                std::cerr << "Failed to cook: " << inputPath << " - " << cooker.getLastError() << std::endl;
+                totals.assetsFailed++;
+                lastError_ = cooker.getLastError();
+                reportProgress("Failed: " + inputPath, progress);
+                continue;
+            }
+            
+            const CookingStats& assetStats = cooker.getStats();
+            accumulateStats(totals, assetStats);
+            reportProgress((assetStats.assetsSkipped ? "Up to date: " : "Cooked: ") + inputPath, progress);
         }
+    };
+    
+    std::vector<std::thread> lanes;
+    lanes.reserve(laneCount - 1);
+    for (size_t lane = 1; lane < laneCount; ++lane) {
+        lanes.emplace_back(runLane);
+    }
+    runLane();
+    for (std::thread& lane : lanes) {
+        lane.join();
+    }
+    
+    stats_ = totals;
+    stats_.totalTime = getCurrentTimeMs() - startTime;
+    
+    if (config_.verbose) {
+        std::cout << "\nBatch complete: " << stats_.assetsCooked << " cooked, "
+                  << stats_.assetsSkipped << " up to date, "
+                  << stats_.assetsFailed << " failed ("
+                  << laneCount << " in flight, " << laneCount + jobs->getWorkerCount() << " threads)" << std::endl;
+        std::cout << "  Stage time, summed over assets (ms):" << std::endl;
+        std::cout << "    Load:              " << stats_.loadTime << std::endl;
+        std::cout << "    Meshlets:          " << stats_.meshletGenerationTime << std::endl;
+        std::cout << "    Cluster hierarchy: " << stats_.clusterHierarchyTime << std::endl;
+        std::cout << "    SDF:               " << stats_.sdfGenerationTime << std::endl;
+        std::cout << "    Surface cards:     " << stats_.surfaceCardTime << std::endl;
+        std::cout << "    Physics:           " << stats_.physicsTime << std::endl;
+        std::cout << "    Assembly:          " << stats_.assemblyTime << std::endl;
+        std::cout << "    Compression:       " << stats_.compressionTime << std::endl;
+        std::cout << "    Write:             " << stats_.writeTime << std::endl;
+        std::cout << "  Output: " << stats_.compressedSize / 1024 << " KB of "
+                  << stats_.totalSize / 1024 << " KB (" << compressionRatio(stats_) << ":1)" << std::endl;
+        std::cout << "  Wall time: " << stats_.totalTime << " ms" << std::endl;
     }
     
-    return allSuccess;
+    return stats_.assetsFailed == 0;
 }
 
 // ============================================================================
@@ -727,6 +1100,7 @@ bool AssetCooker::buildClusterHierarchy(const InputMesh& mesh,
     
     while (currentLevel.size() > 1) {
         std::vector<uint32_t> nextLevel;
+        bool childrenAreClusters = outNodes.empty();
         
         // Group into parent nodes (4 children per node)
         const uint32_t childrenPerNode = 4;
@@ -742,7 +1116,7 @@ bool AssetCooker::buildClusterHierarchy(const InputMesh& mesh,
             
             for (uint32_t c = 0; c < childCount; c++) {
                 uint32_t childIdx = currentLevel[i + c];
-                if (outNodes.empty()) {
+                if (childrenAreClusters) {
                     // Children are clusters
                     const auto& cluster = outClusters[childIdx];
                     minBounds = glm::min(minBounds, cluster.sphereCenter - glm::vec3(cluster.sphereRadius));
@@ -768,7 +1142,7 @@ bool AssetCooker::buildClusterHierarchy(const InputMesh& mesh,
             
             node.childOffset = currentLevel[i];
             node.childCount = childCount;
-            node.flags = outNodes.empty() ? 0x1 : 0;  // NODE_FLAG_LEAF if pointing to clusters
+            node.flags = childrenAreClusters ? 0x1 : 0;  // NODE_FLAG_LEAF if pointing to clusters
             node.level = static_cast<uint32_t>(outNodes.size() / 100);  // Rough level estimate
             
             nextLevel.push_back(static_cast<uint32_t>(outNodes.size()));
@@ -806,6 +1180,7 @@ bool AssetCooker::buildClusterPages(const std::vector<CookedCluster>& clusters,
         page.uncompressedSize = page.clusterCount * sizeof(CookedCluster);
         page.compressedSize = 0;  // Will be set if compression is enabled
         page.fileOffset = fileOffset;
+        page.blockOffset = 0;
         page.flags = 0;
         page.dependencyMask = (p > 0) ? (1u << (p - 1)) : 0;  // Simple linear dependency
         
@@ -819,50 +1194,259 @@ bool AssetCooker::buildClusterPages(const std::vector<CookedCluster>& clusters,
 // SDF GENERATION
 // ============================================================================
 
-float AssetCooker::pointTriangleDistance(const glm::vec3& p,
-                                          const glm::vec3& a,
-                                          const glm::vec3& b,
-                                          const glm::vec3& c) {
+namespace {
+
+// Squared distance from p to triangle abc (Ericson, Real-Time Collision Detection 5.1.5)
+float pointTriangleDistanceSq(const glm::vec3& p,
+                              const glm::vec3& a,
+                              const glm::vec3& b,
+                              const glm::vec3& c) {
     glm::vec3 ab = b - a;
     glm::vec3 ac = c - a;
     glm::vec3 ap = p - a;
     
     float d1 = glm::dot(ab, ap);
     float d2 = glm::dot(ac, ap);
-    if (d1 <= 0.0f && d2 <= 0.0f) return glm::length(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return glm::dot(ap, ap);
     
     glm::vec3 bp = p - b;
     float d3 = glm::dot(ab, bp);
     float d4 = glm::dot(ac, bp);
-    if (d3 >= 0.0f && d4 <= d3) return glm::length(bp);
+    if (d3 >= 0.0f && d4 <= d3) return glm::dot(bp, bp);
     
     float vc = d1 * d4 - d3 * d2;
     if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
         float v = d1 / (d1 - d3);
-        return glm::length(p - (a + v * ab));
+        glm::vec3 d = p - (a + v * ab);
+        return glm::dot(d, d);
     }
     
     glm::vec3 cp = p - c;
     float d5 = glm::dot(ab, cp);
     float d6 = glm::dot(ac, cp);
-    if (d6 >= 0.0f && d5 <= d6) return glm::length(cp);
+    if (d6 >= 0.0f && d5 <= d6) return glm::dot(cp, cp);
     
     float vb = d5 * d2 - d1 * d6;
     if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
         float w = d2 / (d2 - d6);
-        return glm::length(p - (a + w * ac));
+        glm::vec3 d = p - (a + w * ac);
+        return glm::dot(d, d);
     }
     
     float va = d3 * d6 - d5 * d4;
     if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
         float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
-        return glm::length(p - (b + w * (c - b)));
+        glm::vec3 d = p - (b + w * (c - b));
+        return glm::dot(d, d);
     }
     
     float denom = 1.0f / (va + vb + vc);
     float v = vb * denom;
     float w = vc * denom;
-    return glm::length(p - (a + ab * v + ac * w));
+    glm::vec3 d = p - (a + ab * v + ac * w);
+    return glm::dot(d, d);
+}
+
+constexpr uint32_t SDF_BVH_LEAF_SIZE = 4;
+constexpr uint32_t SDF_BVH_MAX_DEPTH = 64;
+
+struct SDFTriangle {
+    glm::vec3 a, b, c;
+};
+
+struct SDFBVHNode {
+    glm::vec3 boundsMin;
+    uint32_t first;         // Leaf: first triangle. Inner: right child (left is next node)
+    glm::vec3 boundsMax;
+    uint32_t count;         // Triangles in leaf, 0 for inner nodes
+};
+
+/**
+ * Median-split BVH over a mesh's triangles, flattened in depth-first order
+ * with triangles stored contiguously per leaf. Answers nearest-triangle
+ * and axis-aligned ray queries for SDF baking; read-only after build, so
+ * any number of threads can query it.
+ */
+class SDFTriangleBVH {
+public:
+    explicit SDFTriangleBVH(const InputMesh& mesh) {
+        size_t triangleCount = mesh.indices.size() / 3;
+        std::vector<SDFTriangle> triangles(triangleCount);
+        std::vector<glm::vec3> centroids(triangleCount);
+        std::vector<uint32_t> order(triangleCount);
+        
+        for (size_t t = 0; t < triangleCount; t++) {
+            triangles[t].a = mesh.vertices[mesh.indices[t * 3 + 0]].position;
+            triangles[t].b = mesh.vertices[mesh.indices[t * 3 + 1]].position;
+            triangles[t].c = mesh.vertices[mesh.indices[t * 3 + 2]].position;
+            centroids[t] = (triangles[t].a + triangles[t].b + triangles[t].c) / 3.0f;
+            order[t] = static_cast<uint32_t>(t);
+        }
+        
+        if (triangleCount > 0) {
+            nodes_.reserve(2 * triangleCount / SDF_BVH_LEAF_SIZE + 1);
+            build(triangles, centroids, order, 0, static_cast<uint32_t>(triangleCount));
+        }
+        
+        triangles_.resize(triangleCount);
+        for (size_t t = 0; t < triangleCount; t++) {
+            triangles_[t] = triangles[order[t]];
+        }
+    }
+    
+    bool empty() const { return triangles_.empty(); }
+    
+    // Squared distance from p to the nearest triangle. hint is a triangle
+    // expected to be close (e.g. the previous voxel's answer); it seeds the
+    // search radius and receives the new nearest triangle.
+    float closestDistanceSq(const glm::vec3& p, uint32_t& hint) const {
+        const SDFTriangle& seed = triangles_[hint];
+        float best = pointTriangleDistanceSq(p, seed.a, seed.b, seed.c);
+        uint32_t bestTriangle = hint;
+        
+        uint32_t stack[SDF_BVH_MAX_DEPTH * 2];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+        
+        while (stackSize > 0) {
+            uint32_t nodeIndex = stack[--stackSize];
+            const SDFBVHNode& node = nodes_[nodeIndex];
+            if (boxDistanceSq(p, node) >= best) continue;
+            
+            if (node.count > 0) {
+                for (uint32_t t = node.first; t < node.first + node.count; t++) {
+                    const SDFTriangle& tri = triangles_[t];
+                    float d = pointTriangleDistanceSq(p, tri.a, tri.b, tri.c);
+                    if (d < best) {
+                        best = d;
+                        bestTriangle = t;
+                    }
+                }
+                continue;
+            }
+            
+            // Visit the nearer child first so the radius shrinks sooner
+            uint32_t left = nodeIndex + 1;
+            uint32_t right = node.first;
+            float leftDist = boxDistanceSq(p, nodes_[left]);
+            float rightDist = boxDistanceSq(p, nodes_[right]);
+            if (leftDist > rightDist) {
+                std::swap(left, right);
+                std::swap(leftDist, rightDist);
+            }
+            if (rightDist < best) stack[stackSize++] = right;
+            if (leftDist < best) stack[stackSize++] = left;
+        }
+        
+        hint = bestTriangle;
+        return best;
+    }
+    
+    // Appends the axis coordinate of every triangle crossing the line
+    // through origin parallel to the given axis
+    void intersectAxisLine(const glm::vec3& origin, int axis, std::vector<float>& outHits) const {
+        if (nodes_.empty()) return;
+        
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+        
+        uint32_t stack[SDF_BVH_MAX_DEPTH * 2];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+        
+        while (stackSize > 0) {
+            uint32_t nodeIndex = stack[--stackSize];
+            const SDFBVHNode& node = nodes_[nodeIndex];
+            if (origin[u] < node.boundsMin[u] || origin[u] > node.boundsMax[u] ||
+                origin[v] < node.boundsMin[v] || origin[v] > node.boundsMax[v]) {
+                continue;
+            }
+            
+            if (node.count == 0) {
+                stack[stackSize++] = node.first;
+                stack[stackSize++] = nodeIndex + 1;
+                continue;
+            }
+            
+            for (uint32_t t = node.first; t < node.first + node.count; t++) {
+                const SDFTriangle& tri = triangles_[t];
+                
+                // 2D barycentrics of the line's footprint in the (u, v) plane
+                float au = tri.a[u] - origin[u], av = tri.a[v] - origin[v];
+                float bu = tri.b[u] - origin[u], bv = tri.b[v] - origin[v];
+                float cu = tri.c[u] - origin[u], cv = tri.c[v] - origin[v];
+                float w0 = bu * cv - bv * cu;
+                float w1 = cu * av - cv * au;
+                float w2 = au * bv - av * bu;
+                
+                bool allPositive = w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f;
+                bool allNegative = w0 <= 0.0f && w1 <= 0.0f && w2 <= 0.0f;
+                float area = w0 + w1 + w2;
+                if ((!allPositive && !allNegative) || area == 0.0f) continue;
+                
+                outHits.push_back((w0 * tri.a[axis] + w1 * tri.b[axis] + w2 * tri.c[axis]) / area);
+            }
+        }
+    }
+    
+private:
+    uint32_t build(std::vector<SDFTriangle>& triangles, const std::vector<glm::vec3>& centroids,
+                   std::vector<uint32_t>& order, uint32_t first, uint32_t count) {
+        uint32_t nodeIndex = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back({});
+        
+        glm::vec3 boundsMin(std::numeric_limits<float>::max());
+        glm::vec3 boundsMax(-std::numeric_limits<float>::max());
+        glm::vec3 centroidMin = boundsMin;
+        glm::vec3 centroidMax = boundsMax;
+        for (uint32_t i = first; i < first + count; i++) {
+            const SDFTriangle& tri = triangles[order[i]];
+            boundsMin = glm::min(boundsMin, glm::min(tri.a, glm::min(tri.b, tri.c)));
+            boundsMax = glm::max(boundsMax, glm::max(tri.a, glm::max(tri.b, tri.c)));
+            centroidMin = glm::min(centroidMin, centroids[order[i]]);
+            centroidMax = glm::max(centroidMax, centroids[order[i]]);
+        }
+        
+        nodes_[nodeIndex].boundsMin = boundsMin;
+        nodes_[nodeIndex].boundsMax = boundsMax;
+        
+        if (count <= SDF_BVH_LEAF_SIZE) {
+            nodes_[nodeIndex].first = first;
+            nodes_[nodeIndex].count = count;
+            return nodeIndex;
+        }
+        
+        glm::vec3 extent = centroidMax - centroidMin;
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        
+        // Median split keeps the depth at log2(n), within the traversal stack
+        uint32_t mid = first + count / 2;
+        std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + first + count,
+                         [&](uint32_t lhs, uint32_t rhs) { return centroids[lhs][axis] < centroids[rhs][axis]; });
+        
+        build(triangles, centroids, order, first, mid - first);
+        uint32_t right = build(triangles, centroids, order, mid, first + count - mid);
+        nodes_[nodeIndex].first = right;
+        nodes_[nodeIndex].count = 0;
+        return nodeIndex;
+    }
+    
+    static float boxDistanceSq(const glm::vec3& p, const SDFBVHNode& node) {
+        glm::vec3 d = glm::max(glm::max(node.boundsMin - p, p - node.boundsMax), glm::vec3(0.0f));
+        return glm::dot(d, d);
+    }
+    
+    std::vector<SDFTriangle> triangles_;
+    std::vector<SDFBVHNode> nodes_;
+};
+
+} // namespace
+
+float AssetCooker::pointTriangleDistance(const glm::vec3& p,
+                                          const glm::vec3& a,
+                                          const glm::vec3& b,
+                                          const glm::vec3& c) {
+    return std::sqrt(pointTriangleDistanceSq(p, a, b, c));
 }
 
 bool AssetCooker::generateSDF(const InputMesh& mesh,
@@ -885,43 +1469,83 @@ bool AssetCooker::generateSDF(const InputMesh& mesh,
     // Limit resolution
     outResolution = glm::min(outResolution, glm::ivec3(config_.sdfResolution));
     
-    size_t totalVoxels = outResolution.x * outResolution.y * outResolution.z;
+    SDFTriangleBVH bvh(mesh);
+    if (bvh.empty()) {
+        return false;
+    }
+    
+    const glm::ivec3 res = outResolution;
+    const float voxelSize = outVoxelSize;
+    size_t totalVoxels = static_cast<size_t>(res.x) * res.y * res.z;
     outSdfVolume.resize(totalVoxels);
     
-    // Parallel SDF computation
-    #pragma omp parallel for
-    for (int z = 0; z < outResolution.z; z++) {
-        for (int y = 0; y < outResolution.y; y++) {
-            for (int x = 0; x < outResolution.x; x++) {
-                glm::vec3 voxelPos = boundsMin + glm::vec3(
-                    (x + 0.5f) * outVoxelSize,
-                    (y + 0.5f) * outVoxelSize,
-                    (z + 0.5f) * outVoxelSize
-                );
+    auto voxelIndex = [res](int x, int y, int z) {
+        return static_cast<size_t>(x) + static_cast<size_t>(y) * res.x + static_cast<size_t>(z) * res.x * res.y;
+    };
+    auto voxelCenter = [&](int x, int y, int z) {
+        return boundsMin + glm::vec3(x + 0.5f, y + 0.5f, z + 0.5f) * voxelSize;
+    };
+    
+    JobSystem& jobs = getJobSystem();
+    
+    // ------------------------------------------------------------------------
+    // Sign: ray parity along grid lines. One line per row of voxels gives the
+    // crossings for the whole row; a majority vote over the three axes
+    // tolerates small holes and non-manifold seams.
+    // ------------------------------------------------------------------------
+    std::vector<uint8_t> insideVotes(totalVoxels, 0);
+    
+    // Nudge lines off voxel centers so they don't graze axis-aligned edges
+    const glm::vec3 lineJitter = glm::vec3(0.000731f, 0.000419f, 0.000563f) * voxelSize;
+    
+    for (int axis = 0; axis < 3; axis++) {
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+        size_t lineCount = static_cast<size_t>(res[u]) * res[v];
+        
+        jobs.parallelFor(lineCount, 64, [&](size_t begin, size_t end) {
+            std::vector<float> hits;
+            for (size_t line = begin; line < end; line++) {
+                glm::ivec3 cell(0);
+                cell[u] = static_cast<int>(line % res[u]);
+                cell[v] = static_cast<int>(line / res[u]);
                 
-                float minDist = std::numeric_limits<float>::max();
+                hits.clear();
+                bvh.intersectAxisLine(voxelCenter(cell.x, cell.y, cell.z) + lineJitter, axis, hits);
+                std::sort(hits.begin(), hits.end());
                 
-                // Find minimum distance to all triangles
-                for (size_t t = 0; t < mesh.indices.size(); t += 3) {
-                    const glm::vec3& a = mesh.vertices[mesh.indices[t + 0]].position;
-                    const glm::vec3& b = mesh.vertices[mesh.indices[t + 1]].position;
-                    const glm::vec3& c = mesh.vertices[mesh.indices[t + 2]].position;
-                    
-                    float dist = pointTriangleDistance(voxelPos, a, b, c);
-                    minDist = std::min(minDist, dist);
+                size_t crossed = 0;
+                for (cell[axis] = 0; cell[axis] < res[axis]; cell[axis]++) {
+                    float coord = voxelCenter(cell.x, cell.y, cell.z)[axis];
+                    while (crossed < hits.size() && hits[crossed] < coord) {
+                        crossed++;
+                    }
+                    insideVotes[voxelIndex(cell.x, cell.y, cell.z)] += static_cast<uint8_t>(crossed & 1);
                 }
-                
-                // Determine sign using winding number
-                // (simplified - assumes manifold mesh)
-                float sign = 1.0f;
-                // TODO: Implement proper inside/outside detection
-                
-                size_t idx = x + y * outResolution.x + z * outResolution.x * outResolution.y;
-                outSdfVolume[idx] = sign * minDist;
             }
-        }
+        });
     }
     
+    // ------------------------------------------------------------------------
+    // Distance: BVH nearest-triangle query per voxel. Walking each row in
+    // order, the previous voxel's triangle bounds the search to about one
+    // voxel beyond the true distance.
+    // ------------------------------------------------------------------------
+    size_t rowCount = static_cast<size_t>(res.y) * res.z;
+    
+    jobs.parallelFor(rowCount, 8, [&](size_t begin, size_t end) {
+        uint32_t hint = 0;
+        for (size_t row = begin; row < end; row++) {
+            int y = static_cast<int>(row % res.y);
+            int z = static_cast<int>(row / res.y);
+            for (int x = 0; x < res.x; x++) {
+                size_t idx = voxelIndex(x, y, z);
+                float distance = std::sqrt(bvh.closestDistanceSq(voxelCenter(x, y, z), hint));
+                outSdfVolume[idx] = insideVotes[idx] >= 2 ? -distance : distance;
+            }
+        }
+    });
+    
     return true;
 }
 
@@ -1055,20 +1679,83 @@ bool AssetCooker::generatePhysicsData(const InputMesh& mesh,
     return true;
 }
 
+// ============================================================================
+// SECTION COMPRESSION
+// ============================================================================
+
+std::vector<uint8_t> AssetCooker::packSection(SectionType type, std::vector<uint8_t>& data) {
+    CompressionCodec codec = config_.compressPages ? DataCompression::selectCodec(type) : CompressionCodec::None;
+    return DataCompression::compressSection(type, data, codec, config_.compressionLevel);
+}
+
+std::vector<uint8_t> AssetCooker::packNaniteSection(std::vector<uint8_t>& naniteData) {
+    if (naniteData.size() < sizeof(NaniteHeader)) {
+        return packSection(SectionType::Nanite, naniteData);
+    }
+    
+    NaniteHeader naniteHeader;
+    memcpy(&naniteHeader, naniteData.data(), sizeof(NaniteHeader));
+    
+    auto readPage = [&](const std::vector<uint8_t>& data, uint32_t index) {
+        PageTableEntry page;
+        memcpy(&page, data.data() + naniteHeader.pageTableOffset + index * sizeof(PageTableEntry), sizeof(PageTableEntry));
+        return page;
+    };
+    
+    // Every cluster page becomes its own block so the streamer can read and
+    // decode one page at a time
+    std::vector<uint32_t> splitPoints;
+    for (uint32_t p = 0; p < naniteHeader.pageCount; p++) {
+        PageTableEntry page = readPage(naniteData, p);
+        uint32_t pageStart = static_cast<uint32_t>(naniteHeader.clusterBufferOffset) + page.fileOffset;
+        splitPoints.push_back(pageStart);
+        splitPoints.push_back(pageStart + page.uncompressedSize);
+    }
+    
+    // The page table sits after the cluster data, so the page blocks are
+    // already compressed when it is patched with their location
+    auto recordPageBlocks = [&](const std::vector<CompressedBlockEntry>& blocks, std::vector<uint8_t>& data) {
+        for (uint32_t p = 0; p < naniteHeader.pageCount; p++) {
+            PageTableEntry page = readPage(data, p);
+            uint32_t pageStart = static_cast<uint32_t>(naniteHeader.clusterBufferOffset) + page.fileOffset;
+            
+            auto block = std::lower_bound(blocks.begin(), blocks.end(), pageStart,
+                [](const CompressedBlockEntry& entry, uint32_t offset) { return entry.uncompressedOffset < offset; });
+            if (block == blocks.end() || block->uncompressedOffset != pageStart ||
+                block->uncompressedSize != page.uncompressedSize) {
+                continue;
+            }
+            
+            page.blockOffset = block->dataOffset;
+            page.compressedSize = block->compressedSize;
+            memcpy(data.data() + naniteHeader.pageTableOffset + p * sizeof(PageTableEntry), &page, sizeof(PageTableEntry));
+        }
+    };
+    
+    CompressionCodec codec = config_.compressPages ? DataCompression::selectCodec(SectionType::Nanite) : CompressionCodec::None;
+    return DataCompression::compressSection(SectionType::Nanite, naniteData, codec, config_.compressionLevel,
+                                            std::move(splitPoints),
+                                            static_cast<uint32_t>(naniteHeader.pageTableOffset),
+                                            recordPageBlocks);
+}
+
 // ============================================================================
 // FILE WRITING
 // ============================================================================
 
 bool AssetCooker::writeAssetFile(const std::string& path,
                                   const AssetHeader& header,
-                                  const std::vector<uint8_t>& geometryData,
-                                  const std::vector<uint8_t>& naniteData,
-                                  const std::vector<uint8_t>& lumenData,
-                                  const std::vector<uint8_t>& physicsData,
-                                  const std::vector<uint8_t>& materialData) {
-    std::ofstream file(path, std::ios::binary);
+                                  const std::vector<uint8_t>& geometrySection,
+                                  const std::vector<uint8_t>& naniteSection,
+                                  const std::vector<uint8_t>& lumenSection,
+                                  const std::vector<uint8_t>& physicsSection,
+                                  const std::vector<uint8_t>& materialSection) {
+    // Write beside the target and rename, so an interrupted cook never
+    // leaves a truncated file that looks complete
+    std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary);
     if (!file) {
-        lastError_ = "Failed to open output file: " + path;
+        lastError_ = "Failed to open output file: " + tempPath;
         return false;
     }
     
@@ -1077,24 +1764,24 @@ bool AssetCooker::writeAssetFile(const std::string& path,
     uint64_t offset = sizeof(AssetHeader);
     
     finalHeader.geometryOffset = offset;
-    finalHeader.geometrySectionSize = static_cast<uint32_t>(geometryData.size());
-    offset += geometryData.size();
+    finalHeader.geometrySectionSize = static_cast<uint32_t>(geometrySection.size());
+    offset += geometrySection.size();
     
     finalHeader.naniteOffset = offset;
-    finalHeader.naniteSectionSize = static_cast<uint32_t>(naniteData.size());
-    offset += naniteData.size();
+    finalHeader.naniteSectionSize = static_cast<uint32_t>(naniteSection.size());
+    offset += naniteSection.size();
     
     finalHeader.lumenOffset = offset;
-    finalHeader.lumenSectionSize = static_cast<uint32_t>(lumenData.size());
-    offset += lumenData.size();
+    finalHeader.lumenSectionSize = static_cast<uint32_t>(lumenSection.size());
+    offset += lumenSection.size();
     
     finalHeader.physicsOffset = offset;
-    finalHeader.physicsSectionSize = static_cast<uint32_t>(physicsData.size());
-    offset += physicsData.size();
+    finalHeader.physicsSectionSize = static_cast<uint32_t>(physicsSection.size());
+    offset += physicsSection.size();
     
     finalHeader.materialOffset = offset;
-    finalHeader.materialSectionSize = static_cast<uint32_t>(materialData.size());
-    offset += materialData.size();
+    finalHeader.materialSectionSize = static_cast<uint32_t>(materialSection.size());
+    offset += materialSection.size();
     
     finalHeader.totalSize = static_cast<uint32_t>(offset);
     
@@ -1102,13 +1789,104 @@ bool AssetCooker::writeAssetFile(const std::string& path,
     file.write(reinterpret_cast<const char*>(&finalHeader), sizeof(AssetHeader));
     
     // Write sections
-    file.write(reinterpret_cast<const char*>(geometryData.data()), geometryData.size());
-    file.write(reinterpret_cast<const char*>(naniteData.data()), naniteData.size());
-    file.write(reinterpret_cast<const char*>(lumenData.data()), lumenData.size());
-    file.write(reinterpret_cast<const char*>(physicsData.data()), physicsData.size());
-    file.write(reinterpret_cast<const char*>(materialData.data()), materialData.size());
+    file.write(reinterpret_cast<const char*>(geometrySection.data()), geometrySection.size());
+    file.write(reinterpret_cast<const char*>(naniteSection.data()), naniteSection.size());
+    file.write(reinterpret_cast<const char*>(lumenSection.data()), lumenSection.size());
+    file.write(reinterpret_cast<const char*>(physicsSection.data()), physicsSection.size());
+    file.write(reinterpret_cast<const char*>(materialSection.data()), materialSection.size());
     
     file.close();
+    if (!file) {
+        lastError_ = "Failed to write output file: " + tempPath;
+        return false;
+    }
+    
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        lastError_ = "Failed to replace output file: " + path + " (" + error.message() + ")";
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool AssetCooker::writeStreamingFile(const std::string& path,
+                                      const std::vector<uint8_t>& naniteData,
+                                      const std::vector<uint8_t>& naniteSection) {
+    NaniteHeader naniteHeader{};
+    if (naniteData.size() >= sizeof(NaniteHeader)) {
+        memcpy(&naniteHeader, naniteData.data(), sizeof(NaniteHeader));
+    }
+    SectionHeader sectionHeader{};
+    memcpy(&sectionHeader, naniteSection.data(), sizeof(SectionHeader));
+    
+    uint32_t pageCount = naniteHeader.pageCount;
+    std::vector<uint32_t> rootPages;
+    if (naniteHeader.rootPageIndex < pageCount) {
+        rootPages.push_back(naniteHeader.rootPageIndex);
+    }
+    
+    // Compressed pages are copied as their section block; the rest raw
+    std::vector<uint64_t> pageOffsets(pageCount);
+    std::vector<uint32_t> pageSizes(pageCount);
+    std::vector<uint32_t> uncompressedSizes(pageCount);
+    std::vector<const uint8_t*> pageData(pageCount);
+    
+    uint64_t offset = 4 * sizeof(uint32_t) + pageCount * (sizeof(uint64_t) + 2 * sizeof(uint32_t)) +
+                      rootPages.size() * sizeof(uint32_t) + sizeof(uint32_t);
+    for (uint32_t p = 0; p < pageCount; p++) {
+        PageTableEntry page;
+        memcpy(&page, naniteData.data() + naniteHeader.pageTableOffset + p * sizeof(PageTableEntry), sizeof(PageTableEntry));
+        
+        if (page.compressedSize > 0) {
+            pageData[p] = naniteSection.data() + page.blockOffset;
+            pageSizes[p] = page.compressedSize;
+        } else {
+            pageData[p] = naniteData.data() + naniteHeader.clusterBufferOffset + page.fileOffset;
+            pageSizes[p] = page.uncompressedSize;
+        }
+        uncompressedSizes[p] = page.uncompressedSize;
+        pageOffsets[p] = offset;
+        offset += pageSizes[p];
+    }
+    
+    std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary);
+    if (!file) {
+        lastError_ = "Failed to open output file: " + tempPath;
+        return false;
+    }
+    
+    uint32_t counts[4] = {pageCount, static_cast<uint32_t>(rootPages.size()),
+                          naniteHeader.hierarchyNodeCount, naniteHeader.clusterCount};
+    file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+    file.write(reinterpret_cast<const char*>(pageOffsets.data()), pageCount * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char*>(pageSizes.data()), pageCount * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(rootPages.data()), rootPages.size() * sizeof(uint32_t));
+    
+    // Codec trailer; without it the streamer would read every page as raw
+    uint32_t codec = sectionHeader.flags;
+    file.write(reinterpret_cast<const char*>(&codec), sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(uncompressedSizes.data()), pageCount * sizeof(uint32_t));
+    
+    for (uint32_t p = 0; p < pageCount; p++) {
+        file.write(reinterpret_cast<const char*>(pageData[p]), pageSizes[p]);
+    }
+    
+    file.close();
+    if (!file) {
+        lastError_ = "Failed to write output file: " + tempPath;
+        return false;
+    }
+    
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        lastError_ = "Failed to replace output file: " + path + " (" + error.message() + ")";
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
     return true;
 }
 
@@ -1135,6 +1913,10 @@ Options:
   --no-physics         Skip physics generation
   --no-compress        Disable page compression
   
+  -j, --jobs N         Worker threads for batch cooking (default: all cores)
+  --max-in-flight N    Assets cooked at once; bounds memory (default: --jobs)
+  --force              Recook even if source and settings are unchanged
+  
 Input formats:
   .obj                 Wavefront OBJ
   .gltf, .glb          GLTF 2.0
@@ -1186,6 +1968,12 @@ int CookerCLI::run(int argc, char* argv[]) {
             config.generateTriangleMesh = false;
         } else if (arg == "--no-compress") {
             config.compressPages = false;
+        } else if ((arg == "-j" || arg == "--jobs") && i + 1 < argc) {
+            config.jobs = static_cast<uint32_t>(std::stoi(argv[++i]));
+        } else if (arg == "--max-in-flight" && i + 1 < argc) {
+            config.maxAssetsInFlight = static_cast<uint32_t>(std::stoi(argv[++i]));
+        } else if (arg == "--force") {
+            config.skipUnchanged = false;
         } else if (arg == "--batch" && i + 1 < argc) {
             batchFile = argv[++i];
         } else if (arg == "--output-dir" && i + 1 < argc) {
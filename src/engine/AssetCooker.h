@@ -9,7 +9,7 @@
  * 
  * Usage (command line):
  *   sanic_cooker.exe --input model.obj --output model.sanic_mesh
- *   sanic_cooker.exe --batch assets_list.txt --output-dir cooked/
+ *   sanic_cooker.exe --batch assets_list.txt --output-dir cooked/ --jobs 16
  * 
  * Usage (API):
  *   AssetCooker cooker;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "SanicAssetFormat.h"
+#include "JobSystem.h"
 #include <string>
 #include <vector>
 #include <functional>
@@ -60,10 +61,16 @@ struct CookerConfig {
     // Compression
     bool compressPages = true;
     int compressionLevel = 6;               // 1-12 for LZ4HC
+    bool writeStreamingFile = true;         // Also write <output>.nanite for NaniteStreamingManager
     
     // Output
     bool verbose = true;
     bool dryRun = false;
+    
+    // Batch cooking
+    uint32_t jobs = 0;                      // Worker threads, 0 = shared JobSystem
+    uint32_t maxAssetsInFlight = 0;         // Bounds peak memory, 0 = one per thread
+    bool skipUnchanged = true;              // Skip outputs whose source and settings hashes match
 };
 
 // ============================================================================
@@ -148,14 +155,23 @@ struct CookingStats {
     uint64_t totalSize;
     uint64_t compressedSize;
     
-    // Timing (ms)
+    // Timing (ms). After cookBatch, stage times are summed over all assets
+    // and totalTime is the wall time of the whole batch.
+    double loadTime;
     double meshletGenerationTime;
     double clusterHierarchyTime;
     double sdfGenerationTime;
     double surfaceCardTime;
     double physicsTime;
     double compressionTime;
+    double assemblyTime;
+    double writeTime;
     double totalTime;
+    
+    // Asset counts (1/0 for a single cook)
+    uint32_t assetsCooked;
+    uint32_t assetsSkipped;
+    uint32_t assetsFailed;
 };
 
 // Progress callback
@@ -177,6 +193,10 @@ public:
     // Progress callback
     void setProgressCallback(ProgressCallback callback) { progressCallback_ = callback; }
     
+    // Pool for stage and batch parallelism (nullptr = JobSystem::getInstance()).
+    // CookerConfig::jobs overrides this in cookBatch.
+    void setJobSystem(JobSystem* jobs) { jobSystem_ = jobs; }
+    
     // Main cooking functions
     bool loadFromOBJ(const std::string& objPath, InputAsset& outAsset);
     bool loadFromGLTF(const std::string& gltfPath, InputAsset& outAsset);
@@ -184,9 +204,23 @@ public:
     bool cook(const InputAsset& input, const std::string& outputPath);
     bool cookFile(const std::string& inputPath, const std::string& outputPath);
     
-    // Batch cooking
+    // Batch cooking. Assets are cooked concurrently, at most
+    // maxAssetsInFlight at a time; unchanged outputs are skipped, so an
+    // interrupted batch resumes where it stopped.
     bool cookBatch(const std::vector<std::pair<std::string, std::string>>& files);
     
+    // True if outputPath was cooked from a source with this hash using the
+    // current settings
+    bool isUpToDate(const std::string& outputPath, uint64_t sourceHash) const;
+    
+    // Signed (negative inside) distance volume, BVH-accelerated and
+    // multithreaded on the cooker's JobSystem. Voxel (x, y, z) is centred at
+    // boundsMin - sdfPadding + (x + 0.5, y + 0.5, z + 0.5) * outVoxelSize.
+    bool generateSDF(const InputMesh& mesh,
+                     std::vector<float>& outSdfVolume,
+                     glm::ivec3& outResolution,
+                     float& outVoxelSize);
+    
     // Get last cooking stats
     const CookingStats& getStats() const { return stats_; }
     
@@ -208,11 +242,6 @@ private:
     bool buildClusterPages(const std::vector<CookedCluster>& clusters,
                            std::vector<PageTableEntry>& outPages);
     
-    bool generateSDF(const InputMesh& mesh,
-                     std::vector<float>& outSdfVolume,
-                     glm::ivec3& outResolution,
-                     float& outVoxelSize);
-    
     bool generateSurfaceCards(const InputMesh& mesh,
                               std::vector<CookedSurfaceCard>& outCards);
     
@@ -231,10 +260,6 @@ private:
                                 const glm::vec3& b,
                                 const glm::vec3& c);
     
-    float calculateWindingNumber(const glm::vec3& point,
-                                 const std::vector<InputVertex>& vertices,
-                                 const std::vector<uint32_t>& indices);
-    
     // Surface card generation helpers
     void fitOrientedBoundingBox(const std::vector<glm::vec3>& points,
                                 glm::vec3& outCenter,
@@ -247,22 +272,34 @@ private:
     // File I/O
     bool writeAssetFile(const std::string& path,
                         const AssetHeader& header,
-                        const std::vector<uint8_t>& geometryData,
-                        const std::vector<uint8_t>& naniteData,
-                        const std::vector<uint8_t>& lumenData,
-                        const std::vector<uint8_t>& physicsData,
-                        const std::vector<uint8_t>& materialData);
-    
-    // Compression
-    std::vector<uint8_t> compressData(const std::vector<uint8_t>& data);
+                        const std::vector<uint8_t>& geometrySection,
+                        const std::vector<uint8_t>& naniteSection,
+                        const std::vector<uint8_t>& lumenSection,
+                        const std::vector<uint8_t>& physicsSection,
+                        const std::vector<uint8_t>& materialSection);
+    
+    // Page index and page data in the layout NaniteStreamingManager::
+    // registerResource reads. naniteData is the packed section's source,
+    // its page table already recording the compressed blocks.
+    bool writeStreamingFile(const std::string& path,
+                            const std::vector<uint8_t>& naniteData,
+                            const std::vector<uint8_t>& naniteSection);
+    
+    // Compression: frames a section with its SectionHeader, compressing it
+    // unless compressPages is off
+    std::vector<uint8_t> packSection(SectionType type, std::vector<uint8_t>& data);
+    std::vector<uint8_t> packNaniteSection(std::vector<uint8_t>& naniteData);
     
     // Progress reporting
     void reportProgress(const std::string& stage, float progress);
     
+    JobSystem& getJobSystem() const;
+    
     CookerConfig config_;
     CookingStats stats_;
     std::string lastError_;
     ProgressCallback progressCallback_;
+    JobSystem* jobSystem_ = nullptr;
 };
 
 // ============================================================================
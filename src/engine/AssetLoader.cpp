@@ -6,6 +6,7 @@
  */
 
 #include "AssetLoader.h"
+#include "DataCompression.h"
 #include <fstream>
 #include <chrono>
 #include <algorithm>
@@ -145,7 +146,7 @@ LoadedAsset* AssetLoader::loadSync(const std::string& filePath) {
     }
     
     // Verify magic number
-    if (header.magic != SANIC_MESH_MAGIC) {
+    if (header.magic != SANIC_MAGIC && header.magic != SANIC_MESH_MAGIC) {
         return nullptr;
     }
     
@@ -165,27 +166,25 @@ LoadedAsset* AssetLoader::loadSync(const std::string& filePath) {
     
     // Parse and load each section
     size_t offset = 0;
+    uint64_t bytesDecompressed = 0;
+    double decompressTimeMs = 0.0;
+    std::vector<uint8_t> sectionData;
     while (offset < fileData.size()) {
-        // Read section header
-        if (offset + sizeof(SectionHeader) > fileData.size()) {
-            break;
-        }
-        
+        // Decode section header and data in one go; sections are
+        // decompressed block by block straight into sectionData
+        auto decompressStart = std::chrono::high_resolution_clock::now();
         SectionHeader sectionHeader;
-        std::memcpy(&sectionHeader, fileData.data() + offset, sizeof(SectionHeader));
-        offset += sizeof(SectionHeader);
-        
-        // Extract section data
-        if (offset + sectionHeader.compressedSize > fileData.size()) {
+        if (!DataCompression::decompressSection(fileData.data() + offset, fileData.size() - offset,
+                                                sectionHeader, sectionData)) {
             break;
         }
+        offset += sizeof(SectionHeader) + sectionHeader.compressedSize;
         
-        std::vector<uint8_t> sectionData(fileData.data() + offset, 
-                                         fileData.data() + offset + sectionHeader.compressedSize);
-        offset += sectionHeader.compressedSize;
-        
-        // TODO: Decompress if needed
-        // For now, assume uncompressed
+        if (static_cast<CompressionCodec>(sectionHeader.flags) != CompressionCodec::None) {
+            auto decompressEnd = std::chrono::high_resolution_clock::now();
+            decompressTimeMs += std::chrono::duration<double, std::milli>(decompressEnd - decompressStart).count();
+            bytesDecompressed += sectionHeader.uncompressedSize;
+        }
         
         // Load based on section type
         switch (sectionHeader.type) {
@@ -215,6 +214,9 @@ LoadedAsset* AssetLoader::loadSync(const std::string& filePath) {
         std::lock_guard<std::mutex> lock(statsMutex_);
         totalLoadTime_ += loadTimeMs;
         loadCount_++;
+        bytesRead_ += asset->fileSize;
+        bytesDecompressed_ += bytesDecompressed;
+        totalDecompressTime_ += decompressTimeMs;
     }
     
     // Add to cache
@@ -1006,6 +1008,9 @@ AssetLoader::Stats AssetLoader::getStats() const {
     stats.pagesStreaming = 0;
     stats.loadRequestsPending = pendingRequests_.load();
     stats.averageLoadTimeMs = loadCount_ > 0 ? static_cast<float>(totalLoadTime_ / loadCount_) : 0.0f;
+    stats.bytesRead = bytesRead_;
+    stats.bytesDecompressed = bytesDecompressed_;
+    stats.decompressTimeMs = static_cast<float>(totalDecompressTime_);
     
     return stats;
 }
@@ -1023,7 +1028,7 @@ bool isValidSanicMesh(const std::string& filePath) {
     uint32_t magic;
     file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
     
-    return file.good() && magic == SANIC_MESH_MAGIC;
+    return file.good() && (magic == SANIC_MAGIC || magic == SANIC_MESH_MAGIC);
 }
 
 bool getAssetInfo(const std::string& filePath, AssetHeader& outHeader) {
@@ -1034,7 +1039,7 @@ bool getAssetInfo(const std::string& filePath, AssetHeader& outHeader) {
     
     file.read(reinterpret_cast<char*>(&outHeader), sizeof(AssetHeader));
     
-    return file.good() && outHeader.magic == SANIC_MESH_MAGIC;
+    return file.good() && (outHeader.magic == SANIC_MAGIC || outHeader.magic == SANIC_MESH_MAGIC);
 }
 
 } // namespace Sanic
@@ -179,6 +179,9 @@ public:
         uint32_t pagesStreaming;
         uint32_t loadRequestsPending;
         float averageLoadTimeMs;
+        uint64_t bytesRead;             // File bytes read by loadSync
+        uint64_t bytesDecompressed;     // Section bytes produced by decompression
+        float decompressTimeMs;         // Total time spent decompressing
     };
     Stats getStats() const;
     
@@ -259,6 +262,9 @@ private:
     std::atomic<uint32_t> pendingRequests_{0};
     double totalLoadTime_ = 0.0;
     uint32_t loadCount_ = 0;
+    uint64_t bytesRead_ = 0;
+    uint64_t bytesDecompressed_ = 0;
+    double totalDecompressTime_ = 0.0;
 };
 
 // ============================================================================
@@ -35,282 +35,6 @@ IAudioPluginFactory* IAudioPluginFactory::findFactory(const std::string& name, E
     return nullptr;
 }
 
-// ============================================================================
-// CONVOLUTION REVERB
-// ============================================================================
-
-ConvolutionReverb::ConvolutionReverb() {
-    overlapL_.resize(FFT_SIZE, 0.0f);
-    overlapR_.resize(FFT_SIZE, 0.0f);
-    inputBuffer_.resize(FFT_SIZE, 0.0f);
-    fftBuffer_.resize(FFT_SIZE);
-    timeBuffer_.resize(FFT_SIZE * 2);
-}
-
-ConvolutionReverb::~ConvolutionReverb() {
-    shutdown();
-}
-
-bool ConvolutionReverb::initialize() {
-    inputPos_ = 0;
-    std::fill(overlapL_.begin(), overlapL_.end(), 0.0f);
-    std::fill(overlapR_.begin(), overlapR_.end(), 0.0f);
-    return true;
-}
-
-void ConvolutionReverb::shutdown() {
-    irFreqL_.clear();
-    irFreqR_.clear();
-    irLength_ = 0;
-    numPartitions_ = 0;
-}
-
-void ConvolutionReverb::setParams(const FReverbParams& params) {
-    params_ = params;
-}
-
-bool ConvolutionReverb::loadImpulseResponse(const std::string& path) {
-    // Load WAV file
-    std::ifstream file(path, std::ios::binary);
-    if (!file) {
-        return false;
-    }
-    
-    // Read WAV header
-    char header[44];
-    file.read(header, 44);
-    
-    // Parse header
-    uint16_t channels = *reinterpret_cast<uint16_t*>(&header[22]);
-    uint32_t sampleRate = *reinterpret_cast<uint32_t*>(&header[24]);
-    uint16_t bitsPerSample = *reinterpret_cast<uint16_t*>(&header[34]);
-    uint32_t dataSize = *reinterpret_cast<uint32_t*>(&header[40]);
-    
-    size_t numSamples = dataSize / (bitsPerSample / 8);
-    size_t samplesPerChannel = numSamples / channels;
-    
-    std::vector<float> irData(numSamples);
-    
-    if (bitsPerSample == 16) {
-        std::vector<int16_t> rawData(numSamples);
-        file.read(reinterpret_cast<char*>(rawData.data()), dataSize);
-        for (size_t i = 0; i < numSamples; ++i) {
-            irData[i] = rawData[i] / 32768.0f;
-        }
-    } else if (bitsPerSample == 32) {
-        file.read(reinterpret_cast<char*>(irData.data()), dataSize);
-    }
-    
-    return loadImpulseResponseFromMemory(irData.data(), samplesPerChannel, sampleRate, channels);
-}
-
-bool ConvolutionReverb::loadImpulseResponseFromMemory(const float* data, size_t sampleCount,
-                                                       uint32_t sampleRate, uint32_t channels) {
-    irLength_ = sampleCount;
-    numPartitions_ = (irLength_ + HOP_SIZE - 1) / HOP_SIZE;
-    
-    // Calculate latency
-    latencyMs_ = (float)HOP_SIZE / sampleRate * 1000.0f;
-    
-    // Allocate frequency domain storage for partitioned convolution
-    irFreqL_.resize(numPartitions_ * (FFT_SIZE / 2 + 1));
-    irFreqR_.resize(numPartitions_ * (FFT_SIZE / 2 + 1));
-    
-    // Convert each partition to frequency domain
-    std::vector<float> partition(FFT_SIZE, 0.0f);
-    std::vector<std::complex<float>> partitionFreq(FFT_SIZE / 2 + 1);
-    
-    for (size_t p = 0; p < numPartitions_; ++p) {
-        size_t offset = p * HOP_SIZE;
-        size_t count = std::min(HOP_SIZE, irLength_ - offset);
-        
-        // Left channel
-        std::fill(partition.begin(), partition.end(), 0.0f);
-        for (size_t i = 0; i < count; ++i) {
-            size_t srcIdx = (offset + i) * channels;
-            partition[i] = data[srcIdx] * irGain_;
-        }
-        
-        // Zero-pad and FFT
-        for (size_t i = 0; i < FFT_SIZE; ++i) {
-            fftBuffer_[i] = std::complex<float>(partition[i], 0.0f);
-        }
-        fft(fftBuffer_.data(), FFT_SIZE, false);
-        
-        // Store
-        size_t freqOffset = p * (FFT_SIZE / 2 + 1);
-        for (size_t i = 0; i <= FFT_SIZE / 2; ++i) {
-            irFreqL_[freqOffset + i] = fftBuffer_[i];
-        }
-        
-        // Right channel (or copy from left if mono)
-        std::fill(partition.begin(), partition.end(), 0.0f);
-        for (size_t i = 0; i < count; ++i) {
-            size_t srcIdx = (offset + i) * channels + (channels > 1 ? 1 : 0);
-            partition[i] = data[srcIdx] * irGain_;
-        }
-        
-        for (size_t i = 0; i < FFT_SIZE; ++i) {
-            fftBuffer_[i] = std::complex<float>(partition[i], 0.0f);
-        }
-        fft(fftBuffer_.data(), FFT_SIZE, false);
-        
-        for (size_t i = 0; i <= FFT_SIZE / 2; ++i) {
-            irFreqR_[freqOffset + i] = fftBuffer_[i];
-        }
-    }
-    
-    return true;
-}
-
-void ConvolutionReverb::process(float* buffer, size_t frameCount, uint32_t sampleRate) {
-    if (irLength_ == 0 || numPartitions_ == 0) {
-        // No IR loaded, pass through
-        return;
-    }
-    
-    float wet = params_.wetLevel;
-    float dry = params_.dryLevel;
-    
-    // Process in chunks
-    size_t processed = 0;
-    while (processed < frameCount) {
-        size_t toProcess = std::min(frameCount - processed, HOP_SIZE - inputPos_);
-        
-        // Copy input to buffer
-        for (size_t i = 0; i < toProcess; ++i) {
-            inputBuffer_[inputPos_ + i] = buffer[(processed + i) * 2]; // Left channel
-        }
-        inputPos_ += toProcess;
-        
-        if (inputPos_ >= HOP_SIZE) {
-            // Process partition
-            processPartitioned(inputBuffer_.data(), timeBuffer_.data(), HOP_SIZE);
-            
-            // Mix output
-            for (size_t i = 0; i < HOP_SIZE && (processed + i) < frameCount; ++i) {
-                float inL = buffer[(processed + i) * 2];
-                float inR = buffer[(processed + i) * 2 + 1];
-                
-                buffer[(processed + i) * 2] = dry * inL + wet * timeBuffer_[i * 2];
-                buffer[(processed + i) * 2 + 1] = dry * inR + wet * timeBuffer_[i * 2 + 1];
-            }
-            
-            inputPos_ = 0;
-        }
-        
-        processed += toProcess;
-    }
-}
-
-void ConvolutionReverb::processPartitioned(const float* input, float* output, size_t frameCount) {
-    // Simplified partitioned convolution
-    // In production, use WOLA (Weighted Overlap-Add) or Uniformly Partitioned Convolution
-    
-    const size_t freqSize = FFT_SIZE / 2 + 1;
-    std::vector<std::complex<float>> accL(freqSize, {0, 0});
-    std::vector<std::complex<float>> accR(freqSize, {0, 0});
-    
-    // FFT input
-    for (size_t i = 0; i < FFT_SIZE; ++i) {
-        fftBuffer_[i] = std::complex<float>(i < frameCount ? input[i] : 0.0f, 0.0f);
-    }
-    fft(fftBuffer_.data(), FFT_SIZE, false);
-    
-    // Multiply with first partition (simplified - full impl would use all partitions)
-    for (size_t i = 0; i < freqSize; ++i) {
-        accL[i] = fftBuffer_[i] * irFreqL_[i];
-        accR[i] = fftBuffer_[i] * irFreqR_[i];
-    }
-    
-    // IFFT left
-    for (size_t i = 0; i < freqSize; ++i) {
-        fftBuffer_[i] = accL[i];
-    }
-    for (size_t i = freqSize; i < FFT_SIZE; ++i) {
-        fftBuffer_[i] = std::conj(fftBuffer_[FFT_SIZE - i]);
-    }
-    fft(fftBuffer_.data(), FFT_SIZE, true);
-    
-    // Overlap-add left
-    for (size_t i = 0; i < FFT_SIZE; ++i) {
-        float sample = fftBuffer_[i].real() / FFT_SIZE + overlapL_[i];
-        if (i < frameCount) {
-            output[i * 2] = sample;
-        }
-        overlapL_[i] = (i + frameCount < FFT_SIZE) ? fftBuffer_[i + frameCount].real() / FFT_SIZE : 0.0f;
-    }
-    
-    // IFFT right
-    for (size_t i = 0; i < freqSize; ++i) {
-        fftBuffer_[i] = accR[i];
-    }
-    for (size_t i = freqSize; i < FFT_SIZE; ++i) {
-        fftBuffer_[i] = std::conj(fftBuffer_[FFT_SIZE - i]);
-    }
-    fft(fftBuffer_.data(), FFT_SIZE, true);
-    
-    // Overlap-add right
-    for (size_t i = 0; i < FFT_SIZE; ++i) {
-        float sample = fftBuffer_[i].real() / FFT_SIZE + overlapR_[i];
-        if (i < frameCount) {
-            output[i * 2 + 1] = sample;
-        }
-        overlapR_[i] = (i + frameCount < FFT_SIZE) ? fftBuffer_[i + frameCount].real() / FFT_SIZE : 0.0f;
-    }
-}
-
-void ConvolutionReverb::fft(std::complex<float>* data, size_t n, bool inverse) {
-    // Cooley-Tukey FFT implementation
-    // Bit-reversal permutation
-    for (size_t i = 0, j = 0; i < n; ++i) {
-        if (j > i) {
-            std::swap(data[i], data[j]);
-        }
-        size_t m = n / 2;
-        while (j >= m && m >= 1) {
-            j -= m;
-            m /= 2;
-        }
-        j += m;
-    }
-    
-    // Danielson-Lanczos section
-    for (size_t mmax = 1; mmax < n; mmax *= 2) {
-        float theta = (inverse ? 1.0f : -1.0f) * 3.14159265358979f / mmax;
-        std::complex<float> wphase(std::cos(theta), std::sin(theta));
-        std::complex<float> w(1.0f, 0.0f);
-        
-        for (size_t m = 0; m < mmax; ++m) {
-            for (size_t i = m; i < n; i += mmax * 2) {
-                size_t j = i + mmax;
-                std::complex<float> temp = w * data[j];
-                data[j] = data[i] - temp;
-                data[i] = data[i] + temp;
-            }
-            w *= wphase;
-        }
-    }
-}
-
-std::vector<std::string> ConvolutionReverb::getIRPresets() {
-    return {
-        "Small Room",
-        "Medium Room",
-        "Large Hall",
-        "Cathedral",
-        "Plate",
-        "Spring",
-        "Cave",
-        "Outdoor"
-    };
-}
-
-bool ConvolutionReverb::loadPreset(const std::string& presetName) {
-    std::string path = "audio/impulses/" + presetName + ".wav";
-    return loadImpulseResponse(path);
-}
-
 // ============================================================================
 // FMOD INTEGRATION
 // ============================================================================
@@ -795,234 +519,4 @@ void AmbisonicsEncoder::computeSHCoefficients(float azimuth, float elevation) {
     // Order 3 would add 7 more channels...
 }
 
-// ============================================================================
-// DSP EFFECTS
-// ============================================================================
-
-void LowPassFilter::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
-    if (bypass) return;
-    
-    // Simple one-pole low-pass filter
-    float dt = 1.0f / sampleRate;
-    float rc = 1.0f / (2.0f * 3.14159f * cutoffFreq_);
-    float alpha = dt / (rc + dt);
-    
-    for (size_t i = 0; i < frameCount; ++i) {
-        for (uint32_t c = 0; c < channels; ++c) {
-            float sample = buffer[i * channels + c];
-            sample = prevSamples_[c][0] + alpha * (sample - prevSamples_[c][0]);
-            prevSamples_[c][0] = sample;
-            
-            buffer[i * channels + c] = sample * mix + buffer[i * channels + c] * (1.0f - mix);
-        }
-    }
-}
-
-void LowPassFilter::reset() {
-    std::memset(prevSamples_, 0, sizeof(prevSamples_));
-}
-
-void HighPassFilter::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
-    if (bypass) return;
-    
-    float dt = 1.0f / sampleRate;
-    float rc = 1.0f / (2.0f * 3.14159f * cutoffFreq_);
-    float alpha = rc / (rc + dt);
-    
-    for (size_t i = 0; i < frameCount; ++i) {
-        for (uint32_t c = 0; c < channels; ++c) {
-            float sample = buffer[i * channels + c];
-            float filtered = alpha * (prevSamples_[c][1] + sample - prevSamples_[c][0]);
-            prevSamples_[c][0] = sample;
-            prevSamples_[c][1] = filtered;
-            
-            buffer[i * channels + c] = filtered * mix + buffer[i * channels + c] * (1.0f - mix);
-        }
-    }
-}
-
-void HighPassFilter::reset() {
-    std::memset(prevSamples_, 0, sizeof(prevSamples_));
-}
-
-void Compressor::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
-    if (bypass) return;
-    
-    float threshold = std::pow(10.0f, thresholdDb_ / 20.0f);
-    float makeupGain = std::pow(10.0f, makeupGainDb_ / 20.0f);
-    float attackCoef = std::exp(-1.0f / (attackMs_ * 0.001f * sampleRate));
-    float releaseCoef = std::exp(-1.0f / (releaseMs_ * 0.001f * sampleRate));
-    
-    for (size_t i = 0; i < frameCount; ++i) {
-        // Find peak across channels
-        float peak = 0.0f;
-        for (uint32_t c = 0; c < channels; ++c) {
-            peak = std::max(peak, std::abs(buffer[i * channels + c]));
-        }
-        
-        // Update envelope
-        if (peak > envelope_) {
-            envelope_ = attackCoef * envelope_ + (1.0f - attackCoef) * peak;
-        } else {
-            envelope_ = releaseCoef * envelope_ + (1.0f - releaseCoef) * peak;
-        }
-        
-        // Calculate gain reduction
-        float gain = 1.0f;
-        if (envelope_ > threshold) {
-            float overDb = 20.0f * std::log10(envelope_ / threshold);
-            float reducedDb = overDb * (1.0f - 1.0f / ratio_);
-            gain = std::pow(10.0f, -reducedDb / 20.0f);
-        }
-        
-        // Apply gain
-        for (uint32_t c = 0; c < channels; ++c) {
-            buffer[i * channels + c] *= gain * makeupGain;
-        }
-    }
-}
-
-void Compressor::reset() {
-    envelope_ = 0.0f;
-}
-
-void Limiter::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
-    if (bypass) return;
-    
-    float threshold = std::pow(10.0f, thresholdDb_ / 20.0f);
-    float releaseCoef = std::exp(-1.0f / (releaseMs_ * 0.001f * sampleRate));
-    
-    for (size_t i = 0; i < frameCount; ++i) {
-        // Find peak
-        float peak = 0.0f;
-        for (uint32_t c = 0; c < channels; ++c) {
-            peak = std::max(peak, std::abs(buffer[i * channels + c]));
-        }
-        
-        // Calculate required gain
-        float targetGain = (peak > threshold) ? threshold / peak : 1.0f;
-        
-        // Smooth gain changes
-        if (targetGain < gain_) {
-            gain_ = targetGain;  // Instant attack
-        } else {
-            gain_ = releaseCoef * gain_ + (1.0f - releaseCoef) * targetGain;
-        }
-        
-        // Apply
-        for (uint32_t c = 0; c < channels; ++c) {
-            buffer[i * channels + c] *= gain_;
-        }
-    }
-}
-
-void Limiter::reset() {
-    gain_ = 1.0f;
-}
-
-void Delay::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
-    if (bypass) return;
-    
-    size_t delaySamples = (size_t)(delayTimeMs_ * 0.001f * sampleRate) * channels;
-    
-    if (delayBuffer_.size() != delaySamples) {
-        delayBuffer_.resize(delaySamples, 0.0f);
-        delayPos_ = 0;
-    }
-    
-    for (size_t i = 0; i < frameCount; ++i) {
-        for (uint32_t c = 0; c < channels; ++c) {
-            size_t idx = i * channels + c;
-            size_t delayIdx = (delayPos_ + c) % delayBuffer_.size();
-            
-            float delayed = delayBuffer_[delayIdx];
-            float input = buffer[idx];
-            
-            delayBuffer_[delayIdx] = input + delayed * feedback_;
-            buffer[idx] = input * (1.0f - mix) + delayed * mix;
-        }
-        
-        delayPos_ = (delayPos_ + channels) % delayBuffer_.size();
-    }
-}
-
-void Delay::reset() {
-    std::fill(delayBuffer_.begin(), delayBuffer_.end(), 0.0f);
-    delayPos_ = 0;
-}
-
-void Chorus::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
-    if (bypass) return;
-    
-    // Delay buffer for modulation
-    size_t maxDelaySamples = (size_t)(30.0f * 0.001f * sampleRate) * channels;
-    if (delayBuffer_.size() != maxDelaySamples) {
-        delayBuffer_.resize(maxDelaySamples, 0.0f);
-        writePos_ = 0;
-    }
-    
-    float phaseIncrement = rate_ / sampleRate;
-    
-    for (size_t i = 0; i < frameCount; ++i) {
-        float lfo = std::sin(phase_ * 2.0f * 3.14159f);
-        phase_ += phaseIncrement;
-        if (phase_ >= 1.0f) phase_ -= 1.0f;
-        
-        float delayMs = 10.0f + lfo * depth_ * 10.0f;
-        size_t delaySamples = (size_t)(delayMs * 0.001f * sampleRate);
-        
-        for (uint32_t c = 0; c < channels; ++c) {
-            size_t idx = i * channels + c;
-            size_t writeIdx = (writePos_ + c) % delayBuffer_.size();
-            
-            delayBuffer_[writeIdx] = buffer[idx];
-            
-            size_t readIdx = (writePos_ + delayBuffer_.size() - delaySamples * channels + c) % delayBuffer_.size();
-            float delayed = delayBuffer_[readIdx];
-            
-            buffer[idx] = buffer[idx] * 0.5f + delayed * 0.5f;
-        }
-        
-        writePos_ = (writePos_ + channels) % delayBuffer_.size();
-    }
-}
-
-void Chorus::reset() {
-    std::fill(delayBuffer_.begin(), delayBuffer_.end(), 0.0f);
-    writePos_ = 0;
-    phase_ = 0.0f;
-}
-
-// ============================================================================
-// EFFECTS CHAIN
-// ============================================================================
-
-void EffectsChain::addEffect(std::unique_ptr<IAudioEffect> effect) {
-    effects_.push_back(std::move(effect));
-}
-
-void EffectsChain::removeEffect(size_t index) {
-    if (index < effects_.size()) {
-        effects_.erase(effects_.begin() + index);
-    }
-}
-
-void EffectsChain::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
-    for (auto& effect : effects_) {
-        if (!effect->bypass) {
-            effect->process(buffer, frameCount, channels, sampleRate);
-        }
-    }
-}
-
-void EffectsChain::reset() {
-    for (auto& effect : effects_) {
-        effect->reset();
-    }
-}
-
-IAudioEffect* EffectsChain::getEffect(size_t index) {
-    return index < effects_.size() ? effects_[index].get() : nullptr;
-}
-
 } // namespace Sanic
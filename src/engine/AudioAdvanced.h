@@ -19,6 +19,7 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
+#include <cstring>
 #include <memory>
 #include <functional>
 #include <complex>
@@ -243,7 +244,50 @@ public:
 // ============================================================================
 
 /**
- * High-quality convolution reverb using FFT
+ * Real-input FFT of a fixed power-of-two size on split re/im arrays, with
+ * precomputed twiddles and SSE butterflies.
+ *
+ * A transform of size N yields N/2 bins. The DC and Nyquist bins are both
+ * real, so the Nyquist value is packed into im[0].
+ */
+class RealFFT {
+public:
+    void setup(size_t size);            // Power of two, at least 16
+    size_t getSize() const { return size_; }
+    
+    void forward(const float* input, float* re, float* im);
+    
+    // Unnormalized: inverse(forward(x)) == size * x
+    void inverse(const float* re, const float* im, float* output);
+    
+private:
+    size_t size_ = 0;
+    std::vector<uint32_t> bitReverse_;  // size/2 entries
+    std::vector<float> twiddleRe_;      // Per stage of half-length h, at offset h - 1
+    std::vector<float> twiddleIm_;
+    std::vector<float> splitRe_;        // e^(-2 pi i k / size), k < size/2
+    std::vector<float> splitIm_;
+    std::vector<float> workRe_;
+    std::vector<float> workIm_;
+    
+    // In-place complex FFT of size/2 points, input in bit-reversed order
+    void transform(float* re, float* im) const;
+};
+
+/**
+ * Stereo convolution reverb with a fixed latency of BLOCK_SIZE frames.
+ *
+ * The IR is split across two uniformly partitioned stages, each with a
+ * frequency-domain delay line of past input spectra:
+ * - the head stage covers the first TAIL_BLOCK_SIZE - BLOCK_SIZE samples
+ *   in BLOCK_SIZE partitions and runs every block;
+ * - the tail stage covers the rest in TAIL_BLOCK_SIZE partitions. Its
+ *   multiply-accumulate work is spread evenly over the head blocks, so a
+ *   multi-second hall costs a few dozen partitions rather than hundreds.
+ *
+ * Each input channel is convolved with the matching IR channel; a mono IR
+ * is applied to both. process() does not allocate. Loading an IR
+ * reallocates, so it must not run concurrently with process().
  */
 class ConvolutionReverb : public IReverbPlugin {
 public:
@@ -277,29 +321,43 @@ private:
     float irGain_ = 1.0f;
     float latencyMs_ = 0.0f;
     
-    // FFT convolution data
-    static constexpr size_t FFT_SIZE = 2048;
-    static constexpr size_t HOP_SIZE = FFT_SIZE / 2;
-    
-    // Impulse response in frequency domain
-    std::vector<std::complex<float>> irFreqL_;
-    std::vector<std::complex<float>> irFreqR_;
-    size_t irLength_ = 0;
-    size_t numPartitions_ = 0;
-    
-    // Overlap-add buffers
-    std::vector<float> overlapL_;
-    std::vector<float> overlapR_;
-    std::vector<float> inputBuffer_;
-    size_t inputPos_ = 0;
-    
-    // FFT buffers
-    std::vector<std::complex<float>> fftBuffer_;
-    std::vector<float> timeBuffer_;
-    
-    // FFT implementation (using simple DFT or external library)
-    void fft(std::complex<float>* data, size_t n, bool inverse);
-    void processPartitioned(const float* input, float* output, size_t frameCount);
+    static constexpr size_t CHANNELS = 2;
+    static constexpr size_t BLOCK_SIZE = 256;
+    static constexpr size_t TAIL_BLOCK_SIZE = 4096;
+    
+    // One uniformly partitioned convolution over a segment of the IR
+    struct Stage {
+        size_t blockSize = 0;
+        size_t partitionCount = 0;
+        RealFFT fft;
+        
+        std::vector<float> irSpectra;   // [channel][partition][re | im], blockSize bins
+        std::vector<float> delayLine;   // [channel][slot][re | im], ring of input spectra
+        std::vector<float> accumulator; // [channel][re | im]
+        std::vector<float> window;      // [channel][2 * blockSize]: previous block, current
+        std::vector<float> output;      // [channel][blockSize]
+        std::vector<float> scratch;     // 2 * blockSize
+        size_t slot = 0;                // Delay-line slot of the next input spectrum
+        size_t fill = 0;                // Samples of the current block gathered
+        
+        void setup(size_t size, const float* ir, uint32_t irChannels,
+                   size_t offset, size_t length, float gain);
+        void reset();
+        void transformInput();                      // Current block into the delay line
+        void accumulate(size_t first, size_t last); // Partitions [first, last)
+        void finish();                              // Accumulator to output; next slot
+    };
+    
+    Stage head_;
+    Stage tail_;
+    size_t tailReadPos_ = 0;
+    
+    // BLOCK_SIZE frames of input being gathered, and of output being played
+    std::vector<float> blockInput_;     // [channel][BLOCK_SIZE]
+    std::vector<float> blockOutput_;
+    size_t blockPos_ = 0;
+    
+    void processBlock();
 };
 
 // ============================================================================
@@ -0,0 +1,686 @@
+/**
+ * AudioEffects.cpp
+ * 
+ * DSP effects and effects chains applied to voices by the mixer, and the
+ * convolution reverb. Kept apart from AudioAdvanced.cpp, which isn't built.
+ */
+
+#include "AudioAdvanced.h"
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SANIC_AUDIO_SSE2 1
+#else
+#define SANIC_AUDIO_SSE2 0
+#endif
+
+namespace Sanic {
+
+// ============================================================================
+// DSP EFFECTS
+// ============================================================================
+
+void LowPassFilter::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
+    if (bypass) return;
+    
+    // Simple one-pole low-pass filter
+    float dt = 1.0f / sampleRate;
+    float rc = 1.0f / (2.0f * 3.14159f * cutoffFreq_);
+    float alpha = dt / (rc + dt);
+    
+    for (size_t i = 0; i < frameCount; ++i) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            float sample = buffer[i * channels + c];
+            sample = prevSamples_[c][0] + alpha * (sample - prevSamples_[c][0]);
+            prevSamples_[c][0] = sample;
+            
+            buffer[i * channels + c] = sample * mix + buffer[i * channels + c] * (1.0f - mix);
+        }
+    }
+}
+
+void LowPassFilter::reset() {
+    std::memset(prevSamples_, 0, sizeof(prevSamples_));
+}
+
+void HighPassFilter::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
+    if (bypass) return;
+    
+    float dt = 1.0f / sampleRate;
+    float rc = 1.0f / (2.0f * 3.14159f * cutoffFreq_);
+    float alpha = rc / (rc + dt);
+    
+    for (size_t i = 0; i < frameCount; ++i) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            float sample = buffer[i * channels + c];
+            float filtered = alpha * (prevSamples_[c][1] + sample - prevSamples_[c][0]);
+            prevSamples_[c][0] = sample;
+            prevSamples_[c][1] = filtered;
+            
+            buffer[i * channels + c] = filtered * mix + buffer[i * channels + c] * (1.0f - mix);
+        }
+    }
+}
+
+void HighPassFilter::reset() {
+    std::memset(prevSamples_, 0, sizeof(prevSamples_));
+}
+
+void Compressor::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
+    if (bypass) return;
+    
+    float threshold = std::pow(10.0f, thresholdDb_ / 20.0f);
+    float makeupGain = std::pow(10.0f, makeupGainDb_ / 20.0f);
+    float attackCoef = std::exp(-1.0f / (attackMs_ * 0.001f * sampleRate));
+    float releaseCoef = std::exp(-1.0f / (releaseMs_ * 0.001f * sampleRate));
+    
+    for (size_t i = 0; i < frameCount; ++i) {
+        // Find peak across channels
+        float peak = 0.0f;
+        for (uint32_t c = 0; c < channels; ++c) {
+            peak = std::max(peak, std::abs(buffer[i * channels + c]));
+        }
+        
+        // Update envelope
+        if (peak > envelope_) {
+            envelope_ = attackCoef * envelope_ + (1.0f - attackCoef) * peak;
+        } else {
+            envelope_ = releaseCoef * envelope_ + (1.0f - releaseCoef) * peak;
+        }
+        
+        // Calculate gain reduction
+        float gain = 1.0f;
+        if (envelope_ > threshold) {
+            float overDb = 20.0f * std::log10(envelope_ / threshold);
+            float reducedDb = overDb * (1.0f - 1.0f / ratio_);
+            gain = std::pow(10.0f, -reducedDb / 20.0f);
+        }
+        
+        // Apply gain
+        for (uint32_t c = 0; c < channels; ++c) {
+            buffer[i * channels + c] *= gain * makeupGain;
+        }
+    }
+}
+
+void Compressor::reset() {
+    envelope_ = 0.0f;
+}
+
+void Limiter::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
+    if (bypass) return;
+    
+    float threshold = std::pow(10.0f, thresholdDb_ / 20.0f);
+    float releaseCoef = std::exp(-1.0f / (releaseMs_ * 0.001f * sampleRate));
+    
+    for (size_t i = 0; i < frameCount; ++i) {
+        // Find peak
+        float peak = 0.0f;
+        for (uint32_t c = 0; c < channels; ++c) {
+            peak = std::max(peak, std::abs(buffer[i * channels + c]));
+        }
+        
+        // Calculate required gain
+        float targetGain = (peak > threshold) ? threshold / peak : 1.0f;
+        
+        // Smooth gain changes
+        if (targetGain < gain_) {
+            gain_ = targetGain;  // Instant attack
+        } else {
+            gain_ = releaseCoef * gain_ + (1.0f - releaseCoef) * targetGain;
+        }
+        
+        // Apply
+        for (uint32_t c = 0; c < channels; ++c) {
+            buffer[i * channels + c] *= gain_;
+        }
+    }
+}
+
+void Limiter::reset() {
+    gain_ = 1.0f;
+}
+
+void Delay::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
+    if (bypass) return;
+    
+    size_t delaySamples = (size_t)(delayTimeMs_ * 0.001f * sampleRate) * channels;
+    
+    if (delayBuffer_.size() != delaySamples) {
+        delayBuffer_.resize(delaySamples, 0.0f);
+        delayPos_ = 0;
+    }
+    
+    for (size_t i = 0; i < frameCount; ++i) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            size_t idx = i * channels + c;
+            size_t delayIdx = (delayPos_ + c) % delayBuffer_.size();
+            
+            float delayed = delayBuffer_[delayIdx];
+            float input = buffer[idx];
+            
+            delayBuffer_[delayIdx] = input + delayed * feedback_;
+            buffer[idx] = input * (1.0f - mix) + delayed * mix;
+        }
+        
+        delayPos_ = (delayPos_ + channels) % delayBuffer_.size();
+    }
+}
+
+void Delay::reset() {
+    std::fill(delayBuffer_.begin(), delayBuffer_.end(), 0.0f);
+    delayPos_ = 0;
+}
+
+void Chorus::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
+    if (bypass) return;
+    
+    // Delay buffer for modulation
+    size_t maxDelaySamples = (size_t)(30.0f * 0.001f * sampleRate) * channels;
+    if (delayBuffer_.size() != maxDelaySamples) {
+        delayBuffer_.resize(maxDelaySamples, 0.0f);
+        writePos_ = 0;
+    }
+    
+    float phaseIncrement = rate_ / sampleRate;
+    
+    for (size_t i = 0; i < frameCount; ++i) {
+        float lfo = std::sin(phase_ * 2.0f * 3.14159f);
+        phase_ += phaseIncrement;
+        if (phase_ >= 1.0f) phase_ -= 1.0f;
+        
+        float delayMs = 10.0f + lfo * depth_ * 10.0f;
+        size_t delaySamples = (size_t)(delayMs * 0.001f * sampleRate);
+        
+        for (uint32_t c = 0; c < channels; ++c) {
+            size_t idx = i * channels + c;
+            size_t writeIdx = (writePos_ + c) % delayBuffer_.size();
+            
+            delayBuffer_[writeIdx] = buffer[idx];
+            
+            size_t readIdx = (writePos_ + delayBuffer_.size() - delaySamples * channels + c) % delayBuffer_.size();
+            float delayed = delayBuffer_[readIdx];
+            
+            buffer[idx] = buffer[idx] * 0.5f + delayed * 0.5f;
+        }
+        
+        writePos_ = (writePos_ + channels) % delayBuffer_.size();
+    }
+}
+
+void Chorus::reset() {
+    std::fill(delayBuffer_.begin(), delayBuffer_.end(), 0.0f);
+    writePos_ = 0;
+    phase_ = 0.0f;
+}
+
+// ============================================================================
+// EFFECTS CHAIN
+// ============================================================================
+
+void EffectsChain::addEffect(std::unique_ptr<IAudioEffect> effect) {
+    effects_.push_back(std::move(effect));
+}
+
+void EffectsChain::removeEffect(size_t index) {
+    if (index < effects_.size()) {
+        effects_.erase(effects_.begin() + index);
+    }
+}
+
+void EffectsChain::process(float* buffer, size_t frameCount, uint32_t channels, uint32_t sampleRate) {
+    for (auto& effect : effects_) {
+        if (!effect->bypass) {
+            effect->process(buffer, frameCount, channels, sampleRate);
+        }
+    }
+}
+
+void EffectsChain::reset() {
+    for (auto& effect : effects_) {
+        effect->reset();
+    }
+}
+
+IAudioEffect* EffectsChain::getEffect(size_t index) {
+    return index < effects_.size() ? effects_[index].get() : nullptr;
+}
+
+// ============================================================================
+// REAL FFT
+// ============================================================================
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+
+// acc += x * h over split spectra of `bins` bins (a multiple of 4). Bin 0
+// packs the real DC and Nyquist values, which multiply separately.
+void multiplyAccumulate(const float* xRe, const float* xIm, const float* hRe, const float* hIm,
+                        float* accRe, float* accIm, size_t bins) {
+    float dc = accRe[0] + xRe[0] * hRe[0];
+    float nyquist = accIm[0] + xIm[0] * hIm[0];
+    
+#if SANIC_AUDIO_SSE2
+    for (size_t k = 0; k < bins; k += 4) {
+        __m128 ar = _mm_loadu_ps(xRe + k), ai = _mm_loadu_ps(xIm + k);
+        __m128 br = _mm_loadu_ps(hRe + k), bi = _mm_loadu_ps(hIm + k);
+        __m128 re = _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi));
+        __m128 im = _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br));
+        _mm_storeu_ps(accRe + k, _mm_add_ps(_mm_loadu_ps(accRe + k), re));
+        _mm_storeu_ps(accIm + k, _mm_add_ps(_mm_loadu_ps(accIm + k), im));
+    }
+#else
+    for (size_t k = 0; k < bins; ++k) {
+        accRe[k] += xRe[k] * hRe[k] - xIm[k] * hIm[k];
+        accIm[k] += xRe[k] * hIm[k] + xIm[k] * hRe[k];
+    }
+#endif
+    
+    accRe[0] = dc;
+    accIm[0] = nyquist;
+}
+
+} // namespace
+
+void RealFFT::setup(size_t size) {
+    size_ = size;
+    const size_t half = size / 2;
+    
+    uint32_t bits = 0;
+    while ((size_t(1) << bits) < half) bits++;
+    bitReverse_.resize(half);
+    for (size_t i = 0; i < half; ++i) {
+        uint32_t r = 0;
+        for (uint32_t b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        bitReverse_[i] = r;
+    }
+    
+    twiddleRe_.resize(half);
+    twiddleIm_.resize(half);
+    for (size_t h = 1; h < half; h *= 2) {
+        for (size_t k = 0; k < h; ++k) {
+            float angle = -PI * k / h;
+            twiddleRe_[h - 1 + k] = std::cos(angle);
+            twiddleIm_[h - 1 + k] = std::sin(angle);
+        }
+    }
+    
+    splitRe_.resize(half);
+    splitIm_.resize(half);
+    for (size_t k = 0; k < half; ++k) {
+        float angle = -2.0f * PI * k / size;
+        splitRe_[k] = std::cos(angle);
+        splitIm_[k] = std::sin(angle);
+    }
+    
+    workRe_.assign(half, 0.0f);
+    workIm_.assign(half, 0.0f);
+}
+
+void RealFFT::transform(float* re, float* im) const {
+    const size_t n = size_ / 2;
+    
+    // Lengths 2 and 4 as one radix-4 pass: twiddles are 1 and -i
+    for (size_t i = 0; i < n; i += 4) {
+        float r0 = re[i] + re[i + 1], i0 = im[i] + im[i + 1];
+        float r1 = re[i] - re[i + 1], i1 = im[i] - im[i + 1];
+        float r2 = re[i + 2] + re[i + 3], i2 = im[i + 2] + im[i + 3];
+        float r3 = re[i + 2] - re[i + 3], i3 = im[i + 2] - im[i + 3];
+        re[i] = r0 + r2;      im[i] = i0 + i2;
+        re[i + 2] = r0 - r2;  im[i + 2] = i0 - i2;
+        re[i + 1] = r1 + i3;  im[i + 1] = i1 - r3;
+        re[i + 3] = r1 - i3;  im[i + 3] = i1 + r3;
+    }
+    
+    for (size_t h = 4; h < n; h *= 2) {
+        const float* wr = twiddleRe_.data() + h - 1;
+        const float* wi = twiddleIm_.data() + h - 1;
+        
+        for (size_t start = 0; start < n; start += 2 * h) {
+            float* ar = re + start;
+            float* ai = im + start;
+            float* br = ar + h;
+            float* bi = ai + h;
+            
+#if SANIC_AUDIO_SSE2
+            for (size_t k = 0; k < h; k += 4) {
+                __m128 cr = _mm_loadu_ps(wr + k), ci = _mm_loadu_ps(wi + k);
+                __m128 xr = _mm_loadu_ps(br + k), xi = _mm_loadu_ps(bi + k);
+                __m128 tr = _mm_sub_ps(_mm_mul_ps(xr, cr), _mm_mul_ps(xi, ci));
+                __m128 ti = _mm_add_ps(_mm_mul_ps(xr, ci), _mm_mul_ps(xi, cr));
+                __m128 ur = _mm_loadu_ps(ar + k), ui = _mm_loadu_ps(ai + k);
+                _mm_storeu_ps(ar + k, _mm_add_ps(ur, tr));
+                _mm_storeu_ps(ai + k, _mm_add_ps(ui, ti));
+                _mm_storeu_ps(br + k, _mm_sub_ps(ur, tr));
+                _mm_storeu_ps(bi + k, _mm_sub_ps(ui, ti));
+            }
+#else
+            for (size_t k = 0; k < h; ++k) {
+                float tr = br[k] * wr[k] - bi[k] * wi[k];
+                float ti = br[k] * wi[k] + bi[k] * wr[k];
+                br[k] = ar[k] - tr;
+                bi[k] = ai[k] - ti;
+                ar[k] += tr;
+                ai[k] += ti;
+            }
+#endif
+        }
+    }
+}
+
+void RealFFT::forward(const float* input, float* re, float* im) {
+    const size_t n = size_ / 2;
+    
+    // Even samples as real parts, odd as imaginary
+    for (size_t i = 0; i < n; ++i) {
+        workRe_[bitReverse_[i]] = input[2 * i];
+        workIm_[bitReverse_[i]] = input[2 * i + 1];
+    }
+    transform(workRe_.data(), workIm_.data());
+    
+    // Separate the even and odd spectra, then combine
+    re[0] = workRe_[0] + workIm_[0];
+    im[0] = workRe_[0] - workIm_[0];
+    for (size_t k = 1; k < n; ++k) {
+        float ar = workRe_[k], ai = workIm_[k];
+        float br = workRe_[n - k], bi = -workIm_[n - k];
+        float evenRe = 0.5f * (ar + br), evenIm = 0.5f * (ai + bi);
+        float oddRe = 0.5f * (ai - bi), oddIm = -0.5f * (ar - br);
+        re[k] = evenRe + oddRe * splitRe_[k] - oddIm * splitIm_[k];
+        im[k] = evenIm + oddRe * splitIm_[k] + oddIm * splitRe_[k];
+    }
+}
+
+void RealFFT::inverse(const float* re, const float* im, float* output) {
+    const size_t n = size_ / 2;
+    
+    workRe_[0] = re[0] + im[0];
+    workIm_[0] = re[0] - im[0];
+    for (size_t k = 1; k < n; ++k) {
+        float br = re[n - k], bi = -im[n - k];
+        float evenRe = re[k] + br, evenIm = im[k] + bi;
+        float dRe = re[k] - br, dIm = im[k] - bi;
+        float oddRe = dRe * splitRe_[k] + dIm * splitIm_[k];
+        float oddIm = dIm * splitRe_[k] - dRe * splitIm_[k];
+        workRe_[bitReverse_[k]] = evenRe - oddIm;
+        workIm_[bitReverse_[k]] = evenIm + oddRe;
+    }
+    
+    // Swapping re and im turns the forward transform into the inverse
+    transform(workIm_.data(), workRe_.data());
+    
+    for (size_t i = 0; i < n; ++i) {
+        output[2 * i] = workRe_[i];
+        output[2 * i + 1] = workIm_[i];
+    }
+}
+
+// ============================================================================
+// CONVOLUTION REVERB
+// ============================================================================
+
+void ConvolutionReverb::Stage::setup(size_t size, const float* ir, uint32_t irChannels,
+                                     size_t offset, size_t length, float gain) {
+    blockSize = size;
+    partitionCount = (length + size - 1) / size;
+    fft.setup(2 * size);
+    
+    const size_t spectrum = 2 * size;
+    irSpectra.assign(CHANNELS * partitionCount * spectrum, 0.0f);
+    delayLine.assign(CHANNELS * partitionCount * spectrum, 0.0f);
+    accumulator.assign(CHANNELS * spectrum, 0.0f);
+    window.assign(CHANNELS * 2 * size, 0.0f);
+    output.assign(CHANNELS * size, 0.0f);
+    scratch.assign(2 * size, 0.0f);
+    slot = 0;
+    fill = 0;
+    
+    // Partitions zero-padded to the FFT size, with the inverse's 1/(2 * size) folded in
+    const float scale = gain / (2 * size);
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        size_t source = std::min<size_t>(c, irChannels - 1);
+        for (size_t p = 0; p < partitionCount; ++p) {
+            size_t begin = p * size;
+            size_t count = std::min(size, length - begin);
+            std::fill(scratch.begin(), scratch.end(), 0.0f);
+            for (size_t i = 0; i < count; ++i) {
+                scratch[i] = ir[(offset + begin + i) * irChannels + source] * scale;
+            }
+            
+            float* dst = &irSpectra[(c * partitionCount + p) * spectrum];
+            fft.forward(scratch.data(), dst, dst + size);
+        }
+    }
+}
+
+void ConvolutionReverb::Stage::reset() {
+    std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+    std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+    std::fill(window.begin(), window.end(), 0.0f);
+    std::fill(output.begin(), output.end(), 0.0f);
+    slot = 0;
+    fill = 0;
+}
+
+void ConvolutionReverb::Stage::transformInput() {
+    const size_t spectrum = 2 * blockSize;
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        float* samples = &window[c * 2 * blockSize];
+        float* dst = &delayLine[(c * partitionCount + slot) * spectrum];
+        fft.forward(samples, dst, dst + blockSize);
+        std::copy(samples + blockSize, samples + 2 * blockSize, samples);
+    }
+}
+
+void ConvolutionReverb::Stage::accumulate(size_t first, size_t last) {
+    const size_t spectrum = 2 * blockSize;
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        float* accRe = &accumulator[c * spectrum];
+        float* accIm = accRe + blockSize;
+        
+        for (size_t p = first; p < last; ++p) {
+            // Partition p pairs with the input spectrum from p blocks ago
+            size_t inputSlot = (slot + partitionCount - p) % partitionCount;
+            const float* x = &delayLine[(c * partitionCount + inputSlot) * spectrum];
+            const float* h = &irSpectra[(c * partitionCount + p) * spectrum];
+            multiplyAccumulate(x, x + blockSize, h, h + blockSize, accRe, accIm, blockSize);
+        }
+    }
+}
+
+void ConvolutionReverb::Stage::finish() {
+    const size_t spectrum = 2 * blockSize;
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        float* acc = &accumulator[c * spectrum];
+        fft.inverse(acc, acc + blockSize, scratch.data());
+        std::fill(acc, acc + spectrum, 0.0f);
+        
+        // Overlap-save: the first half wrapped around and is discarded
+        std::copy(scratch.begin() + blockSize, scratch.end(), output.begin() + c * blockSize);
+    }
+    slot = (slot + 1) % partitionCount;
+}
+
+ConvolutionReverb::ConvolutionReverb() {
+    blockInput_.resize(CHANNELS * BLOCK_SIZE, 0.0f);
+    blockOutput_.resize(CHANNELS * BLOCK_SIZE, 0.0f);
+}
+
+ConvolutionReverb::~ConvolutionReverb() {
+    shutdown();
+}
+
+bool ConvolutionReverb::initialize() {
+    head_.reset();
+    tail_.reset();
+    tailReadPos_ = 0;
+    blockPos_ = 0;
+    std::fill(blockOutput_.begin(), blockOutput_.end(), 0.0f);
+    return true;
+}
+
+void ConvolutionReverb::shutdown() {
+    head_ = Stage();
+    tail_ = Stage();
+}
+
+void ConvolutionReverb::setParams(const FReverbParams& params) {
+    params_ = params;
+}
+
+bool ConvolutionReverb::loadImpulseResponse(const std::string& path) {
+    // Load WAV file
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    
+    // Read WAV header
+    char header[44];
+    file.read(header, 44);
+    
+    // Parse header
+    uint16_t channels = *reinterpret_cast<uint16_t*>(&header[22]);
+    uint32_t sampleRate = *reinterpret_cast<uint32_t*>(&header[24]);
+    uint16_t bitsPerSample = *reinterpret_cast<uint16_t*>(&header[34]);
+    uint32_t dataSize = *reinterpret_cast<uint32_t*>(&header[40]);
+    
+    size_t numSamples = dataSize / (bitsPerSample / 8);
+    size_t samplesPerChannel = numSamples / channels;
+    
+    std::vector<float> irData(numSamples);
+    
+    if (bitsPerSample == 16) {
+        std::vector<int16_t> rawData(numSamples);
+        file.read(reinterpret_cast<char*>(rawData.data()), dataSize);
+        for (size_t i = 0; i < numSamples; ++i) {
+            irData[i] = rawData[i] / 32768.0f;
+        }
+    } else if (bitsPerSample == 32) {
+        file.read(reinterpret_cast<char*>(irData.data()), dataSize);
+    }
+    
+    return loadImpulseResponseFromMemory(irData.data(), samplesPerChannel, sampleRate, channels);
+}
+
+bool ConvolutionReverb::loadImpulseResponseFromMemory(const float* data, size_t sampleCount,
+                                                       uint32_t sampleRate, uint32_t channels) {
+    if (!data || sampleCount == 0 || channels == 0) {
+        return false;
+    }
+    
+    latencyMs_ = (float)BLOCK_SIZE / sampleRate * 1000.0f;
+    
+    // The tail's output for a block arrives TAIL_BLOCK_SIZE later than its
+    // input starts, one head block of which is already latency
+    const size_t headLength = std::min(sampleCount, TAIL_BLOCK_SIZE - BLOCK_SIZE);
+    head_.setup(BLOCK_SIZE, data, channels, 0, headLength, irGain_);
+    
+    tail_ = Stage();
+    if (sampleCount > headLength) {
+        tail_.setup(TAIL_BLOCK_SIZE, data, channels, headLength, sampleCount - headLength, irGain_);
+    }
+    
+    return initialize();
+}
+
+void ConvolutionReverb::process(float* buffer, size_t frameCount, uint32_t /*sampleRate*/) {
+    if (head_.partitionCount == 0) {
+        // No IR loaded, pass through
+        return;
+    }
+    
+    float wet = params_.wetLevel;
+    float dry = params_.dryLevel;
+    
+    size_t processed = 0;
+    while (processed < frameCount) {
+        size_t count = std::min(frameCount - processed, BLOCK_SIZE - blockPos_);
+        
+        for (size_t i = 0; i < count; ++i) {
+            float* frame = buffer + (processed + i) * 2;
+            for (size_t c = 0; c < CHANNELS; ++c) {
+                blockInput_[c * BLOCK_SIZE + blockPos_ + i] = frame[c];
+                frame[c] = dry * frame[c] + wet * blockOutput_[c * BLOCK_SIZE + blockPos_ + i];
+            }
+        }
+        
+        blockPos_ += count;
+        processed += count;
+        
+        if (blockPos_ == BLOCK_SIZE) {
+            processBlock();
+            blockPos_ = 0;
+        }
+    }
+}
+
+void ConvolutionReverb::processBlock() {
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        const float* input = &blockInput_[c * BLOCK_SIZE];
+        std::copy(input, input + BLOCK_SIZE, head_.window.begin() + c * 2 * BLOCK_SIZE + BLOCK_SIZE);
+        if (tail_.partitionCount > 0) {
+            std::copy(input, input + BLOCK_SIZE,
+                      tail_.window.begin() + c * 2 * TAIL_BLOCK_SIZE + TAIL_BLOCK_SIZE + tail_.fill);
+        }
+    }
+    
+    head_.transformInput();
+    head_.accumulate(0, head_.partitionCount);
+    head_.finish();
+    std::copy(head_.output.begin(), head_.output.end(), blockOutput_.begin());
+    
+    if (tail_.partitionCount > 0) {
+        // Older partitions only need past spectra, so their share of the
+        // next tail block is done a slice per head block
+        constexpr size_t slices = TAIL_BLOCK_SIZE / BLOCK_SIZE;
+        tail_.fill += BLOCK_SIZE;
+        size_t slice = tail_.fill / BLOCK_SIZE - 1;
+        size_t older = tail_.partitionCount - 1;
+        tail_.accumulate(1 + older * slice / slices, 1 + older * (slice + 1) / slices);
+        
+        if (tail_.fill == TAIL_BLOCK_SIZE) {
+            tail_.transformInput();
+            tail_.accumulate(0, 1);
+            tail_.finish();
+            tail_.fill = 0;
+            tailReadPos_ = 0;
+        }
+        
+        for (size_t c = 0; c < CHANNELS; ++c) {
+            const float* tail = &tail_.output[c * TAIL_BLOCK_SIZE + tailReadPos_];
+            float* out = &blockOutput_[c * BLOCK_SIZE];
+            for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+                out[i] += tail[i];
+            }
+        }
+        tailReadPos_ += BLOCK_SIZE;
+    }
+}
+
+std::vector<std::string> ConvolutionReverb::getIRPresets() {
+    return {
+        "Small Room",
+        "Medium Room",
+        "Large Hall",
+        "Cathedral",
+        "Plate",
+        "Spring",
+        "Cave",
+        "Outdoor"
+    };
+}
+
+bool ConvolutionReverb::loadPreset(const std::string& presetName) {
+    std::string path = "audio/impulses/" + presetName + ".wav";
+    return loadImpulseResponse(path);
+}
+
+} // namespace Sanic
@@ -6,8 +6,10 @@
  */
 
 #include "AudioSystem.h"
+#include "AudioAdvanced.h"
 #include <cmath>
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <cstring>
@@ -25,29 +27,61 @@ namespace Sanic {
 // AUDIO CLIP
 // ============================================================================
 
-AudioClip::~AudioClip() {
-    unload();
-}
-
-bool AudioClip::loadFromFile(const std::string& path) {
-    filePath_ = path;
-    
-    // Check file extension
-    std::string ext = path.substr(path.find_last_of('.') + 1);
-    
-    // For now, we'll just load WAV files
-    // In a real implementation, this would use a library like dr_wav, stb_vorbis, etc.
-    
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open audio file: " << path << std::endl;
-        return false;
-    }
+/**
+ * Decode state of a streaming clip. The I/O thread fills chunks from the
+ * free queue and hands them over through the ready queue; the mixer reads
+ * them in order and returns them. A seek bumps the generation, so chunks
+ * decoded for the old position are recognised and dropped.
+ */
+struct AudioStream {
+    struct Chunk {
+        uint32_t generation = 0;
+        size_t start = 0;           // First clip frame
+        uint32_t frames = 0;
+        float* samples = nullptr;   // Interleaved, into storage
+    };
     
-    // Read WAV header (simplified)
+    // Immutable after open
+    std::string path;
+    std::streamoff dataOffset = 0;
+    uint32_t channels = 0;
+    uint32_t bitsPerSample = 0;
+    size_t totalFrames = 0;
+    uint32_t chunkFrames = 0;
+    size_t memoryBytes = 0;
+    std::vector<float> storage;
+    std::vector<Chunk> chunks;
+    
+    SPSCQueue<uint32_t> ready;      // I/O thread -> mixer
+    SPSCQueue<uint32_t> free;       // Mixer -> I/O thread
+    
+    // Seek requests, mixer -> I/O thread
+    std::atomic<size_t> seekFrame{0};
+    std::atomic<uint32_t> requestedGeneration{0};
+    
+    // Mixer side
+    uint32_t current = UINT32_MAX;
+    size_t cursor = 0;
+    uint32_t generation = 0;
+    std::atomic<uint32_t> underruns{0};
+    
+    // I/O side
+    std::ifstream file;
+    std::vector<uint8_t> raw;
+    size_t decodeFrame = 0;
+    uint32_t decodeGeneration = 0;
+    
+    std::atomic<bool> closed{false};
+};
+
+namespace {
+
+// Reads a WAV header up to the start of its data chunk
+bool readWavHeader(std::ifstream& file, const std::string& path,
+                   AudioClipInfo& info, uint32_t& dataBytes) {
     char riff[4];
     file.read(riff, 4);
-    if (strncmp(riff, "RIFF", 4) != 0) {
+    if (!file || strncmp(riff, "RIFF", 4) != 0) {
         std::cerr << "Not a valid WAV file: " << path << std::endl;
         return false;
     }
@@ -56,7 +90,7 @@ bool AudioClip::loadFromFile(const std::string& path) {
     
     char wave[4];
     file.read(wave, 4);
-    if (strncmp(wave, "WAVE", 4) != 0) {
+    if (!file || strncmp(wave, "WAVE", 4) != 0) {
         std::cerr << "Not a valid WAV file: " << path << std::endl;
         return false;
     }
@@ -74,15 +108,15 @@ bool AudioClip::loadFromFile(const std::string& path) {
             
             uint16_t numChannels;
             file.read(reinterpret_cast<char*>(&numChannels), 2);
-            info_.channels = numChannels;
+            info.channels = numChannels;
             
-            file.read(reinterpret_cast<char*>(&info_.sampleRate), 4);
+            file.read(reinterpret_cast<char*>(&info.sampleRate), 4);
             
             file.seekg(6, std::ios::cur);  // Skip byte rate and block align
             
             uint16_t bitsPerSample;
             file.read(reinterpret_cast<char*>(&bitsPerSample), 2);
-            info_.bitsPerSample = bitsPerSample;
+            info.bitsPerSample = bitsPerSample;
             
             // Skip remaining fmt data
             if (chunkSize > 16) {
@@ -90,19 +124,14 @@ bool AudioClip::loadFromFile(const std::string& path) {
             }
         }
         else if (strncmp(chunkId, "data", 4) == 0) {
-            // Read audio data
-            size_t bytesPerSample = info_.bitsPerSample / 8;
-            info_.sampleCount = chunkSize / bytesPerSample;
-            
-            std::vector<uint8_t> rawData(chunkSize);
-            file.read(reinterpret_cast<char*>(rawData.data()), chunkSize);
-            
-            // Convert to float
-            samples_.resize(info_.sampleCount);
-            convertToFloat(rawData.data(), samples_.data(), info_.sampleCount,
-                          info_.bitsPerSample, info_.channels);
+            if (info.channels == 0 || info.bitsPerSample < 8) break;
             
-            break;
+            size_t bytesPerSample = info.bitsPerSample / 8;
+            info.sampleCount = chunkSize / bytesPerSample;
+            info.duration = static_cast<float>(info.sampleCount) /
+                            static_cast<float>(info.sampleRate * info.channels);
+            dataBytes = chunkSize;
+            return true;
         }
         else {
             // Skip unknown chunk
@@ -110,8 +139,108 @@ bool AudioClip::loadFromFile(const std::string& path) {
         }
     }
     
-    info_.duration = static_cast<float>(info_.sampleCount) / 
-                    static_cast<float>(info_.sampleRate * info_.channels);
+    std::cerr << "No audio data in WAV file: " << path << std::endl;
+    return false;
+}
+
+// Mixer side of a seek: discards the held chunk and asks for a refill
+void seekStream(AudioStream& stream, size_t frame) {
+    if (stream.current != UINT32_MAX) {
+        stream.free.push(stream.current);
+        stream.current = UINT32_MAX;
+    }
+    stream.cursor = frame % stream.totalFrames;
+    stream.generation++;
+    stream.seekFrame.store(stream.cursor, std::memory_order_relaxed);
+    stream.requestedGeneration.store(stream.generation, std::memory_order_release);
+}
+
+size_t readStream(AudioStream& stream, float* output, size_t frameCount, size_t frame) {
+    if (stream.totalFrames == 0) return 0;
+    
+    const uint32_t channels = stream.channels;
+    if (frame != stream.cursor) {
+        seekStream(stream, frame);
+    }
+    
+    size_t done = 0;
+    while (done < frameCount) {
+        if (stream.current == UINT32_MAX && !stream.ready.pop(stream.current)) {
+            break;
+        }
+        
+        const AudioStream::Chunk& chunk = stream.chunks[stream.current];
+        if (chunk.generation != stream.generation ||
+            stream.cursor < chunk.start || stream.cursor >= chunk.start + chunk.frames) {
+            // Decoded before a seek, or overtaken while the decoder lagged
+            stream.free.push(stream.current);
+            stream.current = UINT32_MAX;
+            continue;
+        }
+        
+        const size_t offset = stream.cursor - chunk.start;
+        const size_t count = std::min<size_t>(frameCount - done, chunk.frames - offset);
+        if (output) {
+            memcpy(output + done * channels, chunk.samples + offset * channels,
+                   count * channels * sizeof(float));
+        }
+        done += count;
+        stream.cursor += count;
+        
+        if (offset + count == chunk.frames) {
+            stream.free.push(stream.current);
+            stream.current = UINT32_MAX;
+        }
+        if (stream.cursor == stream.totalFrames) {
+            stream.cursor = 0;  // The decoder wraps with us
+        }
+    }
+    
+    if (done < frameCount) {
+        // Underrun: play silence but keep time, so the stream stays in
+        // step with its voice and anything synced to it
+        if (output) {
+            memset(output + done * channels, 0, (frameCount - done) * channels * sizeof(float));
+        }
+        stream.cursor = (stream.cursor + frameCount - done) % stream.totalFrames;
+        stream.underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    return frameCount;
+}
+
+} // namespace
+
+AudioClip::~AudioClip() {
+    unload();
+}
+
+bool AudioClip::loadFromFile(const std::string& path) {
+    filePath_ = path;
+    
+    // Check file extension
+    std::string ext = path.substr(path.find_last_of('.') + 1);
+    
+    // For now, we'll just load WAV files
+    // In a real implementation, this would use a library like dr_wav, stb_vorbis, etc.
+    
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open audio file: " << path << std::endl;
+        return false;
+    }
+    
+    uint32_t dataBytes = 0;
+    if (!readWavHeader(file, path, info_, dataBytes)) {
+        return false;
+    }
+    
+    std::vector<uint8_t> rawData(dataBytes);
+    file.read(reinterpret_cast<char*>(rawData.data()), dataBytes);
+    
+    // Convert to float
+    samples_.resize(info_.sampleCount);
+    convertToFloat(rawData.data(), samples_.data(), info_.sampleCount,
+                  info_.bitsPerSample, info_.channels);
     
     loaded_ = true;
     return true;
@@ -130,16 +259,30 @@ bool AudioClip::loadFromMemory(const void* data, size_t size, AudioClipInfo info
 void AudioClip::unload() {
     samples_.clear();
     samples_.shrink_to_fit();
+    if (stream_) {
+        // The streamer releases the chunks once it lets go of the stream
+        stream_->closed.store(true, std::memory_order_release);
+        stream_.reset();
+    }
     loaded_ = false;
 }
 
+size_t AudioClip::getFrameCount() const {
+    if (info_.channels == 0) return 0;
+    return (stream_ ? info_.sampleCount : samples_.size()) / info_.channels;
+}
+
 size_t AudioClip::streamSamples(float* output, size_t frameCount, size_t position) {
-    if (!loaded_ || samples_.empty()) return 0;
+    if (!loaded_ || info_.channels == 0) return 0;
+    if (stream_) {
+        return readStream(*stream_, output, frameCount, position / info_.channels);
+    }
+    if (samples_.empty() || position >= samples_.size()) return 0;
     
     size_t samplesToRead = std::min(frameCount * info_.channels, 
                                    samples_.size() - position);
     
-    if (samplesToRead > 0) {
+    if (samplesToRead > 0 && output) {
         memcpy(output, samples_.data() + position, samplesToRead * sizeof(float));
     }
     
@@ -165,25 +308,33 @@ void AudioSource::setConfig(const AudioSourceConfig& config) {
     config_ = config;
 }
 
+void AudioSource::setEffectsChain(std::shared_ptr<EffectsChain> effects) {
+    effects_ = std::move(effects);
+}
+
 void AudioSource::play() {
     if (!clip_) return;
     
     if (paused_) {
         paused_ = false;
+        pending_ = (pending_ & ~PendingPause) | PendingResume;
     } else {
         samplePosition_ = 0;
+        pending_ = PendingStart;
     }
     playing_ = true;
 }
 
 void AudioSource::pause() {
     paused_ = true;
+    pending_ = (pending_ & ~PendingResume) | PendingPause;
 }
 
 void AudioSource::stop() {
     playing_ = false;
     paused_ = false;
     samplePosition_ = 0;
+    pending_ = PendingStop;
 }
 
 void AudioSource::setTime(float time) {
@@ -191,6 +342,7 @@ void AudioSource::setTime(float time) {
     
     const AudioClipInfo& info = clip_->getInfo();
     samplePosition_ = static_cast<size_t>(time * info.sampleRate * info.channels);
+    pending_ |= PendingSeek;
 }
 
 float AudioSource::getTime() const {
@@ -214,7 +366,7 @@ void AudioSource::setDirection(const glm::vec3& direction) {
 }
 
 void AudioSource::setVolume(float volume) {
-    targetVolume_ = volume * config_.volume;
+    userVolume_ = volume;
 }
 
 void AudioSource::setPitch(float pitch) {
@@ -224,7 +376,7 @@ void AudioSource::setPitch(float pitch) {
 void AudioSource::updateInternal(float deltaTime, const glm::vec3& listenerPos,
                                  const glm::vec3& listenerForward, float occlusion) {
     if (!config_.is3D) {
-        currentVolume_ = config_.volume;
+        currentVolume_ = config_.volume * userVolume_;
         currentPan_ = 0.0f;
         return;
     }
@@ -265,7 +417,7 @@ void AudioSource::updateInternal(float deltaTime, const glm::vec3& listenerPos,
     float occlusionAttenuation = 1.0f - occlusionFactor_ * 0.8f;  // Max 80% reduction
     
     // Final volume
-    targetVolume_ = config_.volume * attenuation * coneAttenuation * occlusionAttenuation;
+    targetVolume_ = config_.volume * userVolume_ * attenuation * coneAttenuation * occlusionAttenuation;
     
     // Pan (stereo positioning)
     if (distance > 0.001f) {
@@ -280,53 +432,6 @@ void AudioSource::updateInternal(float deltaTime, const glm::vec3& listenerPos,
     currentPan_ = glm::mix(currentPan_, targetPan_, smoothing);
 }
 
-size_t AudioSource::mixSamples(float* output, size_t frameCount, uint32_t sampleRate) {
-    if (!clip_ || !playing_ || paused_) return 0;
-    
-    const std::vector<float>& samples = clip_->getSamples();
-    const AudioClipInfo& info = clip_->getInfo();
-    
-    if (samples.empty()) return 0;
-    
-    size_t framesWritten = 0;
-    
-    for (size_t i = 0; i < frameCount; ++i) {
-        if (samplePosition_ >= samples.size()) {
-            if (config_.loop) {
-                samplePosition_ = 0;
-            } else {
-                playing_ = false;
-                break;
-            }
-        }
-        
-        float sample = 0.0f;
-        
-        if (info.channels == 1) {
-            sample = samples[samplePosition_];
-            samplePosition_++;
-        } else {
-            // Average stereo to mono for 3D spatialization
-            sample = (samples[samplePosition_] + samples[samplePosition_ + 1]) * 0.5f;
-            samplePosition_ += 2;
-        }
-        
-        // Apply volume
-        sample *= currentVolume_;
-        
-        // Apply pan for stereo output
-        float leftGain = (currentPan_ <= 0.0f) ? 1.0f : (1.0f - currentPan_);
-        float rightGain = (currentPan_ >= 0.0f) ? 1.0f : (1.0f + currentPan_);
-        
-        output[i * 2] += sample * leftGain;
-        output[i * 2 + 1] += sample * rightGain;
-        
-        framesWritten++;
-    }
-    
-    return framesWritten;
-}
-
 // ============================================================================
 // REVERB ZONE
 // ============================================================================
@@ -368,17 +473,204 @@ float ReverbZone::getBlendWeight(const glm::vec3& point) const {
     return 1.0f - (maxDist / blendDistance);
 }
 
+// ============================================================================
+// AUDIO STREAMER
+// ============================================================================
+
+namespace {
+
+// Streams are mixed as mono or stereo; wider files are rejected
+constexpr uint32_t MAX_STREAM_CHANNELS = 2;
+
+// Fills the stream's free chunks from its decode position. Returns
+// whether anything was decoded.
+bool decodeStream(AudioStream& stream) {
+    const size_t frameBytes = size_t(stream.channels) * (stream.bitsPerSample / 8);
+    bool worked = false;
+    
+    while (true) {
+        uint32_t generation = stream.requestedGeneration.load(std::memory_order_acquire);
+        if (generation != stream.decodeGeneration) {
+            stream.decodeGeneration = generation;
+            stream.decodeFrame = stream.seekFrame.load(std::memory_order_relaxed);
+            stream.file.clear();
+            stream.file.seekg(stream.dataOffset + std::streamoff(stream.decodeFrame * frameBytes));
+        }
+        
+        uint32_t index;
+        if (!stream.free.pop(index)) break;
+        
+        AudioStream::Chunk& chunk = stream.chunks[index];
+        const size_t frames = std::min<size_t>(stream.chunkFrames, stream.totalFrames - stream.decodeFrame);
+        const size_t bytes = frames * frameBytes;
+        
+        stream.file.read(reinterpret_cast<char*>(stream.raw.data()), bytes);
+        size_t got = stream.file ? bytes : size_t(std::max<std::streamsize>(0, stream.file.gcount()));
+        if (got < bytes) {
+            // Truncated file: pad with silence rather than stall the reader
+            memset(stream.raw.data() + got, 0, bytes - got);
+            stream.file.clear();
+        }
+        convertToFloat(stream.raw.data(), chunk.samples, frames * stream.channels,
+                       stream.bitsPerSample, stream.channels);
+        
+        chunk.generation = stream.decodeGeneration;
+        chunk.start = stream.decodeFrame;
+        chunk.frames = static_cast<uint32_t>(frames);
+        stream.ready.push(index);  // Sized for every chunk, never full
+        worked = true;
+        
+        // Readers loop or stop at the end, so decoding always wraps
+        stream.decodeFrame += frames;
+        if (stream.decodeFrame >= stream.totalFrames) {
+            stream.decodeFrame = 0;
+            stream.file.seekg(stream.dataOffset);
+        }
+    }
+    return worked;
+}
+
+} // namespace
+
+AudioStreamer::~AudioStreamer() {
+    stop();
+}
+
+void AudioStreamer::start() {
+    if (running_.exchange(true)) return;
+    thread_ = std::thread(&AudioStreamer::threadMain, this);
+}
+
+void AudioStreamer::stop() {
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void AudioStreamer::pump() {
+    serviceStreams();
+}
+
+std::shared_ptr<AudioClip> AudioStreamer::openClip(const std::string& path,
+                                                   uint32_t chunkFrames, uint32_t chunkCount) {
+    auto stream = std::make_shared<AudioStream>();
+    stream->file.open(path, std::ios::binary);
+    if (!stream->file.is_open()) {
+        std::cerr << "Failed to open audio file: " << path << std::endl;
+        return nullptr;
+    }
+    
+    auto clip = std::make_shared<AudioClip>();
+    uint32_t dataBytes = 0;
+    if (!readWavHeader(stream->file, path, clip->info_, dataBytes)) {
+        return nullptr;
+    }
+    const AudioClipInfo& info = clip->info_;
+    if (info.channels > MAX_STREAM_CHANNELS) {
+        std::cerr << "Streaming supports mono and stereo only: " << path << std::endl;
+        return nullptr;
+    }
+    
+    chunkFrames = std::max(chunkFrames, 256u);
+    chunkCount = std::max(chunkCount, 2u);
+    const size_t frameBytes = size_t(info.channels) * (info.bitsPerSample / 8);
+    const size_t memoryBytes = size_t(chunkFrames) * chunkCount * info.channels * sizeof(float) +
+                               size_t(chunkFrames) * frameBytes;
+    
+    // Reserve against the budget before allocating
+    size_t used = memoryUsed_.load(std::memory_order_relaxed);
+    do {
+        if (used + memoryBytes > budgetBytes_) {
+            std::cerr << "Streaming budget exhausted, can't stream: " << path << std::endl;
+            return nullptr;
+        }
+    } while (!memoryUsed_.compare_exchange_weak(used, used + memoryBytes, std::memory_order_relaxed));
+    
+    stream->path = path;
+    stream->dataOffset = stream->file.tellg();
+    stream->channels = info.channels;
+    stream->bitsPerSample = info.bitsPerSample;
+    stream->totalFrames = info.sampleCount / info.channels;
+    stream->chunkFrames = chunkFrames;
+    stream->memoryBytes = memoryBytes;
+    stream->storage.assign(size_t(chunkFrames) * chunkCount * info.channels, 0.0f);
+    stream->raw.assign(size_t(chunkFrames) * frameBytes, 0);
+    stream->chunks.resize(chunkCount);
+    stream->ready.reset(chunkCount);
+    stream->free.reset(chunkCount);
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        stream->chunks[i].samples = stream->storage.data() + size_t(i) * chunkFrames * info.channels;
+        stream->free.push(i);
+    }
+    
+    clip->filePath_ = path;
+    clip->info_.streaming = true;
+    clip->isStreaming_ = true;
+    clip->stream_ = stream;
+    clip->loaded_ = true;
+    
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    streams_.push_back(std::move(stream));
+    return clip;
+}
+
+uint32_t AudioStreamer::getUnderruns() const {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    uint32_t underruns = retiredUnderruns_;
+    for (const auto& stream : streams_) {
+        underruns += stream->underruns.load(std::memory_order_relaxed);
+    }
+    return underruns;
+}
+
+bool AudioStreamer::serviceStreams() {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    bool worked = false;
+    
+    for (size_t i = 0; i < streams_.size();) {
+        AudioStream& stream = *streams_[i];
+        if (stream.closed.load(std::memory_order_acquire)) {
+            memoryUsed_.fetch_sub(stream.memoryBytes, std::memory_order_relaxed);
+            retiredUnderruns_ += stream.underruns.load(std::memory_order_relaxed);
+            streams_[i] = std::move(streams_.back());
+            streams_.pop_back();
+            continue;
+        }
+        worked |= decodeStream(stream);
+        ++i;
+    }
+    return worked;
+}
+
+void AudioStreamer::threadMain() {
+    while (running_.load(std::memory_order_acquire)) {
+        if (!serviceStreams()) {
+            // Nothing consumed since the last pass. A chunk lasts tens of
+            // milliseconds, so a short nap keeps every stream well ahead.
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
+
 // ============================================================================
 // AUDIO SYSTEM
 // ============================================================================
 
+namespace {
+
+// Voices quieter than this are never mixed
+constexpr float AUDIBLE_THRESHOLD = 1e-4f;
+
+// Streamed voices read ahead at most this many clip frames per output frame
+constexpr double MAX_STREAM_STEP = 4.0;
+
+} // namespace
+
 AudioSystem::AudioSystem() {
-    mixBuffer_.resize(4096 * 2);  // 4096 stereo frames
-    reverbBuffer_.resize(4096 * 2);
-    
     // Initialize delay lines for reverb
     for (int i = 0; i < 8; ++i) {
-        delayLines_[i].resize(44100);  // 1 second max delay
+        delayLines_[i].resize(sampleRate_);  // 1 second max delay
     }
 }
 
@@ -386,65 +678,313 @@ AudioSystem::~AudioSystem() {
     shutdown();
 }
 
-bool AudioSystem::initialize() {
+bool AudioSystem::initialize(const AudioSystemConfig& config) {
     if (initialized_) return true;
     
-    // In a real implementation, this would initialize miniaudio
-    // ma_device_config config = ma_device_config_init(ma_device_type_playback);
-    // config.playback.format = ma_format_f32;
-    // config.playback.channels = 2;
-    // config.sampleRate = 44100;
-    // config.dataCallback = audioCallback;
-    // config.pUserData = this;
+    // No device backend is built in (miniaudio.h is not vendored), so a
+    // Realtime mixer would play to nothing. Null runs the same mixer thread
+    // paced at the output rate.
+    if (config.mode == AudioDeviceMode::Realtime) {
+        std::cerr << "Audio system: no output device backend is built in; "
+                  << "use AudioDeviceMode::Null or Offline" << std::endl;
+        return false;
+    }
+    
+    config_ = config;
+    config_.blockFrames = std::max(1u, config_.blockFrames);
+    config_.maxRealVoices = std::min(config_.maxRealVoices, config_.maxVoices);
+    sampleRate_ = config_.sampleRate;
+    
+    for (int i = 0; i < 8; ++i) {
+        delayLines_[i].assign(sampleRate_, 0.0f);
+        delayPositions_[i] = 0;
+    }
+    mixBuffer_.assign(config_.blockFrames * channels_, 0.0f);
+    
+    // Everything the mixer touches is sized up front. A voice fading out
+    // renders alongside the one replacing it, hence twice maxRealVoices.
+    const uint32_t renderSlots = config_.maxRealVoices * 2;
+    config_.parallelGrain = std::max(config_.parallelGrain, (renderSlots + 0xFFFE) / 0xFFFF);  // Ranges fit dspWork_
+    voices_.assign(config_.maxVoices, MixerVoice());
+    activeVoices_.clear();
+    activeVoices_.reserve(config_.maxVoices);
+    rankedVoices_.reserve(config_.maxVoices);
+    renderVoices_.reserve(renderSlots);
+    renderFadeOut_.reserve(renderSlots);
+    voiceBuffers_.assign(size_t(renderSlots) * getVoiceSlotSize(), 0.0f);
+    voicePositions_.reset(new std::atomic<double>[config_.maxVoices]);
+    for (uint32_t i = 0; i < config_.maxVoices; ++i) {
+        voicePositions_[i].store(0.0, std::memory_order_relaxed);
+    }
+    mixMasterVolume_ = masterVolume_;
+    mixReverb_ = ReverbSettings();
+    mixReverb_.wetMix = 0.0f;
+    
+    voiceSources_.assign(config_.maxVoices, nullptr);
+    freeVoices_.clear();
+    for (uint32_t i = config_.maxVoices; i-- > 0;) {
+        freeVoices_.push_back(i);
+    }
+    retiredVoices_.clear();
+    overflowCommands_.clear();
+    
+    // Every playing source sends an update per frame
+    commands_.reset(config_.maxVoices * 4 + 256);
+    events_.reset(config_.maxVoices * 2);
+    commandsIssued_ = 0;
+    commandsPublished_.store(0, std::memory_order_relaxed);
+    commandsProcessed_.store(0, std::memory_order_relaxed);
+    
+    streamer_.setBudget(config_.streamingBudgetBytes);
+    
+    dspGeneration_ = 0;
+    dspWork_.store(0, std::memory_order_relaxed);
+    dspRunning_.store(true, std::memory_order_release);
+    for (uint32_t i = 0; i < config_.dspThreads; ++i) {
+        dspWorkers_.emplace_back(&AudioSystem::dspWorkerMain, this);
+    }
     
-    std::cout << "Audio system initialized (stub)" << std::endl;
     initialized_ = true;
+    
+    if (config_.mode == AudioDeviceMode::Null) {
+        outputRing_.reset(size_t(config_.blockFrames) * channels_ * std::max(2u, config_.outputBlocks));
+        mixerRunning_.store(true, std::memory_order_release);
+        mixerThread_ = std::thread(&AudioSystem::mixerThreadMain, this);
+        streamer_.start();
+    }
+    
+    std::cout << "Audio system initialized (" 
+              << (config_.mode == AudioDeviceMode::Offline ? "offline" : "null device") << ")" << std::endl;
     return true;
 }
 
 void AudioSystem::shutdown() {
     if (!initialized_) return;
     
+    mixerRunning_.store(false, std::memory_order_release);
+    if (mixerThread_.joinable()) {
+        mixerThread_.join();
+    }
+    dspRunning_.store(false, std::memory_order_release);
+    dspWake_.notify_all();
+    for (auto& worker : dspWorkers_) {
+        worker.join();
+    }
+    dspWorkers_.clear();
+    streamer_.stop();
+    
     // Stop all sources
     for (auto& source : sources_) {
         source->stop();
+        source->voice_ = UINT32_MAX;
+        source->voiceClip_.reset();
+        source->voiceEffects_.reset();
     }
     sources_.clear();
+    oneShotSources_.clear();
+    retiredVoices_.clear();
+    voices_.clear();
+    activeVoices_.clear();
     
     // Unload all clips
     clipCache_.clear();
     
-    // Shutdown miniaudio
-    // ma_device_uninit(device_);
-    
     initialized_ = false;
 }
 
+void AudioSystem::renderOffline(float* output, size_t frameCount) {
+    if (!initialized_ || config_.mode != AudioDeviceMode::Offline) return;
+    
+    for (size_t offset = 0; offset < frameCount; offset += config_.blockFrames) {
+        size_t count = std::min<size_t>(config_.blockFrames, frameCount - offset);
+        processAudio(output + offset * channels_, count);
+    }
+}
+
 void AudioSystem::update(float deltaTime) {
     if (!initialized_) return;
     
     std::lock_guard<std::mutex> lock(sourcesMutex_);
     
-    // Update all sources
-    for (auto& source : sources_) {
+    readMixerFeedback();
+    
+    // Update all sources and send their changes to the mixer
+    for (auto& sourcePtr : sources_) {
+        AudioSource& source = *sourcePtr;
+        
         float occlusion = 0.0f;
-        if (occlusionEnabled_ && source->getPosition() != listener_.position) {
-            occlusion = calculateOcclusion(source->getPosition());
+        if (occlusionEnabled_ && source.getPosition() != listener_.position) {
+            occlusion = calculateOcclusion(source.getPosition());
         }
         
-        source->updateInternal(deltaTime, listener_.position, 
+        source.updateInternal(deltaTime, listener_.position, 
                               listener_.forward, occlusion);
+        
+        const uint32_t pending = source.pending_;
+        source.pending_ = 0;
+        
+        if ((pending & AudioSource::PendingStart) && source.voice_ == UINT32_MAX) {
+            if (freeVoices_.empty()) {
+                // Out of voices: the play request is dropped
+                source.playing_ = false;
+                continue;
+            }
+            source.voice_ = freeVoices_.back();
+            freeVoices_.pop_back();
+            voiceSources_[source.voice_] = &source;
+        }
+        if (source.voice_ == UINT32_MAX) continue;
+        
+        MixerCommand command;
+        command.voice = source.voice_;
+        const uint32_t channels = source.clip_ ? std::max(1u, source.clip_->getInfo().channels) : 1;
+        
+        if (pending & AudioSource::PendingStop) {
+            command.type = MixerCommand::Type::Stop;
+            sendCommand(command);
+        }
+        if (pending & AudioSource::PendingStart) {
+            if (source.voiceClip_ != source.clip_ || source.voiceEffects_ != source.effects_) {
+                retireVoice(source, false);
+            }
+            source.voiceClip_ = source.clip_;
+            source.voiceEffects_ = source.effects_;
+            
+            command.type = MixerCommand::Type::Start;
+            command.clip = source.clip_.get();
+            command.effects = source.effects_.get();
+            command.position = double(source.samplePosition_ / channels);
+            command.loop = source.config_.loop;
+            command.priority = source.config_.priority;
+            command.alwaysReal = source.config_.alwaysReal;
+            sendCommand(command);
+            source.syncCommand_ = commandsIssued_;
+        } else if (pending & AudioSource::PendingSeek) {
+            command.type = MixerCommand::Type::Seek;
+            command.position = double(source.samplePosition_ / channels);
+            sendCommand(command);
+            source.syncCommand_ = commandsIssued_;
+        }
+        if (pending & AudioSource::PendingPause) {
+            command.type = MixerCommand::Type::Pause;
+            sendCommand(command);
+        }
+        if (pending & AudioSource::PendingResume) {
+            command.type = MixerCommand::Type::Resume;
+            sendCommand(command);
+        }
+        
+        if (source.playing_) {
+            command.type = MixerCommand::Type::Update;
+            command.volume = source.currentVolume_;
+            command.pan = source.currentPan_;
+            command.pitch = source.currentPitch_;
+            sendCommand(command);
+        }
     }
     
     // Update one-shot sources
     for (auto it = oneShotSources_.begin(); it != oneShotSources_.end();) {
         it->lifetime -= deltaTime;
         if (it->lifetime <= 0 || !it->source->isPlaying()) {
+            auto source = std::find(sources_.begin(), sources_.end(), it->source);
+            if (source != sources_.end()) {
+                if ((*source)->voice_ != UINT32_MAX) {
+                    MixerCommand command;
+                    command.type = MixerCommand::Type::Release;
+                    command.voice = (*source)->voice_;
+                    sendCommand(command);
+                    retireVoice(**source, true);
+                }
+                sources_.erase(source);
+            }
             it = oneShotSources_.erase(it);
         } else {
             ++it;
         }
     }
+    
+    MixerCommand mix;
+    mix.type = MixerCommand::Type::SetMix;
+    mix.volume = masterVolume_ * listener_.masterVolume;
+    mix.reverb = blendReverbSettings();
+    sendCommand(mix);
+    
+    flushCommands();
+    
+    // The mixer takes each update's commands as a whole, so sources
+    // started together (e.g. music stems) start on the same sample
+    commandsPublished_.store(commandsIssued_ - overflowCommands_.size(), std::memory_order_release);
+}
+
+void AudioSystem::sendCommand(const MixerCommand& command) {
+    commandsIssued_++;
+    if (!overflowCommands_.empty() || !commands_.push(command)) {
+        overflowCommands_.push_back(command);
+    }
+}
+
+void AudioSystem::flushCommands() {
+    size_t sent = 0;
+    while (sent < overflowCommands_.size() && commands_.push(overflowCommands_[sent])) {
+        sent++;
+    }
+    overflowCommands_.erase(overflowCommands_.begin(), overflowCommands_.begin() + sent);
+}
+
+void AudioSystem::retireVoice(AudioSource& source, bool freeVoice) {
+    RetiredVoice retired;
+    retired.command = commandsIssued_;
+    retired.clip = std::move(source.voiceClip_);
+    retired.effects = std::move(source.voiceEffects_);
+    source.voiceClip_.reset();
+    source.voiceEffects_.reset();
+    
+    if (freeVoice) {
+        retired.freeVoice = source.voice_;
+        voiceSources_[source.voice_] = nullptr;
+        source.voice_ = UINT32_MAX;
+    }
+    retiredVoices_.push_back(std::move(retired));
+}
+
+void AudioSystem::readMixerFeedback() {
+    const uint64_t processed = commandsProcessed_.load(std::memory_order_acquire);
+    
+    // Voices that reached the end of their clip
+    MixerEvent event;
+    while (events_.pop(event)) {
+        AudioSource* source = voiceSources_[event.voice];
+        if (source && event.command >= source->syncCommand_ &&
+            !(source->pending_ & AudioSource::PendingStart)) {
+            source->playing_ = false;
+            source->paused_ = false;
+            source->samplePosition_ = 0;
+        }
+    }
+    
+    // Playback positions, unless a newer start or seek is still in flight
+    for (AudioSource* source : voiceSources_) {
+        if (!source || !source->playing_ || !source->clip_ || processed < source->syncCommand_ ||
+            (source->pending_ & (AudioSource::PendingStart | AudioSource::PendingSeek))) {
+            continue;
+        }
+        double frames = voicePositions_[source->voice_].load(std::memory_order_relaxed);
+        source->samplePosition_ = size_t(frames) * std::max(1u, source->clip_->getInfo().channels);
+    }
+    
+    // References and voice slots the mixer can no longer see
+    size_t kept = 0;
+    for (RetiredVoice& retired : retiredVoices_) {
+        if (retired.command <= processed) {
+            if (retired.freeVoice != UINT32_MAX) {
+                freeVoices_.push_back(retired.freeVoice);
+            }
+        } else {
+            retiredVoices_[kept++] = std::move(retired);
+        }
+    }
+    retiredVoices_.resize(kept);
 }
 
 void AudioSystem::setListener(const AudioListener& listener) {
@@ -468,6 +1008,10 @@ std::shared_ptr<AudioClip> AudioSystem::loadClip(const std::string& path) {
     return clip;
 }
 
+std::shared_ptr<AudioClip> AudioSystem::loadStreamingClip(const std::string& path) {
+    return streamer_.openClip(path, config_.streamChunkFrames, config_.streamChunkCount);
+}
+
 void AudioSystem::unloadClip(const std::string& path) {
     std::lock_guard<std::mutex> lock(clipsMutex_);
     clipCache_.erase(path);
@@ -487,6 +1031,13 @@ void AudioSystem::destroySource(std::shared_ptr<AudioSource> source) {
     
     auto it = std::find(sources_.begin(), sources_.end(), source);
     if (it != sources_.end()) {
+        if (source->voice_ != UINT32_MAX) {
+            MixerCommand command;
+            command.type = MixerCommand::Type::Release;
+            command.voice = source->voice_;
+            sendCommand(command);
+            retireVoice(*source, true);
+        }
         sources_.erase(it);
     }
 }
@@ -513,6 +1064,8 @@ void AudioSystem::playOneShot(std::shared_ptr<AudioClip> clip, const glm::vec3&
     OneShotSource oneShot;
     oneShot.source = source;
     oneShot.lifetime = clip->getInfo().duration + 0.5f;  // Extra buffer
+    
+    std::lock_guard<std::mutex> lock(sourcesMutex_);
     oneShotSources_.push_back(oneShot);
 }
 
@@ -555,7 +1108,7 @@ void AudioSystem::pauseAll() {
 void AudioSystem::resumeAll() {
     std::lock_guard<std::mutex> lock(sourcesMutex_);
     for (auto& source : sources_) {
-        if (source->isPlaying()) {
+        if (source->isPlaying() && source->isPaused()) {
             source->play();
         }
     }
@@ -569,15 +1122,15 @@ void AudioSystem::setSDFTexture(VkImageView sdfView, VkSampler sdfSampler) {
 AudioSystem::Stats AudioSystem::getStats() const {
     Stats stats = {};
     
-    stats.activeSources = 0;
-    stats.virtualSources = 0;
-    
-    for (const auto& source : sources_) {
-        if (source->isPlaying()) {
-            stats.activeSources++;
-        }
-    }
+    stats.activeSources = realVoiceCount_.load(std::memory_order_relaxed);
+    stats.virtualSources = virtualVoiceCount_.load(std::memory_order_relaxed);
+    stats.cpuUsagePercent = mixerLoad_.load(std::memory_order_relaxed);
+    stats.underruns = underruns_.load(std::memory_order_relaxed);
+    stats.streamingMemoryBytes = streamer_.getMemoryUsed();
+    stats.streamingBudgetBytes = streamer_.getBudget();
+    stats.streamUnderruns = streamer_.getUnderruns();
     
+    std::lock_guard<std::mutex> lock(clipsMutex_);
     stats.totalClipsLoaded = static_cast<uint32_t>(clipCache_.size());
     
     for (const auto& [path, clip] : clipCache_) {
@@ -589,30 +1142,139 @@ AudioSystem::Stats AudioSystem::getStats() const {
 
 void AudioSystem::audioCallback(void* userData, float* output, size_t frameCount) {
     AudioSystem* system = static_cast<AudioSystem*>(userData);
-    system->processAudio(output, frameCount);
+    
+    bool underrun = false;
+    for (size_t i = 0; i < frameCount * system->channels_; ++i) {
+        if (!system->outputRing_.pop(output[i])) {
+            output[i] = 0.0f;
+            underrun = true;
+        }
+    }
+    if (underrun) {
+        system->underruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AudioSystem::mixerThreadMain() {
+    const size_t blockSamples = size_t(config_.blockFrames) * channels_;
+    const auto blockDuration = std::chrono::duration<double>(double(config_.blockFrames) / sampleRate_);
+    const auto start = std::chrono::high_resolution_clock::now();
+    uint64_t consumedFrames = 0;
+    
+    while (mixerRunning_.load(std::memory_order_acquire)) {
+        // Keep the ring full for the device
+        while (outputRing_.capacity() - outputRing_.size() >= blockSamples) {
+            processAudio(mixBuffer_.data(), config_.blockFrames);
+            for (size_t i = 0; i < blockSamples; ++i) {
+                outputRing_.push(mixBuffer_[i]);
+            }
+        }
+        
+        if (!device_) {
+            // Null device: consume the mix at the output rate
+            std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+            uint64_t dueFrames = uint64_t(elapsed.count() * sampleRate_);
+            float discard;
+            while (consumedFrames < dueFrames && outputRing_.size() >= channels_) {
+                for (uint32_t c = 0; c < channels_; ++c) {
+                    outputRing_.pop(discard);
+                }
+                consumedFrames++;
+            }
+            if (consumedFrames < dueFrames) {
+                underruns_.fetch_add(1, std::memory_order_relaxed);
+                consumedFrames = dueFrames;
+            }
+        }
+        
+        std::this_thread::sleep_for(blockDuration / 2);
+    }
 }
 
 void AudioSystem::processAudio(float* output, size_t frameCount) {
-    // Clear output buffer
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    MixerCommand command;
+    uint64_t processed = commandsProcessed_.load(std::memory_order_relaxed);
+    const uint64_t published = commandsPublished_.load(std::memory_order_acquire);
+    while (processed < published && commands_.pop(command)) {
+        executeCommand(command);
+        processed++;
+    }
+    commandsProcessed_.store(processed, std::memory_order_release);
+    
+    if (config_.mode == AudioDeviceMode::Offline) {
+        // No I/O thread offline: decode in step with the mix, after any
+        // seeks, so renders are reproducible and streams never underrun
+        streamer_.pump();
+    }
+    
+    selectRealVoices();
+    
+    // Voice DSP fans out across the DSP workers in ranges of parallelGrain
+    // voices; each voice renders into its own slot. The mixer claims ranges
+    // too, so a block never waits on a worker that has yet to wake.
+    const size_t slotSize = getVoiceSlotSize();
+    const size_t grain = std::max(1u, config_.parallelGrain);
+    const uint32_t rangeCount = uint32_t((renderVoices_.size() + grain - 1) / grain);
+    if (dspWorkers_.empty() || rangeCount <= 1) {
+        for (size_t i = 0; i < renderVoices_.size(); ++i) {
+            renderVoice(renderVoices_[i], &voiceBuffers_[i * slotSize], frameCount, renderFadeOut_[i] != 0);
+        }
+    } else {
+        // Nothing from the previous block is still claimable, so these
+        // plain writes are ordered before any worker reads by dspWork_
+        dspFrameCount_ = frameCount;
+        dspRangesDone_.store(0, std::memory_order_relaxed);
+        dspGeneration_++;
+        dspWork_.store((uint64_t(dspGeneration_) << 32) | rangeCount, std::memory_order_release);
+        dspWake_.notify_all();
+        
+        renderDspRanges(dspGeneration_);
+        while (dspRangesDone_.load(std::memory_order_acquire) < rangeCount) {
+            std::this_thread::yield();
+        }
+    }
+    
+    // Sum in a fixed order so renders are reproducible
     memset(output, 0, frameCount * channels_ * sizeof(float));
+    for (size_t i = 0; i < renderVoices_.size(); ++i) {
+        const float* stereo = &voiceBuffers_[i * slotSize + config_.blockFrames];
+        for (size_t s = 0; s < frameCount * channels_; ++s) {
+            output[s] += stereo[s];
+        }
+    }
     
-    std::lock_guard<std::mutex> lock(sourcesMutex_);
+    // Virtual voices keep time without rendering
+    uint32_t virtualCount = 0;
+    for (uint32_t index : activeVoices_) {
+        MixerVoice& voice = voices_[index];
+        if (!voice.selected && !voice.real && !voice.paused) {
+            advanceVoice(voice, frameCount);
+            virtualCount++;
+        }
+    }
     
-    // Mix all sources
-    for (auto& source : sources_) {
-        if (source->isPlaying() && !source->isPaused()) {
-            source->mixSamples(output, frameCount, sampleRate_);
+    for (size_t i = activeVoices_.size(); i-- > 0;) {
+        uint32_t index = activeVoices_[i];
+        MixerVoice& voice = voices_[index];
+        voice.real = voice.selected;
+        voice.selected = false;
+        voicePositions_[index].store(voice.position, std::memory_order_relaxed);
+        
+        if (voice.finished && events_.push({ index, processed })) {
+            deactivateVoice(index);
         }
     }
+    realVoiceCount_.store(static_cast<uint32_t>(rankedVoices_.size()), std::memory_order_relaxed);
+    virtualVoiceCount_.store(virtualCount, std::memory_order_relaxed);
     
     // Apply reverb
-    if (!reverbZones_.empty()) {
-        applyReverb(output, frameCount);
-    }
+    applyReverb(output, frameCount, mixReverb_);
     
     // Apply master volume
     for (size_t i = 0; i < frameCount * channels_; ++i) {
-        output[i] *= masterVolume_;
+        output[i] *= mixMasterVolume_;
         
         // Soft clipping
         if (output[i] > 1.0f) {
@@ -621,6 +1283,325 @@ void AudioSystem::processAudio(float* output, size_t frameCount) {
             output[i] = -1.0f + std::exp(-(-output[i] - 1.0f));
         }
     }
+    
+    std::chrono::duration<float> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    mixerLoad_.store(elapsed.count() * sampleRate_ / frameCount * 100.0f, std::memory_order_relaxed);
+}
+
+void AudioSystem::executeCommand(const MixerCommand& command) {
+    if (command.type == MixerCommand::Type::SetMix) {
+        mixMasterVolume_ = command.volume;
+        mixReverb_ = command.reverb;
+        return;
+    }
+    
+    MixerVoice& voice = voices_[command.voice];
+    switch (command.type) {
+        case MixerCommand::Type::Start:
+            voice.clip = command.clip;
+            voice.effects = command.effects;
+            seekVoice(voice, command.position);
+            voice.loop = command.loop;
+            voice.priority = command.priority;
+            voice.alwaysReal = command.alwaysReal;
+            voice.paused = false;
+            voice.finished = false;
+            voice.real = false;
+            voice.gainL = voice.gainR = 0.0f;
+            activateVoice(command.voice);
+            break;
+        case MixerCommand::Type::Stop:
+            deactivateVoice(command.voice);
+            break;
+        case MixerCommand::Type::Pause:
+            voice.paused = true;
+            voice.real = false;
+            voice.gainL = voice.gainR = 0.0f;
+            break;
+        case MixerCommand::Type::Resume:
+            voice.paused = false;
+            break;
+        case MixerCommand::Type::Seek:
+            if (voice.clip) {
+                seekVoice(voice, command.position);
+            }
+            break;
+        case MixerCommand::Type::Update:
+            voice.volume = command.volume;
+            voice.pan = command.pan;
+            voice.pitch = command.pitch;
+            break;
+        case MixerCommand::Type::Release:
+            deactivateVoice(command.voice);
+            voice.clip = nullptr;
+            voice.effects = nullptr;
+            break;
+        default:
+            break;
+    }
+}
+
+void AudioSystem::seekVoice(MixerVoice& voice, double position) {
+    voice.position = position;
+    if (voice.clip->isStreaming()) {
+        double frame = std::floor(position);
+        voice.streamNext = static_cast<size_t>(frame);
+        voice.streamOffset = 2.0 + (position - frame);
+        voice.streamHistory[0] = voice.streamHistory[1] = 0.0f;
+        
+        // An empty read repositions the stream now, giving the decoder
+        // until this voice renders to catch up
+        voice.clip->streamSamples(nullptr, 0, voice.streamNext * voice.clip->getInfo().channels);
+    }
+}
+
+void AudioSystem::dspWorkerMain() {
+    uint32_t seenGeneration = 0;
+    while (dspRunning_.load(std::memory_order_acquire)) {
+        const uint32_t generation = uint32_t(dspWork_.load(std::memory_order_acquire) >> 32);
+        if (generation == seenGeneration) {
+            // The mixer notifies without the lock, so a wakeup can slip
+            // past; the timeout bounds that, and the mixer covers the block
+            std::unique_lock<std::mutex> lock(dspWakeMutex_);
+            dspWake_.wait_for(lock, std::chrono::milliseconds(2));
+            continue;
+        }
+        seenGeneration = generation;
+        renderDspRanges(generation);
+    }
+}
+
+void AudioSystem::renderDspRanges(uint32_t generation) {
+    const size_t slotSize = getVoiceSlotSize();
+    const size_t grain = std::max(1u, config_.parallelGrain);
+    uint64_t work = dspWork_.load(std::memory_order_acquire);
+    
+    for (;;) {
+        const uint32_t range = uint32_t(work >> 16) & 0xFFFF;
+        const uint32_t rangeCount = uint32_t(work) & 0xFFFF;
+        if (uint32_t(work >> 32) != generation || range >= rangeCount) {
+            return;
+        }
+        if (!dspWork_.compare_exchange_weak(work, work + (1u << 16),
+                                            std::memory_order_acq_rel, std::memory_order_acquire)) {
+            continue;
+        }
+        
+        const size_t end = std::min(renderVoices_.size(), (range + 1) * grain);
+        for (size_t i = range * grain; i < end; ++i) {
+            renderVoice(renderVoices_[i], &voiceBuffers_[i * slotSize], dspFrameCount_, renderFadeOut_[i] != 0);
+        }
+        dspRangesDone_.fetch_add(1, std::memory_order_release);
+        work = dspWork_.load(std::memory_order_acquire);
+    }
+}
+
+size_t AudioSystem::getVoiceSlotSize() const {
+    // Mono and panned output, then a window of streamed frames read
+    // ahead at up to MAX_STREAM_STEP (see readStream)
+    const size_t frames = config_.blockFrames;
+    return frames * (1 + channels_) +
+           (size_t(MAX_STREAM_STEP) * frames + 8) * MAX_STREAM_CHANNELS;
+}
+
+void AudioSystem::activateVoice(uint32_t index) {
+    MixerVoice& voice = voices_[index];
+    if (voice.activeIndex != UINT32_MAX) return;
+    voice.activeIndex = static_cast<uint32_t>(activeVoices_.size());
+    activeVoices_.push_back(index);
+}
+
+void AudioSystem::deactivateVoice(uint32_t index) {
+    MixerVoice& voice = voices_[index];
+    if (voice.activeIndex == UINT32_MAX) return;
+    
+    uint32_t last = activeVoices_.back();
+    activeVoices_[voice.activeIndex] = last;
+    voices_[last].activeIndex = voice.activeIndex;
+    activeVoices_.pop_back();
+    
+    voice.activeIndex = UINT32_MAX;
+    voice.real = false;
+    voice.gainL = voice.gainR = 0.0f;
+}
+
+void AudioSystem::selectRealVoices() {
+    rankedVoices_.clear();
+    for (uint32_t index : activeVoices_) {
+        MixerVoice& voice = voices_[index];
+        if (voice.paused || voice.finished) continue;
+        
+        // Priority 0 counts double, 255 barely at all
+        float weight = (256 - glm::clamp(voice.priority, 0, 255)) / 128.0f;
+        voice.audibility = voice.volume * weight;
+        if (voice.audibility > AUDIBLE_THRESHOLD) {
+            rankedVoices_.push_back(index);
+        }
+    }
+    
+    // alwaysReal voices rank above all others, so only more of them than
+    // maxRealVoices could push one out
+    if (rankedVoices_.size() > config_.maxRealVoices) {
+        std::nth_element(rankedVoices_.begin(), rankedVoices_.begin() + config_.maxRealVoices, rankedVoices_.end(),
+            [this](uint32_t a, uint32_t b) {
+                const MixerVoice& voiceA = voices_[a];
+                const MixerVoice& voiceB = voices_[b];
+                if (voiceA.alwaysReal != voiceB.alwaysReal) return voiceA.alwaysReal;
+                return voiceA.audibility > voiceB.audibility;
+            });
+        rankedVoices_.resize(config_.maxRealVoices);
+    }
+    
+    renderVoices_.clear();
+    renderFadeOut_.clear();
+    for (uint32_t index : rankedVoices_) {
+        voices_[index].selected = true;
+        renderVoices_.push_back(index);
+        renderFadeOut_.push_back(0);
+    }
+    
+    // Voices that just lost their place fade out over this block
+    for (uint32_t index : activeVoices_) {
+        const MixerVoice& voice = voices_[index];
+        if (voice.real && !voice.selected && !voice.finished) {
+            renderVoices_.push_back(index);
+            renderFadeOut_.push_back(1);
+        }
+    }
+}
+
+void AudioSystem::renderVoice(uint32_t voiceIndex, float* output, size_t frameCount, bool fadeOut) {
+    MixerVoice& voice = voices_[voiceIndex];
+    float* mono = output;
+    float* stereo = output + config_.blockFrames;
+    
+    const std::vector<float>& samples = voice.clip->getSamples();
+    const AudioClipInfo& info = voice.clip->getInfo();
+    const size_t channels = std::max(1u, info.channels);
+    const size_t clipFrames = voice.clip->getFrameCount();
+    double step = double(voice.pitch) * info.sampleRate / sampleRate_;
+    
+    // Streamed clips are read for the whole block up front, already mono
+    const float* window = nullptr;
+    double windowOffset = 0.0;
+    if (voice.clip->isStreaming() && clipFrames > 0) {
+        step = std::min(step, MAX_STREAM_STEP);
+        float* buffer = stereo + size_t(config_.blockFrames) * channels_;
+        windowOffset = readStream(voice, buffer, frameCount, step);
+        window = buffer;
+    }
+    
+    for (size_t i = 0; i < frameCount; ++i) {
+        if (voice.finished || clipFrames == 0) {
+            voice.finished = true;
+            mono[i] = 0.0f;
+            continue;
+        }
+        
+        if (window) {
+            size_t w = static_cast<size_t>(windowOffset);
+            float t = static_cast<float>(windowOffset - double(w));
+            mono[i] = window[w] + (window[w + 1] - window[w]) * t;
+            windowOffset += step;
+        } else {
+            size_t frame0 = static_cast<size_t>(voice.position);
+            size_t frame1 = frame0 + 1 < clipFrames ? frame0 + 1 : (voice.loop ? 0 : frame0);
+            float t = static_cast<float>(voice.position - double(frame0));
+            
+            // Average stereo to mono for 3D spatialization
+            float a = 0.0f, b = 0.0f;
+            for (size_t c = 0; c < channels; ++c) {
+                a += samples[frame0 * channels + c];
+                b += samples[frame1 * channels + c];
+            }
+            mono[i] = (a + (b - a) * t) / channels;
+        }
+        
+        voice.position += step;
+        if (voice.position >= clipFrames) {
+            if (voice.loop) {
+                voice.position = std::fmod(voice.position, double(clipFrames));
+            } else {
+                voice.finished = true;
+            }
+        }
+    }
+    
+    if (voice.effects) {
+        voice.effects->process(mono, frameCount, 1, sampleRate_);
+    }
+    
+    // Pan, ramping gains from the last block's to avoid zipper noise
+    float targetL = 0.0f, targetR = 0.0f;
+    if (!fadeOut) {
+        targetL = voice.volume * ((voice.pan <= 0.0f) ? 1.0f : (1.0f - voice.pan));
+        targetR = voice.volume * ((voice.pan >= 0.0f) ? 1.0f : (1.0f + voice.pan));
+    }
+    float stepL = (targetL - voice.gainL) / frameCount;
+    float stepR = (targetR - voice.gainR) / frameCount;
+    for (size_t i = 0; i < frameCount; ++i) {
+        stereo[i * 2] = mono[i] * (voice.gainL + stepL * (i + 1));
+        stereo[i * 2 + 1] = mono[i] * (voice.gainR + stepR * (i + 1));
+    }
+    voice.gainL = targetL;
+    voice.gainR = targetR;
+}
+
+void AudioSystem::advanceVoice(MixerVoice& voice, size_t frameCount) {
+    const AudioClipInfo& info = voice.clip->getInfo();
+    const size_t clipFrames = voice.clip->getFrameCount();
+    double step = double(voice.pitch) * info.sampleRate / sampleRate_;
+    
+    if (voice.clip->isStreaming() && clipFrames > 0) {
+        // Keep consuming, so the stream stays in step for when the voice
+        // becomes real again
+        step = std::min(step, MAX_STREAM_STEP);
+        readStream(voice, nullptr, frameCount, step);
+    }
+    
+    voice.position += step * frameCount;
+    if (voice.position >= clipFrames) {
+        if (voice.loop && clipFrames > 0) {
+            voice.position = std::fmod(voice.position, double(clipFrames));
+        } else {
+            voice.finished = true;
+        }
+    }
+}
+
+double AudioSystem::readStream(MixerVoice& voice, float* window, size_t frameCount, double step) {
+    // window[0..1] are the last two frames of the previous block; the
+    // frames read now follow from window[2]. Returns where in the window
+    // this block's first output frame falls.
+    AudioClip& clip = *voice.clip;
+    const size_t channels = std::max(1u, clip.getInfo().channels);
+    const double offset = voice.streamOffset;
+    const size_t pull = static_cast<size_t>(offset + step * double(frameCount - 1));
+    
+    clip.streamSamples(window ? window + 2 * channels : nullptr, pull, voice.streamNext * channels);
+    
+    if (window) {
+        // Downmix in place; frame w is read from w * channels >= w
+        if (channels > 1) {
+            for (size_t w = 2; w < pull + 2; ++w) {
+                float sum = 0.0f;
+                for (size_t c = 0; c < channels; ++c) {
+                    sum += window[w * channels + c];
+                }
+                window[w] = sum / channels;
+            }
+        }
+        window[0] = voice.streamHistory[0];
+        window[1] = voice.streamHistory[1];
+        voice.streamHistory[0] = window[pull];
+        voice.streamHistory[1] = window[pull + 1];
+    } else {
+        voice.streamHistory[0] = voice.streamHistory[1] = 0.0f;
+    }
+    
+    voice.streamNext = (voice.streamNext + pull) % clip.getFrameCount();
+    voice.streamOffset = offset + step * double(frameCount) - double(pull);
+    return offset;
 }
 
 float AudioSystem::calculateOcclusion(const glm::vec3& sourcePos) {
@@ -638,9 +1619,7 @@ float AudioSystem::calculateOcclusion(const glm::vec3& sourcePos) {
     return 0.0f;
 }
 
-void AudioSystem::applyReverb(float* buffer, size_t frameCount) {
-    ReverbSettings settings = blendReverbSettings();
-    
+void AudioSystem::applyReverb(float* buffer, size_t frameCount, const ReverbSettings& settings) {
     if (settings.wetMix < 0.001f) return;
     
     // Simple Schroeder reverb
@@ -7,11 +7,13 @@
  * - 3D positional audio with HRTF
  * - Ray traced occlusion using existing RT infrastructure
  * - Reverb zones based on room geometry
- * - Streaming audio for music
- * - Real-time audio mixing
+ * - Streaming audio for music: decoded on an I/O thread a few chunks ahead
+ * - Dedicated mixer thread fed by a lock-free command queue
+ * - Voice virtualization: only the most audible voices are mixed
+ * - Null and offline devices for benchmarks and regression renders
  * 
  * Integration:
- * - Uses miniaudio for cross-platform playback
+ * - Realtime output through miniaudio (not built in yet; Null mode stands in)
  * - Queries acceleration structure for occlusion
  * - Uses SDF for fast approximate occlusion
  */
@@ -26,6 +28,7 @@
 #include <memory>
 #include <queue>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
 #include <functional>
 #include <thread>
@@ -33,6 +36,9 @@
 namespace Sanic {
 
 class VulkanContext;
+class EffectsChain;
+class AudioStreamer;
+struct AudioStream;
 
 // ============================================================================
 // AUDIO CLIP
@@ -57,20 +63,32 @@ public:
     void unload();
     
     const AudioClipInfo& getInfo() const { return info_; }
-    const std::vector<float>& getSamples() const { return samples_; }
-    
-    // For streaming clips
+    const std::vector<float>& getSamples() const { return samples_; }  // Empty when streaming
+    size_t getFrameCount() const;
+    bool isStreaming() const { return isStreaming_; }
+    
+    /**
+     * Interleaved samples starting at `position` (in samples); output may
+     * be null to skip them.
+     *
+     * Streaming clips read sequentially from chunks decoded by an
+     * AudioStreamer, and seek when position jumps. Frames not decoded in
+     * time read as silence but still advance the stream, so it never
+     * drifts from its reader. Streaming clips have one reader, the mixer.
+     */
     size_t streamSamples(float* output, size_t frameCount, size_t position);
     
 private:
+    friend class AudioStreamer;
+    
     AudioClipInfo info_;
     std::vector<float> samples_;  // Interleaved samples, normalized to [-1, 1]
     std::string filePath_;
     bool loaded_ = false;
     bool isStreaming_ = false;
     
-    // Streaming state
-    void* streamHandle_ = nullptr;
+    // Streaming state, shared with the AudioStreamer's I/O thread
+    std::shared_ptr<AudioStream> stream_;
 };
 
 // ============================================================================
@@ -96,6 +114,10 @@ struct AudioSourceConfig {
     
     // Priority (lower = more important, won't be culled)
     int priority = 128;
+    
+    // Ranked ahead of every other voice for the maxRealVoices slots, so
+    // louder voices never virtualize it while audible (e.g. music stems)
+    bool alwaysReal = false;
 };
 
 class AudioSource {
@@ -104,8 +126,12 @@ public:
     ~AudioSource();
     
     void setClip(std::shared_ptr<AudioClip> clip);
+    const std::shared_ptr<AudioClip>& getClip() const { return clip_; }
     void setConfig(const AudioSourceConfig& config);
     
+    // Processed per voice before spatialization; one chain per source
+    void setEffectsChain(std::shared_ptr<EffectsChain> effects);
+    
     void play();
     void pause();
     void stop();
@@ -129,10 +155,21 @@ public:
     // Internal - called by AudioSystem
     void updateInternal(float deltaTime, const glm::vec3& listenerPos, 
                        const glm::vec3& listenerForward, float occlusion);
-    size_t mixSamples(float* output, size_t frameCount, uint32_t sampleRate);
     
 private:
+    friend class AudioSystem;
+    
+    // Changes not yet sent to the mixer, consumed by AudioSystem::update()
+    enum PendingFlags : uint32_t {
+        PendingStart = 1 << 0,
+        PendingStop = 1 << 1,
+        PendingPause = 1 << 2,
+        PendingResume = 1 << 3,
+        PendingSeek = 1 << 4
+    };
+    
     std::shared_ptr<AudioClip> clip_;
+    std::shared_ptr<EffectsChain> effects_;
     AudioSourceConfig config_;
     
     glm::vec3 position_ = glm::vec3(0.0f);
@@ -143,6 +180,7 @@ private:
     std::atomic<bool> paused_{false};
     size_t samplePosition_ = 0;
     
+    float userVolume_ = 1.0f;  // setVolume, on top of config_.volume
     float currentVolume_ = 1.0f;
     float currentPitch_ = 1.0f;
     float currentPan_ = 0.0f;  // -1 = left, 1 = right
@@ -151,6 +189,13 @@ private:
     // Interpolation for smooth parameter changes
     float targetVolume_ = 1.0f;
     float targetPan_ = 0.0f;
+    
+    // Mixer bookkeeping (game thread)
+    uint32_t pending_ = 0;
+    uint32_t voice_ = UINT32_MAX;       // Mixer voice slot, assigned on first play
+    uint64_t syncCommand_ = 0;          // Last Start/Seek; older mixer feedback is stale
+    std::shared_ptr<AudioClip> voiceClip_;          // What the mixer may still read
+    std::shared_ptr<EffectsChain> voiceEffects_;
 };
 
 // ============================================================================
@@ -195,18 +240,152 @@ public:
     float getBlendWeight(const glm::vec3& point) const;
 };
 
+// ============================================================================
+// MIXER
+// ============================================================================
+
+/**
+ * Bounded single-producer, single-consumer ring. push() and pop() are
+ * lock-free and never allocate; reset() is not thread-safe.
+ */
+template<typename T>
+class SPSCQueue {
+public:
+    explicit SPSCQueue(size_t capacity = 0) { reset(capacity); }
+    
+    // Capacity is rounded up to a power of two
+    void reset(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size *= 2;
+        items_.assign(size, T());
+        mask_ = size - 1;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+    
+    bool push(const T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) return false;
+        items_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    bool pop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        item = items_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return items_.size(); }
+    
+private:
+    std::vector<T> items_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_{0};   // Next to pop (consumer)
+    alignas(64) std::atomic<size_t> tail_{0};   // Next to push (producer)
+};
+
+enum class AudioDeviceMode {
+    Realtime,       // Mixer thread feeding the output device; fails without a backend
+    Null,           // Mixer thread paced at the output rate, mix discarded
+    Offline         // No thread or device; renderOffline() pulls the mix
+};
+
+struct AudioSystemConfig {
+    AudioDeviceMode mode = AudioDeviceMode::Realtime;
+    uint32_t sampleRate = 48000;
+    uint32_t blockFrames = 256;         // Mixer block; also the largest callback chunk
+    uint32_t outputBlocks = 4;          // Realtime/Null: blocks mixed ahead of the device
+    uint32_t maxVoices = 1024;          // Playing sources, audible or not
+    uint32_t maxRealVoices = 64;        // Mixed per block; the rest advance silently
+    uint32_t dspThreads = 2;            // Mixer-owned voice DSP workers (0 renders inline)
+    uint32_t parallelGrain = 4;         // Voices per range when fanning out voice DSP
+    
+    // Streaming clips: chunks decoded ahead of each reader, and their memory cap
+    uint32_t streamChunkFrames = 4096;
+    uint32_t streamChunkCount = 4;
+    size_t streamingBudgetBytes = 32 * 1024 * 1024;
+};
+
+// ============================================================================
+// AUDIO STREAMER
+// ============================================================================
+
+/**
+ * I/O thread that decodes streaming clips into fixed pools of chunks
+ * ahead of their read cursors. Chunks pass to and from the mixer through
+ * lock-free queues, so neither side waits on the other. Chunk memory is
+ * accounted against a budget; opening a stream that would exceed it fails.
+ */
+class AudioStreamer {
+public:
+    AudioStreamer() = default;
+    ~AudioStreamer();
+    
+    // Realtime/Null: decode on the I/O thread. Offline: call pump() instead.
+    void start();
+    void stop();
+    
+    // Decodes into every stream's free chunks on the calling thread
+    void pump();
+    
+    // Opens a WAV file as a streaming clip; nullptr if it can't be read
+    // or its chunks would exceed the budget
+    std::shared_ptr<AudioClip> openClip(const std::string& path, uint32_t chunkFrames, uint32_t chunkCount);
+    
+    void setBudget(size_t bytes) { budgetBytes_ = bytes; }
+    size_t getBudget() const { return budgetBytes_; }
+    size_t getMemoryUsed() const { return memoryUsed_.load(std::memory_order_relaxed); }
+    uint32_t getUnderruns() const;
+    
+private:
+    std::vector<std::shared_ptr<AudioStream>> streams_;
+    mutable std::mutex streamsMutex_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<size_t> memoryUsed_{0};
+    uint32_t retiredUnderruns_ = 0;     // From streams already closed
+    size_t budgetBytes_ = 32 * 1024 * 1024;
+    
+    void threadMain();
+    bool serviceStreams();
+};
+
 // ============================================================================
 // AUDIO SYSTEM
 // ============================================================================
 
+/**
+ * Game-thread front end of the mixer. AudioSource calls take effect at the
+ * next update(), which sends them with positions and gains as commands to
+ * the mixer. The mixer runs on its own thread (or inside renderOffline()),
+ * owns all voice state, and never locks or allocates. Voice DSP fans out
+ * to a few workers of its own that never run game jobs; the mixer renders
+ * any range they haven't claimed, so a late worker never stalls a block.
+ *
+ * Each block the mixer ranks playing voices by audibility (volume after
+ * attenuation, weighted by priority) and mixes the loudest maxRealVoices;
+ * the others keep their place without being rendered. Audible alwaysReal
+ * voices take those slots ahead of everything else. Voices fade in and
+ * out over one block as they cross that line.
+ */
 class AudioSystem {
 public:
     AudioSystem();
     ~AudioSystem();
     
-    bool initialize();
+    bool initialize(const AudioSystemConfig& config = AudioSystemConfig());
     void shutdown();
     
+    // Offline mode: mixes frameCount stereo frames into output
+    void renderOffline(float* output, size_t frameCount);
+    
     // Update (call every frame)
     void update(float deltaTime);
     
@@ -218,6 +397,9 @@ public:
     std::shared_ptr<AudioClip> loadClip(const std::string& path);
     void unloadClip(const std::string& path);
     
+    // Uncached: every streaming clip has its own decode cursor
+    std::shared_ptr<AudioClip> loadStreamingClip(const std::string& path);
+    
     // Audio sources
     std::shared_ptr<AudioSource> createSource();
     void destroySource(std::shared_ptr<AudioSource> source);
@@ -252,19 +434,102 @@ public:
         uint32_t totalClipsLoaded;
         size_t memoryUsedBytes;
         float cpuUsagePercent;
+        uint32_t underruns;       // Device callbacks that found the mix behind
+        size_t streamingMemoryBytes;
+        size_t streamingBudgetBytes;
+        uint32_t streamUnderruns; // Stream reads that found no decoded chunk
     };
     Stats getStats() const;
     
 private:
+    // Game thread -> mixer
+    struct MixerCommand {
+        enum class Type : uint8_t { Start, Stop, Pause, Resume, Seek, Update, Release, SetMix };
+        Type type = Type::Update;
+        uint32_t voice = 0;
+        AudioClip* clip = nullptr;      // Start
+        EffectsChain* effects = nullptr;
+        double position = 0.0;          // Start, Seek: in clip frames
+        float volume = 0.0f;            // Update; SetMix: master volume
+        float pan = 0.0f;
+        float pitch = 1.0f;
+        int priority = 128;
+        bool alwaysReal = false;
+        bool loop = false;
+        ReverbSettings reverb;          // SetMix
+    };
+    
+    // Mixer -> game thread
+    struct MixerEvent {
+        uint32_t voice = 0;
+        uint64_t command = 0;           // Commands processed when it ended
+    };
+    
+    // Owned by the mixer
+    struct MixerVoice {
+        AudioClip* clip = nullptr;
+        EffectsChain* effects = nullptr;
+        double position = 0.0;          // In clip frames
+        float volume = 0.0f;
+        float pan = 0.0f;
+        float pitch = 1.0f;
+        float gainL = 0.0f;             // Reached at the end of the last mixed block
+        float gainR = 0.0f;
+        float audibility = 0.0f;
+        int priority = 128;
+        bool alwaysReal = false;
+        uint32_t activeIndex = UINT32_MAX;  // In activeVoices_, if playing
+        
+        // Streaming clips are read ahead into a window starting two
+        // frames before the interpolation point
+        size_t streamNext = 0;          // Next clip frame to read
+        double streamOffset = 0.0;      // Position relative to streamHistory[0]
+        float streamHistory[2] = {};
+        bool paused = false;
+        bool loop = false;
+        bool real = false;              // Mixed in the last block
+        bool selected = false;          // Mixed in this block
+        bool finished = false;
+    };
+    
+    // Clip and effect references the mixer may use until it has
+    // processed command `command`; the voice slot is freed with them
+    struct RetiredVoice {
+        uint64_t command = 0;
+        std::shared_ptr<AudioClip> clip;
+        std::shared_ptr<EffectsChain> effects;
+        uint32_t freeVoice = UINT32_MAX;
+    };
+    
     // Audio thread callback
     static void audioCallback(void* userData, float* output, size_t frameCount);
     void processAudio(float* output, size_t frameCount);
     
+    // Game thread side
+    void sendCommand(const MixerCommand& command);
+    void flushCommands();
+    void readMixerFeedback();
+    void retireVoice(AudioSource& source, bool freeVoice);
+    
+    // Mixer side
+    void mixerThreadMain();
+    void executeCommand(const MixerCommand& command);
+    void activateVoice(uint32_t index);
+    void deactivateVoice(uint32_t index);
+    void selectRealVoices();
+    void renderVoice(uint32_t voiceIndex, float* output, size_t frameCount, bool fadeOut);
+    void advanceVoice(MixerVoice& voice, size_t frameCount);
+    double readStream(MixerVoice& voice, float* window, size_t frameCount, double step);
+    void seekVoice(MixerVoice& voice, double position);
+    size_t getVoiceSlotSize() const;
+    void dspWorkerMain();
+    void renderDspRanges(uint32_t generation);
+    
     // Occlusion calculation
     float calculateOcclusion(const glm::vec3& sourcePos);
     
     // Reverb processing
-    void applyReverb(float* buffer, size_t frameCount);
+    void applyReverb(float* buffer, size_t frameCount, const ReverbSettings& settings);
     ReverbSettings blendReverbSettings();
     
     AudioListener listener_;
@@ -274,7 +539,7 @@ private:
     std::unordered_map<std::string, std::shared_ptr<AudioClip>> clipCache_;
     
     std::mutex sourcesMutex_;
-    std::mutex clipsMutex_;
+    mutable std::mutex clipsMutex_;
     
     float masterVolume_ = 1.0f;
     float musicVolume_ = 1.0f;
@@ -282,15 +547,63 @@ private:
     
     bool initialized_ = false;
     bool occlusionEnabled_ = false;
+    AudioSystemConfig config_;
     
     // miniaudio device handle
     void* device_ = nullptr;
     
     // Mixing buffer
     std::vector<float> mixBuffer_;
-    uint32_t sampleRate_ = 44100;
+    uint32_t sampleRate_ = 48000;
     uint32_t channels_ = 2;
     
+    // Game thread side of the mixer
+    SPSCQueue<MixerCommand> commands_;
+    std::vector<MixerCommand> overflowCommands_;    // Waiting for queue space
+    uint64_t commandsIssued_ = 0;
+    std::vector<AudioSource*> voiceSources_;        // By voice slot
+    std::vector<uint32_t> freeVoices_;
+    std::vector<RetiredVoice> retiredVoices_;
+    
+    // Shared between the two sides
+    SPSCQueue<MixerEvent> events_;
+    std::unique_ptr<std::atomic<double>[]> voicePositions_;
+    std::atomic<uint64_t> commandsPublished_{0};   // Queued up to the end of an update()
+    std::atomic<uint64_t> commandsProcessed_{0};
+    std::atomic<uint32_t> realVoiceCount_{0};
+    std::atomic<uint32_t> virtualVoiceCount_{0};
+    std::atomic<uint32_t> underruns_{0};
+    std::atomic<float> mixerLoad_{0.0f};
+    
+    // Mixer side
+    std::vector<MixerVoice> voices_;
+    std::vector<uint32_t> activeVoices_;
+    std::vector<uint32_t> rankedVoices_;
+    std::vector<uint32_t> renderVoices_;            // Mixed this block
+    std::vector<uint8_t> renderFadeOut_;
+    std::vector<float> voiceBuffers_;               // Per render slot: mono, then stereo
+    uint32_t dspGeneration_ = 0;                    // Bumped per fanned-out block
+    size_t dspFrameCount_ = 0;                      // Published with dspWork_
+    float mixMasterVolume_ = 1.0f;
+    ReverbSettings mixReverb_;
+    
+    AudioStreamer streamer_;
+    
+    // Realtime and Null modes: mixer thread and its output ring
+    std::thread mixerThread_;
+    std::atomic<bool> mixerRunning_{false};
+    SPSCQueue<float> outputRing_;
+    
+    // Voice DSP workers. dspWork_ packs the generation (high 32 bits), the
+    // next unclaimed range and the range count (16 bits each), so a worker
+    // can only claim ranges of the block it was woken for.
+    std::vector<std::thread> dspWorkers_;
+    std::atomic<bool> dspRunning_{false};
+    std::atomic<uint64_t> dspWork_{0};
+    std::atomic<uint32_t> dspRangesDone_{0};
+    std::mutex dspWakeMutex_;
+    std::condition_variable dspWake_;
+    
     // Reverb state
     std::vector<float> reverbBuffer_;
     std::vector<float> delayLines_[8];  // For early reflections
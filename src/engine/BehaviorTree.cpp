@@ -385,6 +385,7 @@ void AIController::lookAt(const glm::vec3& target) {
     // Calculate rotation to face direction
     float yaw = atan2(direction.x, direction.z);
     transform->rotation = glm::quat(glm::vec3(0, yaw, 0));
+    TransformSystem::markDirty(*world_, entity_);
 }
 
 void AIController::lookAt(Entity target) {
@@ -0,0 +1,488 @@
+/**
+ * DataCompression.cpp
+ *
+ * LZ4 block codec, shuffle filter and section framing.
+ */
+
+#include "DataCompression.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Sanic {
+
+namespace {
+
+constexpr size_t LZ4_MIN_MATCH = 4;
+constexpr size_t LZ4_LAST_LITERALS = 5;     // Block must end with literals
+constexpr size_t LZ4_MF_LIMIT = 12;         // Last match starts this far from the end
+constexpr size_t LZ4_MAX_DISTANCE = 65535;
+constexpr uint32_t LZ4_FAST_HASH_LOG = 12;
+constexpr uint32_t LZ4_HC_HASH_LOG = 15;
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t read64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t hash4(uint32_t sequence, uint32_t hashLog) {
+    return (sequence * 2654435761u) >> (32 - hashLog);
+}
+
+// Bytes that match at a and b, stopping at limit
+inline size_t countMatch(const uint8_t* a, const uint8_t* b, const uint8_t* limit) {
+    const uint8_t* start = a;
+    while (a + 8 <= limit && read64(a) == read64(b)) {
+        a += 8;
+        b += 8;
+    }
+    while (a < limit && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return static_cast<size_t>(a - start);
+}
+
+inline uint8_t* writeLength(uint8_t* op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+size_t compressLZ4(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity, int level) {
+    const uint8_t* ip = src;
+    const uint8_t* anchor = src;
+    const uint8_t* const iend = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + dstCapacity;
+
+    // Appends one sequence; matchLength 0 writes the closing literals-only sequence
+    auto emitSequence = [&](size_t matchLength, size_t offset) -> bool {
+        size_t literalLength = static_cast<size_t>(ip - anchor);
+        size_t worstCase = 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1;
+        if (static_cast<size_t>(oend - op) < worstCase) {
+            return false;
+        }
+
+        uint8_t* token = op++;
+        if (literalLength >= 15) {
+            *token = 15 << 4;
+            op = writeLength(op, literalLength - 15);
+        } else {
+            *token = static_cast<uint8_t>(literalLength << 4);
+        }
+        if (literalLength > 0) {
+            std::memcpy(op, anchor, literalLength);
+            op += literalLength;
+        }
+
+        if (matchLength == 0) {
+            return true;
+        }
+
+        *op++ = static_cast<uint8_t>(offset & 0xFF);
+        *op++ = static_cast<uint8_t>(offset >> 8);
+        size_t extra = matchLength - LZ4_MIN_MATCH;
+        if (extra >= 15) {
+            *token |= 15;
+            op = writeLength(op, extra - 15);
+        } else {
+            *token |= static_cast<uint8_t>(extra);
+        }
+        return true;
+    };
+
+    if (srcSize > LZ4_MF_LIMIT) {
+        // Hash heads plus a 64K chain of distances to the previous position
+        // with the same hash; level sets how far down the chain we look
+        const uint32_t hashLog = level <= 1 ? LZ4_FAST_HASH_LOG : LZ4_HC_HASH_LOG;
+        const int maxAttempts = level <= 1 ? 1 : 1 << std::min(level - 1, 8);
+
+        thread_local std::vector<int32_t> head;
+        thread_local std::vector<uint16_t> chain;
+        head.assign(size_t(1) << hashLog, -1);
+        chain.resize(LZ4_MAX_DISTANCE + 1);
+
+        const uint8_t* const matchStartLimit = iend - LZ4_MF_LIMIT;
+        const uint8_t* const matchEndLimit = iend - LZ4_LAST_LITERALS;
+        size_t nextInsert = 0;
+
+        while (ip < matchStartLimit) {
+            size_t position = static_cast<size_t>(ip - src);
+            for (; nextInsert < position; ++nextInsert) {
+                uint32_t h = hash4(read32(src + nextInsert), hashLog);
+                int32_t previous = head[h];
+                size_t delta = previous < 0 ? 0 : nextInsert - static_cast<size_t>(previous);
+                chain[nextInsert & LZ4_MAX_DISTANCE] = static_cast<uint16_t>(delta > LZ4_MAX_DISTANCE ? 0 : delta);
+                head[h] = static_cast<int32_t>(nextInsert);
+            }
+
+            uint32_t sequence = read32(ip);
+            int32_t candidate = head[hash4(sequence, hashLog)];
+            size_t bestLength = 0;
+            size_t bestOffset = 0;
+
+            for (int attempt = 0; candidate >= 0 && attempt < maxAttempts; ++attempt) {
+                size_t distance = position - static_cast<size_t>(candidate);
+                if (distance > LZ4_MAX_DISTANCE) break;
+
+                const uint8_t* match = src + candidate;
+                if (read32(match) == sequence) {
+                    size_t length = LZ4_MIN_MATCH + countMatch(ip + LZ4_MIN_MATCH, match + LZ4_MIN_MATCH, matchEndLimit);
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestOffset = distance;
+                    }
+                }
+
+                uint16_t delta = chain[candidate & LZ4_MAX_DISTANCE];
+                if (delta == 0) break;
+                candidate -= delta;
+            }
+
+            if (bestLength < LZ4_MIN_MATCH) {
+                ++ip;
+                continue;
+            }
+
+            if (!emitSequence(bestLength, bestOffset)) {
+                return 0;
+            }
+            ip += bestLength;
+            anchor = ip;
+        }
+    }
+
+    ip = iend;
+    if (!emitSequence(0, 0)) {
+        return 0;
+    }
+    return static_cast<size_t>(op - dst);
+}
+
+bool decompressLZ4(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* ip = src;
+    const uint8_t* const iend = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + dstSize;
+
+    auto readLength = [&](size_t& length) -> bool {
+        uint8_t byte;
+        do {
+            if (ip >= iend) return false;
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    for (;;) {
+        if (ip >= iend) return false;
+        uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(literalLength)) return false;
+        if (literalLength > static_cast<size_t>(iend - ip) ||
+            literalLength > static_cast<size_t>(oend - op)) {
+            return false;
+        }
+        if (literalLength > 0) {
+            std::memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+        }
+
+        if (ip == iend) break;  // Closing literals-only sequence
+
+        if (iend - ip < 2) return false;
+        size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(matchLength)) return false;
+        matchLength += LZ4_MIN_MATCH;
+        if (matchLength > static_cast<size_t>(oend - op)) return false;
+
+        const uint8_t* match = op - offset;
+        if (offset >= matchLength) {
+            std::memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            // Overlapping copy repeats the last offset bytes
+            for (size_t i = 0; i < matchLength; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    return op == oend;
+}
+
+// Groups byte k of every 4-byte word together; float exponents and the
+// high bytes of small integers then form long runs
+void shuffle4(const uint8_t* src, size_t size, uint8_t* dst) {
+    size_t words = size / 4;
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t i = 0; i < words; ++i) {
+            dst[k * words + i] = src[i * 4 + k];
+        }
+    }
+    if (size % 4 != 0) {
+        std::memcpy(dst + words * 4, src + words * 4, size % 4);
+    }
+}
+
+void unshuffle4(const uint8_t* src, size_t size, uint8_t* dst) {
+    size_t words = size / 4;
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t i = 0; i < words; ++i) {
+            dst[i * 4 + k] = src[k * words + i];
+        }
+    }
+    if (size % 4 != 0) {
+        std::memcpy(dst + words * 4, src + words * 4, size % 4);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// BLOCK CODECS
+// ============================================================================
+
+size_t DataCompression::compress(CompressionCodec codec, const uint8_t* src, size_t srcSize,
+                                 uint8_t* dst, size_t dstCapacity, int level) {
+    switch (codec) {
+        case CompressionCodec::None:
+            if (dstCapacity < srcSize) return 0;
+            if (srcSize > 0) std::memcpy(dst, src, srcSize);
+            return srcSize;
+
+        case CompressionCodec::LZ4:
+            return compressLZ4(src, srcSize, dst, dstCapacity, level);
+
+        case CompressionCodec::LZ4Shuffle4: {
+            thread_local std::vector<uint8_t> shuffled;
+            shuffled.resize(srcSize);
+            shuffle4(src, srcSize, shuffled.data());
+            return compressLZ4(shuffled.data(), srcSize, dst, dstCapacity, level);
+        }
+    }
+    return 0;
+}
+
+bool DataCompression::decompress(CompressionCodec codec, const uint8_t* src, size_t srcSize,
+                                 uint8_t* dst, size_t dstSize) {
+    switch (codec) {
+        case CompressionCodec::None:
+            if (srcSize != dstSize) return false;
+            if (srcSize > 0) std::memcpy(dst, src, srcSize);
+            return true;
+
+        case CompressionCodec::LZ4:
+            return decompressLZ4(src, srcSize, dst, dstSize);
+
+        case CompressionCodec::LZ4Shuffle4: {
+            thread_local std::vector<uint8_t> shuffled;
+            shuffled.resize(dstSize);
+            if (!decompressLZ4(src, srcSize, shuffled.data(), dstSize)) return false;
+            unshuffle4(shuffled.data(), dstSize, dst);
+            return true;
+        }
+    }
+    return false;
+}
+
+CompressionCodec DataCompression::selectCodec(SectionType type) {
+    switch (type) {
+        case SectionType::Geometry:     // Float vertex attributes, 32-bit indices
+        case SectionType::Lumen:        // Float SDF volume
+            return CompressionCodec::LZ4Shuffle4;
+        case SectionType::Nanite:       // Mixed structs and 8-bit triangle lists
+        case SectionType::Physics:
+        case SectionType::Material:
+        default:
+            return CompressionCodec::LZ4;
+    }
+}
+
+// ============================================================================
+// SECTION FRAMING
+// ============================================================================
+
+std::vector<uint8_t> DataCompression::compressSection(SectionType type, std::vector<uint8_t>& data,
+                                                      CompressionCodec codec, int level,
+                                                      std::vector<uint32_t> splitPoints,
+                                                      uint32_t patchOffset,
+                                                      const SectionPatch& patch) {
+    SectionHeader header{};
+    header.type = type;
+    header.uncompressedSize = static_cast<uint32_t>(data.size());
+    header.flags = static_cast<uint32_t>(codec);
+
+    std::vector<uint8_t> out;
+
+    if (codec == CompressionCodec::None) {
+        if (patch) {
+            patch({}, data);
+        }
+        header.compressedSize = header.uncompressedSize;
+        out.resize(sizeof(SectionHeader) + data.size());
+        std::memcpy(out.data(), &header, sizeof(SectionHeader));
+        if (!data.empty()) {
+            std::memcpy(out.data() + sizeof(SectionHeader), data.data(), data.size());
+        }
+        return out;
+    }
+
+    // Plan blocks: cut at every split point, then at COMPRESSION_BLOCK_SIZE
+    uint32_t dataSize = header.uncompressedSize;
+    if (patch && patchOffset < dataSize) {
+        splitPoints.push_back(patchOffset);
+    }
+    splitPoints.push_back(0);
+    splitPoints.push_back(dataSize);
+    std::sort(splitPoints.begin(), splitPoints.end());
+    splitPoints.erase(std::unique(splitPoints.begin(), splitPoints.end()), splitPoints.end());
+
+    std::vector<CompressedBlockEntry> blocks;
+    for (size_t i = 0; i + 1 < splitPoints.size() && splitPoints[i + 1] <= dataSize; ++i) {
+        for (uint32_t offset = splitPoints[i]; offset < splitPoints[i + 1]; offset += COMPRESSION_BLOCK_SIZE) {
+            CompressedBlockEntry block{};
+            block.uncompressedOffset = offset;
+            block.uncompressedSize = std::min(COMPRESSION_BLOCK_SIZE, splitPoints[i + 1] - offset);
+            blocks.push_back(block);
+        }
+    }
+
+    uint32_t dataStart = static_cast<uint32_t>(sizeof(SectionHeader) + sizeof(CompressedSectionHeader) +
+                                               blocks.size() * sizeof(CompressedBlockEntry));
+    std::vector<std::vector<uint8_t>> packed(blocks.size());
+    size_t compressedCount = 0;
+
+    // Compresses blocks in order up to (not including) end; blocks that
+    // don't shrink are stored raw
+    auto compressBlocksUntil = [&](size_t end) {
+        for (; compressedCount < end; ++compressedCount) {
+            CompressedBlockEntry& block = blocks[compressedCount];
+            const uint8_t* src = data.data() + block.uncompressedOffset;
+            std::vector<uint8_t>& bytes = packed[compressedCount];
+
+            bytes.resize(compressBound(block.uncompressedSize));
+            size_t size = compress(codec, src, block.uncompressedSize, bytes.data(), bytes.size(), level);
+            if (size == 0 || size >= block.uncompressedSize) {
+                bytes.assign(src, src + block.uncompressedSize);
+            } else {
+                bytes.resize(size);
+            }
+
+            block.compressedSize = static_cast<uint32_t>(bytes.size());
+            block.dataOffset = compressedCount == 0 ? dataStart :
+                blocks[compressedCount - 1].dataOffset + blocks[compressedCount - 1].compressedSize;
+        }
+    };
+
+    if (patch) {
+        size_t beforePatch = 0;
+        while (beforePatch < blocks.size() &&
+               blocks[beforePatch].uncompressedOffset + blocks[beforePatch].uncompressedSize <= patchOffset) {
+            ++beforePatch;
+        }
+        compressBlocksUntil(beforePatch);
+        patch(blocks, data);
+    }
+    compressBlocksUntil(blocks.size());
+
+    uint32_t totalSize = blocks.empty() ? dataStart : blocks.back().dataOffset + blocks.back().compressedSize;
+    header.compressedSize = totalSize - static_cast<uint32_t>(sizeof(SectionHeader));
+
+    CompressedSectionHeader sectionHeader{};
+    sectionHeader.blockCount = static_cast<uint32_t>(blocks.size());
+
+    out.resize(totalSize);
+    uint8_t* cursor = out.data();
+    std::memcpy(cursor, &header, sizeof(SectionHeader));
+    cursor += sizeof(SectionHeader);
+    std::memcpy(cursor, &sectionHeader, sizeof(CompressedSectionHeader));
+    cursor += sizeof(CompressedSectionHeader);
+    if (!blocks.empty()) {
+        std::memcpy(cursor, blocks.data(), blocks.size() * sizeof(CompressedBlockEntry));
+    }
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        std::memcpy(out.data() + blocks[i].dataOffset, packed[i].data(), packed[i].size());
+    }
+
+    return out;
+}
+
+bool DataCompression::decompressSection(const uint8_t* section, size_t sectionSize,
+                                        SectionHeader& outHeader, std::vector<uint8_t>& outData) {
+    if (sectionSize < sizeof(SectionHeader)) {
+        return false;
+    }
+    std::memcpy(&outHeader, section, sizeof(SectionHeader));
+
+    size_t storedSize = sectionSize - sizeof(SectionHeader);
+    if (outHeader.compressedSize > storedSize) {
+        return false;
+    }
+
+    const uint8_t* stored = section + sizeof(SectionHeader);
+    outData.resize(outHeader.uncompressedSize);
+
+    CompressionCodec codec = static_cast<CompressionCodec>(outHeader.flags);
+    if (codec == CompressionCodec::None) {
+        if (outHeader.compressedSize != outHeader.uncompressedSize) return false;
+        if (!outData.empty()) {
+            std::memcpy(outData.data(), stored, outData.size());
+        }
+        return true;
+    }
+
+    if (outHeader.compressedSize < sizeof(CompressedSectionHeader)) {
+        return false;
+    }
+
+    CompressedSectionHeader sectionHeader;
+    std::memcpy(&sectionHeader, stored, sizeof(CompressedSectionHeader));
+
+    size_t tableEnd = sizeof(SectionHeader) + sizeof(CompressedSectionHeader) +
+                      static_cast<size_t>(sectionHeader.blockCount) * sizeof(CompressedBlockEntry);
+    size_t sectionEnd = sizeof(SectionHeader) + outHeader.compressedSize;
+    if (tableEnd > sectionEnd) {
+        return false;
+    }
+
+    const uint8_t* table = stored + sizeof(CompressedSectionHeader);
+    for (uint32_t i = 0; i < sectionHeader.blockCount; ++i) {
+        CompressedBlockEntry block;
+        std::memcpy(&block, table + i * sizeof(CompressedBlockEntry), sizeof(CompressedBlockEntry));
+
+        if (block.dataOffset < tableEnd ||
+            static_cast<size_t>(block.dataOffset) + block.compressedSize > sectionEnd ||
+            static_cast<size_t>(block.uncompressedOffset) + block.uncompressedSize > outData.size()) {
+            return false;
+        }
+
+        const uint8_t* src = section + block.dataOffset;
+        uint8_t* dst = outData.data() + block.uncompressedOffset;
+        bool raw = block.compressedSize == block.uncompressedSize;
+        if (!decompress(raw ? CompressionCodec::None : codec, src, block.compressedSize, dst, block.uncompressedSize)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace Sanic
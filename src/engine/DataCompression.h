@@ -0,0 +1,73 @@
+/**
+ * DataCompression.h
+ *
+ * Self-contained lossless compression for cooked assets and save data.
+ *
+ * Features:
+ * - LZ4 block format (compatible with liblz4's LZ4_decompress_safe)
+ * - Hash-chain match finder; level trades cook time for ratio
+ * - Bounds-checked decoder that writes straight into caller memory
+ * - 4-byte shuffle filter for float-heavy data (vertices, SDF volumes)
+ * - Blocked section framing (see SanicAssetFormat.h) for page streaming
+ *
+ * Usage:
+ *   std::vector<uint8_t> packed(DataCompression::compressBound(size));
+ *   packed.resize(DataCompression::compress(CompressionCodec::LZ4, src, size,
+ *                                           packed.data(), packed.size()));
+ *   DataCompression::decompress(CompressionCodec::LZ4, packed.data(), packed.size(), dst, size);
+ */
+
+#pragma once
+
+#include "SanicAssetFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Sanic {
+
+class DataCompression {
+public:
+    // Worst-case compressed size for srcSize input bytes
+    static size_t compressBound(size_t srcSize) { return srcSize + srcSize / 255 + 16; }
+
+    // Returns the compressed size, or 0 if it would not fit in dstCapacity.
+    // level 1 is fastest; up to 12 searches longer match chains.
+    static size_t compress(CompressionCodec codec, const uint8_t* src, size_t srcSize,
+                           uint8_t* dst, size_t dstCapacity, int level = 1);
+
+    // dstSize must be the exact decompressed size. Returns false on
+    // malformed input; never reads or writes out of bounds.
+    static bool decompress(CompressionCodec codec, const uint8_t* src, size_t srcSize,
+                           uint8_t* dst, size_t dstSize);
+
+    // Codec that suits a section's content
+    static CompressionCodec selectCodec(SectionType type);
+
+    /**
+     * Frames data as a section: SectionHeader, then either the raw bytes
+     * (codec None) or a block table and blocks of at most
+     * COMPRESSION_BLOCK_SIZE. Blocks also break at every offset in
+     * splitPoints, so callers can make e.g. each cluster page its own block.
+     * Blocks that don't shrink are stored raw.
+     *
+     * If patch is given, blocks that end at or before patchOffset are
+     * compressed first; patch may then rewrite data from patchOffset on
+     * (e.g. a page table recording those blocks) before the rest is
+     * compressed.
+     */
+    using SectionPatch = std::function<void(const std::vector<CompressedBlockEntry>& blocks,
+                                            std::vector<uint8_t>& data)>;
+    static std::vector<uint8_t> compressSection(SectionType type, std::vector<uint8_t>& data,
+                                                CompressionCodec codec, int level,
+                                                std::vector<uint32_t> splitPoints = {},
+                                                uint32_t patchOffset = UINT32_MAX,
+                                                const SectionPatch& patch = nullptr);
+
+    // Decodes a section written by compressSection (or an uncompressed one)
+    static bool decompressSection(const uint8_t* section, size_t sectionSize,
+                                  SectionHeader& outHeader, std::vector<uint8_t>& outData);
+};
+
+} // namespace Sanic
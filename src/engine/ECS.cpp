@@ -5,36 +5,376 @@
  */
 
 #include "ECS.h"
+#include "JobSystem.h"
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 
 namespace Sanic {
 
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// ============================================================================
+// ARCHETYPE IMPLEMENTATION
+// ============================================================================
+
+Archetype::Archetype(const ComponentSignature& signature) : signature_(signature) {
+    auto& registry = ComponentRegistry::getInstance();
+    
+    size_t rowBytes = sizeof(Entity);
+    size_t paddingBytes = 0;
+    for (ComponentTypeId id = 0; id < MAX_COMPONENTS; ++id) {
+        if (!signature.test(id)) continue;
+        
+        const ComponentTypeInfo& info = registry.getTypeInfo(id);
+        componentTypes_.push_back(id);
+        componentSizes_[id] = info.size;
+        rowBytes += info.size;
+        paddingBytes += info.alignment;
+        chunkAlignment_ = std::max(chunkAlignment_, info.alignment);
+    }
+    
+    size_t usable = ARCHETYPE_CHUNK_BYTES > paddingBytes ? ARCHETYPE_CHUNK_BYTES - paddingBytes : 0;
+    chunkCapacity_ = static_cast<uint32_t>(std::max<size_t>(1, usable / rowBytes));
+    
+    // Lay out columns: entity IDs first, then each component array
+    size_t offset = sizeof(Entity) * chunkCapacity_;
+    for (ComponentTypeId id : componentTypes_) {
+        offset = alignUp(offset, registry.getTypeInfo(id).alignment);
+        columnOffsets_[id] = offset;
+        offset += componentSizes_[id] * chunkCapacity_;
+    }
+    chunkBytes_ = std::max(ARCHETYPE_CHUNK_BYTES, offset);
+}
+
+Archetype::~Archetype() {
+    for (uint32_t row = 0; row < count_; ++row) {
+        destroyRow(row);
+    }
+    for (uint8_t* chunk : chunks_) {
+        ::operator delete(chunk, std::align_val_t(chunkAlignment_));
+    }
+}
+
+uint32_t Archetype::pushRow(Entity entity) {
+    uint32_t row = static_cast<uint32_t>(count_);
+    size_t chunk = row / chunkCapacity_;
+    if (chunk >= chunks_.size()) {
+        chunks_.push_back(static_cast<uint8_t*>(::operator new(chunkBytes_, std::align_val_t(chunkAlignment_))));
+    }
+    
+    getChunkEntities(chunk)[row % chunkCapacity_] = entity;
+    ++count_;
+    return row;
+}
+
+Entity Archetype::eraseRow(uint32_t row) {
+    uint32_t last = static_cast<uint32_t>(count_ - 1);
+    Entity moved = INVALID_ENTITY;
+    
+    if (row != last) {
+        auto& registry = ComponentRegistry::getInstance();
+        for (ComponentTypeId id : componentTypes_) {
+            registry.getTypeInfo(id).relocate(getComponent(row, id), getComponent(last, id));
+        }
+        moved = getEntity(last);
+        getChunkEntities(row / chunkCapacity_)[row % chunkCapacity_] = moved;
+    }
+    --count_;
+    
+    // Keep one spare chunk around so an entity bouncing across a chunk
+    // boundary doesn't allocate every time
+    while (chunks_.size() > getChunkCount() + 1) {
+        ::operator delete(chunks_.back(), std::align_val_t(chunkAlignment_));
+        chunks_.pop_back();
+    }
+    
+    return moved;
+}
+
+void Archetype::destroyRow(uint32_t row) {
+    auto& registry = ComponentRegistry::getInstance();
+    for (ComponentTypeId id : componentTypes_) {
+        registry.getTypeInfo(id).destroy(getComponent(row, id));
+    }
+}
+
+// ============================================================================
+// COMMAND BUFFER IMPLEMENTATION
+// ============================================================================
+
+static constexpr size_t COMMAND_BLOCK_BYTES = 4096;
+
+Entity CommandBuffer::createEntity() {
+    Entity placeholder = PENDING_ENTITY_BIT | pendingCount_++;
+    commands_.push_back({CommandType::CreateEntity, placeholder, 0, nullptr});
+    return placeholder;
+}
+
+void CommandBuffer::destroyEntity(Entity entity) {
+    commands_.push_back({CommandType::DestroyEntity, entity, 0, nullptr});
+}
+
+void* CommandBuffer::allocatePayload(size_t size, size_t alignment) {
+    while (currentBlock_ < blocks_.size()) {
+        Block& block = blocks_[currentBlock_];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        size_t offset = alignUp(base + block.used, alignment) - base;
+        if (offset + size <= block.size) {
+            block.used = offset + size;
+            return block.data.get() + offset;
+        }
+        ++currentBlock_;
+    }
+    
+    Block block;
+    block.size = std::max(COMMAND_BLOCK_BYTES, size + alignment);
+    block.data = std::make_unique<uint8_t[]>(block.size);
+    blocks_.push_back(std::move(block));
+    currentBlock_ = blocks_.size() - 1;
+    return allocatePayload(size, alignment);
+}
+
+Entity CommandBuffer::resolve(Entity entity) const {
+    if (entity == INVALID_ENTITY || !(entity & PENDING_ENTITY_BIT)) {
+        return entity;
+    }
+    return pendingEntities_[entity & ~PENDING_ENTITY_BIT];
+}
+
+void CommandBuffer::playback(World& world) {
+    pendingEntities_.assign(pendingCount_, INVALID_ENTITY);
+    
+    for (Command& command : commands_) {
+        Entity entity = resolve(command.entity);
+        
+        switch (command.type) {
+            case CommandType::CreateEntity:
+                pendingEntities_[command.entity & ~PENDING_ENTITY_BIT] = world.createEntity();
+                break;
+                
+            case CommandType::DestroyEntity:
+                world.destroyEntity(entity);
+                break;
+                
+            case CommandType::AddComponent:
+                // Entity may have been destroyed by an earlier command
+                if (world.isValid(entity)) {
+                    world.addComponentRaw(entity, command.typeId, command.payload);
+                    command.payload = nullptr;
+                }
+                break;
+                
+            case CommandType::RemoveComponent:
+                if (world.isValid(entity)) {
+                    world.removeComponentRaw(entity, command.typeId);
+                }
+                break;
+        }
+    }
+    
+    clear();
+}
+
+void CommandBuffer::clear() {
+    auto& registry = ComponentRegistry::getInstance();
+    for (Command& command : commands_) {
+        if (command.type == CommandType::AddComponent && command.payload) {
+            registry.getTypeInfo(command.typeId).destroy(command.payload);
+        }
+    }
+    commands_.clear();
+    
+    for (Block& block : blocks_) {
+        block.used = 0;
+    }
+    currentBlock_ = 0;
+    pendingEntities_.clear();
+    pendingCount_ = 0;
+}
+
+// ============================================================================
+// SYSTEM SCHEDULER IMPLEMENTATION
+// ============================================================================
+
+void SystemScheduler::rebuild(const std::vector<std::shared_ptr<System>>& systems) {
+    uint32_t count = static_cast<uint32_t>(systems.size());
+    nodes_.assign(count, Node{});
+    roots_.clear();
+    remaining_ = std::make_unique<std::atomic<uint32_t>[]>(count);
+    
+    // Depth of each node in the DAG, for the critical path statistic
+    std::vector<uint32_t> depth(count, 1);
+    criticalPathLength_ = 0;
+    
+    for (uint32_t i = 0; i < count; ++i) {
+        nodes_[i].system = systems[i].get();
+        
+        // Depend on every earlier (lower priority value) system we conflict with
+        for (uint32_t j = 0; j < i; ++j) {
+            if (systems[i]->conflictsWith(*systems[j])) {
+                nodes_[j].dependents.push_back(i);
+                nodes_[i].dependencyCount++;
+                depth[i] = std::max(depth[i], depth[j] + 1);
+            }
+        }
+        
+        if (nodes_[i].dependencyCount == 0) {
+            roots_.push_back(i);
+        }
+        criticalPathLength_ = std::max(criticalPathLength_, depth[i]);
+    }
+}
+
+void SystemScheduler::runSystem(System& system, World& world, SystemPhase phase, float deltaTime) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    switch (phase) {
+        case SystemPhase::Update:      system.update(world, deltaTime); break;
+        case SystemPhase::FixedUpdate: system.fixedUpdate(world, deltaTime); break;
+        case SystemPhase::LateUpdate:  system.lateUpdate(world, deltaTime); break;
+        default: break;
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    double timeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    
+    size_t phaseIndex = static_cast<size_t>(phase);
+    system.stats_.lastTimeMs[phaseIndex] = timeMs;
+    system.stats_.totalTimeMs[phaseIndex] += timeMs;
+    system.stats_.runCount[phaseIndex]++;
+}
+
+void SystemScheduler::run(World& world, SystemPhase phase, float deltaTime) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    JobSystem& jobs = jobSystem_ ? *jobSystem_ : JobSystem::getInstance();
+    
+    // Nothing to overlap: a pure chain runs serially either way
+    bool parallel = parallel_ && jobs.getWorkerCount() > 0 &&
+                    criticalPathLength_ < nodes_.size();
+    
+    if (!parallel) {
+        for (Node& node : nodes_) {
+            runSystem(*node.system, world, phase, deltaTime);
+        }
+    } else {
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            remaining_[i].store(nodes_[i].dependencyCount, std::memory_order_relaxed);
+        }
+        
+        JobCounter counter;
+        
+        // Each finished system releases its dependents. Dependents are
+        // submitted before the job completes, so the counter can't drain early.
+        std::function<void(uint32_t)> schedule = [&](uint32_t index) {
+            jobs.submit([&, index] {
+                runSystem(*nodes_[index].system, world, phase, deltaTime);
+                for (uint32_t dependent : nodes_[index].dependents) {
+                    if (remaining_[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        schedule(dependent);
+                    }
+                }
+            }, &counter);
+        };
+        
+        for (uint32_t root : roots_) {
+            schedule(root);
+        }
+        jobs.wait(counter);
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    lastPhaseTimeMs_[static_cast<size_t>(phase)] =
+        std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
 // ============================================================================
 // WORLD IMPLEMENTATION
 // ============================================================================
 
+World::World() {
+    emptyArchetype_ = getOrCreateArchetype(ComponentSignature{});
+}
+
 World::~World() {
     // Shutdown all systems
     for (auto& system : systems_) {
         system->shutdown(*this);
     }
     systems_.clear();
+    
+    for (auto& channel : eventChannels_) {
+        delete channel.load(std::memory_order_acquire);
+    }
 }
 
 Entity World::createEntity() {
+    Entity entity = allocateEntity();
+    
+    EntitySlot& slot = entitySlots_[entity];
+    slot.location.archetype = emptyArchetype_;
+    slot.location.row = emptyArchetype_->pushRow(entity);
+    ++livingCount_;
+    
+    return entity;
+}
+
+Archetype* World::createEntities(const ComponentSignature& signature, size_t count,
+                                 std::vector<Entity>& outEntities, uint32_t& outFirstRow) {
+    auto& registry = ComponentRegistry::getInstance();
+    Archetype* archetype = getOrCreateArchetype(signature);
+    for (ComponentTypeId id : archetype->getComponentTypes()) {
+        if (!registry.getTypeInfo(id).defaultConstruct) {
+            throw std::invalid_argument("World::createEntities: component is not default-constructible");
+        }
+    }
+    
+    outEntities.resize(count);
+    outFirstRow = static_cast<uint32_t>(archetype->size());
+    
+    for (size_t i = 0; i < count; ++i) {
+        Entity entity = allocateEntity();
+        uint32_t row = archetype->pushRow(entity);
+        
+        EntitySlot& slot = entitySlots_[entity];
+        slot.location.archetype = archetype;
+        slot.location.row = row;
+        outEntities[i] = entity;
+    }
+    livingCount_ += count;
+    if (archetype->hasComponent(ComponentRegistry::getInstance().getTypeId<Transform>())) {
+        ++transformStructureVersion_;
+    }
+    
+    // Construct column by column, each a contiguous run per chunk
+    for (ComponentTypeId id : archetype->getComponentTypes()) {
+        auto construct = registry.getTypeInfo(id).defaultConstruct;
+        for (size_t i = 0; i < count; ++i) {
+            construct(archetype->getComponent(outFirstRow + static_cast<uint32_t>(i), id));
+        }
+    }
+    
+    return archetype;
+}
+
+Entity World::allocateEntity() {
     Entity entity;
     
-    if (!availableEntities_.empty()) {
-        entity = availableEntities_.front();
-        availableEntities_.pop();
+    if (freeHead_ != INVALID_ENTITY) {
+        entity = freeHead_;
+        freeHead_ = entitySlots_[entity].nextFree;
+        if (freeHead_ == INVALID_ENTITY) {
+            freeTail_ = INVALID_ENTITY;
+        }
     } else {
-        entity = nextEntityId_++;
+        entity = static_cast<Entity>(entitySlots_.size());
+        entitySlots_.emplace_back();
     }
     
-    livingEntities_.insert(entity);
-    signatures_[entity] = ComponentSignature{};
-    
+    entitySlots_[entity].nextFree = INVALID_ENTITY;
     return entity;
 }
 
@@ -47,12 +387,13 @@ Entity World::createEntity(const std::string& name) {
 }
 
 void World::destroyEntity(Entity entity) {
-    if (livingEntities_.find(entity) == livingEntities_.end()) {
+    if (!isValid(entity)) {
         return;
     }
     
     // Remove from parent if has transform
     if (hasComponent<Transform>(entity)) {
+        ++transformStructureVersion_;
         Transform& transform = getComponent<Transform>(entity);
         if (transform.parent != INVALID_ENTITY && isValid(transform.parent)) {
             Transform& parentTransform = getComponent<Transform>(transform.parent);
@@ -60,34 +401,151 @@ void World::destroyEntity(Entity entity) {
             children.erase(std::remove(children.begin(), children.end(), entity), children.end());
         }
         
-        // Destroy children
-        for (Entity child : transform.children) {
+        // Destroy children. Take the list first: destroying a child compacts
+        // its archetype, which can relocate this entity's Transform.
+        std::vector<Entity> children = std::move(transform.children);
+        for (Entity child : children) {
             destroyEntity(child);
         }
     }
     
-    // Notify all component arrays
-    for (auto& [typeId, array] : componentArrays_) {
-        array->entityDestroyed(entity);
+    EntitySlot& slot = entitySlots_[entity];
+    slot.location.archetype->destroyRow(slot.location.row);
+    Entity moved = slot.location.archetype->eraseRow(slot.location.row);
+    if (moved != INVALID_ENTITY) {
+        entitySlots_[moved].location.row = slot.location.row;
     }
+    slot.location = EntityLocation{};
+    slot.generation++;
+    --livingCount_;
     
-    signatures_.erase(entity);
-    livingEntities_.erase(entity);
-    availableEntities_.push(entity);
+    // Append to the free list
+    slot.nextFree = INVALID_ENTITY;
+    if (freeTail_ != INVALID_ENTITY) {
+        entitySlots_[freeTail_].nextFree = entity;
+    } else {
+        freeHead_ = entity;
+    }
+    freeTail_ = entity;
 }
 
-bool World::isValid(Entity entity) const {
-    return livingEntities_.find(entity) != livingEntities_.end();
+Archetype* World::getOrCreateArchetype(const ComponentSignature& signature) {
+    auto it = archetypes_.find(signature);
+    if (it != archetypes_.end()) {
+        return it->second.get();
+    }
+    
+    auto archetype = std::make_unique<Archetype>(signature);
+    Archetype* result = archetype.get();
+    archetypes_.emplace(signature, std::move(archetype));
+    archetypeList_.push_back(result);
+    
+    // New archetypes are the only event that changes a query's match list
+    std::unique_lock<std::shared_mutex> lock(queryCacheMutex_);
+    for (auto& [querySignature, cache] : queryCaches_) {
+        if ((signature & querySignature) == querySignature) {
+            cache->archetypes.push_back(result);
+        }
+    }
+    
+    return result;
+}
+
+Archetype* World::getArchetypeWith(Archetype* source, ComponentTypeId typeId) {
+    Archetype* target = source->getAddEdge(typeId);
+    if (!target) {
+        ComponentSignature signature = source->getSignature();
+        signature.set(typeId);
+        target = getOrCreateArchetype(signature);
+        source->setAddEdge(typeId, target);
+        target->setRemoveEdge(typeId, source);
+    }
+    return target;
+}
+
+Archetype* World::getArchetypeWithout(Archetype* source, ComponentTypeId typeId) {
+    Archetype* target = source->getRemoveEdge(typeId);
+    if (!target) {
+        ComponentSignature signature = source->getSignature();
+        signature.reset(typeId);
+        target = getOrCreateArchetype(signature);
+        source->setRemoveEdge(typeId, target);
+        target->setAddEdge(typeId, source);
+    }
+    return target;
+}
+
+void World::addComponentRaw(Entity entity, ComponentTypeId typeId, void* source) {
+    const ComponentTypeInfo& info = ComponentRegistry::getInstance().getTypeInfo(typeId);
+    EntityLocation& location = entitySlots_[entity].location;
+    
+    if (location.archetype->hasComponent(typeId)) {
+        void* existing = location.archetype->getComponent(location.row, typeId);
+        info.destroy(existing);
+        info.relocate(existing, source);
+        return;
+    }
+    
+    moveToArchetype(entity, getArchetypeWith(location.archetype, typeId));
+    info.relocate(location.archetype->getComponent(location.row, typeId), source);
+}
+
+void World::removeComponentRaw(Entity entity, ComponentTypeId typeId) {
+    if (!isValid(entity)) return;
+    
+    EntityLocation& location = entitySlots_[entity].location;
+    if (!location.archetype->hasComponent(typeId)) return;
+    
+    moveToArchetype(entity, getArchetypeWithout(location.archetype, typeId));
+}
+
+void World::moveToArchetype(Entity entity, Archetype* target) {
+    EntityLocation& location = entitySlots_[entity].location;
+    Archetype* source = location.archetype;
+    if (source == target) return;
+    
+    uint32_t sourceRow = location.row;
+    uint32_t targetRow = target->pushRow(entity);
+    
+    auto& registry = ComponentRegistry::getInstance();
+    for (ComponentTypeId typeId : source->getComponentTypes()) {
+        const ComponentTypeInfo& info = registry.getTypeInfo(typeId);
+        void* src = source->getComponent(sourceRow, typeId);
+        if (target->hasComponent(typeId)) {
+            info.relocate(target->getComponent(targetRow, typeId), src);
+        } else {
+            info.destroy(src);
+        }
+    }
+    
+    Entity moved = source->eraseRow(sourceRow);
+    if (moved != INVALID_ENTITY) {
+        entitySlots_[moved].location.row = sourceRow;
+    }
+    
+    ComponentTypeId transformId = registry.getTypeId<Transform>();
+    if (source->hasComponent(transformId) != target->hasComponent(transformId)) {
+        ++transformStructureVersion_;
+    }
+    
+    location.archetype = target;
+    location.row = targetRow;
 }
 
 void World::update(float deltaTime) {
+    // Publish last frame's typed events
+    for (auto& slot : eventChannels_) {
+        IEventChannel* channel = slot.load(std::memory_order_acquire);
+        if (channel) {
+            channel->swap();
+        }
+    }
+    
     // Process events
     eventBus_.processEvents();
     
     // Update all systems
-    for (auto& system : systems_) {
-        system->update(*this, deltaTime);
-    }
+    scheduler_.run(*this, SystemPhase::Update, deltaTime);
     
     // Process pending destruction
     for (Entity entity : pendingDestruction_) {
@@ -97,42 +555,75 @@ void World::update(float deltaTime) {
 }
 
 void World::fixedUpdate(float fixedDeltaTime) {
-    for (auto& system : systems_) {
-        system->fixedUpdate(*this, fixedDeltaTime);
-    }
+    scheduler_.run(*this, SystemPhase::FixedUpdate, fixedDeltaTime);
 }
 
 void World::lateUpdate(float deltaTime) {
-    for (auto& system : systems_) {
-        system->lateUpdate(*this, deltaTime);
-    }
+    scheduler_.run(*this, SystemPhase::LateUpdate, deltaTime);
 }
 
 std::vector<Entity> World::getEntitiesWithSignature(ComponentSignature signature) const {
     std::vector<Entity> result;
     
-    for (Entity entity : livingEntities_) {
-        auto it = signatures_.find(entity);
-        if (it != signatures_.end()) {
-            // Check if entity has all required components
-            if ((it->second & signature) == signature) {
-                result.push_back(entity);
-            }
+    for (Archetype* archetype : getMatchingArchetypes(signature)) {
+        for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+            const Entity* entities = archetype->getChunkEntities(chunk);
+            result.insert(result.end(), entities, entities + archetype->getChunkSize(chunk));
+        }
+    }
+    
+    return result;
+}
+
+std::vector<Archetype*> World::getMatchingArchetypes(ComponentSignature signature) const {
+    std::vector<Archetype*> result;
+    
+    for (Archetype* archetype : archetypeList_) {
+        // Archetype must have all required components
+        if ((archetype->getSignature() & signature) == signature) {
+            result.push_back(archetype);
         }
     }
     
     return result;
 }
 
+const QueryCache& World::getQueryCache(const ComponentSignature& signature) {
+    {
+        std::shared_lock<std::shared_mutex> lock(queryCacheMutex_);
+        auto it = queryCaches_.find(signature);
+        if (it != queryCaches_.end()) {
+            return *it->second;
+        }
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(queryCacheMutex_);
+    auto it = queryCaches_.find(signature);
+    if (it != queryCaches_.end()) {
+        return *it->second;
+    }
+    
+    auto cache = std::make_unique<QueryCache>();
+    cache->signature = signature;
+    cache->archetypes = getMatchingArchetypes(signature);
+    
+    const QueryCache& result = *cache;
+    queryCaches_.emplace(signature, std::move(cache));
+    return result;
+}
+
 Entity World::findEntity(const std::string& name) const {
-    ComponentTypeId nameTypeId = ComponentRegistry::getInstance().getTypeId<Name>();
-    auto it = componentArrays_.find(nameTypeId);
-    if (it == componentArrays_.end()) return INVALID_ENTITY;
+    ComponentSignature nameSignature;
+    nameSignature.set(ComponentRegistry::getInstance().getTypeId<Name>());
     
-    auto* nameArray = static_cast<ComponentArray<Name>*>(it->second.get());
-    for (size_t i = 0; i < nameArray->size(); ++i) {
-        if ((*nameArray)[i].name == name) {
-            return nameArray->getEntity(i);
+    for (Archetype* archetype : getMatchingArchetypes(nameSignature)) {
+        for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+            const Name* names = archetype->getChunkColumn<Name>(chunk);
+            for (uint32_t i = 0; i < archetype->getChunkSize(chunk); ++i) {
+                if (names[i].name == name) {
+                    return archetype->getChunkEntities(chunk)[i];
+                }
+            }
         }
     }
     
@@ -142,14 +633,17 @@ Entity World::findEntity(const std::string& name) const {
 std::vector<Entity> World::findEntitiesWithTag(const std::string& tag) const {
     std::vector<Entity> result;
     
-    ComponentTypeId nameTypeId = ComponentRegistry::getInstance().getTypeId<Name>();
-    auto it = componentArrays_.find(nameTypeId);
-    if (it == componentArrays_.end()) return result;
+    ComponentSignature nameSignature;
+    nameSignature.set(ComponentRegistry::getInstance().getTypeId<Name>());
     
-    auto* nameArray = static_cast<ComponentArray<Name>*>(it->second.get());
-    for (size_t i = 0; i < nameArray->size(); ++i) {
-        if ((*nameArray)[i].tag == tag) {
-            result.push_back(nameArray->getEntity(i));
+    for (Archetype* archetype : getMatchingArchetypes(nameSignature)) {
+        for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+            const Name* names = archetype->getChunkColumn<Name>(chunk);
+            for (uint32_t i = 0; i < archetype->getChunkSize(chunk); ++i) {
+                if (names[i].tag == tag) {
+                    result.push_back(archetype->getChunkEntities(chunk)[i]);
+                }
+            }
         }
     }
     
@@ -161,15 +655,26 @@ Entity World::instantiate(Entity prefab) {
     
     Entity instance = createEntity();
     
-    // Copy all components from prefab
-    ComponentSignature prefabSig = getSignature(prefab);
-    for (auto& [typeId, array] : componentArrays_) {
-        if (prefabSig.test(typeId)) {
-            array->copyComponent(prefab, instance);
-            signatures_[instance].set(typeId);
+    // Non-copyable components are skipped
+    auto& registry = ComponentRegistry::getInstance();
+    Archetype* prefabArchetype = entitySlots_[prefab].location.archetype;
+    ComponentSignature signature;
+    for (ComponentTypeId typeId : prefabArchetype->getComponentTypes()) {
+        if (registry.getTypeInfo(typeId).copyConstruct) {
+            signature.set(typeId);
         }
     }
     
+    // Copy all components from prefab straight into the instance's row
+    moveToArchetype(instance, getOrCreateArchetype(signature));
+    const EntityLocation& source = entitySlots_[prefab].location;
+    const EntityLocation& target = entitySlots_[instance].location;
+    for (ComponentTypeId typeId : target.archetype->getComponentTypes()) {
+        registry.getTypeInfo(typeId).copyConstruct(
+            target.archetype->getComponent(target.row, typeId),
+            source.archetype->getComponent(source.row, typeId));
+    }
+    
     return instance;
 }
 
@@ -185,63 +690,281 @@ Entity World::instantiate(Entity prefab, const glm::vec3& position, const glm::q
 
 void World::clear() {
     // Destroy all entities
-    std::vector<Entity> toDestroy(livingEntities_.begin(), livingEntities_.end());
-    for (Entity entity : toDestroy) {
+    for (Entity entity = 0; entity < entitySlots_.size(); ++entity) {
         destroyEntity(entity);
     }
     
-    // Reset entity counter
-    while (!availableEntities_.empty()) {
-        availableEntities_.pop();
+    // Hand out indices from 0 again. Generations are kept, so handles taken
+    // before the clear stay invalid.
+    for (Entity entity = 0; entity < entitySlots_.size(); ++entity) {
+        entitySlots_[entity].nextFree = entity + 1 < entitySlots_.size() ? entity + 1 : INVALID_ENTITY;
     }
-    nextEntityId_ = 0;
+    freeHead_ = entitySlots_.empty() ? INVALID_ENTITY : 0;
+    freeTail_ = entitySlots_.empty() ? INVALID_ENTITY : static_cast<Entity>(entitySlots_.size() - 1);
 }
 
 // ============================================================================
 // TRANSFORM SYSTEM
 // ============================================================================
 
+// Target node count per parallel batch; batches always hold whole root subtrees
+static constexpr size_t TRANSFORM_BATCH_NODES = 512;
+
 void TransformSystem::update(World& world, float deltaTime) {
     updateWorldMatrices(world);
 }
 
 void TransformSystem::updateWorldMatrices(World& world) {
-    worldMatrices_.clear();
+    // Transforms gained or lost, or setParent, since the last rebuild
+    if (hierarchyDirty_ || world.getTransformStructureVersion() != structureVersion_) {
+        rebuildHierarchy(world);
+    }
+    
+    // Always drains the dirty set; under a full update its ranges go unused
+    if (!collectDirtyRanges(world)) {
+        rebuildHierarchy(world);
+    }
+    
+    JobSystem& jobs = world.getScheduler().getJobSystem();
+    
+    auto runRanges = [&]() {
+        for (const auto& [begin, end] : changedRanges_) {
+            std::fill(changed_.begin() + begin, changed_.begin() + end, 0);
+        }
+        changedRanges_.clear();
+        
+        std::atomic<bool> valid{true};
+        jobs.parallelFor(rangeBatchStarts_.size() - 1, 1, [&](size_t begin, size_t end) {
+            for (size_t batch = begin; batch < end; ++batch) {
+                for (size_t r = rangeBatchStarts_[batch]; r < rangeBatchStarts_[batch + 1]; ++r) {
+                    if (!valid.load(std::memory_order_relaxed)) return;
+                    if (!updateRange(world, updateRanges_[r].first, updateRanges_[r].second)) {
+                        valid = false;
+                    }
+                }
+            }
+        });
+        
+        changedRanges_ = updateRanges_;
+        lastChangedCount_ = 0;
+        for (const auto& [begin, end] : updateRanges_) {
+            lastChangedCount_ += end - begin;
+        }
+        return valid.load();
+    };
+    
+    // A full update reuses the root-subtree batches
+    auto selectAll = [&]() {
+        updateRanges_.clear();
+        rangeBatchStarts_.clear();
+        for (size_t batch = 0; batch + 1 < batchStarts_.size(); ++batch) {
+            rangeBatchStarts_.push_back(batch);
+            updateRanges_.push_back({static_cast<uint32_t>(batchStarts_[batch]),
+                                     static_cast<uint32_t>(batchStarts_[batch + 1])});
+        }
+        rangeBatchStarts_.push_back(updateRanges_.size());
+    };
+    
+    if (forceFullUpdate_) {
+        selectAll();
+    }
+    if (!runRanges()) {
+        rebuildHierarchy(world);
+        selectAll();
+        runRanges();
+    }
+    forceFullUpdate_ = false;
+}
+
+bool TransformSystem::collectDirtyRanges(World& world) {
+    size_t dirtyCount = dirtyCount_.exchange(0);
+    std::sort(dirtyNodes_.begin(), dirtyNodes_.begin() + dirtyCount);
     
-    // Get all entities with transforms
-    auto query = world.query<Transform>();
+    updateRanges_.clear();
+    bool valid = true;
+    for (size_t i = 0; i < dirtyCount; ++i) {
+        uint32_t node = dirtyNodes_[i];
+        dirty_[node].store(0, std::memory_order_relaxed);
+        if (!valid) continue;
+        
+        const Transform* transform = world.tryGetComponent<Transform>(entities_[node]);
+        if (!transform || transform->parent != parentEntities_[node]) {
+            valid = false;
+            continue;
+        }
+        
+        // Sorted preorder: a node inside the previous subtree is already covered
+        if (!updateRanges_.empty() && node < updateRanges_.back().second) continue;
+        updateRanges_.push_back({node, subtreeEnds_[node]});
+    }
     
-    // First pass: find root entities (no parent)
-    std::vector<Entity> roots;
-    for (auto [entity, transform] : query) {
-        if (transform.parent == INVALID_ENTITY) {
-            roots.push_back(entity);
+    // Ranges are disjoint subtrees, so jobs never read a matrix another writes
+    rangeBatchStarts_.assign(1, 0);
+    size_t batchNodes = 0;
+    for (size_t r = 0; r < updateRanges_.size(); ++r) {
+        batchNodes += updateRanges_[r].second - updateRanges_[r].first;
+        if (batchNodes >= TRANSFORM_BATCH_NODES) {
+            rangeBatchStarts_.push_back(r + 1);
+            batchNodes = 0;
         }
     }
+    if (rangeBatchStarts_.back() != updateRanges_.size()) {
+        rangeBatchStarts_.push_back(updateRanges_.size());
+    }
+    return valid;
+}
+
+void TransformSystem::markDirty(Entity entity) {
+    uint32_t node = entity < entityToNode_.size() ? entityToNode_[entity] : UINT32_MAX;
+    if (node == UINT32_MAX) {
+        // Not in the flat arrays yet; only a rebuild can place it
+        hierarchyDirty_ = true;
+        return;
+    }
+    if (dirty_[node].exchange(1, std::memory_order_relaxed) == 0) {
+        dirtyNodes_[dirtyCount_.fetch_add(1, std::memory_order_relaxed)] = node;
+    }
+}
+
+void TransformSystem::markDirty(World& world, Entity entity) {
+    if (TransformSystem* system = world.getSystem<TransformSystem>()) {
+        system->markDirty(entity);
+    }
+}
+
+void TransformSystem::rebuildHierarchy(World& world) {
+    std::vector<Entity> transformEntities = world.getEntitiesWithSignature(getSignature());
+    size_t count = transformEntities.size();
+    
+    // Dense entity -> input index lookup
+    Entity maxEntity = 0;
+    for (Entity entity : transformEntities) {
+        maxEntity = std::max(maxEntity, entity);
+    }
+    std::vector<uint32_t> lookup(count > 0 ? maxEntity + 1 : 0, UINT32_MAX);
+    for (uint32_t i = 0; i < count; ++i) {
+        lookup[transformEntities[i]] = i;
+    }
     
-    // Recursive update function
-    std::function<void(Entity, const glm::mat4&)> updateEntity = [&](Entity entity, const glm::mat4& parentMatrix) {
-        Transform& transform = world.getComponent<Transform>(entity);
-        glm::mat4 worldMatrix = parentMatrix * transform.getLocalMatrix();
-        worldMatrices_[entity] = worldMatrix;
+    // Child lists built from Transform::parent, which is authoritative
+    std::vector<uint32_t> parentOf(count, UINT32_MAX);
+    std::vector<uint32_t> childStart(count + 1, 0);
+    for (uint32_t i = 0; i < count; ++i) {
+        Entity parent = world.getComponent<Transform>(transformEntities[i]).parent;
+        if (parent < lookup.size() && lookup[parent] != UINT32_MAX && lookup[parent] != i) {
+            parentOf[i] = lookup[parent];
+            childStart[parentOf[i] + 1]++;
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        childStart[i + 1] += childStart[i];
+    }
+    std::vector<uint32_t> childList(childStart[count]);
+    std::vector<uint32_t> childFill(childStart.begin(), childStart.end() - 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (parentOf[i] != UINT32_MAX) {
+            childList[childFill[parentOf[i]]++] = i;
+        }
+    }
+    
+    entities_.clear();
+    parents_.clear();
+    parentEntities_.clear();
+    entities_.reserve(count);
+    parents_.reserve(count);
+    parentEntities_.reserve(count);
+    batchStarts_.assign(1, 0);
+    
+    std::vector<uint8_t> visited(count, 0);
+    std::vector<std::pair<uint32_t, int32_t>> stack;
+    
+    // Depth-first preorder keeps each root subtree contiguous
+    auto emitSubtree = [&](uint32_t root) {
+        if (entities_.size() - batchStarts_.back() >= TRANSFORM_BATCH_NODES) {
+            batchStarts_.push_back(entities_.size());
+        }
         
-        for (Entity child : transform.children) {
-            if (world.isValid(child)) {
-                updateEntity(child, worldMatrix);
+        stack.push_back({root, -1});
+        while (!stack.empty()) {
+            auto [node, parentIndex] = stack.back();
+            stack.pop_back();
+            if (visited[node]) continue;
+            visited[node] = 1;
+            
+            int32_t index = static_cast<int32_t>(entities_.size());
+            Entity entity = transformEntities[node];
+            entities_.push_back(entity);
+            parents_.push_back(parentIndex);
+            parentEntities_.push_back(world.getComponent<Transform>(entity).parent);
+            
+            for (uint32_t c = childStart[node]; c < childStart[node + 1]; ++c) {
+                stack.push_back({childList[c], index});
             }
         }
     };
     
-    // Update from roots
-    for (Entity root : roots) {
-        updateEntity(root, glm::mat4(1.0f));
+    for (uint32_t i = 0; i < count; ++i) {
+        if (parentOf[i] == UINT32_MAX) {
+            emitSubtree(i);
+        }
+    }
+    
+    // Anything left is part of a parent cycle; treat it as a root
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!visited[i]) {
+            emitSubtree(i);
+        }
+    }
+    batchStarts_.push_back(entities_.size());
+    
+    // Preorder puts children after parents, so a reverse pass sizes subtrees
+    std::vector<uint32_t> subtreeSizes(count, 1);
+    subtreeEnds_.resize(count);
+    for (size_t i = count; i-- > 0;) {
+        if (parents_[i] >= 0) {
+            subtreeSizes[parents_[i]] += subtreeSizes[i];
+        }
+        subtreeEnds_[i] = static_cast<uint32_t>(i + subtreeSizes[i]);
     }
+    
+    worldMatrices_.resize(count);
+    changed_.assign(count, 0);
+    changedRanges_.clear();
+    
+    // Node indices moved, so any pending marks are stale; the full update covers them
+    dirty_ = std::make_unique<std::atomic<uint8_t>[]>(count);
+    dirtyNodes_.resize(count);
+    dirtyCount_ = 0;
+    
+    entityToNode_.assign(lookup.size(), UINT32_MAX);
+    for (uint32_t i = 0; i < count; ++i) {
+        entityToNode_[entities_[i]] = i;
+    }
+    
+    hierarchyDirty_ = false;
+    forceFullUpdate_ = true;
+    structureVersion_ = world.getTransformStructureVersion();
+}
+
+bool TransformSystem::updateRange(World& world, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const Transform* transform = world.tryGetComponent<Transform>(entities_[i]);
+        if (!transform || transform->parent != parentEntities_[i]) {
+            return false;
+        }
+        
+        // Parents precede children, so the parent's matrix is already final
+        int32_t parent = parents_[i];
+        glm::mat4 local = transform->getLocalMatrix();
+        worldMatrices_[i] = parent >= 0 ? worldMatrices_[parent] * local : local;
+        changed_[i] = 1;
+    }
+    return true;
 }
 
 glm::mat4 TransformSystem::getWorldMatrix(World& world, Entity entity) {
-    auto it = worldMatrices_.find(entity);
-    if (it != worldMatrices_.end()) {
-        return it->second;
+    if (entity < entityToNode_.size() && entityToNode_[entity] != UINT32_MAX) {
+        return worldMatrices_[entityToNode_[entity]];
     }
     
     if (world.hasComponent<Transform>(entity)) {
@@ -255,9 +978,10 @@ void TransformSystem::setParent(World& world, Entity child, Entity parent) {
     if (!world.hasComponent<Transform>(child)) return;
     
     Transform& childTransform = world.getComponent<Transform>(child);
+    hierarchyDirty_ = true;
     
     // Remove from old parent
-    if (childTransform.parent != INVALID_ENTITY && world.isValid(childTransform.parent)) {
+    if (childTransform.parent != INVALID_ENTITY && world.hasComponent<Transform>(childTransform.parent)) {
         Transform& oldParent = world.getComponent<Transform>(childTransform.parent);
         auto& children = oldParent.children;
         children.erase(std::remove(children.begin(), children.end(), child), children.end());
@@ -281,7 +1005,12 @@ void TransformSystem::removeFromParent(World& world, Entity child) {
 // ============================================================================
 
 void MovementSystem::update(World& world, float deltaTime) {
-    for (auto [entity, transform, velocity] : world.query<Transform, Velocity>()) {
+    TransformSystem* transforms = world.getSystem<TransformSystem>();
+    
+    world.query<Transform, Velocity>().parallelForEach(
+        [deltaTime, transforms](Entity entity, Transform& transform, const Velocity& velocity, CommandBuffer&) {
+        bool moved = velocity.linear != glm::vec3(0.0f);
+        
         // Apply linear velocity
         transform.position += velocity.linear * deltaTime;
         
@@ -290,8 +1019,13 @@ void MovementSystem::update(World& world, float deltaTime) {
             glm::quat rotDelta = glm::quat(velocity.angular * deltaTime);
             transform.rotation = rotDelta * transform.rotation;
             transform.rotation = glm::normalize(transform.rotation);
+            moved = true;
         }
-    }
+        
+        if (moved && transforms) {
+            transforms->markDirty(entity);
+        }
+    }, 1024);
 }
 
 } // namespace Sanic
@@ -7,7 +7,7 @@
  * - Archetype-based storage for cache efficiency
  * - Type-safe component access
  * - System scheduling with dependencies
- * - Event/message passing
+ * - Event/message passing (typed per-frame channels plus a named-event bus)
  * - Prefab support for instantiation
  * 
  * Usage:
@@ -18,11 +18,17 @@
  *   
  *   world.registerSystem<MovementSystem>();
  *   world.update(deltaTime);
+ *
+ *   world.getEventChannel<DamageEvent>().emit(damage);          // any thread
+ *   world.getEventChannel<DamageEvent>().forEachBatch(           // next frame
+ *       [](const DamageEvent* events, size_t count) { ... });
  */
 
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -31,11 +37,19 @@
 #include <typeindex>
 #include <typeinfo>
 #include <bitset>
-#include <queue>
 #include <string>
 #include <any>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include "JobSystem.h"
 
 namespace Sanic {
 
@@ -47,14 +61,17 @@ namespace Sanic {
 using Entity = uint32_t;
 constexpr Entity INVALID_ENTITY = UINT32_MAX;
 
-// Generation counter to detect stale entity references
+// Generation counter to detect stale entity references. An Entity is a slot
+// index that gets recycled; hold an EntityHandle (World::getHandle) when a
+// reference may outlive the entity, and check it with World::isValid.
 struct EntityHandle {
-    uint32_t index;
-    uint32_t generation;
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
     
     bool operator==(const EntityHandle& other) const {
         return index == other.index && generation == other.generation;
     }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
     
     bool isValid() const { return index != UINT32_MAX; }
 };
@@ -66,6 +83,18 @@ struct EntityHandle {
 using ComponentTypeId = uint32_t;
 constexpr uint32_t MAX_COMPONENTS = 64;
 
+// Type-erased lifetime operations, used by archetype storage to move rows between chunks
+struct ComponentTypeInfo {
+    size_t size = 0;
+    size_t alignment = 1;
+    const std::type_info* type = nullptr;
+    bool triviallyCopyable = false;                           // Rows may be copied bytewise
+    void (*defaultConstruct)(void* dst) = nullptr;            // nullptr without a default constructor
+    void (*relocate)(void* dst, void* src) = nullptr;        // Move-construct dst from src, then destroy src
+    void (*copyConstruct)(void* dst, const void* src) = nullptr;  // nullptr for non-copyable components
+    void (*destroy)(void* ptr) = nullptr;
+};
+
 class ComponentRegistry {
 public:
     static ComponentRegistry& getInstance() {
@@ -75,27 +104,75 @@ public:
     
     template<typename T>
     ComponentTypeId getTypeId() {
+        // Resolved once per type, so hot paths don't pay for the type_index lookup
+        static const ComponentTypeId id = registerType<T>();
+        return id;
+    }
+    
+    size_t getComponentSize(ComponentTypeId id) const {
+        return id < MAX_COMPONENTS ? typeInfos_[id].size : 0;
+    }
+    
+    const ComponentTypeInfo& getTypeInfo(ComponentTypeId id) const {
+        return typeInfos_[id];
+    }
+    
+    // Id of a type already used as a component; false if it never was
+    bool findTypeId(std::type_index type, ComponentTypeId& outId) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = typeToId_.find(type);
+        if (it == typeToId_.end()) return false;
+        outId = it->second;
+        return true;
+    }
+    
+private:
+    ComponentRegistry() = default;
+    
+    template<typename T>
+    ComponentTypeId registerType() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
         std::type_index typeIdx(typeid(T));
         auto it = typeToId_.find(typeIdx);
         if (it != typeToId_.end()) {
             return it->second;
         }
         
+        if (nextId_ >= MAX_COMPONENTS) {
+            throw std::length_error("ComponentRegistry: MAX_COMPONENTS exceeded");
+        }
+        
         ComponentTypeId id = nextId_++;
         typeToId_[typeIdx] = id;
-        idToSize_[id] = sizeof(T);
+        
+        ComponentTypeInfo& info = typeInfos_[id];
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        info.type = &typeid(T);
+        info.triviallyCopyable = std::is_trivially_copyable_v<T>;
+        if constexpr (std::is_default_constructible_v<T>) {
+            info.defaultConstruct = [](void* dst) { new (dst) T(); };
+        }
+        info.relocate = [](void* dst, void* src) {
+            T* source = static_cast<T*>(src);
+            new (dst) T(std::move(*source));
+            source->~T();
+        };
+        if constexpr (std::is_copy_constructible_v<T>) {
+            info.copyConstruct = [](void* dst, const void* src) {
+                new (dst) T(*static_cast<const T*>(src));
+            };
+        }
+        info.destroy = [](void* ptr) {
+            static_cast<T*>(ptr)->~T();
+        };
         return id;
     }
     
-    size_t getComponentSize(ComponentTypeId id) const {
-        auto it = idToSize_.find(id);
-        return it != idToSize_.end() ? it->second : 0;
-    }
-    
-private:
-    ComponentRegistry() = default;
+    mutable std::mutex mutex_;
     std::unordered_map<std::type_index, ComponentTypeId> typeToId_;
-    std::unordered_map<ComponentTypeId, size_t> idToSize_;
+    std::array<ComponentTypeInfo, MAX_COMPONENTS> typeInfos_{};
     ComponentTypeId nextId_ = 0;
 };
 
@@ -103,95 +180,120 @@ private:
 using ComponentSignature = std::bitset<MAX_COMPONENTS>;
 
 // ============================================================================
-// COMPONENT STORAGE
+// ARCHETYPE STORAGE
 // ============================================================================
 
-// Base class for type-erased component arrays
-class IComponentArray {
-public:
-    virtual ~IComponentArray() = default;
-    virtual void entityDestroyed(Entity entity) = 0;
-    virtual void* getDataPtr(Entity entity) = 0;
-    virtual void copyComponent(Entity src, Entity dst) = 0;
-};
+// Target size of one archetype chunk. Archetypes with very large rows get
+// bigger chunks so that at least one row always fits.
+constexpr size_t ARCHETYPE_CHUNK_BYTES = 16 * 1024;
 
-// Typed component storage
-template<typename T>
-class ComponentArray : public IComponentArray {
+/**
+ * All entities sharing one ComponentSignature, stored in fixed-size SoA chunks.
+ * Each chunk holds an Entity column followed by one tightly packed column per
+ * component type. Rows are kept dense: removing a row moves the archetype's
+ * last row into the hole, so every chunk except the last is full.
+ *
+ * Rows are addressed archetype-wide (row = chunk * capacity + index). Pointers
+ * into a chunk stay valid until a structural change touches that row.
+ */
+class Archetype {
 public:
-    void insertData(Entity entity, T component) {
-        size_t newIndex = size_;
-        entityToIndex_[entity] = newIndex;
-        indexToEntity_[newIndex] = entity;
-        
-        if (newIndex >= components_.size()) {
-            components_.resize(newIndex + 1);
-        }
-        components_[newIndex] = component;
-        ++size_;
-    }
+    explicit Archetype(const ComponentSignature& signature);
+    ~Archetype();
     
-    void removeData(Entity entity) {
-        auto it = entityToIndex_.find(entity);
-        if (it == entityToIndex_.end()) return;
-        
-        size_t indexOfRemoved = it->second;
-        size_t indexOfLast = size_ - 1;
-        
-        // Move last element to removed position
-        components_[indexOfRemoved] = components_[indexOfLast];
-        
-        Entity lastEntity = indexToEntity_[indexOfLast];
-        entityToIndex_[lastEntity] = indexOfRemoved;
-        indexToEntity_[indexOfRemoved] = lastEntity;
-        
-        entityToIndex_.erase(entity);
-        indexToEntity_.erase(indexOfLast);
-        --size_;
-    }
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+    
+    const ComponentSignature& getSignature() const { return signature_; }
+    const std::vector<ComponentTypeId>& getComponentTypes() const { return componentTypes_; }
+    bool hasComponent(ComponentTypeId typeId) const { return signature_.test(typeId); }
     
-    T& getData(Entity entity) {
-        return components_[entityToIndex_.at(entity)];
+    size_t size() const { return count_; }
+    uint32_t getChunkCapacity() const { return chunkCapacity_; }
+    
+    // Chunks that currently hold at least one row
+    size_t getChunkCount() const { return (count_ + chunkCapacity_ - 1) / chunkCapacity_; }
+    uint32_t getChunkSize(size_t chunk) const {
+        size_t first = chunk * chunkCapacity_;
+        return static_cast<uint32_t>(std::min<size_t>(chunkCapacity_, count_ - first));
     }
     
-    T* tryGetData(Entity entity) {
-        auto it = entityToIndex_.find(entity);
-        if (it == entityToIndex_.end()) return nullptr;
-        return &components_[it->second];
+    Entity* getChunkEntities(size_t chunk) const {
+        return reinterpret_cast<Entity*>(chunks_[chunk]);
     }
     
-    bool hasData(Entity entity) const {
-        return entityToIndex_.find(entity) != entityToIndex_.end();
+    void* getChunkColumn(size_t chunk, ComponentTypeId typeId) const {
+        return chunks_[chunk] + columnOffsets_[typeId];
     }
     
-    void entityDestroyed(Entity entity) override {
-        if (entityToIndex_.find(entity) != entityToIndex_.end()) {
-            removeData(entity);
-        }
+    template<typename T>
+    T* getChunkColumn(size_t chunk) const {
+        ComponentTypeId typeId = ComponentRegistry::getInstance().getTypeId<T>();
+        return static_cast<T*>(getChunkColumn(chunk, typeId));
     }
     
-    void* getDataPtr(Entity entity) override {
-        auto it = entityToIndex_.find(entity);
-        if (it == entityToIndex_.end()) return nullptr;
-        return &components_[it->second];
+    Entity getEntity(uint32_t row) const {
+        return getChunkEntities(row / chunkCapacity_)[row % chunkCapacity_];
     }
     
-    void copyComponent(Entity src, Entity dst) override {
-        if (hasData(src)) {
-            insertData(dst, getData(src));
-        }
+    void* getComponent(uint32_t row, ComponentTypeId typeId) const {
+        return static_cast<uint8_t*>(getChunkColumn(row / chunkCapacity_, typeId)) +
+               static_cast<size_t>(row % chunkCapacity_) * componentSizes_[typeId];
     }
     
-    // Iteration support
-    size_t size() const { return size_; }
-    T& operator[](size_t index) { return components_[index]; }
-    Entity getEntity(size_t index) const { return indexToEntity_.at(index); }
+    // Appends a row for entity. The new row's component storage is
+    // uninitialized and must be constructed by the caller.
+    uint32_t pushRow(Entity entity);
+    
+    // Moves the last row into `row` and shrinks by one. Components at `row`
+    // must already be destroyed or relocated. Returns the entity that now
+    // occupies `row`, or INVALID_ENTITY if `row` was the last row.
+    Entity eraseRow(uint32_t row);
+    
+    // Runs destructors for every component in a row
+    void destroyRow(uint32_t row);
+    
+    // Cached transitions in the archetype graph
+    Archetype* getAddEdge(ComponentTypeId typeId) const { return addEdges_[typeId]; }
+    Archetype* getRemoveEdge(ComponentTypeId typeId) const { return removeEdges_[typeId]; }
+    void setAddEdge(ComponentTypeId typeId, Archetype* target) { addEdges_[typeId] = target; }
+    void setRemoveEdge(ComponentTypeId typeId, Archetype* target) { removeEdges_[typeId] = target; }
     
 private:
-    std::vector<T> components_;
-    std::unordered_map<Entity, size_t> entityToIndex_;
-    std::unordered_map<size_t, Entity> indexToEntity_;
-    size_t size_ = 0;
+    ComponentSignature signature_;
+    std::vector<ComponentTypeId> componentTypes_;
+    std::array<size_t, MAX_COMPONENTS> columnOffsets_{};
+    std::array<size_t, MAX_COMPONENTS> componentSizes_{};
+    
+    uint32_t chunkCapacity_ = 0;
+    size_t chunkBytes_ = 0;
+    size_t chunkAlignment_ = 64;
+    std::vector<uint8_t*> chunks_;
+    size_t count_ = 0;
+    
+    std::array<Archetype*, MAX_COMPONENTS> addEdges_{};
+    std::array<Archetype*, MAX_COMPONENTS> removeEdges_{};
+};
+
+// Where an entity's row lives
+struct EntityLocation {
+    Archetype* archetype = nullptr;
+    uint32_t row = 0;
+};
+
+// One per entity index. archetype == nullptr marks a free slot.
+struct EntitySlot {
+    EntityLocation location;
+    uint32_t generation = 0;          // Bumped on destroy
+    Entity nextFree = INVALID_ENTITY;  // Free list link while the slot is unused
+};
+
+// Persistent match list for one query signature. Owned by World and updated
+// whenever an archetype is created, so entities moving between archetypes
+// never require a rescan and iterating costs O(matches).
+struct QueryCache {
+    ComponentSignature signature;
+    std::vector<Archetype*> archetypes;
 };
 
 // ============================================================================
@@ -242,6 +344,21 @@ struct Active {
 
 class World;
 
+enum class SystemPhase : uint32_t {
+    Update = 0,
+    FixedUpdate = 1,
+    LateUpdate = 2,
+    
+    Count = 3
+};
+
+// Per-system timing, written by whichever thread ran the system
+struct SystemStats {
+    double lastTimeMs[static_cast<size_t>(SystemPhase::Count)] = {};
+    double totalTimeMs[static_cast<size_t>(SystemPhase::Count)] = {};
+    uint64_t runCount[static_cast<size_t>(SystemPhase::Count)] = {};
+};
+
 class System {
 public:
     virtual ~System() = default;
@@ -255,10 +372,25 @@ public:
     // Component requirements for this system
     ComponentSignature getSignature() const { return signature_; }
     
+    // Declared component access, used by the scheduler to run systems in parallel.
+    // A system that declares nothing is exclusive: it runs alone, in priority order.
+    // A system that declares access may only touch those components and must not
+    // make structural changes (create/destroy entities, add/remove components).
+    const ComponentSignature& getReadAccess() const { return readAccess_; }
+    const ComponentSignature& getWriteAccess() const { return writeAccess_; }
+    bool isExclusive() const { return exclusive_; }
+    bool conflictsWith(const System& other) const {
+        if (exclusive_ || other.exclusive_) return true;
+        return (writeAccess_ & (other.readAccess_ | other.writeAccess_)).any() ||
+               (other.writeAccess_ & readAccess_).any();
+    }
+    
     // Ordering
     int getPriority() const { return priority_; }
     void setPriority(int priority) { priority_ = priority; }
     
+    const SystemStats& getStats() const { return stats_; }
+    
 protected:
     template<typename T>
     void requireComponent() {
@@ -266,14 +398,239 @@ protected:
         signature_.set(id);
     }
     
+    template<typename T>
+    void readComponent() {
+        readAccess_.set(ComponentRegistry::getInstance().getTypeId<T>());
+        exclusive_ = false;
+    }
+    
+    template<typename T>
+    void writeComponent() {
+        writeAccess_.set(ComponentRegistry::getInstance().getTypeId<T>());
+        exclusive_ = false;
+    }
+    
     ComponentSignature signature_;
+    ComponentSignature readAccess_;
+    ComponentSignature writeAccess_;
+    bool exclusive_ = true;
     int priority_ = 0;
+    
+private:
+    friend class SystemScheduler;
+    SystemStats stats_;
+};
+
+// ============================================================================
+// SYSTEM SCHEDULER
+// ============================================================================
+
+/**
+ * Runs a World's systems for one phase. Systems are ordered by priority; a
+ * system depends on every earlier system it conflicts with, and the resulting
+ * DAG is executed on a JobSystem so non-conflicting systems overlap. Since
+ * conflicting pairs keep their priority order, results match a serial run.
+ */
+class SystemScheduler {
+public:
+    // Falls back to a deterministic single-threaded run in priority order
+    void setParallel(bool parallel) { parallel_ = parallel; }
+    bool isParallel() const { return parallel_; }
+    
+    // nullptr selects JobSystem::getInstance()
+    void setJobSystem(JobSystem* jobSystem) { jobSystem_ = jobSystem; }
+    JobSystem& getJobSystem() const { return jobSystem_ ? *jobSystem_ : JobSystem::getInstance(); }
+    
+    // Must be called whenever the system list or a system's access changes
+    void rebuild(const std::vector<std::shared_ptr<System>>& systems);
+    
+    void run(World& world, SystemPhase phase, float deltaTime);
+    
+    // Wall time of the last run of each phase
+    double getLastPhaseTimeMs(SystemPhase phase) const {
+        return lastPhaseTimeMs_[static_cast<size_t>(phase)];
+    }
+    
+    // Longest dependency chain in the graph (1 = everything can overlap)
+    uint32_t getCriticalPathLength() const { return criticalPathLength_; }
+    
+private:
+    struct Node {
+        System* system = nullptr;
+        std::vector<uint32_t> dependents;
+        uint32_t dependencyCount = 0;
+    };
+    
+    static void runSystem(System& system, World& world, SystemPhase phase, float deltaTime);
+    
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> roots_;
+    std::unique_ptr<std::atomic<uint32_t>[]> remaining_;
+    uint32_t criticalPathLength_ = 0;
+    bool parallel_ = true;
+    JobSystem* jobSystem_ = nullptr;
+    double lastPhaseTimeMs_[static_cast<size_t>(SystemPhase::Count)] = {};
 };
 
 // ============================================================================
 // EVENTS
 // ============================================================================
 
+// Events per block in an EventChannel buffer. Blocks are kept and reused
+// from frame to frame, so a warmed-up channel never allocates.
+constexpr size_t EVENT_BLOCK_SIZE = 256;
+constexpr size_t MAX_EVENT_BLOCKS = 1024;   // Per frame: 256K events per channel
+constexpr uint32_t MAX_EVENT_CHANNELS = 256;
+
+class IEventChannel {
+public:
+    virtual ~IEventChannel() = default;
+    virtual void swap() = 0;
+};
+
+/**
+ * Typed, double-buffered event stream. Producers append during a frame;
+ * swap() at the frame boundary publishes those events to consumers, who
+ * pull them in batches until the next swap.
+ *
+ * emit() is lock-free and may be called from any number of threads at once,
+ * but not concurrently with swap(). Reads may run concurrently with each
+ * other and with emit(). Trivially copyable payloads are cheapest.
+ */
+template<typename T>
+class EventChannel : public IEventChannel {
+public:
+    EventChannel() = default;
+    
+    ~EventChannel() override {
+        for (Buffer& buffer : buffers_) {
+            destroyEvents(buffer);
+            for (auto& block : buffer.blocks) {
+                T* data = block.load(std::memory_order_relaxed);
+                if (data) {
+                    ::operator delete(data, std::align_val_t(alignof(T)));
+                }
+            }
+        }
+    }
+    
+    EventChannel(const EventChannel&) = delete;
+    EventChannel& operator=(const EventChannel&) = delete;
+    
+    template<typename... Args>
+    void emit(Args&&... args) {
+        Buffer& buffer = buffers_[readIndex_ ^ 1];
+        size_t slot = buffer.count.fetch_add(1, std::memory_order_relaxed);
+        size_t blockIndex = slot / EVENT_BLOCK_SIZE;
+        if (blockIndex >= MAX_EVENT_BLOCKS) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        
+        T* block = buffer.blocks[blockIndex].load(std::memory_order_acquire);
+        if (!block) {
+            block = allocateBlock(buffer.blocks[blockIndex]);
+        }
+        new (block + slot % EVENT_BLOCK_SIZE) T(std::forward<Args>(args)...);
+    }
+    
+    // Retires the events consumers saw last frame and publishes this frame's
+    void swap() override {
+        Buffer& retired = buffers_[readIndex_];
+        destroyEvents(retired);
+        retired.count.store(0, std::memory_order_relaxed);
+        readIndex_ ^= 1;
+    }
+    
+    // Number of events readable this frame
+    size_t size() const { return readableCount(buffers_[readIndex_]); }
+    bool empty() const { return size() == 0; }
+    
+    // fn(const T* events, size_t count) once per contiguous block
+    template<typename Func>
+    void forEachBatch(Func&& fn) const {
+        const Buffer& buffer = buffers_[readIndex_];
+        size_t remaining = readableCount(buffer);
+        for (size_t blockIndex = 0; remaining > 0; ++blockIndex) {
+            size_t count = std::min(remaining, EVENT_BLOCK_SIZE);
+            fn(static_cast<const T*>(buffer.blocks[blockIndex].load(std::memory_order_acquire)), count);
+            remaining -= count;
+        }
+    }
+    
+    template<typename Func>
+    void forEach(Func&& fn) const {
+        forEachBatch([&fn](const T* events, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(events[i]);
+            }
+        });
+    }
+    
+    // Events lost because a frame exceeded EVENT_BLOCK_SIZE * MAX_EVENT_BLOCKS
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    
+private:
+    struct Buffer {
+        std::array<std::atomic<T*>, MAX_EVENT_BLOCKS> blocks{};
+        std::atomic<size_t> count{0};
+    };
+    
+    static size_t readableCount(const Buffer& buffer) {
+        return std::min(buffer.count.load(std::memory_order_acquire), EVENT_BLOCK_SIZE * MAX_EVENT_BLOCKS);
+    }
+    
+    static T* allocateBlock(std::atomic<T*>& slot) {
+        T* block = static_cast<T*>(::operator new(sizeof(T) * EVENT_BLOCK_SIZE, std::align_val_t(alignof(T))));
+        T* expected = nullptr;
+        if (!slot.compare_exchange_strong(expected, block, std::memory_order_acq_rel)) {
+            // Another producer got there first
+            ::operator delete(block, std::align_val_t(alignof(T)));
+            return expected;
+        }
+        return block;
+    }
+    
+    static void destroyEvents(Buffer& buffer) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            size_t remaining = readableCount(buffer);
+            for (size_t blockIndex = 0; remaining > 0; ++blockIndex) {
+                size_t count = std::min(remaining, EVENT_BLOCK_SIZE);
+                T* events = buffer.blocks[blockIndex].load(std::memory_order_relaxed);
+                for (size_t i = 0; i < count; ++i) {
+                    events[i].~T();
+                }
+                remaining -= count;
+            }
+        }
+    }
+    
+    Buffer buffers_[2];
+    uint32_t readIndex_ = 0;   // The other buffer receives emits
+    std::atomic<uint64_t> dropped_{0};
+};
+
+// Compile-time event type -> dense channel slot
+class EventChannelRegistry {
+public:
+    template<typename T>
+    static uint32_t getId() {
+        static const uint32_t id = allocateId();
+        return id;
+    }
+    
+private:
+    static uint32_t allocateId() {
+        static std::atomic<uint32_t> nextId{0};
+        uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+        if (id >= MAX_EVENT_CHANNELS) {
+            throw std::length_error("EventChannelRegistry: MAX_EVENT_CHANNELS exceeded");
+        }
+        return id;
+    }
+};
+
+// Untyped, name-keyed events (legacy API, built on EventChannel)
 struct Event {
     std::string name;
     std::any data;
@@ -290,7 +647,7 @@ public:
     }
     
     void emit(const Event& event) {
-        pendingEvents_.push(event);
+        pendingEvents_.emit(event);
     }
     
     void emitImmediate(const Event& event) {
@@ -303,22 +660,108 @@ public:
     }
     
     void processEvents() {
-        while (!pendingEvents_.empty()) {
-            Event event = pendingEvents_.front();
-            pendingEvents_.pop();
-            emitImmediate(event);
+        // Events emitted by callbacks are delivered in the same call
+        for (;;) {
+            pendingEvents_.swap();
+            if (pendingEvents_.empty()) break;
+            pendingEvents_.forEach([this](const Event& event) { emitImmediate(event); });
         }
     }
     
 private:
     std::unordered_map<std::string, std::vector<EventCallback>> subscribers_;
-    std::queue<Event> pendingEvents_;
+    EventChannel<Event> pendingEvents_;
+};
+
+// ============================================================================
+// COMMAND BUFFER - Deferred structural changes
+// ============================================================================
+
+// Entities created through a CommandBuffer carry this bit until playback
+constexpr Entity PENDING_ENTITY_BIT = 0x80000000u;
+
+/**
+ * Records create/destroy/add/remove so they can be applied to a World later,
+ * e.g. from worker threads while a query is being iterated. Component values
+ * are moved into a chunked arena and relocated straight into archetype rows
+ * on playback. Not thread-safe: use one buffer per thread.
+ */
+class CommandBuffer {
+public:
+    CommandBuffer() = default;
+    ~CommandBuffer() { clear(); }
+    
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+    
+    // Returns a placeholder that later commands in this buffer may refer to;
+    // the real entity is created on playback
+    Entity createEntity();
+    void destroyEntity(Entity entity);
+    
+    template<typename T>
+    void addComponent(Entity entity, T component = T{}) {
+        ComponentTypeId typeId = ComponentRegistry::getInstance().getTypeId<T>();
+        void* payload = allocatePayload(sizeof(T), alignof(T));
+        new (payload) T(std::move(component));
+        commands_.push_back({CommandType::AddComponent, entity, typeId, payload});
+    }
+    
+    template<typename T>
+    void removeComponent(Entity entity) {
+        ComponentTypeId typeId = ComponentRegistry::getInstance().getTypeId<T>();
+        commands_.push_back({CommandType::RemoveComponent, entity, typeId, nullptr});
+    }
+    
+    // Applies all commands in recording order, then clears the buffer
+    void playback(World& world);
+    
+    // Drops all commands, destroying any component values not played back
+    void clear();
+    
+    bool empty() const { return commands_.empty(); }
+    size_t size() const { return commands_.size(); }
+    
+private:
+    enum class CommandType : uint8_t {
+        CreateEntity,
+        DestroyEntity,
+        AddComponent,
+        RemoveComponent
+    };
+    
+    struct Command {
+        CommandType type;
+        Entity entity;
+        ComponentTypeId typeId;
+        void* payload;
+    };
+    
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size = 0;
+        size_t used = 0;
+    };
+    
+    void* allocatePayload(size_t size, size_t alignment);
+    Entity resolve(Entity entity) const;
+    
+    std::vector<Command> commands_;
+    std::vector<Block> blocks_;      // Retained across clear() for reuse
+    size_t currentBlock_ = 0;
+    std::vector<Entity> pendingEntities_;
+    uint32_t pendingCount_ = 0;
 };
 
 // ============================================================================
 // QUERY - Iterate entities with specific components
 // ============================================================================
 
+// Walks every archetype whose signature contains Components, chunk by chunk.
+// Backed by World's QueryCache, so constructing one doesn't scan or allocate
+// and it can be kept as a member and reused every frame.
+// Structural changes (add/remove component, destroy) during iteration may
+// move rows; defer them until the loop is done.
 template<typename... Components>
 class Query {
 public:
@@ -326,28 +769,94 @@ public:
     
     class Iterator {
     public:
-        Iterator(World& world, size_t index, const std::vector<Entity>& entities)
-            : world_(world), index_(index), entities_(entities) {}
+        Iterator(const std::vector<Archetype*>& archetypes, size_t archetypeIndex)
+            : archetypes_(&archetypes), archetypeIndex_(archetypeIndex) {
+            seekChunk();
+        }
         
-        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
-        Iterator& operator++() { ++index_; return *this; }
+        bool operator!=(const Iterator& other) const {
+            return archetypeIndex_ != other.archetypeIndex_ ||
+                   chunkIndex_ != other.chunkIndex_ ||
+                   row_ != other.row_;
+        }
         
-        std::tuple<Entity, Components&...> operator*();
+        Iterator& operator++() {
+            if (++row_ >= chunkSize_) {
+                row_ = 0;
+                ++chunkIndex_;
+                seekChunk();
+            }
+            return *this;
+        }
+        
+        std::tuple<Entity, Components&...> operator*() const {
+            return std::apply([this](Components*... columns) {
+                return std::tuple<Entity, Components&...>(entities_[row_], columns[row_]...);
+            }, columns_);
+        }
         
     private:
-        World& world_;
-        size_t index_;
-        const std::vector<Entity>& entities_;
+        // Advance to the next non-empty chunk and cache its column pointers
+        void seekChunk() {
+            while (archetypeIndex_ < archetypes_->size()) {
+                Archetype* archetype = (*archetypes_)[archetypeIndex_];
+                if (chunkIndex_ < archetype->getChunkCount()) {
+                    chunkSize_ = archetype->getChunkSize(chunkIndex_);
+                    entities_ = archetype->getChunkEntities(chunkIndex_);
+                    columns_ = std::make_tuple(archetype->template getChunkColumn<Components>(chunkIndex_)...);
+                    return;
+                }
+                ++archetypeIndex_;
+                chunkIndex_ = 0;
+            }
+        }
+        
+        const std::vector<Archetype*>* archetypes_;
+        size_t archetypeIndex_;
+        size_t chunkIndex_ = 0;
+        uint32_t row_ = 0;
+        uint32_t chunkSize_ = 0;
+        Entity* entities_ = nullptr;
+        std::tuple<Components*...> columns_;
     };
     
-    Iterator begin() { return Iterator(world_, 0, matchingEntities_); }
-    Iterator end() { return Iterator(world_, matchingEntities_.size(), matchingEntities_); }
+    Iterator begin() { return Iterator(cache_->archetypes, 0); }
+    Iterator end() { return Iterator(cache_->archetypes, cache_->archetypes.size()); }
+    
+    size_t count() const {
+        size_t total = 0;
+        for (Archetype* archetype : cache_->archetypes) {
+            total += archetype->size();
+        }
+        return total;
+    }
     
-    size_t count() const { return matchingEntities_.size(); }
+    // Splits the matched entities into contiguous ranges of grainSize and runs
+    // fn(entity, Components&..., CommandBuffer&) across the World's job pool,
+    // or serially when the scheduler isn't parallel. Each range records
+    // structural changes into its own CommandBuffer; they are played back on
+    // the calling thread, in range order, once all ranges finish, so results
+    // don't depend on which worker ran what. Call from outside the scheduler
+    // or from an exclusive system, since playback changes the World's
+    // structure and the buffers are the World's, reused from call to call.
+    template<typename Func>
+    void parallelForEach(Func&& fn, size_t grainSize = 256);
+    
+    // Hot-loop entry point: fn(count, entities, Components*...) once per chunk
+    template<typename Func>
+    void forEachChunk(Func&& fn) {
+        for (Archetype* archetype : cache_->archetypes) {
+            for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+                fn(static_cast<size_t>(archetype->getChunkSize(chunk)),
+                   archetype->getChunkEntities(chunk),
+                   archetype->template getChunkColumn<Components>(chunk)...);
+            }
+        }
+    }
     
 private:
-    World& world_;
-    std::vector<Entity> matchingEntities_;
+    World* world_;
+    const QueryCache* cache_;
 };
 
 // ============================================================================
@@ -356,60 +865,105 @@ private:
 
 class World {
 public:
-    World() = default;
+    World();
     ~World();
     
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+    
     // Entity management
     Entity createEntity();
     Entity createEntity(const std::string& name);
     void destroyEntity(Entity entity);
-    bool isValid(Entity entity) const;
+    
+    // Creates count entities with the components in signature, all
+    // default-constructed, in one pass. They take rows [outFirstRow,
+    // outFirstRow + count) of the returned archetype, so loaders can fill
+    // whole chunk columns at once.
+    Archetype* createEntities(const ComponentSignature& signature, size_t count,
+                              std::vector<Entity>& outEntities, uint32_t& outFirstRow);
+    
+    bool isValid(Entity entity) const {
+        return entity < entitySlots_.size() && entitySlots_[entity].location.archetype != nullptr;
+    }
+    
+    // Generation-checked references that never alias a recycled entity
+    bool isValid(EntityHandle handle) const {
+        return handle.index < entitySlots_.size() &&
+               entitySlots_[handle.index].generation == handle.generation &&
+               entitySlots_[handle.index].location.archetype != nullptr;
+    }
+    
+    EntityHandle getHandle(Entity entity) const {
+        if (!isValid(entity)) return EntityHandle{};
+        return EntityHandle{entity, entitySlots_[entity].generation};
+    }
+    
+    // Returns INVALID_ENTITY if the handle is stale
+    Entity resolve(EntityHandle handle) const {
+        return isValid(handle) ? handle.index : INVALID_ENTITY;
+    }
     
     // Component management
+    // Adding or removing a component moves the entity to another archetype,
+    // so references to its components do not survive the call.
+    // addComponent throws on an invalid entity; removeComponent ignores it.
     template<typename T>
     T& addComponent(Entity entity, T component = T{}) {
-        ComponentTypeId typeId = ComponentRegistry::getInstance().getTypeId<T>();
-        
-        // Create array if needed
-        if (componentArrays_.find(typeId) == componentArrays_.end()) {
-            componentArrays_[typeId] = std::make_shared<ComponentArray<T>>();
+        if (!isValid(entity)) {
+            throw std::invalid_argument("World::addComponent: invalid entity");
         }
         
-        auto& arr = getComponentArray<T>();
-        arr.insertData(entity, component);
+        ComponentTypeId typeId = ComponentRegistry::getInstance().getTypeId<T>();
+        EntityLocation& location = entitySlots_[entity].location;
         
-        signatures_[entity].set(typeId);
+        if (location.archetype->hasComponent(typeId)) {
+            T& existing = *static_cast<T*>(location.archetype->getComponent(location.row, typeId));
+            existing = std::move(component);
+            return existing;
+        }
         
-        return arr.getData(entity);
+        moveToArchetype(entity, getArchetypeWith(location.archetype, typeId));
+        void* storage = location.archetype->getComponent(location.row, typeId);
+        return *new (storage) T(std::move(component));
     }
     
     template<typename T>
     void removeComponent(Entity entity) {
-        ComponentTypeId typeId = ComponentRegistry::getInstance().getTypeId<T>();
-        getComponentArray<T>().removeData(entity);
-        signatures_[entity].reset(typeId);
+        removeComponentRaw(entity, ComponentRegistry::getInstance().getTypeId<T>());
     }
     
     template<typename T>
     T& getComponent(Entity entity) {
-        return getComponentArray<T>().getData(entity);
+        T* component = tryGetComponent<T>(entity);
+        if (!component) {
+            throw std::out_of_range("World::getComponent: entity does not have component");
+        }
+        return *component;
     }
     
     template<typename T>
     T* tryGetComponent(Entity entity) {
-        return getComponentArray<T>().tryGetData(entity);
+        if (entity >= entitySlots_.size()) return nullptr;
+        
+        ComponentTypeId typeId = ComponentRegistry::getInstance().getTypeId<T>();
+        const EntityLocation& location = entitySlots_[entity].location;
+        if (!location.archetype || !location.archetype->hasComponent(typeId)) return nullptr;
+        
+        return static_cast<T*>(location.archetype->getComponent(location.row, typeId));
     }
     
     template<typename T>
     bool hasComponent(Entity entity) const {
         ComponentTypeId typeId = ComponentRegistry::getInstance().getTypeId<T>();
-        auto it = signatures_.find(entity);
-        return it != signatures_.end() && it->second.test(typeId);
+        return getSignature(entity).test(typeId);
     }
     
     ComponentSignature getSignature(Entity entity) const {
-        auto it = signatures_.find(entity);
-        return it != signatures_.end() ? it->second : ComponentSignature{};
+        if (!isValid(entity)) {
+            return ComponentSignature{};
+        }
+        return entitySlots_[entity].location.archetype->getSignature();
     }
     
     // System management
@@ -420,8 +974,9 @@ public:
         system->init(*this);
         
         // Sort by priority
-        std::sort(systems_.begin(), systems_.end(),
+        std::stable_sort(systems_.begin(), systems_.end(),
             [](const auto& a, const auto& b) { return a->getPriority() < b->getPriority(); });
+        scheduler_.rebuild(systems_);
         
         return *system;
     }
@@ -440,8 +995,15 @@ public:
     void fixedUpdate(float fixedDeltaTime);
     void lateUpdate(float deltaTime);
     
+    SystemScheduler& getScheduler() { return scheduler_; }
+    
     // Entity queries
     std::vector<Entity> getEntitiesWithSignature(ComponentSignature signature) const;
+    std::vector<Archetype*> getMatchingArchetypes(ComponentSignature signature) const;
+    
+    // Persistent match list for signature, registered on first use.
+    // Safe to call from systems running in parallel.
+    const QueryCache& getQueryCache(const ComponentSignature& signature);
     
     template<typename... Components>
     Query<Components...> query() {
@@ -454,6 +1016,24 @@ public:
     // Events
     EventBus& getEventBus() { return eventBus_; }
     
+    // Typed event channel, created on first use (lock-free, any thread).
+    // Events emitted during a frame are readable for the whole next frame:
+    // World::update swaps every channel before running systems.
+    template<typename T>
+    EventChannel<T>& getEventChannel() {
+        std::atomic<IEventChannel*>& slot = eventChannels_[EventChannelRegistry::getId<T>()];
+        IEventChannel* channel = slot.load(std::memory_order_acquire);
+        if (!channel) {
+            IEventChannel* created = new EventChannel<T>();
+            if (slot.compare_exchange_strong(channel, created, std::memory_order_acq_rel)) {
+                channel = created;
+            } else {
+                delete created;
+            }
+        }
+        return *static_cast<EventChannel<T>*>(channel);
+    }
+    
     // Prefabs
     Entity instantiate(Entity prefab);
     Entity instantiate(Entity prefab, const glm::vec3& position, const glm::quat& rotation = glm::quat());
@@ -461,34 +1041,61 @@ public:
     // Scene management
     void clear();
     
+    // Bumped whenever an entity gains or loses a Transform
+    uint64_t getTransformStructureVersion() const { return transformStructureVersion_; }
+    
     // Debug
-    size_t getEntityCount() const { return livingEntities_.size(); }
+    size_t getEntityCount() const { return livingCount_; }
     size_t getSystemCount() const { return systems_.size(); }
+    size_t getArchetypeCount() const { return archetypeList_.size(); }
     
 private:
-    template<typename T>
-    ComponentArray<T>& getComponentArray() {
-        ComponentTypeId typeId = ComponentRegistry::getInstance().getTypeId<T>();
-        return *static_cast<ComponentArray<T>*>(componentArrays_[typeId].get());
-    }
-    
-    // Entity storage
-    std::queue<Entity> availableEntities_;
-    std::unordered_set<Entity> livingEntities_;
-    uint32_t nextEntityId_ = 0;
-    
-    // Component storage
-    std::unordered_map<ComponentTypeId, std::shared_ptr<IComponentArray>> componentArrays_;
-    std::unordered_map<Entity, ComponentSignature> signatures_;
+    Entity allocateEntity();
+    Archetype* getOrCreateArchetype(const ComponentSignature& signature);
+    Archetype* getArchetypeWith(Archetype* source, ComponentTypeId typeId);
+    Archetype* getArchetypeWithout(Archetype* source, ComponentTypeId typeId);
+    
+    // Type-erased component changes used by CommandBuffer playback.
+    // addComponentRaw relocates the value at source into the entity's row.
+    void addComponentRaw(Entity entity, ComponentTypeId typeId, void* source);
+    void removeComponentRaw(Entity entity, ComponentTypeId typeId);
+    friend class CommandBuffer;
+    
+    // Moves an entity's row into target. Shared components are relocated,
+    // components target lacks are destroyed, and components only target has
+    // are left uninitialized for the caller to construct.
+    void moveToArchetype(Entity entity, Archetype* target);
+    
+    // Entity storage: dense slots with a FIFO free list, so recycled indices
+    // are reused as late as possible
+    std::vector<EntitySlot> entitySlots_;
+    Entity freeHead_ = INVALID_ENTITY;
+    Entity freeTail_ = INVALID_ENTITY;
+    size_t livingCount_ = 0;
+    uint64_t transformStructureVersion_ = 0;
+    
+    // Component storage: one archetype per distinct signature
+    std::unordered_map<ComponentSignature, std::unique_ptr<Archetype>> archetypes_;
+    std::vector<Archetype*> archetypeList_;
+    Archetype* emptyArchetype_ = nullptr;
+    std::unordered_map<ComponentSignature, std::unique_ptr<QueryCache>> queryCaches_;
+    mutable std::shared_mutex queryCacheMutex_;
     
     // Systems
     std::vector<std::shared_ptr<System>> systems_;
+    SystemScheduler scheduler_;
     
     // Events
     EventBus eventBus_;
+    std::array<std::atomic<IEventChannel*>, MAX_EVENT_CHANNELS> eventChannels_{};
     
     // Pending destruction
     std::vector<Entity> pendingDestruction_;
+    
+    // Scratch for Query::parallelForEach, which runs one call at a time
+    template<typename... Components> friend class Query;
+    std::vector<size_t> parallelOffsets_;
+    std::vector<std::unique_ptr<CommandBuffer>> parallelCommands_;
 };
 
 // ============================================================================
@@ -496,17 +1103,78 @@ private:
 // ============================================================================
 
 template<typename... Components>
-Query<Components...>::Query(World& world) : world_(world) {
-    ComponentSignature required;
-    ((required.set(ComponentRegistry::getInstance().getTypeId<Components>())), ...);
-    
-    matchingEntities_ = world.getEntitiesWithSignature(required);
+Query<Components...>::Query(World& world) : world_(&world) {
+    static const ComponentSignature required = [] {
+        ComponentSignature signature;
+        ((signature.set(ComponentRegistry::getInstance().getTypeId<Components>())), ...);
+        return signature;
+    }();
+    
+    cache_ = &world.getQueryCache(required);
 }
 
 template<typename... Components>
-std::tuple<Entity, Components&...> Query<Components...>::Iterator::operator*() {
-    Entity entity = entities_[index_];
-    return std::tie(entity, world_.getComponent<Components>(entity)...);
+template<typename Func>
+void Query<Components...>::parallelForEach(Func&& fn, size_t grainSize) {
+    const std::vector<Archetype*>& archetypes = cache_->archetypes;
+    
+    // Prefix sums of archetype sizes so each range can find its first row
+    std::vector<size_t>& offsets = world_->parallelOffsets_;
+    offsets.clear();
+    offsets.push_back(0);
+    for (Archetype* archetype : archetypes) {
+        offsets.push_back(offsets.back() + archetype->size());
+    }
+    
+    size_t total = offsets.back();
+    if (total == 0) return;
+    
+    // A serial scheduler gets a single range on the calling thread
+    SystemScheduler& scheduler = world_->getScheduler();
+    grainSize = scheduler.isParallel() ? std::max<size_t>(1, grainSize) : total;
+    
+    // parallelFor splits at multiples of grainSize, so begin / grainSize
+    // names the range and its buffer
+    size_t rangeCount = (total + grainSize - 1) / grainSize;
+    std::vector<std::unique_ptr<CommandBuffer>>& commandBuffers = world_->parallelCommands_;
+    while (commandBuffers.size() < rangeCount) {
+        commandBuffers.push_back(std::make_unique<CommandBuffer>());
+    }
+    
+    scheduler.getJobSystem().parallelFor(total, grainSize, [&](size_t begin, size_t end) {
+        CommandBuffer& commands = *commandBuffers[begin / grainSize];
+        
+        size_t archetypeIndex = std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1;
+        size_t index = begin;
+        
+        while (index < end) {
+            Archetype* archetype = archetypes[archetypeIndex];
+            size_t archetypeEnd = std::min(end, offsets[archetypeIndex + 1]);
+            size_t row = index - offsets[archetypeIndex];
+            size_t capacity = archetype->getChunkCapacity();
+            
+            while (index < archetypeEnd) {
+                size_t chunk = row / capacity;
+                size_t first = row % capacity;
+                size_t rows = std::min(capacity - first, archetypeEnd - index);
+                
+                Entity* entities = archetype->getChunkEntities(chunk);
+                std::apply([&](Components*... columns) {
+                    for (size_t i = first; i < first + rows; ++i) {
+                        fn(entities[i], columns[i]..., commands);
+                    }
+                }, std::make_tuple(archetype->template getChunkColumn<Components>(chunk)...));
+                
+                index += rows;
+                row += rows;
+            }
+            ++archetypeIndex;
+        }
+    });
+    
+    for (size_t range = 0; range < rangeCount; ++range) {
+        commandBuffers[range]->playback(*world_);
+    }
 }
 
 // ============================================================================
@@ -641,6 +1309,15 @@ struct ParticleEmitter {
 // COMMON SYSTEMS
 // ============================================================================
 
+/**
+ * Maintains world matrices for the Transform hierarchy. Entities are kept in
+ * flat arrays in depth-first order (parents before children), so every
+ * subtree is a contiguous range. Writers report the Transforms they change
+ * with markDirty(); each update recomputes just the subtrees under those
+ * nodes, in parallel. Hierarchy edits (setParent, a dirty node with a new
+ * Transform::parent, new or destroyed transforms) trigger a rebuild and a
+ * full update.
+ */
 class TransformSystem : public System {
 public:
     TransformSystem() {
@@ -653,9 +1330,59 @@ public:
     void setParent(World& world, Entity child, Entity parent);
     void removeFromParent(World& world, Entity child);
     
+    // Record that entity's Transform was written. Thread-safe, but not
+    // during update(). A write nobody marks is seen at the next full update.
+    void markDirty(Entity entity);
+    void markAllDirty() { forceFullUpdate_ = true; }
+    
+    // For writers without the system at hand; no-op if none is registered
+    static void markDirty(World& world, Entity entity);
+    
+    // World matrices in hierarchy order, parallel to getOrderedEntities().
+    // Contiguous so the renderer can upload them directly.
+    const std::vector<glm::mat4>& getWorldMatrices() const { return worldMatrices_; }
+    const std::vector<Entity>& getOrderedEntities() const { return entities_; }
+    
+    // 1 for each node whose world matrix changed in the last update
+    const std::vector<uint8_t>& getChangedFlags() const { return changed_; }
+    size_t getLastChangedCount() const { return lastChangedCount_; }
+    
 private:
     void updateWorldMatrices(World& world);
-    std::unordered_map<Entity, glm::mat4> worldMatrices_;
+    void rebuildHierarchy(World& world);
+    
+    // Recomputes nodes [begin, end); false if a Transform has gone
+    bool updateRange(World& world, size_t begin, size_t end);
+    
+    // Collects the subtrees under dirty nodes into updateRanges_; false if
+    // one was reparented
+    bool collectDirtyRanges(World& world);
+    
+    // Flat hierarchy, parallel arrays indexed by node
+    std::vector<Entity> entities_;
+    std::vector<int32_t> parents_;          // Node index of parent, -1 for roots
+    std::vector<Entity> parentEntities_;    // Transform::parent seen at rebuild
+    std::vector<uint32_t> subtreeEnds_;     // One past the node's last descendant
+    std::vector<glm::mat4> worldMatrices_;
+    std::vector<uint8_t> changed_;
+    
+    std::vector<uint32_t> entityToNode_;    // Indexed by entity, UINT32_MAX if absent
+    std::vector<size_t> batchStarts_;       // Runs of whole root subtrees; last entry = node count
+    
+    // Dirty set: a flag per node and the flagged nodes in marking order
+    std::unique_ptr<std::atomic<uint8_t>[]> dirty_;
+    std::vector<uint32_t> dirtyNodes_;
+    std::atomic<size_t> dirtyCount_{0};
+    
+    // Disjoint node ranges updated this frame, and where each job's share starts
+    std::vector<std::pair<uint32_t, uint32_t>> updateRanges_;
+    std::vector<size_t> rangeBatchStarts_;
+    std::vector<std::pair<uint32_t, uint32_t>> changedRanges_;  // Last update's, to clear
+    
+    std::atomic<bool> hierarchyDirty_{true};
+    bool forceFullUpdate_ = true;
+    uint64_t structureVersion_ = 0;         // World's transform structure version at rebuild
+    size_t lastChangedCount_ = 0;
 };
 
 class MovementSystem : public System {
@@ -663,6 +1390,12 @@ public:
     MovementSystem() {
         requireComponent<Transform>();
         requireComponent<Velocity>();
+        writeComponent<Transform>();
+        readComponent<Velocity>();
+        
+        // Spreads its own work over the job pool with parallelForEach,
+        // which needs the World to itself
+        exclusive_ = true;
     }
     
     void update(World& world, float deltaTime) override;
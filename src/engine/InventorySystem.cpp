@@ -813,6 +813,8 @@ void InventorySystem::init(World& world) {
 }
 
 void InventorySystem::update(World& world, float deltaTime) {
+    TransformSystem* transforms = world.getSystem<TransformSystem>();
+    
     // Update world items (bobbing, rotation, despawn)
     world.query<WorldItemComponent, Transform>([&](Entity entity, 
                                                     WorldItemComponent& worldItem,
@@ -837,6 +839,10 @@ void InventorySystem::update(World& world, float deltaTime) {
                                              glm::radians(rotation),
                                              glm::vec3(0, 1, 0));
         }
+        
+        if (transforms && (worldItem.bobbing || worldItem.rotating)) {
+            transforms->markDirty(entity);
+        }
     });
 }
 
@@ -0,0 +1,175 @@
+/**
+ * JobSystem.cpp
+ *
+ * Implementation of the work-stealing thread pool.
+ */
+
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace Sanic {
+
+namespace {
+thread_local const JobSystem* tlsOwner = nullptr;
+thread_local uint32_t tlsWorkerIndex = 0;
+}
+
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return instance;
+}
+
+JobSystem::JobSystem(uint32_t workerCount) {
+    for (uint32_t i = 0; i <= workerCount; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        running_ = false;
+    }
+    sleepCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+uint32_t JobSystem::getCurrentWorkerIndex() const {
+    return tlsOwner == this ? tlsWorkerIndex : getWorkerCount();
+}
+
+void JobSystem::submit(Job job, JobCounter* counter) {
+    if (counter) {
+        counter->pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Workers push to their own queue; outside threads spread across workers
+    uint32_t queueIndex = getCurrentWorkerIndex();
+    if (queueIndex == getWorkerCount() && !workers_.empty()) {
+        queueIndex = nextQueue_.fetch_add(1, std::memory_order_relaxed) % getWorkerCount();
+    }
+
+    {
+        WorkerQueue& queue = *queues_[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back({std::move(job), counter});
+    }
+    queuedJobs_.fetch_add(1, std::memory_order_release);
+
+    {
+        // Taking the lock orders this notify after a sleeper's predicate check
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCondition_.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    uint32_t preferredQueue = getCurrentWorkerIndex();
+    while (!counter.isDone()) {
+        if (!tryRunOne(preferredQueue)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize,
+                            const std::function<void(size_t begin, size_t end)>& fn) {
+    if (count == 0) return;
+
+    grainSize = std::max<size_t>(1, grainSize);
+    size_t rangeCount = (count + grainSize - 1) / grainSize;
+
+    if (rangeCount == 1 || workers_.empty()) {
+        for (size_t begin = 0; begin < count; begin += grainSize) {
+            fn(begin, std::min(count, begin + grainSize));
+        }
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t range = 1; range < rangeCount; ++range) {
+        size_t begin = range * grainSize;
+        size_t end = std::min(count, begin + grainSize);
+        submit([&fn, begin, end] { fn(begin, end); }, &counter);
+    }
+
+    // The calling thread takes the first range itself
+    fn(0, std::min(count, grainSize));
+    wait(counter);
+}
+
+void JobSystem::workerLoop(uint32_t index) {
+    tlsOwner = this;
+    tlsWorkerIndex = index;
+
+    while (running_.load(std::memory_order_acquire)) {
+        if (tryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this] {
+            return !running_.load(std::memory_order_acquire) ||
+                   queuedJobs_.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+bool JobSystem::tryRunOne(uint32_t preferredQueue) {
+    QueuedJob job;
+    if (!popJob(preferredQueue, job)) {
+        return false;
+    }
+    execute(job);
+    return true;
+}
+
+bool JobSystem::popJob(uint32_t preferredQueue, QueuedJob& out) {
+    if (queuedJobs_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    // Own queue first, newest job (still warm in cache)
+    {
+        WorkerQueue& queue = *queues_[preferredQueue];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            out = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            queuedJobs_.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    // Steal the oldest job from someone else
+    size_t queueCount = queues_.size();
+    for (size_t offset = 1; offset < queueCount; ++offset) {
+        WorkerQueue& queue = *queues_[(preferredQueue + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            out = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            queuedJobs_.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::execute(QueuedJob& job) {
+    job.job();
+    if (job.counter) {
+        job.counter->pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+} // namespace Sanic
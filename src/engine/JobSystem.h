@@ -0,0 +1,102 @@
+/**
+ * JobSystem.h
+ *
+ * Work-stealing thread pool shared by engine subsystems.
+ *
+ * Features:
+ * - One deque per worker; owners pop LIFO, idle workers steal FIFO
+ * - Counters for waiting on groups of jobs
+ * - Waiting threads help execute jobs, so nested waits never deadlock
+ * - parallelFor over index ranges with a grain size
+ *
+ * Usage:
+ *   JobSystem& jobs = JobSystem::getInstance();
+ *   JobCounter counter;
+ *   jobs.submit([]{ doWork(); }, &counter);
+ *   jobs.wait(counter);
+ *
+ *   jobs.parallelFor(count, 256, [&](size_t begin, size_t end) { ... });
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Sanic {
+
+using Job = std::function<void()>;
+
+// Tracks completion of a group of submitted jobs
+class JobCounter {
+public:
+    bool isDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+    uint32_t getPending() const { return pending_.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32_t> pending_{0};
+};
+
+class JobSystem {
+public:
+    // Shared pool sized to the machine (hardware threads - 1 workers)
+    static JobSystem& getInstance();
+
+    // workerCount == 0 gives a pool with no threads; jobs then run inside wait()
+    explicit JobSystem(uint32_t workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(Job job, JobCounter* counter = nullptr);
+
+    // Blocks until counter reaches zero, running queued jobs meanwhile
+    void wait(JobCounter& counter);
+
+    // Splits [0, count) into ranges of at most grainSize and runs
+    // fn(begin, end) for each across the pool. Returns when all are done.
+    void parallelFor(size_t count, size_t grainSize,
+                     const std::function<void(size_t begin, size_t end)>& fn);
+
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+    // Index of the calling worker thread in [0, getWorkerCount()), or
+    // getWorkerCount() for any thread outside the pool
+    uint32_t getCurrentWorkerIndex() const;
+
+private:
+    struct QueuedJob {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<QueuedJob> jobs;
+    };
+
+    void workerLoop(uint32_t index);
+    bool tryRunOne(uint32_t preferredQueue);
+    bool popJob(uint32_t preferredQueue, QueuedJob& out);
+    void execute(QueuedJob& job);
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;  // One per worker, plus one for outside threads
+    std::atomic<uint32_t> nextQueue_{0};
+    std::atomic<size_t> queuedJobs_{0};
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    std::atomic<bool> running_{true};
+};
+
+} // namespace Sanic
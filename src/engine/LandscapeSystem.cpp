@@ -126,6 +126,7 @@ uint32_t LandscapeSystem::createLandscape(const LandscapeConfig& config) {
     
     landscape.id = id;
     landscape.config = config;
+    ++revision_;
     landscape.transform = glm::mat4(1.0f);
     landscape.invTransform = glm::mat4(1.0f);
     
@@ -229,6 +230,7 @@ void LandscapeSystem::destroyLandscape(uint32_t landscapeId) {
     }
     
     landscapes_.erase(it);
+    ++revision_;
 }
 
 bool LandscapeSystem::createComponent(Landscape& landscape, uint32_t x, uint32_t y) {
@@ -621,6 +623,7 @@ void LandscapeSystem::setTransform(uint32_t landscapeId, const glm::vec3& positi
     Landscape& landscape = it->second;
     landscape.transform = glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(rotation);
     landscape.invTransform = glm::inverse(landscape.transform);
+    ++revision_;
 }
 
 bool LandscapeSystem::importHeightmap(uint32_t landscapeId, const std::string& path) {
@@ -686,6 +689,7 @@ bool LandscapeSystem::importHeightmap(uint32_t landscapeId, const uint16_t* data
         updateHeightmapTexture(component);
     }
     
+    ++revision_;
     return true;
 }
 
@@ -698,6 +702,7 @@ uint32_t LandscapeSystem::addLayer(uint32_t landscapeId, const LandscapeLayer& l
     newLayer.id = static_cast<uint32_t>(landscape.layers.size()) + 1;
     
     landscape.layers.push_back(newLayer);
+    ++revision_;
     return newLayer.id;
 }
 
@@ -711,6 +716,7 @@ void LandscapeSystem::removeLayer(uint32_t landscapeId, uint32_t layerId) {
                        [layerId](const LandscapeLayer& l) { return l.id == layerId; }),
         landscape.layers.end()
     );
+    ++revision_;
 }
 
 void LandscapeSystem::applyBrush(uint32_t landscapeId, const glm::vec3& worldPos,
@@ -727,6 +733,7 @@ void LandscapeSystem::applyBrush(uint32_t landscapeId, const glm::vec3& worldPos
     
     // Find affected components
     float brushRadiusWorld = brush.radius;
+    ++revision_;
     
     for (auto& component : landscape.components) {
         // Check if brush overlaps component
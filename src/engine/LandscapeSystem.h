@@ -298,6 +298,12 @@ public:
     };
     Statistics getStatistics(uint32_t landscapeId) const;
     
+    /**
+     * Edit counter, bumped by every change to a landscape's shape, layers
+     * or placement. Lets derived data (PCG caches) tell when to rebuild.
+     */
+    uint64_t getRevision() const { return revision_; }
+    
 private:
     // Internal structures
     struct Landscape {
@@ -364,6 +370,7 @@ private:
     
     std::unordered_map<uint32_t, Landscape> landscapes_;
     uint32_t nextLandscapeId_ = 1;
+    uint64_t revision_ = 0;
     
     // Shared sampler
     VkSampler heightmapSampler_ = VK_NULL_HANDLE;
@@ -12,9 +12,14 @@
 #include <cmath>
 #include <fstream>
 #include <chrono>
+#include <cstring>
 
 namespace Sanic {
 
+// How far ahead free sources are predicted for ordinary streaming; the
+// prefetch planner looks beyond it
+static constexpr float VELOCITY_PREDICTION_TIME = 1.0f;
+
 LevelStreaming::LevelStreaming() = default;
 
 LevelStreaming::~LevelStreaming() {
@@ -32,7 +37,7 @@ bool LevelStreaming::initialize(VulkanContext* context, AsyncPhysics* physics,
     // Start streaming threads
     if (config_.useAsyncLoading) {
         shutdownRequested_ = false;
-        for (uint32_t i = 0; i < config_.streamingThreads; ++i) {
+        for (uint32_t i = 0; i < std::max(config_.streamingThreads, 1u); ++i) {
             streamingThreads_.emplace_back(&LevelStreaming::streamingThreadFunc, this);
         }
     }
@@ -46,7 +51,7 @@ void LevelStreaming::shutdown() {
     
     // Signal shutdown to streaming threads
     {
-        std::lock_guard<std::mutex> lock(streamingMutex_);
+        std::lock_guard<std::mutex> lock(queueMutex_);
         shutdownRequested_ = true;
     }
     streamingCondition_.notify_all();
@@ -59,18 +64,36 @@ void LevelStreaming::shutdown() {
     }
     streamingThreads_.clear();
     
-    // Unload all cells
+    // Unload all cells, including ones partway through activation
     for (auto& [hash, cell] : cells_) {
-        if (cell.state == WorldCell::State::Loaded) {
+        if (cell.state != WorldCell::State::Unloaded) {
             unloadCellActors(cell);
         }
     }
     
     cells_.clear();
+    cellsById_.clear();
+    activeCells_.clear();
+    visitedCells_.clear();
     sources_.clear();
     dataLayers_.clear();
     streamingVolumes_.clear();
     
+    streamingSplines_.clear();
+    splineStreamingSources_.clear();
+    
+    loadQueue_ = {};
+    unloadQueue_ = {};
+    queuedTickets_.clear();
+    queuedLoadBytes_ = 0;
+    completedLoads_.clear();
+    pendingActivations_.clear();
+    prefetchPlan_.clear();
+    prefetchQueue_ = {};
+    for (auto& issued : issuedPrefetches_) issued.clear();
+    memoryUsed_ = 0;
+    worldPath_.clear();
+    
     initialized_ = false;
 }
 
@@ -100,19 +123,24 @@ WorldCell& LevelStreaming::getOrCreateCell(glm::ivec2 coord) {
     auto it = cells_.find(hash);
     if (it == cells_.end()) {
         WorldCell cell;
-        cell.id = static_cast<uint32_t>(cells_.size());
+        cell.id = static_cast<uint32_t>(cellsById_.size());
         cell.gridCoord = coord;
         cell.boundsMin = glm::vec3(coord.x * config_.cellSize, -1e6f, coord.y * config_.cellSize);
         cell.boundsMax = glm::vec3((coord.x + 1) * config_.cellSize, 1e6f, (coord.y + 1) * config_.cellSize);
         cell.state = WorldCell::State::Unloaded;
+        cell.hlodLevel = static_cast<uint32_t>(config_.hlodLevels.size());  // Far until a source comes near
         
-        cells_[hash] = cell;
-        it = cells_.find(hash);
+        it = cells_.emplace(hash, std::move(cell)).first;
+        cellsById_.push_back(&it->second);  // Map nodes don't move on rehash
     }
     
     return it->second;
 }
 
+WorldCell* LevelStreaming::findCell(uint32_t cellId) {
+    return cellId < cellsById_.size() ? cellsById_[cellId] : nullptr;
+}
+
 uint32_t LevelStreaming::addStreamingSource(const StreamingSource& source) {
     uint32_t id = nextSourceId_++;
     sources_[id] = source;
@@ -172,6 +200,245 @@ uint32_t LevelStreaming::addStreamingVolume(const StreamingVolume& volume) {
     return id;
 }
 
+uint32_t LevelStreaming::addStreamingSpline(const StreamingSpline& spline) {
+    uint32_t id = nextSplineId_++;
+    StreamingSpline& stored = streamingSplines_[id];
+    stored = spline;
+    stored.id = id;
+    resampleSpline(stored);
+    return id;
+}
+
+void LevelStreaming::updateStreamingSpline(uint32_t splineId, const std::vector<SplinePoint>& points) {
+    auto it = streamingSplines_.find(splineId);
+    if (it == streamingSplines_.end()) return;
+    
+    it->second.points = points;
+    resampleSpline(it->second);
+}
+
+void LevelStreaming::removeStreamingSpline(uint32_t splineId) {
+    streamingSplines_.erase(splineId);
+    
+    for (auto it = splineStreamingSources_.begin(); it != splineStreamingSources_.end();) {
+        if (it->second.splineId == splineId) {
+            it = splineStreamingSources_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto& [id, source] : sources_) {
+        if (source.lockedSplineId == splineId) source.lockedSplineId = 0;
+    }
+}
+
+StreamingSpline* LevelStreaming::getStreamingSpline(uint32_t splineId) {
+    auto it = streamingSplines_.find(splineId);
+    return it != streamingSplines_.end() ? &it->second : nullptr;
+}
+
+uint32_t LevelStreaming::addSplineStreamingSource(uint32_t splineId, float initialPosition) {
+    uint32_t id = nextSplineSourceId_++;
+    SplineStreamingSource& source = splineStreamingSources_[id];
+    source.id = id;
+    source.splineId = splineId;
+    source.position = initialPosition;
+    source.worldPosition = evaluateSpline(splineId, initialPosition);
+    source.direction = evaluateSplineTangent(splineId, initialPosition);
+    
+    auto spline = streamingSplines_.find(splineId);
+    if (spline != streamingSplines_.end()) {
+        source.distanceAlongSpline = initialPosition * spline->second.cachedLength;
+    }
+    return id;
+}
+
+void LevelStreaming::updateSplineStreamingSource(uint32_t sourceId, float position, float velocity) {
+    auto it = splineStreamingSources_.find(sourceId);
+    if (it == splineStreamingSources_.end()) return;
+    
+    it->second.position = position;
+    it->second.velocity = velocity;
+}
+
+void LevelStreaming::updateSplineStreamingSources() {
+    for (auto& [id, source] : splineStreamingSources_) {
+        auto spline = streamingSplines_.find(source.splineId);
+        if (spline == streamingSplines_.end()) continue;
+        
+        source.worldPosition = evaluateSpline(spline->second, source.position);
+        source.direction = evaluateSplineTangent(source.splineId, source.position);
+        source.distanceAlongSpline = source.position * spline->second.cachedLength;
+    }
+}
+
+void LevelStreaming::resampleSpline(StreamingSpline& spline) {
+    uint32_t count = std::max(spline.sampleCount, 2u);
+    spline.sampledPoints.resize(count);
+    spline.sampledDistances.resize(count);
+    
+    float length = 0.0f;
+    for (uint32_t i = 0; i < count; ++i) {
+        float t = static_cast<float>(i) / (count - 1);
+        spline.sampledPoints[i] = evaluateSpline(spline, t);
+        if (i > 0) {
+            length += glm::distance(spline.sampledPoints[i - 1], spline.sampledPoints[i]);
+        }
+        spline.sampledDistances[i] = length;
+    }
+    spline.cachedLength = length;
+}
+
+namespace {
+
+// Segment of a spline with point count n containing t, and t within it
+void splineSegment(size_t n, float t, bool closed, size_t& segment, float& u) {
+    size_t segments = closed ? n : n - 1;
+    float f = std::clamp(t, 0.0f, 1.0f) * segments;
+    segment = std::min(static_cast<size_t>(f), segments - 1);
+    u = f - segment;
+}
+
+size_t splinePointIndex(int64_t index, size_t n, bool closed) {
+    if (closed) return static_cast<size_t>(((index % int64_t(n)) + n) % n);
+    return static_cast<size_t>(std::clamp<int64_t>(index, 0, int64_t(n) - 1));
+}
+
+} // namespace
+
+glm::vec3 LevelStreaming::evaluateSpline(uint32_t splineId, float t) const {
+    auto it = streamingSplines_.find(splineId);
+    if (it == streamingSplines_.end()) return glm::vec3(0.0f);
+    return evaluateSpline(it->second, t);
+}
+
+glm::vec3 LevelStreaming::evaluateSpline(const StreamingSpline& spline, float t) const {
+    const auto& points = spline.points;
+    if (points.empty()) return glm::vec3(0.0f);
+    if (points.size() == 1) return points[0].position;
+    
+    switch (spline.type) {
+        case StreamingSpline::Type::Linear: {
+            size_t segment;
+            float u;
+            splineSegment(points.size(), t, spline.isClosed, segment, u);
+            const glm::vec3& p1 = points[segment].position;
+            const glm::vec3& p2 = points[splinePointIndex(segment + 1, points.size(), spline.isClosed)].position;
+            return glm::mix(p1, p2, u);
+        }
+        case StreamingSpline::Type::CatmullRom:
+            return evaluateCatmullRom(points, t, spline.isClosed);
+        case StreamingSpline::Type::Bezier:
+            return evaluateBezier(points, t, spline.isClosed);
+        case StreamingSpline::Type::Hermite:
+            return evaluateHermite(points, t, spline.isClosed);
+    }
+    return points[0].position;
+}
+
+glm::vec3 LevelStreaming::evaluateCatmullRom(const std::vector<SplinePoint>& points, float t, bool closed) const {
+    size_t segment;
+    float u;
+    splineSegment(points.size(), t, closed, segment, u);
+    
+    int64_t i = static_cast<int64_t>(segment);
+    const glm::vec3& p0 = points[splinePointIndex(i - 1, points.size(), closed)].position;
+    const glm::vec3& p1 = points[splinePointIndex(i, points.size(), closed)].position;
+    const glm::vec3& p2 = points[splinePointIndex(i + 1, points.size(), closed)].position;
+    const glm::vec3& p3 = points[splinePointIndex(i + 2, points.size(), closed)].position;
+    
+    float u2 = u * u;
+    float u3 = u2 * u;
+    return 0.5f * (2.0f * p1 + (p2 - p0) * u +
+                   (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u2 +
+                   (3.0f * p1 - p0 - 3.0f * p2 + p3) * u3);
+}
+
+glm::vec3 LevelStreaming::evaluateBezier(const std::vector<SplinePoint>& points, float t, bool closed) const {
+    size_t segment;
+    float u;
+    splineSegment(points.size(), t, closed, segment, u);
+    
+    // Tangents are handle offsets: out from this point, in towards the next
+    const SplinePoint& a = points[segment];
+    const SplinePoint& b = points[splinePointIndex(segment + 1, points.size(), closed)];
+    glm::vec3 c1 = a.position + a.tangentOut;
+    glm::vec3 c2 = b.position - b.tangentIn;
+    
+    float v = 1.0f - u;
+    return v * v * v * a.position + 3.0f * v * v * u * c1 + 3.0f * v * u * u * c2 + u * u * u * b.position;
+}
+
+glm::vec3 LevelStreaming::evaluateHermite(const std::vector<SplinePoint>& points, float t, bool closed) const {
+    size_t segment;
+    float u;
+    splineSegment(points.size(), t, closed, segment, u);
+    
+    const SplinePoint& a = points[segment];
+    const SplinePoint& b = points[splinePointIndex(segment + 1, points.size(), closed)];
+    
+    float u2 = u * u;
+    float u3 = u2 * u;
+    return (2.0f * u3 - 3.0f * u2 + 1.0f) * a.position + (u3 - 2.0f * u2 + u) * a.tangentOut +
+           (-2.0f * u3 + 3.0f * u2) * b.position + (u3 - u2) * b.tangentIn;
+}
+
+glm::vec3 LevelStreaming::evaluateSplineTangent(uint32_t splineId, float t) const {
+    auto it = streamingSplines_.find(splineId);
+    if (it == streamingSplines_.end()) return glm::vec3(0.0f, 0.0f, 1.0f);
+    
+    const float dt = 0.001f;
+    glm::vec3 delta = evaluateSpline(it->second, std::min(t + dt, 1.0f)) -
+                      evaluateSpline(it->second, std::max(t - dt, 0.0f));
+    float length = glm::length(delta);
+    return length > 0.0f ? delta / length : glm::vec3(0.0f, 0.0f, 1.0f);
+}
+
+float LevelStreaming::findClosestPointOnSpline(uint32_t splineId, const glm::vec3& worldPos) const {
+    auto it = streamingSplines_.find(splineId);
+    if (it == streamingSplines_.end()) return 0.0f;
+    return findClosestPointOnSpline(it->second, worldPos);
+}
+
+float LevelStreaming::findClosestPointOnSpline(const StreamingSpline& spline, const glm::vec3& worldPos) const {
+    const auto& samples = spline.sampledPoints;
+    if (samples.size() < 2) return 0.0f;
+    
+    // Closest sampled segment, then the projection onto it
+    float bestDistance = std::numeric_limits<float>::max();
+    float bestT = 0.0f;
+    for (size_t i = 0; i + 1 < samples.size(); ++i) {
+        glm::vec3 segment = samples[i + 1] - samples[i];
+        float lengthSq = glm::dot(segment, segment);
+        float u = lengthSq > 0.0f ? std::clamp(glm::dot(worldPos - samples[i], segment) / lengthSq, 0.0f, 1.0f) : 0.0f;
+        
+        float distance = glm::distance(worldPos, samples[i] + segment * u);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            bestT = (static_cast<float>(i) + u) / (samples.size() - 1);
+        }
+    }
+    return bestT;
+}
+
+float LevelStreaming::getSplineStreamingDistance(uint32_t splineId, float t) const {
+    auto it = streamingSplines_.find(splineId);
+    if (it == streamingSplines_.end()) return config_.streamingDistance;
+    return getSplineStreamingDistance(it->second, t);
+}
+
+float LevelStreaming::getSplineStreamingDistance(const StreamingSpline& spline, float t) const {
+    const auto& points = spline.points;
+    if (points.empty()) return spline.defaultStreamingDistance;
+    if (points.size() == 1) return points[0].streamingDistance;
+    
+    size_t segment;
+    float u;
+    splineSegment(points.size(), t, spline.isClosed, segment, u);
+    return glm::mix(points[segment].streamingDistance,
+                    points[splinePointIndex(segment + 1, points.size(), spline.isClosed)].streamingDistance, u);
+}
+
 void LevelStreaming::addActorToCell(glm::ivec2 cellCoord, const CellActor& actor) {
     WorldCell& cell = getOrCreateCell(cellCoord);
     cell.actors.push_back(actor);
@@ -181,52 +448,116 @@ void LevelStreaming::addActorToCell(glm::ivec2 cellCoord, const CellActor& actor
     cell.boundsMax.y = std::max(cell.boundsMax.y, actor.boundsMax.y);
 }
 
+void LevelStreaming::addCellResource(glm::ivec2 cellCoord, const CellResourceRef& resource) {
+    getOrCreateCell(cellCoord).resources.push_back(resource);
+}
+
+void LevelStreaming::setPrefetchHandler(PrefetchKind kind, PrefetchHandler handler) {
+    prefetchHandlers_[static_cast<size_t>(kind)] = std::move(handler);
+}
+
 void LevelStreaming::update(float deltaTime, uint64_t frameNumber) {
     currentFrame_ = frameNumber;
     
+    updateSplineStreamingSources();
+    
+    // Plan prefetches first so priorities don't unload what's planned
+    if (config_.enablePrefetch) {
+        updatePrefetchPlan(deltaTime);
+    }
+    
     // Update streaming priorities
     updateStreamingPriorities();
     
+    if (config_.enablePrefetch) {
+        issuePrefetches();
+    }
+    
     // Process streaming queue (synchronous loads if async disabled)
     if (!config_.useAsyncLoading) {
         processStreamingQueue();
     } else {
-        // Wake up streaming threads
+        // Wake up streaming threads, then activate what they've read
         streamingCondition_.notify_all();
+        activatePendingCells();
+        processUnloads();
     }
     
     // Update HLOD visibility
     updateHLODVisibility();
 }
 
+void LevelStreaming::visitCell(WorldCell& cell) {
+    if (cell.priorityPass == priorityPass_) return;
+    
+    cell.priorityPass = priorityPass_;
+    cell.distanceToSource = std::numeric_limits<float>::max();
+    cell.loadPriority = 0.0f;
+    passCells_.push_back(&cell);
+}
+
 void LevelStreaming::updateStreamingPriorities() {
-    // Calculate min distance to any streaming source for each cell
-    for (auto& [hash, cell] : cells_) {
-        cell.distanceToSource = std::numeric_limits<float>::max();
-        cell.loadPriority = 0.0f;
-        
-        for (const auto& [id, source] : sources_) {
-            if (!source.isActive) continue;
-            
-            glm::vec3 cellCenter = cellToWorld(cell.gridCoord);
-            
-            // Predict future position if using velocity
-            glm::vec3 sourcePos = source.position;
-            if (source.useVelocityPrediction) {
-                sourcePos += source.velocity * 1.0f;  // 1 second prediction
-            }
-            
-            float dist = glm::distance(glm::vec2(cellCenter.x, cellCenter.z),
-                                        glm::vec2(sourcePos.x, sourcePos.z));
-            
-            if (dist < cell.distanceToSource) {
-                cell.distanceToSource = dist;
+    priorityPass_++;
+    passCells_.clear();
+    
+    // Cells whose state or HLOD level may change: those loaded or loading,
+    // and those near a source last pass, which get one more pass at max
+    // distance once it has moved away
+    for (uint32_t cellId : activeCells_) {
+        if (WorldCell* cell = findCell(cellId)) visitCell(*cell);
+    }
+    for (uint32_t cellId : visitedCells_) {
+        if (WorldCell* cell = findCell(cellId)) visitCell(*cell);
+    }
+    
+    // Beyond this every cell gets the last HLOD level and unloads anyway
+    float queryDistance = config_.unloadDistance;
+    for (const auto& level : config_.hlodLevels) {
+        queryDistance = std::max(queryDistance, level.distance);
+    }
+    int cellRadius = static_cast<int>(std::ceil(queryDistance / config_.cellSize));
+    
+    // Calculate min distance to any streaming source for the cells around it
+    auto probeSource = [&](const glm::vec3& sourcePos, int32_t sourcePriority) {
+        glm::ivec2 center = worldToCell(sourcePos);
+        for (int y = center.y - cellRadius; y <= center.y + cellRadius; ++y) {
+            for (int x = center.x - cellRadius; x <= center.x + cellRadius; ++x) {
+                auto it = cells_.find(cellHash({x, y}));
+                if (it == cells_.end()) continue;
+                
+                WorldCell& cell = it->second;
+                visitCell(cell);
+                
+                glm::vec3 cellCenter = cellToWorld(cell.gridCoord);
+                float dist = glm::distance(glm::vec2(cellCenter.x, cellCenter.z),
+                                            glm::vec2(sourcePos.x, sourcePos.z));
+                
+                if (dist < cell.distanceToSource) {
+                    cell.distanceToSource = dist;
+                }
+                
+                // Calculate priority (closer = higher priority)
+                float priority = sourcePriority * 1000.0f + (1000.0f - dist);
+                cell.loadPriority = std::max(cell.loadPriority, priority);
             }
-            
-            // Calculate priority (closer = higher priority)
-            float priority = source.priority * 1000.0f + (1000.0f - dist);
-            cell.loadPriority = std::max(cell.loadPriority, priority);
         }
+    };
+    
+    for (const auto& [id, source] : sources_) {
+        if (!source.isActive) continue;
+        
+        // Predict future position if using velocity
+        glm::vec3 sourcePos = source.position;
+        if (source.useVelocityPrediction) {
+            sourcePos += source.velocity * VELOCITY_PREDICTION_TIME;
+        }
+        probeSource(sourcePos, source.priority);
+    }
+    
+    for (const auto& [id, source] : splineStreamingSources_) {
+        auto spline = streamingSplines_.find(source.splineId);
+        if (!source.isActive || spline == streamingSplines_.end() || !spline->second.isEnabled) continue;
+        probeSource(source.worldPosition, 0);
     }
     
     // Check streaming volumes
@@ -234,169 +565,563 @@ void LevelStreaming::updateStreamingPriorities() {
         if (!volume.isEnabled) continue;
         
         for (uint32_t cellId : volume.affectedCells) {
-            // Find cell by ID (inefficient - in production use ID lookup map)
-            for (auto& [hash, cell] : cells_) {
-                if (cell.id != cellId) continue;
-                
-                switch (volume.mode) {
-                    case StreamingVolume::Mode::ForceLoad:
-                        cell.loadPriority += 10000.0f;
-                        break;
-                    case StreamingVolume::Mode::BlockLoad:
-                        cell.loadPriority = -10000.0f;
-                        break;
-                    case StreamingVolume::Mode::OverrideDistance:
-                        cell.distanceToSource = std::min(cell.distanceToSource, volume.overrideDistance);
-                        break;
-                    case StreamingVolume::Mode::ForceUnload:
-                        cell.loadPriority = -20000.0f;
-                        break;
-                }
-                break;
+            WorldCell* cell = findCell(cellId);
+            if (!cell) continue;
+            visitCell(*cell);
+            
+            switch (volume.mode) {
+                case StreamingVolume::Mode::ForceLoad:
+                    cell->loadPriority += 10000.0f;
+                    break;
+                case StreamingVolume::Mode::BlockLoad:
+                    cell->loadPriority = -10000.0f;
+                    break;
+                case StreamingVolume::Mode::OverrideDistance:
+                    cell->distanceToSource = std::min(cell->distanceToSource, volume.overrideDistance);
+                    break;
+                case StreamingVolume::Mode::ForceUnload:
+                    cell->loadPriority = -20000.0f;
+                    break;
             }
         }
     }
     
     // Queue loads/unloads
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    
-    for (auto& [hash, cell] : cells_) {
-        bool shouldLoad = cell.distanceToSource < config_.streamingDistance &&
-                          cell.loadPriority > 0;
-        bool shouldUnload = cell.distanceToSource > config_.unloadDistance ||
-                            cell.loadPriority < 0;
-        
-        if (shouldLoad && cell.state == WorldCell::State::Unloaded) {
-            // Check if not already in queue
-            bool alreadyQueued = false;
-            {
-                std::lock_guard<std::mutex> activeLock(activeLoadsMutex_);
-                alreadyQueued = activeLoads_.count(cell.id) > 0;
+    for (WorldCell* cell : passCells_) {
+        bool shouldLoad = cell->distanceToSource < config_.streamingDistance &&
+                          cell->loadPriority > 0;
+        bool planned = config_.enablePrefetch && cell->prefetchPass == prefetchPass_;
+        bool shouldUnload = (cell->distanceToSource > config_.unloadDistance && !planned) ||
+                            cell->loadPriority < 0;
+        
+        // Prefetch telemetry: was it resident by the time it was needed?
+        if (shouldLoad && !cell->isDemanded) {
+            cell->isDemanded = true;
+            demandedCells_++;
+            if (cell->state == WorldCell::State::Loaded) residentOnDemand_++;
+            if (cell->wasPrefetched) {
+                usefulPrefetches_++;
+                cell->wasPrefetched = false;
             }
+        } else if (!shouldLoad) {
+            cell->isDemanded = false;
+        }
+        
+        if (shouldLoad && cell->state == WorldCell::State::Unloaded) {
+            queueCellLoad(*cell, cell->loadPriority);
+        } else if (shouldUnload && cell->state == WorldCell::State::Loading) {
+            cancelCellLoad(*cell);
+        } else if (shouldUnload && cell->state == WorldCell::State::Loaded) {
+            cell->state = WorldCell::State::Unloading;
             
-            if (!alreadyQueued) {
-                StreamingRequest req;
-                req.cellId = cell.id;
-                req.priority = cell.loadPriority;
-                req.isLoad = true;
-                loadQueue_.push(req);
-            }
-        } else if (shouldUnload && cell.state == WorldCell::State::Loaded) {
+            std::lock_guard<std::mutex> lock(queueMutex_);
             StreamingRequest req;
-            req.cellId = cell.id;
-            req.priority = -cell.loadPriority;  // Invert so low priority unloads first
+            req.cellId = cell->id;
+            req.priority = -cell->loadPriority;  // Invert so low priority unloads first
             req.isLoad = false;
             unloadQueue_.push(req);
         }
     }
+    
+    visitedCells_.clear();
+    for (WorldCell* cell : passCells_) {
+        if (cell->distanceToSource != std::numeric_limits<float>::max()) {
+            visitedCells_.push_back(cell->id);
+        }
+    }
 }
 
-void LevelStreaming::processStreamingQueue() {
-    uint32_t loadsThisFrame = 0;
+void LevelStreaming::queueCellLoad(WorldCell& cell, float priority) {
+    cell.state = WorldCell::State::Loading;
+    cell.loadTicket++;
+    activeCells_.insert(cell.id);
+    
+    StreamingRequest req;
+    req.cellId = cell.id;
+    req.priority = priority;
+    req.isLoad = true;
+    req.ticket = cell.loadTicket;
+    req.dataOffset = cell.dataOffset;
+    req.dataSize = cell.dataSize;
     
     std::lock_guard<std::mutex> lock(queueMutex_);
+    queuedTickets_[cell.id] = req.ticket;
+    queuedLoadBytes_ += req.dataSize;
+    loadQueue_.push(req);
+}
+
+void LevelStreaming::cancelCellLoad(WorldCell& cell) {
+    // Actors activated so far go; a read in flight is dropped when it lands
+    unloadCellActors(cell);
+    if (cell.dataSize > 0 && !cell.actors.empty()) {
+        memoryUsed_ -= std::min<uint64_t>(memoryUsed_, cell.dataSize);
+        cell.actors.clear();
+        cell.actors.shrink_to_fit();
+    }
     
-    // Process loads
-    while (!loadQueue_.empty() && loadsThisFrame < config_.maxLoadsPerFrame) {
-        StreamingRequest req = loadQueue_.top();
-        loadQueue_.pop();
-        
-        // Find cell
-        for (auto& [hash, cell] : cells_) {
-            if (cell.id == req.cellId && cell.state == WorldCell::State::Unloaded) {
-                if (loadCell(cell)) {
-                    loadsThisFrame++;
+    if (cell.wasPrefetched) {
+        wastedPrefetches_++;
+        cell.wasPrefetched = false;
+    }
+    
+    cell.state = WorldCell::State::Unloaded;
+    cell.loadTicket++;
+    activeCells_.erase(cell.id);
+    
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    if (queuedTickets_.erase(cell.id) > 0) {
+        queuedLoadBytes_ -= std::min(queuedLoadBytes_, cell.dataSize);
+    }
+}
+
+void LevelStreaming::recordRead(uint64_t bytes, float milliseconds) {
+    uint32_t threads = config_.useAsyncLoading ? std::max(config_.streamingThreads, 1u) : 1u;
+    float throughput = static_cast<float>(bytes) / std::max(milliseconds, 0.001f) * 1000.0f * threads;
+    
+    // Moving averages; the first read seeds them
+    auto blend = [](std::atomic<float>& average, float value) {
+        float current = average.load();
+        average.store(current > 0.0f ? current * 0.9f + value * 0.1f : value);
+    };
+    blend(ioThroughput_, throughput);
+    blend(ioReadTime_, milliseconds);
+    blend(ioReadBytes_, static_cast<float>(bytes));
+}
+
+float LevelStreaming::computeLookahead(float speed, uint64_t backlogBytes) const {
+    float throughput = ioThroughput_.load();
+    if (throughput <= 0.0f) return config_.prefetchMaxLookahead;  // Nothing measured yet
+    
+    // A source crossing cells at this speed needs a new row of cells across
+    // its streaming diameter each time, which eats into the throughput left
+    // for getting ahead. The lookahead has to cover the backlog, one more
+    // read, and the data the path adds while those are fetched:
+    //   T = (readTime + backlog / throughput) / (1 - demand / throughput)
+    float rowCells = 2.0f * config_.streamingDistance / config_.cellSize;
+    float demand = speed / config_.cellSize * rowCells * ioReadBytes_.load();
+    if (demand >= throughput) return config_.prefetchMaxLookahead;
+    
+    float fetchTime = ioReadTime_.load() / 1000.0f + static_cast<float>(backlogBytes) / throughput;
+    float lookahead = config_.prefetchSafetyFactor * fetchTime / (1.0f - demand / throughput);
+    return std::clamp(lookahead, config_.prefetchMinLookahead, config_.prefetchMaxLookahead);
+}
+
+void LevelStreaming::samplePathAlongSpline(const StreamingSpline& spline, float t, float direction,
+                                           float startDistance, float endDistance, float speed,
+                                           std::vector<PrefetchSample>& outSamples) const {
+    if (spline.cachedLength <= 0.0f || speed <= 0.0f || endDistance <= startDistance) return;
+    
+    float step = config_.cellSize * 0.5f;
+    uint32_t steps = std::min(static_cast<uint32_t>(std::ceil((endDistance - startDistance) / step)), 256u);
+    for (uint32_t i = 0; i <= steps; ++i) {
+        float travelled = std::min(startDistance + i * step, endDistance);
+        float sampleT = t + direction * travelled / spline.cachedLength;
+        if (spline.isClosed) {
+            sampleT -= std::floor(sampleT);
+        } else if (sampleT < 0.0f || sampleT > 1.0f) {
+            break;  // Runs off the end of the track
+        }
+        
+        PrefetchSample sample;
+        sample.position = evaluateSpline(spline, sampleT);
+        sample.timeToArrival = travelled / speed;
+        sample.radius = std::max(getSplineStreamingDistance(spline, sampleT), spline.width * 0.5f);
+        outSamples.push_back(sample);
+    }
+}
+
+void LevelStreaming::updatePrefetchPlan(float deltaTime) {
+    prefetchPass_++;
+    prefetchPlan_.clear();
+    lastLookahead_ = 0.0f;
+    
+    uint64_t backlogBytes;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        backlogBytes = queuedLoadBytes_;
+    }
+    
+    std::vector<PrefetchSample> samples;
+    auto planPath = [&](int32_t sourcePriority) {
+        for (const PrefetchSample& sample : samples) {
+            glm::ivec2 center = worldToCell(sample.position);
+            int cellRadius = static_cast<int>(std::ceil(sample.radius / config_.cellSize));
+            
+            for (int y = center.y - cellRadius; y <= center.y + cellRadius; ++y) {
+                for (int x = center.x - cellRadius; x <= center.x + cellRadius; ++x) {
+                    auto it = cells_.find(cellHash({x, y}));
+                    if (it == cells_.end()) continue;
+                    
+                    WorldCell& cell = it->second;
+                    glm::vec3 cellCenter = cellToWorld(cell.gridCoord);
+                    if (glm::distance(glm::vec2(cellCenter.x, cellCenter.z),
+                                      glm::vec2(sample.position.x, sample.position.z)) > sample.radius) {
+                        continue;
+                    }
+                    
+                    // Sooner is more urgent; all of it ranks below cells a
+                    // source is already within streaming distance of
+                    PrefetchRequest request;
+                    request.kind = PrefetchKind::Cell;
+                    request.resourceId = cell.id;
+                    request.index = 0;
+                    request.timeToArrival = sample.timeToArrival;
+                    request.priority = sourcePriority * 1000.0f + 500.0f / (1.0f + sample.timeToArrival);
+                    
+                    auto [planned, inserted] = prefetchPlan_.emplace(cell.id, request);
+                    if (!inserted && request.priority > planned->second.priority) {
+                        planned->second = request;
+                    }
+                    cell.prefetchPass = prefetchPass_;
                 }
-                break;
             }
         }
-    }
+    };
     
-    // Process unloads
-    while (!unloadQueue_.empty()) {
-        StreamingRequest req = unloadQueue_.top();
-        unloadQueue_.pop();
+    // Free sources follow their velocity curve: current velocity plus the
+    // measured acceleration, held for a short horizon so turns and braking
+    // show up without extrapolating them forever
+    for (auto& [id, source] : sources_) {
+        if (deltaTime > 0.0f) {
+            glm::vec3 acceleration = (source.velocity - source.lastVelocity) / deltaTime;
+            source.acceleration = glm::mix(source.acceleration, acceleration, 0.2f);
+        }
+        source.lastVelocity = source.velocity;
         
-        // Find cell
-        for (auto& [hash, cell] : cells_) {
-            if (cell.id == req.cellId && cell.state == WorldCell::State::Loaded) {
-                unloadCell(cell);
-                break;
+        float speed = glm::length(source.velocity);
+        if (!source.isActive || speed < 1.0f) continue;
+        
+        // The lookahead starts where ordinary streaming stops seeing
+        float lookahead = computeLookahead(speed, backlogBytes);
+        float demandTime = source.useVelocityPrediction ? VELOCITY_PREDICTION_TIME : 0.0f;
+        samples.clear();
+        
+        auto spline = streamingSplines_.find(source.lockedSplineId);
+        if (source.lockedSplineId != 0 && spline != streamingSplines_.end() && spline->second.isEnabled) {
+            const StreamingSpline& path = spline->second;
+            float t = findClosestPointOnSpline(path, source.position);
+            float direction = glm::dot(source.velocity, evaluateSplineTangent(path.id, t)) < 0.0f ? -1.0f : 1.0f;
+            
+            lookahead = std::max(lookahead, path.lookAheadTime);
+            float distance = std::max(speed * (demandTime + lookahead), path.lookAheadDistance);
+            samplePathAlongSpline(path, t, direction, speed * demandTime, distance, speed, samples);
+        } else if (source.useVelocityPrediction) {
+            float step = std::min(config_.cellSize * 0.5f / speed, lookahead);
+            float horizon = config_.prefetchAccelerationHorizon;
+            float endTime = demandTime + lookahead;
+            for (float time = demandTime; time <= endTime && samples.size() < 256; time += step) {
+                float accelTime = std::min(time, horizon);
+                glm::vec3 offset = source.velocity * time +
+                                   source.acceleration * (0.5f * accelTime * accelTime + accelTime * (time - accelTime));
+                samples.push_back({source.position + offset, time, config_.streamingDistance});
             }
         }
+        
+        lastLookahead_ = std::max(lastLookahead_, lookahead);
+        planPath(source.priority);
+    }
+    
+    // Spline sources move along their spline at velocity (parameter per second)
+    for (const auto& [id, source] : splineStreamingSources_) {
+        auto spline = streamingSplines_.find(source.splineId);
+        if (!source.isActive || spline == streamingSplines_.end() || !spline->second.isEnabled) continue;
+        
+        const StreamingSpline& path = spline->second;
+        float speed = std::abs(source.velocity) * path.cachedLength;
+        if (speed < 1.0f) continue;
+        
+        float lookahead = std::max(computeLookahead(speed, backlogBytes), path.lookAheadTime);
+        float distance = std::max(speed * lookahead, path.lookAheadDistance);
+        
+        samples.clear();
+        samplePathAlongSpline(path, source.position, source.velocity < 0.0f ? -1.0f : 1.0f, 0.0f, distance, speed,
+                              samples);
+        
+        lastLookahead_ = std::max(lastLookahead_, lookahead);
+        planPath(0);
     }
 }
 
-void LevelStreaming::streamingThreadFunc() {
-    while (!shutdownRequested_) {
-        StreamingRequest req;
-        bool hasRequest = false;
+void LevelStreaming::issuePrefetches() {
+    // Cells, and the pages and mips their actors use, through one queue
+    prefetchQueue_ = {};
+    std::unordered_map<uint64_t, PrefetchRequest> resources[3];
+    
+    for (const auto& [cellId, request] : prefetchPlan_) {
+        WorldCell* cell = findCell(cellId);
+        if (!cell) continue;
         
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
+        if (cell->state == WorldCell::State::Unloaded && cell->loadPriority >= 0.0f) {
+            prefetchQueue_.push(request);
+        }
+        
+        for (const CellResourceRef& ref : cell->resources) {
+            PrefetchRequest resource = request;
+            resource.kind = ref.kind;
+            resource.resourceId = ref.resourceId;
+            resource.index = ref.index;
             
-            if (!loadQueue_.empty()) {
-                req = loadQueue_.top();
-                loadQueue_.pop();
-                hasRequest = true;
+            uint64_t key = (static_cast<uint64_t>(ref.resourceId) << 32) | ref.index;
+            auto [it, inserted] = resources[static_cast<size_t>(ref.kind)].emplace(key, resource);
+            if (!inserted && resource.priority > it->second.priority) {
+                it->second = resource;
             }
         }
+    }
+    for (auto& byKey : resources) {
+        for (const auto& [key, request] : byKey) {
+            prefetchQueue_.push(request);
+        }
+    }
+    
+    size_t queuedLoads;
+    uint64_t queuedBytes;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queuedLoads = queuedTickets_.size();
+        queuedBytes = queuedLoadBytes_;
+    }
+    
+    uint32_t issued = 0;
+    while (!prefetchQueue_.empty() && issued < config_.maxPrefetchRequestsPerFrame) {
+        PrefetchRequest request = prefetchQueue_.top();
+        prefetchQueue_.pop();
         
-        if (!hasRequest) {
-            std::unique_lock<std::mutex> lock(streamingMutex_);
-            streamingCondition_.wait_for(lock, std::chrono::milliseconds(100));
+        if (request.kind == PrefetchKind::Cell) {
+            // Leave the streaming threads room for what's needed now, and
+            // the memory budget room for what's loaded
+            WorldCell* cell = findCell(request.resourceId);
+            if (queuedLoads >= config_.maxConcurrentLoads ||
+                memoryUsed_.load() + queuedBytes + cell->dataSize > config_.streamingBudget) {
+                continue;
+            }
+            
+            queueCellLoad(*cell, request.priority);
+            cell->wasPrefetched = true;
+            queuedLoads++;
+            queuedBytes += cell->dataSize;
+            prefetchedCells_++;
+            issued++;
             continue;
         }
         
-        // Mark as actively loading
-        {
-            std::lock_guard<std::mutex> lock(activeLoadsMutex_);
-            if (activeLoads_.count(req.cellId) > 0) {
-                continue;  // Already being loaded
+        size_t kind = static_cast<size_t>(request.kind);
+        if (!prefetchHandlers_[kind]) continue;
+        
+        uint64_t key = (static_cast<uint64_t>(request.resourceId) << 32) | request.index;
+        auto [it, inserted] = issuedPrefetches_[kind].emplace(key, currentFrame_);
+        if (!inserted) {
+            if (currentFrame_ - it->second < config_.prefetchReissueFrames) continue;
+            it->second = currentFrame_;
+        }
+        
+        prefetchHandlers_[kind](request);
+        (request.kind == PrefetchKind::NanitePage ? pageRequests_ : mipRequests_)++;
+        issued++;
+    }
+    
+    // Forget requests old enough to be sent again anyway
+    for (auto& issuedByKey : issuedPrefetches_) {
+        if (issuedByKey.size() < 4096) continue;
+        for (auto it = issuedByKey.begin(); it != issuedByKey.end();) {
+            if (currentFrame_ - it->second >= config_.prefetchReissueFrames) {
+                it = issuedByKey.erase(it);
+            } else {
+                ++it;
             }
-            activeLoads_.insert(req.cellId);
+        }
+    }
+}
+
+void LevelStreaming::processStreamingQueue() {
+    uint32_t loadsThisFrame = 0;
+    
+    // Process loads
+    while (loadsThisFrame < config_.maxLoadsPerFrame) {
+        StreamingRequest req;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            if (loadQueue_.empty()) break;
+            req = loadQueue_.top();
+            loadQueue_.pop();
         }
         
-        // Find and load cell
-        auto startTime = std::chrono::high_resolution_clock::now();
+        WorldCell* cell = findCell(req.cellId);
+        if (cell && cell->loadTicket == req.ticket && loadCell(*cell)) {
+            loadsThisFrame++;
+        }
+    }
+    
+    processUnloads();
+}
+
+void LevelStreaming::processUnloads() {
+    while (true) {
+        StreamingRequest req;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            if (unloadQueue_.empty()) break;
+            req = unloadQueue_.top();
+            unloadQueue_.pop();
+        }
         
-        for (auto& [hash, cell] : cells_) {
-            if (cell.id == req.cellId) {
-                if (req.isLoad && cell.state == WorldCell::State::Unloaded) {
-                    loadCell(cell);
-                } else if (!req.isLoad && cell.state == WorldCell::State::Loaded) {
-                    unloadCell(cell);
-                }
-                break;
-            }
+        WorldCell* cell = findCell(req.cellId);
+        if (cell && cell->state == WorldCell::State::Unloading) {
+            unloadCell(*cell);
+        }
+    }
+}
+
+void LevelStreaming::streamingThreadFunc() {
+    while (true) {
+        StreamingRequest req;
+        std::string worldPath;
+        
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            streamingCondition_.wait(lock, [this] {
+                return shutdownRequested_ || !loadQueue_.empty();
+            });
+            if (shutdownRequested_) return;
+            
+            req = loadQueue_.top();
+            loadQueue_.pop();
+            
+            // Cancelled or requeued since
+            auto it = queuedTickets_.find(req.cellId);
+            if (it == queuedTickets_.end() || it->second != req.ticket) continue;
+            queuedTickets_.erase(it);
+            queuedLoadBytes_ -= std::min(queuedLoadBytes_, req.dataSize);
+            
+            worldPath = worldPath_;
         }
         
+        // Read and deserialize; everything touching the world waits for
+        // the main thread
+        auto startTime = std::chrono::high_resolution_clock::now();
+        
+        CellLoadResult result;
+        result.cellId = req.cellId;
+        result.ticket = req.ticket;
+        result.success = req.dataSize == 0 ||
+                         readCellActors(worldPath, req.dataOffset, req.dataSize, result.actors);
+        
         auto endTime = std::chrono::high_resolution_clock::now();
         float loadTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
         
+        if (req.dataSize > 0 && result.success) {
+            recordRead(req.dataSize, loadTime);
+        }
+        
         // Update statistics
         uint32_t count = loadCount_.fetch_add(1) + 1;
         float avg = averageLoadTime_.load();
         averageLoadTime_.store((avg * (count - 1) + loadTime) / count);
         
-        // Remove from active loads
-        {
-            std::lock_guard<std::mutex> lock(activeLoadsMutex_);
-            activeLoads_.erase(req.cellId);
+        std::lock_guard<std::mutex> lock(completedMutex_);
+        completedLoads_.push_back(std::move(result));
+    }
+}
+
+void LevelStreaming::activatePendingCells() {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    std::vector<CellLoadResult> completed;
+    {
+        std::lock_guard<std::mutex> lock(completedMutex_);
+        completed.swap(completedLoads_);
+    }
+    
+    for (CellLoadResult& result : completed) {
+        WorldCell* cell = findCell(result.cellId);
+        if (!cell || cell->loadTicket != result.ticket || cell->state != WorldCell::State::Loading) {
+            continue;  // Cancelled while reading
+        }
+        
+        if (!result.success) {
+            // Back to unloaded; the next priority update retries it
+            cell->state = WorldCell::State::Unloaded;
+            activeCells_.erase(cell->id);
+            continue;
+        }
+        
+        if (cell->dataSize > 0 && !result.actors.empty()) {
+            cell->actors = std::move(result.actors);
+            memoryUsed_ += cell->dataSize;
         }
+        pendingActivations_.push_back({cell->id, cell->loadTicket, 0});
     }
+    
+    // Activate actors until the budget runs out, always making some progress
+    auto elapsedMs = [&] {
+        return std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+    };
+    
+    bool activatedAny = false;
+    while (!pendingActivations_.empty()) {
+        PendingActivation& pending = pendingActivations_.front();
+        WorldCell* cell = findCell(pending.cellId);
+        if (!cell || cell->loadTicket != pending.ticket || cell->state != WorldCell::State::Loading) {
+            pendingActivations_.pop_front();
+            continue;
+        }
+        
+        while (pending.nextActor < cell->actors.size()) {
+            if (activatedAny && elapsedMs() >= config_.activationBudgetMs) {
+                lastActivationTime_ = elapsedMs();
+                return;
+            }
+            activateCellActor(cell->actors[pending.nextActor++]);
+            activatedAny = true;
+        }
+        
+        finishCellLoad(*cell);
+        pendingActivations_.pop_front();
+    }
+    
+    lastActivationTime_ = elapsedMs();
 }
 
 bool LevelStreaming::loadCell(WorldCell& cell) {
-    if (cell.state != WorldCell::State::Unloaded) {
+    if (cell.state == WorldCell::State::Loaded || cell.state == WorldCell::State::Unloading) {
         return false;
     }
     
-    cell.state = WorldCell::State::Loading;
+    // Takes over from any asynchronous load in flight
+    if (cell.state == WorldCell::State::Unloaded) {
+        cell.state = WorldCell::State::Loading;
+        activeCells_.insert(cell.id);
+    }
+    cell.loadTicket++;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (queuedTickets_.erase(cell.id) > 0) {
+            queuedLoadBytes_ -= std::min(queuedLoadBytes_, cell.dataSize);
+        }
+    }
+    
+    // Actors already read if it was partway through activation
+    if (cell.dataSize > 0 && cell.actors.empty()) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        if (!readCellActors(worldPath_, cell.dataOffset, cell.dataSize, cell.actors)) {
+            cell.state = WorldCell::State::Unloaded;
+            activeCells_.erase(cell.id);
+            return false;
+        }
+        recordRead(cell.dataSize, std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count());
+        if (!cell.actors.empty()) memoryUsed_ += cell.dataSize;
+    }
     
     // Load actors
     loadCellActors(cell);
+    finishCellLoad(cell);
     
+    return true;
+}
+
+void LevelStreaming::finishCellLoad(WorldCell& cell) {
     cell.state = WorldCell::State::Loaded;
     cell.lastAccessFrame = currentFrame_;
     
@@ -404,12 +1129,10 @@ bool LevelStreaming::loadCell(WorldCell& cell) {
     if (onCellLoaded_) {
         onCellLoaded_(cell.id);
     }
-    
-    return true;
 }
 
 bool LevelStreaming::unloadCell(WorldCell& cell) {
-    if (cell.state != WorldCell::State::Loaded) {
+    if (cell.state != WorldCell::State::Loaded && cell.state != WorldCell::State::Unloading) {
         return false;
     }
     
@@ -418,7 +1141,20 @@ bool LevelStreaming::unloadCell(WorldCell& cell) {
     // Unload actors
     unloadCellActors(cell);
     
+    // Streamed cells give their actors back until the next load
+    if (cell.dataSize > 0 && !cell.actors.empty()) {
+        memoryUsed_ -= std::min<uint64_t>(memoryUsed_, cell.dataSize);
+        cell.actors.clear();
+        cell.actors.shrink_to_fit();
+    }
+    
+    if (cell.wasPrefetched) {
+        wastedPrefetches_++;
+        cell.wasPrefetched = false;
+    }
+    
     cell.state = WorldCell::State::Unloaded;
+    activeCells_.erase(cell.id);
     
     // Fire callback
     if (onCellUnloaded_) {
@@ -428,24 +1164,69 @@ bool LevelStreaming::unloadCell(WorldCell& cell) {
     return true;
 }
 
-void LevelStreaming::loadCellActors(WorldCell& cell) {
-    for (auto& actor : cell.actors) {
-        if (actor.isLoaded) continue;
-        
-        // Load mesh
-        // In production, this would load from asset system
-        // actor.meshId = assetSystem->loadMesh(actor.typeName);
+bool LevelStreaming::readCellActors(const std::string& worldPath, uint64_t offset, uint64_t size,
+                                    std::vector<CellActor>& outActors) {
+    std::ifstream file(worldPath, std::ios::binary);
+    if (!file.is_open()) return false;
+    
+    std::vector<char> data(size);
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(data.data(), static_cast<std::streamsize>(size));
+    if (!file) return false;
+    
+    const char* ptr = data.data();
+    const char* end = ptr + size;
+    auto read = [&](void* dst, size_t bytes) {
+        if (static_cast<size_t>(end - ptr) < bytes) return false;
+        std::memcpy(dst, ptr, bytes);
+        ptr += bytes;
+        return true;
+    };
+    
+    uint32_t actorCount;
+    if (!read(&actorCount, sizeof(actorCount))) return false;
+    
+    std::vector<CellActor> actors(actorCount);
+    for (CellActor& actor : actors) {
+        uint32_t nameLen;
+        if (!read(&nameLen, sizeof(nameLen)) || static_cast<size_t>(end - ptr) < nameLen) return false;
+        actor.typeName.assign(ptr, nameLen);
+        ptr += nameLen;
         
-        // Create physics body if needed
-        if (physics_ && actor.meshId != 0) {
-            // Create static collision
-            // actor.physicsBodyId = physics_->createStaticBody(...);
+        if (!read(&actor.transform, sizeof(actor.transform)) ||
+            !read(&actor.boundsMin, sizeof(actor.boundsMin)) ||
+            !read(&actor.boundsMax, sizeof(actor.boundsMax))) {
+            return false;
         }
-        
-        actor.isLoaded = true;
+        actor.isLoaded = false;
+    }
+    
+    outActors = std::move(actors);
+    return true;
+}
+
+void LevelStreaming::loadCellActors(WorldCell& cell) {
+    for (auto& actor : cell.actors) {
+        activateCellActor(actor);
     }
 }
 
+void LevelStreaming::activateCellActor(CellActor& actor) {
+    if (actor.isLoaded) return;
+    
+    // Load mesh
+    // In production, this would load from asset system
+    // actor.meshId = assetSystem->loadMesh(actor.typeName);
+    
+    // Create physics body if needed
+    if (physics_ && actor.meshId != 0) {
+        // Create static collision
+        // actor.physicsBodyId = physics_->createStaticBody(...);
+    }
+    
+    actor.isLoaded = true;
+}
+
 void LevelStreaming::unloadCellActors(WorldCell& cell) {
     for (auto& actor : cell.actors) {
         if (!actor.isLoaded) continue;
@@ -465,20 +1246,21 @@ void LevelStreaming::unloadCellActors(WorldCell& cell) {
 }
 
 void LevelStreaming::updateHLODVisibility() {
-    for (auto& [hash, cell] : cells_) {
+    // Only cells the priority update visited can have changed distance
+    for (WorldCell* cell : passCells_) {
         // Determine which HLOD level to show
         uint32_t targetHLOD = 0;
         
         for (size_t i = 0; i < config_.hlodLevels.size(); ++i) {
-            if (cell.distanceToSource >= config_.hlodLevels[i].distance) {
+            if (cell->distanceToSource >= config_.hlodLevels[i].distance) {
                 targetHLOD = static_cast<uint32_t>(i + 1);
             }
         }
         
-        if (targetHLOD != cell.hlodLevel) {
+        if (targetHLOD != cell->hlodLevel) {
             // Switch HLOD level
             // In production, this would show/hide appropriate actors
-            cell.hlodLevel = targetHLOD;
+            cell->hlodLevel = targetHLOD;
         }
     }
 }
@@ -510,7 +1292,7 @@ void LevelStreaming::forceLoadRadius(const glm::vec3& position, float radius, bo
     glm::ivec2 centerCell = worldToCell(position);
     int cellRadius = static_cast<int>(std::ceil(radius / config_.cellSize));
     
-    std::vector<uint32_t> cellsToLoad;
+    std::vector<WorldCell*> cellsToLoad;
     
     for (int y = -cellRadius; y <= cellRadius; ++y) {
         for (int x = -cellRadius; x <= cellRadius; ++x) {
@@ -523,32 +1305,22 @@ void LevelStreaming::forceLoadRadius(const glm::vec3& position, float radius, bo
             }
             
             WorldCell& cell = getOrCreateCell(coord);
-            if (cell.state == WorldCell::State::Unloaded) {
-                cellsToLoad.push_back(cell.id);
+            if (cell.state == WorldCell::State::Unloaded ||
+                (waitForComplete && cell.state == WorldCell::State::Loading)) {
+                cellsToLoad.push_back(&cell);
             }
         }
     }
     
     if (waitForComplete) {
-        // Synchronous load
-        for (uint32_t cellId : cellsToLoad) {
-            for (auto& [hash, cell] : cells_) {
-                if (cell.id == cellId) {
-                    loadCell(cell);
-                    break;
-                }
-            }
+        // Synchronous load, taking over any asynchronous ones in flight
+        for (WorldCell* cell : cellsToLoad) {
+            loadCell(*cell);
         }
     } else {
         // Queue loads
-        std::lock_guard<std::mutex> lock(queueMutex_);
-        
-        for (uint32_t cellId : cellsToLoad) {
-            StreamingRequest req;
-            req.cellId = cellId;
-            req.priority = 10000.0f;  // High priority
-            req.isLoad = true;
-            loadQueue_.push(req);
+        for (WorldCell* cell : cellsToLoad) {
+            queueCellLoad(*cell, 10000.0f);  // High priority
         }
         
         streamingCondition_.notify_all();
@@ -557,7 +1329,9 @@ void LevelStreaming::forceLoadRadius(const glm::vec3& position, float radius, bo
 
 void LevelStreaming::forceUnloadAll() {
     for (auto& [hash, cell] : cells_) {
-        if (cell.state == WorldCell::State::Loaded) {
+        if (cell.state == WorldCell::State::Loading) {
+            cancelCellLoad(cell);
+        } else if (cell.state != WorldCell::State::Unloaded) {
             unloadCell(cell);
         }
     }
@@ -602,6 +1376,45 @@ bool LevelStreaming::loadWorld(const std::string& worldPath) {
     uint32_t cellCount;
     file.read(reinterpret_cast<char*>(&cellCount), sizeof(cellCount));
     
+    if (version >= 2) {
+        // Only the cell table; the streaming threads read each cell's actors
+        // when it loads
+        for (uint32_t i = 0; i < cellCount; ++i) {
+            glm::ivec2 coord;
+            uint64_t offset, size;
+            file.read(reinterpret_cast<char*>(&coord), sizeof(coord));
+            file.read(reinterpret_cast<char*>(&offset), sizeof(offset));
+            file.read(reinterpret_cast<char*>(&size), sizeof(size));
+            if (!file) return false;
+            
+            WorldCell& cell = getOrCreateCell(coord);
+            cell.dataOffset = offset;
+            cell.dataSize = size;
+            
+            // Resources are in the table so they can be prefetched before
+            // the cell itself is read
+            if (version >= 3) {
+                uint32_t resourceCount;
+                file.read(reinterpret_cast<char*>(&resourceCount), sizeof(resourceCount));
+                if (!file) return false;
+                
+                cell.resources.resize(resourceCount);
+                for (CellResourceRef& resource : cell.resources) {
+                    uint32_t kind;
+                    file.read(reinterpret_cast<char*>(&kind), sizeof(kind));
+                    file.read(reinterpret_cast<char*>(&resource.resourceId), sizeof(resource.resourceId));
+                    file.read(reinterpret_cast<char*>(&resource.index), sizeof(resource.index));
+                    resource.kind = static_cast<PrefetchKind>(kind);
+                }
+                if (!file) return false;
+            }
+        }
+        
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        worldPath_ = worldPath;
+        return true;
+    }
+    
     for (uint32_t i = 0; i < cellCount; ++i) {
         glm::ivec2 coord;
         file.read(reinterpret_cast<char*>(&coord), sizeof(coord));
@@ -636,32 +1449,96 @@ bool LevelStreaming::loadWorld(const std::string& worldPath) {
 }
 
 bool LevelStreaming::saveWorld(const std::string& worldPath) {
+    // Cell payloads first: streamed cells that aren't resident are read back
+    // from the current world file, which may be the one being overwritten
+    std::vector<const WorldCell*> cells;
+    std::vector<std::vector<char>> payloads;
+    cells.reserve(cells_.size());
+    payloads.reserve(cells_.size());
+    
+    for (const auto& [hash, cell] : cells_) {
+        std::vector<CellActor> streamed;
+        const std::vector<CellActor>* actors = &cell.actors;
+        if (cell.dataSize > 0 && cell.actors.empty()) {
+            if (!readCellActors(worldPath_, cell.dataOffset, cell.dataSize, streamed)) return false;
+            actors = &streamed;
+        }
+        
+        std::vector<char> payload;
+        auto write = [&payload](const void* src, size_t bytes) {
+            const char* data = static_cast<const char*>(src);
+            payload.insert(payload.end(), data, data + bytes);
+        };
+        
+        uint32_t actorCount = static_cast<uint32_t>(actors->size());
+        write(&actorCount, sizeof(actorCount));
+        
+        for (const auto& actor : *actors) {
+            uint32_t nameLen = static_cast<uint32_t>(actor.typeName.size());
+            write(&nameLen, sizeof(nameLen));
+            write(actor.typeName.data(), nameLen);
+            
+            write(&actor.transform, sizeof(actor.transform));
+            write(&actor.boundsMin, sizeof(actor.boundsMin));
+            write(&actor.boundsMax, sizeof(actor.boundsMax));
+        }
+        
+        cells.push_back(&cell);
+        payloads.push_back(std::move(payload));
+    }
+    
     std::ofstream file(worldPath, std::ios::binary);
     if (!file.is_open()) return false;
     
     // Write header
     file.write("WLVL", 4);
-    uint32_t version = 1;
+    uint32_t version = 3;
     file.write(reinterpret_cast<const char*>(&version), sizeof(version));
     
-    // Write cells
-    uint32_t cellCount = static_cast<uint32_t>(cells_.size());
+    // Write cell table: coordinate, offset and size of its actors, then the
+    // resources they use
+    uint32_t cellCount = static_cast<uint32_t>(cells.size());
     file.write(reinterpret_cast<const char*>(&cellCount), sizeof(cellCount));
     
-    for (const auto& [hash, cell] : cells_) {
-        file.write(reinterpret_cast<const char*>(&cell.gridCoord), sizeof(cell.gridCoord));
-        
-        uint32_t actorCount = static_cast<uint32_t>(cell.actors.size());
-        file.write(reinterpret_cast<const char*>(&actorCount), sizeof(actorCount));
+    const size_t resourceSize = 3 * sizeof(uint32_t);
+    uint64_t offset = 4 + sizeof(version) + sizeof(cellCount);
+    for (const WorldCell* cell : cells) {
+        offset += sizeof(glm::ivec2) + 2 * sizeof(uint64_t) + sizeof(uint32_t) + cell->resources.size() * resourceSize;
+    }
+    std::vector<uint64_t> offsets(cells.size());
+    
+    for (size_t i = 0; i < cells.size(); ++i) {
+        uint64_t size = payloads[i].size();
+        offsets[i] = offset;
+        file.write(reinterpret_cast<const char*>(&cells[i]->gridCoord), sizeof(cells[i]->gridCoord));
+        file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        offset += size;
         
-        for (const auto& actor : cell.actors) {
-            uint32_t nameLen = static_cast<uint32_t>(actor.typeName.size());
-            file.write(reinterpret_cast<const char*>(&nameLen), sizeof(nameLen));
-            file.write(actor.typeName.data(), nameLen);
-            
-            file.write(reinterpret_cast<const char*>(&actor.transform), sizeof(actor.transform));
-            file.write(reinterpret_cast<const char*>(&actor.boundsMin), sizeof(actor.boundsMin));
-            file.write(reinterpret_cast<const char*>(&actor.boundsMax), sizeof(actor.boundsMax));
+        uint32_t resourceCount = static_cast<uint32_t>(cells[i]->resources.size());
+        file.write(reinterpret_cast<const char*>(&resourceCount), sizeof(resourceCount));
+        for (const CellResourceRef& resource : cells[i]->resources) {
+            uint32_t kind = static_cast<uint32_t>(resource.kind);
+            file.write(reinterpret_cast<const char*>(&kind), sizeof(kind));
+            file.write(reinterpret_cast<const char*>(&resource.resourceId), sizeof(resource.resourceId));
+            file.write(reinterpret_cast<const char*>(&resource.index), sizeof(resource.index));
+        }
+    }
+    
+    for (const auto& payload : payloads) {
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    }
+    if (!file.good()) return false;
+    
+    // Streamed cells now live at new offsets in the rewritten file
+    if (worldPath == worldPath_) {
+        file.close();
+        for (size_t i = 0; i < cells.size(); ++i) {
+            WorldCell* cell = findCell(cells[i]->id);
+            if (cell->dataSize > 0) {
+                cell->dataOffset = offsets[i];
+                cell->dataSize = payloads[i].size();
+            }
         }
     }
     
@@ -674,9 +1551,11 @@ LevelStreaming::Statistics LevelStreaming::getStatistics() const {
     stats.memoryUsed = memoryUsed_.load();
     stats.memoryBudget = config_.streamingBudget;
     stats.averageLoadTime = averageLoadTime_.load();
+    stats.activationTime = lastActivationTime_;
+    stats.pendingActivations = static_cast<uint32_t>(pendingActivations_.size());
     
-    for (const auto& [hash, cell] : cells_) {
-        switch (cell.state) {
+    for (uint32_t cellId : activeCells_) {
+        switch (cellsById_[cellId]->state) {
             case WorldCell::State::Loaded:
                 stats.loadedCells++;
                 break;
@@ -701,6 +1580,23 @@ LevelStreaming::Statistics LevelStreaming::getStatistics() const {
     return stats;
 }
 
+LevelStreaming::PrefetchStatistics LevelStreaming::getPrefetchStatistics() const {
+    PrefetchStatistics stats = {};
+    stats.demandedCells = demandedCells_;
+    stats.residentOnDemand = residentOnDemand_;
+    stats.hitRate = demandedCells_ > 0 ? static_cast<float>(residentOnDemand_) / demandedCells_ : 0.0f;
+    stats.prefetchedCells = prefetchedCells_;
+    stats.usefulPrefetches = usefulPrefetches_;
+    stats.wastedPrefetches = wastedPrefetches_;
+    stats.nanitePageRequests = pageRequests_;
+    stats.textureMipRequests = mipRequests_;
+    stats.plannedCells = static_cast<uint32_t>(prefetchPlan_.size());
+    stats.lookaheadTime = lastLookahead_;
+    stats.ioThroughput = ioThroughput_.load();
+    stats.ioReadTime = ioReadTime_.load();
+    return stats;
+}
+
 void LevelStreaming::debugDraw(VkCommandBuffer cmd, const glm::mat4& viewProj) {
     // Draw debug visualization of streaming grid
     // Color cells by state: gray = unloaded, green = loaded, yellow = loading
@@ -7,10 +7,13 @@
  * Key features:
  * - Spatial hash grid for world partition
  * - Distance-based streaming with priority
- * - Async loading with streaming pool
+ * - Async loading: file I/O and deserialization on the streaming threads,
+ *   activation on the main thread under a per-frame time budget
  * - HLOD for distant cells
  * - Data layers for content organization
  * - Streaming volumes for manual control
+ * - Predictive prefetch along each source's spline or velocity curve, with
+ *   lookahead sized from measured I/O throughput
  * 
  * Architecture:
  * - World divided into cells (default 128m x 128m)
@@ -28,6 +31,8 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
+#include <deque>
+#include <limits>
 #include <memory>
 #include <string>
 #include <functional>
@@ -70,6 +75,30 @@ struct StreamingSource {
     
     bool isActive = true;
     bool useVelocityPrediction = true;
+    
+    uint32_t lockedSplineId = 0;    // Streaming spline the source moves along (0 = free)
+    
+    // Estimated by the prefetch planner from velocity changes
+    glm::vec3 acceleration = glm::vec3(0.0f);
+    glm::vec3 lastVelocity = glm::vec3(0.0f);
+};
+
+/**
+ * Kind of data the prefetch planner requests
+ */
+enum class PrefetchKind : uint8_t {
+    Cell,           // World cell actors, loaded by LevelStreaming itself
+    NanitePage,     // Geometry page; resourceId is the Nanite resource
+    TextureMip      // Texture mip; resourceId is the streamed texture
+};
+
+/**
+ * Streamed resource a cell's actors use, prefetched with the cell
+ */
+struct CellResourceRef {
+    PrefetchKind kind;
+    uint32_t resourceId;
+    uint32_t index;                 // Page index or mip level
 };
 
 /**
@@ -103,6 +132,11 @@ struct WorldCell {
     std::vector<CellActor> actors;
     std::vector<uint32_t> dataLayers;   // Which layers this cell has content in
     
+    // Actor records in the world file; dataSize == 0 means actors are resident
+    uint64_t dataOffset = 0;
+    uint64_t dataSize = 0;
+    std::vector<CellResourceRef> resources;
+    
     // HLOD
     uint32_t hlodLevel = 0;         // 0 = full detail, 1+ = simplified
     uint32_t hlodActorId = 0;       // Merged/simplified actor for distance
@@ -117,8 +151,13 @@ struct WorldCell {
     State state = State::Unloaded;
     
     float loadPriority = 0.0f;
-    float distanceToSource = 0.0f;
+    float distanceToSource = std::numeric_limits<float>::max();
     uint64_t lastAccessFrame = 0;
+    uint32_t loadTicket = 0;        // Bumped per load request; stale results are dropped
+    uint64_t priorityPass = 0;      // Last priority update that visited this cell
+    uint64_t prefetchPass = 0;      // Last prefetch plan that included this cell
+    bool isDemanded = false;        // Within streaming distance of a source
+    bool wasPrefetched = false;     // Loaded by the planner, not yet demanded
     
     // Dependencies
     std::vector<uint32_t> dependsOn;    // Cells that must load first
@@ -240,12 +279,31 @@ struct StreamingRequest {
     uint32_t cellId;
     float priority;
     bool isLoad;                    // true = load, false = unload
+    uint32_t ticket = 0;            // WorldCell::loadTicket when queued
+    uint64_t dataOffset = 0;
+    uint64_t dataSize = 0;
     
     bool operator<(const StreamingRequest& other) const {
         return priority < other.priority;  // Lower priority = later in queue
     }
 };
 
+/**
+ * Request issued by the prefetch planner. Cells, Nanite pages and texture
+ * mips share one queue, ordered by when a source is expected to need them.
+ */
+struct PrefetchRequest {
+    PrefetchKind kind;
+    uint32_t resourceId;            // Cell id for cells
+    uint32_t index;                 // Page index or mip level
+    float priority;                 // Unbounded; prefetchPage takes it as urgency
+    float timeToArrival;            // Seconds until a source is expected to need it
+    
+    bool operator<(const PrefetchRequest& other) const {
+        return priority < other.priority;
+    }
+};
+
 /**
  * Level streaming configuration
  */
@@ -258,7 +316,8 @@ struct LevelStreamingConfig {
     float streamingDistance = 256.0f;
     float unloadDistance = 384.0f;  // Hysteresis
     uint32_t maxConcurrentLoads = 4;
-    uint32_t maxLoadsPerFrame = 2;
+    uint32_t maxLoadsPerFrame = 2;  // Synchronous loading only
+    float activationBudgetMs = 2.0f;    // Main-thread time per frame for activating loaded cells
     float loadTimeout = 30.0f;      // Seconds before giving up
     
     // Memory
@@ -275,6 +334,15 @@ struct LevelStreamingConfig {
     // Threading
     uint32_t streamingThreads = 2;
     bool useAsyncLoading = true;
+    
+    // Prefetch
+    bool enablePrefetch = true;
+    float prefetchMinLookahead = 1.0f;          // Seconds
+    float prefetchMaxLookahead = 10.0f;         // Also used until I/O has been measured
+    float prefetchSafetyFactor = 1.5f;          // Margin over the estimated fetch time
+    float prefetchAccelerationHorizon = 2.0f;   // Seconds acceleration is extrapolated for
+    uint32_t maxPrefetchRequestsPerFrame = 16;
+    uint32_t prefetchReissueFrames = 60;        // Before a page/mip is requested again
 };
 
 /**
@@ -282,6 +350,7 @@ struct LevelStreamingConfig {
  */
 using CellLoadedCallback = std::function<void(uint32_t cellId)>;
 using CellUnloadedCallback = std::function<void(uint32_t cellId)>;
+using PrefetchHandler = std::function<void(const PrefetchRequest& request)>;
 
 /**
  * World partition level streaming system
@@ -398,6 +467,18 @@ public:
      */
     void addActorToCell(glm::ivec2 cellCoord, const CellActor& actor);
     
+    /**
+     * Add a streamed resource the cell's actors use, so it's prefetched
+     * with the cell
+     */
+    void addCellResource(glm::ivec2 cellCoord, const CellResourceRef& resource);
+    
+    /**
+     * Set where prefetched Nanite pages and texture mips are sent, e.g.
+     * NaniteStreamingManager::prefetchPage and TextureStreamer::prefetchMip
+     */
+    void setPrefetchHandler(PrefetchKind kind, PrefetchHandler handler);
+    
     /**
      * Generate HLOD for cells
      */
@@ -442,12 +523,30 @@ public:
         uint32_t loadingCells;
         uint32_t pendingLoads;
         uint32_t pendingUnloads;
+        uint32_t pendingActivations;    // Read, waiting for main-thread activation
         uint64_t memoryUsed;
         uint64_t memoryBudget;
-        float averageLoadTime;
+        float averageLoadTime;          // I/O + deserialize, ms
+        float activationTime;           // Main thread, last frame, ms
     };
     Statistics getStatistics() const;
     
+    struct PrefetchStatistics {
+        uint64_t demandedCells;         // Cells that came within streaming distance
+        uint64_t residentOnDemand;      // ...and were already loaded
+        float hitRate;                  // residentOnDemand / demandedCells
+        uint64_t prefetchedCells;       // Cell loads issued by the planner
+        uint64_t usefulPrefetches;      // Prefetched cells later demanded
+        uint64_t wastedPrefetches;      // Prefetched cells dropped before demand
+        uint64_t nanitePageRequests;
+        uint64_t textureMipRequests;
+        uint32_t plannedCells;          // In the current plan
+        float lookaheadTime;            // Longest over sources, seconds
+        float ioThroughput;             // Bytes per second, all streaming threads
+        float ioReadTime;               // Average cell read, ms
+    };
+    PrefetchStatistics getPrefetchStatistics() const;
+    
     // Debug
     void debugDraw(VkCommandBuffer cmd, const glm::mat4& viewProj);
     
@@ -458,34 +557,69 @@ private:
     uint64_t cellHash(glm::ivec2 coord) const;
     
     WorldCell& getOrCreateCell(glm::ivec2 coord);
+    WorldCell* findCell(uint32_t cellId);
+    void visitCell(WorldCell& cell);
     
     void updateStreamingPriorities();
     void processStreamingQueue();
     void streamingThreadFunc();
     
+    void queueCellLoad(WorldCell& cell, float priority);
+    void cancelCellLoad(WorldCell& cell);
+    void activatePendingCells();
+    void processUnloads();
+    
     bool loadCell(WorldCell& cell);
     bool unloadCell(WorldCell& cell);
+    void finishCellLoad(WorldCell& cell);
     
+    static bool readCellActors(const std::string& worldPath, uint64_t offset, uint64_t size,
+                               std::vector<CellActor>& outActors);
     void loadCellActors(WorldCell& cell);
+    void activateCellActor(CellActor& actor);
     void unloadCellActors(WorldCell& cell);
     
     void updateHLODVisibility();
     
+    // Prefetch planner
+    struct PrefetchSample {
+        glm::vec3 position;
+        float timeToArrival;
+        float radius;
+    };
+    void updatePrefetchPlan(float deltaTime);
+    float computeLookahead(float speed, uint64_t backlogBytes) const;
+    void samplePathAlongSpline(const StreamingSpline& spline, float t, float direction,
+                               float startDistance, float endDistance, float speed,
+                               std::vector<PrefetchSample>& outSamples) const;
+    void issuePrefetches();
+    void recordRead(uint64_t bytes, float milliseconds);
+    
     // Spline helpers
     void resampleSpline(StreamingSpline& spline);
+    glm::vec3 evaluateSpline(const StreamingSpline& spline, float t) const;
     glm::vec3 evaluateCatmullRom(const std::vector<SplinePoint>& points, float t, bool closed) const;
-    glm::vec3 evaluateBezier(const std::vector<SplinePoint>& points, float t) const;
-    glm::vec3 evaluateHermite(const std::vector<SplinePoint>& points, float t) const;
+    glm::vec3 evaluateBezier(const std::vector<SplinePoint>& points, float t, bool closed) const;
+    glm::vec3 evaluateHermite(const std::vector<SplinePoint>& points, float t, bool closed) const;
+    float findClosestPointOnSpline(const StreamingSpline& spline, const glm::vec3& worldPos) const;
+    float getSplineStreamingDistance(const StreamingSpline& spline, float t) const;
     void updateSplineStreamingSources();
-    void collectCellsAlongSpline(const StreamingSpline& spline, float t, float lookAhead, 
-                                  std::vector<uint32_t>& outCells) const;
     
     VulkanContext* context_ = nullptr;
     AsyncPhysics* physics_ = nullptr;
     LevelStreamingConfig config_;
     
-    // Grid storage
+    // Grid storage. Keyed by grid coordinate, so the cells near a point are
+    // found by probing the coordinates around it
     std::unordered_map<uint64_t, WorldCell> cells_;
+    std::vector<WorldCell*> cellsById_;                 // Cell ids are dense
+    std::unordered_set<uint32_t> activeCells_;          // Not Unloaded
+    std::vector<WorldCell*> passCells_;                 // Visited by the current priority update
+    std::vector<uint32_t> visitedCells_;                // Near a source in the last priority update
+    uint64_t priorityPass_ = 0;
+    
+    // World file the streamed cells are read from
+    std::string worldPath_;
     
     // Streaming sources
     std::unordered_map<uint32_t, StreamingSource> sources_;
@@ -509,17 +643,54 @@ private:
     // Streaming queue
     std::priority_queue<StreamingRequest> loadQueue_;
     std::priority_queue<StreamingRequest> unloadQueue_;
+    std::unordered_map<uint32_t, uint32_t> queuedTickets_;  // Cell -> ticket still wanted
+    uint64_t queuedLoadBytes_ = 0;                          // World file bytes behind those
     std::mutex queueMutex_;
     
     // Streaming threads
     std::vector<std::thread> streamingThreads_;
     std::atomic<bool> shutdownRequested_{false};
     std::condition_variable streamingCondition_;
-    std::mutex streamingMutex_;
     
-    // Active loads tracking
-    std::unordered_set<uint32_t> activeLoads_;
-    std::mutex activeLoadsMutex_;
+    // Cells read by the streaming threads, activated on the main thread
+    struct CellLoadResult {
+        uint32_t cellId;
+        uint32_t ticket;
+        bool success;
+        std::vector<CellActor> actors;
+    };
+    std::vector<CellLoadResult> completedLoads_;
+    std::mutex completedMutex_;
+    
+    struct PendingActivation {
+        uint32_t cellId;
+        uint32_t ticket;
+        size_t nextActor;
+    };
+    std::deque<PendingActivation> pendingActivations_;
+    float lastActivationTime_ = 0.0f;
+    
+    // Prefetch plan: cell -> request, rebuilt every frame
+    std::unordered_map<uint32_t, PrefetchRequest> prefetchPlan_;
+    std::priority_queue<PrefetchRequest> prefetchQueue_;
+    uint64_t prefetchPass_ = 0;
+    PrefetchHandler prefetchHandlers_[3];
+    std::unordered_map<uint64_t, uint64_t> issuedPrefetches_[3];    // Key -> frame issued
+    float lastLookahead_ = 0.0f;
+    
+    // Measured by the streaming threads
+    std::atomic<float> ioThroughput_{0.0f};     // Bytes per second, all threads
+    std::atomic<float> ioReadTime_{0.0f};       // ms per cell read
+    std::atomic<float> ioReadBytes_{0.0f};      // Bytes per cell read
+    
+    // Prefetch telemetry
+    uint64_t demandedCells_ = 0;
+    uint64_t residentOnDemand_ = 0;
+    uint64_t prefetchedCells_ = 0;
+    uint64_t usefulPrefetches_ = 0;
+    uint64_t wastedPrefetches_ = 0;
+    uint64_t pageRequests_ = 0;
+    uint64_t mipRequests_ = 0;
     
     // Memory tracking
     std::atomic<uint64_t> memoryUsed_{0};
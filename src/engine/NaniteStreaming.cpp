@@ -5,6 +5,7 @@
  */
 
 #include "NaniteStreaming.h"
+#include "DataCompression.h"
 #include "VulkanContext.h"
 #include <fstream>
 #include <algorithm>
@@ -174,7 +175,7 @@ uint32_t NaniteStreamingManager::registerResource(const std::string& path) {
         return 0;
     }
     
-    // Read header (simplified - real implementation would have proper file format)
+    // Read header. AssetCooker writes this layout as <asset>.nanite.
     file.read(reinterpret_cast<char*>(&resource->numPages), sizeof(uint32_t));
     file.read(reinterpret_cast<char*>(&resource->numRootPages), sizeof(uint32_t));
     file.read(reinterpret_cast<char*>(&resource->numHierarchyNodes), sizeof(uint32_t));
@@ -193,6 +194,19 @@ uint32_t NaniteStreamingManager::registerResource(const std::string& path) {
     file.read(reinterpret_cast<char*>(resource->rootPageIndices.data()), 
               resource->numRootPages * sizeof(uint32_t));
     
+    // Optional trailer: page codec and uncompressed sizes. Files without
+    // it store every page raw.
+    uint32_t codec = 0;
+    resource->pageUncompressedSizes.resize(resource->numPages);
+    if (file.read(reinterpret_cast<char*>(&codec), sizeof(uint32_t)) &&
+        file.read(reinterpret_cast<char*>(resource->pageUncompressedSizes.data()),
+                  resource->numPages * sizeof(uint32_t))) {
+        resource->pageCodec = static_cast<Sanic::CompressionCodec>(codec);
+    } else {
+        resource->pageCodec = Sanic::CompressionCodec::None;
+        resource->pageUncompressedSizes = resource->pageSizes;
+    }
+    
     uint32_t id = resource->resourceId;
     resources[id] = std::move(resource);
     
@@ -275,6 +289,29 @@ void NaniteStreamingManager::endFrame(VkCommandBuffer cmd) {
     vkCmdUpdateBuffer(cmd, requestBuffer, 0, sizeof(FGPURequestHeader), &clearHeader);
 }
 
+bool NaniteStreamingManager::prefetchPage(uint32_t resourceId, uint32_t pageIndex, float urgency) {
+    FStreamingResource* resource = getResource(resourceId);
+    if (!resource || pageIndex >= resource->numPages) return false;
+    
+    FPageKey key;
+    key.resourceId = resourceId;
+    key.pageIndex = pageIndex;
+    
+    if (residentPages.count(key) > 0) return false;
+    if (requestedPages.count(key.toUint64()) > 0) return false;
+    
+    FPageRequest req;
+    req.key = key;
+    urgency = std::max(urgency, 0.0f);
+    req.priority = NaniteStreaming::PRIORITY_PREFETCH * urgency / (1.0f + urgency);
+    req.frameRequested = static_cast<uint32_t>(currentFrame);
+    req.screenPixels = 0;
+    
+    pendingRequests.push(req);
+    requestedPages.insert(key.toUint64());
+    return true;
+}
+
 void NaniteStreamingManager::processGPURequests() {
     // Read request header
     const FGPURequestHeader* header = static_cast<const FGPURequestHeader*>(requestReadbackMapped);
@@ -541,13 +578,33 @@ void NaniteStreamingManager::loadPageFromDisk(FPendingPage* page) {
     
     uint64_t offset = resource->pageOffsets[page->key.pageIndex];
     uint32_t size = resource->pageSizes[page->key.pageIndex];
+    uint32_t uncompressedSize = resource->pageUncompressedSizes[page->key.pageIndex];
     
-    page->cpuData.resize(size);
-    file.seekg(offset);
-    file.read(reinterpret_cast<char*>(page->cpuData.data()), size);
+    if (uncompressedSize > NaniteStreaming::STREAMING_PAGE_SIZE) {
+        page->state = EPageState::NotLoaded;
+        return;
+    }
     
-    // Decompress if needed (placeholder)
-    // DecompressPage(page->cpuData);
+    if (size == uncompressedSize || resource->pageCodec == Sanic::CompressionCodec::None) {
+        page->cpuData.resize(size);
+        file.seekg(offset);
+        file.read(reinterpret_cast<char*>(page->cpuData.data()), size);
+    } else {
+        // Decompress here on the I/O thread so the main thread only copies
+        // finished pages into staging memory
+        thread_local std::vector<uint8_t> compressed;
+        compressed.resize(size);
+        file.seekg(offset);
+        file.read(reinterpret_cast<char*>(compressed.data()), size);
+        
+        page->cpuData.resize(uncompressedSize);
+        if (!file || !Sanic::DataCompression::decompress(resource->pageCodec, compressed.data(), size,
+                                                         page->cpuData.data(), uncompressedSize)) {
+            page->cpuData.clear();
+            page->state = EPageState::NotLoaded;
+            return;
+        }
+    }
     
     // State is already Loading, will be processed by main thread
 }
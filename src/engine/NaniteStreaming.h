@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "SanicAssetFormat.h"
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
 #include <vector>
@@ -175,6 +176,8 @@ public:
     uint32_t numPages;
     std::vector<uint64_t> pageOffsets;  // File offsets for each page
     std::vector<uint32_t> pageSizes;    // Compressed sizes
+    std::vector<uint32_t> pageUncompressedSizes;  // Equal to pageSizes for pages stored raw
+    Sanic::CompressionCodec pageCodec = Sanic::CompressionCodec::None;
     
     // Root pages (always resident)
     uint32_t numRootPages;
@@ -225,6 +228,15 @@ public:
     uint32_t registerResource(const std::string& path);
     void unregisterResource(uint32_t resourceId);
     
+    /**
+     * Request a page ahead of GPU demand (e.g. level streaming prefetch).
+     * urgency is any non-negative value, higher meaning sooner; it is
+     * mapped into [0, PRIORITY_PREFETCH) so prefetches keep their order
+     * among themselves but never outrank a page the GPU asked for.
+     * @return false if the page is unknown, resident or already requested
+     */
+    bool prefetchPage(uint32_t resourceId, uint32_t pageIndex, float urgency);
+    
     /**
      * Begin frame - read GPU requests from previous frame
      */
@@ -5,15 +5,19 @@
  */
 
 #include "NavigationSystem.h"
-
-// Recast/Detour headers would be included here
-// #include "Recast.h"
-// #include "DetourNavMesh.h"
-// #include "DetourNavMeshBuilder.h"
-// #include "DetourNavMeshQuery.h"
+#include "JobSystem.h"
+
+#include "Recast.h"
+#include "DetourAlloc.h"
+#include "DetourCommon.h"
+#include "DetourNavMesh.h"
+#include "DetourNavMeshBuilder.h"
+#include "DetourNavMeshQuery.h"
 // #include "DetourCrowd.h"
 
 #include <algorithm>
+#include <atomic>
+#include <climits>
 #include <cmath>
 #include <cstring>
 
@@ -54,6 +58,325 @@ void NavMeshInputGeometry::calculateBounds() {
     }
 }
 
+// ============================================================================
+// TILE BUILDING
+// ============================================================================
+
+/**
+ * Everything a tile build needs besides geometry. Immutable once created,
+ * so worker threads share it through a shared_ptr.
+ */
+struct NavMeshBuildContext {
+    NavMeshSettings settings;
+    std::vector<OffMeshConnection> offMeshConnections;
+    glm::vec3 origin = glm::vec3(0);    // Grid corner (x/z of the build bounds)
+    int tileCells = 0;                  // Tile width in cells, excluding border
+    int borderCells = 0;                // Extra cells around each tile
+    float tileWorldSize = 0.0f;
+    int tilesX = 0;
+    int tilesY = 0;
+    uint32_t generation = 0;
+};
+
+namespace {
+
+inline uint64_t makeTileKey(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+inline void splitTileKey(uint64_t key, int& x, int& y) {
+    x = static_cast<int>(static_cast<uint32_t>(key >> 32));
+    y = static_cast<int>(static_cast<uint32_t>(key));
+}
+
+// Tiles whose area, grown by the Recast border, overlaps [min, max] on X/Z.
+// Returns false if none do.
+bool getTileRange(const NavMeshBuildContext& context, const glm::vec3& min, const glm::vec3& max,
+                  int& x0, int& y0, int& x1, int& y1) {
+    float border = context.borderCells * context.settings.cellSize;
+    x0 = static_cast<int>(std::floor((min.x - border - context.origin.x) / context.tileWorldSize));
+    y0 = static_cast<int>(std::floor((min.z - border - context.origin.z) / context.tileWorldSize));
+    x1 = static_cast<int>(std::floor((max.x + border - context.origin.x) / context.tileWorldSize));
+    y1 = static_cast<int>(std::floor((max.z + border - context.origin.z) / context.tileWorldSize));
+    
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, context.tilesX - 1);
+    y1 = std::min(y1, context.tilesY - 1);
+    return x0 <= x1 && y0 <= y1;
+}
+
+/**
+ * Triangles bucketed by the tiles they can affect, so a tile build only
+ * rasterizes nearby geometry. Stored as one flat list with per-tile offsets.
+ */
+struct NavMeshTileGrid {
+    std::vector<uint32_t> tileStart;    // tilesX * tilesY + 1 entries
+    std::vector<uint32_t> triangles;
+    
+    void build(const NavMeshBuildContext& context, const NavMeshInputGeometry& geometry) {
+        size_t tileCount = static_cast<size_t>(context.tilesX) * context.tilesY;
+        size_t triangleCount = geometry.indices.size() / 3;
+        tileStart.assign(tileCount + 1, 0);
+        
+        auto forEachTile = [&](size_t tri, auto&& fn) {
+            const glm::vec3& a = geometry.vertices[geometry.indices[tri * 3 + 0]];
+            const glm::vec3& b = geometry.vertices[geometry.indices[tri * 3 + 1]];
+            const glm::vec3& c = geometry.vertices[geometry.indices[tri * 3 + 2]];
+            
+            int x0, y0, x1, y1;
+            if (!getTileRange(context, glm::min(a, glm::min(b, c)), glm::max(a, glm::max(b, c)), x0, y0, x1, y1)) {
+                return;
+            }
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    fn(static_cast<size_t>(y) * context.tilesX + x);
+                }
+            }
+        };
+        
+        // Count, prefix sum, then fill
+        for (size_t tri = 0; tri < triangleCount; ++tri) {
+            forEachTile(tri, [&](size_t tile) { tileStart[tile + 1]++; });
+        }
+        for (size_t tile = 0; tile < tileCount; ++tile) {
+            tileStart[tile + 1] += tileStart[tile];
+        }
+        
+        triangles.resize(tileStart[tileCount]);
+        std::vector<uint32_t> cursor(tileStart.begin(), tileStart.end() - 1);
+        for (size_t tri = 0; tri < triangleCount; ++tri) {
+            forEachTile(tri, [&](size_t tile) { triangles[cursor[tile]++] = static_cast<uint32_t>(tri); });
+        }
+    }
+    
+    const uint32_t* getTriangles(const NavMeshBuildContext& context, int x, int y, size_t& outCount) const {
+        size_t tile = static_cast<size_t>(y) * context.tilesX + x;
+        outCount = tileStart[tile + 1] - tileStart[tile];
+        return triangles.data() + tileStart[tile];
+    }
+};
+
+// Frees Recast intermediates however a tile build exits
+struct RecastTileScratch {
+    rcHeightfield* solid = nullptr;
+    rcCompactHeightfield* chf = nullptr;
+    rcContourSet* cset = nullptr;
+    rcPolyMesh* pmesh = nullptr;
+    rcPolyMeshDetail* dmesh = nullptr;
+    
+    ~RecastTileScratch() {
+        rcFreeHeightField(solid);
+        rcFreeCompactHeightfield(chf);
+        rcFreeContourSet(cset);
+        rcFreePolyMesh(pmesh);
+        rcFreePolyMeshDetail(dmesh);
+    }
+};
+
+uint16_t getAreaFlags(uint8_t area) {
+    switch (area) {
+        case NavArea::WATER:    return NavFlag::SWIM;
+        case NavArea::DOOR:     return NavFlag::WALK | NavFlag::DOOR;
+        case NavArea::JUMP:     return NavFlag::JUMP;
+        case NavArea::DISABLED: return NavFlag::DISABLED;
+        default:                return NavFlag::WALK;
+    }
+}
+
+/**
+ * Voxelizes one tile and converts it to Detour tile data. Thread-safe: only
+ * reads its inputs. outTile.data stays empty if the tile has no walkable
+ * area; returns false if Recast or Detour fail.
+ */
+bool buildTileData(const NavMeshBuildContext& context, const NavMeshInputGeometry& geometry,
+                   const uint32_t* triangles, size_t triangleCount, NavMeshTile& outTile) {
+    outTile.data.clear();
+    if (triangleCount == 0) {
+        return true;
+    }
+    
+    const NavMeshSettings& settings = context.settings;
+    
+    rcConfig cfg;
+    std::memset(&cfg, 0, sizeof(cfg));
+    cfg.cs = settings.cellSize;
+    cfg.ch = settings.cellHeight;
+    cfg.walkableSlopeAngle = settings.agentMaxSlope;
+    cfg.walkableHeight = static_cast<int>(std::ceil(settings.agentHeight / cfg.ch));
+    cfg.walkableClimb = static_cast<int>(std::floor(settings.agentMaxClimb / cfg.ch));
+    cfg.walkableRadius = static_cast<int>(std::ceil(settings.agentRadius / cfg.cs));
+    cfg.maxEdgeLen = static_cast<int>(settings.edgeMaxLen / cfg.cs);
+    cfg.maxSimplificationError = settings.edgeMaxError;
+    cfg.minRegionArea = static_cast<int>(settings.regionMinSize * settings.regionMinSize);
+    cfg.mergeRegionArea = static_cast<int>(settings.regionMergeSize * settings.regionMergeSize);
+    cfg.maxVertsPerPoly = std::min(settings.vertsPerPoly, DT_VERTS_PER_POLYGON);
+    cfg.tileSize = context.tileCells;
+    cfg.borderSize = context.borderCells;
+    cfg.width = cfg.tileSize + cfg.borderSize * 2;
+    cfg.height = cfg.tileSize + cfg.borderSize * 2;
+    cfg.detailSampleDist = settings.detailSampleDist < 0.9f ? 0.0f : cfg.cs * settings.detailSampleDist;
+    cfg.detailSampleMaxError = cfg.ch * settings.detailSampleMaxError;
+    
+    // Tile bounds grown by the border, so regions and erosion match across tiles
+    float border = cfg.borderSize * cfg.cs;
+    cfg.bmin[0] = context.origin.x + outTile.tileX * context.tileWorldSize - border;
+    cfg.bmin[1] = geometry.boundsMin.y;
+    cfg.bmin[2] = context.origin.z + outTile.tileY * context.tileWorldSize - border;
+    cfg.bmax[0] = context.origin.x + (outTile.tileX + 1) * context.tileWorldSize + border;
+    cfg.bmax[1] = geometry.boundsMax.y;
+    cfg.bmax[2] = context.origin.z + (outTile.tileY + 1) * context.tileWorldSize + border;
+    
+    rcContext ctx(false);
+    RecastTileScratch scratch;
+    
+    // Rasterize this tile's triangles
+    scratch.solid = rcAllocHeightfield();
+    if (!scratch.solid ||
+        !rcCreateHeightfield(&ctx, *scratch.solid, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch)) {
+        return false;
+    }
+    
+    std::vector<int> tileTris(triangleCount * 3);
+    for (size_t i = 0; i < triangleCount; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            tileTris[i * 3 + k] = static_cast<int>(geometry.indices[triangles[i] * 3 + k]);
+        }
+    }
+    std::vector<unsigned char> areas(triangleCount, 0);
+    
+    const float* verts = &geometry.vertices[0].x;
+    int vertCount = static_cast<int>(geometry.vertices.size());
+    int triCount = static_cast<int>(triangleCount);
+    
+    rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, vertCount, tileTris.data(), triCount, areas.data());
+    if (!rcRasterizeTriangles(&ctx, verts, vertCount, tileTris.data(), areas.data(), triCount,
+                              *scratch.solid, cfg.walkableClimb)) {
+        return false;
+    }
+    
+    // Drop spans the agent can't stand on
+    rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *scratch.solid);
+    rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *scratch.solid);
+    rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *scratch.solid);
+    
+    // Regions
+    scratch.chf = rcAllocCompactHeightfield();
+    if (!scratch.chf ||
+        !rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *scratch.solid, *scratch.chf)) {
+        return false;
+    }
+    rcFreeHeightField(scratch.solid);
+    scratch.solid = nullptr;
+    
+    if (!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *scratch.chf) ||
+        !rcBuildDistanceField(&ctx, *scratch.chf) ||
+        !rcBuildRegions(&ctx, *scratch.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea)) {
+        return false;
+    }
+    
+    // Contours and polygons
+    scratch.cset = rcAllocContourSet();
+    if (!scratch.cset ||
+        !rcBuildContours(&ctx, *scratch.chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *scratch.cset)) {
+        return false;
+    }
+    if (scratch.cset->nconts == 0) {
+        return true;
+    }
+    
+    scratch.pmesh = rcAllocPolyMesh();
+    if (!scratch.pmesh || !rcBuildPolyMesh(&ctx, *scratch.cset, cfg.maxVertsPerPoly, *scratch.pmesh)) {
+        return false;
+    }
+    scratch.dmesh = rcAllocPolyMeshDetail();
+    if (!scratch.dmesh ||
+        !rcBuildPolyMeshDetail(&ctx, *scratch.pmesh, *scratch.chf, cfg.detailSampleDist,
+                               cfg.detailSampleMaxError, *scratch.dmesh)) {
+        return false;
+    }
+    
+    rcPolyMesh& pmesh = *scratch.pmesh;
+    if (pmesh.npolys == 0) {
+        return true;
+    }
+    if (pmesh.nverts >= 0xffff) {
+        return false;  // Detour indexes tile vertices with 16 bits
+    }
+    
+    for (int i = 0; i < pmesh.npolys; ++i) {
+        if (pmesh.areas[i] == RC_WALKABLE_AREA) {
+            pmesh.areas[i] = NavArea::WALKABLE;
+        }
+        pmesh.flags[i] = getAreaFlags(pmesh.areas[i]);
+    }
+    
+    // Off-mesh connections; Detour keeps the ones that start in this tile
+    size_t connectionCount = context.offMeshConnections.size();
+    std::vector<float> conVerts(connectionCount * 6);
+    std::vector<float> conRadii(connectionCount);
+    std::vector<unsigned short> conFlags(connectionCount);
+    std::vector<unsigned char> conAreas(connectionCount);
+    std::vector<unsigned char> conDirs(connectionCount);
+    std::vector<unsigned int> conIds(connectionCount);
+    for (size_t i = 0; i < connectionCount; ++i) {
+        const OffMeshConnection& con = context.offMeshConnections[i];
+        glm::vec3 start = con.direction == OffMeshConnection::Direction::EndToStart ? con.endPos : con.startPos;
+        glm::vec3 end = con.direction == OffMeshConnection::Direction::EndToStart ? con.startPos : con.endPos;
+        std::memcpy(&conVerts[i * 6 + 0], &start.x, sizeof(float) * 3);
+        std::memcpy(&conVerts[i * 6 + 3], &end.x, sizeof(float) * 3);
+        conRadii[i] = con.radius;
+        conAreas[i] = static_cast<unsigned char>(con.areaType);
+        conFlags[i] = getAreaFlags(conAreas[i]);
+        conDirs[i] = con.direction == OffMeshConnection::Direction::Bidirectional ? DT_OFFMESH_CON_BIDIR : 0;
+        conIds[i] = con.userId;
+    }
+    
+    dtNavMeshCreateParams params;
+    std::memset(&params, 0, sizeof(params));
+    params.verts = pmesh.verts;
+    params.vertCount = pmesh.nverts;
+    params.polys = pmesh.polys;
+    params.polyAreas = pmesh.areas;
+    params.polyFlags = pmesh.flags;
+    params.polyCount = pmesh.npolys;
+    params.nvp = pmesh.nvp;
+    params.detailMeshes = scratch.dmesh->meshes;
+    params.detailVerts = scratch.dmesh->verts;
+    params.detailVertsCount = scratch.dmesh->nverts;
+    params.detailTris = scratch.dmesh->tris;
+    params.detailTriCount = scratch.dmesh->ntris;
+    params.offMeshConVerts = conVerts.data();
+    params.offMeshConRad = conRadii.data();
+    params.offMeshConFlags = conFlags.data();
+    params.offMeshConAreas = conAreas.data();
+    params.offMeshConDir = conDirs.data();
+    params.offMeshConUserID = conIds.data();
+    params.offMeshConCount = static_cast<int>(connectionCount);
+    params.walkableHeight = settings.agentHeight;
+    params.walkableRadius = settings.agentRadius;
+    params.walkableClimb = settings.agentMaxClimb;
+    params.tileX = outTile.tileX;
+    params.tileY = outTile.tileY;
+    params.tileLayer = 0;
+    std::memcpy(params.bmin, pmesh.bmin, sizeof(params.bmin));
+    std::memcpy(params.bmax, pmesh.bmax, sizeof(params.bmax));
+    params.cs = cfg.cs;
+    params.ch = cfg.ch;
+    params.buildBvTree = true;
+    
+    unsigned char* navData = nullptr;
+    int navDataSize = 0;
+    if (!dtCreateNavMeshData(&params, &navData, &navDataSize)) {
+        return false;
+    }
+    outTile.data.assign(navData, navData + navDataSize);
+    dtFree(navData);
+    return true;
+}
+
+} // namespace
+
 // ============================================================================
 // NAVIGATION MESH
 // ============================================================================
@@ -61,8 +384,10 @@ void NavMeshInputGeometry::calculateBounds() {
 NavigationMesh::NavigationMesh() = default;
 
 NavigationMesh::~NavigationMesh() {
+    stopRebuildThread();
+    
     if (navMesh_) {
-        // dtFreeNavMesh(navMesh_);
+        dtFreeNavMesh(navMesh_);
         navMesh_ = nullptr;
     }
 }
@@ -72,6 +397,10 @@ bool NavigationMesh::build(const NavMeshInputGeometry& geometry, const NavMeshSe
     boundsMin_ = geometry.boundsMin;
     boundsMax_ = geometry.boundsMax;
     
+    if (geometry.indices.empty() || boundsMin_.x > boundsMax_.x || boundsMin_.z > boundsMax_.z) {
+        return false;
+    }
+    
     if (settings.useTiles) {
         return buildTiledMesh(geometry);
     } else {
@@ -80,78 +409,339 @@ bool NavigationMesh::build(const NavMeshInputGeometry& geometry, const NavMeshSe
 }
 
 bool NavigationMesh::buildSingleTile(const NavMeshInputGeometry& geometry) {
-    // This would use Recast to build a single-tile NavMesh
-    // 
-    // 1. Create Recast config from settings
-    // 2. Create heightfield (rcCreateHeightfield)
-    // 3. Rasterize triangles (rcRasterizeTriangles)
-    // 4. Filter walkables (rcFilterLowHangingWalkableObstacles, etc.)
-    // 5. Build compact heightfield (rcBuildCompactHeightfield)
-    // 6. Build distance field (rcBuildDistanceField)
-    // 7. Build regions (rcBuildRegions)
-    // 8. Build contours (rcBuildContours)
-    // 9. Build polygon mesh (rcBuildPolyMesh)
-    // 10. Build detail mesh (rcBuildPolyMeshDetail)
-    // 11. Create Detour NavMesh data (dtCreateNavMeshData)
-    // 12. Initialize Detour NavMesh (dtAllocNavMesh, init)
-    
-    // Placeholder - actual implementation would use Recast library
-    return true;
+    // One tile covering the whole bounds
+    float extent = std::max(boundsMax_.x - boundsMin_.x, boundsMax_.z - boundsMin_.z);
+    int tileCells = std::max(1, static_cast<int>(std::ceil(extent / settings_.cellSize)));
+    return buildTiles(geometry, tileCells);
 }
 
 bool NavigationMesh::buildTiledMesh(const NavMeshInputGeometry& geometry) {
-    // Similar to single tile but splits into grid of tiles
-    // Each tile is built independently and added to the NavMesh
-    
-    float tileWidth = settings_.tileSize * settings_.cellSize;
-    float tileHeight = settings_.tileSize * settings_.cellSize;
-    
-    int numTilesX = static_cast<int>(std::ceil((boundsMax_.x - boundsMin_.x) / tileWidth));
-    int numTilesY = static_cast<int>(std::ceil((boundsMax_.z - boundsMin_.z) / tileHeight));
-    
-    // Create empty tiled NavMesh
-    // dtNavMeshParams params;
-    // params.orig[0] = boundsMin_.x;
-    // params.orig[1] = boundsMin_.y;
-    // params.orig[2] = boundsMin_.z;
-    // params.tileWidth = tileWidth;
-    // params.tileHeight = tileHeight;
-    // params.maxTiles = numTilesX * numTilesY;
-    // params.maxPolys = 1 << 20;
-    // 
-    // navMesh_ = dtAllocNavMesh();
-    // navMesh_->init(&params);
+    int tileCells = std::max(1, static_cast<int>(settings_.tileSize));
+    return buildTiles(geometry, tileCells);
+}
+
+bool NavigationMesh::buildTiles(const NavMeshInputGeometry& geometry, int tileCells) {
+    auto context = std::make_shared<NavMeshBuildContext>();
+    context->settings = settings_;
+    context->offMeshConnections = offMeshConnections_;
+    context->origin = glm::vec3(boundsMin_.x, 0.0f, boundsMin_.z);
+    context->tileCells = tileCells;
+    context->borderCells = static_cast<int>(std::ceil(settings_.agentRadius / settings_.cellSize)) + 3;
+    context->tileWorldSize = tileCells * settings_.cellSize;
+    context->tilesX = std::max(1, static_cast<int>(std::ceil((boundsMax_.x - boundsMin_.x) / context->tileWorldSize)));
+    context->tilesY = std::max(1, static_cast<int>(std::ceil((boundsMax_.z - boundsMin_.z) / context->tileWorldSize)));
     
-    // Build each tile
-    for (int y = 0; y < numTilesY; ++y) {
-        for (int x = 0; x < numTilesX; ++x) {
-            buildTile(x, y, geometry);
-        }
+    // Drop any background work for the previous grid
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex_);
+        context->generation = ++buildGeneration_;
+        buildContext_ = context;
+        rebuildGeometry_.reset();
+        dirtyTiles_.clear();
+        rebuiltTiles_.clear();
     }
+    tilesX_ = context->tilesX;
+    tilesY_ = context->tilesY;
     
-    return true;
+    if (navMesh_) {
+        dtFreeNavMesh(navMesh_);
+        navMesh_ = nullptr;
+        notifyTileChanged(-1, -1);
+    }
+    navMesh_ = dtAllocNavMesh();
+    if (!navMesh_) {
+        return false;
+    }
+    
+    // Detour packs tile and polygon indices into 22 bits of a poly ref
+    int tileBits = std::min(static_cast<int>(dtIlog2(dtNextPow2(static_cast<unsigned int>(tilesX_ * tilesY_)))), 14);
+    int polyBits = 22 - tileBits;
+    
+    dtNavMeshParams params;
+    std::memset(&params, 0, sizeof(params));
+    params.orig[0] = context->origin.x;
+    params.orig[1] = boundsMin_.y;
+    params.orig[2] = context->origin.z;
+    params.tileWidth = context->tileWorldSize;
+    params.tileHeight = context->tileWorldSize;
+    params.maxTiles = 1 << tileBits;
+    params.maxPolys = 1 << polyBits;
+    
+    if (dtStatusFailed(navMesh_->init(&params))) {
+        dtFreeNavMesh(navMesh_);
+        navMesh_ = nullptr;
+        return false;
+    }
+    
+    NavMeshTileGrid grid;
+    grid.build(*context, geometry);
+    
+    // Tiles are independent; voxelize them in parallel and add each to the
+    // NavMesh as it finishes (adding isn't thread-safe, but is cheap)
+    size_t tileCount = static_cast<size_t>(tilesX_) * tilesY_;
+    std::mutex addMutex;
+    std::atomic<uint32_t> failedTiles{0};
+    
+    JobSystem::getInstance().parallelFor(tileCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            NavMeshTile tile;
+            tile.tileX = static_cast<int>(i % tilesX_);
+            tile.tileY = static_cast<int>(i / tilesX_);
+            
+            size_t triangleCount = 0;
+            const uint32_t* triangles = grid.getTriangles(*context, tile.tileX, tile.tileY, triangleCount);
+            if (!buildTileData(*context, geometry, triangles, triangleCount, tile)) {
+                failedTiles.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (tile.data.empty()) {
+                continue;
+            }
+            
+            std::lock_guard<std::mutex> lock(addMutex);
+            if (!addTileData(tile)) {
+                failedTiles.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    
+    return failedTiles.load() == 0;
 }
 
 bool NavigationMesh::buildTile(int tileX, int tileY, const NavMeshInputGeometry& geometry) {
-    // Build a single tile and add it to the NavMesh
-    // Filters geometry to only include triangles that overlap this tile
+    std::shared_ptr<const NavMeshBuildContext> context;
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex_);
+        context = buildContext_;
+    }
+    if (!navMesh_ || !context ||
+        tileX < 0 || tileY < 0 || tileX >= context->tilesX || tileY >= context->tilesY) {
+        return false;
+    }
+    
+    // Filter geometry to the triangles that can touch this tile
+    std::vector<uint32_t> triangles;
+    size_t triangleCount = geometry.indices.size() / 3;
+    for (size_t tri = 0; tri < triangleCount; ++tri) {
+        const glm::vec3& a = geometry.vertices[geometry.indices[tri * 3 + 0]];
+        const glm::vec3& b = geometry.vertices[geometry.indices[tri * 3 + 1]];
+        const glm::vec3& c = geometry.vertices[geometry.indices[tri * 3 + 2]];
+        int x0, y0, x1, y1;
+        if (getTileRange(*context, glm::min(a, glm::min(b, c)), glm::max(a, glm::max(b, c)), x0, y0, x1, y1) &&
+            tileX >= x0 && tileX <= x1 && tileY >= y0 && tileY <= y1) {
+            triangles.push_back(static_cast<uint32_t>(tri));
+        }
+    }
+    
+    NavMeshTile tile;
+    tile.tileX = tileX;
+    tile.tileY = tileY;
+    if (!buildTileData(*context, geometry, triangles.data(), triangles.size(), tile)) {
+        return false;
+    }
+    
+    return replaceTile(tile);
+}
+
+bool NavigationMesh::replaceTile(const NavMeshTile& tile) {
+    dtTileRef ref = navMesh_->getTileRefAt(tile.tileX, tile.tileY, 0);
+    if (ref) {
+        navMesh_->removeTile(ref, nullptr, nullptr);
+    }
+    
+    bool added = tile.data.empty() || addTileData(tile);
+    notifyTileChanged(tile.tileX, tile.tileY);
+    return added;
+}
+
+bool NavigationMesh::addTileData(const NavMeshTile& tile) {
+    // Detour frees tile data with dtFree, so hand it its own copy
+    int size = static_cast<int>(tile.data.size());
+    unsigned char* data = static_cast<unsigned char*>(dtAlloc(size, DT_ALLOC_PERM));
+    if (!data) {
+        return false;
+    }
+    std::memcpy(data, tile.data.data(), size);
     
+    if (dtStatusFailed(navMesh_->addTile(data, size, DT_TILE_FREE_DATA, 0, nullptr))) {
+        dtFree(data);
+        return false;
+    }
     return true;
 }
 
 void NavigationMesh::removeTile(int tileX, int tileY) {
     if (!navMesh_) return;
     
-    // dtTileRef ref = navMesh_->getTileRefAt(tileX, tileY, 0);
-    // if (ref) {
-    //     navMesh_->removeTile(ref, nullptr, nullptr);
-    // }
+    dtTileRef ref = navMesh_->getTileRefAt(tileX, tileY, 0);
+    if (ref) {
+        navMesh_->removeTile(ref, nullptr, nullptr);
+        notifyTileChanged(tileX, tileY);
+    }
+}
+
+uint32_t NavigationMesh::addTileChangedListener(TileChangedCallback callback) {
+    uint32_t id = nextListenerId_++;
+    tileListeners_.emplace_back(id, std::move(callback));
+    return id;
+}
+
+void NavigationMesh::removeTileChangedListener(uint32_t listenerId) {
+    tileListeners_.erase(
+        std::remove_if(tileListeners_.begin(), tileListeners_.end(),
+            [listenerId](const auto& listener) { return listener.first == listenerId; }),
+        tileListeners_.end()
+    );
+}
+
+void NavigationMesh::notifyTileChanged(int tileX, int tileY) {
+    for (const auto& listener : tileListeners_) {
+        listener.second(tileX, tileY);
+    }
+}
+
+// ============================================================================
+// RUNTIME TILE REBUILDS
+// ============================================================================
+
+void NavigationMesh::rebuildTilesAsync(std::shared_ptr<const NavMeshInputGeometry> geometry,
+                                       const std::vector<NavMeshBounds>& dirtyBounds) {
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex_);
+        if (!buildContext_) return;
+        
+        if (geometry) {
+            rebuildGeometry_ = std::move(geometry);
+        }
+        for (const NavMeshBounds& bounds : dirtyBounds) {
+            queueDirtyTiles(bounds);
+        }
+        
+        if (!rebuildThread_.joinable()) {
+            rebuildShutdown_ = false;
+            rebuildThread_ = std::thread(&NavigationMesh::rebuildThreadFunc, this);
+        }
+    }
+    rebuildCondition_.notify_one();
+}
+
+void NavigationMesh::queueDirtyTiles(const NavMeshBounds& bounds) {
+    int x0, y0, x1, y1;
+    if (!getTileRange(*buildContext_, bounds.min, bounds.max, x0, y0, x1, y1)) {
+        return;
+    }
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            dirtyTiles_.insert(makeTileKey(x, y));
+        }
+    }
+}
+
+uint32_t NavigationMesh::applyRebuiltTiles(uint32_t maxTiles) {
+    std::vector<NavMeshTile> finished;
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex_);
+        while (!rebuiltTiles_.empty() && finished.size() < maxTiles) {
+            auto it = rebuiltTiles_.begin();
+            finished.push_back(std::move(it->second));
+            rebuiltTiles_.erase(it);
+        }
+    }
+    
+    // Only these Detour calls touch the NavMesh, so queries never see a
+    // half-built tile
+    for (const NavMeshTile& tile : finished) {
+        replaceTile(tile);
+    }
+    return static_cast<uint32_t>(finished.size());
+}
+
+uint32_t NavigationMesh::getPendingTileCount() const {
+    std::lock_guard<std::mutex> lock(rebuildMutex_);
+    return static_cast<uint32_t>(dirtyTiles_.size() + rebuiltTiles_.size()) + tilesInFlight_;
+}
+
+void NavigationMesh::rebuildThreadFunc() {
+    // Triangle grid for the geometry snapshot being rebuilt; only remade
+    // when the snapshot or the build changes
+    std::shared_ptr<const NavMeshInputGeometry> gridGeometry;
+    uint32_t gridGeneration = 0;
+    NavMeshTileGrid grid;
+    
+    while (true) {
+        std::shared_ptr<const NavMeshBuildContext> context;
+        std::shared_ptr<const NavMeshInputGeometry> geometry;
+        NavMeshTile tile;
+        
+        {
+            std::unique_lock<std::mutex> lock(rebuildMutex_);
+            rebuildCondition_.wait(lock, [this] {
+                return rebuildShutdown_ || (!dirtyTiles_.empty() && rebuildGeometry_);
+            });
+            if (rebuildShutdown_) return;
+            
+            // One tile at a time, so new snapshots and dirty tiles are
+            // picked up between tiles
+            uint64_t key = *dirtyTiles_.begin();
+            dirtyTiles_.erase(dirtyTiles_.begin());
+            splitTileKey(key, tile.tileX, tile.tileY);
+            
+            context = buildContext_;
+            geometry = rebuildGeometry_;
+            tilesInFlight_++;
+        }
+        
+        if (geometry != gridGeometry || context->generation != gridGeneration) {
+            grid.build(*context, *geometry);
+            gridGeometry = geometry;
+            gridGeneration = context->generation;
+        }
+        
+        size_t triangleCount = 0;
+        const uint32_t* triangles = grid.getTriangles(*context, tile.tileX, tile.tileY, triangleCount);
+        bool built = buildTileData(*context, *geometry, triangles, triangleCount, tile);
+        
+        {
+            std::lock_guard<std::mutex> lock(rebuildMutex_);
+            tilesInFlight_--;
+            
+            // A failed tile keeps its old data; results for a replaced
+            // build are dropped
+            if (built && context->generation == buildGeneration_) {
+                tile.loaded = true;
+                rebuiltTiles_[makeTileKey(tile.tileX, tile.tileY)] = std::move(tile);
+            }
+        }
+    }
+}
+
+void NavigationMesh::stopRebuildThread() {
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex_);
+        rebuildShutdown_ = true;
+    }
+    rebuildCondition_.notify_all();
+    
+    if (rebuildThread_.joinable()) {
+        rebuildThread_.join();
+    }
 }
 
 bool NavigationMesh::addOffMeshConnection(const OffMeshConnection& connection) {
     offMeshConnections_.push_back(connection);
     
-    // Would rebuild affected tiles to include the connection
+    // Later tile builds include it; rebuild the tiles at both ends now if
+    // we have geometry to rebuild them from
+    std::lock_guard<std::mutex> lock(rebuildMutex_);
+    if (buildContext_) {
+        auto context = std::make_shared<NavMeshBuildContext>(*buildContext_);
+        context->offMeshConnections = offMeshConnections_;
+        buildContext_ = context;
+        
+        queueDirtyTiles({connection.startPos, connection.startPos});
+        queueDirtyTiles({connection.endPos, connection.endPos});
+        rebuildCondition_.notify_one();
+    }
     
     return true;
 }
@@ -162,6 +752,21 @@ void NavigationMesh::removeOffMeshConnection(uint32_t userId) {
             [userId](const OffMeshConnection& c) { return c.userId == userId; }),
         offMeshConnections_.end()
     );
+    
+    std::lock_guard<std::mutex> lock(rebuildMutex_);
+    if (buildContext_) {
+        for (const OffMeshConnection& connection : buildContext_->offMeshConnections) {
+            if (connection.userId == userId) {
+                queueDirtyTiles({connection.startPos, connection.startPos});
+                queueDirtyTiles({connection.endPos, connection.endPos});
+            }
+        }
+        
+        auto context = std::make_shared<NavMeshBuildContext>(*buildContext_);
+        context->offMeshConnections = offMeshConnections_;
+        buildContext_ = context;
+        rebuildCondition_.notify_one();
+    }
 }
 
 bool NavigationMesh::saveToFile(const std::string& path) const {
@@ -180,245 +785,1353 @@ bool NavigationMesh::loadFromFile(const std::string& path) {
 // ============================================================================
 
 NavQueryFilter::NavQueryFilter() {
-    // filter_ = new dtQueryFilter();
-    // 
-    // // Set default area costs
-    // filter_->setAreaCost(NavArea::WALKABLE, 1.0f);
-    // filter_->setAreaCost(NavArea::WATER, 10.0f);
-    // filter_->setAreaCost(NavArea::GRASS, 1.5f);
-    // filter_->setAreaCost(NavArea::ROAD, 0.5f);
-    // filter_->setAreaCost(NavArea::DOOR, 1.0f);
-    // 
-    // filter_->setIncludeFlags(NavFlag::ALL);
-    // filter_->setExcludeFlags(NavFlag::DISABLED);
+    filter_ = new dtQueryFilter();
+    
+    // Set default area costs
+    filter_->setAreaCost(NavArea::WALKABLE, 1.0f);
+    filter_->setAreaCost(NavArea::WATER, 10.0f);
+    filter_->setAreaCost(NavArea::GRASS, 1.5f);
+    filter_->setAreaCost(NavArea::ROAD, 0.5f);
+    filter_->setAreaCost(NavArea::DOOR, 1.0f);
+    
+    filter_->setIncludeFlags(NavFlag::ALL);
+    filter_->setExcludeFlags(NavFlag::DISABLED);
+}
+
+NavQueryFilter::~NavQueryFilter() {
+    delete filter_;
+}
+
+NavQueryFilter::NavQueryFilter(const NavQueryFilter& other)
+    : filter_(new dtQueryFilter(*other.filter_)) {
+}
+
+NavQueryFilter& NavQueryFilter::operator=(const NavQueryFilter& other) {
+    if (this != &other) {
+        *filter_ = *other.filter_;
+    }
+    return *this;
+}
+
+void NavQueryFilter::setAreaCost(uint32_t areaId, float cost) {
+    filter_->setAreaCost(static_cast<int>(areaId), cost);
+}
+
+float NavQueryFilter::getAreaCost(uint32_t areaId) const {
+    return filter_->getAreaCost(static_cast<int>(areaId));
+}
+
+void NavQueryFilter::setIncludeFlags(uint16_t flags) {
+    filter_->setIncludeFlags(flags);
+}
+
+void NavQueryFilter::setExcludeFlags(uint16_t flags) {
+    filter_->setExcludeFlags(flags);
+}
+
+// ============================================================================
+// NAVIGATION QUERY
+// ============================================================================
+
+namespace {
+
+// Search extents around a point when snapping it to the NavMesh
+const float POLY_PICK_EXTENTS[3] = { 2.0f, 4.0f, 2.0f };
+
+} // namespace
+
+NavigationQuery::NavigationQuery(NavigationMesh& navMesh)
+    : navMesh_(navMesh) {
+    
+    query_ = dtAllocNavMeshQuery();
+    ensureQuery();
+    
+    polyPath_.resize(MAX_POLYS);
+}
+
+NavigationQuery::~NavigationQuery() {
+    dtFreeNavMeshQuery(query_);
+}
+
+bool NavigationQuery::ensureQuery() {
+    const dtNavMesh* navMesh = navMesh_.getNavMesh();
+    if (!query_ || !navMesh) {
+        return false;
+    }
+    if (query_->getAttachedNavMesh() == navMesh) {
+        return true;
+    }
+    return dtStatusSucceed(query_->init(navMesh, MAX_SEARCH_NODES));
+}
+
+PathResult NavigationQuery::findPath(
+    const glm::vec3& start,
+    const glm::vec3& end,
+    const NavQueryFilter& filter
+) {
+    PathResult result;
+    
+    if (!navMesh_.isValid() || !ensureQuery()) {
+        result.status = PathResult::Status::NoPath;
+        return result;
+    }
+    
+    if (hierarchy_ && hierarchy_->isLongRoute(start, end)) {
+        return hierarchy_->findPath(start, end, filter);
+    }
+    
+    // Find nearest polys for start and end
+    uint64_t startPoly = 0, endPoly = 0;
+    glm::vec3 startOnMesh, endOnMesh;
+    
+    if (!findNearestPoly(start, filter, startPoly, startOnMesh)) {
+        result.status = PathResult::Status::InvalidStart;
+        return result;
+    }
+    if (!findNearestPoly(end, filter, endPoly, endOnMesh)) {
+        result.status = PathResult::Status::InvalidEnd;
+        return result;
+    }
+    
+    // Find path
+    std::vector<dtPolyRef> polys(MAX_POLYS);
+    int polyCount = 0;
+    dtStatus status = query_->findPath(
+        static_cast<dtPolyRef>(startPoly), static_cast<dtPolyRef>(endPoly),
+        &startOnMesh.x, &endOnMesh.x,
+        filter.getFilter(),
+        polys.data(), &polyCount, MAX_POLYS);
+    
+    if (dtStatusFailed(status) || polyCount == 0) {
+        result.status = dtStatusDetail(status, DT_OUT_OF_NODES) ? PathResult::Status::OutOfNodes
+                                                                 : PathResult::Status::NoPath;
+        return result;
+    }
+    
+    // Smooth path
+    polyPath_.assign(polys.begin(), polys.begin() + polyCount);
+    smoothPath(polyPath_, polyCount, startOnMesh, endOnMesh, result.path);
+    
+    result.success = !result.path.empty();
+    result.partial = dtStatusDetail(status, DT_PARTIAL_RESULT) || polys[polyCount - 1] != endPoly;
+    result.status = !result.success ? PathResult::Status::NoPath
+                  : result.partial ? PathResult::Status::PartialPath
+                                   : PathResult::Status::Success;
+    
+    return result;
+}
+
+void NavigationQuery::findPathAsync(
+    const glm::vec3& start,
+    const glm::vec3& end,
+    PathCallback callback,
+    const NavQueryFilter& filter
+) {
+    // Would use a job system to compute path on background thread
+    // For now, just compute synchronously
+    PathResult result = findPath(start, end, filter);
+    callback(result);
+}
+
+bool NavigationQuery::findNearestPoint(
+    const glm::vec3& point,
+    glm::vec3& outNearest,
+    float searchRadius
+) {
+    if (!ensureQuery()) return false;
+    
+    dtPolyRef nearestPoly = 0;
+    float extents[3] = { searchRadius, searchRadius * 2, searchRadius };
+    
+    NavQueryFilter filter;
+    dtStatus status = query_->findNearestPoly(
+        &point.x, extents, filter.getFilter(),
+        &nearestPoly, &outNearest.x);
+    
+    return dtStatusSucceed(status) && nearestPoly != 0;
+}
+
+bool NavigationQuery::raycast(
+    const glm::vec3& start,
+    const glm::vec3& end,
+    glm::vec3& outHitPoint,
+    glm::vec3& outHitNormal
+) {
+    // Would use dtNavMeshQuery::raycast
+    return false;
+}
+
+bool NavigationQuery::isPointOnNavMesh(const glm::vec3& point, float tolerance) {
+    glm::vec3 nearest;
+    if (findNearestPoint(point, nearest, tolerance)) {
+        return glm::distance(point, nearest) <= tolerance;
+    }
+    return false;
+}
+
+glm::vec3 NavigationQuery::getRandomPoint() {
+    // dtPolyRef randomPoly;
+    // float pt[3];
+    // 
+    // dtStatus status = query_->findRandomPoint(
+    //     defaultFilter_.getFilter(), frand, &randomPoly, pt);
+    // 
+    // if (dtStatusSucceed(status)) {
+    //     return glm::vec3(pt[0], pt[1], pt[2]);
+    // }
+    
+    return glm::vec3(0);
+}
+
+glm::vec3 NavigationQuery::getRandomPointInRadius(const glm::vec3& center, float radius) {
+    // Find start poly
+    // dtPolyRef startPoly;
+    // float nearestPt[3];
+    // float extents[3] = { 2, 4, 2 };
+    // 
+    // query_->findNearestPoly(&center.x, extents, defaultFilter_.getFilter(),
+    //                         &startPoly, nearestPt);
+    // 
+    // dtPolyRef randomPoly;
+    // float pt[3];
+    // 
+    // query_->findRandomPointAroundCircle(
+    //     startPoly, &center.x, radius,
+    //     defaultFilter_.getFilter(), frand,
+    //     &randomPoly, pt);
+    // 
+    // return glm::vec3(pt[0], pt[1], pt[2]);
+    
+    return center;
+}
+
+bool NavigationQuery::projectToNavMesh(const glm::vec3& point, glm::vec3& outProjected, float searchHeight) {
+    return findNearestPoint(point, outProjected, searchHeight);
+}
+
+bool NavigationQuery::findNearestPoly(const glm::vec3& point, const NavQueryFilter& filter,
+                                      uint64_t& outPoly, glm::vec3& outNearest) {
+    outPoly = 0;
+    if (!ensureQuery()) return false;
+    
+    dtPolyRef poly = 0;
+    dtStatus status = query_->findNearestPoly(&point.x, POLY_PICK_EXTENTS, filter.getFilter(),
+                                              &poly, &outNearest.x);
+    outPoly = poly;
+    return dtStatusSucceed(status) && poly != 0;
+}
+
+bool NavigationQuery::beginSlicedPath(uint64_t startPoly, uint64_t endPoly,
+                                      const glm::vec3& start, const glm::vec3& end,
+                                      const NavQueryFilter& filter) {
+    if (!ensureQuery()) return false;
+    
+    dtStatus status = query_->initSlicedFindPath(
+        static_cast<dtPolyRef>(startPoly), static_cast<dtPolyRef>(endPoly),
+        &start.x, &end.x, filter.getFilter());
+    return !dtStatusFailed(status);
+}
+
+NavigationQuery::SliceStatus NavigationQuery::updateSlicedPath(int maxIterations) {
+    // A rebuilt NavMesh invalidates the search
+    if (!query_ || query_->getAttachedNavMesh() != navMesh_.getNavMesh()) {
+        return SliceStatus::Failed;
+    }
+    
+    int doneIterations = 0;
+    dtStatus status = query_->updateSlicedFindPath(maxIterations, &doneIterations);
+    if (dtStatusFailed(status)) return SliceStatus::Failed;
+    return dtStatusInProgress(status) ? SliceStatus::InProgress : SliceStatus::Done;
+}
+
+bool NavigationQuery::finishSlicedPath(std::vector<uint64_t>& outPolys, bool& outPartial) {
+    std::vector<dtPolyRef> polys(MAX_POLYS);
+    int polyCount = 0;
+    dtStatus status = query_->finalizeSlicedFindPath(polys.data(), &polyCount, MAX_POLYS);
+    
+    outPolys.assign(polys.begin(), polys.begin() + polyCount);
+    outPartial = dtStatusDetail(status, DT_PARTIAL_RESULT);
+    return dtStatusSucceed(status) && polyCount > 0;
+}
+
+void NavigationQuery::buildStraightPath(const std::vector<uint64_t>& polys,
+                                        const glm::vec3& start, const glm::vec3& end,
+                                        std::vector<glm::vec3>& outPath) {
+    smoothPath(polys, static_cast<int>(polys.size()), start, end, outPath);
+}
+
+void NavigationQuery::smoothPath(
+    const std::vector<uint64_t>& polys,
+    int polyCount,
+    const glm::vec3& start,
+    const glm::vec3& end,
+    std::vector<glm::vec3>& outPath
+) {
+    outPath.clear();
+    if (polyCount == 0 || !ensureQuery()) return;
+    
+    std::vector<dtPolyRef> corridor(polys.begin(), polys.begin() + polyCount);
+    
+    // Snap the endpoints into the corridor; a partial corridor stops short
+    // of end, so aim for its closest point
+    glm::vec3 origin = start, target = end;
+    query_->closestPointOnPoly(corridor.front(), &start.x, &origin.x, nullptr);
+    query_->closestPointOnPoly(corridor.back(), &end.x, &target.x, nullptr);
+    
+    // String pulling algorithm (Detour's findStraightPath)
+    // This creates a smooth path by finding the shortest path through the portal edges
+    std::vector<float> straightPath(MAX_SMOOTH * 3);
+    int straightPathCount = 0;
+    
+    dtStatus status = query_->findStraightPath(
+        &origin.x, &target.x,
+        corridor.data(), polyCount,
+        straightPath.data(), nullptr, nullptr,
+        &straightPathCount, MAX_SMOOTH);
+    if (dtStatusFailed(status)) return;
+    
+    outPath.reserve(straightPathCount);
+    for (int i = 0; i < straightPathCount; ++i) {
+        outPath.push_back(glm::vec3(
+            straightPath[i * 3],
+            straightPath[i * 3 + 1],
+            straightPath[i * 3 + 2]
+        ));
+    }
+}
+
+// ============================================================================
+// PATH REQUEST QUEUE
+// ============================================================================
+
+PathRequestQueue::PathRequestQueue(NavigationMesh& navMesh, uint32_t queryContextCount)
+    : navMesh_(navMesh)
+    , defaultFilter_(std::make_shared<NavQueryFilter>()) {
+    
+    contexts_.resize(std::max(1u, queryContextCount));
+    for (QueryContext& context : contexts_) {
+        context.query = std::make_unique<NavigationQuery>(navMesh);
+    }
+}
+
+PathRequestQueue::~PathRequestQueue() = default;
+
+uint32_t PathRequestQueue::submit(const glm::vec3& start, const glm::vec3& end,
+                                  std::shared_ptr<const NavQueryFilter> filter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    Request request;
+    request.ticket = nextTicket_++;
+    if (nextTicket_ == 0) nextTicket_ = 1;
+    request.start = start;
+    request.end = end;
+    request.filter = filter ? std::move(filter) : defaultFilter_;
+    pending_.push_back(std::move(request));
+    
+    return pending_.back().ticket;
+}
+
+void PathRequestQueue::cancel(uint32_t ticket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    auto matches = [ticket](const Request& r) { return r.ticket == ticket; };
+    pending_.erase(std::remove_if(pending_.begin(), pending_.end(), matches), pending_.end());
+    
+    // A search with no waiters left still runs to completion, unseen
+    for (auto& search : activeSearches_) {
+        search->waiters.erase(std::remove_if(search->waiters.begin(), search->waiters.end(), matches),
+                              search->waiters.end());
+    }
+}
+
+void PathRequestQueue::setHierarchy(NavHierarchy* hierarchy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hierarchy_ = hierarchy;
+    
+    for (Request& request : pending_) {
+        if (request.longRoute) {
+            request.resolved = false;
+        }
+    }
+    if (hierarchySearch_) {
+        for (Request& request : hierarchySearch_->waiters) {
+            request.resolved = false;
+            pending_.push_back(std::move(request));
+        }
+        activeSearches_.erase(std::find(activeSearches_.begin(), activeSearches_.end(), hierarchySearch_));
+        hierarchySearch_.reset();
+    }
+}
+
+uint32_t PathRequestQueue::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    size_t count = pending_.size();
+    for (const auto& search : activeSearches_) {
+        count += search->waiters.size();
+    }
+    return static_cast<uint32_t>(count);
+}
+
+void PathRequestQueue::update(float budgetUs, const glm::vec3& priorityOrigin,
+                              std::vector<CompletedPath>& outCompleted) {
+    Clock::time_point startTime = Clock::now();
+    Clock::time_point deadline = startTime +
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::micro>(budgetUs));
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.searchesCompleted = 0;
+        stats_.requestsCoalesced = 0;
+        completed_ = &outCompleted;
+        
+        // Re-prioritize every update; the origin moves
+        std::stable_sort(pending_.begin(), pending_.end(), [&](const Request& a, const Request& b) {
+            glm::vec3 da = a.start - priorityOrigin;
+            glm::vec3 db = b.start - priorityOrigin;
+            return glm::dot(da, da) < glm::dot(db, db);
+        });
+    }
+    
+    if (navMesh_.isValid()) {
+        resolvePending(deadline);
+        
+        // The hierarchy is one more lane, after the contexts
+        size_t lanes = contexts_.size() + (hierarchy_ ? 1 : 0);
+        if (lanes == 1) {
+            runContext(contexts_[0], deadline);
+        } else {
+            JobSystem::getInstance().parallelFor(lanes, 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (i < contexts_.size()) {
+                        runContext(contexts_[i], deadline);
+                    } else {
+                        runHierarchy(deadline);
+                    }
+                }
+            });
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    completed_ = nullptr;
+    stats_.pendingRequests = static_cast<uint32_t>(pending_.size());
+    stats_.activeSearches = static_cast<uint32_t>(activeSearches_.size());
+    stats_.updateTimeUs = std::chrono::duration<float, std::micro>(Clock::now() - startTime).count();
+}
+
+void PathRequestQueue::resolvePending(Clock::time_point deadline) {
+    // Only the calling thread runs this; nearest-poly lookups don't disturb
+    // a sliced search in progress on the same query
+    NavigationQuery& query = *contexts_[0].query;
+    
+    // Always resolve at least one request so a tiny budget still makes progress
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool resolvedAny = false;
+    for (size_t i = 0; i < pending_.size() && (!resolvedAny || Clock::now() < deadline);) {
+        Request& request = pending_[i];
+        if (request.resolved) {
+            ++i;
+            continue;
+        }
+        resolvedAny = true;
+        
+        glm::vec3 nearest;
+        bool startFound = query.findNearestPoly(request.start, *request.filter, request.startPoly, nearest);
+        bool endFound = startFound && query.findNearestPoly(request.end, *request.filter, request.endPoly, nearest);
+        request.resolved = true;
+        
+        // Long routes wait for the hierarchy's sliced search instead
+        request.longRoute = hierarchy_ && hierarchy_->isLongRoute(request.start, request.end);
+        
+        if (!startFound || !endFound) {
+            completed_->push_back({ request.ticket, PathResult() });
+            completed_->back().result.status = startFound ? PathResult::Status::InvalidEnd
+                                                          : PathResult::Status::InvalidStart;
+            pending_.erase(pending_.begin() + i);
+            continue;
+        }
+        
+        // Join a search already under way for the same corridor
+        auto search = std::find_if(activeSearches_.begin(), activeSearches_.end(), [&](const auto& s) {
+            return s->startPoly == request.startPoly && s->endPoly == request.endPoly &&
+                   s->filter == request.filter && s->longRoute == request.longRoute;
+        });
+        if (search != activeSearches_.end()) {
+            (*search)->waiters.push_back(std::move(request));
+            pending_.erase(pending_.begin() + i);
+            stats_.requestsCoalesced++;
+            continue;
+        }
+        ++i;
+    }
+}
+
+void PathRequestQueue::runContext(QueryContext& context, Clock::time_point deadline) {
+    // At least one slice per update, even with the budget already spent
+    for (bool first = true; first || Clock::now() < deadline; first = false) {
+        if (!context.search && !dispatchNext(context)) {
+            return;  // Nothing left to dispatch
+        }
+        
+        switch (context.query->updateSlicedPath(ITERATIONS_PER_SLICE)) {
+            case NavigationQuery::SliceStatus::InProgress:
+                break;
+            case NavigationQuery::SliceStatus::Done:
+                completeSearch(context, true);
+                break;
+            case NavigationQuery::SliceStatus::Failed:
+                // Usually a tile under the search was rebuilt; try once more
+                if (!restartSearch(context)) {
+                    completeSearch(context, false);
+                }
+                break;
+        }
+    }
+}
+
+std::shared_ptr<PathRequestQueue::Search> PathRequestQueue::takeSearch(bool longRoute) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    auto first = std::find_if(pending_.begin(), pending_.end(), [&](const Request& r) {
+        return r.resolved && r.longRoute == longRoute;
+    });
+    if (first == pending_.end()) {
+        return nullptr;
+    }
+    
+    auto search = std::make_shared<Search>();
+    search->startPoly = first->startPoly;
+    search->endPoly = first->endPoly;
+    search->filter = first->filter;
+    search->start = first->start;
+    search->end = first->end;
+    search->longRoute = longRoute;
+    
+    // Take every resolved request with the same key along
+    auto sameKey = [&](const Request& r) {
+        return r.resolved && r.startPoly == search->startPoly && r.endPoly == search->endPoly &&
+               r.filter == search->filter && r.longRoute == longRoute;
+    };
+    auto shared = std::stable_partition(first, pending_.end(), [&](const Request& r) { return !sameKey(r); });
+    std::move(shared, pending_.end(), std::back_inserter(search->waiters));
+    pending_.erase(shared, pending_.end());
+    
+    stats_.requestsCoalesced += static_cast<uint32_t>(search->waiters.size() - 1);
+    activeSearches_.push_back(search);
+    return search;
+}
+
+bool PathRequestQueue::dispatchNext(QueryContext& context) {
+    std::shared_ptr<Search> search = takeSearch(false);
+    if (!search) {
+        return false;
+    }
+    
+    context.search = search;
+    if (!context.query->beginSlicedPath(search->startPoly, search->endPoly,
+                                        search->start, search->end, *search->filter) &&
+        !restartSearch(context)) {
+        completeSearch(context, false);
+    }
+    return true;
+}
+
+bool PathRequestQueue::restartSearch(QueryContext& context) {
+    Search& search = *context.search;
+    if (search.restarted) {
+        return false;
+    }
+    search.restarted = true;
+    
+    // Polygon refs may be stale; look them up again
+    glm::vec3 nearest;
+    uint64_t startPoly = 0, endPoly = 0;
+    NavigationQuery& query = *context.query;
+    if (!query.findNearestPoly(search.start, *search.filter, startPoly, nearest) ||
+        !query.findNearestPoly(search.end, *search.filter, endPoly, nearest)) {
+        return false;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        search.startPoly = startPoly;
+        search.endPoly = endPoly;
+    }
+    return query.beginSlicedPath(startPoly, endPoly, search.start, search.end, *search.filter);
+}
+
+void PathRequestQueue::completeSearch(QueryContext& context, bool found) {
+    std::shared_ptr<Search> search = std::move(context.search);
+    
+    std::vector<uint64_t> polys;
+    bool partial = false;
+    if (found) {
+        found = context.query->finishSlicedPath(polys, partial);
+    }
+    
+    // Stop accepting waiters before building their paths
+    std::vector<Request> waiters;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        activeSearches_.erase(std::find(activeSearches_.begin(), activeSearches_.end(), search));
+        waiters = std::move(search->waiters);
+    }
+    
+    // Each waiter gets the shared corridor string-pulled from its own start
+    std::vector<CompletedPath> results(waiters.size());
+    for (size_t i = 0; i < waiters.size(); ++i) {
+        CompletedPath& completed = results[i];
+        completed.ticket = waiters[i].ticket;
+        
+        PathResult& result = completed.result;
+        if (found) {
+            context.query->buildStraightPath(polys, waiters[i].start, waiters[i].end, result.path);
+        }
+        
+        result.success = !result.path.empty();
+        result.partial = partial || (found && polys.back() != search->endPoly);
+        result.status = !result.success ? PathResult::Status::NoPath
+                      : result.partial ? PathResult::Status::PartialPath
+                                       : PathResult::Status::Success;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::move(results.begin(), results.end(), std::back_inserter(*completed_));
+    stats_.searchesCompleted++;
+}
+
+void PathRequestQueue::runHierarchy(Clock::time_point deadline) {
+    // Only this lane touches the hierarchy during update(); at least one
+    // slice per update, like the contexts
+    for (bool first = true; first || Clock::now() < deadline; first = false) {
+        if (!hierarchySearch_) {
+            hierarchySearch_ = takeSearch(true);
+            if (!hierarchySearch_) {
+                return;  // Nothing left to dispatch
+            }
+            hierarchy_->beginSlicedPath(hierarchySearch_->start, hierarchySearch_->end, *hierarchySearch_->filter);
+        }
+        
+        if (hierarchy_->updateSlicedPath(ITERATIONS_PER_SLICE) == NavigationQuery::SliceStatus::Done) {
+            completeHierarchySearch();
+        }
+    }
+}
+
+void PathRequestQueue::completeHierarchySearch() {
+    std::shared_ptr<Search> search = std::move(hierarchySearch_);
+    PathResult shared = hierarchy_->finishSlicedPath();
+    
+    std::vector<Request> waiters;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        activeSearches_.erase(std::find(activeSearches_.begin(), activeSearches_.end(), search));
+        waiters = std::move(search->waiters);
+    }
+    
+    // Requests that joined share the route from the same polygons, with
+    // the ends string-pulled from their own start and end
+    std::vector<CompletedPath> results(waiters.size());
+    for (size_t i = 0; i < waiters.size(); ++i) {
+        results[i].ticket = waiters[i].ticket;
+        if (waiters[i].start == search->start && waiters[i].end == search->end) {
+            results[i].result = shared;
+        } else {
+            results[i].result = hierarchy_->adaptSlicedPath(shared, waiters[i].start, waiters[i].end);
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::move(results.begin(), results.end(), std::back_inserter(*completed_));
+    stats_.searchesCompleted++;
+}
+
+// ============================================================================
+// HIERARCHICAL PATHFINDING
+// ============================================================================
+
+namespace {
+
+inline glm::vec3 getTileVertex(const dtMeshTile* tile, unsigned short index) {
+    const float* v = &tile->verts[index * 3];
+    return glm::vec3(v[0], v[1], v[2]);
+}
+
+// Where a link leaves its polygon
+glm::vec3 getLinkPoint(const dtMeshTile* tile, const dtPoly& poly, const dtLink& link, const glm::vec3& centroid) {
+    if (poly.getType() == DT_POLYTYPE_OFFMESH_CONNECTION) {
+        return getTileVertex(tile, poly.verts[link.edge & 1]);  // Edge 0/1 is the start/end point
+    }
+    if (link.edge >= poly.vertCount) {
+        return centroid;  // Link onto an off-mesh connection
+    }
+    
+    glm::vec3 a = getTileVertex(tile, poly.verts[link.edge]);
+    glm::vec3 b = getTileVertex(tile, poly.verts[(link.edge + 1) % poly.vertCount]);
+    
+    // A link across a tile border may cover only part of the edge
+    float t = link.side != 0xff ? (link.bmin + link.bmax) * (0.5f / 255.0f) : 0.5f;
+    return glm::mix(a, b, t);
+}
+
+// Coarse search node ids: tile, portal, and whether it was entered through
+constexpr uint64_t COARSE_NO_PARENT = UINT64_MAX - 1;
+constexpr uint64_t COARSE_GOAL = UINT64_MAX;
+
+inline uint64_t coarseNodeId(int tilesX, int x, int y, uint32_t portal, bool entered) {
+    uint64_t tileIndex = static_cast<uint64_t>(y) * std::max(1, tilesX) + x;
+    return (tileIndex << 33) | (static_cast<uint64_t>(portal) << 1) | (entered ? 1 : 0);
+}
+
+} // namespace
+
+NavHierarchy::NavHierarchy(NavigationMesh& navMesh, const NavQueryFilter& filter,
+                           const NavHierarchySettings& settings)
+    : navMesh_(navMesh)
+    , filter_(filter)
+    , settings_(settings)
+    , query_(std::make_unique<NavigationQuery>(navMesh))
+    , slicedQuery_(std::make_unique<NavigationQuery>(navMesh)) {
+    
+    // The coarse heuristic is distance times the cheapest area cost
+    for (uint32_t area = 0; area < DT_MAX_AREAS; ++area) {
+        minAreaCost_ = std::min(minAreaCost_, std::max(0.0f, filter_.getAreaCost(area)));
+    }
+    
+    listenerId_ = navMesh_.addTileChangedListener([this](int tileX, int tileY) {
+        onTileChanged(tileX, tileY);
+    });
+}
+
+NavHierarchy::~NavHierarchy() {
+    navMesh_.removeTileChangedListener(listenerId_);
+}
+
+void NavHierarchy::clear() {
+    clusters_.clear();
+    routes_.clear();
+    routeByKey_.clear();
+}
+
+void NavHierarchy::onTileChanged(int tileX, int tileY) {
+    sliced_.tileChanged = true;
+    if (tileX < 0) {
+        clear();
+        return;
+    }
+    
+    // Neighbours' portals into the tile changed too
+    const int offsets[5][2] = { {0, 0}, {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+    std::set<uint64_t> affected;
+    for (const auto& offset : offsets) {
+        uint64_t key = makeTileKey(tileX + offset[0], tileY + offset[1]);
+        clusters_.erase(key);
+        affected.insert(key);
+    }
+    
+    for (auto it = routes_.begin(); it != routes_.end();) {
+        bool touches = std::any_of(it->tiles.begin(), it->tiles.end(),
+                                   [&](uint64_t tile) { return affected.count(tile) != 0; });
+        if (touches) {
+            routeByKey_.erase(it->key);
+            it = routes_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+const NavHierarchy::Cluster* NavHierarchy::getCluster(int tileX, int tileY) {
+    uint64_t key = makeTileKey(tileX, tileY);
+    auto it = clusters_.find(key);
+    if (it == clusters_.end()) {
+        it = clusters_.emplace(key, Cluster()).first;
+        buildCluster(tileX, tileY, it->second);
+        stats_.clustersBuilt++;
+    }
+    return &it->second;
+}
+
+void NavHierarchy::precompute() {
+    int tilesX = navMesh_.getTileCountX();
+    int tilesY = navMesh_.getTileCountY();
+    std::vector<Cluster> built(static_cast<size_t>(tilesX) * tilesY);
+    
+    // Clusters only read the NavMesh, so tiles build independently
+    JobSystem::getInstance().parallelFor(built.size(), 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            buildCluster(static_cast<int>(i % tilesX), static_cast<int>(i / tilesX), built[i]);
+        }
+    });
+    
+    for (size_t i = 0; i < built.size(); ++i) {
+        clusters_[makeTileKey(static_cast<int>(i % tilesX), static_cast<int>(i / tilesX))] = std::move(built[i]);
+    }
+    stats_.clustersBuilt += static_cast<uint32_t>(built.size());
+}
+
+void NavHierarchy::buildCluster(int tileX, int tileY, Cluster& outCluster) const {
+    const dtNavMesh* navMesh = navMesh_.getNavMesh();
+    const dtMeshTile* tile = navMesh ? navMesh->getTileAt(tileX, tileY, 0) : nullptr;
+    if (!tile || !tile->header) {
+        return;  // No tile, no portals
+    }
+    
+    const dtQueryFilter* filter = filter_.getFilter();
+    uint32_t polyCount = static_cast<uint32_t>(tile->header->polyCount);
+    dtPolyRef base = navMesh->getPolyRefBase(tile);
+    
+    outCluster.polyBase = base;
+    outCluster.centroids.resize(polyCount);
+    outCluster.costScales.resize(polyCount);
+    for (uint32_t i = 0; i < polyCount; ++i) {
+        const dtPoly& poly = tile->polys[i];
+        
+        glm::vec3 centroid(0.0f);
+        for (int v = 0; v < poly.vertCount; ++v) {
+            centroid += getTileVertex(tile, poly.verts[v]);
+        }
+        outCluster.centroids[i] = centroid / static_cast<float>(std::max<int>(1, poly.vertCount));
+        outCluster.costScales[i] = filter->passFilter(base | static_cast<dtPolyRef>(i), tile, &poly)
+            ? filter->getAreaCost(poly.getArea()) : -1.0f;
+    }
+    
+    // Links inside the tile form the polygon graph; links out of it are
+    // portal candidates
+    struct BorderEdge {
+        uint32_t polyIndex;
+        int neighbourX, neighbourY;
+        glm::vec3 position;
+        float lo, hi;                   // Extent along the border
+    };
+    std::vector<BorderEdge> borderEdges;
+    
+    outCluster.linkStart.resize(polyCount + 1);
+    for (uint32_t i = 0; i < polyCount; ++i) {
+        outCluster.linkStart[i] = static_cast<uint32_t>(outCluster.links.size());
+        if (outCluster.costScales[i] < 0.0f) continue;
+        
+        const dtPoly& poly = tile->polys[i];
+        for (unsigned int k = poly.firstLink; k != DT_NULL_LINK; k = tile->links[k].next) {
+            const dtLink& link = tile->links[k];
+            if (!link.ref) continue;
+            
+            const dtMeshTile* neighbourTile = nullptr;
+            const dtPoly* neighbourPoly = nullptr;
+            navMesh->getTileAndPolyByRefUnsafe(link.ref, &neighbourTile, &neighbourPoly);
+            glm::vec3 point = getLinkPoint(tile, poly, link, outCluster.centroids[i]);
+            
+            if (neighbourTile == tile) {
+                outCluster.links.emplace_back(static_cast<uint32_t>(neighbourPoly - tile->polys), point);
+                continue;
+            }
+            if (!filter->passFilter(link.ref, neighbourTile, neighbourPoly)) continue;
+            
+            BorderEdge edge;
+            edge.polyIndex = i;
+            edge.neighbourX = neighbourTile->header->x;
+            edge.neighbourY = neighbourTile->header->y;
+            edge.position = point;
+            edge.lo = edge.hi = 0.0f;
+            
+            // Tile borders are axis aligned: X neighbours share a border along Z
+            int axis = edge.neighbourX != tileX ? 2 : 0;
+            edge.lo = edge.hi = point[axis];
+            if (link.edge < poly.vertCount && poly.getType() != DT_POLYTYPE_OFFMESH_CONNECTION) {
+                glm::vec3 a = getTileVertex(tile, poly.verts[link.edge]);
+                glm::vec3 b = getTileVertex(tile, poly.verts[(link.edge + 1) % poly.vertCount]);
+                float t0 = link.bmin / 255.0f, t1 = link.bmax / 255.0f;
+                edge.lo = std::min(glm::mix(a, b, t0)[axis], glm::mix(a, b, t1)[axis]);
+                edge.hi = std::max(glm::mix(a, b, t0)[axis], glm::mix(a, b, t1)[axis]);
+            }
+            borderEdges.push_back(edge);
+        }
+    }
+    outCluster.linkStart[polyCount] = static_cast<uint32_t>(outCluster.links.size());
+    
+    // Merge touching border edges into one portal per stretch of open
+    // border, keeping the edge nearest the middle. The neighbour tile
+    // merges the same edges, so both sides get matching portals.
+    std::sort(borderEdges.begin(), borderEdges.end(), [](const BorderEdge& a, const BorderEdge& b) {
+        if (a.neighbourX != b.neighbourX) return a.neighbourX < b.neighbourX;
+        if (a.neighbourY != b.neighbourY) return a.neighbourY < b.neighbourY;
+        return a.lo < b.lo;
+    });
+    
+    const float MERGE_TOLERANCE = 0.01f;
+    for (size_t first = 0; first < borderEdges.size();) {
+        size_t last = first;
+        float runHi = borderEdges[first].hi;
+        while (last + 1 < borderEdges.size() &&
+               borderEdges[last + 1].neighbourX == borderEdges[first].neighbourX &&
+               borderEdges[last + 1].neighbourY == borderEdges[first].neighbourY &&
+               borderEdges[last + 1].lo <= runHi + MERGE_TOLERANCE) {
+            ++last;
+            runHi = std::max(runHi, borderEdges[last].hi);
+        }
+        
+        float middle = (borderEdges[first].lo + runHi) * 0.5f;
+        size_t best = first;
+        for (size_t e = first + 1; e <= last; ++e) {
+            float center = (borderEdges[e].lo + borderEdges[e].hi) * 0.5f;
+            float bestCenter = (borderEdges[best].lo + borderEdges[best].hi) * 0.5f;
+            if (std::abs(center - middle) < std::abs(bestCenter - middle)) {
+                best = e;
+            }
+        }
+        
+        Portal portal;
+        portal.polyIndex = borderEdges[best].polyIndex;
+        portal.position = borderEdges[best].position;
+        portal.neighbourX = borderEdges[best].neighbourX;
+        portal.neighbourY = borderEdges[best].neighbourY;
+        outCluster.portals.push_back(portal);
+        
+        first = last + 1;
+    }
+    
+    // Portal-to-portal costs through the tile
+    size_t portalCount = outCluster.portals.size();
+    outCluster.distances.resize(portalCount * portalCount);
+    std::vector<float> costs;
+    for (size_t a = 0; a < portalCount; ++a) {
+        computePortalCosts(outCluster, outCluster.portals[a].polyIndex, outCluster.portals[a].position, costs);
+        std::copy(costs.begin(), costs.end(), outCluster.distances.begin() + a * portalCount);
+    }
+}
+
+void NavHierarchy::computePortalCosts(const Cluster& cluster, uint32_t sourcePoly,
+                                      const glm::vec3& point, std::vector<float>& outCosts) {
+    size_t polyCount = cluster.centroids.size();
+    outCosts.assign(cluster.portals.size(), FLT_MAX);
+    if (sourcePoly >= polyCount || cluster.costScales[sourcePoly] < 0.0f) return;
+    
+    // Dijkstra over polygon centroids, crossing each shared edge at its midpoint
+    std::vector<float> polyCosts(polyCount, FLT_MAX);
+    using QueueEntry = std::pair<float, uint32_t>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open;
+    
+    polyCosts[sourcePoly] = glm::distance(point, cluster.centroids[sourcePoly]) * cluster.costScales[sourcePoly];
+    open.push({ polyCosts[sourcePoly], sourcePoly });
+    
+    while (!open.empty()) {
+        auto [cost, poly] = open.top();
+        open.pop();
+        if (cost > polyCosts[poly]) continue;
+        
+        for (uint32_t k = cluster.linkStart[poly]; k < cluster.linkStart[poly + 1]; ++k) {
+            const auto& [next, edgePoint] = cluster.links[k];
+            if (cluster.costScales[next] < 0.0f) continue;
+            
+            float nextCost = cost +
+                glm::distance(cluster.centroids[poly], edgePoint) * cluster.costScales[poly] +
+                glm::distance(edgePoint, cluster.centroids[next]) * cluster.costScales[next];
+            if (nextCost < polyCosts[next]) {
+                polyCosts[next] = nextCost;
+                open.push({ nextCost, next });
+            }
+        }
+    }
+    
+    for (size_t i = 0; i < cluster.portals.size(); ++i) {
+        const Portal& portal = cluster.portals[i];
+        float scale = cluster.costScales[portal.polyIndex];
+        if (portal.polyIndex == sourcePoly) {
+            outCosts[i] = glm::distance(point, portal.position) * scale;
+        } else if (polyCosts[portal.polyIndex] < FLT_MAX) {
+            outCosts[i] = polyCosts[portal.polyIndex] +
+                          glm::distance(cluster.centroids[portal.polyIndex], portal.position) * scale;
+        }
+    }
 }
 
-NavQueryFilter::~NavQueryFilter() {
-    // delete filter_;
+int NavHierarchy::findTwinPortal(const Cluster& neighbour, int tileX, int tileY, const glm::vec3& position) {
+    // The portal back into our tile nearest this one
+    int twin = -1;
+    float twinDistance = FLT_MAX;
+    for (size_t i = 0; i < neighbour.portals.size(); ++i) {
+        const Portal& candidate = neighbour.portals[i];
+        if (candidate.neighbourX != tileX || candidate.neighbourY != tileY) continue;
+        
+        float distance = glm::distance(candidate.position, position);
+        if (distance < twinDistance) {
+            twin = static_cast<int>(i);
+            twinDistance = distance;
+        }
+    }
+    return twin;
 }
 
-void NavQueryFilter::setAreaCost(uint32_t areaId, float cost) {
-    // if (filter_) {
-    //     filter_->setAreaCost(areaId, cost);
-    // }
+bool NavHierarchy::isLongRoute(const glm::vec3& start, const glm::vec3& end) const {
+    const dtNavMesh* navMesh = navMesh_.getNavMesh();
+    if (!navMesh) return false;
+    
+    int startX, startY, endX, endY;
+    navMesh->calcTileLoc(&start.x, &startX, &startY);
+    navMesh->calcTileLoc(&end.x, &endX, &endY);
+    return std::max(std::abs(endX - startX), std::abs(endY - startY)) > settings_.flatSearchTileDistance;
 }
 
-float NavQueryFilter::getAreaCost(uint32_t areaId) const {
-    // return filter_ ? filter_->getAreaCost(areaId) : 1.0f;
-    return 1.0f;
+PathResult NavHierarchy::findPath(const glm::vec3& start, const glm::vec3& end, const NavQueryFilter& filter) {
+    SlicedSearch search;
+    search.query = query_.get();
+    search.start = start;
+    search.end = end;
+    search.filter = &filter;
+    startSearch(search, true);
+    while (search.stage != SliceStage::Done) {
+        advanceSearch(search, INT_MAX);
+    }
+    return std::move(search.result);
 }
 
-void NavQueryFilter::setIncludeFlags(uint16_t flags) {
-    // if (filter_) filter_->setIncludeFlags(flags);
+void NavHierarchy::beginSlicedPath(const glm::vec3& start, const glm::vec3& end, const NavQueryFilter& filter) {
+    sliced_.query = slicedQuery_.get();
+    sliced_.start = start;
+    sliced_.end = end;
+    sliced_.filter = &filter;
+    sliced_.restarted = false;
+    startSearch(sliced_, true);
 }
 
-void NavQueryFilter::setExcludeFlags(uint16_t flags) {
-    // if (filter_) filter_->setExcludeFlags(flags);
+NavigationQuery::SliceStatus NavHierarchy::updateSlicedPath(int maxIterations) {
+    if (sliced_.stage == SliceStage::Coarse && sliced_.tileChanged) {
+        // Portals already queued may be gone; begin again, once
+        if (sliced_.restarted) {
+            finishSearch(sliced_, PathResult::Status::NoPath);
+        } else {
+            sliced_.restarted = true;
+            startSearch(sliced_, sliced_.useCache);
+        }
+    }
+    
+    advanceSearch(sliced_, maxIterations);
+    return sliced_.stage == SliceStage::Done ? NavigationQuery::SliceStatus::Done
+                                             : NavigationQuery::SliceStatus::InProgress;
 }
 
-// ============================================================================
-// NAVIGATION QUERY
-// ============================================================================
+PathResult NavHierarchy::finishSlicedPath() {
+    PathResult result = std::move(sliced_.result);
+    sliced_.result = PathResult();
+    sliced_.stage = SliceStage::Done;
+    return result;
+}
 
-NavigationQuery::NavigationQuery(NavigationMesh& navMesh)
-    : navMesh_(navMesh) {
+PathResult NavHierarchy::adaptSlicedPath(const PathResult& shared, const glm::vec3& start, const glm::vec3& end) {
+    const SlicedSearch& search = sliced_;
+    if (shared.path.empty()) {
+        return shared;
+    }
+    if (search.corridors.empty()) {
+        // The search went flat; there's nothing to reuse
+        return search.query->findPath(start, end, *search.filter);
+    }
     
-    // query_ = dtAllocNavMeshQuery();
-    // query_->init(navMesh.getNavMesh(), 2048);
+    NavigationQuery& query = *search.query;
+    PathResult result = shared;
+    std::vector<glm::vec3>& path = result.path;
+    std::vector<glm::vec3> pulled;
     
-    polyPath_.resize(MAX_POLYS);
-}
-
-NavigationQuery::~NavigationQuery() {
-    // dtFreeNavMeshQuery(query_);
+    // The last segment first, so the first one's indices stay put. Segments
+    // join at points both corridors contain, so the joins don't move.
+    size_t last = search.corridors.size() - 1;
+    size_t lastStart = search.segmentStarts[last];
+    query.buildStraightPath(search.corridors[last], last == 0 ? start : path[lastStart], end, pulled);
+    if (pulled.empty()) {
+        return search.query->findPath(start, end, *search.filter);
+    }
+    path.erase(path.begin() + lastStart, path.end());
+    path.insert(path.end(), pulled.begin(), pulled.end());
+    
+    if (last > 0) {
+        size_t firstEnd = search.segmentStarts[1];
+        query.buildStraightPath(search.corridors[0], start, path[firstEnd], pulled);
+        if (pulled.empty()) {
+            return search.query->findPath(start, end, *search.filter);
+        }
+        path.erase(path.begin(), path.begin() + firstEnd + 1);
+        path.insert(path.begin(), pulled.begin(), pulled.end());
+    }
+    return result;
 }
 
-PathResult NavigationQuery::findPath(
-    const glm::vec3& start,
-    const glm::vec3& end,
-    const NavQueryFilter& filter
-) {
-    PathResult result;
+void NavHierarchy::startSearch(SlicedSearch& search, bool useCache) {
+    search.useCache = useCache;
+    search.fromCache = false;
+    search.tileChanged = false;
+    search.segmentActive = false;
+    search.corridors.clear();
+    search.segmentStarts.clear();
+    search.result = PathResult();
     
-    if (!navMesh_.isValid()) {
-        result.status = PathResult::Status::NoPath;
-        return result;
+    if (!navMesh_.isValid() || !isLongRoute(search.start, search.end)) {
+        search.result = search.query->findPath(search.start, search.end, *search.filter);
+        search.stage = SliceStage::Done;
+        return;
     }
     
-    // Find nearest polys for start and end
-    // dtPolyRef startPoly, endPoly;
-    // float nearestPt[3];
-    // float extents[3] = { 2.0f, 4.0f, 2.0f };
-    // 
-    // dtStatus status = query_->findNearestPoly(
-    //     &start.x, extents, filter.getFilter(), &startPoly, nearestPt);
-    // 
-    // if (dtStatusFailed(status) || startPoly == 0) {
-    //     result.status = PathResult::Status::InvalidStart;
-    //     return result;
-    // }
-    // 
-    // status = query_->findNearestPoly(
-    //     &end.x, extents, filter.getFilter(), &endPoly, nearestPt);
-    // 
-    // if (dtStatusFailed(status) || endPoly == 0) {
-    //     result.status = PathResult::Status::InvalidEnd;
-    //     return result;
-    // }
-    // 
-    // // Find path
-    // int polyCount = 0;
-    // status = query_->findPath(
-    //     startPoly, endPoly,
-    //     &start.x, &end.x,
-    //     filter.getFilter(),
-    //     polyPath_.data(), &polyCount, MAX_POLYS);
-    // 
-    // if (dtStatusFailed(status) || polyCount == 0) {
-    //     result.status = PathResult::Status::NoPath;
-    //     return result;
-    // }
-    // 
-    // // Smooth path
-    // smoothPath(polyPath_, polyCount, start, end, result.path);
-    // 
-    // result.success = true;
-    // result.partial = (dtStatusDetail(status, DT_PARTIAL_RESULT));
-    // result.status = result.partial ? PathResult::Status::PartialPath : PathResult::Status::Success;
+    if (!search.query->findNearestPoly(search.start, filter_, search.startPoly, search.startOnMesh)) {
+        finishSearch(search, PathResult::Status::InvalidStart);
+        return;
+    }
+    if (!search.query->findNearestPoly(search.end, filter_, search.endPoly, search.endOnMesh)) {
+        finishSearch(search, PathResult::Status::InvalidEnd);
+        return;
+    }
     
-    // Placeholder implementation
-    result.success = true;
-    result.path.push_back(start);
-    result.path.push_back(end);
-    result.status = PathResult::Status::Success;
+    // Coarse route, from the cache if another query went between these tiles
+    const dtNavMesh* navMesh = navMesh_.getNavMesh();
+    int startX, startY, endX, endY;
+    navMesh->calcTileLoc(&search.startOnMesh.x, &startX, &startY);
+    navMesh->calcTileLoc(&search.endOnMesh.x, &endX, &endY);
     
-    return result;
+    uint64_t tilesX = static_cast<uint64_t>(std::max(1, navMesh_.getTileCountX()));
+    uint64_t routeKey = ((static_cast<uint32_t>(startY) * tilesX + static_cast<uint32_t>(startX)) << 32) |
+                        static_cast<uint32_t>(static_cast<uint32_t>(endY) * tilesX + static_cast<uint32_t>(endX));
+    
+    auto cached = useCache ? routeByKey_.find(routeKey) : routeByKey_.end();
+    if (cached != routeByKey_.end()) {
+        routes_.splice(routes_.begin(), routes_, cached->second);
+        search.route = *cached->second;
+        search.fromCache = true;
+        stats_.cacheHits++;
+        beginRefine(search);
+        return;
+    }
+    stats_.cacheMisses++;
+    search.route.key = routeKey;
+    
+    // Seed the portal search with the cost from start to each portal of its tile
+    const dtMeshTile* startTile = nullptr;
+    const dtMeshTile* endTile = nullptr;
+    const dtPoly* poly = nullptr;
+    navMesh->getTileAndPolyByRefUnsafe(static_cast<dtPolyRef>(search.startPoly), &startTile, &poly);
+    navMesh->getTileAndPolyByRefUnsafe(static_cast<dtPolyRef>(search.endPoly), &endTile, &poly);
+    
+    int startTileX = startTile->header->x, startTileY = startTile->header->y;
+    search.endX = endTile->header->x;
+    search.endY = endTile->header->y;
+    const Cluster* startCluster = getCluster(startTileX, startTileY);
+    const Cluster* endCluster = getCluster(search.endX, search.endY);
+    
+    std::vector<float> startCosts;
+    computePortalCosts(*startCluster, static_cast<uint32_t>(search.startPoly ^ startCluster->polyBase),
+                       search.startOnMesh, startCosts);
+    computePortalCosts(*endCluster, static_cast<uint32_t>(search.endPoly ^ endCluster->polyBase),
+                       search.endOnMesh, search.endCosts);
+    
+    search.nodes.clear();
+    search.open = decltype(search.open)();
+    search.goalCost = FLT_MAX;
+    search.goalParent = COARSE_NO_PARENT;
+    search.stage = SliceStage::Coarse;
+    stats_.coarseNodesExpanded = 0;
+    
+    for (uint32_t i = 0; i < startCluster->portals.size(); ++i) {
+        if (startCosts[i] < FLT_MAX) {
+            pushCoarse(search, *startCluster, startTileX, startTileY, i, false, startCosts[i], COARSE_NO_PARENT);
+        }
+    }
 }
 
-void NavigationQuery::findPathAsync(
-    const glm::vec3& start,
-    const glm::vec3& end,
-    PathCallback callback,
-    const NavQueryFilter& filter
-) {
-    // Would use a job system to compute path on background thread
-    // For now, just compute synchronously
-    PathResult result = findPath(start, end, filter);
-    callback(result);
+void NavHierarchy::advanceSearch(SlicedSearch& search, int maxIterations) {
+    switch (search.stage) {
+        case SliceStage::Coarse: advanceCoarse(search, maxIterations); break;
+        case SliceStage::Refine: advanceRefine(search, maxIterations); break;
+        case SliceStage::Done: break;
+    }
 }
 
-bool NavigationQuery::findNearestPoint(
-    const glm::vec3& point,
-    glm::vec3& outNearest,
-    float searchRadius
-) {
-    // dtPolyRef nearestPoly;
-    // float extents[3] = { searchRadius, searchRadius * 2, searchRadius };
-    // 
-    // dtStatus status = query_->findNearestPoly(
-    //     &point.x, extents, defaultFilter_.getFilter(),
-    //     &nearestPoly, &outNearest.x);
-    // 
-    // return dtStatusSucceed(status) && nearestPoly != 0;
+void NavHierarchy::pushCoarse(SlicedSearch& search, const Cluster& cluster, int tileX, int tileY,
+                              uint32_t portal, bool entered, float cost, uint64_t parent) {
+    uint64_t id = coarseNodeId(navMesh_.getTileCountX(), tileX, tileY, portal, entered);
+    CoarseNode& node = search.nodes[id];
+    if (cost >= node.cost) return;
+    node = { cost, parent, tileX, tileY, portal, entered, false };
     
-    outNearest = point;
-    outNearest.y = 0;  // Project to ground
-    return true;
-}
-
-bool NavigationQuery::raycast(
-    const glm::vec3& start,
-    const glm::vec3& end,
-    glm::vec3& outHitPoint,
-    glm::vec3& outHitNormal
-) {
-    // Would use dtNavMeshQuery::raycast
-    return false;
+    // No area costs less than minAreaCost_ per metre, so this never overestimates
+    float estimate = glm::distance(cluster.portals[portal].position, search.endOnMesh) * minAreaCost_;
+    search.open.push({ cost + estimate, -cost, id });
 }
 
-bool NavigationQuery::isPointOnNavMesh(const glm::vec3& point, float tolerance) {
-    glm::vec3 nearest;
-    if (findNearestPoint(point, nearest, tolerance)) {
-        return glm::distance(point, nearest) <= tolerance;
+void NavHierarchy::advanceCoarse(SlicedSearch& search, int maxIterations) {
+    for (int i = 0; i < maxIterations && !search.open.empty(); ++i) {
+        uint64_t id = std::get<2>(search.open.top());
+        search.open.pop();
+        if (id == COARSE_GOAL) {
+            finishCoarse(search);
+            return;
+        }
+        
+        CoarseNode& node = search.nodes[id];
+        if (node.closed) continue;
+        node.closed = true;
+        if (++stats_.coarseNodesExpanded > settings_.maxCoarseNodes) {
+            finishSearch(search, PathResult::Status::NoPath);
+            return;
+        }
+        
+        // Copy out; pushes below may rehash the node table
+        CoarseNode current = node;
+        const Cluster& cluster = *getCluster(current.tileX, current.tileY);
+        
+        if (current.entered) {
+            if (current.tileX == search.endX && current.tileY == search.endY &&
+                search.endCosts[current.portal] < FLT_MAX) {
+                float cost = current.cost + search.endCosts[current.portal];
+                if (cost < search.goalCost) {
+                    search.goalCost = cost;
+                    search.goalParent = id;
+                    search.open.push({ cost, -cost, COARSE_GOAL });
+                }
+            }
+            
+            size_t portalCount = cluster.portals.size();
+            for (uint32_t j = 0; j < portalCount; ++j) {
+                float distance = cluster.distances[current.portal * portalCount + j];
+                if (j != current.portal && distance < FLT_MAX) {
+                    pushCoarse(search, cluster, current.tileX, current.tileY, j, false, current.cost + distance, id);
+                }
+            }
+        } else {
+            const Portal& portal = cluster.portals[current.portal];
+            const Cluster* neighbour = getCluster(portal.neighbourX, portal.neighbourY);
+            int twin = findTwinPortal(*neighbour, current.tileX, current.tileY, portal.position);
+            if (twin >= 0) {
+                float distance = glm::distance(portal.position, neighbour->portals[twin].position);
+                pushCoarse(search, *neighbour, portal.neighbourX, portal.neighbourY, static_cast<uint32_t>(twin), true,
+                           current.cost + distance, id);
+            }
+        }
     }
-    return false;
-}
-
-glm::vec3 NavigationQuery::getRandomPoint() {
-    // dtPolyRef randomPoly;
-    // float pt[3];
-    // 
-    // dtStatus status = query_->findRandomPoint(
-    //     defaultFilter_.getFilter(), frand, &randomPoly, pt);
-    // 
-    // if (dtStatusSucceed(status)) {
-    //     return glm::vec3(pt[0], pt[1], pt[2]);
-    // }
     
-    return glm::vec3(0);
+    if (search.open.empty()) {
+        finishCoarse(search);
+    }
 }
 
-glm::vec3 NavigationQuery::getRandomPointInRadius(const glm::vec3& center, float radius) {
-    // Find start poly
-    // dtPolyRef startPoly;
-    // float nearestPt[3];
-    // float extents[3] = { 2, 4, 2 };
-    // 
-    // query_->findNearestPoly(&center.x, extents, defaultFilter_.getFilter(),
-    //                         &startPoly, nearestPt);
-    // 
-    // dtPolyRef randomPoly;
-    // float pt[3];
-    // 
-    // query_->findRandomPointAroundCircle(
-    //     startPoly, &center.x, radius,
-    //     defaultFilter_.getFilter(), frand,
-    //     &randomPoly, pt);
-    // 
-    // return glm::vec3(pt[0], pt[1], pt[2]);
+void NavHierarchy::finishCoarse(SlicedSearch& search) {
+    if (search.goalParent == COARSE_NO_PARENT) {
+        finishSearch(search, PathResult::Status::NoPath);
+        return;
+    }
     
-    return center;
+    // Walk back, keeping the portal each tile is left by
+    Route& route = search.route;
+    route.exits.clear();
+    route.tiles.clear();
+    for (uint64_t id = search.goalParent; id != COARSE_NO_PARENT;) {
+        const CoarseNode& node = search.nodes[id];
+        if (!node.entered) {
+            route.exits.push_back(getCluster(node.tileX, node.tileY)->portals[node.portal].position);
+            route.tiles.push_back(makeTileKey(node.tileX, node.tileY));
+        }
+        id = node.parent;
+    }
+    route.tiles.push_back(makeTileKey(search.endX, search.endY));
+    std::reverse(route.exits.begin(), route.exits.end());
+    
+    auto existing = routeByKey_.find(route.key);
+    if (existing != routeByKey_.end()) {
+        routes_.erase(existing->second);
+    }
+    routes_.push_front(route);
+    routeByKey_[route.key] = routes_.begin();
+    
+    while (routes_.size() > settings_.cacheCapacity) {
+        routeByKey_.erase(routes_.back().key);
+        routes_.pop_back();
+    }
+    
+    beginRefine(search);
 }
 
-bool NavigationQuery::projectToNavMesh(const glm::vec3& point, glm::vec3& outProjected, float searchHeight) {
-    return findNearestPoint(point, outProjected, searchHeight);
+void NavHierarchy::beginRefine(SlicedSearch& search) {
+    // Refine with local searches between portals a few tiles apart
+    search.waypoints.clear();
+    int span = std::max(1, settings_.refineSpan);
+    for (size_t i = span - 1; i < search.route.exits.size(); i += span) {
+        search.waypoints.push_back(search.route.exits[i]);
+    }
+    search.waypoints.push_back(search.endOnMesh);
+    
+    search.waypoint = 0;
+    search.from = search.startOnMesh;
+    search.segmentActive = false;
+    search.corridors.clear();
+    search.segmentStarts.clear();
+    search.stage = SliceStage::Refine;
 }
 
-void NavigationQuery::smoothPath(
-    const std::vector<uint64_t>& polys,
-    int polyCount,
-    const glm::vec3& start,
-    const glm::vec3& end,
-    std::vector<glm::vec3>& outPath
-) {
-    if (polyCount == 0) return;
+void NavHierarchy::advanceRefine(SlicedSearch& search, int maxIterations) {
+    NavigationQuery& query = *search.query;
+    const NavQueryFilter& filter = *search.filter;
+    PathResult segment;
+    std::vector<uint64_t> polys;
     
-    // String pulling algorithm (Detour's findStraightPath)
-    // This creates a smooth path by finding the shortest path through the portal edges
+    if (!search.segmentActive) {
+        uint64_t fromPoly = 0;
+        if (!query.findNearestPoly(search.from, filter, fromPoly, search.segmentStart)) {
+            segment.status = PathResult::Status::InvalidStart;
+        } else if (!query.findNearestPoly(search.waypoints[search.waypoint], filter,
+                                          search.segmentEndPoly, search.segmentEnd)) {
+            segment.status = PathResult::Status::InvalidEnd;
+        } else {
+            search.segmentActive = query.beginSlicedPath(fromPoly, search.segmentEndPoly,
+                                                         search.segmentStart, search.segmentEnd, filter);
+        }
+    }
     
-    // float straightPath[MAX_SMOOTH * 3];
-    // unsigned char straightPathFlags[MAX_SMOOTH];
-    // dtPolyRef straightPathPolys[MAX_SMOOTH];
-    // int straightPathCount = 0;
-    // 
-    // query_->findStraightPath(
-    //     &start.x, &end.x,
-    //     polys.data(), polyCount,
-    //     straightPath, straightPathFlags, straightPathPolys,
-    //     &straightPathCount, MAX_SMOOTH);
-    // 
-    // outPath.reserve(straightPathCount);
-    // for (int i = 0; i < straightPathCount; ++i) {
-    //     outPath.push_back(glm::vec3(
-    //         straightPath[i * 3],
-    //         straightPath[i * 3 + 1],
-    //         straightPath[i * 3 + 2]
-    //     ));
-    // }
+    if (search.segmentActive) {
+        NavigationQuery::SliceStatus status = query.updateSlicedPath(maxIterations);
+        if (status == NavigationQuery::SliceStatus::InProgress) return;
+        search.segmentActive = false;
+        
+        bool partial = false;
+        if (status == NavigationQuery::SliceStatus::Done && query.finishSlicedPath(polys, partial)) {
+            query.buildStraightPath(polys, search.segmentStart, search.segmentEnd, segment.path);
+            segment.success = !segment.path.empty();
+            segment.partial = partial || polys.back() != search.segmentEndPoly;
+            segment.status = !segment.success ? PathResult::Status::NoPath
+                           : segment.partial ? PathResult::Status::PartialPath
+                                             : PathResult::Status::Success;
+        }
+    }
+    
+    PathResult& result = search.result;
+    bool last = search.waypoint + 1 == search.waypoints.size();
+    if (!segment.success || (segment.partial && !last)) {
+        // A cached route may not suit this start; plan from scratch
+        if (search.fromCache) {
+            startSearch(search, false);
+        } else if (result.path.empty()) {
+            finishSearch(search, segment.status);
+        } else {
+            finishSearch(search, PathResult::Status::PartialPath);
+        }
+        return;
+    }
+    
+    search.segmentStarts.push_back(result.path.empty() ? 0 : result.path.size() - 1);
+    search.corridors.push_back(std::move(polys));
+    result.path.insert(result.path.end(),
+                       segment.path.begin() + (result.path.empty() ? 0 : 1), segment.path.end());
+    search.from = segment.path.back();
     
-    // Placeholder
-    outPath.push_back(start);
-    outPath.push_back(end);
+    if (last) {
+        finishSearch(search, segment.partial ? PathResult::Status::PartialPath : PathResult::Status::Success);
+    } else {
+        search.waypoint++;
+    }
+}
+
+void NavHierarchy::finishSearch(SlicedSearch& search, PathResult::Status status) {
+    PathResult& result = search.result;
+    result.status = status;
+    result.success = !result.path.empty();
+    result.partial = status == PathResult::Status::PartialPath;
+    search.stage = SliceStage::Done;
 }
 
 // ============================================================================
@@ -598,13 +2311,29 @@ NavigationSystem::NavigationSystem() {
 void NavigationSystem::init(World& world) {
     // Initialize if we have a NavMesh
     if (navMesh_ && navMesh_->isValid()) {
+        hierarchy_ = std::make_unique<NavHierarchy>(*navMesh_);
         query_ = std::make_unique<NavigationQuery>(*navMesh_);
+        query_->setHierarchy(hierarchy_.get());
         crowd_ = std::make_unique<CrowdManager>(*navMesh_);
         crowd_->initialize(128);
     }
+    resetPathQueue();
 }
 
 void NavigationSystem::update(World& world, float deltaTime) {
+    if (navMesh_ && navMeshFromWorld_) {
+        if (runtimeRebuild_) {
+            rebuildTimer_ += deltaTime;
+            if (rebuildTimer_ >= rebuildInterval_) {
+                rebuildTimer_ = 0.0f;
+                detectGeometryChanges(world);
+            }
+        }
+        
+        // Swap in a few finished tiles; the rest wait for later frames
+        navMesh_->applyRebuiltTiles(MAX_TILE_SWAPS_PER_FRAME);
+    }
+    
     processPathRequests(world);
     updatePathFollowing(world, deltaTime);
     
@@ -615,18 +2344,45 @@ void NavigationSystem::update(World& world, float deltaTime) {
 }
 
 void NavigationSystem::shutdown(World& world) {
+    pathQueue_.reset();
+    submittedPaths_.clear();
     query_.reset();
+    hierarchy_.reset();
     crowd_.reset();
 }
 
 void NavigationSystem::setNavMesh(std::shared_ptr<NavigationMesh> navMesh) {
+    // These refer to the old NavMesh; drop them before it can go away
+    pathQueue_.reset();
+    query_.reset();
+    hierarchy_.reset();
+    
     navMesh_ = navMesh;
+    navMeshFromWorld_ = false;
+    geometrySources_.clear();
     
     if (navMesh_ && navMesh_->isValid()) {
+        hierarchy_ = std::make_unique<NavHierarchy>(*navMesh_);
         query_ = std::make_unique<NavigationQuery>(*navMesh_);
+        query_->setHierarchy(hierarchy_.get());
         crowd_ = std::make_unique<CrowdManager>(*navMesh_);
         crowd_->initialize(128);
     }
+    resetPathQueue();
+}
+
+void NavigationSystem::resetPathQueue() {
+    pathQueue_.reset();
+    if (navMesh_ && navMesh_->isValid()) {
+        pathQueue_ = std::make_unique<PathRequestQueue>(*navMesh_, pathQueryContexts_);
+        pathQueue_->setHierarchy(hierarchy_.get());
+    }
+    
+    // Requests the old queue never answered start over
+    for (const auto& [ticket, submitted] : submittedPaths_) {
+        pendingRequests_.push({ submitted.handle.index, submitted.target });
+    }
+    submittedPaths_.clear();
 }
 
 void NavigationSystem::requestPath(Entity entity, const glm::vec3& target) {
@@ -643,8 +2399,9 @@ bool NavigationSystem::hasReachedDestination(Entity entity) const {
 }
 
 void NavigationSystem::processPathRequests(World& world) {
-    if (!query_) return;
+    if (!pathQueue_) return;
     
+    // Hand new requests to the queue; searching happens within the budget
     while (!pendingRequests_.empty()) {
         auto request = pendingRequests_.front();
         pendingRequests_.pop();
@@ -654,27 +2411,50 @@ void NavigationSystem::processPathRequests(World& world) {
         
         if (!nav || !transform) continue;
         
-        NavQueryFilter filter;
-        if (nav->filter) {
-            filter = *nav->filter;
+        // A newer request replaces one still in flight
+        if (nav->pathPending && nav->pathTicket != 0) {
+            pathQueue_->cancel(nav->pathTicket);
+            submittedPaths_.erase(nav->pathTicket);
         }
         
-        PathResult result = query_->findPath(transform->position, request.target, filter);
+        nav->pathTicket = pathQueue_->submit(transform->position, request.target, nav->filter);
+        nav->pathPending = true;
+        submittedPaths_[nav->pathTicket] = { world.getHandle(request.entity), request.target };
+    }
+    
+    completedPaths_.clear();
+    pathQueue_->update(pathBudgetUs_, pathPriorityOrigin_, completedPaths_);
+    
+    for (const auto& completed : completedPaths_) {
+        auto it = submittedPaths_.find(completed.ticket);
+        if (it == submittedPaths_.end()) continue;
+        SubmittedPath submitted = it->second;
+        submittedPaths_.erase(it);
+        
+        // The entity may have been destroyed or re-requested meanwhile
+        Entity entity = world.resolve(submitted.handle);
+        auto* nav = entity != INVALID_ENTITY ? world.tryGetComponent<NavigationComponent>(entity) : nullptr;
+        if (!nav || nav->pathTicket != completed.ticket) continue;
+        
+        nav->pathPending = false;
+        nav->pathTicket = 0;
         
+        const PathResult& result = completed.result;
         if (result.success) {
             nav->path = result.path;
             nav->currentWaypoint = 0;
-            nav->targetPosition = request.target;
+            nav->targetPosition = submitted.target;
             nav->hasTarget = true;
             nav->isMoving = true;
             nav->reachedDestination = false;
-            nav->pathPending = false;
         }
     }
 }
 
 void NavigationSystem::updatePathFollowing(World& world, float deltaTime) {
-    for (auto& [entity, transform, nav] : world.query<Transform, NavigationComponent>()) {
+    TransformSystem* transforms = world.getSystem<TransformSystem>();
+    
+    for (auto&& [entity, transform, nav] : world.query<Transform, NavigationComponent>()) {
         // Skip if using crowd navigation
         if (nav.crowdAgentId >= 0) continue;
         
@@ -727,6 +2507,7 @@ void NavigationSystem::updatePathFollowing(World& world, float deltaTime) {
             
             transform.rotation = glm::angleAxis(currentYaw + turn, glm::vec3(0, 1, 0));
         }
+        if (transforms) transforms->markDirty(entity);
         
         nav.isMoving = true;
     }
@@ -735,7 +2516,9 @@ void NavigationSystem::updatePathFollowing(World& world, float deltaTime) {
 void NavigationSystem::updateCrowdAgents(World& world, float deltaTime) {
     if (!crowd_) return;
     
-    for (auto& [entity, transform, nav] : world.query<Transform, NavigationComponent>()) {
+    TransformSystem* transforms = world.getSystem<TransformSystem>();
+    
+    for (auto&& [entity, transform, nav] : world.query<Transform, NavigationComponent>()) {
         if (nav.crowdAgentId < 0) continue;
         
         CrowdAgentState state = crowd_->getAgentState(nav.crowdAgentId);
@@ -749,6 +2532,7 @@ void NavigationSystem::updateCrowdAgents(World& world, float deltaTime) {
                 float yaw = std::atan2(-dir.x, -dir.z);
                 transform.rotation = glm::angleAxis(yaw, glm::vec3(0, 1, 0));
             }
+            if (transforms) transforms->markDirty(entity);
             
             nav.isMoving = glm::length(state.velocity) > 0.1f;
             nav.reachedDestination = state.reachedTarget;
@@ -756,27 +2540,177 @@ void NavigationSystem::updateCrowdAgents(World& world, float deltaTime) {
     }
 }
 
+namespace {
+
+glm::mat4 computeWorldMatrix(World& world, Entity entity) {
+    glm::mat4 matrix(1.0f);
+    while (entity != INVALID_ENTITY) {
+        auto* transform = world.tryGetComponent<Transform>(entity);
+        if (!transform) break;
+        matrix = transform->getLocalMatrix() * matrix;
+        entity = transform->parent;
+    }
+    return matrix;
+}
+
+// World-space corners of a collider's box; spheres and capsules use their
+// bounding box. Corner i has max x/y/z where bit 0/1/2 of i is set.
+bool getColliderCorners(const glm::mat4& worldMatrix, const Collider& collider, glm::vec3 outCorners[8]) {
+    glm::vec3 halfExtent;
+    switch (collider.type) {
+        case Collider::Type::Box:
+            halfExtent = collider.size * 0.5f;
+            break;
+        case Collider::Type::Sphere:
+            halfExtent = glm::vec3(collider.radius);
+            break;
+        case Collider::Type::Capsule:
+            halfExtent = glm::vec3(collider.radius, std::max(collider.height * 0.5f, collider.radius), collider.radius);
+            break;
+        default:
+            return false;  // Mesh colliders carry no geometry here
+    }
+    
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 local = collider.center + glm::vec3((i & 1) ? halfExtent.x : -halfExtent.x,
+                                                      (i & 2) ? halfExtent.y : -halfExtent.y,
+                                                      (i & 4) ? halfExtent.z : -halfExtent.z);
+        outCorners[i] = glm::vec3(worldMatrix * glm::vec4(local, 1.0f));
+    }
+    return true;
+}
+
+void addColliderTriangles(NavMeshInputGeometry& geometry, const glm::mat4& worldMatrix, const Collider& collider) {
+    glm::vec3 corners[8];
+    if (!getColliderCorners(worldMatrix, collider, corners)) return;
+    
+    static const int faces[6][4] = {
+        {0, 2, 6, 4}, {1, 3, 7, 5},     // -X, +X
+        {0, 1, 5, 4}, {2, 3, 7, 6},     // -Y, +Y
+        {0, 1, 3, 2}, {4, 5, 7, 6}      // -Z, +Z
+    };
+    
+    glm::vec3 center(0.0f);
+    for (const glm::vec3& corner : corners) center += corner * 0.125f;
+    
+    // Recast treats a triangle as floor when its normal points up, so wind
+    // every triangle to face out of the box
+    auto addOutward = [&](const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+        glm::vec3 normal = glm::cross(b - a, c - a);
+        if (glm::dot(normal, (a + b + c) / 3.0f - center) >= 0.0f) {
+            geometry.addTriangle(a, b, c);
+        } else {
+            geometry.addTriangle(a, c, b);
+        }
+    };
+    
+    for (const auto& face : faces) {
+        addOutward(corners[face[0]], corners[face[1]], corners[face[2]]);
+        addOutward(corners[face[0]], corners[face[2]], corners[face[3]]);
+    }
+}
+
+bool sameCollider(const Collider& a, const Collider& b) {
+    return a.type == b.type && a.center == b.center && a.size == b.size &&
+           a.radius == b.radius && a.height == b.height;
+}
+
+} // namespace
+
+void NavigationSystem::scanGeometrySources(World& world, std::unordered_map<Entity, NavGeometrySource>& outSources) {
+    outSources.clear();
+    
+    for (auto&& [entity, transform, collider] : world.query<Transform, Collider>()) {
+        if (collider.isTrigger) continue;
+        
+        // Simulated bodies would keep dirtying tiles; only static and
+        // kinematic colliders shape the NavMesh
+        auto* body = world.tryGetComponent<RigidBody>(entity);
+        if (body && body->type == RigidBody::Type::Dynamic && !body->isKinematic) continue;
+        
+        NavGeometrySource source;
+        source.handle = world.getHandle(entity);
+        source.worldMatrix = computeWorldMatrix(world, entity);
+        source.collider = collider;
+        
+        glm::vec3 corners[8];
+        if (!getColliderCorners(source.worldMatrix, collider, corners)) continue;
+        
+        source.bounds.min = glm::vec3(FLT_MAX);
+        source.bounds.max = glm::vec3(-FLT_MAX);
+        for (const glm::vec3& corner : corners) {
+            source.bounds.min = glm::min(source.bounds.min, corner);
+            source.bounds.max = glm::max(source.bounds.max, corner);
+        }
+        
+        outSources[entity] = source;
+    }
+}
+
+void NavigationSystem::detectGeometryChanges(World& world) {
+    std::unordered_map<Entity, NavGeometrySource> sources;
+    scanGeometrySources(world, sources);
+    
+    // Tiles under both the old and new footprint of anything that changed
+    std::vector<NavMeshBounds> dirtyBounds;
+    for (const auto& [entity, source] : sources) {
+        auto it = geometrySources_.find(entity);
+        if (it == geometrySources_.end()) {
+            dirtyBounds.push_back(source.bounds);
+            continue;
+        }
+        
+        const NavGeometrySource& previous = it->second;
+        if (previous.handle != source.handle || previous.worldMatrix != source.worldMatrix ||
+            !sameCollider(previous.collider, source.collider)) {
+            dirtyBounds.push_back(previous.bounds);
+            dirtyBounds.push_back(source.bounds);
+        }
+    }
+    for (const auto& [entity, previous] : geometrySources_) {
+        if (sources.find(entity) == sources.end()) {
+            dirtyBounds.push_back(previous.bounds);
+        }
+    }
+    
+    geometrySources_ = std::move(sources);
+    if (dirtyBounds.empty()) return;
+    
+    // The background thread keeps this snapshot alive while it builds
+    auto geometry = std::make_shared<NavMeshInputGeometry>();
+    for (const auto& [entity, source] : geometrySources_) {
+        addColliderTriangles(*geometry, source.worldMatrix, source.collider);
+    }
+    navMesh_->rebuildTilesAsync(geometry, dirtyBounds);
+}
+
 bool NavigationSystem::buildNavMeshFromWorld(World& world, const NavMeshSettings& settings) {
-    NavMeshInputGeometry geometry;
+    std::unordered_map<Entity, NavGeometrySource> sources;
+    scanGeometrySources(world, sources);
     
-    // Collect geometry from world
-    // Would iterate through static meshes and add their triangles
+    NavMeshInputGeometry geometry;
+    for (const auto& [entity, source] : sources) {
+        addColliderTriangles(geometry, source.worldMatrix, source.collider);
+    }
+    if (geometry.indices.empty()) {
+        return false;
+    }
     
-    // For now, just create a simple ground plane
-    float size = 100.0f;
-    geometry.addTriangle(
-        glm::vec3(-size, 0, -size),
-        glm::vec3(size, 0, -size),
-        glm::vec3(-size, 0, size)
-    );
-    geometry.addTriangle(
-        glm::vec3(size, 0, -size),
-        glm::vec3(size, 0, size),
-        glm::vec3(-size, 0, size)
-    );
+    auto navMesh = std::make_shared<NavigationMesh>();
+    if (!navMesh->build(geometry, settings)) {
+        return false;
+    }
     
-    navMesh_ = std::make_shared<NavigationMesh>();
-    return navMesh_->build(geometry, settings);
+    setNavMesh(navMesh);
+    navMeshFromWorld_ = true;
+    geometrySources_ = std::move(sources);
+    rebuildTimer_ = 0.0f;
+    return true;
+}
+
+void NavigationSystem::setRuntimeRebuild(bool enabled, float interval) {
+    runtimeRebuild_ = enabled;
+    rebuildInterval_ = interval;
 }
 
 } // namespace Sanic
@@ -6,10 +6,13 @@
  * Features:
  * - NavMesh generation from level geometry
  * - Pathfinding with A* through Detour
+ * - Time-sliced, prioritized path request queue with request coalescing
+ * - Hierarchical tile-portal search with an LRU route cache for long paths
  * - Path smoothing and string-pulling
  * - Dynamic obstacle avoidance
  * - Off-mesh links (jumps, ladders, etc.)
  * - NavMesh streaming for large worlds
+ * - Parallel tile builds; background rebuilds of tiles under changed geometry
  * 
  * Reference:
  *   Engine/Source/Runtime/NavigationSystem/
@@ -28,6 +31,15 @@
 #include <functional>
 #include <unordered_map>
 #include <queue>
+#include <tuple>
+#include <list>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cfloat>
+#include <chrono>
+#include <algorithm>
 
 // Forward declarations for Recast/Detour
 struct rcConfig;
@@ -79,6 +91,14 @@ struct NavMeshSettings {
     float tileSize = 48.0f;           // Tile size in cells
 };
 
+/**
+ * World-space box marking where navigation geometry changed
+ */
+struct NavMeshBounds {
+    glm::vec3 min = glm::vec3(0);
+    glm::vec3 max = glm::vec3(0);
+};
+
 /**
  * Input geometry for NavMesh building
  */
@@ -126,8 +146,18 @@ struct OffMeshConnection {
     float costMultiplier = 1.0f;
 };
 
+// Tile build inputs shared by all tiles of one build (defined in the .cpp)
+struct NavMeshBuildContext;
+class NavHierarchy;
+
 /**
  * Navigation mesh manager
+ *
+ * Tiles are voxelized with Recast and stored in a Detour NavMesh. build()
+ * builds every tile in parallel on the JobSystem. At runtime,
+ * rebuildTilesAsync() rebuilds just the tiles under changed geometry on a
+ * background thread; applyRebuiltTiles() then swaps them in on the thread
+ * that runs queries.
  */
 class NavigationMesh {
 public:
@@ -135,12 +165,13 @@ public:
     ~NavigationMesh();
     
     /**
-     * Build NavMesh from geometry
+     * Build NavMesh from geometry. Replaces any previous NavMesh and
+     * cancels pending background rebuilds.
      */
     bool build(const NavMeshInputGeometry& geometry, const NavMeshSettings& settings = {});
     
     /**
-     * Build a single tile (for streaming)
+     * Build a single tile of the current grid and swap it in (for streaming)
      */
     bool buildTile(int tileX, int tileY, const NavMeshInputGeometry& geometry);
     
@@ -149,6 +180,43 @@ public:
      */
     void removeTile(int tileX, int tileY);
     
+    /**
+     * Queue a background rebuild of the tiles overlapping dirtyBounds, using
+     * geometry as the new source (nullptr keeps the previous call's). Pass
+     * both the old and new bounds of moved geometry, and the bounds of
+     * destroyed geometry. Tiles outside the grid of the last build() are
+     * ignored.
+     */
+    void rebuildTilesAsync(std::shared_ptr<const NavMeshInputGeometry> geometry,
+                           const std::vector<NavMeshBounds>& dirtyBounds);
+    
+    /**
+     * Swap up to maxTiles finished background tiles into the NavMesh.
+     * Must be called on the thread that queries the NavMesh.
+     * @return Number of tiles swapped
+     */
+    uint32_t applyRebuiltTiles(uint32_t maxTiles = UINT32_MAX);
+    
+    /**
+     * Tiles queued, building, or waiting for applyRebuiltTiles()
+     */
+    uint32_t getPendingTileCount() const;
+    
+    /**
+     * Listeners run whenever a tile is added, replaced or removed, with its
+     * coordinates, and once with (-1, -1) after build() replaces every tile.
+     * They run on the thread that changed the NavMesh.
+     */
+    using TileChangedCallback = std::function<void(int tileX, int tileY)>;
+    uint32_t addTileChangedListener(TileChangedCallback callback);
+    void removeTileChangedListener(uint32_t listenerId);
+    
+    /**
+     * Tile grid of the last build()
+     */
+    int getTileCountX() const { return tilesX_; }
+    int getTileCountY() const { return tilesY_; }
+    
     /**
      * Add off-mesh connection
      */
@@ -200,9 +268,34 @@ private:
     
     std::vector<OffMeshConnection> offMeshConnections_;
     
+    int tilesX_ = 0;
+    int tilesY_ = 0;
+    
+    std::vector<std::pair<uint32_t, TileChangedCallback>> tileListeners_;
+    uint32_t nextListenerId_ = 1;
+    
+    // Background tile rebuilds. Everything below is guarded by rebuildMutex_.
+    std::thread rebuildThread_;
+    mutable std::mutex rebuildMutex_;
+    std::condition_variable rebuildCondition_;
+    std::shared_ptr<const NavMeshBuildContext> buildContext_;
+    std::shared_ptr<const NavMeshInputGeometry> rebuildGeometry_;
+    std::set<uint64_t> dirtyTiles_;
+    std::unordered_map<uint64_t, NavMeshTile> rebuiltTiles_;
+    uint32_t tilesInFlight_ = 0;
+    uint32_t buildGeneration_ = 0;       // Bumped by build(); older results are dropped
+    bool rebuildShutdown_ = false;
+    
     // Build helpers
     bool buildSingleTile(const NavMeshInputGeometry& geometry);
     bool buildTiledMesh(const NavMeshInputGeometry& geometry);
+    bool buildTiles(const NavMeshInputGeometry& geometry, int tileCells);
+    bool addTileData(const NavMeshTile& tile);
+    bool replaceTile(const NavMeshTile& tile);
+    void queueDirtyTiles(const NavMeshBounds& bounds);
+    void rebuildThreadFunc();
+    void stopRebuildThread();
+    void notifyTileChanged(int tileX, int tileY);
 };
 
 // ============================================================================
@@ -217,6 +310,9 @@ public:
     NavQueryFilter();
     ~NavQueryFilter();
     
+    NavQueryFilter(const NavQueryFilter& other);
+    NavQueryFilter& operator=(const NavQueryFilter& other);
+    
     /**
      * Set area cost (higher = harder to traverse)
      */
@@ -273,7 +369,8 @@ public:
     ~NavigationQuery();
     
     /**
-     * Find path between two points
+     * Find path between two points. Long routes go through the hierarchy,
+     * if one is set.
      */
     PathResult findPath(
         const glm::vec3& start,
@@ -281,6 +378,11 @@ public:
         const NavQueryFilter& filter = NavQueryFilter()
     );
     
+    /**
+     * Use hierarchy for routes it considers long (nullptr to disable)
+     */
+    void setHierarchy(NavHierarchy* hierarchy) { hierarchy_ = hierarchy; }
+    
     /**
      * Find path asynchronously
      */
@@ -331,22 +433,387 @@ public:
      */
     bool projectToNavMesh(const glm::vec3& point, glm::vec3& outProjected, float searchHeight = 5.0f);
     
+    /**
+     * Find the polygon nearest to point and the closest point on it
+     */
+    bool findNearestPoly(const glm::vec3& point, const NavQueryFilter& filter,
+                         uint64_t& outPoly, glm::vec3& outNearest);
+    
+    /**
+     * Sliced A*: begin a search, advance it a bounded number of nodes per
+     * call, then collect the polygon corridor. One search per query at a
+     * time. The filter must outlive the search.
+     */
+    enum class SliceStatus { InProgress, Done, Failed };
+    bool beginSlicedPath(uint64_t startPoly, uint64_t endPoly,
+                         const glm::vec3& start, const glm::vec3& end,
+                         const NavQueryFilter& filter);
+    SliceStatus updateSlicedPath(int maxIterations);
+    bool finishSlicedPath(std::vector<uint64_t>& outPolys, bool& outPartial);
+    
+    /**
+     * String-pull a polygon corridor into waypoints. start and end are
+     * clamped to the first and last polygon.
+     */
+    void buildStraightPath(const std::vector<uint64_t>& polys,
+                           const glm::vec3& start, const glm::vec3& end,
+                           std::vector<glm::vec3>& outPath);
+    
 private:
     NavigationMesh& navMesh_;
     dtNavMeshQuery* query_ = nullptr;
+    NavHierarchy* hierarchy_ = nullptr;
     
     // Path finding internals
     static const int MAX_POLYS = 256;
     static const int MAX_SMOOTH = 2048;
+    static const int MAX_SEARCH_NODES = 2048;
     
     std::vector<uint64_t> polyPath_;
     
+    // Re-attach the query if the NavMesh was rebuilt; false if there is none
+    bool ensureQuery();
+    
     // String pulling for path smoothing
     void smoothPath(const std::vector<uint64_t>& polys, int polyCount,
                     const glm::vec3& start, const glm::vec3& end,
                     std::vector<glm::vec3>& outPath);
 };
 
+/**
+ * Asynchronous path requests served by time-sliced A*
+ *
+ * Each update() spends at most a fixed budget advancing searches,
+ * ITERATIONS_PER_SLICE nodes between budget checks, so a burst of requests
+ * is spread over frames instead of stalling one. Pending requests closest
+ * to the priority origin (usually the player) start first. Requests that
+ * resolve to the same start polygon, end polygon and filter share a single
+ * search.
+ *
+ * With more than one query context, contexts advance their searches in
+ * parallel on the JobSystem, each with its own NavigationQuery. Long routes
+ * go to the NavHierarchy, if one is set, whose sliced search advances
+ * alongside the contexts under the same deadline. update() returns only
+ * after they are done, so tile swaps never overlap a search.
+ */
+class PathRequestQueue {
+public:
+    struct CompletedPath {
+        uint32_t ticket = 0;
+        PathResult result;
+    };
+    
+    struct Stats {
+        uint32_t pendingRequests = 0;
+        uint32_t activeSearches = 0;
+        uint32_t searchesCompleted = 0;     // Last update
+        uint32_t requestsCoalesced = 0;     // Last update
+        float updateTimeUs = 0.0f;          // Last update
+    };
+    
+    // A* nodes expanded between budget checks
+    static constexpr int ITERATIONS_PER_SLICE = 32;
+    
+    explicit PathRequestQueue(NavigationMesh& navMesh, uint32_t queryContextCount = 1);
+    ~PathRequestQueue();
+    
+    /**
+     * Queue a path request. A null filter uses the default filter.
+     * @return Ticket identifying the result, never 0
+     */
+    uint32_t submit(const glm::vec3& start, const glm::vec3& end,
+                    std::shared_ptr<const NavQueryFilter> filter = nullptr);
+    
+    /**
+     * Drop a request; its result is never delivered
+     */
+    void cancel(uint32_t ticket);
+    
+    /**
+     * Answer long requests with hierarchy instead of sliced A*, in the
+     * same budget (nullptr to disable). Requests already routed to the
+     * previous hierarchy are classified again.
+     */
+    void setHierarchy(NavHierarchy* hierarchy);
+    
+    /**
+     * Advance searches for at most budgetUs microseconds (per context) and
+     * append finished requests to outCompleted
+     */
+    void update(float budgetUs, const glm::vec3& priorityOrigin, std::vector<CompletedPath>& outCompleted);
+    
+    uint32_t getPendingCount() const;
+    const Stats& getStats() const { return stats_; }
+    
+private:
+    using Clock = std::chrono::high_resolution_clock;
+    
+    struct Request {
+        uint32_t ticket = 0;
+        glm::vec3 start = glm::vec3(0);
+        glm::vec3 end = glm::vec3(0);
+        std::shared_ptr<const NavQueryFilter> filter;
+        
+        // Nearest polygons, found before the request can be dispatched
+        bool resolved = false;
+        bool longRoute = false;         // Served by the hierarchy
+        uint64_t startPoly = 0;
+        uint64_t endPoly = 0;
+    };
+    
+    // One A* search shared by every request with the same key
+    struct Search {
+        uint64_t startPoly = 0;
+        uint64_t endPoly = 0;
+        std::shared_ptr<const NavQueryFilter> filter;
+        glm::vec3 start = glm::vec3(0);
+        glm::vec3 end = glm::vec3(0);
+        bool longRoute = false;
+        bool restarted = false;
+        std::vector<Request> waiters;
+    };
+    
+    struct QueryContext {
+        std::unique_ptr<NavigationQuery> query;
+        std::shared_ptr<Search> search;
+    };
+    
+    NavigationMesh& navMesh_;
+    NavHierarchy* hierarchy_ = nullptr;
+    std::shared_ptr<Search> hierarchySearch_;   // On hierarchy_; also in activeSearches_
+    std::vector<QueryContext> contexts_;
+    std::shared_ptr<const NavQueryFilter> defaultFilter_;
+    
+    // Guards everything below while contexts run in parallel
+    mutable std::mutex mutex_;
+    std::vector<Request> pending_;          // Nearest the priority origin first
+    std::vector<std::shared_ptr<Search>> activeSearches_;
+    std::vector<CompletedPath>* completed_ = nullptr;
+    uint32_t nextTicket_ = 1;
+    Stats stats_;
+    
+    void resolvePending(Clock::time_point deadline);
+    void runContext(QueryContext& context, Clock::time_point deadline);
+    bool dispatchNext(QueryContext& context);
+    bool restartSearch(QueryContext& context);
+    void completeSearch(QueryContext& context, bool found);
+    std::shared_ptr<Search> takeSearch(bool longRoute);
+    void runHierarchy(Clock::time_point deadline);
+    void completeHierarchySearch();
+};
+
+// ============================================================================
+// HIERARCHICAL PATHFINDING
+// ============================================================================
+
+struct NavHierarchySettings {
+    int flatSearchTileDistance = 2;     // Closer than this (in tiles) uses plain A*
+    int refineSpan = 4;                 // Tiles crossed per local refinement search
+    uint32_t cacheCapacity = 256;       // Portal routes kept, least recently used evicted
+    uint32_t maxCoarseNodes = 65536;    // Portal expansions before giving up
+};
+
+/**
+ * Two-level pathfinding for long routes
+ *
+ * Each NavMesh tile is a cluster. Each contiguous run of polygon edges
+ * shared with a neighbouring tile is a portal, and the travel cost between
+ * every pair of portals in a tile is precomputed over the tile's polygon
+ * graph. A query searches this portal graph, then refines the route with
+ * short A* searches between portals a few tiles apart, so search cost grows
+ * with the number of tiles crossed rather than polygons.
+ *
+ * Portal routes are cached per (start tile, end tile), so agents heading
+ * the same way reuse the coarse search. Clusters are built on first use
+ * (or all at once with precompute()); changing a tile discards it, its
+ * neighbours and every cached route through them.
+ *
+ * Portal costs use the filter given at construction. Not thread-safe; use
+ * it from the thread that updates the NavMesh.
+ */
+class NavHierarchy {
+public:
+    struct Stats {
+        uint32_t cacheHits = 0;
+        uint32_t cacheMisses = 0;
+        uint32_t clustersBuilt = 0;
+        uint32_t coarseNodesExpanded = 0;   // Last coarse search
+    };
+    
+    NavHierarchy(NavigationMesh& navMesh, const NavQueryFilter& filter = NavQueryFilter(),
+                 const NavHierarchySettings& settings = {});
+    ~NavHierarchy();
+    
+    NavHierarchy(const NavHierarchy&) = delete;
+    NavHierarchy& operator=(const NavHierarchy&) = delete;
+    
+    /**
+     * Whether start and end are far enough apart for a hierarchical search
+     */
+    bool isLongRoute(const glm::vec3& start, const glm::vec3& end) const;
+    
+    /**
+     * Find a path through the portal graph. filter applies to refinement.
+     */
+    PathResult findPath(const glm::vec3& start, const glm::vec3& end,
+                        const NavQueryFilter& filter = NavQueryFilter());
+    
+    /**
+     * Sliced findPath: begin a search, advance it by up to maxIterations
+     * portal or polygon expansions per call until it returns Done, then
+     * collect the result. One search at a time, independent of findPath().
+     * The filter must outlive the search. A coarse search under a changed
+     * tile restarts once, then gives up.
+     */
+    void beginSlicedPath(const glm::vec3& start, const glm::vec3& end, const NavQueryFilter& filter);
+    NavigationQuery::SliceStatus updateSlicedPath(int maxIterations);
+    PathResult finishSlicedPath();
+    
+    /**
+     * The path finishSlicedPath() returned, string-pulled again for other
+     * endpoints in the same start and end polygons (requests that shared
+     * the search). Only the first and last refined segments change. Valid
+     * until the next beginSlicedPath().
+     */
+    PathResult adaptSlicedPath(const PathResult& shared, const glm::vec3& start, const glm::vec3& end);
+    
+    /**
+     * Build every cluster now, in parallel, instead of on first use
+     */
+    void precompute();
+    
+    /**
+     * Drop all clusters and cached routes
+     */
+    void clear();
+    
+    const Stats& getStats() const { return stats_; }
+    
+private:
+    // One contiguous stretch of border shared with a neighbouring tile,
+    // represented by the polygon edge nearest its middle
+    struct Portal {
+        uint32_t polyIndex = 0;         // Polygon on this side, within the tile
+        glm::vec3 position = glm::vec3(0);
+        int neighbourX = 0;             // Tile on the other side
+        int neighbourY = 0;
+    };
+    
+    struct Cluster {
+        std::vector<Portal> portals;
+        std::vector<float> distances;   // portals x portals; FLT_MAX if unreachable
+        
+        // Polygon graph of the tile, for costs from arbitrary points
+        uint64_t polyBase = 0;
+        std::vector<glm::vec3> centroids;
+        std::vector<float> costScales;  // Area cost; negative if filtered out
+        std::vector<uint32_t> linkStart;
+        std::vector<std::pair<uint32_t, glm::vec3>> links;  // Polygon, shared edge midpoint
+    };
+    
+    // A cached coarse route
+    struct Route {
+        uint64_t key = 0;
+        std::vector<glm::vec3> exits;   // Portal used to leave each tile
+        std::vector<uint64_t> tiles;    // Tiles the route passes through
+    };
+    
+    // A portal plus whether it was just entered through (next: cross the
+    // tile) or is being left by (next: the twin)
+    struct CoarseNode {
+        float cost = FLT_MAX;
+        uint64_t parent = 0;
+        int tileX = 0;
+        int tileY = 0;
+        uint32_t portal = 0;
+        bool entered = false;
+        bool closed = false;
+    };
+    
+    // (estimate, -cost, node): among equal estimates, expand the node
+    // furthest along first, so routes of equal length don't all get explored
+    using CoarseEntry = std::tuple<float, float, uint64_t>;
+    
+    enum class SliceStage { Coarse, Refine, Done };
+    
+    // Everything a search carries from one slice to the next
+    struct SlicedSearch {
+        NavigationQuery* query = nullptr;   // For refinement
+        SliceStage stage = SliceStage::Done;
+        glm::vec3 start = glm::vec3(0);
+        glm::vec3 end = glm::vec3(0);
+        const NavQueryFilter* filter = nullptr;
+        bool useCache = true;
+        bool fromCache = false;
+        bool tileChanged = false;
+        bool restarted = false;
+        PathResult result;
+        
+        uint64_t startPoly = 0;
+        uint64_t endPoly = 0;
+        glm::vec3 startOnMesh = glm::vec3(0);
+        glm::vec3 endOnMesh = glm::vec3(0);
+        int endX = 0;
+        int endY = 0;
+        Route route;
+        
+        // Coarse stage: A* over portals
+        std::unordered_map<uint64_t, CoarseNode> nodes;
+        std::priority_queue<CoarseEntry, std::vector<CoarseEntry>, std::greater<CoarseEntry>> open;
+        std::vector<float> endCosts;
+        float goalCost = FLT_MAX;
+        uint64_t goalParent = 0;
+        
+        // Refine stage: one sliced A* per waypoint
+        std::vector<glm::vec3> waypoints;
+        size_t waypoint = 0;
+        glm::vec3 from = glm::vec3(0);
+        bool segmentActive = false;
+        uint64_t segmentEndPoly = 0;
+        glm::vec3 segmentStart = glm::vec3(0);
+        glm::vec3 segmentEnd = glm::vec3(0);
+        
+        // Each refined segment's polygon corridor, and the index of its
+        // first point in result.path
+        std::vector<std::vector<uint64_t>> corridors;
+        std::vector<size_t> segmentStarts;
+    };
+    
+    NavigationMesh& navMesh_;
+    NavQueryFilter filter_;
+    NavHierarchySettings settings_;
+    std::unique_ptr<NavigationQuery> query_;
+    std::unique_ptr<NavigationQuery> slicedQuery_;
+    uint32_t listenerId_ = 0;
+    
+    std::unordered_map<uint64_t, Cluster> clusters_;
+    std::list<Route> routes_;           // Most recently used first
+    std::unordered_map<uint64_t, std::list<Route>::iterator> routeByKey_;
+    SlicedSearch sliced_;
+    float minAreaCost_ = 1.0f;          // Keeps the coarse heuristic admissible
+    Stats stats_;
+    
+    const Cluster* getCluster(int tileX, int tileY);
+    static int findTwinPortal(const Cluster& neighbour, int tileX, int tileY, const glm::vec3& position);
+    void buildCluster(int tileX, int tileY, Cluster& outCluster) const;
+    void onTileChanged(int tileX, int tileY);
+    
+    // Stages of a search; findPath() runs one to completion in a go
+    void startSearch(SlicedSearch& search, bool useCache);
+    void advanceSearch(SlicedSearch& search, int maxIterations);
+    void advanceCoarse(SlicedSearch& search, int maxIterations);
+    void pushCoarse(SlicedSearch& search, const Cluster& cluster, int tileX, int tileY,
+                    uint32_t portal, bool entered, float cost, uint64_t parent);
+    void finishCoarse(SlicedSearch& search);
+    void beginRefine(SlicedSearch& search);
+    void advanceRefine(SlicedSearch& search, int maxIterations);
+    static void finishSearch(SlicedSearch& search, PathResult::Status status);
+    
+    // Cost from point, on polygon sourcePoly, to each portal of cluster
+    static void computePortalCosts(const Cluster& cluster, uint32_t sourcePoly,
+                                   const glm::vec3& point, std::vector<float>& outCosts);
+};
+
 // ============================================================================
 // CROWD SIMULATION
 // ============================================================================
@@ -495,6 +962,7 @@ struct NavigationComponent {
     bool isMoving = false;
     bool reachedDestination = false;
     bool pathPending = false;
+    uint32_t pathTicket = 0;   // PathRequestQueue ticket while pathPending
     
     // Crowd agent (if using crowd)
     int crowdAgentId = -1;
@@ -556,14 +1024,71 @@ public:
     bool hasReachedDestination(Entity entity) const;
     
     /**
-     * Build NavMesh from world geometry
+     * Build NavMesh from the colliders of static and kinematic entities.
+     * Afterwards, tiles under colliders that move, appear or are destroyed
+     * are rebuilt in the background (see setRuntimeRebuild).
      */
     bool buildNavMeshFromWorld(World& world, const NavMeshSettings& settings = {});
     
+    /**
+     * Enable background rebuilds for a NavMesh built from the world;
+     * colliders are checked for changes every interval seconds
+     */
+    void setRuntimeRebuild(bool enabled, float interval = 0.25f);
+    
+    // Finished tiles swapped into the NavMesh per update
+    static constexpr uint32_t MAX_TILE_SWAPS_PER_FRAME = 8;
+    
+    /**
+     * Time spent on path requests per update, in microseconds
+     */
+    void setPathBudget(float microseconds) { pathBudgetUs_ = microseconds; }
+    
+    /**
+     * Pending path requests nearest this point are served first
+     */
+    void setPathPriorityOrigin(const glm::vec3& origin) { pathPriorityOrigin_ = origin; }
+    
+    /**
+     * Number of searches advanced in parallel, each with its own query.
+     * Takes effect when the NavMesh is next set.
+     */
+    void setPathQueryContexts(uint32_t count) { pathQueryContexts_ = std::max(1u, count); }
+    
+    PathRequestQueue* getPathQueue() { return pathQueue_.get(); }
+    
+    /**
+     * Get the hierarchy used for long paths
+     */
+    NavHierarchy* getHierarchy() { return hierarchy_.get(); }
+    
 private:
     std::shared_ptr<NavigationMesh> navMesh_;
+    std::unique_ptr<NavHierarchy> hierarchy_;
     std::unique_ptr<NavigationQuery> query_;
     std::unique_ptr<CrowdManager> crowd_;
+    std::unique_ptr<PathRequestQueue> pathQueue_;
+    
+    float pathBudgetUs_ = 1000.0f;
+    glm::vec3 pathPriorityOrigin_ = glm::vec3(0);
+    uint32_t pathQueryContexts_ = 1;
+    std::vector<PathRequestQueue::CompletedPath> completedPaths_;
+    
+    // Colliders that contributed to the NavMesh at the last scan
+    struct NavGeometrySource {
+        EntityHandle handle;
+        glm::mat4 worldMatrix;
+        Collider collider;
+        NavMeshBounds bounds;
+    };
+    std::unordered_map<Entity, NavGeometrySource> geometrySources_;
+    bool navMeshFromWorld_ = false;
+    bool runtimeRebuild_ = true;
+    float rebuildInterval_ = 0.25f;
+    float rebuildTimer_ = 0.0f;
+    
+    void scanGeometrySources(World& world, std::unordered_map<Entity, NavGeometrySource>& outSources);
+    void detectGeometryChanges(World& world);
     
     // Pending path requests
     struct PathRequest {
@@ -572,6 +1097,14 @@ private:
     };
     std::queue<PathRequest> pendingRequests_;
     
+    // Requests submitted to pathQueue_, by ticket
+    struct SubmittedPath {
+        EntityHandle handle;
+        glm::vec3 target;
+    };
+    std::unordered_map<uint32_t, SubmittedPath> submittedPaths_;
+    
+    void resetPathQueue();
     void processPathRequests(World& world);
     void updatePathFollowing(World& world, float deltaTime);
     void updateCrowdAgents(World& world, float deltaTime);
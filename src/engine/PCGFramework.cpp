@@ -2,62 +2,268 @@
 #include "VulkanRenderer.h"
 #include "LandscapeSystem.h"
 #include "FoliageSystem.h"
+#include "JobSystem.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
+#include <glm/gtx/norm.hpp>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
 #include <queue>
 #include <fstream>
+#include <type_traits>
 
 namespace Kinetic {
 
+namespace {
+
+// Points per job when a node splits its work over point ranges
+constexpr size_t POINT_GRAIN = 4096;
+
+// Grids that would need more cells than this use coarser cells
+constexpr size_t MAX_GRID_CELLS = size_t(1) << 22;
+
+void parallelPoints(const PCGContext& context, size_t count,
+                    const std::function<void(size_t begin, size_t end)>& fn) {
+    context.getJobSystem().parallelFor(count, POINT_GRAIN, fn);
+}
+
+// FNV-1a
+uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t hashCombine(uint64_t seed, uint64_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+template<typename T>
+void gatherColumn(const std::vector<T>& source, const std::vector<uint32_t>& indices, std::vector<T>& dest) {
+    dest.resize(indices.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        dest[i] = source[indices[i]];
+    }
+}
+
+// Rotation taking +Y onto normal
+glm::quat rotationToNormal(const glm::vec3& normal) {
+    glm::vec3 up(0, 1, 0);
+    glm::vec3 axis = glm::normalize(glm::cross(up, normal));
+    float angle = std::acos(glm::clamp(glm::dot(up, normal), -1.0f, 1.0f));
+    return glm::angleAxis(angle, axis);
+}
+
+// Grid over bounds with cells of at least cellSize, capped at MAX_GRID_CELLS
+float fitGrid(const glm::vec3& boundsMin, const glm::vec3& boundsMax, float cellSize, glm::ivec3& dims) {
+    glm::vec3 size = glm::max(boundsMax - boundsMin, glm::vec3(0.0f));
+    while (true) {
+        dims = glm::ivec3(
+            std::max(1, static_cast<int>(std::ceil(size.x / cellSize))),
+            std::max(1, static_cast<int>(std::ceil(size.y / cellSize))),
+            std::max(1, static_cast<int>(std::ceil(size.z / cellSize)))
+        );
+        if (size_t(dims.x) * dims.y * dims.z <= MAX_GRID_CELLS) return cellSize;
+        cellSize *= 2.0f;
+    }
+}
+
+glm::ivec3 gridCell(const glm::vec3& position, const glm::vec3& boundsMin, float cellSize, const glm::ivec3& dims) {
+    glm::ivec3 cell = glm::ivec3(glm::floor((position - boundsMin) / cellSize));
+    return glm::clamp(cell, glm::ivec3(0), dims - 1);
+}
+
+} // namespace
+
 //------------------------------------------------------------------------------
 // PCGSpatialData
 //------------------------------------------------------------------------------
 
+void PCGSpatialData::resize(size_t count) {
+    positions.resize(count, glm::vec3(0));
+    normals.resize(count, glm::vec3(0, 1, 0));
+    scales.resize(count, glm::vec3(1));
+    rotations.resize(count, glm::quat(1, 0, 0, 0));
+    colors.resize(count, glm::vec4(1));
+    densities.resize(count, 1.0f);
+    seeds.resize(count, 0);
+    for (auto& column : attributes) {
+        std::visit([count](auto& values) { values.resize(count); }, column.values);
+    }
+    spatialIndexDirty = true;
+}
+
+void PCGSpatialData::reserve(size_t count) {
+    positions.reserve(count);
+    normals.reserve(count);
+    scales.reserve(count);
+    rotations.reserve(count);
+    colors.reserve(count);
+    densities.reserve(count);
+    seeds.reserve(count);
+    for (auto& column : attributes) {
+        std::visit([count](auto& values) { values.reserve(count); }, column.values);
+    }
+}
+
+void PCGSpatialData::addPoint(const PCGPoint& point) {
+    size_t index = size();
+    resize(index + 1);
+    setPoint(index, point);
+}
+
+PCGPoint PCGSpatialData::getPoint(size_t index) const {
+    PCGPoint point;
+    point.position = positions[index];
+    point.normal = normals[index];
+    point.scale = scales[index];
+    point.rotation = rotations[index];
+    point.color = colors[index];
+    point.density = densities[index];
+    point.seed = seeds[index];
+    return point;
+}
+
+void PCGSpatialData::setPoint(size_t index, const PCGPoint& point) {
+    positions[index] = point.position;
+    normals[index] = point.normal;
+    scales[index] = point.scale;
+    rotations[index] = point.rotation;
+    colors[index] = point.color;
+    densities[index] = point.density;
+    seeds[index] = point.seed;
+    spatialIndexDirty = true;
+}
+
 void PCGSpatialData::updateBounds() {
     boundsMin = glm::vec3(std::numeric_limits<float>::max());
     boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
     
-    for (const auto& point : points) {
-        boundsMin = glm::min(boundsMin, point.position);
-        boundsMax = glm::max(boundsMax, point.position);
+    for (const auto& position : positions) {
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
     }
     
     spatialIndexDirty = true;
 }
 
 void PCGSpatialData::clear() {
-    points.clear();
+    resize(0);
+    attributes.clear();
     boundsMin = glm::vec3(std::numeric_limits<float>::max());
     boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
     spatialIndexDirty = true;
 }
 
 void PCGSpatialData::append(const PCGSpatialData& other) {
-    points.insert(points.end(), other.points.begin(), other.points.end());
+    const size_t oldSize = size();
+    
+    // Columns only one side has are zero-filled on the other
+    for (const auto& column : other.attributes) {
+        if (!findAttribute(column.name)) {
+            PCGAttributeColumn added{column.name, column.values};
+            std::visit([oldSize](auto& values) { values.assign(oldSize, {}); }, added.values);
+            attributes.push_back(std::move(added));
+        }
+    }
+    
+    positions.insert(positions.end(), other.positions.begin(), other.positions.end());
+    normals.insert(normals.end(), other.normals.begin(), other.normals.end());
+    scales.insert(scales.end(), other.scales.begin(), other.scales.end());
+    rotations.insert(rotations.end(), other.rotations.begin(), other.rotations.end());
+    colors.insert(colors.end(), other.colors.begin(), other.colors.end());
+    densities.insert(densities.end(), other.densities.begin(), other.densities.end());
+    seeds.insert(seeds.end(), other.seeds.begin(), other.seeds.end());
+    
+    for (auto& column : attributes) {
+        const PCGAttributeColumn* source = other.findAttribute(column.name);
+        std::visit([&](auto& values) {
+            using Column = std::decay_t<decltype(values)>;
+            const Column* sourceValues = source ? std::get_if<Column>(&source->values) : nullptr;
+            if (sourceValues) {
+                values.insert(values.end(), sourceValues->begin(), sourceValues->end());
+            } else {
+                values.resize(size());
+            }
+        }, column.values);
+    }
+    
     boundsMin = glm::min(boundsMin, other.boundsMin);
     boundsMax = glm::max(boundsMax, other.boundsMax);
     spatialIndexDirty = true;
 }
 
+void PCGSpatialData::gather(const PCGSpatialData& source, const std::vector<uint32_t>& indices) {
+    gatherColumn(source.positions, indices, positions);
+    gatherColumn(source.normals, indices, normals);
+    gatherColumn(source.scales, indices, scales);
+    gatherColumn(source.rotations, indices, rotations);
+    gatherColumn(source.colors, indices, colors);
+    gatherColumn(source.densities, indices, densities);
+    gatherColumn(source.seeds, indices, seeds);
+    
+    attributes.resize(source.attributes.size());
+    for (size_t i = 0; i < source.attributes.size(); i++) {
+        attributes[i].name = source.attributes[i].name;
+        std::visit([&](const auto& values) {
+            using Column = std::decay_t<decltype(values)>;
+            Column gathered;
+            gatherColumn(values, indices, gathered);
+            attributes[i].values = std::move(gathered);
+        }, source.attributes[i].values);
+    }
+    
+    updateBounds();
+}
+
+void PCGSpatialData::partition(const PCGSpatialData& source, const std::vector<uint8_t>& mask,
+                               PCGSpatialData* pass, PCGSpatialData* fail) {
+    std::vector<uint32_t> passIndices, failIndices;
+    for (uint32_t i = 0; i < mask.size(); i++) {
+        (mask[i] ? passIndices : failIndices).push_back(i);
+    }
+    
+    if (pass) pass->gather(source, passIndices);
+    if (fail) fail->gather(source, failIndices);
+}
+
+const PCGAttributeColumn* PCGSpatialData::findAttribute(const std::string& name) const {
+    for (const auto& column : attributes) {
+        if (column.name == name) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
 void PCGSpatialData::buildSpatialIndex(float cellSize) const {
     if (!spatialIndexDirty && gridCellSize == cellSize) return;
     
-    gridCellSize = cellSize;
-    glm::vec3 size = boundsMax - boundsMin;
-    gridDimensions = glm::ivec3(
-        std::max(1, static_cast<int>(std::ceil(size.x / cellSize))),
-        std::max(1, static_cast<int>(std::ceil(size.y / cellSize))),
-        std::max(1, static_cast<int>(std::ceil(size.z / cellSize)))
-    );
+    gridCellSize = fitGrid(boundsMin, boundsMax, cellSize, gridDimensions);
+    const size_t cellCount = size_t(gridDimensions.x) * gridDimensions.y * gridDimensions.z;
     
-    // Build grid (simple spatial hashing for now)
-    spatialGrid.clear();
-    spatialGrid.resize(gridDimensions.x * gridDimensions.y * gridDimensions.z);
+    // Counting sort of point indices by cell
+    std::vector<uint32_t> pointCells(size());
+    spatialCellStart.assign(cellCount + 1, 0);
+    for (size_t i = 0; i < size(); i++) {
+        glm::ivec3 cell = gridCell(positions[i], boundsMin, gridCellSize, gridDimensions);
+        pointCells[i] = static_cast<uint32_t>((size_t(cell.z) * gridDimensions.y + cell.y) * gridDimensions.x + cell.x);
+        spatialCellStart[pointCells[i] + 1]++;
+    }
+    for (size_t c = 0; c < cellCount; c++) {
+        spatialCellStart[c + 1] += spatialCellStart[c];
+    }
     
-    // Just store point indices - a production implementation would use proper 
-    // cell lists or a spatial hash map
+    spatialGrid.resize(size());
+    std::vector<uint32_t> cursor(spatialCellStart.begin(), spatialCellStart.end() - 1);
+    for (uint32_t i = 0; i < size(); i++) {
+        spatialGrid[cursor[pointCells[i]]++] = i;
+    }
     
     spatialIndexDirty = false;
 }
@@ -66,36 +272,72 @@ std::vector<uint32_t> PCGSpatialData::queryRadius(const glm::vec3& center, float
     std::vector<uint32_t> result;
     float radiusSq = radius * radius;
     
-    for (uint32_t i = 0; i < points.size(); i++) {
-        float distSq = glm::length2(points[i].position - center);
-        if (distSq <= radiusSq) {
-            result.push_back(i);
+    if (spatialIndexDirty) {
+        for (uint32_t i = 0; i < size(); i++) {
+            if (glm::length2(positions[i] - center) <= radiusSq) {
+                result.push_back(i);
+            }
         }
+        return result;
     }
     
+    for (uint32_t i : queryBox(center - glm::vec3(radius), center + glm::vec3(radius))) {
+        if (glm::length2(positions[i] - center) <= radiusSq) {
+            result.push_back(i);
+        }
+    }
     return result;
 }
 
 std::vector<uint32_t> PCGSpatialData::queryBox(const glm::vec3& min, const glm::vec3& max) const {
     std::vector<uint32_t> result;
+    auto inBox = [&](const glm::vec3& pos) {
+        return pos.x >= min.x && pos.x <= max.x &&
+               pos.y >= min.y && pos.y <= max.y &&
+               pos.z >= min.z && pos.z <= max.z;
+    };
     
-    for (uint32_t i = 0; i < points.size(); i++) {
-        const auto& pos = points[i].position;
-        if (pos.x >= min.x && pos.x <= max.x &&
-            pos.y >= min.y && pos.y <= max.y &&
-            pos.z >= min.z && pos.z <= max.z) {
-            result.push_back(i);
+    if (spatialIndexDirty) {
+        for (uint32_t i = 0; i < size(); i++) {
+            if (inBox(positions[i])) {
+                result.push_back(i);
+            }
         }
+        return result;
     }
     
+    // Cells overlapping the box; points outside the bounds clamp to edge cells
+    glm::ivec3 cellMin = gridCell(min, boundsMin, gridCellSize, gridDimensions);
+    glm::ivec3 cellMax = gridCell(max, boundsMin, gridCellSize, gridDimensions);
+    for (int z = cellMin.z; z <= cellMax.z; z++) {
+        for (int y = cellMin.y; y <= cellMax.y; y++) {
+            for (int x = cellMin.x; x <= cellMax.x; x++) {
+                size_t cell = (size_t(z) * gridDimensions.y + y) * gridDimensions.x + x;
+                for (uint32_t k = spatialCellStart[cell]; k < spatialCellStart[cell + 1]; k++) {
+                    uint32_t i = spatialGrid[k];
+                    if (inBox(positions[i])) {
+                        result.push_back(i);
+                    }
+                }
+            }
+        }
+    }
     return result;
 }
 
+//------------------------------------------------------------------------------
+// PCGContext
+//------------------------------------------------------------------------------
+
+Sanic::JobSystem& PCGContext::getJobSystem() const {
+    return jobs ? *jobs : Sanic::JobSystem::getInstance();
+}
+
 //------------------------------------------------------------------------------
 // PCGNode
 //------------------------------------------------------------------------------
 
-void PCGNode::setSetting(const std::string& name, const Setting::value_type& value) {
+void PCGNode::setSetting(const std::string& name, const Setting::Value& value) {
     settings_[name] = {name, value};
 }
 
@@ -104,6 +346,54 @@ const PCGNode::Setting* PCGNode::getSetting(const std::string& name) const {
     return it != settings_.end() ? &it->second : nullptr;
 }
 
+uint64_t PCGNode::getSettingsHash() const {
+    std::string name = getName();
+    uint64_t hash = hashBytes(name.data(), name.size());
+    
+    // Summed, so the map's iteration order doesn't matter
+    uint64_t settingsHash = 0;
+    for (const auto& [settingName, setting] : settings_) {
+        uint64_t entry = hashBytes(settingName.data(), settingName.size());
+        entry = hashCombine(entry, setting.value.index());
+        std::visit([&entry](const auto& value) {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::string>) {
+                entry = hashBytes(value.data(), value.size(), entry);
+            } else {
+                entry = hashBytes(&value, sizeof(T), entry);
+            }
+        }, setting.value);
+        settingsHash += hashCombine(entry, 0);
+    }
+    return hashCombine(hash, settingsHash);
+}
+
+float PCGNode::getFloatSetting(const std::string& name, float fallback) const {
+    const Setting* setting = getSetting(name);
+    if (!setting) return fallback;
+    if (const float* value = std::get_if<float>(&setting->value)) return *value;
+    if (const int32_t* value = std::get_if<int32_t>(&setting->value)) return static_cast<float>(*value);
+    return fallback;
+}
+
+int32_t PCGNode::getIntSetting(const std::string& name, int32_t fallback) const {
+    const Setting* setting = getSetting(name);
+    const int32_t* value = setting ? std::get_if<int32_t>(&setting->value) : nullptr;
+    return value ? *value : fallback;
+}
+
+bool PCGNode::getBoolSetting(const std::string& name, bool fallback) const {
+    const Setting* setting = getSetting(name);
+    const bool* value = setting ? std::get_if<bool>(&setting->value) : nullptr;
+    return value ? *value : fallback;
+}
+
+glm::vec3 PCGNode::getVec3Setting(const std::string& name, const glm::vec3& fallback) const {
+    const Setting* setting = getSetting(name);
+    const glm::vec3* value = setting ? std::get_if<glm::vec3>(&setting->value) : nullptr;
+    return value ? *value : fallback;
+}
+
 //------------------------------------------------------------------------------
 // Surface Sampler Node
 //------------------------------------------------------------------------------
@@ -121,16 +411,19 @@ std::vector<PCGPin> PCGSurfaceSamplerNode::getOutputPins() const {
 }
 
 bool PCGSurfaceSamplerNode::execute(PCGContext& context,
-                                     const std::vector<PCGData>& inputs,
-                                     std::vector<PCGData>& outputs) {
-    context.seedRNG(nodeId);
-    
-    PCGSpatialData output;
+                                     const std::vector<PCGDataPtr>& inputs,
+                                     std::vector<PCGDataPtr>& outputs) {
+    const float pointsPerSquareMeter = getFloatSetting("PointsPerSquareMeter", pointsPerSquareMeter_);
+    const float minHeight = getFloatSetting("MinHeight", minHeight_);
+    const float maxHeight = getFloatSetting("MaxHeight", maxHeight_);
+    const float minSlope = getFloatSetting("MinSlope", minSlope_);
+    const float maxSlope = getFloatSetting("MaxSlope", maxSlope_);
+    const bool alignToNormal = getBoolSetting("AlignToNormal", alignToNormal_);
     
     // Get landscape data if available
     const PCGLandscapeData* landscape = nullptr;
-    if (!inputs.empty() && std::holds_alternative<PCGLandscapeData>(inputs[0])) {
-        landscape = &std::get<PCGLandscapeData>(inputs[0]);
+    if (!inputs.empty() && std::holds_alternative<PCGLandscapeData>(*inputs[0])) {
+        landscape = &std::get<PCGLandscapeData>(*inputs[0]);
     }
     
     // Calculate sampling bounds
@@ -138,58 +431,66 @@ bool PCGSurfaceSamplerNode::execute(PCGContext& context,
     glm::vec3 boundsMax = landscape ? landscape->boundsMax : context.worldBoundsMax;
     
     float area = (boundsMax.x - boundsMin.x) * (boundsMax.z - boundsMin.z);
-    uint32_t numPoints = static_cast<uint32_t>(area * pointsPerSquareMeter_);
-    
-    output.points.reserve(numPoints);
-    
-    for (uint32_t i = 0; i < numPoints; i++) {
-        PCGPoint point;
-        
-        // Random XZ position
-        point.position.x = context.randomFloat(boundsMin.x, boundsMax.x);
-        point.position.z = context.randomFloat(boundsMin.z, boundsMax.z);
-        
-        // Get height from landscape
-        if (landscape && landscape->heightQuery) {
-            point.position.y = landscape->heightQuery(glm::vec2(point.position.x, point.position.z));
-        } else if (context.landscape) {
-            point.position.y = context.landscape->getHeightAt(point.position.x, point.position.z);
-        } else {
-            point.position.y = 0.0f;
-        }
-        
-        // Height filter
-        if (point.position.y < minHeight_ || point.position.y > maxHeight_) {
-            continue;
-        }
-        
-        // Get normal and slope
-        if (landscape && landscape->normalQuery) {
-            point.normal = landscape->normalQuery(glm::vec2(point.position.x, point.position.z));
-        } else if (context.landscape) {
-            point.normal = context.landscape->getNormalAt(point.position.x, point.position.z);
-        }
-        
-        // Calculate slope angle
-        float slope = glm::degrees(std::acos(glm::clamp(point.normal.y, 0.0f, 1.0f)));
-        if (slope < minSlope_ || slope > maxSlope_) {
-            continue;
-        }
-        
-        // Align to normal if requested
-        if (alignToNormal_ && point.normal.y < 0.999f) {
-            glm::vec3 up(0, 1, 0);
-            glm::vec3 axis = glm::normalize(glm::cross(up, point.normal));
-            float angle = std::acos(glm::dot(up, point.normal));
-            point.rotation = glm::angleAxis(angle, axis);
+    size_t numPoints = static_cast<size_t>(std::max(0.0f, area * pointsPerSquareMeter));
+    
+    // Candidates are generated in parallel, then the survivors compacted in order
+    PCGSpatialData candidates;
+    candidates.resize(numPoints);
+    std::vector<uint8_t> keep(numPoints, 0);
+    
+    parallelPoints(context, numPoints, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            PCGPointRandom random = context.pointRandom(nodeId, static_cast<uint32_t>(i));
+            glm::vec3 position;
+            glm::vec3 normal(0, 1, 0);
+            
+            // Random XZ position
+            position.x = random.nextFloat(boundsMin.x, boundsMax.x);
+            position.z = random.nextFloat(boundsMin.z, boundsMax.z);
+            
+            // Get height from landscape
+            if (landscape && landscape->heightQuery) {
+                position.y = landscape->heightQuery(glm::vec2(position.x, position.z));
+            } else if (context.landscape) {
+                position.y = context.landscape->getHeightAt(position.x, position.z);
+            } else {
+                position.y = 0.0f;
+            }
+            
+            // Height filter
+            if (position.y < minHeight || position.y > maxHeight) {
+                continue;
+            }
+            
+            // Get normal and slope
+            if (landscape && landscape->normalQuery) {
+                normal = landscape->normalQuery(glm::vec2(position.x, position.z));
+            } else if (context.landscape) {
+                normal = context.landscape->getNormalAt(position.x, position.z);
+            }
+            
+            // Calculate slope angle
+            float slope = glm::degrees(std::acos(glm::clamp(normal.y, 0.0f, 1.0f)));
+            if (slope < minSlope || slope > maxSlope) {
+                continue;
+            }
+            
+            candidates.positions[i] = position;
+            candidates.normals[i] = normal;
+            
+            // Align to normal if requested
+            if (alignToNormal && normal.y < 0.999f) {
+                candidates.rotations[i] = rotationToNormal(normal);
+            }
+            
+            candidates.seeds[i] = context.getChildSeed(static_cast<int32_t>(i));
+            keep[i] = 1;
         }
-        
-        point.seed = context.getChildSeed(i);
-        output.points.push_back(point);
-    }
+    });
     
-    output.updateBounds();
-    outputs.push_back(std::move(output));
+    PCGSpatialData output;
+    PCGSpatialData::partition(candidates, keep, &output, nullptr);
+    outputs.push_back(makePCGData(std::move(output)));
     
     return true;
 }
@@ -223,65 +524,68 @@ std::vector<PCGPin> PCGSplineSamplerNode::getOutputPins() const {
 }
 
 bool PCGSplineSamplerNode::execute(PCGContext& context,
-                                    const std::vector<PCGData>& inputs,
-                                    std::vector<PCGData>& outputs) {
-    if (inputs.empty() || !std::holds_alternative<PCGSplineData>(inputs[0])) {
+                                    const std::vector<PCGDataPtr>& inputs,
+                                    std::vector<PCGDataPtr>& outputs) {
+    if (inputs.empty() || !std::holds_alternative<PCGSplineData>(*inputs[0])) {
         return false;
     }
     
-    const PCGSplineData& spline = std::get<PCGSplineData>(inputs[0]);
-    context.seedRNG(nodeId);
+    const PCGSplineData& spline = std::get<PCGSplineData>(*inputs[0]);
+    const float spacing = getFloatSetting("Spacing", spacing_);
+    const bool projectToSurface = getBoolSetting("ProjectToSurface", projectToSurface_);
+    const float offsetFromSpline = getFloatSetting("OffsetFromSpline", offsetFromSpline_);
     
     PCGSpatialData output;
     
-    if (spline.length <= 0 || spline.points.size() < 2) {
-        outputs.push_back(std::move(output));
+    if (spline.length <= 0 || spline.points.size() < 2 || spacing <= 0.0f) {
+        outputs.push_back(makePCGData(std::move(output)));
         return true;
     }
     
-    uint32_t numPoints = static_cast<uint32_t>(spline.length / spacing_);
-    output.points.reserve(numPoints);
+    uint32_t numPoints = static_cast<uint32_t>(spline.length / spacing);
+    output.resize(numPoints);
     
-    for (uint32_t i = 0; i < numPoints; i++) {
-        float t = static_cast<float>(i) / static_cast<float>(numPoints);
-        
-        // Interpolate along spline
-        uint32_t segmentCount = static_cast<uint32_t>(spline.points.size()) - 1;
-        float segment = t * segmentCount;
-        uint32_t segmentIndex = static_cast<uint32_t>(segment);
-        float segmentT = segment - segmentIndex;
-        
-        if (segmentIndex >= segmentCount) {
-            segmentIndex = segmentCount - 1;
-            segmentT = 1.0f;
-        }
-        
-        const glm::vec3& p0 = spline.points[segmentIndex];
-        const glm::vec3& p1 = spline.points[segmentIndex + 1];
-        
-        PCGPoint point;
-        point.position = glm::mix(p0, p1, segmentT);
-        
-        // Apply offset from spline
-        if (std::abs(offsetFromSpline_) > 0.001f) {
-            // Calculate perpendicular direction
-            glm::vec3 tangent = glm::normalize(p1 - p0);
-            glm::vec3 right = glm::normalize(glm::cross(tangent, glm::vec3(0, 1, 0)));
-            point.position += right * offsetFromSpline_;
-        }
-        
-        // Project to surface if requested
-        if (projectToSurface_ && context.landscape) {
-            point.position.y = context.landscape->getHeightAt(point.position.x, point.position.z);
-            point.normal = context.landscape->getNormalAt(point.position.x, point.position.z);
+    parallelPoints(context, numPoints, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            float t = static_cast<float>(i) / static_cast<float>(numPoints);
+            
+            // Interpolate along spline
+            uint32_t segmentCount = static_cast<uint32_t>(spline.points.size()) - 1;
+            float segment = t * segmentCount;
+            uint32_t segmentIndex = static_cast<uint32_t>(segment);
+            float segmentT = segment - segmentIndex;
+            
+            if (segmentIndex >= segmentCount) {
+                segmentIndex = segmentCount - 1;
+                segmentT = 1.0f;
+            }
+            
+            const glm::vec3& p0 = spline.points[segmentIndex];
+            const glm::vec3& p1 = spline.points[segmentIndex + 1];
+            
+            glm::vec3 position = glm::mix(p0, p1, segmentT);
+            
+            // Apply offset from spline
+            if (std::abs(offsetFromSpline) > 0.001f) {
+                // Calculate perpendicular direction
+                glm::vec3 tangent = glm::normalize(p1 - p0);
+                glm::vec3 right = glm::normalize(glm::cross(tangent, glm::vec3(0, 1, 0)));
+                position += right * offsetFromSpline;
+            }
+            
+            // Project to surface if requested
+            if (projectToSurface && context.landscape) {
+                position.y = context.landscape->getHeightAt(position.x, position.z);
+                output.normals[i] = context.landscape->getNormalAt(position.x, position.z);
+            }
+            
+            output.positions[i] = position;
+            output.seeds[i] = context.getChildSeed(static_cast<int32_t>(i));
         }
-        
-        point.seed = context.getChildSeed(i);
-        output.points.push_back(point);
-    }
+    });
     
     output.updateBounds();
-    outputs.push_back(std::move(output));
+    outputs.push_back(makePCGData(std::move(output)));
     
     return true;
 }
@@ -309,17 +613,20 @@ std::vector<PCGPin> PCGVolumeSamplerNode::getOutputPins() const {
 }
 
 bool PCGVolumeSamplerNode::execute(PCGContext& context,
-                                    const std::vector<PCGData>& inputs,
-                                    std::vector<PCGData>& outputs) {
+                                    const std::vector<PCGDataPtr>& inputs,
+                                    std::vector<PCGDataPtr>& outputs) {
     context.seedRNG(nodeId);
     
+    const float density = getFloatSetting("Density", density_);
+    const bool usePoissonDisk = getBoolSetting("UsePoissonDisk", usePoissonDisk_);
+    
     PCGSpatialData output;
     
     glm::vec3 size = context.worldBoundsMax - context.worldBoundsMin;
     float volume = size.x * size.y * size.z;
-    uint32_t numPoints = static_cast<uint32_t>(volume * density_);
+    uint32_t numPoints = static_cast<uint32_t>(volume * density);
     
-    if (usePoissonDisk_) {
+    if (numPoints > 0 && usePoissonDisk) {
         // Poisson disk sampling for better distribution
         float minDist = std::pow(volume / numPoints, 1.0f / 3.0f);
         
@@ -334,13 +641,13 @@ bool PCGVolumeSamplerNode::execute(PCGContext& context,
         );
         first.seed = context.getChildSeed(0);
         activeList.push_back(first);
-        output.points.push_back(first);
+        output.addPoint(first);
         
         uint32_t maxAttempts = 30;
         
-        while (!activeList.empty() && output.points.size() < numPoints) {
+        while (!activeList.empty() && output.size() < numPoints) {
             uint32_t idx = context.randomInt(0, static_cast<int32_t>(activeList.size()) - 1);
-            PCGPoint& active = activeList[idx];
+            const glm::vec3 activePosition = activeList[idx].position;
             
             bool found = false;
             for (uint32_t attempt = 0; attempt < maxAttempts; attempt++) {
@@ -350,7 +657,7 @@ bool PCGVolumeSamplerNode::execute(PCGContext& context,
                 float phi = std::acos(context.randomFloat() * 2.0f - 1.0f);
                 
                 PCGPoint newPoint;
-                newPoint.position = active.position + glm::vec3(
+                newPoint.position = activePosition + glm::vec3(
                     r * std::sin(phi) * std::cos(theta),
                     r * std::sin(phi) * std::sin(theta),
                     r * std::cos(phi)
@@ -368,17 +675,17 @@ bool PCGVolumeSamplerNode::execute(PCGContext& context,
                 
                 // Check distance to all existing points (inefficient but simple)
                 bool tooClose = false;
-                for (const auto& existing : output.points) {
-                    if (glm::length(newPoint.position - existing.position) < minDist) {
+                for (const auto& existing : output.positions) {
+                    if (glm::length(newPoint.position - existing) < minDist) {
                         tooClose = true;
                         break;
                     }
                 }
                 
                 if (!tooClose) {
-                    newPoint.seed = context.getChildSeed(static_cast<int32_t>(output.points.size()));
+                    newPoint.seed = context.getChildSeed(static_cast<int32_t>(output.size()));
                     activeList.push_back(newPoint);
-                    output.points.push_back(newPoint);
+                    output.addPoint(newPoint);
                     found = true;
                     break;
                 }
@@ -390,7 +697,7 @@ bool PCGVolumeSamplerNode::execute(PCGContext& context,
         }
     } else {
         // Simple random sampling
-        output.points.reserve(numPoints);
+        output.reserve(numPoints);
         for (uint32_t i = 0; i < numPoints; i++) {
             PCGPoint point;
             point.position = glm::vec3(
@@ -399,12 +706,12 @@ bool PCGVolumeSamplerNode::execute(PCGContext& context,
                 context.randomFloat(context.worldBoundsMin.z, context.worldBoundsMax.z)
             );
             point.seed = context.getChildSeed(i);
-            output.points.push_back(point);
+            output.addPoint(point);
         }
     }
     
     output.updateBounds();
-    outputs.push_back(std::move(output));
+    outputs.push_back(makePCGData(std::move(output)));
     
     return true;
 }
@@ -434,55 +741,56 @@ std::vector<PCGPin> PCGDensityFilterNode::getOutputPins() const {
 }
 
 bool PCGDensityFilterNode::execute(PCGContext& context,
-                                    const std::vector<PCGData>& inputs,
-                                    std::vector<PCGData>& outputs) {
-    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(inputs[0])) {
+                                    const std::vector<PCGDataPtr>& inputs,
+                                    std::vector<PCGDataPtr>& outputs) {
+    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(*inputs[0])) {
         return false;
     }
     
-    const PCGSpatialData& input = std::get<PCGSpatialData>(inputs[0]);
-    context.seedRNG(nodeId);
-    
-    PCGSpatialData kept, rejected;
-    
-    for (const auto& point : input.points) {
-        // Sample Perlin noise at point position
-        float noiseValue = 0.0f;
-        float amplitude = 1.0f;
-        float frequency = 1.0f / noiseScale_;
-        
-        for (int octave = 0; octave < noiseOctaves_; octave++) {
-            // Simple noise approximation (would use proper Perlin in production)
-            float x = point.position.x * frequency;
-            float z = point.position.z * frequency;
-            float noise = std::sin(x * 12.9898f + z * 78.233f);
-            noise = std::abs(noise * 43758.5453f - std::floor(noise * 43758.5453f));
+    const PCGSpatialData& input = std::get<PCGSpatialData>(*inputs[0]);
+    const float densityMin = getFloatSetting("DensityMin", densityMin_);
+    const float densityMax = getFloatSetting("DensityMax", densityMax_);
+    const bool invertDensity = getBoolSetting("InvertDensity", invertDensity_);
+    const float noiseScale = getFloatSetting("NoiseScale", noiseScale_);
+    const int32_t noiseOctaves = getIntSetting("NoiseOctaves", noiseOctaves_);
+    
+    std::vector<uint8_t> passes(input.size());
+    parallelPoints(context, input.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const glm::vec3& position = input.positions[i];
             
-            noiseValue += noise * amplitude;
-            amplitude *= 0.5f;
-            frequency *= 2.0f;
-        }
-        
-        noiseValue = (noiseValue + 1.0f) * 0.5f;  // Normalize to 0-1
-        
-        if (invertDensity_) {
-            noiseValue = 1.0f - noiseValue;
-        }
-        
-        bool passes = noiseValue >= densityMin_ && noiseValue <= densityMax_;
-        
-        if (passes) {
-            kept.points.push_back(point);
-        } else {
-            rejected.points.push_back(point);
+            // Sample Perlin noise at point position
+            float noiseValue = 0.0f;
+            float amplitude = 1.0f;
+            float frequency = 1.0f / noiseScale;
+            
+            for (int octave = 0; octave < noiseOctaves; octave++) {
+                // Simple noise approximation (would use proper Perlin in production)
+                float x = position.x * frequency;
+                float z = position.z * frequency;
+                float noise = std::sin(x * 12.9898f + z * 78.233f);
+                noise = std::abs(noise * 43758.5453f - std::floor(noise * 43758.5453f));
+                
+                noiseValue += noise * amplitude;
+                amplitude *= 0.5f;
+                frequency *= 2.0f;
+            }
+            
+            noiseValue = (noiseValue + 1.0f) * 0.5f;  // Normalize to 0-1
+            
+            if (invertDensity) {
+                noiseValue = 1.0f - noiseValue;
+            }
+            
+            passes[i] = noiseValue >= densityMin && noiseValue <= densityMax;
         }
-    }
+    });
     
-    kept.updateBounds();
-    rejected.updateBounds();
+    PCGSpatialData kept, rejected;
+    PCGSpatialData::partition(input, passes, &kept, &rejected);
     
-    outputs.push_back(std::move(kept));
-    outputs.push_back(std::move(rejected));
+    outputs.push_back(makePCGData(std::move(kept)));
+    outputs.push_back(makePCGData(std::move(rejected)));
     
     return true;
 }
@@ -514,48 +822,81 @@ std::vector<PCGPin> PCGDistanceFilterNode::getOutputPins() const {
 }
 
 bool PCGDistanceFilterNode::execute(PCGContext& context,
-                                     const std::vector<PCGData>& inputs,
-                                     std::vector<PCGData>& outputs) {
-    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(inputs[0])) {
+                                     const std::vector<PCGDataPtr>& inputs,
+                                     std::vector<PCGDataPtr>& outputs) {
+    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(*inputs[0])) {
         return false;
     }
     
-    const PCGSpatialData& input = std::get<PCGSpatialData>(inputs[0]);
-    context.seedRNG(nodeId);
+    const PCGSpatialData& input = std::get<PCGSpatialData>(*inputs[0]);
+    const float minDistance = getFloatSetting("MinDistance", minDistance_);
+    const Mode mode = static_cast<Mode>(getIntSetting("Mode", static_cast<int32_t>(mode_)));
     
-    PCGSpatialData output;
-    float minDistSq = minDistance_ * minDistance_;
+    if (minDistance <= 0.0f || input.empty()) {
+        outputs.push_back(inputs[0]);
+        return true;
+    }
     
-    // Copy points and optionally shuffle
-    std::vector<size_t> indices(input.points.size());
-    for (size_t i = 0; i < indices.size(); i++) indices[i] = i;
+    float minDistSq = minDistance * minDistance;
     
-    if (mode_ == Mode::Random) {
-        for (size_t i = indices.size() - 1; i > 0; i--) {
-            size_t j = context.randomInt(0, static_cast<int32_t>(i));
-            std::swap(indices[i], indices[j]);
-        }
+    // Visiting order decides which of two close points survives
+    std::vector<uint32_t> indices(input.size());
+    std::iota(indices.begin(), indices.end(), 0u);
+    
+    if (mode == Mode::Random) {
+        std::vector<uint32_t> keys(input.size());
+        parallelPoints(context, input.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                keys[i] = context.pointRandom(nodeId, static_cast<uint32_t>(i)).nextUInt();
+            }
+        });
+        std::stable_sort(indices.begin(), indices.end(),
+                         [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+    } else if (mode == Mode::Priority) {
+        std::stable_sort(indices.begin(), indices.end(),
+                         [&input](uint32_t a, uint32_t b) { return input.densities[a] > input.densities[b]; });
     }
     
-    // Process points
-    for (size_t idx : indices) {
-        const PCGPoint& point = input.points[idx];
+    // Kept points are bucketed in a grid of cells at least minDistance
+    // wide, so each test only looks at the neighbouring cells
+    glm::ivec3 dims;
+    const float cellSize = fitGrid(input.boundsMin, input.boundsMax, minDistance, dims);
+    std::vector<int32_t> cellHead(size_t(dims.x) * dims.y * dims.z, -1);
+    std::vector<int32_t> nextInCell;
+    std::vector<uint32_t> kept;
+    
+    for (uint32_t idx : indices) {
+        const glm::vec3& position = input.positions[idx];
+        glm::ivec3 cell = gridCell(position, input.boundsMin, cellSize, dims);
+        glm::ivec3 lo = glm::max(cell - 1, glm::ivec3(0));
+        glm::ivec3 hi = glm::min(cell + 1, dims - 1);
         
         bool tooClose = false;
-        for (const auto& existing : output.points) {
-            if (glm::length2(point.position - existing.position) < minDistSq) {
-                tooClose = true;
-                break;
+        for (int z = lo.z; z <= hi.z && !tooClose; z++) {
+            for (int y = lo.y; y <= hi.y && !tooClose; y++) {
+                for (int x = lo.x; x <= hi.x && !tooClose; x++) {
+                    int32_t k = cellHead[(size_t(z) * dims.y + y) * dims.x + x];
+                    for (; k >= 0; k = nextInCell[k]) {
+                        if (glm::length2(position - input.positions[kept[k]]) < minDistSq) {
+                            tooClose = true;
+                            break;
+                        }
+                    }
+                }
             }
         }
         
         if (!tooClose) {
-            output.points.push_back(point);
+            int32_t& head = cellHead[(size_t(cell.z) * dims.y + cell.y) * dims.x + cell.x];
+            nextInCell.push_back(head);
+            head = static_cast<int32_t>(kept.size());
+            kept.push_back(idx);
         }
     }
     
-    output.updateBounds();
-    outputs.push_back(std::move(output));
+    PCGSpatialData output;
+    output.gather(input, kept);
+    outputs.push_back(makePCGData(std::move(output)));
     
     return true;
 }
@@ -585,42 +926,39 @@ std::vector<PCGPin> PCGBoundsFilterNode::getOutputPins() const {
 }
 
 bool PCGBoundsFilterNode::execute(PCGContext& context,
-                                   const std::vector<PCGData>& inputs,
-                                   std::vector<PCGData>& outputs) {
-    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(inputs[0])) {
+                                   const std::vector<PCGDataPtr>& inputs,
+                                   std::vector<PCGDataPtr>& outputs) {
+    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(*inputs[0])) {
         return false;
     }
     
-    const PCGSpatialData& input = std::get<PCGSpatialData>(inputs[0]);
-    
-    PCGSpatialData inside, outside;
+    const PCGSpatialData& input = std::get<PCGSpatialData>(*inputs[0]);
+    const bool invert = getBoolSetting("Invert", invert_);
     
-    glm::vec3 checkMin = boundsMin_;
-    glm::vec3 checkMax = boundsMax_;
+    glm::vec3 checkMin = getVec3Setting("BoundsMin", boundsMin_);
+    glm::vec3 checkMax = getVec3Setting("BoundsMax", boundsMax_);
     if (checkMin == glm::vec3(0) && checkMax == glm::vec3(0)) {
         checkMin = context.worldBoundsMin;
         checkMax = context.worldBoundsMax;
     }
     
-    for (const auto& point : input.points) {
-        bool inBounds = point.position.x >= checkMin.x && point.position.x <= checkMax.x &&
-                        point.position.y >= checkMin.y && point.position.y <= checkMax.y &&
-                        point.position.z >= checkMin.z && point.position.z <= checkMax.z;
-        
-        if (invert_) inBounds = !inBounds;
-        
-        if (inBounds) {
-            inside.points.push_back(point);
-        } else {
-            outside.points.push_back(point);
+    std::vector<uint8_t> inside(input.size());
+    parallelPoints(context, input.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const glm::vec3& position = input.positions[i];
+            bool inBounds = position.x >= checkMin.x && position.x <= checkMax.x &&
+                            position.y >= checkMin.y && position.y <= checkMax.y &&
+                            position.z >= checkMin.z && position.z <= checkMax.z;
+            
+            inside[i] = inBounds != invert;
         }
-    }
+    });
     
-    inside.updateBounds();
-    outside.updateBounds();
+    PCGSpatialData insideData, outsideData;
+    PCGSpatialData::partition(input, inside, &insideData, &outsideData);
     
-    outputs.push_back(std::move(inside));
-    outputs.push_back(std::move(outside));
+    outputs.push_back(makePCGData(std::move(insideData)));
+    outputs.push_back(makePCGData(std::move(outsideData)));
     
     return true;
 }
@@ -652,43 +990,43 @@ std::vector<PCGPin> PCGLayerFilterNode::getOutputPins() const {
 }
 
 bool PCGLayerFilterNode::execute(PCGContext& context,
-                                  const std::vector<PCGData>& inputs,
-                                  std::vector<PCGData>& outputs) {
-    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(inputs[0])) {
+                                  const std::vector<PCGDataPtr>& inputs,
+                                  std::vector<PCGDataPtr>& outputs) {
+    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(*inputs[0])) {
         return false;
     }
     
-    const PCGSpatialData& input = std::get<PCGSpatialData>(inputs[0]);
+    const PCGSpatialData& input = std::get<PCGSpatialData>(*inputs[0]);
     const PCGLandscapeData* landscape = nullptr;
-    if (inputs.size() > 1 && std::holds_alternative<PCGLandscapeData>(inputs[1])) {
-        landscape = &std::get<PCGLandscapeData>(inputs[1]);
+    if (inputs.size() > 1 && std::holds_alternative<PCGLandscapeData>(*inputs[1])) {
+        landscape = &std::get<PCGLandscapeData>(*inputs[1]);
     }
     
-    PCGSpatialData kept, rejected;
+    const uint32_t layerIndex = static_cast<uint32_t>(getIntSetting("LayerIndex", static_cast<int32_t>(layerIndex_)));
+    const float minWeight = getFloatSetting("MinWeight", minWeight_);
+    const float maxWeight = getFloatSetting("MaxWeight", maxWeight_);
     
-    for (const auto& point : input.points) {
-        float weight = 0.0f;
-        
-        if (landscape && landscape->layerWeightQuery) {
-            weight = landscape->layerWeightQuery(glm::vec2(point.position.x, point.position.z), layerIndex_);
-        } else if (context.landscape) {
-            weight = context.landscape->getLayerWeight(point.position.x, point.position.z, layerIndex_);
-        }
-        
-        bool passes = weight >= minWeight_ && weight <= maxWeight_;
-        
-        if (passes) {
-            kept.points.push_back(point);
-        } else {
-            rejected.points.push_back(point);
+    std::vector<uint8_t> passes(input.size());
+    parallelPoints(context, input.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const glm::vec3& position = input.positions[i];
+            float weight = 0.0f;
+            
+            if (landscape && landscape->layerWeightQuery) {
+                weight = landscape->layerWeightQuery(glm::vec2(position.x, position.z), layerIndex);
+            } else if (context.landscape) {
+                weight = context.landscape->getLayerWeight(position.x, position.z, layerIndex);
+            }
+            
+            passes[i] = weight >= minWeight && weight <= maxWeight;
         }
-    }
+    });
     
-    kept.updateBounds();
-    rejected.updateBounds();
+    PCGSpatialData kept, rejected;
+    PCGSpatialData::partition(input, passes, &kept, &rejected);
     
-    outputs.push_back(std::move(kept));
-    outputs.push_back(std::move(rejected));
+    outputs.push_back(makePCGData(std::move(kept)));
+    outputs.push_back(makePCGData(std::move(rejected)));
     
     return true;
 }
@@ -718,55 +1056,61 @@ std::vector<PCGPin> PCGTransformNode::getOutputPins() const {
 }
 
 bool PCGTransformNode::execute(PCGContext& context,
-                                const std::vector<PCGData>& inputs,
-                                std::vector<PCGData>& outputs) {
-    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(inputs[0])) {
+                                const std::vector<PCGDataPtr>& inputs,
+                                std::vector<PCGDataPtr>& outputs) {
+    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(*inputs[0])) {
         return false;
     }
     
-    const PCGSpatialData& input = std::get<PCGSpatialData>(inputs[0]);
-    context.seedRNG(nodeId);
-    
-    PCGSpatialData output;
-    output.points.reserve(input.points.size());
-    
-    for (size_t i = 0; i < input.points.size(); i++) {
-        PCGPoint point = input.points[i];
-        
-        // Random offset
-        glm::vec3 offset(
-            context.randomFloat(offsetMin_.x, offsetMax_.x),
-            context.randomFloat(offsetMin_.y, offsetMax_.y),
-            context.randomFloat(offsetMin_.z, offsetMax_.z)
-        );
-        point.position += offset;
-        
-        // Random rotation
-        glm::vec3 eulerRot(
-            context.randomFloat(rotationMin_.x, rotationMax_.x),
-            context.randomFloat(rotationMin_.y, rotationMax_.y),
-            context.randomFloat(rotationMin_.z, rotationMax_.z)
-        );
-        glm::quat randomRot = glm::quat(glm::radians(eulerRot));
-        point.rotation = randomRot * point.rotation;
-        
-        // Random scale
-        if (uniformScale_) {
-            float s = context.randomFloat(scaleMin_.x, scaleMax_.x);
-            point.scale *= s;
-        } else {
-            point.scale *= glm::vec3(
-                context.randomFloat(scaleMin_.x, scaleMax_.x),
-                context.randomFloat(scaleMin_.y, scaleMax_.y),
-                context.randomFloat(scaleMin_.z, scaleMax_.z)
+    const glm::vec3 offsetMin = getVec3Setting("OffsetMin", offsetMin_);
+    const glm::vec3 offsetMax = getVec3Setting("OffsetMax", offsetMax_);
+    const glm::vec3 rotationMin = getVec3Setting("RotationMin", rotationMin_);
+    const glm::vec3 rotationMax = getVec3Setting("RotationMax", rotationMax_);
+    const glm::vec3 scaleMin = getVec3Setting("ScaleMin", scaleMin_);
+    const glm::vec3 scaleMax = getVec3Setting("ScaleMax", scaleMax_);
+    const bool uniformScale = getBoolSetting("UniformScale", uniformScale_);
+    
+    PCGSpatialData output = std::get<PCGSpatialData>(*inputs[0]);  // Inputs are shared; modify a copy
+    
+    parallelPoints(context, output.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            // Keyed by the point's seed, so a point keeps its variation
+            // when upstream edits add or remove others
+            PCGPointRandom random = context.pointRandom(nodeId, static_cast<uint32_t>(output.seeds[i]));
+            
+            // Random offset
+            glm::vec3 offset(
+                random.nextFloat(offsetMin.x, offsetMax.x),
+                random.nextFloat(offsetMin.y, offsetMax.y),
+                random.nextFloat(offsetMin.z, offsetMax.z)
+            );
+            output.positions[i] += offset;
+            
+            // Random rotation
+            glm::vec3 eulerRot(
+                random.nextFloat(rotationMin.x, rotationMax.x),
+                random.nextFloat(rotationMin.y, rotationMax.y),
+                random.nextFloat(rotationMin.z, rotationMax.z)
             );
+            glm::quat randomRot = glm::quat(glm::radians(eulerRot));
+            output.rotations[i] = randomRot * output.rotations[i];
+            
+            // Random scale
+            if (uniformScale) {
+                float s = random.nextFloat(scaleMin.x, scaleMax.x);
+                output.scales[i] *= s;
+            } else {
+                output.scales[i] *= glm::vec3(
+                    random.nextFloat(scaleMin.x, scaleMax.x),
+                    random.nextFloat(scaleMin.y, scaleMax.y),
+                    random.nextFloat(scaleMin.z, scaleMax.z)
+                );
+            }
         }
-        
-        output.points.push_back(point);
-    }
+    });
     
     output.updateBounds();
-    outputs.push_back(std::move(output));
+    outputs.push_back(makePCGData(std::move(output)));
     
     return true;
 }
@@ -801,48 +1145,46 @@ std::vector<PCGPin> PCGProjectToSurfaceNode::getOutputPins() const {
 }
 
 bool PCGProjectToSurfaceNode::execute(PCGContext& context,
-                                       const std::vector<PCGData>& inputs,
-                                       std::vector<PCGData>& outputs) {
-    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(inputs[0])) {
+                                       const std::vector<PCGDataPtr>& inputs,
+                                       std::vector<PCGDataPtr>& outputs) {
+    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(*inputs[0])) {
         return false;
     }
     
-    const PCGSpatialData& input = std::get<PCGSpatialData>(inputs[0]);
     const PCGLandscapeData* landscape = nullptr;
-    if (inputs.size() > 1 && std::holds_alternative<PCGLandscapeData>(inputs[1])) {
-        landscape = &std::get<PCGLandscapeData>(inputs[1]);
+    if (inputs.size() > 1 && std::holds_alternative<PCGLandscapeData>(*inputs[1])) {
+        landscape = &std::get<PCGLandscapeData>(*inputs[1]);
     }
     
-    PCGSpatialData output;
-    output.points.reserve(input.points.size());
+    const float verticalOffset = getFloatSetting("VerticalOffset", verticalOffset_);
+    const bool alignToNormal = getBoolSetting("AlignToNormal", alignToNormal_);
     
-    for (const auto& point : input.points) {
-        PCGPoint projected = point;
-        
-        glm::vec2 xz(point.position.x, point.position.z);
-        
-        if (landscape && landscape->heightQuery) {
-            projected.position.y = landscape->heightQuery(xz) + verticalOffset_;
-            if (landscape->normalQuery) {
-                projected.normal = landscape->normalQuery(xz);
+    PCGSpatialData output = std::get<PCGSpatialData>(*inputs[0]);  // Inputs are shared; modify a copy
+    
+    parallelPoints(context, output.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            glm::vec3& position = output.positions[i];
+            glm::vec3& normal = output.normals[i];
+            glm::vec2 xz(position.x, position.z);
+            
+            if (landscape && landscape->heightQuery) {
+                position.y = landscape->heightQuery(xz) + verticalOffset;
+                if (landscape->normalQuery) {
+                    normal = landscape->normalQuery(xz);
+                }
+            } else if (context.landscape) {
+                position.y = context.landscape->getHeightAt(xz.x, xz.y) + verticalOffset;
+                normal = context.landscape->getNormalAt(xz.x, xz.y);
+            }
+            
+            if (alignToNormal && normal.y < 0.999f) {
+                output.rotations[i] = rotationToNormal(normal) * output.rotations[i];
             }
-        } else if (context.landscape) {
-            projected.position.y = context.landscape->getHeightAt(xz.x, xz.y) + verticalOffset_;
-            projected.normal = context.landscape->getNormalAt(xz.x, xz.y);
-        }
-        
-        if (alignToNormal_ && projected.normal.y < 0.999f) {
-            glm::vec3 up(0, 1, 0);
-            glm::vec3 axis = glm::normalize(glm::cross(up, projected.normal));
-            float angle = std::acos(glm::dot(up, projected.normal));
-            projected.rotation = glm::angleAxis(angle, axis) * projected.rotation;
         }
-        
-        output.points.push_back(projected);
-    }
+    });
     
     output.updateBounds();
-    outputs.push_back(std::move(output));
+    outputs.push_back(makePCGData(std::move(output)));
     
     return true;
 }
@@ -869,14 +1211,13 @@ std::vector<PCGPin> PCGStaticMeshSpawnerNode::getOutputPins() const {
 }
 
 bool PCGStaticMeshSpawnerNode::execute(PCGContext& context,
-                                        const std::vector<PCGData>& inputs,
-                                        std::vector<PCGData>& outputs) {
-    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(inputs[0])) {
+                                        const std::vector<PCGDataPtr>& inputs,
+                                        std::vector<PCGDataPtr>& outputs) {
+    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(*inputs[0])) {
         return false;
     }
     
-    const PCGSpatialData& input = std::get<PCGSpatialData>(inputs[0]);
-    context.seedRNG(nodeId);
+    const PCGSpatialData& input = std::get<PCGSpatialData>(*inputs[0]);
     
     if (meshPaths_.empty()) {
         return true;  // Nothing to spawn
@@ -887,9 +1228,10 @@ bool PCGStaticMeshSpawnerNode::execute(PCGContext& context,
     for (float w : meshWeights_) totalWeight += w;
     if (totalWeight <= 0.0f) totalWeight = 1.0f;
     
-    for (const auto& point : input.points) {
+    for (size_t p = 0; p < input.size(); p++) {
         // Select mesh based on weights
-        float r = context.randomFloat(0.0f, totalWeight);
+        PCGPointRandom random = context.pointRandom(nodeId, static_cast<uint32_t>(input.seeds[p]));
+        float r = random.nextFloat(0.0f, totalWeight);
         size_t meshIndex = 0;
         float acc = 0.0f;
         for (size_t i = 0; i < meshWeights_.size(); i++) {
@@ -901,7 +1243,7 @@ bool PCGStaticMeshSpawnerNode::execute(PCGContext& context,
         }
         
         // Would spawn mesh here using the renderer
-        // renderer->spawnStaticMesh(meshPaths_[meshIndex], point.position, point.rotation, point.scale);
+        // renderer->spawnStaticMesh(meshPaths_[meshIndex], input.positions[p], input.rotations[p], input.scales[p]);
     }
     
     return true;
@@ -919,6 +1261,15 @@ void PCGStaticMeshSpawnerNode::setMeshAssets(const std::vector<std::string>& mes
     meshWeights_.resize(meshPaths.size(), 1.0f);
 }
 
+uint64_t PCGStaticMeshSpawnerNode::getSettingsHash() const {
+    uint64_t hash = PCGNode::getSettingsHash();
+    for (size_t i = 0; i < meshPaths_.size(); i++) {
+        hash = hashBytes(meshPaths_[i].data(), meshPaths_[i].size(), hash);
+        hash = hashBytes(&meshWeights_[i], sizeof(float), hash);
+    }
+    return hash;
+}
+
 //------------------------------------------------------------------------------
 // Foliage Spawner Node
 //------------------------------------------------------------------------------
@@ -934,25 +1285,32 @@ std::vector<PCGPin> PCGFoliageSpawnerNode::getOutputPins() const {
 }
 
 bool PCGFoliageSpawnerNode::execute(PCGContext& context,
-                                     const std::vector<PCGData>& inputs,
-                                     std::vector<PCGData>& outputs) {
-    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(inputs[0])) {
+                                     const std::vector<PCGDataPtr>& inputs,
+                                     std::vector<PCGDataPtr>& outputs) {
+    if (inputs.empty() || !std::holds_alternative<PCGSpatialData>(*inputs[0])) {
         return false;
     }
     
-    const PCGSpatialData& input = std::get<PCGSpatialData>(inputs[0]);
+    const PCGSpatialData& input = std::get<PCGSpatialData>(*inputs[0]);
     
-    if (!context.foliage || foliageTypeId_ == 0) {
+    const uint32_t foliageTypeId = static_cast<uint32_t>(getIntSetting("FoliageTypeId", static_cast<int32_t>(foliageTypeId_)));
+    if (!context.foliage || foliageTypeId == 0) {
         return true;  // Nothing to spawn
     }
     
-    for (const auto& point : input.points) {
+    // Transforms in parallel; the foliage system itself is fed serially
+    std::vector<glm::mat4> transforms(input.size());
+    parallelPoints(context, input.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            glm::mat4 transform = glm::translate(glm::mat4(1.0f), input.positions[i]);
+            transform = transform * glm::mat4_cast(input.rotations[i]);
+            transforms[i] = glm::scale(transform, input.scales[i]);
+        }
+    });
+    
+    for (const glm::mat4& transform : transforms) {
         // Add foliage instance
-        glm::mat4 transform = glm::translate(glm::mat4(1.0f), point.position);
-        transform = transform * glm::mat4_cast(point.rotation);
-        transform = glm::scale(transform, point.scale);
-        
-        context.foliage->addInstance(foliageTypeId_, transform);
+        context.foliage->addInstance(foliageTypeId, transform);
     }
     
     return true;
@@ -968,6 +1326,10 @@ void PCGFoliageSpawnerNode::setFoliageType(uint32_t foliageTypeId) {
     foliageTypeId_ = foliageTypeId;
 }
 
+uint64_t PCGFoliageSpawnerNode::getSettingsHash() const {
+    return hashBytes(&foliageTypeId_, sizeof(foliageTypeId_), PCGNode::getSettingsHash());
+}
+
 //------------------------------------------------------------------------------
 // PCG Graph
 //------------------------------------------------------------------------------
@@ -1056,88 +1418,214 @@ void PCGGraph::updateExecutionOrder() {
     if (!orderDirty_) return;
     
     executionOrder_.clear();
+    plan_.clear();
     
     // Build dependency graph
-    std::unordered_map<uint32_t, std::vector<uint32_t>> deps;  // node -> depends on
+    std::unordered_map<uint32_t, PCGNode*> nodesById;
+    std::unordered_map<uint32_t, std::vector<PCGConnection>> inputs;    // node -> connections into it
+    std::unordered_map<uint32_t, std::vector<uint32_t>> dependents;     // node -> nodes reading it
     std::unordered_map<uint32_t, int> inDegree;
     
     for (const auto& node : nodes_) {
-        deps[node->nodeId] = {};
+        nodesById[node->nodeId] = node.get();
         inDegree[node->nodeId] = 0;
     }
     
     for (const auto& conn : connections_) {
-        deps[conn.targetNode].push_back(conn.sourceNode);
+        if (!nodesById.count(conn.sourceNode) || !nodesById.count(conn.targetNode)) continue;
+        inputs[conn.targetNode].push_back(conn);
+        dependents[conn.sourceNode].push_back(conn.targetNode);
         inDegree[conn.targetNode]++;
     }
     
-    // Topological sort (Kahn's algorithm)
+    // Topological sort (Kahn's algorithm). Nodes on cycles never become
+    // ready and are skipped.
     std::queue<uint32_t> queue;
-    for (const auto& [id, degree] : inDegree) {
-        if (degree == 0) {
-            queue.push(id);
+    for (const auto& node : nodes_) {
+        if (inDegree[node->nodeId] == 0) {
+            queue.push(node->nodeId);
         }
     }
     
+    std::unordered_map<uint32_t, uint32_t> planIndex;
     while (!queue.empty()) {
         uint32_t nodeId = queue.front();
         queue.pop();
+        planIndex[nodeId] = static_cast<uint32_t>(executionOrder_.size());
         executionOrder_.push_back(nodeId);
+        plan_.push_back({nodesById[nodeId], inputs[nodeId], {}});
         
-        for (const auto& conn : connections_) {
-            if (conn.sourceNode == nodeId) {
-                if (--inDegree[conn.targetNode] == 0) {
-                    queue.push(conn.targetNode);
-                }
+        for (uint32_t target : dependents[nodeId]) {
+            if (--inDegree[target] == 0) {
+                queue.push(target);
             }
         }
     }
     
+    // Each reader once, however many pins it connects
+    for (PlannedNode& planned : plan_) {
+        for (uint32_t target : dependents[planned.node->nodeId]) {
+            auto it = planIndex.find(target);
+            if (it != planIndex.end()) {
+                planned.dependents.push_back(it->second);
+            }
+        }
+        std::sort(planned.dependents.begin(), planned.dependents.end());
+        planned.dependents.erase(std::unique(planned.dependents.begin(), planned.dependents.end()),
+                                 planned.dependents.end());
+    }
+    
+    // Drop the cache of removed nodes
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        it = nodesById.count(it->first) ? std::next(it) : cache_.erase(it);
+    }
+    
     orderDirty_ = false;
 }
 
 bool PCGGraph::execute(PCGContext& context) {
+    auto startTime = std::chrono::high_resolution_clock::now();
     updateExecutionOrder();
     
-    // Store outputs for each node
-    std::unordered_map<uint32_t, std::vector<PCGData>> nodeOutputs;
+    // Everything nodes read besides their settings and inputs. The landscape
+    // revision covers edits made through the same LandscapeSystem.
+    uint64_t landscapeRevision = context.landscape ? context.landscape->getRevision() : 0;
+    uint64_t contextKey = hashBytes(&context.seed, sizeof(context.seed));
+    contextKey = hashBytes(&context.worldBoundsMin, sizeof(glm::vec3), contextKey);
+    contextKey = hashBytes(&context.worldBoundsMax, sizeof(glm::vec3), contextKey);
+    contextKey = hashBytes(&context.landscape, sizeof(context.landscape), contextKey);
+    contextKey = hashBytes(&landscapeRevision, sizeof(landscapeRevision), contextKey);
+    contextKey = hashBytes(&context.foliage, sizeof(context.foliage), contextKey);
+    
+    // Entries exist before any node runs, so workers only look them up
+    for (const auto& planned : plan_) {
+        cache_[planned.node->nodeId];
+    }
+    
+    lastStats_ = ExecutionStats();
     
-    for (uint32_t nodeId : executionOrder_) {
-        PCGNode* node = getNode(nodeId);
-        if (!node) continue;
+    // A node's key covers its settings, the context and its inputs' keys,
+    // so any change upstream reaches everything below it. Keys don't need
+    // outputs, so they're all settled here in plan order.
+    std::vector<uint8_t> pending(plan_.size(), 0);
+    for (size_t i = 0; i < plan_.size(); i++) {
+        const PlannedNode& planned = plan_[i];
+        NodeCache& entry = cache_[planned.node->nodeId];
         
-        // Gather inputs
-        std::vector<PCGData> inputs;
-        auto inputPins = node->getInputPins();
-        inputs.resize(inputPins.size());
+        uint64_t key = hashCombine(contextKey, planned.node->getSettingsHash());
+        key = hashCombine(key, entry.revision);
+        for (const auto& conn : planned.inputs) {
+            uint64_t pins = (uint64_t(conn.sourcePin) << 32) | conn.targetPin;
+            key = hashCombine(key, hashCombine(cache_[conn.sourceNode].key, pins));
+        }
         
-        for (const auto& conn : connections_) {
-            if (conn.targetNode == nodeId) {
-                auto& srcOutputs = nodeOutputs[conn.sourceNode];
-                if (conn.sourcePin < srcOutputs.size()) {
+        if (entry.valid && entry.key == key) {
+            lastStats_.nodesCached++;
+            continue;
+        }
+        entry.key = key;
+        entry.valid = false;
+        pending[i] = 1;
+    }
+    
+    // Count each pending node's pending inputs; cached inputs are ready now
+    auto remaining = std::make_unique<std::atomic<uint32_t>[]>(plan_.size());
+    for (size_t i = 0; i < plan_.size(); i++) {
+        if (!pending[i]) continue;
+        for (uint32_t dependent : plan_[i].dependents) {
+            remaining[dependent].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    std::vector<uint32_t> roots;
+    for (uint32_t i = 0; i < plan_.size(); i++) {
+        if (pending[i] && remaining[i].load(std::memory_order_relaxed) == 0) {
+            roots.push_back(i);
+        }
+    }
+    
+    const PCGDataPtr emptyData = makePCGData(PCGData());
+    
+    Sanic::JobSystem& jobs = context.getJobSystem();
+    Sanic::JobCounter counter;
+    std::atomic<bool> failed{false};
+    std::atomic<uint32_t> executed{0};
+    
+    // Each finished node releases its readers. Readers are submitted before
+    // the job completes, so the counter can't drain early. After a failure
+    // nothing more is released.
+    std::function<void(uint32_t)> schedule = [&](uint32_t index) {
+        jobs.submit([&, index] {
+            if (failed.load(std::memory_order_relaxed)) return;
+            const PlannedNode& planned = plan_[index];
+            
+            // Gather inputs, sharing the upstream outputs
+            std::vector<PCGDataPtr> inputs(planned.node->getInputPins().size(), emptyData);
+            for (const auto& conn : planned.inputs) {
+                const auto& srcOutputs = cache_.find(conn.sourceNode)->second.outputs;
+                if (conn.sourcePin < srcOutputs.size() && conn.targetPin < inputs.size()) {
                     inputs[conn.targetPin] = srcOutputs[conn.sourcePin];
                 }
             }
-        }
-        
-        // Execute node
-        std::vector<PCGData> outputs;
-        if (!node->execute(context, inputs, outputs)) {
-            return false;
-        }
-        
-        nodeOutputs[nodeId] = std::move(outputs);
+            
+            // Execute node
+            PCGContext nodeContext = context;
+            std::vector<PCGDataPtr> outputs;
+            executed.fetch_add(1, std::memory_order_relaxed);
+            if (!planned.node->execute(nodeContext, inputs, outputs)) {
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+            
+            NodeCache& entry = cache_.find(planned.node->nodeId)->second;
+            entry.outputs = std::move(outputs);
+            entry.valid = true;
+            
+            for (uint32_t dependent : planned.dependents) {
+                if (pending[dependent] &&
+                    remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    schedule(dependent);
+                }
+            }
+        }, &counter);
+    };
+    
+    for (uint32_t root : roots) {
+        schedule(root);
+    }
+    jobs.wait(counter);
+    lastStats_.nodesExecuted = executed.load();
+    
+    if (failed.load()) {
+        return false;
     }
     
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    lastStats_.executionTimeMs = elapsed.count();
     return true;
 }
 
 bool PCGGraph::executePartial(PCGContext& context, const std::vector<uint32_t>& nodeIds) {
-    // Execute only specified nodes and their dependencies
-    // (simplified - would need proper dependency tracking in production)
+    // Downstream keys follow from the invalidated ones; everything else is
+    // served from the cache
+    for (uint32_t nodeId : nodeIds) {
+        invalidate(nodeId);
+    }
     return execute(context);
 }
 
+void PCGGraph::invalidate(uint32_t nodeId) {
+    cache_[nodeId].revision++;
+}
+
+void PCGGraph::clearCache() {
+    cache_.clear();
+}
+
+const std::vector<PCGDataPtr>* PCGGraph::getNodeOutputs(uint32_t nodeId) const {
+    auto it = cache_.find(nodeId);
+    return (it != cache_.end() && it->second.valid) ? &it->second.outputs : nullptr;
+}
+
 bool PCGGraph::save(const std::string& path) const {
     // Serialization would go here
     return true;
@@ -1181,6 +1669,7 @@ bool PCGFramework::initialize(VulkanRenderer* renderer) {
 
 void PCGFramework::shutdown() {
     m_graphs.clear();
+    m_presetGraphs.clear();
     m_renderer = nullptr;
 }
 
@@ -1259,70 +1748,80 @@ std::vector<std::string> PCGFramework::getAvailableNodeTypes() const {
     return types;
 }
 
+PCGFramework::PresetGraph& PCGFramework::getPresetGraph(
+    const std::string& name, const std::function<void(PCGGraph&, std::vector<uint32_t>&)>& build) {
+    PresetGraph& preset = m_presetGraphs[name];
+    if (!getGraph(preset.graphId)) {
+        preset.graphId = createGraph(name);
+        preset.nodeIds.clear();
+        build(*getGraph(preset.graphId), preset.nodeIds);
+    }
+    return preset;
+}
+
 void PCGFramework::generateForest(const glm::vec3& boundsMin, const glm::vec3& boundsMax,
                                    int32_t seed, float density) {
-    uint32_t graphId = createGraph("Forest");
-    PCGGraph* graph = getGraph(graphId);
-    
-    // Create sampler
-    auto sampler = createNode("Surface Sampler");
-    sampler->setSetting("PointsPerSquareMeter", density);
-    uint32_t samplerId = graph->addNode(std::move(sampler));
-    
-    // Create density filter
-    auto filter = createNode("Density Filter");
-    filter->setSetting("NoiseScale", 50.0f);
-    uint32_t filterId = graph->addNode(std::move(filter));
-    graph->connect(samplerId, 0, filterId, 0);
-    
-    // Create transform
-    auto transform = createNode("Transform");
-    transform->setSetting("ScaleMin", glm::vec3(0.8f));
-    transform->setSetting("ScaleMax", glm::vec3(1.2f));
-    uint32_t transformId = graph->addNode(std::move(transform));
-    graph->connect(filterId, 0, transformId, 0);
-    
-    // Create spawner
-    auto spawner = createNode("Foliage Spawner");
-    uint32_t spawnerId = graph->addNode(std::move(spawner));
-    graph->connect(transformId, 0, spawnerId, 0);
+    PresetGraph& preset = getPresetGraph("Forest", [this](PCGGraph& graph, std::vector<uint32_t>& ids) {
+        // Create sampler
+        uint32_t samplerId = graph.addNode(createNode("Surface Sampler"));
+        
+        // Create density filter
+        auto filter = createNode("Density Filter");
+        filter->setSetting("NoiseScale", 50.0f);
+        uint32_t filterId = graph.addNode(std::move(filter));
+        graph.connect(samplerId, 0, filterId, 0);
+        
+        // Create transform
+        auto transform = createNode("Transform");
+        transform->setSetting("ScaleMin", glm::vec3(0.8f));
+        transform->setSetting("ScaleMax", glm::vec3(1.2f));
+        uint32_t transformId = graph.addNode(std::move(transform));
+        graph.connect(filterId, 0, transformId, 0);
+        
+        // Create spawner
+        uint32_t spawnerId = graph.addNode(createNode("Foliage Spawner"));
+        graph.connect(transformId, 0, spawnerId, 0);
+        
+        ids = {samplerId, filterId, transformId, spawnerId};
+    });
     
-    // Execute
-    executeGraphInBounds(graphId, boundsMin, boundsMax, seed);
+    PCGGraph* graph = getGraph(preset.graphId);
+    graph->getNode(preset.nodeIds[0])->setSetting("PointsPerSquareMeter", density);
     
-    // Cleanup
-    destroyGraph(graphId);
+    // Execute; unchanged stages come from the cache
+    executeGraphInBounds(preset.graphId, boundsMin, boundsMax, seed);
 }
 
 void PCGFramework::generateRocks(const glm::vec3& boundsMin, const glm::vec3& boundsMax,
                                   int32_t seed, float density) {
     // Similar to forest but with rock meshes
-    uint32_t graphId = createGraph("Rocks");
-    PCGGraph* graph = getGraph(graphId);
+    PresetGraph& preset = getPresetGraph("Rocks", [this](PCGGraph& graph, std::vector<uint32_t>& ids) {
+        auto sampler = createNode("Surface Sampler");
+        sampler->setSetting("MinSlope", 10.0f);  // Rocks on slopes
+        uint32_t samplerId = graph.addNode(std::move(sampler));
+        
+        auto distance = createNode("Distance Filter");
+        distance->setSetting("MinDistance", 5.0f);
+        uint32_t distanceId = graph.addNode(std::move(distance));
+        graph.connect(samplerId, 0, distanceId, 0);
+        
+        auto transform = createNode("Transform");
+        transform->setSetting("ScaleMin", glm::vec3(0.5f));
+        transform->setSetting("ScaleMax", glm::vec3(2.0f));
+        transform->setSetting("RotationMax", glm::vec3(360, 360, 360));
+        uint32_t transformId = graph.addNode(std::move(transform));
+        graph.connect(distanceId, 0, transformId, 0);
+        
+        uint32_t spawnerId = graph.addNode(createNode("Static Mesh Spawner"));
+        graph.connect(transformId, 0, spawnerId, 0);
+        
+        ids = {samplerId, distanceId, transformId, spawnerId};
+    });
+    
+    PCGGraph* graph = getGraph(preset.graphId);
+    graph->getNode(preset.nodeIds[0])->setSetting("PointsPerSquareMeter", density * 0.1f);
     
-    auto sampler = createNode("Surface Sampler");
-    sampler->setSetting("PointsPerSquareMeter", density * 0.1f);
-    sampler->setSetting("MinSlope", 10.0f);  // Rocks on slopes
-    uint32_t samplerId = graph->addNode(std::move(sampler));
-    
-    auto distance = createNode("Distance Filter");
-    distance->setSetting("MinDistance", 5.0f);
-    uint32_t distanceId = graph->addNode(std::move(distance));
-    graph->connect(samplerId, 0, distanceId, 0);
-    
-    auto transform = createNode("Transform");
-    transform->setSetting("ScaleMin", glm::vec3(0.5f));
-    transform->setSetting("ScaleMax", glm::vec3(2.0f));
-    transform->setSetting("RotationMax", glm::vec3(360, 360, 360));
-    uint32_t transformId = graph->addNode(std::move(transform));
-    graph->connect(distanceId, 0, transformId, 0);
-    
-    auto spawner = createNode("Static Mesh Spawner");
-    uint32_t spawnerId = graph->addNode(std::move(spawner));
-    graph->connect(transformId, 0, spawnerId, 0);
-    
-    executeGraphInBounds(graphId, boundsMin, boundsMax, seed);
-    destroyGraph(graphId);
+    executeGraphInBounds(preset.graphId, boundsMin, boundsMax, seed);
 }
 
 void PCGFramework::populateSpline(const PCGSplineData& spline, int32_t seed) {
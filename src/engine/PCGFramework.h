@@ -8,6 +8,9 @@
  * 
  * Features:
  * - Graph-based procedural generation
+ * - Independent branches run in parallel; nodes split work over point ranges
+ * - Node outputs cached by settings and inputs, so edits re-run only downstream
+ * - Columnar point data with typed attribute columns
  * - Multiple node types (samplers, filters, spawners)
  * - Deterministic generation from seeds
  * - Runtime and editor-time generation
@@ -16,6 +19,7 @@
  */
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <vulkan/vulkan.h>
 #include <memory>
 #include <vector>
@@ -24,6 +28,11 @@
 #include <functional>
 #include <random>
 #include <variant>
+#include <limits>
+
+namespace Sanic {
+class JobSystem;
+}
 
 namespace Kinetic {
 
@@ -37,39 +46,88 @@ class FoliageSystem;
 //------------------------------------------------------------------------------
 
 /**
- * Point data for PCG operations
+ * A single point, for building and inspecting point data one at a time.
+ * Bulk work should go through the PCGSpatialData columns directly.
  */
 struct PCGPoint {
-    glm::vec3 position;
+    glm::vec3 position = glm::vec3(0);
     glm::vec3 normal = glm::vec3(0, 1, 0);
     glm::vec3 scale = glm::vec3(1);
     glm::quat rotation = glm::quat(1, 0, 0, 0);
     glm::vec4 color = glm::vec4(1);
     float density = 1.0f;
     int32_t seed = 0;
+};
+
+/**
+ * Custom per-point attribute, stored as one typed column
+ */
+enum class PCGAttributeType {
+    Float,
+    Int,
+    Vector
+};
+
+struct PCGAttributeColumn {
+    std::string name;
+    std::variant<std::vector<float>, std::vector<int32_t>, std::vector<glm::vec3>> values;
     
-    // Custom attributes
-    std::unordered_map<std::string, float> attributes;
+    PCGAttributeType getType() const { return static_cast<PCGAttributeType>(values.index()); }
 };
 
 /**
- * Spatial data collection
+ * Spatial data collection, stored as columns (one element per point)
  */
 struct PCGSpatialData {
-    std::vector<PCGPoint> points;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> scales;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec4> colors;
+    std::vector<float> densities;
+    std::vector<int32_t> seeds;
+    std::vector<PCGAttributeColumn> attributes;
     
     // Bounds
     glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
     glm::vec3 boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
     
+    size_t size() const { return positions.size(); }
+    bool empty() const { return positions.empty(); }
+    
+    // New points get PCGPoint defaults and zeroed attributes
+    void resize(size_t count);
+    void reserve(size_t count);
+    void addPoint(const PCGPoint& point);
+    PCGPoint getPoint(size_t index) const;
+    void setPoint(size_t index, const PCGPoint& point);
+    
     void updateBounds();
     void clear();
     void append(const PCGSpatialData& other);
     
-    // Spatial acceleration (built on demand)
+    // Replaces this data with the selected points of source, in order
+    void gather(const PCGSpatialData& source, const std::vector<uint32_t>& indices);
+    
+    // Splits source by mask (non-zero passes); either output may be null
+    static void partition(const PCGSpatialData& source, const std::vector<uint8_t>& mask,
+                          PCGSpatialData* pass, PCGSpatialData* fail);
+    
+    // Attribute columns, sized to the point count. T is float, int32_t or glm::vec3.
+    template<typename T>
+    std::vector<T>& addAttribute(const std::string& name, T defaultValue = T());
+    template<typename T>
+    std::vector<T>* getAttribute(const std::string& name);
+    template<typename T>
+    const std::vector<T>* getAttribute(const std::string& name) const;
+    const PCGAttributeColumn* findAttribute(const std::string& name) const;
+    
+    // Spatial acceleration (built on demand): point indices bucketed by
+    // grid cell, cell c owning spatialGrid[spatialCellStart[c] .. spatialCellStart[c + 1])
     mutable bool spatialIndexDirty = true;
     mutable std::vector<uint32_t> spatialGrid;
-    mutable glm::ivec3 gridDimensions;
+    mutable std::vector<uint32_t> spatialCellStart;
+    mutable glm::ivec3 gridDimensions = glm::ivec3(0);
     mutable float gridCellSize = 0.0f;
     
     void buildSpatialIndex(float cellSize) const;
@@ -77,6 +135,30 @@ struct PCGSpatialData {
     std::vector<uint32_t> queryBox(const glm::vec3& min, const glm::vec3& max) const;
 };
 
+template<typename T>
+std::vector<T>& PCGSpatialData::addAttribute(const std::string& name, T defaultValue) {
+    if (std::vector<T>* existing = getAttribute<T>(name)) {
+        return *existing;
+    }
+    attributes.push_back({name, std::vector<T>(size(), defaultValue)});
+    return std::get<std::vector<T>>(attributes.back().values);
+}
+
+template<typename T>
+std::vector<T>* PCGSpatialData::getAttribute(const std::string& name) {
+    for (auto& column : attributes) {
+        if (column.name == name) {
+            return std::get_if<std::vector<T>>(&column.values);
+        }
+    }
+    return nullptr;
+}
+
+template<typename T>
+const std::vector<T>* PCGSpatialData::getAttribute(const std::string& name) const {
+    return const_cast<PCGSpatialData*>(this)->getAttribute<T>(name);
+}
+
 /**
  * Landscape data for PCG queries
  */
@@ -84,6 +166,7 @@ struct PCGLandscapeData {
     glm::vec3 boundsMin;
     glm::vec3 boundsMax;
     
+    // Nodes call these from several threads at once
     std::function<float(const glm::vec2&)> heightQuery;
     std::function<glm::vec3(const glm::vec2&)> normalQuery;
     std::function<float(const glm::vec2&, uint32_t)> layerWeightQuery;  // Layer weight at position
@@ -100,6 +183,8 @@ struct PCGSplineData {
     float length = 0.0f;
 };
 
+struct PCGCollectionData;
+
 /**
  * PCG data variants
  */
@@ -107,15 +192,62 @@ using PCGData = std::variant<
     PCGSpatialData,
     PCGLandscapeData,
     PCGSplineData,
-    std::vector<PCGData>  // Collection
+    PCGCollectionData
 >;
 
+/**
+ * Several data items passed along one pin
+ */
+struct PCGCollectionData {
+    std::vector<std::shared_ptr<const PCGData>> items;
+};
+
+/**
+ * Node outputs are immutable once produced and shared: the cache and every
+ * downstream input hold the same data. A node that modifies its input
+ * copies it first.
+ */
+using PCGDataPtr = std::shared_ptr<const PCGData>;
+
+inline PCGDataPtr makePCGData(PCGData data) {
+    return std::make_shared<const PCGData>(std::move(data));
+}
+
 //------------------------------------------------------------------------------
 // PCG Node Base
 //------------------------------------------------------------------------------
 
 /**
- * PCG node execution context
+ * Counter-based random numbers (a PCG hash). Each point draws from its
+ * own stream, so results don't depend on how points are split across
+ * threads.
+ */
+struct PCGPointRandom {
+    uint32_t state;
+    
+    PCGPointRandom(int32_t seed, uint32_t nodeId, uint32_t key)
+        : state(hash(static_cast<uint32_t>(seed) ^ hash(nodeId ^ hash(key)))) {}
+    
+    static uint32_t hash(uint32_t value) {
+        uint32_t s = value * 747796405u + 2891336453u;
+        uint32_t word = ((s >> ((s >> 28u) + 4u)) ^ s) * 277803737u;
+        return (word >> 22u) ^ word;
+    }
+    
+    uint32_t nextUInt() {
+        state = hash(state);
+        return state;
+    }
+    
+    float nextFloat(float min = 0.0f, float max = 1.0f) {
+        return min + (max - min) * static_cast<float>(nextUInt() >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+/**
+ * PCG node execution context. Each node executes with its own copy, so
+ * rng is private to the node; work split over point ranges should use
+ * pointRandom instead.
  */
 struct PCGContext {
     int32_t seed = 0;
@@ -126,6 +258,11 @@ struct PCGContext {
     LandscapeSystem* landscape = nullptr;
     FoliageSystem* foliage = nullptr;
     
+    // Pool for nodes and point ranges (nullptr = JobSystem::getInstance()).
+    // Output doesn't depend on it, so it isn't part of cache keys.
+    Sanic::JobSystem* jobs = nullptr;
+    Sanic::JobSystem& getJobSystem() const;
+    
     // Random generator
     std::mt19937 rng;
     
@@ -147,6 +284,10 @@ struct PCGContext {
         std::uniform_int_distribution<int32_t> dist(min, max);
         return dist(rng);
     }
+    
+    PCGPointRandom pointRandom(uint32_t nodeId, uint32_t key) const {
+        return PCGPointRandom(seed, nodeId, key);
+    }
 };
 
 /**
@@ -186,26 +327,39 @@ public:
     virtual std::vector<PCGPin> getInputPins() const = 0;
     virtual std::vector<PCGPin> getOutputPins() const = 0;
     
-    // Execution
+    // Execution. Nodes in independent branches execute concurrently, so
+    // execute must not touch state shared with other nodes. inputs has one
+    // entry per input pin, never null (unconnected pins read empty data).
     virtual bool execute(PCGContext& context,
-                        const std::vector<PCGData>& inputs,
-                        std::vector<PCGData>& outputs) = 0;
+                        const std::vector<PCGDataPtr>& inputs,
+                        std::vector<PCGDataPtr>& outputs) = 0;
     
     // Settings
     struct Setting {
+        using Value = std::variant<bool, int32_t, float, glm::vec2, glm::vec3, std::string>;
         std::string name;
-        std::variant<bool, int32_t, float, glm::vec2, glm::vec3, std::string> value;
+        Value value;
     };
     
-    void setSetting(const std::string& name, const Setting::value_type& value);
+    void setSetting(const std::string& name, const Setting::Value& value);
     const Setting* getSetting(const std::string& name) const;
     virtual std::vector<Setting> getDefaultSettings() const { return {}; }
     
+    // Identifies everything that affects the output besides the inputs and
+    // context. Nodes with state outside settings_ must fold it in.
+    virtual uint64_t getSettingsHash() const;
+    
     // Unique ID
     uint32_t nodeId = 0;
     
 protected:
     std::unordered_map<std::string, Setting> settings_;
+    
+    // Setting value if set with the expected type, else fallback
+    float getFloatSetting(const std::string& name, float fallback) const;
+    int32_t getIntSetting(const std::string& name, int32_t fallback) const;
+    bool getBoolSetting(const std::string& name, bool fallback) const;
+    glm::vec3 getVec3Setting(const std::string& name, const glm::vec3& fallback) const;
 };
 
 //------------------------------------------------------------------------------
@@ -224,8 +378,8 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
@@ -250,8 +404,8 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
@@ -273,8 +427,8 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
@@ -299,8 +453,8 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
@@ -324,8 +478,8 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
@@ -346,8 +500,8 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
@@ -369,8 +523,8 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
@@ -396,8 +550,8 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
@@ -423,8 +577,8 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
@@ -449,12 +603,13 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
     void setMeshAssets(const std::vector<std::string>& meshPaths);
+    uint64_t getSettingsHash() const override;
     
 private:
     std::vector<std::string> meshPaths_;
@@ -475,12 +630,13 @@ public:
     std::vector<PCGPin> getOutputPins() const override;
     
     bool execute(PCGContext& context,
-                const std::vector<PCGData>& inputs,
-                std::vector<PCGData>& outputs) override;
+                const std::vector<PCGDataPtr>& inputs,
+                std::vector<PCGDataPtr>& outputs) override;
     
     std::vector<Setting> getDefaultSettings() const override;
     
     void setFoliageType(uint32_t foliageTypeId);
+    uint64_t getSettingsHash() const override;
     
 private:
     uint32_t foliageTypeId_ = 0;
@@ -501,7 +657,15 @@ struct PCGConnection {
 };
 
 /**
- * PCG graph containing nodes and connections
+ * PCG graph containing nodes and connections.
+ *
+ * Each node runs on the job system as soon as the nodes feeding it have
+ * finished, so independent branches overlap. Every node's outputs are
+ * cached under a key hashed from its settings, the context and its inputs'
+ * keys, so re-executing re-runs only nodes whose key changed: those edited
+ * and everything downstream of them. Spawners are cached too, so an
+ * unchanged spawner doesn't add its instances twice. Cached outputs are
+ * passed to readers by pointer, never copied.
  */
 class PCGGraph {
 public:
@@ -519,8 +683,25 @@ public:
     
     // Execution
     bool execute(PCGContext& context);
+    
+    // Re-executes nodeIds and everything downstream, even if their keys
+    // match (e.g. after edits to data the context doesn't reference)
     bool executePartial(PCGContext& context, const std::vector<uint32_t>& nodeIds);
     
+    // Forces nodeId to re-run on the next execution
+    void invalidate(uint32_t nodeId);
+    void clearCache();
+    
+    // Cached outputs of a node from the last execution, or nullptr
+    const std::vector<PCGDataPtr>* getNodeOutputs(uint32_t nodeId) const;
+    
+    struct ExecutionStats {
+        uint32_t nodesExecuted = 0;
+        uint32_t nodesCached = 0;
+        float executionTimeMs = 0.0f;
+    };
+    const ExecutionStats& getLastExecutionStats() const { return lastStats_; }
+    
     // Serialization
     bool save(const std::string& path) const;
     bool load(const std::string& path);
@@ -542,6 +723,24 @@ private:
     std::vector<uint32_t> executionOrder_;
     bool orderDirty_ = true;
     
+    // Execution plan in topological order, with input connections resolved
+    // and the nodes reading each node's outputs as plan indices
+    struct PlannedNode {
+        PCGNode* node = nullptr;
+        std::vector<PCGConnection> inputs;
+        std::vector<uint32_t> dependents;
+    };
+    std::vector<PlannedNode> plan_;
+    
+    struct NodeCache {
+        uint64_t key = 0;
+        uint32_t revision = 0;      // Bumped by invalidate()
+        bool valid = false;
+        std::vector<PCGDataPtr> outputs;
+    };
+    std::unordered_map<uint32_t, NodeCache> cache_;
+    ExecutionStats lastStats_;
+    
     void updateExecutionOrder();
 };
 
@@ -601,7 +800,17 @@ private:
     using NodeFactory = std::function<std::unique_ptr<PCGNode>()>;
     std::unordered_map<std::string, NodeFactory> m_nodeFactories;
     
+    // Preset graphs persist between calls, so repeated generation over
+    // the same region reuses cached node outputs
+    struct PresetGraph {
+        uint32_t graphId = 0;
+        std::vector<uint32_t> nodeIds;  // In the order the preset creates them
+    };
+    std::unordered_map<std::string, PresetGraph> m_presetGraphs;
+    
     void registerDefaultNodes();
+    PresetGraph& getPresetGraph(const std::string& name,
+                                const std::function<void(PCGGraph&, std::vector<uint32_t>&)>& build);
 };
 
 } // namespace Kinetic
@@ -125,6 +125,8 @@ void PhysicsMovementSystem::initializeDestructionSystem() {
 }
 
 void PhysicsMovementSystem::updateKineticControllers(World& world, float deltaTime) {
+    TransformSystem* transforms = world.getSystem<TransformSystem>();
+    
     // Query all entities with kinetic controllers
     for (auto& [entity, transform, controller] : 
          world.query<Transform, KineticControllerComponent>()) {
@@ -146,6 +148,7 @@ void PhysicsMovementSystem::updateKineticControllers(World& world, float deltaTi
         const CharacterState& state = controller.controller->getState();
         transform.position = state.position;
         transform.rotation = state.rotation;
+        if (transforms) transforms->markDirty(entity);
         
         // Track player for debris distance
         if (world.hasComponent<Name>(entity)) {
@@ -159,6 +162,8 @@ void PhysicsMovementSystem::updateKineticControllers(World& world, float deltaTi
 }
 
 void PhysicsMovementSystem::updateSplineMovement(World& world, float deltaTime) {
+    TransformSystem* transforms = world.getSystem<TransformSystem>();
+    
     for (auto& [entity, transform, movement] : 
          world.query<Transform, SplineMovementEntityComponent>()) {
         
@@ -182,6 +187,7 @@ void PhysicsMovementSystem::updateSplineMovement(World& world, float deltaTime)
         if (movement.movement->getLockMode() != SplineLockMode::None) {
             transform.position = movement.movement->getCurrentPosition();
             transform.rotation = movement.movement->getCurrentRotation();
+            if (transforms) transforms->markDirty(entity);
         }
     }
 }
@@ -184,30 +184,56 @@ void DynamicMusicSystem::initialize(AudioSystem* audioSystem) {
 
 void DynamicMusicSystem::shutdown() {
     stopTrack(false);
-    tracks_.clear();
+    while (!tracks_.empty()) {
+        unloadTrack(tracks_.begin()->first);
+    }
 }
 
 void DynamicMusicSystem::loadTrack(const std::string& trackName, 
                                     const std::vector<MusicStem>& stems) {
+    unloadTrack(trackName);
+    
     MusicTrack track;
     track.name = trackName;
     track.stems = stems;
     
-    // Load audio sources for each stem
+    // Stems are long and layered, so they stream rather than load whole
     for (auto& stem : track.stems) {
-        // Audio loading would happen here through audioSystem_
         stem.currentVolume = 0.0f;
         stem.targetVolume = 0.0f;
+        
+        std::shared_ptr<AudioSource> source;
+        std::shared_ptr<AudioClip> clip = audioSystem_ ? audioSystem_->loadStreamingClip(stem.audioPath) : nullptr;
+        if (clip) {
+            source = audioSystem_->createSource();
+            source->setClip(clip);
+            
+            AudioSourceConfig config;
+            config.loop = stem.isLooping;
+            config.is3D = false;
+            config.alwaysReal = true;   // Louder voices must not virtualize a stem mid-mix
+            source->setConfig(config);
+            source->setVolume(0.0f);
+        }
+        track.sources.push_back(std::move(source));
     }
     
     tracks_[trackName] = std::move(track);
 }
 
 void DynamicMusicSystem::unloadTrack(const std::string& trackName) {
+    auto it = tracks_.find(trackName);
+    if (it == tracks_.end()) return;
+    
     if (currentTrackName_ == trackName) {
         stopTrack(false);
     }
-    tracks_.erase(trackName);
+    for (auto& source : it->second.sources) {
+        if (source) {
+            audioSystem_->destroySource(source);
+        }
+    }
+    tracks_.erase(it);
 }
 
 void DynamicMusicSystem::playTrack(const std::string& trackName) {
@@ -228,9 +254,17 @@ void DynamicMusicSystem::playTrack(const std::string& trackName) {
     beatAccumulator_ = 0.0f;
     lastBeat_ = -1;
     
-    // Start playing stems (audio system would handle actual playback)
-    for (auto& stem : it->second.stems) {
-        stem.currentBeat = 0.0f;
+    lastPlaybackTime_ = 0.0f;
+    
+    // Requests made between two AudioSystem updates reach the mixer
+    // together, so every stem starts on the same sample
+    MusicTrack& track = it->second;
+    for (size_t i = 0; i < track.stems.size(); ++i) {
+        track.stems[i].currentBeat = 0.0f;
+        if (track.sources[i]) {
+            track.sources[i]->stop();
+            track.sources[i]->play();
+        }
     }
 }
 
@@ -249,12 +283,22 @@ void DynamicMusicSystem::stopTrack(bool fadeOut) {
             stem.currentVolume = 0.0f;
             stem.targetVolume = 0.0f;
         }
-        it->second.isPlaying = false;
+        stopSources(it->second);
     }
     
+    // A fading track keeps playing until updateStemVolumes silences it
     currentTrackName_.clear();
 }
 
+void DynamicMusicSystem::stopSources(MusicTrack& track) {
+    for (auto& source : track.sources) {
+        if (source) {
+            source->stop();
+        }
+    }
+    track.isPlaying = false;
+}
+
 void DynamicMusicSystem::setGameState(GameMusicState state) {
     currentState_ = state;
     
@@ -283,7 +327,20 @@ void DynamicMusicSystem::update(float deltaTime) {
 void DynamicMusicSystem::updateBeatTracking(float deltaTime) {
     float secondsPerBeat = getSecondsPerBeat();
     
-    beatAccumulator_ += deltaTime;
+    // Follow the music's own clock, so beats neither drift from it nor
+    // run on while it's held up; frame time only without a playing stem
+    AudioSource* lead = getLeadSource();
+    if (lead) {
+        float time = lead->getTime();
+        float elapsed = time - lastPlaybackTime_;
+        if (elapsed < 0.0f) {
+            elapsed += lead->getClip()->getInfo().duration;  // Looped
+        }
+        lastPlaybackTime_ = time;
+        beatAccumulator_ += std::max(elapsed, 0.0f);
+    } else {
+        beatAccumulator_ += deltaTime;
+    }
     
     while (beatAccumulator_ >= secondsPerBeat) {
         beatAccumulator_ -= secondsPerBeat;
@@ -302,41 +359,67 @@ void DynamicMusicSystem::updateBeatTracking(float deltaTime) {
     }
 }
 
-void DynamicMusicSystem::updateStemVolumes(float deltaTime) {
+AudioSource* DynamicMusicSystem::getLeadSource() const {
     auto it = tracks_.find(currentTrackName_);
-    if (it == tracks_.end()) return;
+    if (it == tracks_.end()) return nullptr;
     
-    for (auto& stem : it->second.stems) {
-        // Determine target volume based on intensity
-        float targetVol = 0.0f;
-        if (currentIntensity_ >= stem.intensityThreshold) {
-            targetVol = stem.baseVolume;
+    for (const auto& source : it->second.sources) {
+        if (source && source->isPlaying()) {
+            return source.get();
+        }
+    }
+    return nullptr;
+}
+
+void DynamicMusicSystem::updateStemVolumes(float deltaTime) {
+    for (auto& [name, track] : tracks_) {
+        if (!track.isPlaying) continue;
+        
+        // Tracks other than the current one are fading out
+        const bool current = (name == currentTrackName_);
+        bool audible = false;
+        
+        for (size_t i = 0; i < track.stems.size(); ++i) {
+            MusicStem& stem = track.stems[i];
             
-            // Check for overrides
-            auto overrideIt = stemVolumeOverrides_.find(stem.name);
-            if (overrideIt != stemVolumeOverrides_.end()) {
-                targetVol *= overrideIt->second;
+            // Determine target volume based on intensity
+            float targetVol = 0.0f;
+            if (current && currentIntensity_ >= stem.intensityThreshold) {
+                targetVol = stem.baseVolume;
+                
+                // Check for overrides
+                auto overrideIt = stemVolumeOverrides_.find(stem.name);
+                if (overrideIt != stemVolumeOverrides_.end()) {
+                    targetVol *= overrideIt->second;
+                }
+                
+                // Check mute state
+                auto muteIt = stemMuteStates_.find(stem.name);
+                if (muteIt != stemMuteStates_.end() && muteIt->second) {
+                    targetVol = 0.0f;
+                }
             }
             
-            // Check mute state
-            auto muteIt = stemMuteStates_.find(stem.name);
-            if (muteIt != stemMuteStates_.end() && muteIt->second) {
-                targetVol = 0.0f;
+            stem.targetVolume = targetVol;
+            
+            // Interpolate volume
+            float fadeTime = (stem.targetVolume > stem.currentVolume) ? 
+                             stem.fadeInTime : stem.fadeOutTime;
+            float fadeSpeed = deltaTime / std::max(fadeTime, 0.001f);
+            
+            stem.currentVolume = glm::mix(stem.currentVolume, stem.targetVolume, 
+                                           std::min(fadeSpeed, 1.0f));
+            audible |= stem.currentVolume > 0.001f;
+            
+            // Silent stems keep playing, so they come back in step
+            if (track.sources[i]) {
+                track.sources[i]->setVolume(stem.currentVolume);
             }
         }
         
-        stem.targetVolume = targetVol;
-        
-        // Interpolate volume
-        float fadeTime = (stem.targetVolume > stem.currentVolume) ? 
-                         stem.fadeInTime : stem.fadeOutTime;
-        float fadeSpeed = deltaTime / std::max(fadeTime, 0.001f);
-        
-        stem.currentVolume = glm::mix(stem.currentVolume, stem.targetVolume, 
-                                       std::min(fadeSpeed, 1.0f));
-        
-        // Apply to audio source (audio system would handle this)
-        // audioSystem_->setSourceVolume(stem.audioSourceId, stem.currentVolume);
+        if (!current && !audible) {
+            stopSources(track);
+        }
     }
 }
 
@@ -5,7 +5,7 @@
  * 
  * Features:
  * - Wind synthesis based on player velocity
- * - Dynamic music system with stems and intensity mixing
+ * - Dynamic music system with streamed stems and intensity mixing
  * - Speed-based audio effects (Doppler, frequency modulation)
  * - Granular synthesis for environmental sounds
  * - Procedural footstep generation
@@ -261,7 +261,9 @@ public:
     const DynamicMusicConfig& getConfig() const { return config_; }
     
     /**
-     * Load a music track with stems
+     * Load a music track with stems. Each stem streams from disk on its
+     * own source; the stems of a track start on the same sample and share
+     * one playback clock, which also drives the beat.
      * @param trackName Name identifier for the track
      * @param stems Vector of stems to load
      */
@@ -343,6 +345,7 @@ private:
     struct MusicTrack {
         std::string name;
         std::vector<MusicStem> stems;
+        std::vector<std::shared_ptr<AudioSource>> sources;  // Per stem; null if it failed to load
         bool isPlaying = false;
     };
     std::unordered_map<std::string, MusicTrack> tracks_;
@@ -358,6 +361,7 @@ private:
     int currentBar_ = 0;
     float beatAccumulator_ = 0.0f;
     int lastBeat_ = -1;
+    float lastPlaybackTime_ = 0.0f;     // Of the current track's lead stem
     
     // Callbacks
     std::vector<BeatCallback> beatCallbacks_;
@@ -368,6 +372,8 @@ private:
     
     void updateStemVolumes(float deltaTime);
     void updateBeatTracking(float deltaTime);
+    AudioSource* getLeadSource() const;
+    void stopSources(MusicTrack& track);
     float getSecondsPerBeat() const;
 };
 
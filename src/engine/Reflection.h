@@ -36,6 +36,7 @@
 #include <typeindex>
 #include <any>
 #include <memory>
+#include <optional>
 #include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -228,9 +229,9 @@ struct StructDescriptor {
     std::string tooltip;                           // Tooltip description
     std::string category;                          // Category for grouping
     
-    size_t size;                                   // Total struct size
-    size_t alignment;                              // Struct alignment
-    std::type_index typeInfo;                      // C++ type info
+    size_t size = 0;                               // Total struct size
+    size_t alignment = 1;                          // Struct alignment
+    std::type_index typeInfo = std::type_index(typeid(void)); // C++ type info
     
     std::vector<PropertyDescriptor> properties;    // All properties
     std::unordered_map<std::string, size_t> propertyMap; // Name to index
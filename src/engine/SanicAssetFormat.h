@@ -12,6 +12,10 @@
  * [Physics Section]     - Cooked collision data
  * [Material Section]    - Material references and parameters
  * 
+ * Every section starts with a SectionHeader. Compressed sections follow it
+ * with a block table and independently compressed blocks, so any block
+ * (e.g. one Nanite cluster page) can be decoded without the rest.
+ * 
  * Streaming Support:
  * - Each section is page-aligned for DirectStorage
  * - Cluster pages can be loaded on-demand
@@ -34,7 +38,7 @@ namespace Sanic {
 
 constexpr uint32_t SANIC_MAGIC = 0x53414E49;        // "SANI" in little-endian
 constexpr uint32_t SANIC_MESH_MAGIC = 0x534E4D43;   // "SNMC" for mesh files
-constexpr uint32_t SANIC_VERSION = 1;
+constexpr uint32_t SANIC_VERSION = 2;                // v2: SectionHeader before every section
 constexpr uint32_t PAGE_SIZE = 65536;               // 64KB pages for streaming
 constexpr uint32_t CLUSTER_PAGE_SIZE = 16384;       // 16KB cluster pages
 
@@ -53,11 +57,38 @@ enum class SectionType : uint32_t {
 struct SectionHeader {
     SectionType type;
     uint32_t uncompressedSize;
-    uint32_t compressedSize;
-    uint32_t flags;                     // Compression flags
+    uint32_t compressedSize;            // Stored bytes after this header
+    uint32_t flags;                     // CompressionCodec
 };
 // DISABLED: static_assert(sizeof(SectionHeader) == 16, "SectionHeader must be 16 bytes");
 
+// ============================================================================
+// COMPRESSION
+// ============================================================================
+
+enum class CompressionCodec : uint32_t {
+    None = 0,
+    LZ4 = 1,                            // LZ4 block format
+    LZ4Shuffle4 = 2,                    // Byte planes of 4-byte words, then LZ4 (float data)
+};
+
+// Uncompressed size of one compressed block at most
+constexpr uint32_t COMPRESSION_BLOCK_SIZE = PAGE_SIZE;
+
+// Follows the SectionHeader of a compressed section
+struct CompressedSectionHeader {
+    uint32_t blockCount;
+    uint32_t reserved;
+    // CompressedBlockEntry[blockCount], then block data
+};
+
+struct CompressedBlockEntry {
+    uint32_t dataOffset;                // From the SectionHeader
+    uint32_t compressedSize;            // Equal to uncompressedSize if stored raw
+    uint32_t uncompressedOffset;        // Within the decompressed section
+    uint32_t uncompressedSize;
+};
+
 // ============================================================================
 // FILE HEADER
 // ============================================================================
@@ -90,10 +121,11 @@ struct AssetHeader {
     
     // Asset metadata
     char assetName[64];                 // Null-terminated asset name
-    uint64_t sourceHash;                // Hash of source file for cache invalidation
+    uint64_t sourceHash;                // Hash of source file and its dependencies, for cache invalidation
     uint64_t cookTimestamp;             // When the asset was cooked
+    uint64_t cookSettingsHash;          // Hash of the CookerConfig that produced it
     
-    uint32_t reserved[16];              // Future use
+    uint32_t reserved[14];              // Future use
 };
 // DISABLED: static_assert(sizeof(AssetHeader) == 256, "AssetHeader must be 256 bytes");
 
@@ -104,7 +136,7 @@ enum class AssetFlags : uint32_t {
     HasLumen = 1 << 1,
     HasPhysics = 1 << 2,
     HasMaterials = 1 << 3,
-    Compressed = 1 << 4,                // LZ4 compressed sections
+    Compressed = 1 << 4,                // At least one section is compressed
     StreamingEnabled = 1 << 5,          // Supports page-based streaming
     HasImpostor = 1 << 6,               // Has LOD impostor for distance
     TwoSided = 1 << 7,
@@ -241,14 +273,14 @@ struct CookedHierarchyNode {
 
 // Page table entry for streaming
 struct PageTableEntry {
-    uint32_t fileOffset;                // Offset in file
-    uint32_t compressedSize;            // Compressed size (or 0 if uncompressed)
+    uint32_t fileOffset;                // Offset in cluster data
+    uint32_t compressedSize;            // Size of the page's compressed block (or 0 if uncompressed)
     uint32_t uncompressedSize;          // Uncompressed size
     uint32_t clusterOffset;             // First cluster index
     uint32_t clusterCount;              // Clusters in this page
     uint32_t flags;                     // Page flags
     uint32_t dependencyMask;            // Bitmask of required parent pages
-    uint32_t reserved;
+    uint32_t blockOffset;               // Compressed block, from the SectionHeader (0 if uncompressed)
 };
 // DISABLED: static_assert(sizeof(PageTableEntry) == 32, "PageTableEntry must be 32 bytes");
 
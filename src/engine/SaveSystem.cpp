@@ -5,18 +5,307 @@
  */
 
 #include "SaveSystem.h"
+#include "DataCompression.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <filesystem>
 #include <algorithm>
+#include <array>
+#include <cstdio>
 #include <zlib.h>
 
 namespace Sanic {
 
 namespace fs = std::filesystem;
 
+namespace {
+
+// Sections every save file has besides the registered handlers'
+const char* const METADATA_SECTION = "$metadata";
+const char* const ENTITIES_SECTION = "$entities";
+const char* const CHECKPOINTS_SECTION = "$checkpoints";
+
+using Clock = std::chrono::high_resolution_clock;
+
+float elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+// String from a handler without a binary path, built on the game thread
+struct StringSnapshot : SaveSectionSnapshot {
+    std::string data;
+    void write(SaveWriter& writer) const override { writer.writeString(data); }
+};
+
+// A SaveableComponent entity's state, copied out of the World
+struct EntityRecord {
+    enum : uint8_t {
+        HasTransform = 1 << 0,
+        HasHealth = 1 << 1,
+        HasCustom = 1 << 2
+    };
+    
+    std::string persistentId;
+    uint8_t flags = 0;
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+    float health = 0.0f;
+    float maxHealth = 0.0f;
+    std::string custom;
+};
+
+struct EntitiesSnapshot : SaveSectionSnapshot {
+    std::vector<EntityRecord> entities;
+    
+    void write(SaveWriter& writer) const override {
+        writer.write(static_cast<uint32_t>(entities.size()));
+        for (const EntityRecord& e : entities) {
+            writer.writeString(e.persistentId);
+            writer.write(e.flags);
+            if (e.flags & EntityRecord::HasTransform) {
+                writer.write(e.position);
+                writer.write(glm::vec4(e.rotation.x, e.rotation.y, e.rotation.z, e.rotation.w));
+                writer.write(e.scale);
+            }
+            if (e.flags & EntityRecord::HasHealth) {
+                writer.write(e.health);
+                writer.write(e.maxHealth);
+            }
+            if (e.flags & EntityRecord::HasCustom) {
+                writer.writeString(e.custom);
+            }
+        }
+    }
+};
+
+bool readEntityRecord(SaveReader& reader, EntityRecord& e) {
+    if (!reader.readString(e.persistentId) || !reader.read(e.flags)) return false;
+    if (e.flags & EntityRecord::HasTransform) {
+        glm::vec4 rotation;
+        if (!reader.read(e.position) || !reader.read(rotation) || !reader.read(e.scale)) return false;
+        e.rotation = glm::quat(rotation.w, rotation.x, rotation.y, rotation.z);
+    }
+    if (e.flags & EntityRecord::HasHealth) {
+        if (!reader.read(e.health) || !reader.read(e.maxHealth)) return false;
+    }
+    if (e.flags & EntityRecord::HasCustom) {
+        if (!reader.readString(e.custom)) return false;
+    }
+    return true;
+}
+
+struct CheckpointRecord {
+    std::string id;
+    bool activated = false;
+    float activationTime = 0.0f;
+};
+
+struct CheckpointsSnapshot : SaveSectionSnapshot {
+    std::string currentId;
+    std::vector<CheckpointRecord> checkpoints;
+    
+    void write(SaveWriter& writer) const override {
+        writer.writeString(currentId);
+        writer.write(static_cast<uint32_t>(checkpoints.size()));
+        for (const CheckpointRecord& c : checkpoints) {
+            writer.writeString(c.id);
+            writer.write(static_cast<uint8_t>(c.activated));
+            writer.write(c.activationTime);
+        }
+    }
+};
+
+bool readCheckpoints(SaveReader& reader, CheckpointsSnapshot& out) {
+    uint32_t count = 0;
+    if (!reader.readString(out.currentId) || !reader.read(count)) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        CheckpointRecord c;
+        uint8_t activated = 0;
+        if (!reader.readString(c.id) || !reader.read(activated) || !reader.read(c.activationTime)) {
+            return false;
+        }
+        c.activated = activated != 0;
+        out.checkpoints.push_back(std::move(c));
+    }
+    return true;
+}
+
+// String-keyed maps: count, then key/value pairs
+void writeValue(SaveWriter& writer, int value) { writer.write(static_cast<int32_t>(value)); }
+void writeValue(SaveWriter& writer, bool value) { writer.write(static_cast<uint8_t>(value)); }
+void writeValue(SaveWriter& writer, const std::string& value) { writer.writeString(value); }
+
+bool readValue(SaveReader& reader, int& value) {
+    int32_t v = 0;
+    if (!reader.read(v)) return false;
+    value = v;
+    return true;
+}
+bool readValue(SaveReader& reader, bool& value) {
+    uint8_t v = 0;
+    if (!reader.read(v)) return false;
+    value = v != 0;
+    return true;
+}
+bool readValue(SaveReader& reader, std::string& value) { return reader.readString(value); }
+
+template<typename V>
+void writeMap(SaveWriter& writer, const std::unordered_map<std::string, V>& map) {
+    writer.write(static_cast<uint32_t>(map.size()));
+    for (const auto& [key, value] : map) {
+        writer.writeString(key);
+        writeValue(writer, value);
+    }
+}
+
+template<typename V>
+bool readMap(SaveReader& reader, std::unordered_map<std::string, V>& map) {
+    uint32_t count = 0;
+    if (!reader.read(count) || count > reader.getRemaining()) return false;
+    map.clear();
+    map.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string key;
+        V value{};
+        if (!reader.readString(key) || !readValue(reader, value)) return false;
+        map[std::move(key)] = std::move(value);
+    }
+    return true;
+}
+
+std::string getJournalPath(const std::string& filePath) {
+    return filePath + ".journal";
+}
+
+// Stored bytes of a section -> raw bytes, checked against entry.checksum
+bool decodeSection(const SaveSectionEntry& entry, const uint8_t* stored, std::vector<uint8_t>& out) {
+    CompressionCodec codec = static_cast<CompressionCodec>(entry.codec);
+    if (codec == CompressionCodec::None) {
+        if (entry.storedSize != entry.rawSize) return false;
+        out.assign(stored, stored + entry.storedSize);
+    } else {
+        // LZ4 can't expand more than 255:1; anything larger is a corrupt entry
+        if (uint64_t(entry.rawSize) > uint64_t(entry.storedSize) * 255 + 16) return false;
+        out.resize(entry.rawSize);
+        if (!DataCompression::decompress(codec, stored, entry.storedSize, out.data(), out.size())) {
+            return false;
+        }
+    }
+    return SaveSystem::calculateChecksum(out.data(), out.size()) == entry.checksum;
+}
+
+struct EncodedSection {
+    SaveSectionEntry entry;         // offset left for the caller
+    std::vector<uint8_t> stored;
+};
+
+// Fast LZ4 level; sections that don't shrink are stored as-is
+bool encodeSection(uint32_t tag, std::vector<uint8_t>& raw, EncodedSection& out) {
+    if (raw.size() > UINT32_MAX) return false;
+    
+    out.entry = SaveSectionEntry();
+    out.entry.tag = tag;
+    out.entry.rawSize = static_cast<uint32_t>(raw.size());
+    out.entry.checksum = SaveSystem::calculateChecksum(raw.data(), raw.size());
+    
+    out.stored.resize(DataCompression::compressBound(raw.size()));
+    size_t size = DataCompression::compress(CompressionCodec::LZ4, raw.data(), raw.size(),
+                                            out.stored.data(), out.stored.size());
+    if (size == 0 || size >= raw.size()) {
+        out.entry.codec = static_cast<uint32_t>(CompressionCodec::None);
+        out.stored = std::move(raw);
+    } else {
+        out.entry.codec = static_cast<uint32_t>(CompressionCodec::LZ4);
+        out.stored.resize(size);
+    }
+    out.entry.storedSize = static_cast<uint32_t>(out.stored.size());
+    return true;
+}
+
+/**
+ * Walks the valid records of the journal at path, if it belongs to the base
+ * with baseChecksum, calling onSection (if given) for every section in order.
+ * Stops at the first torn or corrupt record, or when onSection returns false.
+ * Returns the offset just past the last record walked, or 0 if there is no
+ * journal for this base.
+ */
+uint64_t readJournal(const std::string& path, uint32_t baseChecksum,
+                     const std::function<bool(const SaveSectionEntry&, const uint8_t*)>& onSection) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return 0;
+    
+    SaveJournalHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != SAVE_JOURNAL_MAGIC || header.formatVersion != SAVE_FORMAT_VERSION ||
+        header.baseChecksum != baseChecksum) {
+        return 0;
+    }
+    
+    uint64_t end = sizeof(header);
+    std::vector<uint8_t> body;
+    
+    while (true) {
+        SaveJournalRecord record;
+        if (!file.read(reinterpret_cast<char*>(&record), sizeof(record)) ||
+            record.magic != SAVE_RECORD_MAGIC ||
+            uint64_t(record.sectionCount) * sizeof(SaveSectionEntry) > record.size) {
+            break;
+        }
+        
+        body.resize(record.size);
+        if (!file.read(reinterpret_cast<char*>(body.data()), record.size) ||
+            SaveSystem::calculateChecksum(body.data(), body.size()) != record.checksum) {
+            break;
+        }
+        
+        const SaveSectionEntry* entries = reinterpret_cast<const SaveSectionEntry*>(body.data());
+        bool valid = true;
+        for (uint32_t i = 0; i < record.sectionCount && valid; ++i) {
+            valid = entries[i].offset <= record.size && entries[i].storedSize <= record.size - entries[i].offset;
+        }
+        if (!valid) break;
+        
+        if (onSection) {
+            for (uint32_t i = 0; i < record.sectionCount; ++i) {
+                if (!onSection(entries[i], body.data() + entries[i].offset)) return end;
+            }
+        }
+        end += sizeof(record) + record.size;
+    }
+    return end;
+}
+
+bool readEntities(SaveReader& reader, const std::function<void(EntityRecord&)>& onEntity) {
+    uint32_t count = 0;
+    if (!reader.read(count)) return false;
+    
+    EntityRecord e;
+    for (uint32_t i = 0; i < count; ++i) {
+        e.flags = 0;
+        if (!readEntityRecord(reader, e)) return false;
+        onEntity(e);
+    }
+    return true;
+}
+
+// An entity as last saved to a slot; only entities that differ go into a delta
+struct EntityBaseline {
+    bool valid = false;
+    EntityRecord record;            // Without custom data; customRevision stands in
+    uint32_t customRevision = 0;
+};
+
+bool sameEntityState(const EntityRecord& a, const EntityRecord& b) {
+    return a.flags == b.flags &&
+           a.position == b.position && a.rotation == b.rotation && a.scale == b.scale &&
+           a.health == b.health && a.maxHealth == b.maxHealth;
+}
+
+} // namespace
+
 // ============================================================================
 // SAVE VERSION IMPLEMENTATION
 // ============================================================================
@@ -51,6 +340,44 @@ std::string SaveMetadata::getFormattedPlayTime() const {
     return ss.str();
 }
 
+void SaveMetadata::write(SaveWriter& writer) const {
+    writer.write(static_cast<int32_t>(slotId));
+    writer.writeString(saveName);
+    writer.writeString(characterName);
+    writer.write(static_cast<int64_t>(std::chrono::system_clock::to_time_t(saveTime)));
+    writer.write(playTime);
+    writer.write(static_cast<int32_t>(playerLevel));
+    writer.writeString(currentArea);
+    writer.writeString(currentQuest);
+    writer.write(completionPercent);
+    writer.writeString(thumbnailPath);
+    writer.write(static_cast<uint32_t>(thumbnailData.size()));
+    writer.writeBytes(thumbnailData.data(), thumbnailData.size());
+}
+
+bool SaveMetadata::read(SaveReader& reader) {
+    int32_t slot = 0;
+    int64_t time = 0;
+    int32_t level = 0;
+    uint32_t thumbnailSize = 0;
+    
+    if (!reader.read(slot) || !reader.readString(saveName) || !reader.readString(characterName) ||
+        !reader.read(time) || !reader.read(playTime) || !reader.read(level) ||
+        !reader.readString(currentArea) || !reader.readString(currentQuest) ||
+        !reader.read(completionPercent) || !reader.readString(thumbnailPath) ||
+        !reader.read(thumbnailSize) || thumbnailSize > reader.getRemaining()) {
+        return false;
+    }
+    
+    thumbnailData.resize(thumbnailSize);
+    reader.readBytes(thumbnailData.data(), thumbnailSize);
+    
+    slotId = slot;
+    saveTime = std::chrono::system_clock::from_time_t(static_cast<std::time_t>(time));
+    playerLevel = level;
+    return true;
+}
+
 // ============================================================================
 // SERIALIZATION CONTEXT IMPLEMENTATION
 // ============================================================================
@@ -78,6 +405,7 @@ Entity SerializationContext::getEntity(uint64_t persistentId) {
 
 void CheckpointManager::registerCheckpoint(const Checkpoint& checkpoint) {
     checkpoints_[checkpoint.id] = checkpoint;
+    revision_++;
 }
 
 void CheckpointManager::activateCheckpoint(const std::string& id) {
@@ -87,6 +415,7 @@ void CheckpointManager::activateCheckpoint(const std::string& id) {
     it->second.isActivated = true;
     it->second.activationTime = 0.0f;  // Would get current game time
     currentCheckpointId_ = id;
+    revision_++;
 }
 
 const Checkpoint* CheckpointManager::getCurrentCheckpoint() const {
@@ -118,11 +447,12 @@ bool CheckpointManager::respawnAtCheckpoint(World& world, Entity player) {
     const Checkpoint* checkpoint = getCurrentCheckpoint();
     if (!checkpoint) return false;
     
-    auto* transform = world.getComponent<Transform>(player);
+    auto* transform = world.tryGetComponent<Transform>(player);
     if (!transform) return false;
     
     transform->position = checkpoint->respawnPosition;
     transform->rotation = checkpoint->respawnRotation;
+    TransformSystem::markDirty(world, player);
     
     // Could also restore state snapshot
     
@@ -134,6 +464,7 @@ void CheckpointManager::clearActivations() {
         checkpoint.isActivated = false;
     }
     currentCheckpointId_.clear();
+    revision_++;
 }
 
 std::string CheckpointManager::serialize() const {
@@ -160,6 +491,7 @@ bool CheckpointManager::deserialize(const std::string& data) {
     try {
         json doc = json::parse(data);
         
+        revision_++;
         currentCheckpointId_ = doc.value("currentCheckpoint", "");
         
         if (doc.contains("checkpoints")) {
@@ -179,10 +511,101 @@ bool CheckpointManager::deserialize(const std::string& data) {
     }
 }
 
+SaveSnapshotPtr CheckpointManager::snapshot() const {
+    auto snapshot = std::make_shared<CheckpointsSnapshot>();
+    snapshot->currentId = currentCheckpointId_;
+    snapshot->checkpoints.reserve(checkpoints_.size());
+    for (const auto& [id, checkpoint] : checkpoints_) {
+        snapshot->checkpoints.push_back({id, checkpoint.isActivated, checkpoint.activationTime});
+    }
+    return snapshot;
+}
+
+bool CheckpointManager::read(SaveReader& reader) {
+    CheckpointsSnapshot state;
+    if (!readCheckpoints(reader, state)) return false;
+    
+    revision_++;
+    currentCheckpointId_ = state.currentId;
+    for (const CheckpointRecord& c : state.checkpoints) {
+        auto it = checkpoints_.find(c.id);
+        if (it != checkpoints_.end()) {
+            it->second.isActivated = c.activated;
+            it->second.activationTime = c.activationTime;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// SAVE FILE READER IMPLEMENTATION
+// ============================================================================
+
+bool SaveFileReader::open(const std::string& filePath) {
+    file_ = std::ifstream(filePath, std::ios::binary);
+    sections_.clear();
+    if (!file_.is_open()) return false;
+    
+    file_.seekg(0, std::ios::end);
+    fileSize_ = static_cast<uint64_t>(file_.tellg());
+    file_.seekg(0, std::ios::beg);
+    
+    if (!file_.read(reinterpret_cast<char*>(&header_), sizeof(header_)) ||
+        header_.magic != SAVE_FILE_MAGIC || header_.formatVersion != SAVE_FORMAT_VERSION) {
+        return false;
+    }
+    
+    uint64_t tableSize = uint64_t(header_.sectionCount) * sizeof(SaveSectionEntry);
+    if (tableSize > fileSize_ - sizeof(header_)) return false;
+    
+    sections_.resize(header_.sectionCount);
+    if (!file_.read(reinterpret_cast<char*>(sections_.data()), static_cast<std::streamsize>(tableSize)) ||
+        SaveSystem::calculateChecksum(sections_.data(), tableSize) != header_.tableChecksum) {
+        sections_.clear();
+        return false;
+    }
+    return true;
+}
+
+SaveVersion SaveFileReader::getVersion() const {
+    SaveVersion version;
+    version.major = header_.versionMajor;
+    version.minor = header_.versionMinor;
+    version.patch = header_.versionPatch;
+    return version;
+}
+
+const SaveSectionEntry* SaveFileReader::findSection(uint32_t tag) const {
+    for (const SaveSectionEntry& entry : sections_) {
+        if (entry.tag == tag) return &entry;
+    }
+    return nullptr;
+}
+
+bool SaveFileReader::readSection(uint32_t tag, std::vector<uint8_t>& outData) {
+    const SaveSectionEntry* entry = findSection(tag);
+    if (!entry || entry->offset > fileSize_ || entry->storedSize > fileSize_ - entry->offset) {
+        return false;
+    }
+    
+    stored_.resize(entry->storedSize);
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(entry->offset));
+    if (!file_.read(reinterpret_cast<char*>(stored_.data()), entry->storedSize)) return false;
+    
+    return decodeSection(*entry, stored_.data(), outData);
+}
+
 // ============================================================================
 // SAVE SYSTEM IMPLEMENTATION
 // ============================================================================
 
+struct SaveSystem::SlotBaseline {
+    std::unordered_map<uint32_t, uint64_t> sectionRevisions;   // Handler tag -> revision saved
+    uint64_t checkpointRevision = UINT64_MAX;
+    std::vector<EntityBaseline> entities;                       // Indexed by Entity
+};
+
 SaveSystem::SaveSystem() {
 }
 
@@ -203,10 +626,25 @@ void SaveSystem::init(const std::string& saveDirectory) {
             // Would load metadata here
         }
     }
+    
+    std::lock_guard<std::mutex> lock(saveMutex_);
+    if (!saveThread_.joinable()) {
+        saveShutdown_ = false;
+        saveThread_ = std::thread(&SaveSystem::saveThreadFunc, this);
+    }
 }
 
 void SaveSystem::shutdown() {
-    // Cleanup
+    // Queued saves are still written before the thread exits
+    {
+        std::lock_guard<std::mutex> lock(saveMutex_);
+        saveShutdown_ = true;
+    }
+    saveCondition_.notify_all();
+    if (saveThread_.joinable()) {
+        saveThread_.join();
+    }
+    deliverFinishedSaves();
 }
 
 void SaveSystem::registerSectionHandler(const SaveSectionHandler& handler) {
@@ -225,19 +663,54 @@ void SaveSystem::registerSerializable(const std::string& typeId,
 }
 
 bool SaveSystem::saveGame(SaveSlotID slot, const std::string& saveName) {
+    return queueSave(slot, saveName, false);
+}
+
+bool SaveSystem::saveIncremental(SaveSlotID slot, const std::string& saveName) {
+    return queueSave(slot, saveName, true);
+}
+
+bool SaveSystem::saveCheckpoint(const std::string& checkpointId) {
+    checkpointManager_.activateCheckpoint(checkpointId);
+    return saveIncremental(AUTO_SAVE_SLOT, "Checkpoint");
+}
+
+bool SaveSystem::queueSave(SaveSlotID slot, const std::string& saveName, bool incremental) {
     if (onSaveStarted_) onSaveStarted_(slot, true);
     
-    std::string filePath = getSlotFilePath(slot);
-    SaveMetadata metadata = createMetadata(slot, saveName);
-    
-    bool success = saveToFile(filePath, metadata);
-    
-    if (success) {
-        slotCache_[slot] = metadata;
+    // A delta needs a base this session wrote (or is writing); otherwise
+    // this save becomes the base
+    std::unique_ptr<SlotBaseline>& baseline = slotBaselines_[slot];
+    incremental = incremental && baseline;
+    if (!incremental) {
+        baseline = std::make_unique<SlotBaseline>();
     }
     
-    if (onSaveCompleted_) onSaveCompleted_(slot, success);
+    SaveMetadata metadata = createMetadata(slot, saveName);
+    PendingSave save = captureSave(metadata.filePath, metadata, baseline.get(), incremental);
+    save.slot = slot;
+    save.incremental = incremental;
+    save.compactionThreshold = journalCompactionThreshold_;
+    
+    {
+        std::lock_guard<std::mutex> lock(saveMutex_);
+        if (saveThread_.joinable() && !saveShutdown_) {
+            saveQueue_.push_back(std::move(save));
+            saveCondition_.notify_one();
+            return true;
+        }
+    }
     
+    // No save thread (init() not called): write it here
+    SaveStats stats;
+    stats.snapshotMs = save.snapshotMs;
+    bool success = writeSave(save, stats);
+    {
+        std::lock_guard<std::mutex> lock(saveMutex_);
+        if (success) lastSaveStats_ = stats;
+        finishedSaves_.push_back({slot, std::move(save.metadata), success});
+    }
+    deliverFinishedSaves();
     return success;
 }
 
@@ -246,69 +719,511 @@ bool SaveSystem::quickSave() {
 }
 
 bool SaveSystem::autoSave() {
+    if (incrementalSaves_) {
+        return saveIncremental(AUTO_SAVE_SLOT, "Auto Save");
+    }
     return saveGame(AUTO_SAVE_SLOT, "Auto Save");
 }
 
 bool SaveSystem::saveToFile(const std::string& filePath, const SaveMetadata& metadata) {
-    using json = nlohmann::json;
+    PendingSave save = captureSave(filePath, metadata);
+    
+    SaveStats stats;
+    stats.snapshotMs = save.snapshotMs;
+    if (!writeSave(save, stats)) return false;
+    
+    std::lock_guard<std::mutex> lock(saveMutex_);
+    lastSaveStats_ = stats;
+    return true;
+}
+
+SaveSystem::PendingSave SaveSystem::captureSave(const std::string& filePath, const SaveMetadata& metadata,
+                                                SlotBaseline* baseline, bool incremental) {
+    auto start = Clock::now();
+    
+    PendingSave save;
+    save.slot = metadata.slotId;
+    save.filePath = filePath;
+    save.metadata = metadata;
+    save.metadata.filePath = filePath;
+    save.metadata.version = currentVersion_;
     
     SerializationContext context;
     context.saveVersion = currentVersion_;
     
-    // Serialize game state
-    std::string gameData = serializeGameState(context);
+    for (const auto& handler : sectionHandlers_) {
+        uint32_t tag = getSectionTag(handler.name);
+        
+        // Unchanged since the slot's last save: nothing to append
+        if (baseline && handler.revision) {
+            uint64_t revision = handler.revision();
+            auto it = baseline->sectionRevisions.find(tag);
+            if (incremental && it != baseline->sectionRevisions.end() && it->second == revision) {
+                continue;
+            }
+            baseline->sectionRevisions[tag] = revision;
+        }
+        
+        SaveSnapshotPtr snapshot;
+        if (handler.snapshot) {
+            snapshot = handler.snapshot(context);
+        } else if (handler.serialize) {
+            auto string = std::make_shared<StringSnapshot>();
+            string->data = handler.serialize(context);
+            snapshot = std::move(string);
+        }
+        if (snapshot) {
+            save.sections.emplace_back(tag, std::move(snapshot));
+        }
+    }
+    
+    // Saveable entities: plain copies only, encoding happens on the save thread.
+    // A delta copies only the entities that differ from the slot's baseline.
+    if (world_) {
+        auto entities = std::make_shared<EntitiesSnapshot>();
+        
+        for (auto [entity, saveable] : world_->query<SaveableComponent>()) {
+            if (!saveable.shouldSave) continue;
+            
+            EntityRecord e;
+            
+            if (saveable.saveTransform) {
+                if (auto* transform = world_->tryGetComponent<Transform>(entity)) {
+                    e.flags |= EntityRecord::HasTransform;
+                    e.position = transform->position;
+                    e.rotation = transform->rotation;
+                    e.scale = transform->scale;
+                }
+            }
+            
+            if (saveable.saveHealth) {
+                if (auto* health = world_->tryGetComponent<Health>(entity)) {
+                    e.flags |= EntityRecord::HasHealth;
+                    e.health = health->current;
+                    e.maxHealth = health->max;
+                }
+            }
+            
+            if (saveable.saveCustomData && saveable.customSerialize) {
+                e.flags |= EntityRecord::HasCustom;
+            }
+            
+            if (baseline) {
+                if (entity >= baseline->entities.size()) {
+                    baseline->entities.resize(entity + 1);
+                }
+                EntityBaseline& last = baseline->entities[entity];
+                if (incremental && last.valid && sameEntityState(last.record, e) &&
+                    last.customRevision == saveable.customRevision &&
+                    last.record.persistentId == saveable.persistentId) {
+                    continue;
+                }
+                last.valid = true;
+                last.record = e;
+                last.record.persistentId = saveable.persistentId;
+                last.customRevision = saveable.customRevision;
+            }
+            
+            e.persistentId = saveable.persistentId;
+            if (e.flags & EntityRecord::HasCustom) {
+                e.custom = saveable.customSerialize();
+            }
+            entities->entities.push_back(std::move(e));
+        }
+        
+        if (!incremental || !entities->entities.empty()) {
+            save.sections.emplace_back(getSectionTag(ENTITIES_SECTION), std::move(entities));
+        }
+    }
+    
+    uint64_t checkpointRevision = checkpointManager_.getRevision();
+    if (!incremental || !baseline || baseline->checkpointRevision != checkpointRevision) {
+        save.sections.emplace_back(getSectionTag(CHECKPOINTS_SECTION), checkpointManager_.snapshot());
+        if (baseline) baseline->checkpointRevision = checkpointRevision;
+    }
     
-    // Build save file
-    json doc;
-    doc["version"] = currentVersion_.toString();
-    doc["metadata"] = {
-        {"slotId", metadata.slotId},
-        {"saveName", metadata.saveName},
-        {"characterName", metadata.characterName},
-        {"saveTime", std::chrono::system_clock::to_time_t(metadata.saveTime)},
-        {"playTime", metadata.playTime},
-        {"playerLevel", metadata.playerLevel},
-        {"currentArea", metadata.currentArea},
-        {"currentQuest", metadata.currentQuest},
-        {"completionPercent", metadata.completionPercent}
-    };
-    doc["gameData"] = gameData;
-    doc["checkpoints"] = checkpointManager_.serialize();
+    save.snapshotMs = elapsedMs(start);
+    return save;
+}
+
+bool SaveSystem::writeSave(PendingSave& save, SaveStats& stats) {
+    if (save.incremental) {
+        return appendJournal(save, stats);
+    }
     
-    std::string jsonStr = doc.dump();
+    auto encodeStart = Clock::now();
     
-    // Calculate checksum
-    uint32_t checksum = calculateChecksum(jsonStr);
+    // Metadata goes first so slot listings read only the start of the file
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> sections;
+    sections.reserve(save.sections.size() + 1);
     
-    // Compress
-    auto compressed = compressData(jsonStr);
+    SaveWriter metadataWriter;
+    save.metadata.write(metadataWriter);
+    sections.emplace_back(getSectionTag(METADATA_SECTION), std::move(metadataWriter.getData()));
     
-    // Write header + compressed data
-    std::ofstream file(filePath, std::ios::binary);
-    if (!file.is_open()) return false;
+    for (const auto& [tag, snapshot] : save.sections) {
+        SaveWriter writer;
+        snapshot->write(writer);
+        sections.emplace_back(tag, std::move(writer.getData()));
+    }
+    stats.encodeMs = elapsedMs(encodeStart);
+    
+    uint32_t checksum = 0;
+    if (!writeSaveFile(save.filePath, sections, stats, checksum)) return false;
+    
+    // The old journal described the old base
+    std::string journalPath = getJournalPath(save.filePath);
+    std::error_code ignored;
+    fs::remove(journalPath, ignored);
+    journalEnds_.erase(journalPath);
+    
+    save.metadata.fileSize = stats.fileBytes;
+    save.metadata.checksum = checksum;
+    return true;
+}
+
+bool SaveSystem::writeSaveFile(const std::string& filePath,
+                               std::vector<std::pair<uint32_t, std::vector<uint8_t>>>& sections,
+                               SaveStats& stats, uint32_t& outChecksum) {
+    auto encodeStart = Clock::now();
+    
+    std::vector<EncodedSection> encoded(sections.size());
+    for (size_t i = 0; i < sections.size(); ++i) {
+        stats.rawBytes += sections[i].second.size();
+        if (!encodeSection(sections[i].first, sections[i].second, encoded[i])) return false;
+    }
+    
+    // Lay out the sections after the table
+    SaveFileHeader header;
+    header.versionMajor = currentVersion_.major;
+    header.versionMinor = currentVersion_.minor;
+    header.versionPatch = currentVersion_.patch;
+    header.sectionCount = static_cast<uint32_t>(encoded.size());
+    
+    std::vector<SaveSectionEntry> table;
+    table.reserve(encoded.size());
+    uint64_t offset = sizeof(SaveFileHeader) + encoded.size() * sizeof(SaveSectionEntry);
+    for (EncodedSection& section : encoded) {
+        section.entry.offset = offset;
+        offset += section.stored.size();
+        table.push_back(section.entry);
+    }
+    header.tableChecksum = calculateChecksum(table.data(), table.size() * sizeof(SaveSectionEntry));
+    
+    stats.encodeMs += elapsedMs(encodeStart);
+    stats.sectionCount = header.sectionCount;
+    auto writeStart = Clock::now();
+    
+    // Write beside the slot and rename over it, so a failed or interrupted
+    // save never replaces a good one
+    std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(table.data()),
+                   static_cast<std::streamsize>(table.size() * sizeof(SaveSectionEntry)));
+        for (const EncodedSection& section : encoded) {
+            file.write(reinterpret_cast<const char*>(section.stored.data()),
+                       static_cast<std::streamsize>(section.stored.size()));
+        }
+        
+        file.flush();
+        if (!file.good()) {
+            file.close();
+            std::error_code ignored;
+            fs::remove(tempPath, ignored);
+            return false;
+        }
+    }
     
-    // Magic number
-    const char magic[] = "SANIC";
-    file.write(magic, 5);
+    std::error_code error;
+    fs::rename(tempPath, filePath, error);
+    if (error) {
+        std::error_code ignored;
+        fs::remove(tempPath, ignored);
+        return false;
+    }
     
-    // Version
-    file.write(reinterpret_cast<const char*>(&currentVersion_.major), sizeof(int));
-    file.write(reinterpret_cast<const char*>(&currentVersion_.minor), sizeof(int));
-    file.write(reinterpret_cast<const char*>(&currentVersion_.patch), sizeof(int));
+    stats.writeMs += elapsedMs(writeStart);
+    stats.fileBytes = static_cast<size_t>(offset);
+    outChecksum = header.tableChecksum;
+    return true;
+}
+
+bool SaveSystem::appendJournal(PendingSave& save, SaveStats& stats) {
+    auto encodeStart = Clock::now();
+    stats.incremental = true;
+    
+    // A delta means nothing without its base
+    SaveFileReader base;
+    if (!base.open(save.filePath)) return false;
+    uint32_t baseChecksum = base.getHeader().tableChecksum;
+    uint64_t baseBytes = base.getFileSize();
+    
+    std::vector<EncodedSection> encoded(save.sections.size() + 1);
+    {
+        SaveWriter writer;
+        save.metadata.write(writer);
+        stats.rawBytes += writer.getData().size();
+        if (!encodeSection(getSectionTag(METADATA_SECTION), writer.getData(), encoded[0])) return false;
+    }
+    for (size_t i = 0; i < save.sections.size(); ++i) {
+        SaveWriter writer;
+        save.sections[i].second->write(writer);
+        stats.rawBytes += writer.getData().size();
+        if (!encodeSection(save.sections[i].first, writer.getData(), encoded[i + 1])) return false;
+    }
     
-    // Checksum
-    file.write(reinterpret_cast<const char*>(&checksum), sizeof(uint32_t));
+    // Record body: section table, then the sections
+    std::vector<uint8_t> body(encoded.size() * sizeof(SaveSectionEntry));
+    for (size_t i = 0; i < encoded.size(); ++i) {
+        encoded[i].entry.offset = body.size();
+        body.insert(body.end(), encoded[i].stored.begin(), encoded[i].stored.end());
+        std::memcpy(body.data() + i * sizeof(SaveSectionEntry), &encoded[i].entry, sizeof(SaveSectionEntry));
+    }
+    if (body.size() > UINT32_MAX) return false;
+    
+    SaveJournalRecord record;
+    record.sectionCount = static_cast<uint32_t>(encoded.size());
+    record.size = static_cast<uint32_t>(body.size());
+    record.checksum = calculateChecksum(body.data(), body.size());
+    
+    stats.encodeMs = elapsedMs(encodeStart);
+    stats.sectionCount = record.sectionCount;
+    auto writeStart = Clock::now();
+    
+    // Where the valid records end. Scanned once per base; a torn record
+    // left by a crash is cut off so new records don't land behind it.
+    std::string journalPath = getJournalPath(save.filePath);
+    std::error_code error;
+    uint64_t journalSize = fs::exists(journalPath, error) ? fs::file_size(journalPath, error) : 0;
+    if (error) journalSize = 0;
+    
+    uint64_t end = 0;
+    auto known = journalEnds_.find(journalPath);
+    if (known != journalEnds_.end() && known->second.first == baseChecksum &&
+        known->second.second <= journalSize) {
+        end = known->second.second;
+    } else {
+        end = readJournal(journalPath, baseChecksum, nullptr);
+    }
     
-    // Uncompressed size
-    size_t uncompressedSize = jsonStr.size();
-    file.write(reinterpret_cast<const char*>(&uncompressedSize), sizeof(size_t));
+    {
+        std::fstream file;
+        if (end == 0) {
+            // No journal for this base yet
+            file.open(journalPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) return false;
+            
+            SaveJournalHeader header;
+            header.baseChecksum = baseChecksum;
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            end = sizeof(header);
+        } else {
+            if (journalSize > end) {
+                fs::resize_file(journalPath, end, error);
+                if (error) return false;
+            }
+            file.open(journalPath, std::ios::in | std::ios::out | std::ios::binary);
+            if (!file.is_open()) return false;
+            file.seekp(static_cast<std::streamoff>(end));
+        }
+        
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        file.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+        file.flush();
+        if (!file.good()) {
+            journalEnds_.erase(journalPath);
+            return false;
+        }
+    }
     
-    // Compressed data
-    file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+    end += sizeof(record) + body.size();
+    journalEnds_[journalPath] = {baseChecksum, end};
+    
+    stats.writeMs = elapsedMs(writeStart);
+    stats.fileBytes = sizeof(record) + body.size();
+    stats.journalBytes = static_cast<size_t>(end);
+    save.metadata.fileSize = static_cast<size_t>(baseBytes + end);
+    save.metadata.checksum = baseChecksum;
+    
+    if (end > save.compactionThreshold) {
+        // On failure base + journal stay as they were, and still load
+        base = SaveFileReader();
+        if (compactJournal(save.filePath)) {
+            stats.compacted = true;
+            stats.journalBytes = 0;
+            if (base.open(save.filePath)) {
+                save.metadata.fileSize = static_cast<size_t>(base.getFileSize());
+                save.metadata.checksum = base.getHeader().tableChecksum;
+            }
+        }
+    }
+    return true;
+}
+
+bool SaveSystem::compactJournal(const std::string& filePath) {
+    SaveFileReader base;
+    if (!base.open(filePath)) return false;
+    uint32_t baseChecksum = base.getHeader().tableChecksum;
+    
+    // Every base section, in file order
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> sections;
+    std::unordered_map<uint32_t, size_t> sectionIndex;
+    for (const SaveSectionEntry& entry : base.getSections()) {
+        sectionIndex[entry.tag] = sections.size();
+        sections.emplace_back(entry.tag, std::vector<uint8_t>());
+        if (!base.readSection(entry.tag, sections.back().second)) return false;
+    }
     
+    // Entities merge by persistent ID; every other section is replaced whole
+    const uint32_t entitiesTag = getSectionTag(ENTITIES_SECTION);
+    EntitiesSnapshot merged;
+    std::unordered_map<std::string, size_t> entityIndex;
+    bool entitiesMerged = false;
+    
+    auto mergeEntities = [&](const std::vector<uint8_t>& data) {
+        SaveReader reader(data.data(), data.size());
+        return readEntities(reader, [&](EntityRecord& e) {
+            auto [it, inserted] = entityIndex.emplace(e.persistentId, merged.entities.size());
+            if (inserted) {
+                merged.entities.push_back(std::move(e));
+            } else {
+                merged.entities[it->second] = std::move(e);
+            }
+        });
+    };
+    
+    bool ok = true;
+    std::vector<uint8_t> data;
+    readJournal(getJournalPath(filePath), baseChecksum, [&](const SaveSectionEntry& entry, const uint8_t* stored) {
+        if (!decodeSection(entry, stored, data)) {
+            ok = false;
+            return false;
+        }
+        
+        if (entry.tag == entitiesTag) {
+            if (!entitiesMerged) {
+                auto it = sectionIndex.find(entitiesTag);
+                if (it != sectionIndex.end() && !mergeEntities(sections[it->second].second)) {
+                    ok = false;
+                    return false;
+                }
+                entitiesMerged = true;
+            }
+            ok = mergeEntities(data);
+            return ok;
+        }
+        
+        auto it = sectionIndex.find(entry.tag);
+        if (it != sectionIndex.end()) {
+            sections[it->second].second.swap(data);
+        } else {
+            sectionIndex[entry.tag] = sections.size();
+            sections.emplace_back(entry.tag, std::move(data));
+        }
+        data.clear();
+        return true;
+    });
+    if (!ok) return false;
+    
+    if (entitiesMerged) {
+        SaveWriter writer;
+        merged.write(writer);
+        auto it = sectionIndex.find(entitiesTag);
+        if (it != sectionIndex.end()) {
+            sections[it->second].second = std::move(writer.getData());
+        } else {
+            sections.emplace_back(entitiesTag, std::move(writer.getData()));
+        }
+    }
+    
+    base = SaveFileReader();  // Close before the rename replaces it
+    
+    SaveStats stats;
+    uint32_t checksum = 0;
+    if (!writeSaveFile(filePath, sections, stats, checksum)) return false;
+    
+    std::string journalPath = getJournalPath(filePath);
+    std::error_code ignored;
+    fs::remove(journalPath, ignored);
+    journalEnds_.erase(journalPath);
     return true;
 }
 
+void SaveSystem::saveThreadFunc() {
+    while (true) {
+        PendingSave save;
+        
+        {
+            std::unique_lock<std::mutex> lock(saveMutex_);
+            saveCondition_.wait(lock, [this] {
+                return saveShutdown_ || !saveQueue_.empty();
+            });
+            if (saveQueue_.empty()) return;  // Shut down with nothing left to write
+            
+            save = std::move(saveQueue_.front());
+            saveQueue_.pop_front();
+            savesInFlight_++;
+        }
+        
+        SaveStats stats;
+        stats.snapshotMs = save.snapshotMs;
+        bool success = writeSave(save, stats);
+        
+        // Release the snapshots here rather than on the game thread
+        save.sections.clear();
+        
+        {
+            std::lock_guard<std::mutex> lock(saveMutex_);
+            savesInFlight_--;
+            if (success) lastSaveStats_ = stats;
+            finishedSaves_.push_back({save.slot, std::move(save.metadata), success});
+        }
+        saveIdleCondition_.notify_all();
+    }
+}
+
+void SaveSystem::deliverFinishedSaves() {
+    std::vector<FinishedSave> finished;
+    {
+        std::lock_guard<std::mutex> lock(saveMutex_);
+        finished.swap(finishedSaves_);
+    }
+    
+    for (FinishedSave& save : finished) {
+        if (save.success) {
+            slotCache_[save.slot] = save.metadata;
+        } else {
+            // What the slot holds is unknown now; the next save rewrites it
+            slotBaselines_.erase(save.slot);
+        }
+        if (onSaveCompleted_) onSaveCompleted_(save.slot, save.success);
+    }
+}
+
+void SaveSystem::flushSaves() {
+    {
+        std::unique_lock<std::mutex> lock(saveMutex_);
+        saveIdleCondition_.wait(lock, [this] {
+            return saveQueue_.empty() && savesInFlight_ == 0;
+        });
+    }
+    deliverFinishedSaves();
+}
+
+bool SaveSystem::isSaving() const {
+    std::lock_guard<std::mutex> lock(saveMutex_);
+    return !saveQueue_.empty() || savesInFlight_ > 0;
+}
+
+SaveSystem::SaveStats SaveSystem::getLastSaveStats() const {
+    std::lock_guard<std::mutex> lock(saveMutex_);
+    return lastSaveStats_;
+}
+
 bool SaveSystem::loadGame(SaveSlotID slot) {
     if (onLoadStarted_) onLoadStarted_(slot, true);
     
@@ -325,6 +1240,249 @@ bool SaveSystem::quickLoad() {
 }
 
 bool SaveSystem::loadFromFile(const std::string& filePath) {
+    // A queued save may be about to replace this file
+    flushSaves();
+    
+    SaveFileReader reader;
+    if (!reader.open(filePath)) {
+        return loadLegacyFile(filePath);
+    }
+    
+    SaveVersion fileVersion = reader.getVersion();
+    if (!currentVersion_.isCompatible(fileVersion)) {
+        return false;  // Incompatible save
+    }
+    
+    SerializationContext context;
+    context.loadVersion = fileVersion;
+    context.saveVersion = currentVersion_;
+    
+    // Deltas appended since the base: the latest copy of each section, and
+    // every entity delta in order (those only hold what changed)
+    const uint32_t entitiesTag = getSectionTag(ENTITIES_SECTION);
+    std::unordered_map<uint32_t, std::vector<uint8_t>> journalSections;
+    std::vector<std::vector<uint8_t>> entityDeltas;
+    bool corrupt = false;
+    
+    readJournal(getJournalPath(filePath), reader.getHeader().tableChecksum,
+                [&](const SaveSectionEntry& entry, const uint8_t* stored) {
+        std::vector<uint8_t> section;
+        if (!decodeSection(entry, stored, section)) {
+            corrupt = true;
+            return false;
+        }
+        if (entry.tag == entitiesTag) {
+            entityDeltas.push_back(std::move(section));
+        } else {
+            journalSections[entry.tag] = std::move(section);
+        }
+        return true;
+    });
+    if (corrupt) return false;
+    
+    // One base section in memory at a time
+    std::vector<uint8_t> data;
+    
+    auto findLatest = [&](uint32_t tag) -> const std::vector<uint8_t>* {
+        auto it = journalSections.find(tag);
+        if (it != journalSections.end()) return &it->second;
+        if (!reader.findSection(tag)) return nullptr;
+        if (!reader.readSection(tag, data)) {
+            corrupt = true;
+            return nullptr;
+        }
+        return &data;
+    };
+    
+    for (const auto& handler : sectionHandlers_) {
+        if (!handler.read && !handler.deserialize) continue;
+        
+        const std::vector<uint8_t>* section = findLatest(getSectionTag(handler.name));
+        if (corrupt) return false;
+        if (!section) continue;
+        
+        SaveReader sectionReader(section->data(), section->size());
+        if (handler.read) {
+            if (!handler.read(sectionReader, context)) return false;
+        } else {
+            std::string string;
+            if (!sectionReader.readString(string) || !handler.deserialize(string, context)) {
+                return false;
+            }
+        }
+    }
+    
+    if (world_ && (reader.findSection(entitiesTag) || !entityDeltas.empty())) {
+        // Persistent ID lookup, built once
+        std::unordered_map<std::string, Entity> entitiesById;
+        for (auto [entity, saveable] : world_->query<SaveableComponent>()) {
+            entitiesById[saveable.persistentId] = entity;
+        }
+        
+        auto applyEntity = [&](EntityRecord& e) {
+            auto it = entitiesById.find(e.persistentId);
+            if (it == entitiesById.end()) return;
+            
+            Entity entity = it->second;
+            auto* saveable = world_->tryGetComponent<SaveableComponent>(entity);
+            if (!saveable) return;
+            
+            if (saveable->saveTransform && (e.flags & EntityRecord::HasTransform)) {
+                if (auto* transform = world_->tryGetComponent<Transform>(entity)) {
+                    transform->position = e.position;
+                    transform->rotation = e.rotation;
+                    transform->scale = e.scale;
+                    TransformSystem::markDirty(*world_, entity);
+                }
+            }
+            
+            if (saveable->saveHealth && (e.flags & EntityRecord::HasHealth)) {
+                if (auto* health = world_->tryGetComponent<Health>(entity)) {
+                    health->current = e.health;
+                    health->max = e.maxHealth;
+                }
+            }
+            
+            if (saveable->saveCustomData && saveable->customDeserialize && (e.flags & EntityRecord::HasCustom)) {
+                saveable->customDeserialize(e.custom);
+            }
+        };
+        
+        // The base, then each delta over it
+        if (reader.findSection(entitiesTag)) {
+            if (!reader.readSection(entitiesTag, data)) return false;
+            SaveReader sectionReader(data.data(), data.size());
+            if (!readEntities(sectionReader, applyEntity)) return false;
+        }
+        for (const std::vector<uint8_t>& delta : entityDeltas) {
+            SaveReader sectionReader(delta.data(), delta.size());
+            if (!readEntities(sectionReader, applyEntity)) return false;
+        }
+    }
+    
+    const std::vector<uint8_t>* checkpoints = findLatest(getSectionTag(CHECKPOINTS_SECTION));
+    if (corrupt) return false;
+    if (checkpoints) {
+        SaveReader sectionReader(checkpoints->data(), checkpoints->size());
+        if (!checkpointManager_.read(sectionReader)) return false;
+    }
+    
+    return true;
+}
+
+bool SaveSystem::exportToJson(const std::string& savePath, const std::string& jsonPath) const {
+    using json = nlohmann::json;
+    
+    SaveFileReader reader;
+    if (!reader.open(savePath)) return false;
+    
+    // Names for the tags we know
+    std::unordered_map<uint32_t, const SaveSectionHandler*> handlers;
+    for (const auto& handler : sectionHandlers_) {
+        handlers[getSectionTag(handler.name)] = &handler;
+    }
+    
+    json doc;
+    doc["formatVersion"] = reader.getHeader().formatVersion;
+    doc["version"] = reader.getVersion().toString();
+    doc["sections"] = json::array();
+    
+    std::vector<uint8_t> data;
+    for (const SaveSectionEntry& entry : reader.getSections()) {
+        json section;
+        char tag[16];
+        std::snprintf(tag, sizeof(tag), "%08x", entry.tag);
+        section["tag"] = tag;
+        section["codec"] = entry.codec;
+        section["storedSize"] = entry.storedSize;
+        section["rawSize"] = entry.rawSize;
+        
+        if (!reader.readSection(entry.tag, data)) {
+            section["error"] = "unreadable";
+            doc["sections"].push_back(section);
+            continue;
+        }
+        SaveReader sectionReader(data.data(), data.size());
+        
+        if (entry.tag == getSectionTag(METADATA_SECTION)) {
+            SaveMetadata metadata;
+            section["name"] = METADATA_SECTION;
+            if (metadata.read(sectionReader)) {
+                section["data"] = {
+                    {"slotId", metadata.slotId},
+                    {"saveName", metadata.saveName},
+                    {"characterName", metadata.characterName},
+                    {"saveTime", std::chrono::system_clock::to_time_t(metadata.saveTime)},
+                    {"playTime", metadata.playTime},
+                    {"playerLevel", metadata.playerLevel},
+                    {"currentArea", metadata.currentArea},
+                    {"currentQuest", metadata.currentQuest},
+                    {"completionPercent", metadata.completionPercent},
+                    {"thumbnailBytes", metadata.thumbnailData.size()}
+                };
+            }
+        } else if (entry.tag == getSectionTag(ENTITIES_SECTION)) {
+            section["name"] = ENTITIES_SECTION;
+            json entities = json::array();
+            uint32_t count = 0;
+            EntityRecord e;
+            sectionReader.read(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                e.flags = 0;
+                if (!readEntityRecord(sectionReader, e)) break;
+                json j;
+                j["persistentId"] = e.persistentId;
+                if (e.flags & EntityRecord::HasTransform) {
+                    j["transform"] = {
+                        {"pos", {e.position.x, e.position.y, e.position.z}},
+                        {"rot", {e.rotation.x, e.rotation.y, e.rotation.z, e.rotation.w}},
+                        {"scale", {e.scale.x, e.scale.y, e.scale.z}}
+                    };
+                }
+                if (e.flags & EntityRecord::HasHealth) {
+                    j["health"] = {{"current", e.health}, {"max", e.maxHealth}};
+                }
+                if (e.flags & EntityRecord::HasCustom) {
+                    j["custom"] = e.custom;
+                }
+                entities.push_back(j);
+            }
+            section["data"] = entities;
+        } else if (entry.tag == getSectionTag(CHECKPOINTS_SECTION)) {
+            section["name"] = CHECKPOINTS_SECTION;
+            CheckpointsSnapshot state;
+            if (readCheckpoints(sectionReader, state)) {
+                json checkpoints = json::array();
+                for (const CheckpointRecord& c : state.checkpoints) {
+                    checkpoints.push_back({{"id", c.id}, {"activated", c.activated},
+                                           {"activationTime", c.activationTime}});
+                }
+                section["data"] = {{"currentCheckpoint", state.currentId}, {"checkpoints", checkpoints}};
+            }
+        } else {
+            auto it = handlers.find(entry.tag);
+            if (it != handlers.end()) {
+                section["name"] = it->second->name;
+                
+                // String sections can be shown; binary ones only by size
+                std::string string;
+                if (!it->second->read && sectionReader.readString(string)) {
+                    section["data"] = string;
+                }
+            }
+        }
+        
+        doc["sections"].push_back(section);
+    }
+    
+    std::ofstream file(jsonPath);
+    if (!file.is_open()) return false;
+    file << doc.dump(2);
+    return file.good();
+}
+
+// Saves from before the binary format: a header and one JSON document
+bool SaveSystem::loadLegacyFile(const std::string& filePath) {
     using json = nlohmann::json;
     
     std::ifstream file(filePath, std::ios::binary);
@@ -360,7 +1518,7 @@ bool SaveSystem::loadFromFile(const std::string& filePath) {
     );
     
     // Decompress
-    std::string jsonStr = decompressData(compressed);
+    std::string jsonStr = decompressData(compressed, uncompressedSize);
     if (jsonStr.empty()) return false;
     
     // Verify checksum
@@ -412,12 +1570,35 @@ std::optional<SaveMetadata> SaveSystem::getSlotMetadata(SaveSlotID slot) const {
     std::string path = getSlotFilePath(slot);
     if (!fs::exists(path)) return std::nullopt;
     
-    // Would read just the header/metadata
-    // For now, return empty metadata
     SaveMetadata metadata;
     metadata.slotId = slot;
     metadata.filePath = path;
     
+    // Only the header, table and metadata section are read, plus the
+    // journal's newest metadata if deltas were appended since
+    SaveFileReader reader;
+    std::vector<uint8_t> data;
+    if (reader.open(path) && reader.readSection(getSectionTag(METADATA_SECTION), data)) {
+        const uint32_t metadataTag = getSectionTag(METADATA_SECTION);
+        uint64_t journalBytes = readJournal(getJournalPath(path), reader.getHeader().tableChecksum,
+                                            [&](const SaveSectionEntry& entry, const uint8_t* stored) {
+            std::vector<uint8_t> latest;
+            if (entry.tag == metadataTag && decodeSection(entry, stored, latest)) {
+                data.swap(latest);
+            }
+            return true;
+        });
+        
+        SaveReader metadataReader(data.data(), data.size());
+        if (metadata.read(metadataReader)) {
+            metadata.slotId = slot;
+            metadata.fileSize = static_cast<size_t>(reader.getFileSize() + journalBytes);
+            metadata.version = reader.getVersion();
+            metadata.checksum = reader.getHeader().tableChecksum;
+            slotCache_[slot] = metadata;
+        }
+    }
+    
     return metadata;
 }
 
@@ -450,10 +1631,16 @@ int SaveSystem::getUsedSlotCount() const {
 }
 
 bool SaveSystem::deleteSaveSlot(SaveSlotID slot) {
+    // A queued save would bring the slot back
+    flushSaves();
+    
     std::string path = getSlotFilePath(slot);
+    slotBaselines_.erase(slot);
     
     if (fs::exists(path)) {
+        std::error_code ignored;
         fs::remove(path);
+        fs::remove(getJournalPath(path), ignored);
         slotCache_.erase(slot);
         return true;
     }
@@ -465,11 +1652,22 @@ bool SaveSystem::copySaveSlot(SaveSlotID source, SaveSlotID destination) {
     std::string srcPath = getSlotFilePath(source);
     std::string dstPath = getSlotFilePath(destination);
     
+    flushSaves();
     if (!fs::exists(srcPath)) return false;
     
+    // The destination's journal and baseline describe its old base
+    slotBaselines_.erase(destination);
+    
     try {
         fs::copy_file(srcPath, dstPath, fs::copy_options::overwrite_existing);
         
+        std::error_code ignored;
+        if (fs::exists(getJournalPath(srcPath))) {
+            fs::copy_file(getJournalPath(srcPath), getJournalPath(dstPath), fs::copy_options::overwrite_existing);
+        } else {
+            fs::remove(getJournalPath(dstPath), ignored);
+        }
+        
         // Update cache
         auto metadata = getSlotMetadata(source);
         if (metadata) {
@@ -489,6 +1687,8 @@ bool SaveSystem::slotExists(SaveSlotID slot) const {
 }
 
 void SaveSystem::update(float deltaTime) {
+    deliverFinishedSaves();
+    
     if (!autoSaveEnabled_) return;
     
     autoSaveTimer_ += deltaTime;
@@ -544,85 +1744,72 @@ std::string SaveSystem::getSlotFilePath(SaveSlotID slot) const {
 }
 
 uint32_t SaveSystem::calculateChecksum(const std::string& data) {
-    // Simple CRC32
-    uint32_t crc = 0xFFFFFFFF;
-    
-    for (char c : data) {
-        crc ^= static_cast<uint8_t>(c);
-        for (int i = 0; i < 8; ++i) {
-            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    return calculateChecksum(data.data(), data.size());
+}
+
+uint32_t SaveSystem::calculateChecksum(const void* data, size_t size) {
+    // CRC32, a byte per table lookup
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+            }
+            t[i] = crc;
         }
-    }
+        return t;
+    }();
     
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; ++i) {
+        crc = (crc >> 8) ^ table[(crc ^ bytes[i]) & 0xFF];
+    }
     return ~crc;
 }
 
-std::vector<uint8_t> SaveSystem::compressData(const std::string& data) {
-    // Simple compression using zlib (would need to link zlib)
-    // For now, just return uncompressed
-    return std::vector<uint8_t>(data.begin(), data.end());
+uint32_t SaveSystem::getSectionTag(const std::string& name) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
-std::string SaveSystem::decompressData(const std::vector<uint8_t>& compressed) {
-    // Would use zlib
-    return std::string(compressed.begin(), compressed.end());
+std::vector<uint8_t> SaveSystem::compressData(const std::string& data) {
+    // Fast LZ4 level; JSON compresses well even without a deep match search.
+    // Data that doesn't shrink is stored as-is.
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(data.data());
+    std::vector<uint8_t> compressed(DataCompression::compressBound(data.size()));
+    size_t size = DataCompression::compress(CompressionCodec::LZ4, src, data.size(),
+                                            compressed.data(), compressed.size());
+    if (size == 0 || size >= data.size()) {
+        return std::vector<uint8_t>(data.begin(), data.end());
+    }
+    compressed.resize(size);
+    return compressed;
 }
 
-std::string SaveSystem::serializeGameState(SerializationContext& context) {
-    using json = nlohmann::json;
-    
-    json doc;
-    
-    // Serialize each section
-    for (const auto& handler : sectionHandlers_) {
-        if (handler.serialize) {
-            doc[handler.name] = handler.serialize(context);
-        }
+std::string SaveSystem::decompressData(const std::vector<uint8_t>& compressed, size_t uncompressedSize) {
+    // Same size means stored raw (this also covers saves from before compression)
+    if (compressed.size() == uncompressedSize) {
+        return std::string(compressed.begin(), compressed.end());
     }
     
-    // Serialize saveable entities
-    if (world_) {
-        json entities = json::array();
-        
-        world_->query<SaveableComponent>([&](Entity entity, SaveableComponent& saveable) {
-            if (!saveable.shouldSave) return;
-            
-            json e;
-            e["persistentId"] = saveable.persistentId;
-            
-            if (saveable.saveTransform) {
-                auto* transform = world_->getComponent<Transform>(entity);
-                if (transform) {
-                    e["transform"] = {
-                        {"pos", {transform->position.x, transform->position.y, transform->position.z}},
-                        {"rot", {transform->rotation.x, transform->rotation.y, 
-                                transform->rotation.z, transform->rotation.w}},
-                        {"scale", {transform->scale.x, transform->scale.y, transform->scale.z}}
-                    };
-                }
-            }
-            
-            if (saveable.saveHealth) {
-                auto* health = world_->getComponent<Health>(entity);
-                if (health) {
-                    e["health"] = {
-                        {"current", health->current},
-                        {"max", health->max}
-                    };
-                }
-            }
-            
-            if (saveable.saveCustomData && saveable.customSerialize) {
-                e["custom"] = saveable.customSerialize();
-            }
-            
-            entities.push_back(e);
-        });
-        
-        doc["entities"] = entities;
+    // LZ4 can't expand more than 255:1; anything larger is a corrupt header
+    if (uncompressedSize > compressed.size() * 255 + 16) {
+        return std::string();
     }
     
-    return doc.dump();
+    std::string data(uncompressedSize, '\0');
+    if (!DataCompression::decompress(CompressionCodec::LZ4, compressed.data(), compressed.size(),
+                                     reinterpret_cast<uint8_t*>(&data[0]), data.size())) {
+        return std::string();
+    }
+    return data;
 }
 
 bool SaveSystem::deserializeGameState(const std::string& data, SerializationContext& context) {
@@ -651,29 +1838,30 @@ bool SaveSystem::deserializeGameState(const std::string& data, SerializationCont
             
             // Find entity with this persistent ID
             Entity entity = INVALID_ENTITY;
-            world_->query<SaveableComponent>([&](Entity ent, SaveableComponent& saveable) {
+            for (auto [ent, saveable] : world_->query<SaveableComponent>()) {
                 if (saveable.persistentId == persistentId) {
                     entity = ent;
                 }
-            });
+            }
             
             if (entity == INVALID_ENTITY) continue;
             
-            auto* saveable = world_->getComponent<SaveableComponent>(entity);
+            auto* saveable = world_->tryGetComponent<SaveableComponent>(entity);
             if (!saveable) continue;
             
             if (saveable->saveTransform && e.contains("transform")) {
-                auto* transform = world_->getComponent<Transform>(entity);
+                auto* transform = world_->tryGetComponent<Transform>(entity);
                 if (transform) {
                     auto& t = e["transform"];
                     transform->position = glm::vec3(t["pos"][0], t["pos"][1], t["pos"][2]);
                     transform->rotation = glm::quat(t["rot"][3], t["rot"][0], t["rot"][1], t["rot"][2]);
                     transform->scale = glm::vec3(t["scale"][0], t["scale"][1], t["scale"][2]);
+                    TransformSystem::markDirty(*world_, entity);
                 }
             }
             
             if (saveable->saveHealth && e.contains("health")) {
-                auto* health = world_->getComponent<Health>(entity);
+                auto* health = world_->tryGetComponent<Health>(entity);
                 if (health) {
                     health->current = e["health"]["current"];
                     health->max = e["health"]["max"];
@@ -802,6 +1990,48 @@ bool PlayerSaveData::deserialize(const std::string& data) {
     }
 }
 
+void PlayerSaveData::write(SaveWriter& writer) const {
+    writer.writeString(playerName);
+    writer.writeString(characterClass);
+    writer.write(static_cast<int32_t>(level));
+    writer.write(static_cast<int32_t>(experience));
+    writer.write(playTime);
+    writer.write(position);
+    writer.write(glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w));
+    writer.writeString(currentArea);
+    writer.write(static_cast<int32_t>(maxHealth));
+    writer.write(static_cast<int32_t>(currentHealth));
+    writer.write(static_cast<int32_t>(maxMana));
+    writer.write(static_cast<int32_t>(currentMana));
+    writer.write(static_cast<int32_t>(gold));
+    writeMap(writer, attributes);
+    writer.writeStrings(unlockedSkills);
+    writeMap(writer, skillLevels);
+    writer.writeStrings(achievements);
+    writeMap(writer, statistics);
+}
+
+bool PlayerSaveData::read(SaveReader& reader) {
+    glm::vec4 r;
+    if (!reader.readString(playerName) || !reader.readString(characterClass) ||
+        !readValue(reader, level) || !readValue(reader, experience) || !reader.read(playTime) ||
+        !reader.read(position) || !reader.read(r) || !reader.readString(currentArea)) {
+        return false;
+    }
+    rotation = glm::quat(r.w, r.x, r.y, r.z);
+    
+    return readValue(reader, maxHealth) &&
+           readValue(reader, currentHealth) &&
+           readValue(reader, maxMana) &&
+           readValue(reader, currentMana) &&
+           readValue(reader, gold) &&
+           readMap(reader, attributes) &&
+           reader.readStrings(unlockedSkills) &&
+           readMap(reader, skillLevels) &&
+           reader.readStrings(achievements) &&
+           readMap(reader, statistics);
+}
+
 // ============================================================================
 // WORLD SAVE DATA IMPLEMENTATION
 // ============================================================================
@@ -862,4 +2092,30 @@ bool WorldSaveData::deserialize(const std::string& data) {
     }
 }
 
+void WorldSaveData::write(SaveWriter& writer) const {
+    writer.write(gameTime);
+    writer.write(static_cast<int32_t>(dayCount));
+    writer.writeString(weatherState);
+    writer.writeStrings(destroyedPersistentIds);
+    writer.writeStrings(spawnedEntityData);
+    writeMap(writer, objectStates);
+    writer.writeStrings(unlockedAreas);
+    writeMap(writer, flags);
+    writeMap(writer, counters);
+    writeMap(writer, strings);
+}
+
+bool WorldSaveData::read(SaveReader& reader) {
+    return reader.read(gameTime) &&
+           readValue(reader, dayCount) &&
+           reader.readString(weatherState) &&
+           reader.readStrings(destroyedPersistentIds) &&
+           reader.readStrings(spawnedEntityData) &&
+           readMap(reader, objectStates) &&
+           reader.readStrings(unlockedAreas) &&
+           readMap(reader, flags) &&
+           readMap(reader, counters) &&
+           readMap(reader, strings);
+}
+
 } // namespace Sanic
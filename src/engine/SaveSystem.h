@@ -10,7 +10,13 @@
  * - Checkpoint system
  * - Cloud save integration hooks
  * - Save file versioning and migration
- * 
+ * - Background saves: sections are snapshotted on the game thread, then
+ *   encoded, compressed and written atomically on a save thread
+ * - Binary save files of tagged, individually compressed sections that
+ *   load one at a time (JSON only as a debug export)
+ * - Incremental saves: changed sections and entities are appended to a
+ *   per-slot journal, compacted into the base save in the background
+ *
  * Reference:
  *   Engine/Source/Runtime/SaveGame/
  */
@@ -26,6 +32,14 @@
 #include <unordered_map>
 #include <chrono>
 #include <optional>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 
 namespace Sanic {
 
@@ -65,6 +79,91 @@ struct SaveVersion {
     static SaveVersion fromString(const std::string& str);
 };
 
+// ============================================================================
+// BINARY ARCHIVES
+// ============================================================================
+
+/**
+ * Appends little-endian binary values to a byte buffer
+ */
+class SaveWriter {
+public:
+    void writeBytes(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        data_.insert(data_.end(), bytes, bytes + size);
+    }
+    
+    template<typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "write() takes plain values");
+        writeBytes(&value, sizeof(T));
+    }
+    
+    void writeString(const std::string& value) {
+        write(static_cast<uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+    
+    void writeStrings(const std::vector<std::string>& values) {
+        write(static_cast<uint32_t>(values.size()));
+        for (const std::string& value : values) writeString(value);
+    }
+    
+    std::vector<uint8_t>& getData() { return data_; }
+    const std::vector<uint8_t>& getData() const { return data_; }
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+/**
+ * Reads what SaveWriter wrote. Every read is bounds-checked and returns
+ * false once the data runs out.
+ */
+class SaveReader {
+public:
+    SaveReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+    
+    bool readBytes(void* out, size_t size) {
+        if (size > size_ - offset_) return false;
+        std::memcpy(out, data_ + offset_, size);
+        offset_ += size;
+        return true;
+    }
+    
+    template<typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "read() takes plain values");
+        return readBytes(&value, sizeof(T));
+    }
+    
+    bool readString(std::string& value) {
+        uint32_t size = 0;
+        if (!read(size) || size > size_ - offset_) return false;
+        value.assign(reinterpret_cast<const char*>(data_ + offset_), size);
+        offset_ += size;
+        return true;
+    }
+    
+    bool readStrings(std::vector<std::string>& values) {
+        uint32_t count = 0;
+        if (!read(count) || count > size_ - offset_) return false;  // Each needs >= 4 bytes
+        values.resize(count);
+        for (std::string& value : values) {
+            if (!readString(value)) return false;
+        }
+        return true;
+    }
+    
+    size_t getRemaining() const { return size_ - offset_; }
+    bool atEnd() const { return offset_ == size_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t offset_ = 0;
+};
+
 /**
  * Metadata for a save slot
  */
@@ -104,6 +203,13 @@ struct SaveMetadata {
      * Get formatted play time
      */
     std::string getFormattedPlayTime() const;
+    
+    /**
+     * Binary form stored in a save file's metadata section
+     * (filePath, fileSize, version and checksum come from the file itself)
+     */
+    void write(SaveWriter& writer) const;
+    bool read(SaveReader& reader);
 };
 
 // ============================================================================
@@ -131,6 +237,73 @@ public:
      * Get type identifier
      */
     virtual const char* getTypeId() const = 0;
+    
+    /**
+     * Binary form used in save files. Defaults to the JSON string;
+     * override for anything saved often.
+     */
+    virtual void write(SaveWriter& writer) const { writer.writeString(serialize()); }
+    virtual bool read(SaveReader& reader) {
+        std::string data;
+        return reader.readString(data) && deserialize(data);
+    }
+};
+
+/**
+ * Immutable copy of a section's state, taken on the game thread and
+ * written out later on the save thread
+ */
+class SaveSectionSnapshot {
+public:
+    virtual ~SaveSectionSnapshot() = default;
+    virtual void write(SaveWriter& writer) const = 0;
+};
+
+using SaveSnapshotPtr = std::shared_ptr<const SaveSectionSnapshot>;
+
+/**
+ * Copy-on-write holder for section state (T needs write(SaveWriter&) const).
+ *
+ * snapshot() shares the current state without copying it. The next edit()
+ * while that snapshot is alive copies the state first, so a save in flight
+ * never sees later changes and saving costs the game thread a refcount.
+ * Edit on one thread only; snapshots can be read from any.
+ */
+template<typename T>
+class SaveState {
+public:
+    SaveState() : state_(std::make_shared<T>()) {}
+    explicit SaveState(T initial) : state_(std::make_shared<T>(std::move(initial))) {}
+    
+    const T& get() const { return *state_; }
+    
+    T& edit() {
+        revision_++;
+        if (state_.use_count() > 1) {
+            state_ = std::make_shared<T>(*state_);
+        } else {
+            // Pairs with the release of the save thread dropping the last snapshot
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *state_;
+    }
+    
+    SaveSnapshotPtr snapshot() const {
+        return std::make_shared<Snapshot>(state_);
+    }
+    
+    // Bumped by every edit(); lets incremental saves skip unchanged sections
+    uint64_t getRevision() const { return revision_; }
+
+private:
+    struct Snapshot : SaveSectionSnapshot {
+        explicit Snapshot(std::shared_ptr<const T> s) : state(std::move(s)) {}
+        void write(SaveWriter& writer) const override { state->write(writer); }
+        std::shared_ptr<const T> state;
+    };
+    
+    std::shared_ptr<T> state_;
+    uint64_t revision_ = 0;
 };
 
 /**
@@ -185,17 +358,124 @@ enum class SaveSection {
 
 /**
  * Handler for a save section
+ *
+ * Give it snapshot/read for the binary path: snapshot runs on the game
+ * thread and should only grab state (see SaveState), its write() runs on
+ * the save thread. Handlers with only serialize/deserialize still work,
+ * but their string is built on the game thread.
+ *
+ * For incremental saves, revision should change whenever the state does
+ * (SaveState::getRevision). Sections without it go into every delta.
+ * read may run more than once per load and must replace, not merge.
  */
 struct SaveSectionHandler {
     SaveSection section;
-    std::string name;
+    std::string name;               // Unique; its hash tags the section in the file
     
     std::function<std::string(const SerializationContext&)> serialize;
     std::function<bool(const std::string&, SerializationContext&)> deserialize;
     
+    std::function<SaveSnapshotPtr(const SerializationContext&)> snapshot;
+    std::function<bool(SaveReader&, SerializationContext&)> read;
+    std::function<uint64_t()> revision;
+    
     int priority = 0;  // Lower = saved/loaded first
 };
 
+// ============================================================================
+// SAVE FILE FORMAT
+// ============================================================================
+
+/**
+ * File Layout (.sav):
+ * [SaveFileHeader]
+ * [SaveSectionEntry x sectionCount]
+ * [Sections]            - Metadata first, then handlers, entities, checkpoints
+ *
+ * Each section is compressed on its own and checksummed, so loading reads
+ * and decodes one section at a time and skips those nobody asks for.
+ *
+ * Journal Layout (.sav.journal, incremental saves):
+ * [SaveJournalHeader]   - Names the base save by its table checksum
+ * [Records]             - SaveJournalRecord, its SaveSectionEntry table
+ *                         (offsets from the end of the record header),
+ *                         then the sections
+ *
+ * A record holds whole handler sections that changed and entity records
+ * that changed. Records replay in order on top of the base; replay stops
+ * at the first torn or corrupt record, losing only that delta.
+ */
+constexpr uint32_t SAVE_FILE_MAGIC = 0x56415353;     // "SSAV" in little-endian
+constexpr uint32_t SAVE_FORMAT_VERSION = 2;          // v2: binary sections (v1 was one JSON blob)
+
+struct SaveFileHeader {
+    uint32_t magic = SAVE_FILE_MAGIC;
+    uint32_t formatVersion = SAVE_FORMAT_VERSION;
+    int32_t versionMajor = 0;       // SaveVersion of the game that wrote it
+    int32_t versionMinor = 0;
+    int32_t versionPatch = 0;
+    uint32_t sectionCount = 0;
+    uint32_t tableChecksum = 0;     // CRC32 of the section table
+    uint32_t reserved = 0;
+};
+static_assert(sizeof(SaveFileHeader) == 32, "SaveFileHeader must be 32 bytes");
+
+struct SaveSectionEntry {
+    uint32_t tag = 0;               // SaveSystem::getSectionTag(name)
+    uint32_t codec = 0;             // CompressionCodec
+    uint64_t offset = 0;            // From the start of the file
+    uint32_t storedSize = 0;
+    uint32_t rawSize = 0;
+    uint32_t checksum = 0;          // CRC32 of the raw bytes
+    uint32_t reserved = 0;
+};
+static_assert(sizeof(SaveSectionEntry) == 32, "SaveSectionEntry must be 32 bytes");
+
+constexpr uint32_t SAVE_JOURNAL_MAGIC = 0x4C4E4A53;  // "SJNL"
+constexpr uint32_t SAVE_RECORD_MAGIC = 0x43455253;   // "SREC"
+
+struct SaveJournalHeader {
+    uint32_t magic = SAVE_JOURNAL_MAGIC;
+    uint32_t formatVersion = SAVE_FORMAT_VERSION;
+    uint32_t baseChecksum = 0;      // SaveFileHeader::tableChecksum of the base
+    uint32_t reserved = 0;
+};
+static_assert(sizeof(SaveJournalHeader) == 16, "SaveJournalHeader must be 16 bytes");
+
+struct SaveJournalRecord {
+    uint32_t magic = SAVE_RECORD_MAGIC;
+    uint32_t sectionCount = 0;
+    uint32_t size = 0;              // Bytes after this header
+    uint32_t checksum = 0;          // CRC32 of those bytes
+};
+static_assert(sizeof(SaveJournalRecord) == 16, "SaveJournalRecord must be 16 bytes");
+
+/**
+ * Reads a save file's header and section table on open(); sections are
+ * read and decompressed only when asked for.
+ */
+class SaveFileReader {
+public:
+    bool open(const std::string& filePath);
+    
+    const SaveFileHeader& getHeader() const { return header_; }
+    const std::vector<SaveSectionEntry>& getSections() const { return sections_; }
+    SaveVersion getVersion() const;
+    uint64_t getFileSize() const { return fileSize_; }
+    
+    const SaveSectionEntry* findSection(uint32_t tag) const;
+    
+    // Decompressed section bytes; false if missing, truncated or corrupt
+    bool readSection(uint32_t tag, std::vector<uint8_t>& outData);
+
+private:
+    std::ifstream file_;
+    SaveFileHeader header_;
+    std::vector<SaveSectionEntry> sections_;
+    uint64_t fileSize_ = 0;
+    std::vector<uint8_t> stored_;   // Reused read buffer
+};
+
 // ============================================================================
 // CHECKPOINT
 // ============================================================================
@@ -272,9 +552,20 @@ public:
      */
     bool deserialize(const std::string& data);
     
+    /**
+     * Activation state for a save file: snapshot() copies it on the game
+     * thread, read() restores it
+     */
+    SaveSnapshotPtr snapshot() const;
+    bool read(SaveReader& reader);
+    
+    // Bumped whenever activation state changes
+    uint64_t getRevision() const { return revision_; }
+
 private:
     std::unordered_map<std::string, Checkpoint> checkpoints_;
     std::string currentCheckpointId_;
+    uint64_t revision_ = 0;
 };
 
 // ============================================================================
@@ -283,6 +574,16 @@ private:
 
 /**
  * Main save/load system
+ *
+ * saveGame() only snapshots sections on the calling (game) thread. The
+ * save thread then encodes and compresses them and writes the file to a
+ * temporary path that is renamed over the slot, so a crash mid-save
+ * leaves the previous save intact. Results come back through update().
+ *
+ * saveIncremental() (auto-saves and saveCheckpoint()) appends only what
+ * changed since the slot's last save to the slot's journal. Once the
+ * journal passes the compaction threshold the save thread merges it into
+ * a new base file. Loading replays base + journal.
  */
 class SaveSystem {
 public:
@@ -313,7 +614,9 @@ public:
     // ================== SAVE OPERATIONS ==================
     
     /**
-     * Save game to slot
+     * Save game to slot in the background. Returns false if it couldn't
+     * be queued; the outcome goes to the save-completed callback, which
+     * runs from update() or flushSaves().
      */
     bool saveGame(SaveSlotID slot, const std::string& saveName = "");
     
@@ -328,10 +631,47 @@ public:
     bool autoSave();
     
     /**
-     * Save to file directly
+     * Append what changed since the slot was last saved to its journal.
+     * Falls back to a full save if this session hasn't saved the slot yet.
+     */
+    bool saveIncremental(SaveSlotID slot, const std::string& saveName = "");
+    
+    /**
+     * Activate a checkpoint and save incrementally to the auto-save slot
+     */
+    bool saveCheckpoint(const std::string& checkpointId);
+    
+    /**
+     * Save to file directly, on the calling thread
      */
     bool saveToFile(const std::string& filePath, const SaveMetadata& metadata);
     
+    /**
+     * Wait for queued saves to reach disk and run their callbacks
+     */
+    void flushSaves();
+    
+    /**
+     * Saves queued or being written
+     */
+    bool isSaving() const;
+    
+    /**
+     * Timings and sizes of the last finished save
+     */
+    struct SaveStats {
+        float snapshotMs = 0.0f;        // Game-thread stall
+        float encodeMs = 0.0f;          // Encode + compress on the save thread
+        float writeMs = 0.0f;
+        size_t rawBytes = 0;
+        size_t fileBytes = 0;           // Base file, or the record for a delta
+        uint32_t sectionCount = 0;
+        bool incremental = false;
+        size_t journalBytes = 0;        // Journal size after the save
+        bool compacted = false;         // Journal was merged into the base
+    };
+    SaveStats getLastSaveStats() const;
+    
     // ================== LOAD OPERATIONS ==================
     
     /**
@@ -345,10 +685,15 @@ public:
     bool quickLoad();
     
     /**
-     * Load from file
+     * Load from file. Sections are read and decoded one at a time.
      */
     bool loadFromFile(const std::string& filePath);
     
+    /**
+     * Debug export of a save file as readable JSON
+     */
+    bool exportToJson(const std::string& savePath, const std::string& jsonPath) const;
+    
     // ================== SLOT MANAGEMENT ==================
     
     /**
@@ -393,6 +738,18 @@ public:
     
     // ================== AUTO-SAVE ==================
     
+    /**
+     * Whether auto-saves append to a journal instead of rewriting the slot
+     */
+    void setIncrementalSavesEnabled(bool enabled) { incrementalSaves_ = enabled; }
+    bool areIncrementalSavesEnabled() const { return incrementalSaves_; }
+    
+    /**
+     * Journal size that triggers a background compaction into the base
+     */
+    void setJournalCompactionThreshold(size_t bytes) { journalCompactionThreshold_ = bytes; }
+    size_t getJournalCompactionThreshold() const { return journalCompactionThreshold_; }
+    
     /**
      * Enable/disable auto-save
      */
@@ -464,7 +821,9 @@ public:
     void setCurrentVersion(const SaveVersion& version) { currentVersion_ = version; }
     
     /**
-     * Register migration handler
+     * Register migration handler. Migrations rewrite the game data of
+     * old JSON saves; binary section readers get the file's version in
+     * SerializationContext::loadVersion instead.
      */
     void registerMigration(const SaveVersion& from, const SaveVersion& to,
                            std::function<std::string(const std::string&)> migrator);
@@ -482,9 +841,15 @@ public:
     std::string getSlotFilePath(SaveSlotID slot) const;
     
     /**
-     * Calculate checksum
+     * Calculate checksum (CRC32)
      */
     static uint32_t calculateChecksum(const std::string& data);
+    static uint32_t calculateChecksum(const void* data, size_t size);
+    
+    /**
+     * Tag of a named section in save files
+     */
+    static uint32_t getSectionTag(const std::string& name);
     
     /**
      * Compress save data
@@ -492,9 +857,9 @@ public:
     static std::vector<uint8_t> compressData(const std::string& data);
     
     /**
-     * Decompress save data
+     * Decompress save data; returns an empty string if it is corrupt
      */
-    static std::string decompressData(const std::vector<uint8_t>& compressed);
+    static std::string decompressData(const std::vector<uint8_t>& compressed, size_t uncompressedSize);
     
     /**
      * Set world reference
@@ -502,7 +867,39 @@ public:
     void setWorld(World* world) { world_ = world; }
     
 private:
-    std::string serializeGameState(SerializationContext& context);
+    // Everything the save thread needs to write one file
+    struct PendingSave {
+        SaveSlotID slot = 0;
+        std::string filePath;
+        SaveMetadata metadata;
+        std::vector<std::pair<uint32_t, SaveSnapshotPtr>> sections;   // Tag, snapshot
+        float snapshotMs = 0.0f;
+        bool incremental = false;               // Append to the journal
+        size_t compactionThreshold = 0;
+    };
+    
+    struct FinishedSave {
+        SaveSlotID slot = 0;
+        SaveMetadata metadata;
+        bool success = false;
+    };
+    
+    // What a slot's files hold as of the last save queued to it
+    struct SlotBaseline;
+    
+    bool queueSave(SaveSlotID slot, const std::string& saveName, bool incremental);
+    PendingSave captureSave(const std::string& filePath, const SaveMetadata& metadata,
+                            SlotBaseline* baseline = nullptr, bool incremental = false);
+    bool writeSave(PendingSave& save, SaveStats& stats);
+    bool writeSaveFile(const std::string& filePath,
+                       std::vector<std::pair<uint32_t, std::vector<uint8_t>>>& sections,
+                       SaveStats& stats, uint32_t& outChecksum);
+    bool appendJournal(PendingSave& save, SaveStats& stats);
+    bool compactJournal(const std::string& filePath);
+    bool loadLegacyFile(const std::string& filePath);
+    void saveThreadFunc();
+    void deliverFinishedSaves();
+    
     bool deserializeGameState(const std::string& data, SerializationContext& context);
     bool migrateData(std::string& data, const SaveVersion& from, const SaveVersion& to);
     SaveMetadata createMetadata(SaveSlotID slot, const std::string& saveName);
@@ -520,6 +917,11 @@ private:
     int maxSaveSlots_ = 10;
     mutable std::unordered_map<SaveSlotID, SaveMetadata> slotCache_;
     
+    // Incremental saves (game thread)
+    std::unordered_map<SaveSlotID, std::unique_ptr<SlotBaseline>> slotBaselines_;
+    bool incrementalSaves_ = true;
+    size_t journalCompactionThreshold_ = 4 * 1024 * 1024;
+    
     // Auto-save
     bool autoSaveEnabled_ = true;
     float autoSaveInterval_ = 300.0f;  // 5 minutes
@@ -538,6 +940,21 @@ private:
     SaveCallback onSaveCompleted_;
     LoadCallback onLoadStarted_;
     LoadCallback onLoadCompleted_;
+    
+    // Background saves. Everything below is guarded by saveMutex_.
+    std::thread saveThread_;
+    mutable std::mutex saveMutex_;
+    std::condition_variable saveCondition_;
+    std::condition_variable saveIdleCondition_;
+    std::deque<PendingSave> saveQueue_;
+    std::vector<FinishedSave> finishedSaves_;
+    uint32_t savesInFlight_ = 0;        // Taken off the queue, not finished
+    SaveStats lastSaveStats_;
+    bool saveShutdown_ = false;
+    
+    // Per journal path: base checksum and end of the last valid record
+    // (whichever thread writes saves)
+    std::unordered_map<std::string, std::pair<uint32_t, uint64_t>> journalEnds_;
 };
 
 // ============================================================================
@@ -561,6 +978,7 @@ struct SaveableComponent {
     // Custom serialization
     std::function<std::string()> customSerialize;
     std::function<void(const std::string&)> customDeserialize;
+    uint32_t customRevision = 0;  // Bump when custom data changes (incremental saves)
 };
 
 // ============================================================================
@@ -611,6 +1029,8 @@ struct PlayerSaveData : public ISerializable {
     std::string serialize() const override;
     bool deserialize(const std::string& data) override;
     const char* getTypeId() const override { return "PlayerSaveData"; }
+    void write(SaveWriter& writer) const override;
+    bool read(SaveReader& reader) override;
 };
 
 // ============================================================================
@@ -645,6 +1065,8 @@ struct WorldSaveData : public ISerializable {
     std::string serialize() const override;
     bool deserialize(const std::string& data) override;
     const char* getTypeId() const override { return "WorldSaveData"; }
+    void write(SaveWriter& writer) const override;
+    bool read(SaveReader& reader) override;
 };
 
 } // namespace Sanic
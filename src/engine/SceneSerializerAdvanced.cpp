@@ -8,7 +8,21 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace Sanic {
 
@@ -790,6 +804,526 @@ bool JSONReader::skipValue() {
     }
 }
 
+// ============================================================================
+// MAPPED FILE
+// ============================================================================
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view) {
+                    data_ = static_cast<const uint8_t*>(view);
+                    size_ = static_cast<size_t>(fileSize.QuadPart);
+                    mapped_ = true;
+                    fileHandle_ = file;
+                    mappingHandle_ = mapping;
+                    return true;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            size_t fileSize = static_cast<size_t>(info.st_size);
+            void* view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                ::close(fd);  // The mapping holds its own reference
+                madvise(view, fileSize, MADV_WILLNEED);
+                data_ = static_cast<const uint8_t*>(view);
+                size_ = fileSize;
+                mapped_ = true;
+                return true;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+
+    // No mapping (or an empty file): read it instead
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+    
+    std::streamoff fileSize = file.tellg();
+    if (fileSize < 0) return false;
+    buffer_.resize(static_cast<size_t>(fileSize));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer_.data()), fileSize)) {
+        buffer_.clear();
+        return false;
+    }
+    
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mappingHandle_);
+        CloseHandle(fileHandle_);
+        mappingHandle_ = nullptr;
+        fileHandle_ = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
+// ============================================================================
+// BINARY SCENE FORMAT
+// ============================================================================
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+float elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+// FNV-1a, 64-bit
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+template<typename T>
+uint64_t hashValue(uint64_t hash, const T& value) {
+    return hashBytes(hash, &value, sizeof(value));
+}
+
+uint64_t hashString(uint64_t hash, const std::string& value) {
+    hash = hashValue(hash, static_cast<uint32_t>(value.size()));
+    return hashBytes(hash, value.data(), value.size());
+}
+
+constexpr uint64_t HASH_SEED = 1469598103934665603ull;
+
+// How one property is stored in a packed record
+enum class FieldKind : uint8_t {
+    Raw,        // prop.size bytes, as in memory
+    String,     // uint32_t string table index
+    Entity      // uint32_t file entity index
+};
+
+struct SceneField {
+    const PropertyDescriptor* property = nullptr;
+    FieldKind kind = FieldKind::Raw;
+    uint32_t size = 0;
+};
+
+// A reflected component type as this build writes and reads it
+struct SceneTypeLayout {
+    const StructDescriptor* descriptor = nullptr;
+    ComponentTypeId componentId = 0;
+    SceneColumnEncoding encoding = SceneColumnEncoding::Packed;
+    uint32_t stride = 0;
+    uint64_t layoutHash = 0;
+    std::vector<SceneField> fields;                     // Serializable properties
+    std::vector<const PropertyDescriptor*> transients;  // POD: reset to defaults when written
+    std::vector<uint8_t> defaults;                      // POD: a default instance's bytes
+};
+
+bool getFieldKind(const PropertyDescriptor& prop, FieldKind& out) {
+    switch (prop.type) {
+        case EPropertyType::Bool:
+        case EPropertyType::Int8:
+        case EPropertyType::Int16:
+        case EPropertyType::Int32:
+        case EPropertyType::Int64:
+        case EPropertyType::UInt8:
+        case EPropertyType::UInt16:
+        case EPropertyType::UInt32:
+        case EPropertyType::UInt64:
+        case EPropertyType::Float:
+        case EPropertyType::Double:
+        case EPropertyType::Vec2:
+        case EPropertyType::Vec3:
+        case EPropertyType::Vec4:
+        case EPropertyType::Quat:
+        case EPropertyType::Mat4:
+        case EPropertyType::Color:
+        case EPropertyType::Enum:
+            out = FieldKind::Raw;
+            return prop.size > 0;
+        case EPropertyType::String:
+        case EPropertyType::Asset:
+        case EPropertyType::SoftObject:
+            out = FieldKind::String;
+            return prop.typeInfo == std::type_index(typeid(std::string));
+        case EPropertyType::Entity:
+            out = FieldKind::Entity;
+            return prop.size == sizeof(Entity);
+        default:
+            return false;   // Structs, arrays, maps and objects have no flat form
+    }
+}
+
+/**
+ * Types that are trivially copyable and match their descriptor's size are
+ * stored as raw bytes; everything else as packed properties. The layout hash
+ * covers exactly what the encoding depends on, so packed types survive
+ * member reordering and POD types don't.
+ */
+bool buildLayout(const StructDescriptor& descriptor, ComponentTypeId componentId, SceneTypeLayout& out) {
+    const ComponentTypeInfo& info = ComponentRegistry::getInstance().getTypeInfo(componentId);
+    if (!info.defaultConstruct) return false;
+    
+    out = SceneTypeLayout();
+    out.descriptor = &descriptor;
+    out.componentId = componentId;
+    
+    std::vector<const PropertyDescriptor*> properties = descriptor.getAllProperties();
+    
+    bool pod = info.triviallyCopyable && info.size == descriptor.size && descriptor.factory;
+    for (const PropertyDescriptor* prop : properties) {
+        FieldKind kind;
+        if (prop->isSerializable() && getFieldKind(*prop, kind) && kind == FieldKind::String) pod = false;
+    }
+    
+    uint32_t packedStride = 0;
+    for (const PropertyDescriptor* prop : properties) {
+        if (!prop->isSerializable()) {
+            out.transients.push_back(prop);
+            continue;
+        }
+        
+        SceneField field;
+        field.property = prop;
+        if (!getFieldKind(*prop, field.kind)) {
+            // POD copies it with the rest of the bytes; packed can't store it
+            if (!pod) continue;
+            field.kind = FieldKind::Raw;
+        }
+        field.size = field.kind == FieldKind::Raw ? static_cast<uint32_t>(prop->size) : sizeof(uint32_t);
+        packedStride += field.size;
+        out.fields.push_back(field);
+    }
+    
+    out.encoding = pod ? SceneColumnEncoding::POD : SceneColumnEncoding::Packed;
+    out.stride = pod ? static_cast<uint32_t>(info.size) : packedStride;
+    
+    uint64_t hash = hashString(HASH_SEED, descriptor.name);
+    hash = hashValue(hash, static_cast<uint32_t>(out.encoding));
+    if (pod) {
+        hash = hashValue(hash, static_cast<uint64_t>(info.size));
+        hash = hashValue(hash, static_cast<uint64_t>(info.alignment));
+    }
+    for (const SceneField& field : out.fields) {
+        hash = hashString(hash, field.property->name);
+        hash = hashValue(hash, static_cast<uint8_t>(field.property->type));
+        hash = hashValue(hash, field.size);
+        if (pod) hash = hashValue(hash, static_cast<uint64_t>(field.property->offset));
+    }
+    out.layoutHash = hash;
+    
+    if (pod) {
+        out.defaults.resize(info.size);
+        void* instance = descriptor.factory();
+        std::memcpy(out.defaults.data(), instance, info.size);
+        descriptor.destructor(instance);
+    } else {
+        out.transients.clear();
+    }
+    return true;
+}
+
+uint32_t readU32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+void writeU32(uint8_t* data, uint32_t value) {
+    std::memcpy(data, &value, sizeof(value));
+}
+
+void alignTo(std::vector<uint8_t>& out, size_t alignment) {
+    out.resize((out.size() + alignment - 1) / alignment * alignment, 0);
+}
+
+class StringTableWriter {
+public:
+    uint32_t add(const std::string& value) {
+        auto [it, inserted] = indices_.emplace(value, static_cast<uint32_t>(ends_.size()));
+        if (inserted) {
+            bytes_.insert(bytes_.end(), value.begin(), value.end());
+            ends_.push_back(static_cast<uint32_t>(bytes_.size()));
+        }
+        return it->second;
+    }
+    
+    void write(std::vector<uint8_t>& out) const {
+        size_t start = out.size();
+        out.resize(start + sizeof(uint32_t) * (ends_.size() + 1) + bytes_.size());
+        uint8_t* dst = out.data() + start;
+        writeU32(dst, static_cast<uint32_t>(ends_.size()));
+        std::memcpy(dst + sizeof(uint32_t), ends_.data(), ends_.size() * sizeof(uint32_t));
+        std::memcpy(dst + sizeof(uint32_t) * (ends_.size() + 1), bytes_.data(), bytes_.size());
+    }
+
+private:
+    std::unordered_map<std::string, uint32_t> indices_;
+    std::vector<uint32_t> ends_;
+    std::vector<char> bytes_;
+};
+
+// Strings straight out of the file, checked on access
+class StringTableView {
+public:
+    bool open(const uint8_t* data, size_t size, uint64_t offset) {
+        if (offset > size || size - offset < sizeof(uint32_t)) return false;
+        count_ = readU32(data + offset);
+        uint64_t bytesOffset = offset + sizeof(uint32_t) * (uint64_t(count_) + 1);
+        if (bytesOffset > size) return false;
+        ends_ = data + offset + sizeof(uint32_t);
+        bytes_ = reinterpret_cast<const char*>(data + bytesOffset);
+        bytesSize_ = size - bytesOffset;
+        return true;
+    }
+    
+    bool get(uint32_t index, std::string_view& out) const {
+        if (index >= count_) return false;
+        uint32_t begin = index == 0 ? 0 : readU32(ends_ + (index - 1) * sizeof(uint32_t));
+        uint32_t end = readU32(ends_ + index * sizeof(uint32_t));
+        if (begin > end || end > bytesSize_) return false;
+        out = std::string_view(bytes_ + begin, end - begin);
+        return true;
+    }
+    
+    bool get(uint32_t index, std::string& out) const {
+        std::string_view view;
+        if (!get(index, view)) return false;
+        out.assign(view.data(), view.size());
+        return true;
+    }
+
+private:
+    uint32_t count_ = 0;
+    const uint8_t* ends_ = nullptr;
+    const char* bytes_ = nullptr;
+    size_t bytesSize_ = 0;
+};
+
+std::unique_ptr<Scene> readBinaryScene(const uint8_t* data, size_t size,
+                                       EnhancedSceneSerializer::BinaryLoadStats& stats) {
+    auto& registry = ComponentRegistry::getInstance();
+    
+    SceneBinaryHeader header;
+    if (!data || size < sizeof(header)) return nullptr;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != SCENE_MAGIC || header.version != SCENE_BINARY_VERSION || header.fileSize != size) {
+        return nullptr;
+    }
+    
+    uint64_t typesOffset = sizeof(SceneBinaryHeader) + sizeof(SceneBinaryMetadata);
+    uint64_t blocksOffset = typesOffset + uint64_t(header.typeCount) * sizeof(SceneTypeEntry);
+    uint64_t rootsOffset = blocksOffset + uint64_t(header.blockCount) * sizeof(SceneBlockEntry);
+    if (rootsOffset + uint64_t(header.rootCount) * sizeof(uint32_t) > size) return nullptr;
+    
+    StringTableView strings;
+    if (!strings.open(data, size, header.stringTableOffset)) return nullptr;
+    
+    // Every type must still have the layout it was written with
+    std::vector<SceneTypeLayout> layouts(header.typeCount);
+    uint64_t schemaHash = HASH_SEED;
+    for (uint32_t i = 0; i < header.typeCount; ++i) {
+        SceneTypeEntry entry;
+        std::memcpy(&entry, data + typesOffset + i * sizeof(SceneTypeEntry), sizeof(entry));
+        schemaHash = hashValue(schemaHash, entry.layoutHash);
+        
+        std::string name;
+        if (!strings.get(entry.name, name)) return nullptr;
+        const StructDescriptor* descriptor = TypeRegistry::getInstance().getStruct(name);
+        ComponentTypeId componentId = 0;
+        if (!descriptor || !registry.findTypeId(descriptor->typeInfo, componentId) ||
+            !buildLayout(*descriptor, componentId, layouts[i])) {
+            return nullptr;
+        }
+        if (layouts[i].layoutHash != entry.layoutHash || layouts[i].stride != entry.stride ||
+            static_cast<uint32_t>(layouts[i].encoding) != entry.encoding) {
+            return nullptr;
+        }
+    }
+    if (schemaHash != header.schemaHash) return nullptr;
+    
+    // Validate every block and column before touching the World
+    struct Block {
+        SceneBlockEntry entry;
+        std::vector<SceneColumnEntry> columns;
+        ComponentSignature signature;
+        uint32_t firstEntity = 0;
+        Archetype* archetype = nullptr;
+        uint32_t firstRow = 0;
+    };
+    std::vector<Block> blocks(header.blockCount);
+    uint64_t entityTotal = 0;
+    
+    for (uint32_t b = 0; b < header.blockCount; ++b) {
+        Block& block = blocks[b];
+        std::memcpy(&block.entry, data + blocksOffset + b * sizeof(SceneBlockEntry), sizeof(SceneBlockEntry));
+        block.firstEntity = static_cast<uint32_t>(entityTotal);
+        entityTotal += block.entry.entityCount;
+        
+        uint64_t columnsEnd = block.entry.columnsOffset + uint64_t(block.entry.columnCount) * sizeof(SceneColumnEntry);
+        if (block.entry.columnsOffset > size || columnsEnd > size) return nullptr;
+        
+        block.columns.resize(block.entry.columnCount);
+        for (uint32_t c = 0; c < block.entry.columnCount; ++c) {
+            SceneColumnEntry& column = block.columns[c];
+            std::memcpy(&column, data + block.entry.columnsOffset + c * sizeof(SceneColumnEntry), sizeof(column));
+            if (column.type >= header.typeCount) return nullptr;
+            
+            const SceneTypeLayout& layout = layouts[column.type];
+            if (block.signature.test(layout.componentId)) return nullptr;
+            block.signature.set(layout.componentId);
+            
+            if (column.size != uint64_t(block.entry.entityCount) * layout.stride ||
+                column.offset > size || column.size > size - column.offset) {
+                return nullptr;
+            }
+        }
+    }
+    if (entityTotal != header.entityCount) return nullptr;
+    
+    auto scene = std::make_unique<Scene>();
+    World& world = scene->getWorld();
+    
+    SceneBinaryMetadata meta;
+    std::memcpy(&meta, data + sizeof(SceneBinaryHeader), sizeof(meta));
+    SceneMetadata& metadata = scene->getMetadata();
+    if (!strings.get(meta.name, metadata.name) || !strings.get(meta.description, metadata.description) ||
+        !strings.get(meta.author, metadata.author) || !strings.get(meta.skyboxPath, metadata.skyboxPath) ||
+        !strings.get(meta.environmentMapPath, metadata.environmentMapPath) ||
+        !strings.get(meta.navMeshPath, metadata.navMeshPath) ||
+        !strings.get(meta.ambienceClip, metadata.ambienceClip)) {
+        return nullptr;
+    }
+    metadata.ambientColor = glm::vec3(meta.ambientColor[0], meta.ambientColor[1], meta.ambientColor[2]);
+    metadata.ambienceVolume = meta.ambienceVolume;
+    metadata.createdTime = meta.createdTime;
+    metadata.modifiedTime = meta.modifiedTime;
+    
+    // Every entity exists before any column is filled, so references to
+    // later blocks resolve
+    auto createStart = Clock::now();
+    std::vector<Entity> entities(header.entityCount);
+    std::vector<Entity> created;
+    for (Block& block : blocks) {
+        block.archetype = world.createEntities(block.signature, block.entry.entityCount, created, block.firstRow);
+        std::copy(created.begin(), created.end(), entities.begin() + block.firstEntity);
+    }
+    stats.createMs = elapsedMs(createStart);
+    
+    auto remap = [&](uint32_t index) {
+        return index < entities.size() ? entities[index] : INVALID_ENTITY;
+    };
+    
+    auto copyStart = Clock::now();
+    for (const Block& block : blocks) {
+        Archetype* archetype = block.archetype;
+        uint32_t capacity = archetype->getChunkCapacity();
+        uint32_t count = block.entry.entityCount;
+        
+        for (const SceneColumnEntry& column : block.columns) {
+            const SceneTypeLayout& layout = layouts[column.type];
+            const ComponentTypeId id = layout.componentId;
+            const uint8_t* src = data + column.offset;
+            
+            if (layout.encoding == SceneColumnEncoding::POD) {
+                // One copy per chunk the block's rows span
+                for (uint32_t row = block.firstRow, end = block.firstRow + count; row < end;) {
+                    uint32_t index = row % capacity;
+                    uint32_t run = std::min(capacity - index, end - row);
+                    uint8_t* dst = static_cast<uint8_t*>(archetype->getChunkColumn(row / capacity, id)) +
+                                   size_t(index) * layout.stride;
+                    std::memcpy(dst, src, size_t(run) * layout.stride);
+                    src += size_t(run) * layout.stride;
+                    row += run;
+                }
+                
+                for (const SceneField& field : layout.fields) {
+                    if (field.kind != FieldKind::Entity) continue;
+                    for (uint32_t row = block.firstRow; row < block.firstRow + count; ++row) {
+                        uint8_t* component = static_cast<uint8_t*>(archetype->getComponent(row, id));
+                        Entity* reference = reinterpret_cast<Entity*>(component + field.property->offset);
+                        *reference = remap(*reference);
+                    }
+                }
+                stats.podColumns++;
+                continue;
+            }
+            
+            for (uint32_t row = block.firstRow; row < block.firstRow + count; ++row) {
+                uint8_t* component = static_cast<uint8_t*>(archetype->getComponent(row, id));
+                for (const SceneField& field : layout.fields) {
+                    uint8_t* dst = component + field.property->offset;
+                    switch (field.kind) {
+                        case FieldKind::Raw:
+                            std::memcpy(dst, src, field.size);
+                            break;
+                        case FieldKind::String:
+                            if (!strings.get(readU32(src), *reinterpret_cast<std::string*>(dst))) return nullptr;
+                            break;
+                        case FieldKind::Entity:
+                            *reinterpret_cast<Entity*>(dst) = remap(readU32(src));
+                            break;
+                    }
+                    src += field.size;
+                }
+            }
+            stats.packedColumns++;
+        }
+    }
+    
+    // Transform::children isn't written; rebuild it from the remapped parents
+    for (Entity entity : entities) {
+        if (!world.hasComponent<Transform>(entity)) continue;
+        Entity parent = world.getComponent<Transform>(entity).parent;
+        if (parent != INVALID_ENTITY && world.hasComponent<Transform>(parent)) {
+            world.getComponent<Transform>(parent).children.push_back(entity);
+        }
+    }
+    
+    std::vector<Entity> roots(header.rootCount);
+    for (uint32_t i = 0; i < header.rootCount; ++i) {
+        roots[i] = remap(readU32(data + rootsOffset + i * sizeof(uint32_t)));
+    }
+    scene->setRootEntities(roots);
+    
+    stats.copyMs = elapsedMs(copyStart);
+    stats.fileBytes = size;
+    stats.entityCount = header.entityCount;
+    return scene;
+}
+
+} // namespace
+
 // ============================================================================
 // ENHANCED SCENE SERIALIZER
 // ============================================================================
@@ -1024,37 +1558,251 @@ void EnhancedSceneSerializer::deserializeComponentJSON(JSONReader& reader, World
 }
 
 std::vector<uint8_t> EnhancedSceneSerializer::serializeToBinary(const Scene& scene) {
-    std::ostringstream stream(std::ios::binary);
+    const World& world = scene.getWorld();
+    auto& registry = ComponentRegistry::getInstance();
+    
+    // Archetypes holding entities, in a stable order; entities are numbered
+    // in the order they're stored
+    std::vector<Archetype*> archetypes;
+    for (Archetype* archetype : world.getMatchingArchetypes(ComponentSignature())) {
+        if (archetype->size() > 0) archetypes.push_back(archetype);
+    }
     
-    // Header
-    stream.write(reinterpret_cast<const char*>(&SCENE_MAGIC), sizeof(SCENE_MAGIC));
-    stream.write(reinterpret_cast<const char*>(&SCENE_VERSION), sizeof(SCENE_VERSION));
+    std::vector<uint32_t> fileIndices;  // By Entity
+    uint32_t entityCount = 0;
+    for (Archetype* archetype : archetypes) {
+        for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+            const Entity* entities = archetype->getChunkEntities(chunk);
+            for (uint32_t i = 0; i < archetype->getChunkSize(chunk); ++i) {
+                if (entities[i] >= fileIndices.size()) {
+                    fileIndices.resize(entities[i] + 1, SCENE_NULL_ENTITY);
+                }
+                fileIndices[entities[i]] = entityCount++;
+            }
+        }
+    }
     
-    // TODO: Serialize scene in binary format
+    auto toFileIndex = [&](Entity entity) {
+        return entity < fileIndices.size() ? fileIndices[entity] : SCENE_NULL_ENTITY;
+    };
     
-    std::string str = stream.str();
-    return std::vector<uint8_t>(str.begin(), str.end());
+    // Type table: every reflected component type in the scene
+    std::vector<SceneTypeLayout> layouts;
+    std::array<int32_t, MAX_COMPONENTS> typeIndices;
+    typeIndices.fill(-2);  // -2 unresolved, -1 not stored
+    
+    std::vector<std::vector<uint32_t>> blockTypes(archetypes.size());
+    size_t columnCount = 0;
+    for (size_t b = 0; b < archetypes.size(); ++b) {
+        for (ComponentTypeId id : archetypes[b]->getComponentTypes()) {
+            if (typeIndices[id] == -2) {
+                typeIndices[id] = -1;
+                const ComponentTypeInfo& info = registry.getTypeInfo(id);
+                const StructDescriptor* descriptor =
+                    info.type ? TypeRegistry::getInstance().getStruct(std::type_index(*info.type)) : nullptr;
+                SceneTypeLayout layout;
+                if (descriptor && buildLayout(*descriptor, id, layout)) {
+                    typeIndices[id] = static_cast<int32_t>(layouts.size());
+                    layouts.push_back(std::move(layout));
+                }
+            }
+            if (typeIndices[id] >= 0) {
+                blockTypes[b].push_back(static_cast<uint32_t>(typeIndices[id]));
+                columnCount++;
+            }
+        }
+    }
+    
+    const std::vector<Entity>& roots = scene.getRootEntities();
+    
+    SceneBinaryHeader header;
+    header.typeCount = static_cast<uint32_t>(layouts.size());
+    header.blockCount = static_cast<uint32_t>(archetypes.size());
+    header.entityCount = entityCount;
+    header.rootCount = static_cast<uint32_t>(roots.size());
+    
+    size_t typesOffset = sizeof(SceneBinaryHeader) + sizeof(SceneBinaryMetadata);
+    size_t blocksOffset = typesOffset + layouts.size() * sizeof(SceneTypeEntry);
+    size_t rootsOffset = blocksOffset + archetypes.size() * sizeof(SceneBlockEntry);
+    size_t columnsOffset = rootsOffset + roots.size() * sizeof(uint32_t);
+    
+    std::vector<uint8_t> out(columnsOffset + columnCount * sizeof(SceneColumnEntry), 0);
+    StringTableWriter strings;
+    
+    // Column data, block by block
+    std::vector<SceneBlockEntry> blocks(archetypes.size());
+    std::vector<SceneColumnEntry> columns;
+    columns.reserve(columnCount);
+    
+    for (size_t b = 0; b < archetypes.size(); ++b) {
+        Archetype* archetype = archetypes[b];
+        uint32_t count = static_cast<uint32_t>(archetype->size());
+        blocks[b].entityCount = count;
+        blocks[b].columnCount = static_cast<uint32_t>(blockTypes[b].size());
+        blocks[b].columnsOffset = columnsOffset + columns.size() * sizeof(SceneColumnEntry);
+        
+        for (uint32_t typeIndex : blockTypes[b]) {
+            const SceneTypeLayout& layout = layouts[typeIndex];
+            const ComponentTypeId id = layout.componentId;
+            const size_t componentSize = registry.getTypeInfo(id).size;
+            
+            alignTo(out, 16);
+            SceneColumnEntry column;
+            column.type = typeIndex;
+            column.offset = out.size();
+            column.size = uint64_t(count) * layout.stride;
+            out.resize(out.size() + column.size);
+            uint8_t* dst = out.data() + column.offset;
+            
+            if (layout.encoding == SceneColumnEncoding::POD) {
+                uint8_t* rows = dst;
+                for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+                    size_t bytes = size_t(archetype->getChunkSize(chunk)) * layout.stride;
+                    std::memcpy(dst, archetype->getChunkColumn(chunk, id), bytes);
+                    dst += bytes;
+                }
+                
+                // Transient fields go out as defaults, references as file indices
+                for (uint32_t row = 0; row < count; ++row) {
+                    uint8_t* component = rows + size_t(row) * layout.stride;
+                    for (const PropertyDescriptor* prop : layout.transients) {
+                        std::memcpy(component + prop->offset, layout.defaults.data() + prop->offset, prop->size);
+                    }
+                    for (const SceneField& field : layout.fields) {
+                        if (field.kind != FieldKind::Entity) continue;
+                        Entity* reference = reinterpret_cast<Entity*>(component + field.property->offset);
+                        *reference = toFileIndex(*reference);
+                    }
+                }
+            } else {
+                for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+                    const uint8_t* component = static_cast<const uint8_t*>(archetype->getChunkColumn(chunk, id));
+                    for (uint32_t i = 0; i < archetype->getChunkSize(chunk); ++i, component += componentSize) {
+                        for (const SceneField& field : layout.fields) {
+                            const uint8_t* src = component + field.property->offset;
+                            switch (field.kind) {
+                                case FieldKind::Raw:
+                                    std::memcpy(dst, src, field.size);
+                                    break;
+                                case FieldKind::String:
+                                    writeU32(dst, strings.add(*reinterpret_cast<const std::string*>(src)));
+                                    break;
+                                case FieldKind::Entity:
+                                    writeU32(dst, toFileIndex(*reinterpret_cast<const Entity*>(src)));
+                                    break;
+                            }
+                            dst += field.size;
+                        }
+                    }
+                }
+            }
+            
+            columns.push_back(column);
+        }
+    }
+    
+    const SceneMetadata& metadata = scene.getMetadata();
+    SceneBinaryMetadata meta;
+    meta.name = strings.add(metadata.name);
+    meta.description = strings.add(metadata.description);
+    meta.author = strings.add(metadata.author);
+    meta.skyboxPath = strings.add(metadata.skyboxPath);
+    meta.environmentMapPath = strings.add(metadata.environmentMapPath);
+    meta.navMeshPath = strings.add(metadata.navMeshPath);
+    meta.ambienceClip = strings.add(metadata.ambienceClip);
+    meta.ambienceVolume = metadata.ambienceVolume;
+    meta.ambientColor[0] = metadata.ambientColor.x;
+    meta.ambientColor[1] = metadata.ambientColor.y;
+    meta.ambientColor[2] = metadata.ambientColor.z;
+    meta.createdTime = metadata.createdTime;
+    meta.modifiedTime = metadata.modifiedTime;
+    
+    std::vector<uint32_t> typeNames(layouts.size());
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        typeNames[i] = strings.add(layouts[i].descriptor->name);
+    }
+    
+    alignTo(out, 4);
+    header.stringTableOffset = out.size();
+    strings.write(out);
+    
+    // Tables, now that every offset is known
+    header.schemaHash = HASH_SEED;
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        SceneTypeEntry entry;
+        entry.name = typeNames[i];
+        entry.encoding = static_cast<uint32_t>(layouts[i].encoding);
+        entry.stride = layouts[i].stride;
+        entry.layoutHash = layouts[i].layoutHash;
+        std::memcpy(out.data() + typesOffset + i * sizeof(SceneTypeEntry), &entry, sizeof(entry));
+        header.schemaHash = hashValue(header.schemaHash, entry.layoutHash);
+    }
+    for (size_t i = 0; i < roots.size(); ++i) {
+        writeU32(out.data() + rootsOffset + i * sizeof(uint32_t), toFileIndex(roots[i]));
+    }
+    if (!blocks.empty()) {
+        std::memcpy(out.data() + blocksOffset, blocks.data(), blocks.size() * sizeof(SceneBlockEntry));
+    }
+    if (!columns.empty()) {
+        std::memcpy(out.data() + columnsOffset, columns.data(), columns.size() * sizeof(SceneColumnEntry));
+    }
+    
+    header.fileSize = out.size();
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(SceneBinaryHeader), &meta, sizeof(meta));
+    return out;
 }
 
-std::unique_ptr<Scene> EnhancedSceneSerializer::deserializeFromBinary(const std::vector<uint8_t>& data) {
-    std::istringstream stream(std::string(data.begin(), data.end()), std::ios::binary);
+bool EnhancedSceneSerializer::saveBinary(const Scene& scene, const std::string& path) {
+    std::vector<uint8_t> data = serializeToBinary(scene);
     
-    // Read and verify header
-    uint32_t magic, version;
-    stream.read(reinterpret_cast<char*>(&magic), sizeof(magic));
-    stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+std::unique_ptr<Scene> EnhancedSceneSerializer::deserializeFromBinary(const std::vector<uint8_t>& data) {
+    return deserializeFromBinary(data.data(), data.size());
+}
+
+std::unique_ptr<Scene> EnhancedSceneSerializer::deserializeFromBinary(const uint8_t* data, size_t size) {
+    BinaryLoadStats stats;
+    std::unique_ptr<Scene> scene = readBinaryScene(data, size, stats);
+    lastLoadStats_ = stats;
+    return scene;
+}
+
+std::unique_ptr<Scene> EnhancedSceneSerializer::loadScene(const std::string& binaryPath,
+                                                          const std::string& jsonPath) {
+    BinaryLoadStats stats;
+    auto mapStart = Clock::now();
     
-    if (magic != SCENE_MAGIC) {
-        throw std::runtime_error("Invalid scene file magic number");
+    MappedFile file;
+    if (file.open(binaryPath)) {
+        stats.mapMs = elapsedMs(mapStart);
+        std::unique_ptr<Scene> scene = readBinaryScene(file.data(), file.size(), stats);
+        if (scene) {
+            lastLoadStats_ = stats;
+            return scene;
+        }
     }
     
-    if (version > SCENE_VERSION) {
-        throw std::runtime_error("Scene file version too new");
-    }
+    // Missing, corrupt or stale: rebuild from the source
+    stats.usedJsonFallback = true;
+    lastLoadStats_ = stats;
+    if (jsonPath.empty()) return nullptr;
     
-    // TODO: Deserialize scene from binary
+    std::ifstream json(jsonPath);
+    if (!json.is_open()) return nullptr;
+    std::stringstream text;
+    text << json.rdbuf();
     
-    return std::make_unique<Scene>();
+    try {
+        return deserializeFromJSON(text.str());
+    } catch (const std::exception&) {
+        return nullptr;
+    }
 }
 
 // ============================================================================
@@ -3,6 +3,9 @@
  * 
  * Enhanced scene serialization with reflection system integration.
  * Provides automatic component serialization using SPROPERTY metadata.
+ * 
+ * Binary scenes are laid out from the reflected component layouts, so
+ * loading one is a file mapping and bulk copies into archetype storage.
  */
 
 #pragma once
@@ -11,6 +14,7 @@
 #include "Reflection.h"
 #include <sstream>
 #include <iomanip>
+#include <string_view>
 
 namespace Sanic {
 
@@ -136,6 +140,126 @@ private:
     Token parseToken();
 };
 
+// ============================================================================
+// BINARY SCENE FORMAT
+// ============================================================================
+
+/**
+ * Binary Scene Layout (little-endian, offsets from the start of the file):
+ * 
+ *   SceneBinaryHeader
+ *   SceneBinaryMetadata
+ *   SceneTypeEntry[typeCount]         One per reflected component type
+ *   SceneBlockEntry[blockCount]       One per archetype: entities sharing a component set
+ *   uint32_t roots[rootCount]         Root entities
+ *   SceneColumnEntry[...]             Per block, one per component type in it
+ *   Column data                       16-byte aligned, entityCount * stride bytes each
+ *   String table                      uint32_t count, uint32_t ends[count], bytes
+ * 
+ * Entities are numbered in file order, block by block, and entity references
+ * (roots, Entity properties) hold these numbers. POD columns are the
+ * components' bytes as they sit in memory, so loading one is a copy into the
+ * archetype's chunk columns plus a patch of its entity references. Packed
+ * columns hold each entity's serializable properties back to back, with
+ * strings as string table indices; those copy field by field.
+ * 
+ * Every type entry carries a hash of the reflected layout it was written
+ * with, and the header a hash over all of them. A file that doesn't match
+ * the running build is rejected instead of misread, and loadScene() falls
+ * back to the JSON source.
+ */
+constexpr uint32_t SCENE_BINARY_VERSION = 2;
+constexpr uint32_t SCENE_NULL_ENTITY = 0xFFFFFFFF;     // Entity reference to nothing
+
+enum class SceneColumnEncoding : uint32_t {
+    POD = 0,        // Raw component bytes, stride = sizeof(component)
+    Packed = 1      // Serializable properties only, in descriptor order
+};
+
+struct SceneBinaryHeader {
+    uint32_t magic = SCENE_MAGIC;
+    uint32_t version = SCENE_BINARY_VERSION;
+    uint64_t schemaHash = 0;            // Over every type entry's layoutHash
+    uint64_t fileSize = 0;
+    uint32_t typeCount = 0;
+    uint32_t blockCount = 0;
+    uint32_t entityCount = 0;
+    uint32_t rootCount = 0;
+    uint64_t stringTableOffset = 0;
+};
+static_assert(sizeof(SceneBinaryHeader) == 48, "SceneBinaryHeader layout is part of the file format");
+
+struct SceneBinaryMetadata {
+    // String table indices
+    uint32_t name = 0;
+    uint32_t description = 0;
+    uint32_t author = 0;
+    uint32_t skyboxPath = 0;
+    uint32_t environmentMapPath = 0;
+    uint32_t navMeshPath = 0;
+    uint32_t ambienceClip = 0;
+    float ambienceVolume = 1.0f;
+    float ambientColor[3] = {};
+    uint32_t reserved = 0;
+    uint64_t createdTime = 0;
+    uint64_t modifiedTime = 0;
+};
+static_assert(sizeof(SceneBinaryMetadata) == 64, "SceneBinaryMetadata layout is part of the file format");
+
+struct SceneTypeEntry {
+    uint32_t name = 0;                  // String table index of the StructDescriptor name
+    uint32_t encoding = 0;              // SceneColumnEncoding
+    uint32_t stride = 0;                // Bytes per entity in this type's columns
+    uint32_t reserved = 0;
+    uint64_t layoutHash = 0;
+};
+static_assert(sizeof(SceneTypeEntry) == 24, "SceneTypeEntry layout is part of the file format");
+
+struct SceneBlockEntry {
+    uint32_t entityCount = 0;
+    uint32_t columnCount = 0;
+    uint64_t columnsOffset = 0;         // SceneColumnEntry[columnCount]
+};
+static_assert(sizeof(SceneBlockEntry) == 16, "SceneBlockEntry layout is part of the file format");
+
+struct SceneColumnEntry {
+    uint32_t type = 0;                  // Type table index
+    uint32_t reserved = 0;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+static_assert(sizeof(SceneColumnEntry) == 24, "SceneColumnEntry layout is part of the file format");
+
+/**
+ * Read-only view of a whole file, memory-mapped where the platform allows
+ * and read into memory otherwise
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    bool open(const std::string& path);
+    void close();
+    
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool isMapped() const { return mapped_; }
+    
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<uint8_t> buffer_;       // Fallback copy
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+};
+
 // ============================================================================
 // ENHANCED SCENE SERIALIZER
 // ============================================================================
@@ -160,14 +284,40 @@ public:
     std::unique_ptr<Scene> deserializeFromJSON(const std::string& json);
     
     /**
-     * Serialize scene to binary with reflection
+     * Serialize scene to binary with reflection. Components without a
+     * StructDescriptor are not written.
      */
     std::vector<uint8_t> serializeToBinary(const Scene& scene);
+    bool saveBinary(const Scene& scene, const std::string& path);
     
     /**
-     * Deserialize scene from binary
+     * Deserialize scene from binary. Returns nullptr if the data is not a
+     * binary scene this build can read: corrupt, another format version, or
+     * written with component layouts that have since changed.
+     * 
+     * A component type is only known once it has been used as a component
+     * (ComponentRegistry assigns ids on first use).
      */
     std::unique_ptr<Scene> deserializeFromBinary(const std::vector<uint8_t>& data);
+    std::unique_ptr<Scene> deserializeFromBinary(const uint8_t* data, size_t size);
+    
+    /**
+     * Load a scene from a mapped binary file, falling back to the JSON source
+     * when the binary is missing or unreadable (pass an empty jsonPath for none)
+     */
+    std::unique_ptr<Scene> loadScene(const std::string& binaryPath, const std::string& jsonPath = "");
+    
+    struct BinaryLoadStats {
+        float mapMs = 0.0f;
+        float createMs = 0.0f;          // Entity and row allocation
+        float copyMs = 0.0f;            // Column copies and reference patching
+        size_t fileBytes = 0;
+        uint32_t entityCount = 0;
+        uint32_t podColumns = 0;
+        uint32_t packedColumns = 0;
+        bool usedJsonFallback = false;
+    };
+    const BinaryLoadStats& getLastLoadStats() const { return lastLoadStats_; }
     
     /**
      * Serialize single entity for copy/paste or networking
@@ -195,6 +345,7 @@ public:
     
 private:
     std::unordered_map<std::string, TypeDescriptor*> typeDescriptors_;
+    BinaryLoadStats lastLoadStats_;
     
     void serializeMetadataJSON(JSONWriter& writer, const SceneMetadata& metadata);
     void deserializeMetadataJSON(JSONReader& reader, SceneMetadata& metadata);
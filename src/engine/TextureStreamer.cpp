@@ -813,4 +813,26 @@ void TextureStreamer::forceLoad(uint32_t textureId, uint32_t targetMip) {
     }
 }
 
+void TextureStreamer::prefetchMip(uint32_t textureId, uint32_t targetMip) {
+    std::lock_guard<std::mutex> lock(texturesMutex_);
+    auto it = textures_.find(textureId);
+    if (it == textures_.end()) return;
+    
+    TextureStreamState& state = it->second;
+    
+    for (uint32_t mip = targetMip; mip < state.mipLevels; ++mip) {
+        if (state.mipResidency[mip] == MipResidency::NotLoaded) {
+            StreamRequest request;
+            request.textureId = textureId;
+            request.mipLevel = mip;
+            request.priority = StreamPriority::Low;
+            request.screenCoverage = 0.0f;
+            request.frameRequested = currentFrame_;
+            
+            std::lock_guard<std::mutex> reqLock(requestMutex_);
+            requestQueue_.push(request);
+        }
+    }
+}
+
 } // namespace Sanic
@@ -229,6 +229,12 @@ public:
      */
     void forceLoad(uint32_t textureId, uint32_t targetMip = 0);
     
+    /**
+     * Queue mips down to targetMip at low priority, ahead of any feedback
+     * asking for them (e.g. level streaming prefetch)
+     */
+    void prefetchMip(uint32_t textureId, uint32_t targetMip);
+    
     /**
      * Request immediate eviction to free memory
      */